@@ -0,0 +1,661 @@
+/**
+ * dozedent_bench - native profiling of the simulation core
+ *
+ * Runs scripted, fixed-seed scenarios through a GameCoordinator built from
+ * the same sources as the WASM module (everything but game_refactored.cpp)
+ * and reports, per scenario: tick time percentiles, mean time per
+ * subsystem from the profile zones (Profiler.h; the target always builds
+ * with DOZEDENT_PROFILE=1), heap allocations, pairs tested and collision
+ * events per tick, the frame arena's high-water mark, and the size and
+ * save/load cost of a full rollback snapshot of the final state.
+ *
+ *   cmake -S public -B build -DDOZEDENT_BUILD_BENCH=ON -DCMAKE_BUILD_TYPE=Release
+ *   cmake --build build --target dozedent_bench
+ *   ./build/dozedent_bench [--ticks N] [--scenario NAME] [--json FILE]
+ *   ./build/dozedent_bench --instances N [--threads T] [--ticks N]
+ *   ./build/dozedent_bench --record-log FILE [--ticks N] | --replay FILE
+ *
+ * --instances steps N headless SimInstances (10 wolves each, per-instance
+ * input) through a SimThreadPool and checks a sample against sequential runs.
+ *
+ * --record-log writes a scripted session as an input log (InputLog.h) and
+ * prints its checkpoint hashes; --replay plays a log back at full speed and
+ * prints the same hashes, so a saved log doubles as a regression test.
+ *
+ * --json writes the results as JSON; tools/scripts/enhanced-build.js copies
+ * a SIM_BENCH.json at the project root into BUILD_REPORT.json (simBench).
+ * tools/scripts/perf-regression.js runs the scenarios (here and, through
+ * tools/scripts/wasm-bench.js, in game.wasm) and checks the JSON against
+ * bench/baselines.json. Keep scenario names, seeds and scripts in step with
+ * wasm-bench.js.
+ */
+#include "coordinators/GameCoordinator.h"
+#include "coordinators/SimInstance.h"
+#include "coordinators/InputLog.h"
+#include "src/entities/PhysicsBarrel.h"
+#include "physics/ForceField.h"
+#include "physics/SnapshotStream.h"
+#include "Profiler.h"
+#include "AllocCounter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr float TICK_DT = 1.0f / 60.0f;
+constexpr int WARMUP_TICKS = 60;
+constexpr unsigned long long RUN_SEED = 1ull;  // init_run seed of every scenario
+constexpr uint32_t SCRIPT_SEED = 12345u;
+
+// Deterministic script randomness, independent of the game RNG
+struct ScriptRng {
+    uint32_t state;
+    uint32_t next() { state = state * 1664525u + 1013904223u; return state; }
+    float unit() { return static_cast<float>(next() >> 8) / 16777216.0f; }
+};
+
+struct Scenario {
+    const char* name;
+    const char* description;
+    void (*setup)(GameCoordinator& game, ScriptRng& rng);
+    // Runs before each tick; drives input and scripted events
+    void (*script)(GameCoordinator& game, ScriptRng& rng, int tick);
+    // Each timed tick also saves and restores the whole simulation, as a rollback peer would
+    bool rollback_every_tick = false;
+};
+
+// ---- Scenario scripts ----
+
+void spawn_wolf_ring(GameCoordinator& game, int count) {
+    const float px = game.get_player_manager().get_x();
+    const float py = game.get_player_manager().get_y();
+    for (int i = 0; i < count; ++i) {
+        // Rings of 50 so large packs don't all start overlapping
+        const float angle = static_cast<float>(i) / static_cast<float>(count) * 6.28318f;
+        const float dist = 0.15f + 0.05f * static_cast<float>(i / 50);
+        const float x = std::min(1.0f, std::max(0.0f, px + dist * std::cos(angle)));
+        const float y = std::min(1.0f, std::max(0.0f, py + dist * std::sin(angle)));
+        game.get_wolf_manager().spawn_wolf(x, y, static_cast<WolfType>(i % 5));
+    }
+}
+
+// Player circles and attacks, so combat, stamina and wolf reactions all run
+void script_player_fights(GameCoordinator& game, ScriptRng&, int tick) {
+    const float phase = static_cast<float>(tick) * 0.05f;
+    game.set_player_input(std::cos(phase), std::sin(phase),
+                          tick % 120 == 0, 0, tick % 20 == 0, tick % 90 == 45, tick % 60 >= 50, 0);
+}
+
+void setup_wolves_10(GameCoordinator& game, ScriptRng&) { spawn_wolf_ring(game, 10); }
+void setup_wolves_100(GameCoordinator& game, ScriptRng&) { spawn_wolf_ring(game, 100); }
+void setup_wolves_500(GameCoordinator& game, ScriptRng&) { spawn_wolf_ring(game, 500); }
+
+// 100 wolves in packs of 5, so pack plans (and their frame scratch) run
+void setup_wolf_packs(GameCoordinator& game, ScriptRng&) {
+    spawn_wolf_ring(game, 100);
+    WolfManager& wolves = game.get_wolf_manager();
+    for (int p = 0; p < 20; ++p) {
+        std::vector<uint32_t> ids;
+        for (int i = 0; i < 5; ++i) {
+            ids.push_back(wolves.get_wolf(p * 5 + i)->id);
+        }
+        wolves.create_pack(ids);
+    }
+}
+
+constexpr int STORM_BARRELS = 400;
+std::vector<uint32_t> g_storm_barrels;
+
+void setup_barrel_storm(GameCoordinator& game, ScriptRng& rng) {
+    // Same body parameters as the spawn_barrel export
+    PhysicsManager& physics = game.get_physics_manager();
+    g_storm_barrels.clear();
+    for (int i = 0; i < STORM_BARRELS; ++i) {
+        RigidBody barrel;
+        barrel.position = FixedVector3::from_floats(rng.unit(), rng.unit(), 0.0f);
+        barrel.mass = Fixed::from_float(PhysicsBarrel::BARREL_MASS);
+        barrel.inverse_mass = Fixed::from_float(1.0f / PhysicsBarrel::BARREL_MASS);
+        barrel.friction = Fixed::from_float(0.7f);
+        barrel.restitution = Fixed::from_float(0.3f);
+        barrel.drag = Fixed::from_float(0.95f);
+        barrel.radius = Fixed::from_float(PhysicsBarrel::BARREL_RADIUS);
+        barrel.type = BodyType::Dynamic;
+        g_storm_barrels.push_back(physics.create_body(barrel));
+    }
+    spawn_wolf_ring(game, 20);
+}
+
+// Throws a volley of 40 barrels every 20 ticks, like the throw_barrel export
+void script_barrel_storm(GameCoordinator& game, ScriptRng& rng, int tick) {
+    script_player_fights(game, rng, tick);
+    if (tick % 20 != 0) return;
+    PhysicsManager& physics = game.get_physics_manager();
+    for (int i = 0; i < 40; ++i) {
+        const uint32_t id = g_storm_barrels[rng.next() % g_storm_barrels.size()];
+        const float dx = rng.unit() * 2.0f - 1.0f;
+        const float dy = rng.unit() * 2.0f - 1.0f;
+        physics.apply_impulse(id, FixedVector3::from_floats(dx * 10.0f, dy * 10.0f, 0.0f));
+    }
+}
+
+constexpr int CHAIN_COUNT = 64;
+constexpr int CHAIN_LINKS = 6;
+std::vector<uint32_t> g_chain_anchors;
+
+// Kinematic anchors dragging hanging chains (the arm rig's constraint shape, at scale)
+void setup_arm_chains(GameCoordinator& game, ScriptRng&) {
+    PhysicsManager& physics = game.get_physics_manager();
+    g_chain_anchors.clear();
+    for (int c = 0; c < CHAIN_COUNT; ++c) {
+        const float x = 0.1f + 0.8f * static_cast<float>(c % 8) / 7.0f;
+        const float y = 0.2f + 0.7f * static_cast<float>(c / 8) / 7.0f;
+
+        RigidBody anchor;
+        anchor.type = BodyType::Kinematic;
+        anchor.position = FixedVector3::from_floats(x, y, 0.0f);
+        anchor.radius = Fixed::from_float(0.015f);
+        anchor.collision_mask = 0;
+        uint32_t prev = physics.create_body(anchor);
+        g_chain_anchors.push_back(prev);
+
+        for (int l = 1; l <= CHAIN_LINKS; ++l) {
+            RigidBody link;
+            link.type = BodyType::Dynamic;
+            link.position = FixedVector3::from_floats(x, y - 0.02f * static_cast<float>(l), 0.0f);
+            link.mass = Fixed::from_float(1.0f);
+            link.inverse_mass = Fixed::from_float(1.0f);
+            link.drag = Fixed::from_float(0.96f);
+            link.radius = Fixed::from_float(0.008f);
+            link.collision_layer = CollisionLayers::PlayerArm;
+            link.collision_mask = CollisionLayers::Enemy | CollisionLayers::Environment;
+            const uint32_t id = physics.create_body(link);
+
+            DistanceConstraint bone;
+            bone.bodyA = prev;
+            bone.bodyB = id;
+            bone.restLength = Fixed::from_float(0.02f);
+            bone.stiffness = Fixed::from_float(0.9f);
+            physics.add_distance_constraint(bone);
+            prev = id;
+        }
+    }
+    spawn_wolf_ring(game, 20);
+}
+
+void script_arm_chains(GameCoordinator& game, ScriptRng& rng, int tick) {
+    script_player_fights(game, rng, tick);
+    PhysicsManager& physics = game.get_physics_manager();
+    const float phase = static_cast<float>(tick) * 0.1f;
+    for (size_t c = 0; c < g_chain_anchors.size(); ++c) {
+        const float x = 0.1f + 0.8f * static_cast<float>(c % 8) / 7.0f;
+        const float y = 0.2f + 0.7f * static_cast<float>(c / 8) / 7.0f;
+        const float sway = 0.03f * std::sin(phase + static_cast<float>(c));
+        physics.set_position(g_chain_anchors[c], FixedVector3::from_floats(x + sway, y, 0.0f));
+    }
+    // The player's own arms reach for a point circling them
+    const float px = game.get_player_manager().get_x();
+    const float py = game.get_player_manager().get_y();
+    game.get_arm_manager().set_left_target(px + 0.1f * std::cos(phase), py + 0.1f * std::sin(phase), 0.0f);
+    game.get_arm_manager().set_right_target(px - 0.1f * std::cos(phase), py + 0.1f * std::sin(phase), 0.0f);
+}
+
+// 400 barrels under a steady inward pull, with a small short-lived blast
+// every 5 ticks and a passing gust every 30: many bounded fields, each
+// reaching only a few bodies
+void setup_force_fields(GameCoordinator& game, ScriptRng& rng) {
+    setup_barrel_storm(game, rng);
+    ForceField pull;
+    pull.type = ForceFieldType::RadialAttract;
+    pull.position = FixedVector3::from_floats(0.5f, 0.5f, 0.0f);
+    pull.direction = FixedVector3::zero();
+    pull.radius = Fixed::from_float(0.0f);
+    pull.strength = Fixed::from_float(0.02f);
+    game.get_physics_manager().add_force_field(pull, 0);
+}
+
+void script_force_fields(GameCoordinator& game, ScriptRng& rng, int tick) {
+    script_player_fights(game, rng, tick);
+    PhysicsManager& physics = game.get_physics_manager();
+    if (tick % 5 == 0) {
+        for (int i = 0; i < 4; ++i) {
+            ForceField blast;
+            blast.type = ForceFieldType::RadialRepel;
+            blast.position = FixedVector3::from_floats(rng.unit(), rng.unit(), 0.0f);
+            blast.direction = FixedVector3::zero();
+            blast.radius = Fixed::from_float(0.08f);
+            blast.strength = Fixed::from_float(0.5f);
+            physics.add_force_field(blast, 12);
+        }
+    }
+    if (tick % 30 == 0) {
+        ForceField gust;
+        gust.type = ForceFieldType::DirectionalWind;
+        gust.position = FixedVector3::from_floats(rng.unit(), rng.unit(), 0.0f);
+        gust.direction = FixedVector3::from_floats(rng.unit() * 2.0f - 1.0f, rng.unit() * 2.0f - 1.0f, 0.0f);
+        gust.radius = Fixed::from_float(0.2f);
+        gust.strength = Fixed::from_float(1.0f);
+        physics.add_force_field(gust, 20);
+    }
+}
+
+// 8x8 streamed chunks; the player walks out diagonally and back, so chunks
+// (terrain colliders and dormant packs) keep paging in and out
+void setup_world_stream(GameCoordinator& game, ScriptRng&) {
+    WorldMapConfig world;
+    world.chunks_x = 8;
+    world.chunks_y = 8;
+    world.chunk_size = 1.0f;
+    world.load_radius = 1.0f;
+    world.seed = 1234u;
+    game.configure_world(world);
+}
+
+void script_world_stream(GameCoordinator& game, ScriptRng&, int tick) {
+    const float move_x = (tick / 600) % 2 == 0 ? 1.0f : -1.0f;
+    const float move_y = (tick / 900) % 2 == 0 ? 0.7f : -0.7f;
+    game.set_player_input(move_x, move_y, 0, 0, tick % 20 == 3, 0, 0, 0);
+}
+
+const Scenario SCENARIOS[] = {
+    {"wolves_10", "10 wolves around a fighting player", setup_wolves_10, script_player_fights},
+    {"wolves_100", "100 wolves around a fighting player", setup_wolves_100, script_player_fights},
+    {"wolves_500", "500 wolves around a fighting player", setup_wolves_500, script_player_fights},
+    {"wolf_packs", "100 wolves in 20 packs around a fighting player", setup_wolf_packs, script_player_fights},
+    {"barrel_storm", "400 barrels thrown in volleys, 20 wolves", setup_barrel_storm, script_barrel_storm},
+    {"arm_chains", "64 swaying 6-link chains plus player arms, 20 wolves", setup_arm_chains, script_arm_chains},
+    {"force_fields", "400 barrels, a global pull, short-lived blasts and gusts", setup_force_fields, script_force_fields},
+    {"world_stream", "8x8 streamed chunks crossed by a walking player", setup_world_stream, script_world_stream},
+    {"rollback_100", "100 wolves, full snapshot save and restore every tick", setup_wolves_100, script_player_fights, true},
+};
+
+// ---- Measurement ----
+
+struct Percentiles {
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+Percentiles summarize(std::vector<double> samples) {
+    Percentiles out;
+    if (samples.empty()) return out;
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+    const auto at = [&](double q) {
+        return samples[static_cast<size_t>(q * static_cast<double>(samples.size() - 1) + 0.5)];
+    };
+    out.mean = sum / static_cast<double>(samples.size());
+    out.p50 = at(0.50);
+    out.p95 = at(0.95);
+    out.p99 = at(0.99);
+    out.max = samples.back();
+    return out;
+}
+
+struct Result {
+    const Scenario* scenario = nullptr;
+    int ticks = 0;
+    int bodies = 0;
+    int wolves = 0;
+    Percentiles tick_ns;
+    double zone_ns[PROFILE_ZONE_COUNT] = {};  // Mean ns/tick per profile zone
+    double allocs_per_tick = 0.0;
+    double alloc_bytes_per_tick = 0.0;
+    double pairs_per_tick = 0.0;
+    double events_per_tick = 0.0;  // Collision events the physics step produced
+    size_t arena_high_water = 0;  // Frame arena bytes, most in any tick
+    size_t snapshot_bytes = 0;    // GameCoordinator::save_state image of the final state
+    double snapshot_save_ns = 0.0;
+    double snapshot_load_ns = 0.0;
+};
+
+constexpr int SNAPSHOT_ITERATIONS = 20;
+
+// Save into image (sized on first use), then restore from it
+void save_image(GameCoordinator& game, std::vector<uint8_t>& image) {
+    if (image.empty()) {
+        SnapshotWriter counter;
+        game.save_state(counter);
+        image.resize(counter.size());
+    }
+    SnapshotWriter w(image.data(), image.size());
+    game.save_state(w);
+    if (!w.ok()) {
+        // The state grew since sizing; resize and write again
+        image.clear();
+        save_image(game, image);
+    }
+}
+
+bool load_image(GameCoordinator& game, const std::vector<uint8_t>& image) {
+    SnapshotReader r(image.data(), image.size());
+    return game.load_state(r);
+}
+
+void measure_snapshot(GameCoordinator& game, Result& result) {
+    std::vector<uint8_t> image;
+    save_image(game, image);
+    double save_ns = 0.0;
+    double load_ns = 0.0;
+    for (int i = 0; i < SNAPSHOT_ITERATIONS; ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+        save_image(game, image);
+        const auto t1 = std::chrono::steady_clock::now();
+        load_image(game, image);
+        const auto t2 = std::chrono::steady_clock::now();
+        save_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        load_ns += std::chrono::duration<double, std::nano>(t2 - t1).count();
+    }
+    result.snapshot_bytes = image.size();
+    result.snapshot_save_ns = save_ns / SNAPSHOT_ITERATIONS;
+    result.snapshot_load_ns = load_ns / SNAPSHOT_ITERATIONS;
+}
+
+Result run_scenario(const Scenario& scenario, int ticks) {
+    GameCoordinator game;
+    game.initialize(RUN_SEED, 0u);
+    game.get_physics_manager().enable_broadphase(true);
+
+    ScriptRng rng{SCRIPT_SEED};
+    scenario.setup(game, rng);
+
+    for (int t = 0; t < WARMUP_TICKS; ++t) {
+        scenario.script(game, rng, t);
+        game.update(TICK_DT);
+    }
+
+    std::vector<double> tick_ns;
+    tick_ns.reserve(static_cast<size_t>(ticks));
+    Result result;
+    result.scenario = &scenario;
+    result.ticks = ticks;
+    double zone_ms[PROFILE_ZONE_COUNT] = {};
+    uint64_t pairs = 0;
+    const PhysicsEventQueue& events = game.get_physics_manager().get_event_queue();
+    const uint32_t events_before = events.pushed() + events.dropped();
+    std::vector<uint8_t> rollback_image;
+    if (scenario.rollback_every_tick) {
+        save_image(game, rollback_image);  // Sized before counting starts
+    }
+    alloc_counter::set_enabled(false);  // Counted only while a tick runs
+    alloc_counter::reset();
+
+    for (int t = 0; t < ticks; ++t) {
+        scenario.script(game, rng, WARMUP_TICKS + t);
+        alloc_counter::set_enabled(true);
+        const auto start = std::chrono::steady_clock::now();
+        if (scenario.rollback_every_tick) {
+            save_image(game, rollback_image);
+            load_image(game, rollback_image);
+        }
+        game.update(TICK_DT);
+        const auto end = std::chrono::steady_clock::now();
+        alloc_counter::set_enabled(false);
+        tick_ns.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+
+        const ProfileFrame* frame = GetFrameProfiler().latest();
+        for (uint32_t z = 0; z < PROFILE_ZONE_COUNT; ++z) {
+            zone_ms[z] += frame->zone_ms[z];
+        }
+        pairs += game.get_physics_manager().get_pairs_checked();
+    }
+
+    const double n = static_cast<double>(ticks);
+    result.tick_ns = summarize(tick_ns);
+    for (uint32_t z = 0; z < PROFILE_ZONE_COUNT; ++z) {
+        result.zone_ns[z] = zone_ms[z] * 1.0e6 / n;
+    }
+    result.allocs_per_tick = static_cast<double>(alloc_counter::count()) / n;
+    result.alloc_bytes_per_tick = static_cast<double>(alloc_counter::bytes()) / n;
+    result.pairs_per_tick = static_cast<double>(pairs) / n;
+    result.events_per_tick = static_cast<double>(events.pushed() + events.dropped() - events_before) / n;
+    result.bodies = game.get_physics_manager().get_body_count();
+    result.wolves = game.get_wolf_manager().get_wolf_count();
+    result.arena_high_water = game.get_frame_arena().high_water();
+    measure_snapshot(game, result);
+    return result;
+}
+
+void print_result(const Result& r) {
+    std::printf("%-13s bodies %4d wolves %3d | tick us p50 %8.1f p95 %8.1f p99 %8.1f max %8.1f"
+                " | allocs/tick %7.1f (%8.0f B) pairs/tick %8.0f events/tick %6.1f arena %6zu B\n",
+        r.scenario->name, r.bodies, r.wolves,
+        r.tick_ns.p50 / 1e3, r.tick_ns.p95 / 1e3, r.tick_ns.p99 / 1e3, r.tick_ns.max / 1e3,
+        r.allocs_per_tick, r.alloc_bytes_per_tick, r.pairs_per_tick, r.events_per_tick, r.arena_high_water);
+    std::printf("             ");
+    for (uint32_t z = 1; z < PROFILE_ZONE_COUNT; ++z) {
+        if (r.zone_ns[z] >= 50.0) {
+            std::printf(" %s %.1f", profile_zone_name(static_cast<ProfileZone>(z)), r.zone_ns[z] / 1e3);
+        }
+    }
+    std::printf(" (us)\n");
+    std::printf("              snapshot %zu B save %.1f us load %.1f us\n",
+        r.snapshot_bytes, r.snapshot_save_ns / 1e3, r.snapshot_load_ns / 1e3);
+}
+
+bool write_json(const char* path, const std::vector<Result>& results) {
+    FILE* f = std::fopen(path, "w");
+    if (!f) return false;
+    std::fprintf(f, "{\n  \"benchmark\": \"dozedent_bench\",\n  \"target\": \"native\",\n  \"tickDt\": %.9g,\n"
+                    "  \"warmupTicks\": %d,\n  \"seed\": %llu,\n  \"scriptSeed\": %u,\n  \"scenarios\": [\n",
+                 TICK_DT, WARMUP_TICKS, RUN_SEED, SCRIPT_SEED);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(f,
+            "    {\n"
+            "      \"name\": \"%s\",\n"
+            "      \"description\": \"%s\",\n"
+            "      \"ticks\": %d,\n"
+            "      \"bodies\": %d,\n"
+            "      \"wolves\": %d,\n"
+            "      \"tickNs\": { \"mean\": %.0f, \"p50\": %.0f, \"p95\": %.0f, \"p99\": %.0f, \"max\": %.0f },\n"
+            "      \"subsystemNs\": {",
+            r.scenario->name, r.scenario->description, r.ticks, r.bodies, r.wolves,
+            r.tick_ns.mean, r.tick_ns.p50, r.tick_ns.p95, r.tick_ns.p99, r.tick_ns.max);
+        for (uint32_t z = 0; z < PROFILE_ZONE_COUNT; ++z) {
+            std::fprintf(f, "%s \"%s\": %.0f", z ? "," : "", profile_zone_name(static_cast<ProfileZone>(z)), r.zone_ns[z]);
+        }
+        std::fprintf(f,
+            " },\n"
+            "      \"allocsPerTick\": %.2f,\n"
+            "      \"allocBytesPerTick\": %.0f,\n"
+            "      \"pairsPerTick\": %.1f,\n"
+            "      \"eventsPerTick\": %.2f,\n"
+            "      \"arenaHighWaterBytes\": %zu,\n"
+            "      \"snapshot\": { \"bytes\": %zu, \"saveNs\": %.0f, \"loadNs\": %.0f }\n"
+            "    }%s\n",
+            r.allocs_per_tick, r.alloc_bytes_per_tick, r.pairs_per_tick, r.events_per_tick, r.arena_high_water,
+            r.snapshot_bytes, r.snapshot_save_ns, r.snapshot_load_ns,
+            i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+
+// ---- Headless instances ----
+
+void fill_instance_inputs(std::vector<SimInputFrame>& frames, int instance, int ticks) {
+    frames.resize(static_cast<size_t>(ticks));
+    for (int t = 0; t < ticks; ++t) {
+        const float phase = static_cast<float>(t) * 0.05f + static_cast<float>(instance);
+        SimInputFrame& in = frames[static_cast<size_t>(t)];
+        in.move_x = std::cos(phase);
+        in.move_y = std::sin(phase);
+        in.rolling = (t + instance) % 120 == 0;
+        in.light_attack = (t + instance) % 20 == 0;
+        in.heavy_attack = (t + instance) % 90 == 45;
+        in.blocking = (t + instance) % 60 >= 50;
+    }
+}
+
+SimInstance* make_instance(int instance) {
+    SimInstance* sim = sim_create(1000ull + static_cast<unsigned long long>(instance), 0u);
+    for (int w = 0; w < 10; ++w) {
+        const float angle = static_cast<float>(w) * 0.6283f;
+        sim_spawn_wolf(sim, 0.5f + 0.15f * std::cos(angle), 0.5f + 0.15f * std::sin(angle), w % 5);
+    }
+    return sim;
+}
+
+int run_instances(int count, int threads, int ticks) {
+    std::vector<std::vector<SimInputFrame>> frames(static_cast<size_t>(count));
+    std::vector<const SimInputFrame*> inputs(static_cast<size_t>(count));
+    std::vector<SimInstance*> sims(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        fill_instance_inputs(frames[static_cast<size_t>(i)], i, ticks);
+        inputs[static_cast<size_t>(i)] = frames[static_cast<size_t>(i)].data();
+        sims[static_cast<size_t>(i)] = make_instance(i);
+    }
+
+    SimThreadPool pool(threads);
+    const auto start = std::chrono::steady_clock::now();
+    pool.step_all(sims.data(), inputs.data(), count, ticks);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Sample instances replayed alone must reach the same state
+    const int sample = std::min(count, 16);
+    int mismatches = 0;
+    for (int i = 0; i < sample; ++i) {
+        const int index = i * count / sample;
+        SimInstance* alone = make_instance(index);
+        sim_step(alone, inputs[static_cast<size_t>(index)], ticks);
+        mismatches += sim_get_state_hash(alone) != sim_get_state_hash(sims[static_cast<size_t>(index)]);
+        sim_destroy(alone);
+    }
+    for (SimInstance* sim : sims) {
+        sim_destroy(sim);
+    }
+
+    std::printf("instances %5d threads %3d ticks %5d | %9.1f ms  %10.0f instance-ticks/s | sequential check %d/%d %s\n",
+        count, pool.get_thread_count(), ticks, ms, static_cast<double>(count) * ticks * 1000.0 / ms,
+        sample - mismatches, sample, mismatches ? "MISMATCH" : "match");
+    return mismatches ? 1 : 0;
+}
+
+// ---- Input logs ----
+
+constexpr uint16_t LOG_CHECKPOINT_INTERVAL = 60;
+
+void print_checkpoints(const std::vector<ReplayCheckpoint>& checkpoints) {
+    for (const ReplayCheckpoint& checkpoint : checkpoints) {
+        std::printf("checkpoint %6u %016llx\n", checkpoint.tick, static_cast<unsigned long long>(checkpoint.hash));
+    }
+}
+
+int record_log(const char* path, int ticks) {
+    std::vector<SimInputFrame> frames;
+    fill_instance_inputs(frames, 0, ticks);
+    InputLogWriter writer;
+    writer.begin(1000ull, 0u, LOG_CHECKPOINT_INTERVAL);
+    SimInstance sim(1000ull, 0u);
+    std::vector<ReplayCheckpoint> checkpoints;
+    for (int t = 0; t < ticks; ++t) {
+        const SimInputFrame in = writer.record(static_cast<uint32_t>(t), frames[static_cast<size_t>(t)]);
+        sim.step(&in, 1);
+        if ((t + 1) % LOG_CHECKPOINT_INTERVAL == 0 || t + 1 == ticks) {
+            checkpoints.push_back({sim.get_tick(), sim.get_state_hash()});
+        }
+    }
+    const std::vector<uint8_t>& bytes = writer.finish();
+    FILE* f = std::fopen(path, "wb");
+    if (!f || std::fwrite(bytes.data(), 1, bytes.size(), f) != bytes.size() || std::fclose(f) != 0) {
+        std::fprintf(stderr, "could not write %s\n", path);
+        return 1;
+    }
+    std::printf("recorded %d ticks, %zu bytes -> %s\n", ticks, bytes.size(), path);
+    print_checkpoints(checkpoints);
+    return 0;
+}
+
+int replay_log(const char* path) {
+    std::vector<uint8_t> bytes;
+    if (FILE* f = std::fopen(path, "rb")) {
+        uint8_t chunk[4096];
+        size_t n = 0;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) {
+            bytes.insert(bytes.end(), chunk, chunk + n);
+        }
+        std::fclose(f);
+    }
+    InputLogReader reader;
+    if (!reader.open(bytes.data(), bytes.size())) {
+        std::fprintf(stderr, "not an input log: %s\n", path);
+        return 2;
+    }
+    SimInstance sim(reader.header().seed, reader.header().start_weapon);
+    std::vector<ReplayCheckpoint> checkpoints;
+    const auto start = std::chrono::steady_clock::now();
+    const uint32_t ticks = replay_input_log(sim.get_coordinator(), reader, UINT32_MAX, checkpoints);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("replayed %u ticks in %.1f ms (%.0f ticks/s)\n", ticks, ms, ticks * 1000.0 / ms);
+    print_checkpoints(checkpoints);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int ticks = 600;
+    const char* only = nullptr;
+    const char* json_path = nullptr;
+    int instances = 0;
+    int threads = 0;
+    const char* record_path = nullptr;
+    const char* replay_path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            ticks = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+            only = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--instances") == 0 && i + 1 < argc) {
+            instances = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--record-log") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--ticks N] [--scenario NAME] [--json FILE]"
+                                 " | --instances N [--threads T] [--ticks N]"
+                                 " | --record-log FILE [--ticks N] | --replay FILE\n", argv[0]);
+            return 2;
+        }
+    }
+    if (instances > 0) {
+        return run_instances(instances, threads, ticks);
+    }
+    if (record_path) {
+        return record_log(record_path, ticks);
+    }
+    if (replay_path) {
+        return replay_log(replay_path);
+    }
+
+    std::vector<Result> results;
+    for (const Scenario& scenario : SCENARIOS) {
+        if (only && std::strcmp(only, scenario.name) != 0) continue;
+        results.push_back(run_scenario(scenario, ticks));
+        print_result(results.back());
+    }
+    if (results.empty()) {
+        std::fprintf(stderr, "unknown scenario: %s\n", only);
+        return 2;
+    }
+    if (json_path && !write_json(json_path, results)) {
+        std::fprintf(stderr, "could not write %s\n", json_path);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * skeleton_batch_bench - SkeletonBatch against one PlayerSkeleton per instance
+ *
+ * Steps M skeletons both ways from the same rest poses for --ticks, times
+ * each, and compares every joint afterwards. Exits non-zero if the batch
+ * differs in any bit (tests/skeleton_batch_test.cpp checks every tick).
+ *
+ *   cmake -S public -B build -DDOZEDENT_BUILD_BENCH=ON
+ *   cmake --build build --target skeleton_batch_bench && ./build/skeleton_batch_bench --instances 64
+ */
+#include "physics/SkeletonBatch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace SkeletonPhysics;
+
+namespace {
+
+const Fixed TICK_DT = Fixed::from_float(1.0f / 60.0f);
+
+// PlayerSkeleton joints in HumanoidJoint order
+Joint PlayerSkeleton::* const JOINTS[SkeletonBatch::JOINT_COUNT] = {
+    &PlayerSkeleton::head, &PlayerSkeleton::neck, &PlayerSkeleton::chest,
+    &PlayerSkeleton::mid_spine, &PlayerSkeleton::lower_spine, &PlayerSkeleton::pelvis,
+    &PlayerSkeleton::shoulder_l, &PlayerSkeleton::shoulder_r, &PlayerSkeleton::elbow_l,
+    &PlayerSkeleton::elbow_r, &PlayerSkeleton::wrist_l, &PlayerSkeleton::wrist_r,
+    &PlayerSkeleton::hand_l, &PlayerSkeleton::hand_r, &PlayerSkeleton::hip_l, &PlayerSkeleton::hip_r,
+    &PlayerSkeleton::knee_l, &PlayerSkeleton::knee_r, &PlayerSkeleton::ankle_l, &PlayerSkeleton::ankle_r,
+    &PlayerSkeleton::heel_l, &PlayerSkeleton::heel_r, &PlayerSkeleton::foot_l, &PlayerSkeleton::foot_r,
+    &PlayerSkeleton::toe_l, &PlayerSkeleton::toe_r
+};
+
+// Spread along x, dropped from staggered heights so contacts differ per instance
+Fixed start_x(int i) { return Fixed::from_float(0.05f + 0.9f * static_cast<float>(i % 16) / 16.0f); }
+Fixed start_y(int i) { return Fixed::from_float(-0.1f - 0.02f * static_cast<float>(i % 13)); }
+const Fixed SCALE = Fixed::from_float(0.2f);
+
+template <typename Fn>
+double ns_per_tick(Fn step, int ticks) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        step();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ticks;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int instances = 64;
+    int ticks = 600;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--instances") == 0) instances = std::max(1, std::atoi(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--ticks") == 0) ticks = std::max(1, std::atoi(argv[i + 1]));
+    }
+
+    // Constraints point into each skeleton, so the vector is never resized after this
+    std::vector<PlayerSkeleton> skeletons(static_cast<size_t>(instances));
+    SkeletonBatch batch(static_cast<uint32_t>(instances));
+    for (int i = 0; i < instances; ++i) {
+        skeletons[i].initialize(start_x(i), start_y(i), SCALE);
+        batch.add(start_x(i), start_y(i), SCALE);
+    }
+
+    const double single_ns = ns_per_tick([&] {
+        for (PlayerSkeleton& sk : skeletons) {
+            sk.update(TICK_DT);
+        }
+    }, ticks);
+    const double batch_ns = ns_per_tick([&] { batch.update(TICK_DT); }, ticks);
+
+    uint64_t mismatches = 0;
+    for (int i = 0; i < instances; ++i) {
+        for (int j = 0; j < SkeletonBatch::JOINT_COUNT; ++j) {
+            const Joint& joint = skeletons[i].*JOINTS[j];
+            const uint32_t k = static_cast<uint32_t>(i);
+            if (batch.joint_x(k, j).raw != joint.x.raw || batch.joint_y(k, j).raw != joint.y.raw) {
+                ++mismatches;
+            }
+        }
+    }
+
+    std::printf("%d skeletons, %d ticks: %llu joint mismatches after the run\n", instances, ticks,
+        static_cast<unsigned long long>(mismatches));
+    std::printf("PlayerSkeleton  %.2f us/tick (%.0f ns per skeleton)\n", single_ns / 1e3, single_ns / instances);
+    std::printf("SkeletonBatch   %.2f us/tick (%.0f ns per skeleton, %.2fx)\n", batch_ns / 1e3,
+        batch_ns / instances, single_ns / batch_ns);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -15,6 +15,7 @@ export class ProgressionBridge {
     this.exports = wasmApi?.exports || {};
     this.memory = wasmApi?.memory || null;
     this.codec = null;
+    this.effectKeyIds = new Map();
     if (this.memory && typeof this.exports.malloc === 'function') {
       this.codec = createStringCodec({ memory: this.memory, exports: this.exports });
     }
@@ -78,7 +79,26 @@ export class ProgressionBridge {
     this.exports.upgrade_reset_class(classId);
   }
 
+  // Interned key id (stable for the session), or -1 when the export is missing
+  getEffectKeyId(key) {
+    let id = this.effectKeyIds.get(key);
+    if (id !== undefined) {return id;}
+    if (!this.codec || typeof this.exports.upgrade_get_effect_key_id !== 'function') {return -1;}
+    const { ptr, len } = this.codec.toWasm(key);
+    try {
+      id = this.exports.upgrade_get_effect_key_id(ptr, len) | 0;
+    } finally {
+      if (typeof this.exports.free === 'function') {this.exports.free(ptr);}
+    }
+    this.effectKeyIds.set(key, id);
+    return id;
+  }
+
   getEffectScalar(classId, key) {
+    if (typeof this.exports.upgrade_get_effect_scalar_id === 'function') {
+      const id = this.getEffectKeyId(key);
+      if (id >= 0) {return this.exports.upgrade_get_effect_scalar_id(classId, id) / 65536.0;}
+    }
     if (!this.codec || typeof this.exports.upgrade_get_effect_scalar !== 'function') {return 0;}
     const { ptr, len } = this.codec.toWasm(key);
     try {
@@ -69,7 +69,7 @@ inputManager = createInputManager(wasmApi, {
 
 vfxManager = new VFXManager(canvas);
 progressionManager = new ProgressionManager(Promise.resolve({ exports: wasmApi.exports, memory: wasmApi.memory }));
-await progressionManager.init();
+await progressionManager.init({ classes: ['warden'] });
 // Default to WARDEN progression for demo
 progressionManager.loadClassState('warden');
 // Optional: mount minimal UI if container exists
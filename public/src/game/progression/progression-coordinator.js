@@ -13,7 +13,7 @@ export class ProgressionCoordinator {
   }
 
   async start() {
-    await this.pm.init();
+    await this.pm.init({ classes: [this.classId] });
     const tree = this.pm.trees.get(this.classId);
     this.vm = new ProgressionViewModel(this.pm);
     this.vm.attach(this.classId);
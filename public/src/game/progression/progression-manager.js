@@ -8,6 +8,8 @@ function fetchJson(url) {
   });
 }
 
+const CLASS_IDS = ['warden', 'raider', 'kensei'];
+
 export class ProgressionManager {
   constructor(modulePromise, basePath = null) {
     this.modulePromise = modulePromise; // Promise resolving to Emscripten Module
@@ -18,25 +20,31 @@ export class ProgressionManager {
     this.store = new LocalProgressStore();
     this.bridge = null;
     this.trees = new Map();
+    this.pendingTrees = new Map(); // classId => Promise while a tree is loading
     this.cachedScalars = new Map(); // key: `${classId}:${effectKey}` => number
     this.listeners = { stateChanged: new Set(), essenceChanged: new Set(), purchaseFailed: new Set() };
   }
 
-  async init() {
+  // classes: trees to load now (default: all). Others load on first ensureClass.
+  async init({ classes = CLASS_IDS } = {}) {
     const Module = await this.modulePromise;
     this.bridge = new ProgressionBridge(Module);
-    const [warden, raider, kensei] = await Promise.all([
-      fetchJson(new URL('../../data/upgrades/warden.json', import.meta.url).href),
-      fetchJson(new URL('../../data/upgrades/raider.json', import.meta.url).href),
-      fetchJson(new URL('../../data/upgrades/kensei.json', import.meta.url).href)
-    ]);
-    this.trees.set('warden', warden);
-    this.trees.set('raider', raider);
-    this.trees.set('kensei', kensei);
-    // Seed trees into WASM
-    for (const [classId, tree] of this.trees) {
-      this.bridge.setTree(this.classIdToInt(classId), JSON.stringify(tree));
+    await Promise.all(classes.map(classId => this.ensureClass(classId)));
+  }
+
+  // Fetches a class's upgrade tree and seeds it into WASM, once
+  ensureClass(classId) {
+    if (this.trees.has(classId)) {return Promise.resolve(this.trees.get(classId));}
+    if (!this.pendingTrees.has(classId)) {
+      const url = new URL(`../../data/upgrades/${classId}.json`, import.meta.url).href;
+      const pending = fetchJson(url).then(tree => {
+        this.trees.set(classId, tree);
+        this.bridge.setTree(this.classIdToInt(classId), JSON.stringify(tree));
+        return tree;
+      }).finally(() => this.pendingTrees.delete(classId));
+      this.pendingTrees.set(classId, pending);
     }
+    return this.pendingTrees.get(classId);
   }
 
   classIdToInt(classId) {
@@ -1,5 +1,6 @@
 // EnemyRenderer.js
 // Handles enemy rendering and state visualization
+import { WolfRenderStateReader, WolfRenderField as F } from '../state/WolfRenderStateReader.js'
 
 export class EnemyRenderer {
   constructor(canvas) {
@@ -7,6 +8,16 @@ export class EnemyRenderer {
     this.ctx = canvas.getContext('2d', { alpha: false })
     this.wolfAnimEnabled = false
     this.wasmExports = null
+    this.renderReader = null
+    this.useBulkState = false
+  }
+
+  // Bulk render buffer: a single view per frame instead of ~25 export calls per wolf
+  _getRenderReader(ex) {
+    if (!this.renderReader || this.renderReader.exports !== ex) {
+      this.renderReader = new WolfRenderStateReader(ex)
+    }
+    return this.renderReader.available() ? this.renderReader : null
   }
 
   /**
@@ -107,6 +118,11 @@ export class EnemyRenderer {
   renderEnemies(wasmApi) {
     try {
       const ex = wasmApi.exports || {}
+      const reader = this._getRenderReader(ex)
+      if (reader) {
+        this.renderEnemiesBulk(reader)
+        return
+      }
       if (typeof ex.get_enemy_count !== 'function') {
         return
       }
@@ -135,6 +151,45 @@ export class EnemyRenderer {
     }
   }
 
+  renderEnemiesBulk(reader) {
+    const count = reader.refresh()
+    const { u32, f32 } = reader
+    this.useBulkState = true
+
+    // First pass: pack coordination lines
+    for (let i = 0; i < count; i += 1) {
+      const bi = reader.base(i)
+      const packId1 = u32[bi + F.PACK_ID]
+      if (packId1 === 0) {
+        continue
+      }
+      const pos1 = this.worldToCanvas(f32[bi + F.X], f32[bi + F.Y])
+      for (let j = i + 1; j < count; j += 1) {
+        const bj = reader.base(j)
+        if (u32[bj + F.PACK_ID] !== packId1) {
+          continue
+        }
+        const pos2 = this.worldToCanvas(f32[bj + F.X], f32[bj + F.Y])
+        this.ctx.strokeStyle = 'rgba(255, 255, 255, 0.3)'
+        this.ctx.lineWidth = 1
+        this.ctx.beginPath()
+        this.ctx.moveTo(pos1.x, pos1.y)
+        this.ctx.lineTo(pos2.x, pos2.y)
+        this.ctx.stroke()
+      }
+    }
+
+    // Second pass: individual wolves
+    for (let i = 0; i < count; i += 1) {
+      const b = reader.base(i)
+      this.renderEnemy(
+        f32[b + F.X], f32[b + F.Y],
+        u32[b + F.STATE], u32[b + F.EMOTION], u32[b + F.TYPE], u32[b + F.PACK_ID], i
+      )
+    }
+    this.useBulkState = false
+  }
+
   renderPackCoordination(wasmExports, enemyCount) {
     const packCount = wasmExports.get_pack_count?.() | 0
     if (packCount === 0) {
@@ -229,12 +284,21 @@ export class EnemyRenderer {
   renderAnimatedWolf(pos, index, stateId, emotionId, packId) {
     const ex = this.wasmExports
     
-    // Read animation data from WASM
-    const bodyBob = ex.get_wolf_body_bob(index)
-    const headPitch = ex.get_wolf_head_pitch(index)
-    const headYaw = ex.get_wolf_head_yaw(index)
-    const tailWag = ex.get_wolf_tail_wag(index)
-    const bodyStretch = ex.get_wolf_body_stretch(index)
+    // Read animation data from the bulk buffer when rendering from it, else per-field exports
+    let bodyBob, headYaw, tailWag, bodyStretch
+    if (this.useBulkState) {
+      const { f32 } = this.renderReader
+      const b = this.renderReader.base(index)
+      bodyBob = f32[b + F.BODY_BOB]
+      headYaw = f32[b + F.HEAD_YAW]
+      tailWag = f32[b + F.TAIL_WAG]
+      bodyStretch = f32[b + F.BODY_STRETCH]
+    } else {
+      bodyBob = ex.get_wolf_body_bob(index)
+      headYaw = ex.get_wolf_head_yaw(index)
+      tailWag = ex.get_wolf_tail_wag(index)
+      bodyStretch = ex.get_wolf_body_stretch(index)
+    }
     
     // Validate all data is finite
     if (!Number.isFinite(bodyBob) || !Number.isFinite(headYaw)) {
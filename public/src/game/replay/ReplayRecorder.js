@@ -2,6 +2,19 @@
 // Records gameplay for deterministic replay
 // Single responsibility: capture and store replay data
 
+// Binary input log layout, mirrored from public/src/wasm/coordinators/InputLog.h
+const INPUT_LOG_MAGIC = 0x4C495A44 // "DZIL"
+const INPUT_LOG_VERSION = 1
+const INPUT_LOG_HEADER_BYTES = 24
+const INPUT_LOG_RECORD_BYTES = 8
+const INPUT_LOG_BUTTONS = ['roll', 'jump', 'light', 'heavy', 'block', 'special']
+
+function quantizeAxis(value) {
+  const clamped = Math.max(-1, Math.min(1, Number(value) || 0))
+  // Halves round away from zero, as lround does on the WASM side
+  return Math.sign(clamped) * Math.round(Math.abs(clamped) * 127)
+}
+
 /**
  * ReplayRecorder captures input frames and game state for replay.
  * Implements deterministic replay for multiplayer validation.
@@ -87,6 +100,50 @@ export class ReplayRecorder {
     }
   }
 
+  /**
+   * Export the recorded input as a binary log for the WASM replay_run export.
+   * Ticks are renumbered from 0; a record is written only when the quantized
+   * input changes. Replays are exact for fixed 60 Hz sessions.
+   * @param {Object} options - startWeapon, checkpointInterval (ticks)
+   * @returns {Uint8Array}
+   */
+  exportInputLog(options = {}) {
+    const inputs = this.frames.filter(frame => frame.type !== 'snapshot')
+    const records = []
+    let last = null
+    inputs.forEach((frame, tick) => {
+      const input = frame.input || {}
+      const flags = input.flags || {}
+      const record = {
+        tick,
+        x: quantizeAxis(input.axisX),
+        y: quantizeAxis(input.axisY),
+        buttons: INPUT_LOG_BUTTONS.reduce((bits, name, bit) => (flags[name] ? bits | (1 << bit) : bits), 0)
+      }
+      if (!last || record.x !== last.x || record.y !== last.y || record.buttons !== last.buttons) {
+        records.push(record)
+        last = record
+      }
+    })
+
+    const bytes = new Uint8Array(INPUT_LOG_HEADER_BYTES + records.length * INPUT_LOG_RECORD_BYTES)
+    const view = new DataView(bytes.buffer)
+    view.setUint32(0, INPUT_LOG_MAGIC, true)
+    view.setUint16(4, INPUT_LOG_VERSION, true)
+    view.setUint16(6, options.checkpointInterval || 0, true)
+    view.setBigUint64(8, BigInt.asUintN(64, BigInt(Math.trunc(Number(this.metadata.seed) || 0))), true)
+    view.setUint32(16, options.startWeapon || 0, true)
+    view.setUint32(20, inputs.length, true)
+    records.forEach((record, i) => {
+      const offset = INPUT_LOG_HEADER_BYTES + i * INPUT_LOG_RECORD_BYTES
+      view.setUint32(offset, record.tick, true)
+      view.setInt8(offset + 4, record.x)
+      view.setInt8(offset + 5, record.y)
+      view.setUint8(offset + 6, record.buttons)
+    })
+    return bytes
+  }
+
   /**
    * Import replay data
    */
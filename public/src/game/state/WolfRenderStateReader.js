@@ -0,0 +1,101 @@
+// WolfRenderStateReader.js
+// Zero-copy view over the WASM wolf render buffer (see wolves/WolfRenderState.h)
+// - One export call for the pointer and one for the count per frame
+// - Falls back (available() === false) when exports or layout version differ
+
+export const WOLF_RENDER_STATE_VERSION = 1
+export const WOLF_RENDER_STATE_WORDS = 32
+
+// Word offsets within one record
+export const WolfRenderField = Object.freeze({
+  ID: 0,
+  TYPE: 1,
+  STATE: 2,
+  EMOTION: 3,
+  PACK_ROLE: 4,
+  PACK_ID: 5,
+  ATTACK_TYPE: 6,
+  AI_TIER: 7,
+  X: 8,
+  Y: 9,
+  VX: 10,
+  VY: 11,
+  FACING_X: 12,
+  FACING_Y: 13,
+  HEALTH: 14,
+  MAX_HEALTH: 15,
+  STAMINA: 16,
+  BODY_STRETCH: 17,
+  HEAD_PITCH: 18,
+  HEAD_YAW: 19,
+  TAIL_WAG: 20,
+  BODY_BOB: 21,
+  EAR_ROTATION: 22, // 2 words
+  LEG_POSITIONS: 24 // 4 legs x (x, y)
+})
+
+export class WolfRenderStateReader {
+  constructor(wasmExports, memory = null) {
+    this.exports = wasmExports || {}
+    this.memory = memory || this.exports.memory || null
+    this.count = 0
+    this.u32 = null
+    this.f32 = null
+    this._buffer = null
+    this._ptr = 0
+    this._supported = this._checkSupport()
+  }
+
+  available() {
+    return this._supported
+  }
+
+  // Refresh views for the current frame; returns the record count
+  refresh() {
+    if (!this._supported) {return 0}
+    const ex = this.exports
+    const ptr = ex.get_wolf_render_state_ptr() >>> 0
+    const count = ex.get_wolf_render_state_count() | 0
+    const buffer = this.memory.buffer
+    if (!ptr || count <= 0) {
+      this.count = 0
+      return 0
+    }
+    // Memory growth detaches old views; the pointer moves when the wolf count grows
+    if (buffer !== this._buffer || ptr !== this._ptr || !this.u32 || this.u32.length < count * WOLF_RENDER_STATE_WORDS) {
+      this.u32 = new Uint32Array(buffer, ptr, count * WOLF_RENDER_STATE_WORDS)
+      this.f32 = new Float32Array(buffer, ptr, count * WOLF_RENDER_STATE_WORDS)
+      this._buffer = buffer
+      this._ptr = ptr
+    }
+    this.count = count
+    return count
+  }
+
+  // Word offset of record i; read with reader.u32[base + field] / reader.f32[base + field]
+  base(i) {
+    return i * WOLF_RENDER_STATE_WORDS
+  }
+
+  _checkSupport() {
+    const ex = this.exports
+    if (
+      typeof ex.get_wolf_render_state_ptr !== 'function' ||
+      typeof ex.get_wolf_render_state_count !== 'function' ||
+      typeof ex.get_wolf_render_state_version !== 'function' ||
+      !this.memory
+    ) {
+      return false
+    }
+    if ((ex.get_wolf_render_state_version() >>> 0) !== WOLF_RENDER_STATE_VERSION) {
+      console.warn('[WolfRenderState] Layout version mismatch, using per-field exports')
+      return false
+    }
+    if (typeof ex.get_wolf_render_state_stride === 'function' &&
+        (ex.get_wolf_render_state_stride() >>> 0) !== WOLF_RENDER_STATE_WORDS * 4) {
+      console.warn('[WolfRenderState] Stride mismatch, using per-field exports')
+      return false
+    }
+    return true
+  }
+}
@@ -1,13 +1,24 @@
 // WolfStateManager.js
 // Read-only facade for wolf and pack snapshots from WASM exports
+// - Reads the bulk render buffer when available (one view, no per-field calls)
 // - Uses new wolf-specific exports when available (Phase 1+)
 // - Falls back to existing enemy exports for compatibility
+import { WolfRenderStateReader, WolfRenderField as F } from './WolfRenderStateReader.js'
 
 export class WolfStateManager {
   constructor(wasmExports) {
     this.exports = wasmExports || {}
     this._lastSnapshotTick = -1
     this._cachedSnapshot = { wolves: [], packs: [], valid: false }
+    this._renderReader = null
+  }
+
+  // Bulk reader bound to the current exports object (exports may be swapped on reload)
+  _getRenderReader() {
+    if (!this._renderReader || this._renderReader.exports !== this.exports) {
+      this._renderReader = new WolfRenderStateReader(this.exports)
+    }
+    return this._renderReader.available() ? this._renderReader : null
   }
 
   // Public API: get immutable snapshot once per frame
@@ -50,7 +61,29 @@ export class WolfStateManager {
     )
   }
 
+  _readWolvesBulk(reader) {
+    const count = Math.min(reader.refresh(), 1024)
+    const { u32, f32 } = reader
+    const wolves = new Array(count)
+    for (let i = 0; i < count; i++) {
+      const b = reader.base(i)
+      wolves[i] = Object.freeze({
+        index: i,
+        position: [this._num(f32[b + F.X], 0), this._num(f32[b + F.Y], 0)],
+        health: this._num(f32[b + F.HEALTH], 1),
+        state: u32[b + F.STATE] | 0,
+        emotion: u32[b + F.EMOTION] | 0
+      })
+    }
+    return wolves
+  }
+
   _readWolves() {
+    const reader = this._getRenderReader()
+    if (reader) {
+      return this._readWolvesBulk(reader)
+    }
+
     // Prefer explicit enemy count until get_wolf_count exists
     const ex = this.exports
     const countFn = ex.get_wolf_count || ex.get_enemy_count
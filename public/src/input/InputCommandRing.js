@@ -0,0 +1,143 @@
+// InputCommandRing.js
+// Writer for the WASM input command ring (see wasm/managers/InputCommandRing.h)
+// - Commands go straight into WASM memory; update() drains them, so input costs no export calls
+// - Falls back (available() === false) when exports or layout version differ
+
+export const INPUT_COMMAND_RING_VERSION = 1
+export const INPUT_COMMAND_STRIDE = 24
+export const INPUT_COMMAND_HEADER_BYTES = 32
+
+export const InputCommandType = Object.freeze({
+  STATE: 0,
+  LIGHT_ATTACK: 1,
+  HEAVY_ATTACK: 2,
+  SPECIAL_ATTACK: 3,
+  ROLL: 4,
+  BASH_CHARGE: 5,
+  BASH_RELEASE: 6,
+  LEFT_HAND_TARGET: 7,
+  RIGHT_HAND_TARGET: 8
+})
+
+export const InputButton = Object.freeze({
+  ROLL: 1 << 0,
+  JUMP: 1 << 1,
+  LIGHT_ATTACK: 1 << 2,
+  HEAVY_ATTACK: 1 << 3,
+  BLOCK: 1 << 4,
+  SPECIAL: 1 << 5
+})
+
+// Header word offsets (u32)
+const H_CAPACITY = 1
+const H_WRITE = 2
+const H_READ = 3
+const H_FRAME = 4
+const H_DROPPED = 5
+const H_HOST_TIME_F64 = 3 // f64 index of host_time_ms
+
+const now = () => (typeof performance !== 'undefined' ? performance.now() : Date.now())
+
+export class InputCommandRing {
+  constructor(wasmExports, memory = null) {
+    this.exports = wasmExports || {}
+    this.memory = memory || this.exports.memory || null
+    this.ptr = 0
+    this.capacity = 0
+    this._buffer = null
+    this._supported = this._checkSupport()
+  }
+
+  available() {
+    return this._supported
+  }
+
+  // Held input, as set_player_input(x, y, roll, jump, light, heavy, block, special)
+  writeState(x, y, roll, jump, light, heavy, block, special, timeMs = now()) {
+    const buttons = (roll ? InputButton.ROLL : 0) | (jump ? InputButton.JUMP : 0) |
+      (light ? InputButton.LIGHT_ATTACK : 0) | (heavy ? InputButton.HEAVY_ATTACK : 0) |
+      (block ? InputButton.BLOCK : 0) | (special ? InputButton.SPECIAL : 0)
+    return this.write(InputCommandType.STATE, x, y, 0, buttons, timeMs)
+  }
+
+  // A press (LIGHT_ATTACK .. ROLL), retried by the simulation for the input buffer window
+  press(type, timeMs = now()) {
+    return this.write(type, 0, 0, 0, 0, timeMs)
+  }
+
+  // Returns false (and counts a drop) when the ring is full or unavailable
+  write(type, x = 0, y = 0, z = 0, buttons = 0, timeMs = now()) {
+    if (!this._supported || !this._views()) {return false}
+    const head = this.u32
+    const write = head[H_WRITE]
+    if (((write - head[H_READ]) >>> 0) >= this.capacity) {
+      head[H_DROPPED] = (head[H_DROPPED] + 1) >>> 0
+      return false
+    }
+    const slot = (write & (this.capacity - 1)) * INPUT_COMMAND_STRIDE
+    const view = this.view
+    view.setUint32(slot, head[H_FRAME], true)
+    view.setFloat32(slot + 4, timeMs, true)
+    view.setUint8(slot + 8, type)
+    view.setUint8(slot + 9, buttons)
+    view.setUint16(slot + 10, 0, true)
+    view.setFloat32(slot + 12, x, true)
+    view.setFloat32(slot + 16, y, true)
+    view.setFloat32(slot + 20, z, true)
+    // Publish after the payload
+    head[H_WRITE] = (write + 1) >>> 0
+    return true
+  }
+
+  // Call right before update(); stamps the clock press ages are measured against
+  flush(timeMs = now()) {
+    if (!this._supported || !this._views()) {return}
+    this.f64[H_HOST_TIME_F64] = timeMs
+  }
+
+  pending() {
+    if (!this._supported || !this._views()) {return 0}
+    return (this.u32[H_WRITE] - this.u32[H_READ]) >>> 0
+  }
+
+  dropped() {
+    if (!this._supported || !this._views()) {return 0}
+    return this.u32[H_DROPPED]
+  }
+
+  // Memory growth detaches old views
+  _views() {
+    const buffer = this.memory.buffer
+    if (buffer !== this._buffer) {
+      this.u32 = new Uint32Array(buffer, this.ptr, INPUT_COMMAND_HEADER_BYTES / 4)
+      this.f64 = new Float64Array(buffer, this.ptr, INPUT_COMMAND_HEADER_BYTES / 8)
+      this.view = new DataView(buffer, this.ptr + INPUT_COMMAND_HEADER_BYTES, this.capacity * INPUT_COMMAND_STRIDE)
+      this._buffer = buffer
+    }
+    return true
+  }
+
+  _checkSupport() {
+    const ex = this.exports
+    if (
+      typeof ex.get_input_command_ring_ptr !== 'function' ||
+      typeof ex.get_input_command_ring_version !== 'function' ||
+      !this.memory
+    ) {
+      return false
+    }
+    if ((ex.get_input_command_ring_version() >>> 0) !== INPUT_COMMAND_RING_VERSION) {
+      console.warn('[InputCommandRing] Layout version mismatch, using per-call input exports')
+      return false
+    }
+    if (typeof ex.get_input_command_stride === 'function' &&
+        (ex.get_input_command_stride() >>> 0) !== INPUT_COMMAND_STRIDE) {
+      console.warn('[InputCommandRing] Stride mismatch, using per-call input exports')
+      return false
+    }
+    this.ptr = ex.get_input_command_ring_ptr() >>> 0
+    if (!this.ptr || this.ptr % 8 !== 0) {return false}
+    this.capacity = new Uint32Array(this.memory.buffer, this.ptr, 2)[H_CAPACITY]
+    return this.capacity > 0 && (this.capacity & (this.capacity - 1)) === 0
+  }
+}
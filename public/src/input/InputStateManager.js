@@ -1,4 +1,5 @@
 import { InputValidator } from '../managers/input-validator.js';
+import { InputCommandRing } from './InputCommandRing.js';
 
 const DEFAULT_CONFIG = {
   bufferDuration: 120,
@@ -44,6 +45,7 @@ export class InputStateManager {
 
   setWasmManager(wasmManager) {
     this.wasmManager = wasmManager;
+    this.commandRing = null;
   }
 
   updateConfig(partialConfig = {}) {
@@ -240,13 +242,14 @@ export class InputStateManager {
 
     while (this.syncState.inputQueue.length > 0) {
       const queuedInput = this.syncState.inputQueue.shift();
-      this.sendInputStateToWasm(queuedInput.state);
+      this.sendInputStateToWasm(queuedInput.state, queuedInput.timestamp);
     }
 
     this.syncState.lastWasmUpdate = performance.now();
+    this.#getCommandRing()?.flush(this.syncState.lastWasmUpdate);
   }
 
-  sendInputStateToWasm(inputState) {
+  sendInputStateToWasm(inputState, timestamp = performance.now()) {
     if (!this.#hasWasmExports()) {
       return;
     }
@@ -272,6 +275,22 @@ export class InputStateManager {
         console.log(`dY"? Sending to WASM: dir=(${validation.inputX.toFixed(2)}, ${validation.inputY.toFixed(2)})`);
       }
 
+      // Shared-memory ring when the module has one: no export calls per input
+      const ring = this.#getCommandRing();
+      if (ring && ring.writeState(
+        validation.inputX,
+        validation.inputY,
+        validation.isRolling,
+        validation.isJumping,
+        validation.lightAttack,
+        validation.heavyAttack,
+        validation.isBlocking,
+        validation.special,
+        timestamp
+      )) {
+        return;
+      }
+
       this.wasmManager.setPlayerInput(
         validation.inputX,
         validation.inputY,
@@ -359,6 +378,16 @@ export class InputStateManager {
     this.syncState.inputQueue.length = 0;
   }
 
+  // Created on first use; null when the module has no compatible ring
+  #getCommandRing() {
+    if (this.commandRing === undefined || this.commandRing === null) {
+      const exports = this.wasmManager?.exports;
+      const ring = exports ? new InputCommandRing(exports) : null;
+      this.commandRing = ring && ring.available() ? ring : false;
+    }
+    return this.commandRing || null;
+  }
+
   #hasWasmExports() {
     return Boolean(
       this.wasmManager &&
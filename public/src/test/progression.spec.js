@@ -44,3 +44,28 @@ export async function test_progression_basic() {
 }
 
 
+
+export async function test_progression_lazy_trees() {
+  const pm = await createPm();
+  pm.trees.clear();
+  const seeded = [];
+  const fetched = [];
+  const realFetch = globalThis.fetch;
+  globalThis.fetch = async (url) => {
+    fetched.push(String(url));
+    return { ok: true, json: async () => ({ version: 1, nodes: [] }) };
+  };
+  try {
+    await pm.init({ classes: ['raider'] });
+    pm.bridge.setTree = (classId) => seeded.push(classId);
+    if (fetched.length !== 1 || !fetched[0].endsWith('raider.json')) {
+      throw new Error(`expected only raider.json, fetched ${fetched.join(', ')}`);
+    }
+    await Promise.all([pm.ensureClass('kensei'), pm.ensureClass('kensei'), pm.ensureClass('raider')]);
+    if (fetched.length !== 2 || seeded.length !== 1 || seeded[0] !== 3) {
+      throw new Error('kensei should load once on first use');
+    }
+  } finally {
+    globalThis.fetch = realFetch;
+  }
+}
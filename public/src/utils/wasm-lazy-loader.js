@@ -6,6 +6,15 @@ export { cleanupGlobalSourceMaps } from './wasm-loader/WasmSourceMap.js';
 
 export const globalWasmLoader = globalWasmLoaderInstance;
 
+const CLASS_MODULES = ['warden', 'raider', 'kensei'];
+
+// ?class=warden|raider|kensei selects the slim per-class build (game_warden.wasm, ...)
+// that carries only that class's abilities; anything else loads the full game.wasm
+export function resolveGameModuleName(search = typeof location !== 'undefined' ? location.search : '') {
+  const classParam = (new URLSearchParams(search).get('class') || '').toLowerCase();
+  return CLASS_MODULES.includes(classParam) ? `game_${classParam}` : 'game';
+}
+
 if (typeof window !== 'undefined') {
   window.runWasmDiagnostics = () => globalWasmLoader.runDiagnostics();
   window.wasmLoader = globalWasmLoader;
@@ -15,7 +24,7 @@ if (typeof document !== 'undefined') {
   document.addEventListener('DOMContentLoaded', () => {
     cleanupGlobalSourceMaps({ logger: console });
 
-    globalWasmLoader.preloadCriticalModules().catch(error => {
+    globalWasmLoader.preloadCriticalModules([resolveGameModuleName()]).catch(error => {
       console.warn('Failed to preload critical WASM modules:', error);
     });
   });
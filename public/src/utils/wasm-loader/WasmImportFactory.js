@@ -48,7 +48,7 @@
     const wasiImports = this.createWasiShim(memory);
 
     let moduleSpecificImports = {};
-    if (moduleName === 'game') {
+    if (moduleName === 'game' || moduleName.startsWith('game_')) {
       moduleSpecificImports = {
         wasi_snapshot_preview1: wasiImports,
         wasi_unstable: wasiImports
@@ -0,0 +1,45 @@
+#include "AllocCounter.h"
+#include "BuildConfig.h"
+
+#if DOZEDENT_COUNT_ALLOCS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<bool> g_count_allocs{true};
+std::atomic<uint64_t> g_alloc_count{0};
+std::atomic<uint64_t> g_alloc_bytes{0};
+
+void* counted_alloc(std::size_t size) {
+    if (g_count_allocs.load(std::memory_order_relaxed)) {
+        g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+        g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+} // namespace
+
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace alloc_counter {
+
+void set_enabled(bool enabled) { g_count_allocs.store(enabled, std::memory_order_relaxed); }
+
+void reset() {
+    g_alloc_count.store(0, std::memory_order_relaxed);
+    g_alloc_bytes.store(0, std::memory_order_relaxed);
+}
+
+uint64_t count() { return g_alloc_count.load(std::memory_order_relaxed); }
+uint64_t bytes() { return g_alloc_bytes.load(std::memory_order_relaxed); }
+
+} // namespace alloc_counter
+#endif
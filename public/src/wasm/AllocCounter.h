@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * AllocCounter - heap allocation counts for perf tooling
+ *
+ * When built with DOZEDENT_COUNT_ALLOCS=1, AllocCounter.cpp replaces the
+ * global operator new/delete for the whole binary and counts every call
+ * made while counting is enabled. Only the perf builds set the flag: the
+ * native bench (bench/dozedent_bench.cpp), which enables counting around
+ * each tick, and game_perf.wasm from `npm run perf:wasm`, which counts
+ * from start-up and lets tools/scripts/wasm-bench.js diff the totals.
+ * Without the flag the file compiles to nothing, the allocator is the
+ * toolchain's own, and these functions are not defined.
+ */
+namespace alloc_counter {
+
+// Counting starts enabled; the totals keep running until reset()
+void set_enabled(bool enabled);
+void reset();
+uint64_t count();
+uint64_t bytes();
+
+} // namespace alloc_counter
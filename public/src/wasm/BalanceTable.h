@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "generated/balance_data.h"
+
+/**
+ * BalanceTable - runtime balance values, hot-swappable between frames
+ *
+ * Values are indexed by BalanceKey (generated from the data/balance JSON by
+ * tools/scripts/generate-balance.cjs). bal(BAL_X) is one load through the
+ * active-table pointer at a constant offset, so it costs about what the old
+ * BAL_X macros did while letting live-ops swap tuning without a rebuild.
+ *
+ * A blob (public/data/balance/balance.bin or an A/B variant) is validated
+ * and copied into the spare table by balance_load_blob; it becomes visible
+ * only at the next balance_commit, which the game calls at init_run and at
+ * the start of each update, so a frame never sees a mix of two tables.
+ * The blob's value block has the same layout as BalanceTable::values, so
+ * loading is a header check and one memcpy; no JSON is parsed at runtime.
+ */
+
+constexpr uint32_t BALANCE_BLOB_MAGIC = 0x4C425A44; // "DZBL"
+constexpr uint16_t BALANCE_BLOB_VERSION = 1;
+constexpr size_t BALANCE_BLOB_HEADER_SIZE = 16;
+constexpr size_t BALANCE_BLOB_SIZE = BALANCE_BLOB_HEADER_SIZE + BAL_KEY_COUNT * sizeof(float);
+
+enum BalanceLoadResult {
+    BALANCE_LOAD_OK = 0,
+    BALANCE_LOAD_BAD_SIZE = -1,
+    BALANCE_LOAD_BAD_MAGIC = -2,
+    BALANCE_LOAD_BAD_VERSION = -3,
+    BALANCE_LOAD_LAYOUT_MISMATCH = -4
+};
+
+struct BalanceTable {
+    uint32_t revision;
+    float values[BAL_KEY_COUNT];
+};
+
+namespace balance_detail {
+
+constexpr BalanceTable make_default_table() {
+    BalanceTable t{};
+    t.revision = BALANCE_DEFAULT_REVISION;
+    for (int i = 0; i < BAL_KEY_COUNT; ++i) {
+        t.values[i] = BALANCE_DEFAULTS[i];
+    }
+    return t;
+}
+
+inline constexpr BalanceTable DEFAULT_TABLE = make_default_table();
+
+inline BalanceTable g_tables[2];
+inline const BalanceTable* g_active = &DEFAULT_TABLE;
+inline const BalanceTable* g_pending = nullptr;
+
+inline uint32_t read_u32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+inline uint16_t read_u16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+} // namespace balance_detail
+
+inline float bal(BalanceKey key) {
+    return balance_detail::g_active->values[key];
+}
+
+inline const BalanceTable& balance_active_table() {
+    return *balance_detail::g_active;
+}
+
+// Validate a blob and stage it for the next commit
+inline int balance_load_blob(const uint8_t* data, size_t size) {
+    using namespace balance_detail;
+    if (!data || size < BALANCE_BLOB_HEADER_SIZE) return BALANCE_LOAD_BAD_SIZE;
+    if (read_u32(data) != BALANCE_BLOB_MAGIC) return BALANCE_LOAD_BAD_MAGIC;
+    if (read_u16(data + 4) != BALANCE_BLOB_VERSION) return BALANCE_LOAD_BAD_VERSION;
+    if (read_u16(data + 6) != BAL_KEY_COUNT || read_u32(data + 8) != BALANCE_LAYOUT_HASH) {
+        return BALANCE_LOAD_LAYOUT_MISMATCH;
+    }
+    if (size < BALANCE_BLOB_SIZE) return BALANCE_LOAD_BAD_SIZE;
+
+    // Never write the table the current frame is reading
+    BalanceTable& spare = (g_active == &g_tables[0]) ? g_tables[1] : g_tables[0];
+    spare.revision = read_u32(data + 12);
+    std::memcpy(spare.values, data + BALANCE_BLOB_HEADER_SIZE, sizeof(spare.values)); // little endian, as WASM
+    g_pending = &spare;
+    return BALANCE_LOAD_OK;
+}
+
+// Stage the compiled-in defaults for the next commit
+inline void balance_reset_defaults() {
+    balance_detail::g_pending = &balance_detail::DEFAULT_TABLE;
+}
+
+// Publish a staged table; call only between frames. Returns true if it swapped.
+inline bool balance_commit() {
+    using namespace balance_detail;
+    if (!g_pending) return false;
+    g_active = g_pending;
+    g_pending = nullptr;
+    return true;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Build configuration - the compile-time feature set of a module
+ *
+ * DOZEDENT_CLASS selects the character class a module is built for, as a
+ * CharacterType value (0 = every class, the default game.wasm). A class
+ * build keeps that class's ability only: the other abilities' per-frame
+ * checks in PlayerManager::update and GameCoordinator compile away, and
+ * game_refactored.cpp drops their exports, so nothing references them.
+ *
+ *   Warden (1): shoulder bash   Raider (2): berserker charge   Kensei (3): flow dash
+ *
+ * Independent of the class:
+ *   DOZEDENT_ARMS=0           no arm IK update and no arm exports
+ *   DOZEDENT_SKELETON=0       no skeleton physics; skeleton getters report none
+ *   DOZEDENT_DEBUG_EXPORTS=0  no perf counter and AI timing getters
+ *   DOZEDENT_COUNT_ALLOCS=1   counted global operator new (AllocCounter.h) and
+ *                             the heap allocation getters; perf builds only
+ *
+ * State structs keep their layout in every build. SIMULATION_FEATURES is
+ * part of the snapshot fingerprint, so a snapshot only loads into a module
+ * that simulates the same features.
+ */
+
+#ifndef DOZEDENT_CLASS
+#define DOZEDENT_CLASS 0
+#endif
+
+#ifndef DOZEDENT_ARMS
+#define DOZEDENT_ARMS 1
+#endif
+
+#ifndef DOZEDENT_SKELETON
+#define DOZEDENT_SKELETON 1
+#endif
+
+#ifndef DOZEDENT_DEBUG_EXPORTS
+#define DOZEDENT_DEBUG_EXPORTS 1
+#endif
+
+#ifndef DOZEDENT_COUNT_ALLOCS
+#define DOZEDENT_COUNT_ALLOCS 0
+#endif
+
+#if DOZEDENT_CLASS < 0 || DOZEDENT_CLASS > 3
+#error "DOZEDENT_CLASS must be 0 (all), 1 (Warden), 2 (Raider) or 3 (Kensei)"
+#endif
+
+// For #if around exports
+#define DOZEDENT_HAS_BASH (DOZEDENT_CLASS == 0 || DOZEDENT_CLASS == 1)
+#define DOZEDENT_HAS_BERSERKER_CHARGE (DOZEDENT_CLASS == 0 || DOZEDENT_CLASS == 2)
+#define DOZEDENT_HAS_FLOW_DASH (DOZEDENT_CLASS == 0 || DOZEDENT_CLASS == 3)
+
+// For if constexpr in simulation code
+namespace build {
+constexpr int CHARACTER_CLASS = DOZEDENT_CLASS;
+constexpr bool HAS_BASH = DOZEDENT_HAS_BASH;
+constexpr bool HAS_BERSERKER_CHARGE = DOZEDENT_HAS_BERSERKER_CHARGE;
+constexpr bool HAS_FLOW_DASH = DOZEDENT_HAS_FLOW_DASH;
+constexpr bool HAS_ARMS = DOZEDENT_ARMS != 0;
+constexpr bool HAS_SKELETON = DOZEDENT_SKELETON != 0;
+constexpr bool HAS_DEBUG_EXPORTS = DOZEDENT_DEBUG_EXPORTS != 0;
+
+// Class in bits 0-1, then the features that change what is simulated
+constexpr uint32_t SIMULATION_FEATURES =
+    static_cast<uint32_t>(CHARACTER_CLASS) |
+    (HAS_ARMS ? 1u << 2 : 0u) |
+    (HAS_SKELETON ? 1u << 3 : 0u);
+
+// Exported as get_build_features
+constexpr uint32_t FEATURE_MASK = SIMULATION_FEATURES | (HAS_DEBUG_EXPORTS ? 1u << 4 : 0u);
+} // namespace build
@@ -0,0 +1,322 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * JsonReader - single-pass, zero-copy pull parser over a (ptr, len) buffer
+ *
+ * Shared by the modules that load JSON handed over from JS (upgrade trees
+ * and state, game-host input and snapshots). The buffer does not need to be
+ * NUL-terminated and is never copied: strings come back as JsonStr views
+ * into it, and numbers are parsed in place. Nested objects and arrays are
+ * handled (skip() walks any value), unlike the find()/strstr scanning it
+ * replaces.
+ *
+ * Usage:
+ *   JsonReader r(json, len);
+ *   JsonStr key;
+ *   if (r.begin_object()) {
+ *       while (r.next_key(key)) {
+ *           if (key == "nodes") { ... } else r.skip();
+ *       }
+ *   }
+ *
+ * Malformed input puts the reader in a failed state (ok() == false) where
+ * every call returns false, so loops over it terminate. skip() walks
+ * containers iteratively and fails past MAX_DEPTH levels of nesting, so
+ * hostile input (game-host reads remote players' JSON) cannot exhaust the
+ * stack.
+ */
+
+// View of a JSON string's raw contents (between the quotes, escapes intact)
+struct JsonStr {
+    const char* ptr = nullptr;
+    int len = 0;
+    bool escaped = false;
+
+    // Compares raw bytes; keys and ids in our data never contain escapes
+    bool operator==(const char* s) const {
+        const size_t n = std::strlen(s);
+        return static_cast<size_t>(len) == n && std::memcmp(ptr, s, n) == 0;
+    }
+    bool operator!=(const char* s) const { return !(*this == s); }
+
+    // Decoded copy (\" \\ \/ \b \f \n \r \t and \uXXXX as UTF-8)
+    std::string to_string() const {
+        std::string out;
+        assign_to(out);
+        return out;
+    }
+
+    // Decode into out, reusing its capacity
+    void assign_to(std::string& out) const {
+        if (!escaped) {
+            out.assign(ptr, len);
+            return;
+        }
+        out.clear();
+        for (int i = 0; i < len; ++i) {
+            char c = ptr[i];
+            if (c != '\\' || i + 1 >= len) {
+                out.push_back(c);
+                continue;
+            }
+            c = ptr[++i];
+            switch (c) {
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u': {
+                    unsigned cp = 0;
+                    for (int k = 0; k < 4 && i + 1 < len; ++k) {
+                        const char h = ptr[++i];
+                        cp = (cp << 4) | static_cast<unsigned>(
+                            h >= 'a' ? h - 'a' + 10 : h >= 'A' ? h - 'A' + 10 : h - '0');
+                    }
+                    if (cp < 0x80) {
+                        out.push_back(static_cast<char>(cp));
+                    } else if (cp < 0x800) {
+                        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+                        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+                    } else {
+                        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+                        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+                    }
+                    break;
+                }
+                default: out.push_back(c); break; // \" \\ \/
+            }
+        }
+    }
+};
+
+class JsonReader {
+public:
+    enum Type { Null, Bool, Number, String, Object, Array, End, Invalid };
+
+    static constexpr int MAX_DEPTH = 64;  // Nesting skip() accepts
+
+    JsonReader(const char* data, int len)
+        : p_(data), end_(data + (len > 0 ? len : 0)) {}
+
+    bool ok() const { return !failed_; }
+
+    // Type of the next value without consuming it
+    Type peek() {
+        skip_ws();
+        if (failed_) return Invalid;
+        if (p_ >= end_) return End;
+        switch (*p_) {
+            case '{': return Object;
+            case '[': return Array;
+            case '"': return String;
+            case 't': case 'f': return Bool;
+            case 'n': return Null;
+            default: return (*p_ == '-' || (*p_ >= '0' && *p_ <= '9')) ? Number : Invalid;
+        }
+    }
+
+    bool begin_object() { return expect('{'); }
+    bool begin_array() { return expect('['); }
+
+    // Next member of the current object; false (and consumes '}') at its end
+    bool next_key(JsonStr& key) {
+        if (!separator('}')) return false;
+        if (!read_string(key)) return false;
+        return expect(':');
+    }
+
+    // True while the current array has another element to read
+    bool next_element() {
+        return separator(']');
+    }
+
+    bool read_string(JsonStr& out) {
+        if (!expect('"')) return false;
+        const char* start = p_;
+        bool escaped = false;
+        while (p_ < end_ && *p_ != '"') {
+            if (*p_ == '\\') {
+                escaped = true;
+                ++p_;
+            }
+            ++p_;
+        }
+        if (p_ >= end_) return fail();
+        out.ptr = start;
+        out.len = static_cast<int>(p_ - start);
+        out.escaped = escaped;
+        ++p_;
+        return true;
+    }
+
+    // Decimal integer/fraction/exponent, parsed without strtod (buffer is not NUL-terminated)
+    bool read_number(double& out) {
+        skip_ws();
+        if (failed_) return false;
+        bool negative = false;
+        if (p_ < end_ && (*p_ == '-' || *p_ == '+')) {
+            negative = (*p_ == '-');
+            ++p_;
+        }
+        uint64_t mantissa = 0;
+        int exponent = 0;
+        int digits = 0;
+        for (; p_ < end_ && *p_ >= '0' && *p_ <= '9'; ++p_, ++digits) {
+            if (mantissa < 100000000000000000ULL) {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*p_ - '0');
+            } else {
+                ++exponent;
+            }
+        }
+        if (p_ < end_ && *p_ == '.') {
+            ++p_;
+            for (; p_ < end_ && *p_ >= '0' && *p_ <= '9'; ++p_, ++digits) {
+                if (mantissa < 100000000000000000ULL) {
+                    mantissa = mantissa * 10 + static_cast<unsigned>(*p_ - '0');
+                    --exponent;
+                }
+            }
+        }
+        if (digits == 0) return fail();
+        if (p_ < end_ && (*p_ == 'e' || *p_ == 'E')) {
+            ++p_;
+            bool exp_negative = false;
+            if (p_ < end_ && (*p_ == '-' || *p_ == '+')) {
+                exp_negative = (*p_ == '-');
+                ++p_;
+            }
+            int e = 0;
+            for (; p_ < end_ && *p_ >= '0' && *p_ <= '9'; ++p_) {
+                if (e < 10000) e = e * 10 + (*p_ - '0');
+            }
+            exponent += exp_negative ? -e : e;
+        }
+        // Exact for the short literals in our data: both operands are exact
+        // doubles, so one multiply or divide rounds correctly
+        double value = static_cast<double>(mantissa);
+        if (exponent < 0) {
+            value /= pow10(-exponent);
+        } else if (exponent > 0) {
+            value *= pow10(exponent);
+        }
+        out = negative ? -value : value;
+        return true;
+    }
+
+    bool read_int(int& out) {
+        double v = 0.0;
+        if (!read_number(v)) return false;
+        out = v >= 2147483647.0 ? 2147483647 : v <= -2147483648.0 ? (-2147483647 - 1) : static_cast<int>(v);
+        return true;
+    }
+
+    bool read_float(float& out) {
+        double v = 0.0;
+        if (!read_number(v)) return false;
+        out = static_cast<float>(v);
+        return true;
+    }
+
+    bool read_bool(bool& out) {
+        skip_ws();
+        if (literal("true")) { out = true; return true; }
+        if (literal("false")) { out = false; return true; }
+        return fail();
+    }
+
+    // Skip one value of any type, including nested containers (up to MAX_DEPTH deep)
+    bool skip() {
+        char closers[MAX_DEPTH];
+        int depth = 0;
+        for (;;) {
+            JsonStr s;
+            double d;
+            bool b;
+            switch (peek()) {
+                case String: if (!read_string(s)) return false; break;
+                case Number: if (!read_number(d)) return false; break;
+                case Bool: if (!read_bool(b)) return false; break;
+                case Null: if (!literal("null")) return fail(); break;
+                case Object:
+                    if (depth == MAX_DEPTH) return fail();
+                    begin_object();
+                    closers[depth++] = '}';
+                    break;
+                case Array:
+                    if (depth == MAX_DEPTH) return fail();
+                    begin_array();
+                    closers[depth++] = ']';
+                    break;
+                default: return fail();
+            }
+            // Move to the next value, closing every container that ends here
+            while (depth > 0) {
+                const bool more = closers[depth - 1] == '}' ? next_key(s) : next_element();
+                if (more) break;
+                if (!ok()) return false;
+                --depth;
+            }
+            if (depth == 0) return ok();
+        }
+    }
+
+private:
+    static double pow10(int n) {
+        static const double SMALL[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        if (n <= 22) return SMALL[n];
+        double r = SMALL[22];
+        for (n -= 22; n > 0 && r < 1e308; --n) r *= 10.0;
+        return r;
+    }
+
+    void skip_ws() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) ++p_;
+    }
+
+    bool expect(char c) {
+        skip_ws();
+        if (failed_ || p_ >= end_ || *p_ != c) return fail();
+        ++p_;
+        return true;
+    }
+
+    // Between container elements: consume a ',' (leniently optional) or the closer
+    bool separator(char closer) {
+        skip_ws();
+        if (failed_ || p_ >= end_) return fail();
+        if (*p_ == ',') {
+            ++p_;
+            skip_ws();
+        }
+        if (p_ < end_ && *p_ == closer) {
+            ++p_;
+            return false;
+        }
+        return p_ < end_ || fail();
+    }
+
+    bool literal(const char* word) {
+        const size_t n = std::strlen(word);
+        if (static_cast<size_t>(end_ - p_) < n || std::memcmp(p_, word, n) != 0) return false;
+        p_ += n;
+        return true;
+    }
+
+    bool fail() {
+        failed_ = true;
+        p_ = end_;
+        return false;
+    }
+
+    const char* p_;
+    const char* end_;
+    bool failed_ = false;
+};
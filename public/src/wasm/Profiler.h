@@ -0,0 +1,157 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * FrameProfiler - per-subsystem wall-clock time for the last N frames
+ *
+ * PROFILE_ZONE(zone) times the enclosing scope and adds it to the open
+ * frame; PROFILE_FRAME_SCOPE() in GameCoordinator::update closes the frame
+ * into a fixed ring of ProfileFrame records that JS reads in place
+ * (get_profile_ptr / get_profile_count exports). Zones are inclusive: a
+ * zone that runs several times in a frame (physics substeps) is summed,
+ * and nested zones are also counted in their parent.
+ *
+ * Both macros compile to nothing unless built with DOZEDENT_PROFILE=1, so
+ * release builds carry no timer calls; the exports stay and report zero
+ * frames. Timing is monitoring only and never feeds the simulation. With
+ * the physics worker, substep zones land in whichever frame is open when
+ * the worker finishes them.
+ */
+
+enum ProfileZone : uint32_t {
+    PROFILE_FRAME = 0,              // Whole GameCoordinator::update
+    PROFILE_PHYSICS,                // PhysicsManager::update (only the kick with a worker)
+    PROFILE_PHYSICS_INTEGRATE,      // Force fields and integration
+    PROFILE_PHYSICS_COLLIDE,        // Broadphase, narrowphase and contact resolution
+    PROFILE_PHYSICS_CONSTRAINTS,
+    PROFILE_PHYSICS_SLEEP,          // Sleep timers and island sleeping
+    PROFILE_PLAYER,                 // Player movement, skeleton and ability state
+    PROFILE_SKELETON,
+    PROFILE_COMBAT,
+    PROFILE_WOLVES,                 // Wolf AI, packs and animation
+    PROFILE_ARMS,
+    PROFILE_GAME_STATE,
+    PROFILE_COORDINATION,           // Cross-manager coordination and collision events
+    PROFILE_WORLD,                  // Chunk streaming (WorldManager)
+    PROFILE_ZONE_COUNT
+};
+
+inline const char* profile_zone_name(ProfileZone zone) {
+    static const char* const NAMES[PROFILE_ZONE_COUNT] = {
+        "frame", "physics", "physicsIntegrate", "physicsCollide", "physicsConstraints",
+        "physicsSleep", "player", "skeleton", "combat", "wolves", "arms", "gameState",
+        "coordination", "world"
+    };
+    return zone < PROFILE_ZONE_COUNT ? NAMES[zone] : "";
+}
+
+// One closed frame; laid out as uint32 + floats so JS can view it as a Float32Array
+struct ProfileFrame {
+    uint32_t frame;                 // Frames closed since start; 0 marks an empty slot
+    float zone_ms[PROFILE_ZONE_COUNT];
+};
+
+class FrameProfiler {
+public:
+    static constexpr uint32_t CAPACITY = 128;
+
+    void add(ProfileZone zone, uint64_t ns) {
+        open_ns_[zone].fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    void end_frame() {
+        ProfileFrame& out = frames_[next_slot_];
+        out.frame = ++frame_count_;
+        for (uint32_t z = 0; z < PROFILE_ZONE_COUNT; ++z) {
+            out.zone_ms[z] = static_cast<float>(open_ns_[z].exchange(0, std::memory_order_relaxed)) * 1.0e-6f;
+        }
+        next_slot_ = (next_slot_ + 1) % CAPACITY;
+        if (count_ < CAPACITY) ++count_;
+    }
+
+    void clear() {
+        for (std::atomic<uint64_t>& ns : open_ns_) ns.store(0, std::memory_order_relaxed);
+        for (ProfileFrame& f : frames_) f = ProfileFrame{};
+        next_slot_ = 0;
+        count_ = 0;
+        frame_count_ = 0;
+    }
+
+    // Ring storage: slot (oldest() + i) % CAPACITY holds the i-th oldest of count() frames
+    const ProfileFrame* data() const { return frames_; }
+    uint32_t count() const { return count_; }
+    uint32_t oldest() const { return (next_slot_ + CAPACITY - count_) % CAPACITY; }
+    const ProfileFrame* latest() const {
+        return count_ ? &frames_[(next_slot_ + CAPACITY - 1) % CAPACITY] : nullptr;
+    }
+
+private:
+    std::atomic<uint64_t> open_ns_[PROFILE_ZONE_COUNT] = {};
+    ProfileFrame frames_[CAPACITY] = {};
+    uint32_t next_slot_ = 0;
+    uint32_t count_ = 0;
+    uint32_t frame_count_ = 0;
+};
+
+inline FrameProfiler& GetFrameProfiler() {
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+// The one wall clock: profile zones, the perf counter getters and the
+// physics step budget all read it. Only a nonzero step budget
+// (PhysicsManager::set_step_budget_ms) can change how many steps run, so it
+// is forced to 0 wherever the simulation must be deterministic
+using PerfClock = std::chrono::steady_clock;
+
+inline double perf_now_ms() {
+    return std::chrono::duration<double, std::milli>(PerfClock::now().time_since_epoch()).count();
+}
+
+class ScopedProfileZone {
+public:
+    explicit ScopedProfileZone(ProfileZone zone)
+        : zone_(zone), start_(PerfClock::now()) {}
+    ~ScopedProfileZone() {
+        const auto elapsed = PerfClock::now() - start_;
+        GetFrameProfiler().add(zone_, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+    ScopedProfileZone(const ScopedProfileZone&) = delete;
+    ScopedProfileZone& operator=(const ScopedProfileZone&) = delete;
+
+private:
+    ProfileZone zone_;
+    PerfClock::time_point start_;
+};
+
+// Times the frame zone, then closes the frame
+class ScopedProfileFrame {
+public:
+    ScopedProfileFrame() : start_(PerfClock::now()) {}
+    ~ScopedProfileFrame() {
+        const auto elapsed = PerfClock::now() - start_;
+        FrameProfiler& profiler = GetFrameProfiler();
+        profiler.add(PROFILE_FRAME, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        profiler.end_frame();
+    }
+    ScopedProfileFrame(const ScopedProfileFrame&) = delete;
+    ScopedProfileFrame& operator=(const ScopedProfileFrame&) = delete;
+
+private:
+    PerfClock::time_point start_;
+};
+
+#define DZ_PROFILE_JOIN_INNER(a, b) a##b
+#define DZ_PROFILE_JOIN(a, b) DZ_PROFILE_JOIN_INNER(a, b)
+
+#if DOZEDENT_PROFILE
+#define PROFILE_ZONE(zone) ScopedProfileZone DZ_PROFILE_JOIN(profile_zone_, __LINE__)(zone)
+#define PROFILE_FRAME_SCOPE() ScopedProfileFrame DZ_PROFILE_JOIN(profile_frame_, __LINE__)
+#else
+#define PROFILE_ZONE(zone) ((void)0)
+#define PROFILE_FRAME_SCOPE() ((void)0)
+#endif
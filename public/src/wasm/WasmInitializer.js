@@ -1,4 +1,4 @@
-import { globalWasmLoader } from '../utils/wasm-lazy-loader.js';
+import { globalWasmLoader, resolveGameModuleName } from '../utils/wasm-lazy-loader.js';
 import { globalMemoryOptimizer } from '../utils/memory-optimizer.js';
 
 import { loadWasmHelper, loadTraditional } from './initializer/module-loader.js';
@@ -43,9 +43,12 @@ export class WasmInitializer {
 
       const { loadWasm } = wasmHelperModule;
 
+      // A missing class module falls through to the traditional game.wasm load below
+      const moduleName = resolveGameModuleName();
+
       try {
-        console.log('Attempting to load WASM module with lazy loader...');
-        const wasmInstance = await globalWasmLoader.loadModule('game', {
+        console.log(`Attempting to load WASM module '${moduleName}' with lazy loader...`);
+        const wasmInstance = await globalWasmLoader.loadModule(moduleName, {
           imports: {},
           onProgress: (progress) => {
             console.log(`WASM loading progress: ${(progress.progress * 100).toFixed(1)}%`);
@@ -78,7 +81,7 @@ export class WasmInitializer {
           success: true,
           fallbackMode: false,
           loadTime: initTime,
-          wasmPath: 'lazy-loader:game'
+          wasmPath: `lazy-loader:${moduleName}`
         });
 
         return true;
@@ -86,7 +89,7 @@ export class WasmInitializer {
         console.warn('Lazy loader failed, falling back to traditional loading:', lazyLoadError.message);
 
         if (lazyLoadError.message?.includes('timeout')) {
-          await runDiagnostics('game');
+          await runDiagnostics(moduleName);
         }
       }
 
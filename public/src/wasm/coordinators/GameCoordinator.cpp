@@ -1,6 +1,11 @@
 #include "GameCoordinator.h"
 #include "../physics/PhysicsEvents.h"
+#include "../physics/ForceField.h"
+#include "../physics/StaticGeometry.h"
 #include "../physics/PhysicsConstants.h"
+#include "../physics/CollisionLayers.h"
+#include "../BalanceTable.h"
+#include "../Profiler.h"
 #include <cmath>
 
 GameCoordinator::GameCoordinator() {
@@ -8,6 +13,14 @@ GameCoordinator::GameCoordinator() {
 }
 
 void GameCoordinator::initialize(unsigned long long seed, unsigned int start_weapon) {
+    if (restore_restart_image(seed, start_weapon)) {
+        return;
+    }
+    
+    // A fresh start is the unit room; a streamed map pages out first
+    world_manager_.initialize(&physics_manager_, &wolf_manager_, &player_manager_);
+    world_manager_.clear();
+    
     // Initialize physics first (deterministic foundation)
     PhysicsConfig physics_config;
     
@@ -16,6 +29,13 @@ void GameCoordinator::initialize(unsigned long long seed, unsigned int start_wea
     
     physics_manager_.initialize(physics_config);
     
+    // Record only the contacts process_collision_events acts on (ground and
+    // barrel contacts otherwise make up most of every step's events)
+    PhysicsEventFilter& event_filter = physics_manager_.get_event_queue().filter();
+    event_filter.clear();
+    event_filter.add_rule(CollisionLayers::Player, CollisionLayers::Enemy);
+    event_filter.add_rule(CollisionLayers::Enemy, CollisionLayers::Enemy);
+    
     // Wire dependencies between managers
     combat_manager_.set_physics_manager(&physics_manager_);
     combat_manager_.set_player_manager(&player_manager_);
@@ -29,14 +49,14 @@ void GameCoordinator::initialize(unsigned long long seed, unsigned int start_wea
     // Initialize wolf manager
     wolf_manager_.initialize(this);
     arm_manager_.initialize(&physics_manager_, &player_manager_);
+    reserve_room_capacity();
     
     // Reset all managers to clean state
     player_manager_.reset_to_spawn();
     input_manager_.clear_input_latches();
     
-    // TODO: Initialize other systems (world, etc.)
-    
     is_initialized_ = true;
+    bake_restart_image(start_weapon);
 }
 
 void GameCoordinator::shutdown() {
@@ -47,34 +67,103 @@ void GameCoordinator::shutdown() {
 void GameCoordinator::reset(unsigned long long new_seed) {
     if (!is_initialized_) return;
     
-    // Reset physics
-    physics_manager_.reset();
-    
-    // Reset game state
-    game_state_manager_.reset(new_seed);
-    
-    // Reset all managers
-    player_manager_.reset_to_spawn();
-    input_manager_.clear_input_latches();
-    wolf_manager_.clear_all();
-    
-    // TODO: Reset other systems
+    // Total play time spans runs; everything else restarts from the image
+    const float total_play_time = game_state_manager_.get_total_play_time();
+    const WorldMapConfig world = world_manager_.get_config();
+    if (!restore_restart_image(new_seed, restart_weapon_)) {
+        initialize(new_seed, restart_weapon_);
+    }
+    game_state_manager_.set_total_play_time(total_play_time);
+    // The image holds the unit room; the same map starts over fresh
+    if (world.chunks_x > 0 && world.chunks_y > 0) {
+        configure_world(world);
+    }
+}
+
+bool GameCoordinator::configure_world(const WorldMapConfig& config) {
+    return world_manager_.configure(config, player_manager_.get_x(), player_manager_.get_y());
+}
+
+void GameCoordinator::disable_world() {
+    world_manager_.clear();
+}
+
+void GameCoordinator::bake_restart_image(unsigned int start_weapon) {
+    SnapshotWriter counter;
+    save_state(counter);
+    restart_image_.resize(counter.size());
+    SnapshotWriter w(restart_image_.data(), restart_image_.size());
+    save_state(w);
+    restart_weapon_ = start_weapon;
+}
+
+bool GameCoordinator::restore_restart_image(unsigned long long seed, unsigned int start_weapon) {
+    if (restart_image_.empty() || start_weapon != restart_weapon_) {
+        return false;
+    }
+    // The capacity hint may have grown since the bake; reserving before the
+    // restore keeps the image's bodies from reallocating on the way in
+    reserve_room_capacity();
+    wolf_manager_.clear_all();  // Also zeroes the pack counters snapshots do not carry
+    SnapshotReader r(restart_image_.data(), restart_image_.size());
+    if (!load_state(r)) {
+        restart_image_.clear();  // Rebuilt by the full initialize that follows
+        return false;
+    }
+    // The image was baked with the first run's seed
+    game_state_manager_.initialize(seed, start_weapon);
+    physics_manager_.clear_frame_hashes();
+    return true;
+}
+
+void GameCoordinator::reserve_room_capacity() {
+    const GameStateManager::RoomCapacity& capacity = game_state_manager_.get_room_capacity();
+    wolf_manager_.reserve(capacity.wolves, capacity.packs);
+    physics_manager_.reserve_bodies(static_cast<size_t>(capacity.bodies));
 }
 
 void GameCoordinator::update(float delta_time) {
     if (!is_initialized_ || game_state_manager_.is_paused()) return;
+    PROFILE_FRAME_SCOPE();
+    frame_arena_.reset();
+    
+    // Wolf and RNG state at frame start salt this update's physics frame hashes
+    if (physics_manager_.is_frame_hash_enabled()) {
+        FrameHasher salt;
+        wolf_manager_.hash_state(salt);
+        game_state_manager_.hash_state(salt);
+        if (world_manager_.is_enabled()) {
+            world_manager_.hash_state(salt);
+        }
+        physics_manager_.set_frame_salt(salt.finish());
+    }
     
     // Update physics first (deterministic fixed timestep)
-    physics_manager_.update(delta_time);
+    {
+        PROFILE_ZONE(PROFILE_PHYSICS);
+        physics_manager_.update(delta_time);
+    }
     
     // Update in coordinated order
     update_input_processing(delta_time);
     update_player_systems(delta_time);
     update_combat_systems(delta_time);
-    wolf_manager_.update(delta_time);  // Update wolf AI and behavior
-    arm_manager_.update(delta_time);
+    {
+        PROFILE_ZONE(PROFILE_WOLVES);
+        wolf_manager_.update(delta_time);  // Update wolf AI and behavior
+    }
+    if constexpr (build::HAS_ARMS) {
+        PROFILE_ZONE(PROFILE_ARMS);
+        arm_manager_.update(delta_time);
+    }
+    if (world_manager_.is_enabled()) {
+        PROFILE_ZONE(PROFILE_WORLD);
+        world_manager_.update(player_manager_.get_x(), player_manager_.get_y());
+    }
     update_game_state(delta_time);
     
+    PROFILE_ZONE(PROFILE_COORDINATION);
+    
     // Coordinate cross-system interactions
     coordinate_player_input();
     coordinate_combat_actions();
@@ -88,6 +177,73 @@ void GameCoordinator::update(float delta_time) {
     synchronize_manager_states();
 }
 
+// ============================================================================
+// Rollback Snapshots
+// ============================================================================
+
+namespace {
+constexpr uint32_t SNAPSHOT_MAGIC = 0x4E535A44;  // "DZSN"
+constexpr uint32_t SNAPSHOT_VERSION = 10;
+
+// Changes whenever a snapshotted struct changes size, so stale images are rejected
+constexpr uint32_t snapshot_layout_fingerprint() {
+    uint32_t h = 2166136261u;
+    const uint32_t sizes[] = {
+        sizeof(Wolf), sizeof(PhysicsConfig), sizeof(DistanceConstraint), sizeof(DistanceRangeConstraint),
+        sizeof(BodyStore::SleepState), sizeof(ForceField), sizeof(PlayerManager::PlayerState), sizeof(SkeletonPhysics::PlayerSkeleton),
+        sizeof(PlayerManager::ShoulderBashState), sizeof(PlayerManager::BerserkerChargeState),
+        sizeof(PlayerManager::FlowDashState),
+        sizeof(CombatManager::CombatState), sizeof(GameStateManager::GameState), sizeof(InputManager::InputState), sizeof(InputManager::BufferedPresses),
+        sizeof(StaticCollider), sizeof(WorldMapConfig), sizeof(WorldChunkRecord), sizeof(TerrainFeature)
+    };
+    for (uint32_t s : sizes) {
+        h = (h ^ s) * 16777619u;
+    }
+    // Modules built with other abilities or features simulate differently
+    return (h ^ build::SIMULATION_FEATURES) * 16777619u;
+}
+}
+
+void GameCoordinator::save_state(SnapshotWriter& w) {
+    w.write(SNAPSHOT_MAGIC);
+    w.write(SNAPSHOT_VERSION);
+    w.write(snapshot_layout_fingerprint());
+    w.write(is_initialized_);
+    
+    physics_manager_.save_state(w);
+    input_manager_.save_state(w);
+    player_manager_.save_state(w);
+    combat_manager_.save_state(w);
+    game_state_manager_.save_state(w);
+    wolf_manager_.save_state(w);
+    arm_manager_.save_state(w);
+    world_manager_.save_state(w);
+}
+
+bool GameCoordinator::load_state(SnapshotReader& r) {
+    uint32_t magic = 0, version = 0, fingerprint = 0;
+    if (!r.read(magic) || !r.read(version) || !r.read(fingerprint) ||
+        magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION ||
+        fingerprint != snapshot_layout_fingerprint()) {
+        return false;
+    }
+    
+    const bool ok = r.read(is_initialized_) &&
+        physics_manager_.load_state(r) &&
+        input_manager_.load_state(r) &&
+        player_manager_.load_state(r) &&
+        combat_manager_.load_state(r) &&
+        game_state_manager_.load_state(r) &&
+        wolf_manager_.load_state(r) &&
+        arm_manager_.load_state(r) &&
+        world_manager_.load_state(r);
+    
+    // Events from the abandoned timeline must not be delivered after a rollback
+    physics_manager_.get_event_queue().clear();
+    physics_manager_.get_event_queue().contacts().end_all();
+    return ok;
+}
+
 void GameCoordinator::set_player_input(float input_x, float input_y, int rolling, int jumping,
                                       int light_attack, int heavy_attack, int blocking, int special) {
     input_manager_.update_input(input_x, input_y, rolling, jumping, 
@@ -95,22 +251,52 @@ void GameCoordinator::set_player_input(float input_x, float input_y, int rolling
 }
 
 void GameCoordinator::update_input_processing(float delta_time) {
-    // Input manager handles its own validation and normalization
-    // No additional processing needed here
+    // Input manager handles its own validation and normalization; commands
+    // JS wrote to the ring since the last update land here, in ring order
+    input_manager_.drain_command_ring(game_state_manager_.get_game_time());
+    const InputCommand* actions = input_manager_.get_frame_actions();
+    for (int i = 0; i < input_manager_.get_frame_action_count(); ++i) {
+        const InputCommand& cmd = actions[i];
+        switch (cmd.type) {
+            case input_command::BASH_CHARGE:
+                if constexpr (build::HAS_BASH) { player_manager_.start_charging_bash(); }
+                break;
+            case input_command::BASH_RELEASE:
+                if constexpr (build::HAS_BASH) { player_manager_.release_bash(); }
+                break;
+            case input_command::LEFT_HAND_TARGET:
+                if constexpr (build::HAS_ARMS) { arm_manager_.set_left_target(cmd.x, cmd.y, cmd.z); }
+                break;
+            case input_command::RIGHT_HAND_TARGET:
+                if constexpr (build::HAS_ARMS) { arm_manager_.set_right_target(cmd.x, cmd.y, cmd.z); }
+                break;
+            default: break;
+        }
+    }
 }
 
 void GameCoordinator::update_player_systems(float delta_time) {
+    PROFILE_ZONE(PROFILE_PLAYER);
     // Update player manager with current input
     const auto& input_state = input_manager_.get_input_state();
     player_manager_.update_movement(input_state.movement_x, input_state.movement_y, delta_time);
     player_manager_.update(delta_time);
+    
+    // Terrain blocks the player too (player movement runs outside the physics step)
+    float x = player_manager_.get_x();
+    float y = player_manager_.get_y();
+    if (physics_manager_.resolve_static_circle(x, y, bal(BAL_PLAYER_RADIUS), CollisionLayers::Player)) {
+        player_manager_.set_position(x, y);
+    }
 }
 
 void GameCoordinator::update_combat_systems(float delta_time) {
+    PROFILE_ZONE(PROFILE_COMBAT);
     combat_manager_.update(delta_time);
 }
 
 void GameCoordinator::update_game_state(float delta_time) {
+    PROFILE_ZONE(PROFILE_GAME_STATE);
     game_state_manager_.update(delta_time);
 }
 
@@ -119,6 +305,7 @@ void GameCoordinator::coordinate_player_input() {
     
     // Handle attack inputs
     handle_attack_inputs();
+    handle_buffered_presses();
     
     // Handle defensive inputs
     handle_defensive_inputs();
@@ -134,13 +321,89 @@ void GameCoordinator::coordinate_player_input() {
 }
 
 void GameCoordinator::coordinate_combat_actions() {
-    // This method coordinates combat actions between combat manager and other systems
-    // For example, applying damage to enemies, handling combat effects, etc.
+    // Every player hitbox open this frame, resolved against enemy bodies in one batched pass
+    using HitSource = CombatManager::HitSource;
+    const float px = player_manager_.get_x();
+    const float py = player_manager_.get_y();
+    const float player_radius = bal(BAL_PLAYER_RADIUS);
+    
+    combat_manager_.begin_hit_frame();
+    if (combat_manager_.get_attack_state() == CombatManager::AttackState::Active) {
+        combat_manager_.add_hitbox(HitSource::Attack, QueryShape::arc_f(
+            px, py, bal(BAL_ATTACK_RANGE), player_manager_.get_facing_x(), player_manager_.get_facing_y(),
+            bal(BAL_ATTACK_ARC_COS_THRESHOLD)));
+    }
+    if constexpr (build::HAS_BASH) {
+        const PlayerManager::BashHitbox bash = player_manager_.get_bash_hitbox();
+        if (bash.active) {
+            combat_manager_.add_hitbox(HitSource::Bash, QueryShape::circle_f(bash.x, bash.y, bash.radius));
+        }
+    }
+    if (build::HAS_BERSERKER_CHARGE && player_manager_.is_berserker_charge_active()) {
+        combat_manager_.add_hitbox(HitSource::Charge, QueryShape::circle_f(px, py, player_radius));
+    }
+    if (build::HAS_FLOW_DASH && player_manager_.is_flow_dash_active()) {
+        // The whole path so far; hit memory keeps earlier targets from being struck again
+        combat_manager_.add_hitbox(HitSource::Dash, QueryShape::capsule_f(
+            player_manager_.get_dash_start_x(), player_manager_.get_dash_start_y(), px, py, player_radius));
+    }
+    
+    for (const CombatManager::Hit& hit : combat_manager_.resolve_hits(CollisionLayers::Enemy)) {
+        apply_player_hit(hit);
+    }
     
-    // TODO: Coordinate with enemy systems
     // TODO: Handle combat effects on environment
 }
 
+void GameCoordinator::apply_player_hit(const CombatManager::Hit& hit) {
+    Wolf* wolf = wolf_manager_.find_wolf_by_body(hit.body_id);
+    if (!wolf) {
+        return;
+    }
+    
+    // Knock away from the player, or along facing when overlapping
+    float dir_x = wolf->x.to_float() - player_manager_.get_x();
+    float dir_y = wolf->y.to_float() - player_manager_.get_y();
+    const float dist = std::sqrt(dir_x * dir_x + dir_y * dir_y);
+    if (dist > 0.001f) {
+        dir_x /= dist;
+        dir_y /= dist;
+    } else {
+        dir_x = player_manager_.get_facing_x();
+        dir_y = player_manager_.get_facing_y();
+    }
+    const float knockback = bal(BAL_ATTACK_KNOCKBACK);
+    
+    switch (hit.source) {
+        case CombatManager::HitSource::Attack: {
+            const float damage = bal(BAL_ATTACK_DAMAGE) * combat_manager_.get_state().damage_multiplier;
+            wolf_manager_.damage_wolf(wolf->id, damage, dir_x * knockback, dir_y * knockback);
+            break;
+        }
+        // Ability hitboxes only exist in builds with the ability
+        case CombatManager::HitSource::Bash:
+            if constexpr (build::HAS_BASH) {
+                player_manager_.on_bash_hit(hit.body_id);
+                combat_manager_.apply_enemy_knockback(hit.body_id, dir_x, dir_y, player_manager_.get_bash_force());
+                // Let the impulse carry before wolf AI steers the body again
+                wolf_manager_.set_wolf_collision_cooldown(hit.body_id, bal(BAL_ATTACK_STUN_SEC));
+            }
+            break;
+        case CombatManager::HitSource::Charge:
+            if constexpr (build::HAS_BERSERKER_CHARGE) {
+                wolf_manager_.damage_wolf(wolf->id, player_manager_.on_charge_hit(hit.body_id),
+                                          dir_x * knockback, dir_y * knockback);
+            }
+            break;
+        case CombatManager::HitSource::Dash:
+            if constexpr (build::HAS_FLOW_DASH) {
+                wolf_manager_.damage_wolf(wolf->id, player_manager_.on_dash_hit(hit.body_id),
+                                          dir_x * knockback, dir_y * knockback);
+            }
+            break;
+    }
+}
+
 void GameCoordinator::coordinate_movement_and_combat() {
     // Coordinate movement restrictions based on combat state
     const auto& combat_state = combat_manager_.get_state();
@@ -194,6 +457,26 @@ void GameCoordinator::handle_attack_inputs() {
     }
 }
 
+void GameCoordinator::handle_buffered_presses() {
+    // Presses from the command ring, oldest first; a press that fails (cooldown,
+    // stamina) is retried each update until the input buffer window closes
+    uint8_t presses[InputManager::PRESS_COUNT];
+    const int count = input_manager_.collect_buffered_presses(game_state_manager_.get_game_time(), presses);
+    for (int i = 0; i < count; ++i) {
+        bool done = false;
+        switch (presses[i]) {
+            case input_command::LIGHT_ATTACK: done = combat_manager_.try_light_attack(); break;
+            case input_command::HEAVY_ATTACK: done = combat_manager_.try_heavy_attack(); break;
+            case input_command::SPECIAL_ATTACK: done = combat_manager_.try_special_attack(); break;
+            case input_command::ROLL: done = combat_manager_.try_roll(); break;
+            default: done = true; break;
+        }
+        if (done) {
+            input_manager_.consume_buffered_press(presses[i]);
+        }
+    }
+}
+
 void GameCoordinator::handle_movement_inputs(float delta_time) {
     const auto& input_state = input_manager_.get_input_state();
     
@@ -228,39 +511,38 @@ void GameCoordinator::synchronize_manager_states() {
 }
 
 void GameCoordinator::process_collision_events() {
-    // Get collision events from physics system
-    auto& event_queue = GetPhysicsEventQueue();
-    int event_count = event_queue.count();
-    const CollisionEvent* events = event_queue.data();
-    
-    // Process each collision event
-    for (int i = 0; i < event_count; i++) {
-        const CollisionEvent& event = events[i];
-        
-        // Check if collision involves player (player body ID is 0)
-        const uint32_t playerBodyId = PhysicsConstants::kPlayerBodyId;
-        bool player_is_bodyA = (event.bodyA == playerBodyId);
-        bool player_is_bodyB = (event.bodyB == playerBodyId);
-        
-        if (player_is_bodyA || player_is_bodyB) {
-            const uint32_t other_body_id = player_is_bodyA ? event.bodyB : event.bodyA;
-            const Wolf* wolf = wolf_manager_.find_wolf_by_body(other_body_id);
-            if (wolf) {
-                handle_player_wolf_collision(other_body_id, event.impulse);
-            }
-        } else {
-            // Check for wolf-wolf collisions
-            const Wolf* wolfA = wolf_manager_.find_wolf_by_body(event.bodyA);
-            const Wolf* wolfB = wolf_manager_.find_wolf_by_body(event.bodyB);
+    // Get collision events from physics system (ring buffer, drained span by span)
+    auto& event_queue = physics_manager_.get_event_queue();
+    const CollisionEvent* events = nullptr;
+    
+    while (int event_count = event_queue.peek(&events)) {
+        // Process each collision event
+        for (int i = 0; i < event_count; i++) {
+            const CollisionEvent& event = events[i];
             
-            if (wolfA && wolfB) {
-                handle_wolf_wolf_collision(event.bodyA, event.bodyB, event.impulse);
+            // Check if collision involves player (player body ID is 0)
+            const uint32_t playerBodyId = PhysicsConstants::kPlayerBodyId;
+            bool player_is_bodyA = (event.bodyA == playerBodyId);
+            bool player_is_bodyB = (event.bodyB == playerBodyId);
+            
+            if (player_is_bodyA || player_is_bodyB) {
+                const uint32_t other_body_id = player_is_bodyA ? event.bodyB : event.bodyA;
+                const Wolf* wolf = wolf_manager_.find_wolf_by_body(other_body_id);
+                if (wolf) {
+                    handle_player_wolf_collision(other_body_id, event.impulse);
+                }
+            } else {
+                // Check for wolf-wolf collisions
+                const Wolf* wolfA = wolf_manager_.find_wolf_by_body(event.bodyA);
+                const Wolf* wolfB = wolf_manager_.find_wolf_by_body(event.bodyB);
+                
+                if (wolfA && wolfB) {
+                    handle_wolf_wolf_collision(event.bodyA, event.bodyB, event.impulse);
+                }
             }
         }
+        event_queue.consume(event_count);
     }
-    
-    // Clear processed events
-    event_queue.clear();
 }
 
 void GameCoordinator::handle_wolf_wolf_collision(uint32_t wolf_body_a, uint32_t wolf_body_b, float impulse_magnitude) {
@@ -289,17 +571,7 @@ void GameCoordinator::handle_player_wolf_collision(uint32_t wolf_body_id, float
     #endif
     
     // Find the wolf that owns this physics body
-    int wolf_count = wolf_manager_.get_wolf_count();
-    Wolf* colliding_wolf = nullptr;
-    
-    for (int i = 0; i < wolf_count; i++) {
-        Wolf* wolf = wolf_manager_.get_wolf_mutable(i);
-        if (wolf && wolf->physics_body_id == wolf_body_id) {
-            colliding_wolf = wolf;
-            break;
-        }
-    }
-    
+    Wolf* colliding_wolf = wolf_manager_.find_wolf_by_body(wolf_body_id);
     if (!colliding_wolf) {
         return;
     }
@@ -6,7 +6,9 @@
 #include "../managers/GameStateManager.h"
 #include "../managers/WolfManager.h"
 #include "../managers/ArmManager.h"
+#include "../managers/WorldManager.h"
 #include "../physics/PhysicsManager.h"
+#include "../physics/FrameArena.h"
 
 /**
  * GameCoordinator - Main coordinator that orchestrates all game systems
@@ -17,14 +19,30 @@ public:
     GameCoordinator();
     ~GameCoordinator() = default;
 
-    // Core lifecycle
+    // Core lifecycle. The first initialize builds every manager and bakes
+    // the result into a restart image; later initialize calls for the same
+    // weapon, and reset, restore that image and reseed instead.
     void initialize(unsigned long long seed, unsigned int start_weapon);
     void shutdown();
-    void reset(unsigned long long new_seed);
+    void reset(unsigned long long new_seed);  // Keeps total play time
+    size_t get_restart_image_size() const { return restart_image_.size(); }
+    // Reserves wolf and physics body storage for the room capacity hint
+    // (barrels live in the export layer, which reserves its own pool)
+    void reserve_room_capacity();
     
     // Main update loop
     void update(float delta_time);
     
+    // Rollback snapshots: raw POD image of every manager's simulation state.
+    // Restoring is only valid within the same build (layout fingerprint check).
+    void save_state(SnapshotWriter& w);
+    bool load_state(SnapshotReader& r);
+    
+    // Streamed world (see WorldManager): replaces the unit room with a chunked
+    // map around the player. reset keeps the map; initialize drops it.
+    bool configure_world(const WorldMapConfig& config);
+    void disable_world();
+    
     // Input handling
     void set_player_input(float input_x, float input_y, int rolling, int jumping,
                          int light_attack, int heavy_attack, int blocking, int special);
@@ -36,6 +54,7 @@ public:
     GameStateManager& get_game_state_manager() { return game_state_manager_; }
     PhysicsManager& get_physics_manager() { return physics_manager_; }
     WolfManager& get_wolf_manager() { return wolf_manager_; }
+    WorldManager& get_world_manager() { return world_manager_; }
     
     const InputManager& get_input_manager() const { return input_manager_; }
     const PlayerManager& get_player_manager() const { return player_manager_; }
@@ -43,6 +62,11 @@ public:
     const GameStateManager& get_game_state_manager() const { return game_state_manager_; }
     const PhysicsManager& get_physics_manager() const { return physics_manager_; }
     const WolfManager& get_wolf_manager() const { return wolf_manager_; }
+    const WorldManager& get_world_manager() const { return world_manager_; }
+    
+    // Scratch memory for the current update, rewound when the next one starts
+    FrameArena& get_frame_arena() { return frame_arena_; }
+    const FrameArena& get_frame_arena() const { return frame_arena_; }
 
 private:
     // Manager instances
@@ -53,10 +77,18 @@ private:
     PhysicsManager physics_manager_;
     WolfManager wolf_manager_;
     ArmManager arm_manager_;
+    WorldManager world_manager_;
+    FrameArena frame_arena_;
     
     // Coordination state
     bool is_initialized_ = false;
     
+    // Restart image: save_state right after the first full initialize
+    std::vector<uint8_t> restart_image_;
+    unsigned int restart_weapon_ = 0;
+    void bake_restart_image(unsigned int start_weapon);
+    bool restore_restart_image(unsigned long long seed, unsigned int start_weapon);
+    
     // Update coordination
     void update_input_processing(float delta_time);
     void update_player_systems(float delta_time);
@@ -72,9 +104,11 @@ private:
     
     // Helper methods
     void handle_attack_inputs();
+    void handle_buffered_presses();
     void handle_movement_inputs(float delta_time);
     void handle_defensive_inputs();
     void synchronize_manager_states();
+    void apply_player_hit(const CombatManager::Hit& hit);
     void handle_player_wolf_collision(uint32_t wolf_body_id, float impulse_magnitude);
     void handle_wolf_wolf_collision(uint32_t wolf_body_a, uint32_t wolf_body_b, float impulse_magnitude);
 public:
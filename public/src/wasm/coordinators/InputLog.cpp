@@ -0,0 +1,35 @@
+#include "InputLog.h"
+
+uint32_t replay_input_log(GameCoordinator& game, const InputLogReader& log, uint32_t stop_tick,
+                          std::vector<ReplayCheckpoint>& checkpoints) {
+    const InputLogHeader& header = log.header();
+    const uint32_t end = stop_tick < header.tick_count ? stop_tick : header.tick_count;
+    const uint32_t interval = header.checkpoint_interval;
+    PhysicsManager& physics = game.get_physics_manager();
+    physics.set_frame_hash_enabled(true);
+    // A wall-clock step budget would make the replay depend on the machine
+    physics.set_step_budget_ms(0.0f);
+
+    SimInputFrame held;
+    size_t next = 0;
+    for (uint32_t tick = 0; tick < end; ++tick) {
+        if (next < log.record_count() && log.record(next).tick == tick) {
+            held = log.record(next++).decode();
+        }
+        // Same per-tick call sequence as SimInstance::step
+        game.set_player_input(held.move_x, held.move_y, held.rolling, held.jumping,
+                              held.light_attack, held.heavy_attack, held.blocking, held.special);
+        game.update(SimInstance::TICK_DT);
+
+        const uint32_t done = tick + 1;
+        if ((interval > 0 && done % interval == 0) || done == end) {
+            ReplayCheckpoint checkpoint;
+            checkpoint.tick = done;
+            if (!physics.get_frame_hash(physics.get_latest_hashed_tick(), checkpoint.hash)) {
+                checkpoint.hash = 0;
+            }
+            checkpoints.push_back(checkpoint);
+        }
+    }
+    return end;
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "SimInstance.h"
+
+/**
+ * Input log - compact binary record of one session's player input
+ *
+ * Layout (little-endian, as on WASM and every native target we build):
+ * a 24-byte InputLogHeader, then 8-byte InputLogRecords sorted by tick.
+ * A record holds from its tick until the next one, so a log only grows
+ * when the input changes. Ticks are fixed 60 Hz updates counted from the
+ * initialize(seed, start_weapon) named in the header, and tick_count is
+ * the session length.
+ *
+ * Axes are quantized to int8 (value * 127, rounded). A recorded session
+ * only replays bit-exactly if the live game was fed the quantized values,
+ * which InputLogWriter::record returns. Keyboard axes (-1, 0, 1) are
+ * exact either way. The log carries player input only: a session also
+ * driven by JS calls (spawn_wolf, set_room_capacity, ...) is out of scope.
+ */
+namespace input_log {
+constexpr uint32_t MAGIC = 0x4C495A44u;  // "DZIL"
+constexpr uint16_t VERSION = 1;
+
+enum Button : uint8_t {
+    BUTTON_ROLL = 1 << 0,
+    BUTTON_JUMP = 1 << 1,
+    BUTTON_LIGHT_ATTACK = 1 << 2,
+    BUTTON_HEAVY_ATTACK = 1 << 3,
+    BUTTON_BLOCK = 1 << 4,
+    BUTTON_SPECIAL = 1 << 5,
+};
+
+inline int8_t quantize_axis(float value) {
+    if (!(value > -1.0f)) value = -1.0f;  // Also catches NaN
+    if (value > 1.0f) value = 1.0f;
+    return static_cast<int8_t>(std::lround(value * 127.0f));
+}
+
+inline float dequantize_axis(int8_t value) { return static_cast<float>(value) / 127.0f; }
+} // namespace input_log
+
+struct InputLogHeader {
+    uint32_t magic = input_log::MAGIC;
+    uint16_t version = input_log::VERSION;
+    uint16_t checkpoint_interval = 0;  // Ticks between replay checkpoints (0 = final tick only)
+    uint64_t seed = 0;
+    uint32_t start_weapon = 0;
+    uint32_t tick_count = 0;
+};
+static_assert(sizeof(InputLogHeader) == 24, "InputLogHeader is part of the log format");
+
+struct InputLogRecord {
+    uint32_t tick = 0;
+    int8_t move_x = 0;
+    int8_t move_y = 0;
+    uint8_t buttons = 0;  // input_log::Button bits
+    uint8_t reserved = 0;
+
+    static InputLogRecord encode(uint32_t tick, const SimInputFrame& in) {
+        using namespace input_log;
+        InputLogRecord record;
+        record.tick = tick;
+        record.move_x = quantize_axis(in.move_x);
+        record.move_y = quantize_axis(in.move_y);
+        record.buttons = static_cast<uint8_t>(
+            (in.rolling ? BUTTON_ROLL : 0) | (in.jumping ? BUTTON_JUMP : 0) |
+            (in.light_attack ? BUTTON_LIGHT_ATTACK : 0) | (in.heavy_attack ? BUTTON_HEAVY_ATTACK : 0) |
+            (in.blocking ? BUTTON_BLOCK : 0) | (in.special ? BUTTON_SPECIAL : 0));
+        return record;
+    }
+
+    SimInputFrame decode() const {
+        using namespace input_log;
+        SimInputFrame in;
+        in.move_x = dequantize_axis(move_x);
+        in.move_y = dequantize_axis(move_y);
+        in.rolling = (buttons & BUTTON_ROLL) != 0;
+        in.jumping = (buttons & BUTTON_JUMP) != 0;
+        in.light_attack = (buttons & BUTTON_LIGHT_ATTACK) != 0;
+        in.heavy_attack = (buttons & BUTTON_HEAVY_ATTACK) != 0;
+        in.blocking = (buttons & BUTTON_BLOCK) != 0;
+        in.special = (buttons & BUTTON_SPECIAL) != 0;
+        return in;
+    }
+
+    bool same_input(const InputLogRecord& other) const {
+        return move_x == other.move_x && move_y == other.move_y && buttons == other.buttons;
+    }
+};
+static_assert(sizeof(InputLogRecord) == 8, "InputLogRecord is part of the log format");
+
+/**
+ * InputLogWriter - builds a log while a session runs
+ *
+ * Call record once per tick, in order, and feed the returned (quantized)
+ * frame to the simulation; finish writes the header and returns the bytes.
+ */
+class InputLogWriter {
+public:
+    InputLogWriter() { begin(0, 0, 0); }
+
+    void begin(uint64_t seed, uint32_t start_weapon, uint16_t checkpoint_interval) {
+        header_ = InputLogHeader();
+        header_.seed = seed;
+        header_.start_weapon = start_weapon;
+        header_.checkpoint_interval = checkpoint_interval;
+        bytes_.assign(sizeof(InputLogHeader), 0);
+        has_last_ = false;
+    }
+
+    SimInputFrame record(uint32_t tick, const SimInputFrame& in) {
+        const InputLogRecord record = InputLogRecord::encode(tick, in);
+        if (!has_last_ || !record.same_input(last_)) {
+            const size_t offset = bytes_.size();
+            bytes_.resize(offset + sizeof(InputLogRecord));
+            std::memcpy(bytes_.data() + offset, &record, sizeof(record));
+            last_ = record;
+            has_last_ = true;
+        }
+        if (tick + 1 > header_.tick_count) {
+            header_.tick_count = tick + 1;
+        }
+        return record.decode();
+    }
+
+    // tick_count 0 keeps the length implied by the recorded ticks
+    const std::vector<uint8_t>& finish(uint32_t tick_count = 0) {
+        if (tick_count > header_.tick_count) {
+            header_.tick_count = tick_count;
+        }
+        std::memcpy(bytes_.data(), &header_, sizeof(header_));
+        return bytes_;
+    }
+
+private:
+    InputLogHeader header_;
+    std::vector<uint8_t> bytes_;
+    InputLogRecord last_;
+    bool has_last_ = false;
+};
+
+/**
+ * InputLogReader - validated view over log bytes (does not copy them)
+ */
+class InputLogReader {
+public:
+    // Rejects a bad magic or version, a truncated record, or ticks out of order
+    bool open(const uint8_t* data, size_t size) {
+        records_ = nullptr;
+        record_count_ = 0;
+        if (!data || size < sizeof(InputLogHeader) ||
+            (size - sizeof(InputLogHeader)) % sizeof(InputLogRecord) != 0) {
+            return false;
+        }
+        std::memcpy(&header_, data, sizeof(header_));
+        if (header_.magic != input_log::MAGIC || header_.version != input_log::VERSION) {
+            return false;
+        }
+        records_ = data + sizeof(InputLogHeader);
+        record_count_ = (size - sizeof(InputLogHeader)) / sizeof(InputLogRecord);
+        for (size_t i = 0; i < record_count_; ++i) {
+            const uint32_t tick = record(i).tick;
+            if (tick >= header_.tick_count || (i > 0 && tick <= record(i - 1).tick)) {
+                records_ = nullptr;
+                record_count_ = 0;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const InputLogHeader& header() const { return header_; }
+    size_t record_count() const { return record_count_; }
+
+    InputLogRecord record(size_t index) const {
+        InputLogRecord out;
+        std::memcpy(&out, records_ + index * sizeof(InputLogRecord), sizeof(out));
+        return out;
+    }
+
+private:
+    InputLogHeader header_;
+    const uint8_t* records_ = nullptr;
+    size_t record_count_ = 0;
+};
+
+struct ReplayCheckpoint {
+    uint32_t tick = 0;   // Ticks completed when the hash was taken
+    uint64_t hash = 0;   // Latest physics frame hash (as SimInstance::get_state_hash)
+};
+
+// Steps game, already initialized from the log header, through ticks
+// [0, min(stop_tick, tick_count)) at SimInstance::TICK_DT with no calls
+// out. Appends a checkpoint every checkpoint_interval ticks and at the
+// last tick run. Returns the number of ticks run.
+uint32_t replay_input_log(GameCoordinator& game, const InputLogReader& log, uint32_t stop_tick,
+                          std::vector<ReplayCheckpoint>& checkpoints);
@@ -0,0 +1,189 @@
+#include "SimInstance.h"
+#include "../physics/FrameHash.h"
+
+SimInstance::SimInstance(uint64_t seed, uint32_t start_weapon) {
+    coordinator_.initialize(seed, start_weapon);
+}
+
+int SimInstance::step(const SimInputFrame* inputs, int ticks) {
+    // Lockstep: the step count must not depend on wall-clock time
+    coordinator_.get_physics_manager().set_step_budget_ms(0.0f);
+    int stepped = 0;
+    for (; stepped < ticks; ++stepped) {
+        if (inputs) {
+            const SimInputFrame& in = inputs[stepped];
+            coordinator_.set_player_input(in.move_x, in.move_y, in.rolling, in.jumping,
+                                          in.light_attack, in.heavy_attack, in.blocking, in.special);
+        } else {
+            coordinator_.set_player_input(0.0f, 0.0f, 0, 0, 0, 0, 0, 0);
+        }
+        coordinator_.update(TICK_DT);
+        tick_++;
+    }
+    return stepped;
+}
+
+uint64_t SimInstance::get_state_hash() {
+    PhysicsManager& physics = coordinator_.get_physics_manager();
+    uint64_t hash = 0;
+    return physics.get_frame_hash(physics.get_latest_hashed_tick(), hash) ? hash : 0;
+}
+
+void SimInstance::save_state(SnapshotWriter& w) {
+    w.write(tick_);
+    coordinator_.save_state(w);
+}
+
+bool SimInstance::load_state(SnapshotReader& r) {
+    return r.read(tick_) && coordinator_.load_state(r);
+}
+
+#if DOZEDENT_SIM_THREADS
+SimThreadPool::SimThreadPool(int threads) {
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    for (int i = 1; i < threads; ++i) {
+        workers_.emplace_back([this] { worker_loop(); });
+    }
+}
+
+SimThreadPool::~SimThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_ready_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void SimThreadPool::step_all(SimInstance* const* sims, const SimInputFrame* const* inputs, int count, int ticks) {
+    if (!sims || count <= 0 || ticks <= 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sims_ = sims;
+        inputs_ = inputs;
+        count_ = count;
+        ticks_ = ticks;
+        next_.store(0, std::memory_order_relaxed);
+        busy_ = static_cast<int>(workers_.size());
+        generation_++;
+    }
+    work_ready_.notify_all();
+    run_batch();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [this] { return busy_ == 0; });
+    sims_ = nullptr;
+    inputs_ = nullptr;
+}
+
+void SimThreadPool::worker_loop() {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_ready_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+        }
+        run_batch();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_--;
+        }
+        work_done_.notify_one();
+    }
+}
+
+void SimThreadPool::run_batch() {
+    for (int i = next_.fetch_add(1, std::memory_order_relaxed); i < count_;
+         i = next_.fetch_add(1, std::memory_order_relaxed)) {
+        if (sims_[i]) {
+            sims_[i]->step(inputs_ ? inputs_[i] : nullptr, ticks_);
+        }
+    }
+}
+#endif
+
+// ---- C API glue ----
+// Handles are SimInstance pointers (opaque i32 in WASM). No function here
+// touches the export layer's default game or any other global.
+
+extern "C" {
+
+__attribute__((used)) __attribute__((export_name("sim_create")))
+SimInstance* sim_create(unsigned long long seed, unsigned int start_weapon) {
+    return new SimInstance(seed ? seed : 1ull, start_weapon);
+}
+
+__attribute__((used)) __attribute__((export_name("sim_destroy")))
+void sim_destroy(SimInstance* sim) { delete sim; }
+
+// inputs: n_ticks SimInputFrame records (16 bytes each), or 0 for no input; returns ticks run
+__attribute__((used)) __attribute__((export_name("sim_step")))
+int sim_step(SimInstance* sim, const SimInputFrame* inputs, int n_ticks) {
+    return sim && n_ticks > 0 ? sim->step(inputs, n_ticks) : 0;
+}
+
+__attribute__((used)) __attribute__((export_name("sim_get_tick")))
+unsigned int sim_get_tick(const SimInstance* sim) { return sim ? sim->get_tick() : 0; }
+
+// Folded to 32 bits like get_frame_hash; 0 before the first step
+__attribute__((used)) __attribute__((export_name("sim_get_state_hash")))
+unsigned int sim_get_state_hash(SimInstance* sim) {
+    if (!sim) return 0;
+    const uint64_t hash = sim->get_state_hash();
+    if (hash == 0) return 0;
+    const uint32_t folded = FrameHasher::fold32(hash);
+    return folded != 0 ? folded : 1;
+}
+
+// Returns bytes written, 0 if capacity is too small (a null buffer reports the size)
+__attribute__((used)) __attribute__((export_name("sim_save_state")))
+int sim_save_state(SimInstance* sim, unsigned char* out, int capacity) {
+    if (!sim) return 0;
+    if (!out) {
+        SnapshotWriter counter;
+        sim->save_state(counter);
+        return static_cast<int>(counter.size());
+    }
+    SnapshotWriter w(out, capacity > 0 ? static_cast<size_t>(capacity) : 0);
+    sim->save_state(w);
+    return w.ok() ? static_cast<int>(w.size()) : 0;
+}
+
+__attribute__((used)) __attribute__((export_name("sim_load_state")))
+int sim_load_state(SimInstance* sim, const unsigned char* in, int size) {
+    if (!sim || !in || size <= 0) return 0;
+    SnapshotReader r(in, static_cast<size_t>(size));
+    return sim->load_state(r) ? 1 : 0;
+}
+
+__attribute__((used)) __attribute__((export_name("sim_spawn_wolf")))
+void sim_spawn_wolf(SimInstance* sim, float x, float y, int type) {
+    if (sim) sim->get_coordinator().get_wolf_manager().spawn_wolf(x, y, static_cast<WolfType>(type));
+}
+
+__attribute__((used)) __attribute__((export_name("sim_get_wolf_count")))
+int sim_get_wolf_count(const SimInstance* sim) {
+    return sim ? sim->get_coordinator().get_wolf_manager().get_wolf_count() : 0;
+}
+
+__attribute__((used)) __attribute__((export_name("sim_get_player_hp")))
+float sim_get_player_hp(const SimInstance* sim) {
+    return sim ? sim->get_coordinator().get_player_manager().get_hp() : 0.0f;
+}
+
+__attribute__((used)) __attribute__((export_name("sim_estimate_player_skill")))
+float sim_estimate_player_skill(const SimInstance* sim) {
+    return sim ? sim->get_coordinator().get_wolf_manager().estimate_player_skill() : 0.0f;
+}
+
+} // extern "C"
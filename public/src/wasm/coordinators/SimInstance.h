@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include "GameCoordinator.h"
+
+#ifndef DOZEDENT_SIM_THREADS
+#  if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#    define DOZEDENT_SIM_THREADS 1
+#  else
+#    define DOZEDENT_SIM_THREADS 0
+#  endif
+#endif
+
+#if DOZEDENT_SIM_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+/**
+ * SimInputFrame - one tick of player input for SimInstance::step
+ *
+ * Fixed 16-byte layout shared with JS (sim_step reads an array of them):
+ * movement axes, then one byte per button, non-zero meaning held.
+ */
+struct SimInputFrame {
+    float move_x = 0.0f;
+    float move_y = 0.0f;
+    uint8_t rolling = 0;
+    uint8_t jumping = 0;
+    uint8_t light_attack = 0;
+    uint8_t heavy_attack = 0;
+    uint8_t blocking = 0;
+    uint8_t special = 0;
+    uint8_t reserved[2] = {0, 0};
+};
+static_assert(sizeof(SimInputFrame) == 16, "SimInputFrame is part of the JS ABI");
+
+/**
+ * SimInstance - one headless match, independent of every other instance
+ *
+ * Owns a GameCoordinator, and through it the physics bodies and collision
+ * event queue, wolves, RNG and frame scratch, and steps it at a fixed
+ * 60 Hz. Nothing an instance mutates is shared, so instances on different
+ * threads never synchronize. They do read process-wide tuning: the active
+ * balance table and the upgrade trees. Publish those (balance_commit,
+ * upgrade_set_tree) only while no instance is stepping. Profile zones
+ * (DOZEDENT_PROFILE builds) are process-wide too, so profile on one thread.
+ */
+class SimInstance {
+public:
+    static constexpr float TICK_DT = 1.0f / 60.0f;
+
+    SimInstance(uint64_t seed, uint32_t start_weapon);
+
+    // Runs ticks fixed updates; inputs holds one frame per tick (null = no input)
+    int step(const SimInputFrame* inputs, int ticks);
+
+    uint32_t get_tick() const { return tick_; }
+    // Latest physics frame hash (body state salted with wolf and RNG state), 0 before the first step
+    uint64_t get_state_hash();
+
+    GameCoordinator& get_coordinator() { return coordinator_; }
+    const GameCoordinator& get_coordinator() const { return coordinator_; }
+
+    // Rollback snapshots: the coordinator image plus the tick counter
+    void save_state(SnapshotWriter& w);
+    bool load_state(SnapshotReader& r);
+
+private:
+    GameCoordinator coordinator_;
+    uint32_t tick_ = 0;
+};
+
+#if DOZEDENT_SIM_THREADS
+/**
+ * SimThreadPool - steps many SimInstances across a fixed set of threads
+ *
+ * step_all hands out instances one at a time from a shared cursor, so a
+ * slow match does not hold up a whole slice, and returns once every
+ * instance has run its ticks. The calling thread works too. Results do
+ * not depend on the thread count: each instance is deterministic alone.
+ */
+class SimThreadPool {
+public:
+    explicit SimThreadPool(int threads = 0);  // 0 = hardware concurrency
+    ~SimThreadPool();
+
+    SimThreadPool(const SimThreadPool&) = delete;
+    SimThreadPool& operator=(const SimThreadPool&) = delete;
+
+    // inputs (optional) holds one frame array per instance, each ticks long or null
+    void step_all(SimInstance* const* sims, const SimInputFrame* const* inputs, int count, int ticks);
+
+    int get_thread_count() const { return static_cast<int>(workers_.size()) + 1; }
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable work_done_;
+    uint64_t generation_ = 0;
+    int busy_ = 0;
+    bool stop_ = false;
+
+    // Current batch (valid while busy_ > 0 or the caller is working)
+    SimInstance* const* sims_ = nullptr;
+    const SimInputFrame* const* inputs_ = nullptr;
+    int count_ = 0;
+    int ticks_ = 0;
+    std::atomic<int> next_{0};
+
+    void worker_loop();
+    void run_batch();
+};
+#endif
+
+// C API over SimInstance (WASM exports and native callers; handles are instance pointers)
+extern "C" {
+SimInstance* sim_create(unsigned long long seed, unsigned int start_weapon);
+void sim_destroy(SimInstance* sim);
+int sim_step(SimInstance* sim, const SimInputFrame* inputs, int n_ticks);
+unsigned int sim_get_tick(const SimInstance* sim);
+unsigned int sim_get_state_hash(SimInstance* sim);
+int sim_save_state(SimInstance* sim, unsigned char* out, int capacity);
+int sim_load_state(SimInstance* sim, const unsigned char* in, int size);
+void sim_spawn_wolf(SimInstance* sim, float x, float y, int type);
+int sim_get_wolf_count(const SimInstance* sim);
+float sim_get_player_hp(const SimInstance* sim);
+float sim_estimate_player_skill(const SimInstance* sim);
+}
@@ -1,21 +1,53 @@
 /**
  * Simple multiplayer game example for host authority system
- * Compile with: emcc game-host.cpp -O3 -s STANDALONE_WASM=1 -s EXPORTED_FUNCTIONS='["_game_init","_game_create_state","_game_update","_game_handle_input","_game_get_state","_game_get_state_size","_game_apply_state","_game_destroy","_malloc","_free"]' -s EXPORTED_RUNTIME_METHODS='["ccall","cwrap"]' -o game-host.wasm
+ * Compile with: emcc game-host.cpp -O3 -s STANDALONE_WASM=1 -s EXPORTED_FUNCTIONS='["_game_init","_game_create_state","_game_update","_game_handle_input","_game_get_state","_game_get_state_size","_game_apply_state","_game_handle_input_binary","_game_get_state_binary","_game_get_state_binary_size","_game_apply_state_binary","_game_get_state_for","_game_set_interest","_game_destroy","_malloc","_free"]' -s EXPORTED_RUNTIME_METHODS='["ccall","cwrap"]' -o game-host.wasm
  */
 
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
 #include <vector>
 #include <string>
 #include <sstream>
+#include "JsonReader.h"
 
-#define MAX_PLAYERS 16
+#define MAX_PLAYERS 64
 #define WORLD_WIDTH 1280
 #define WORLD_HEIGHT 720
 #define PLAYER_SPEED 200.0f // pixels per second
 #define PLAYER_RADIUS 16.0f
 
+// Binary snapshot format (see game_get_state_binary)
+#define SNAPSHOT_MAGIC 0x4453       // "DS" little endian
+#define SNAPSHOT_VERSION 2
+#define SNAPSHOT_HEADER_SIZE 28
+#define SNAPSHOT_HISTORY 32         // frames kept for delta baselines
+#define SNAPSHOT_POS_SCALE 16.0f    // 1/16 px, u16 covers 0..4095 px
+#define SNAPSHOT_VEL_SCALE 64.0f    // 1/64 px/s, i16 covers +-511 px/s
+#define SNAPSHOT_FLAG_DELTA 0x01
+#define SNAPSHOT_FIELD_POS 0x01
+#define SNAPSHOT_FIELD_VEL 0x02
+#define SNAPSHOT_FIELD_HEALTH 0x04
+#define SNAPSHOT_FIELD_SCORE 0x08
+#define SNAPSHOT_FIELD_ALL 0x0F
+#define SNAPSHOT_MAX_SIZE (SNAPSHOT_HEADER_SIZE + MAX_PLAYERS * 15)
+
+// Interest management (see game_get_state_for)
+#define INTEREST_CELL_SIZE 128.0f     // interest grid cell, px
+#define INTEREST_HISTORY 16           // per-recipient frames kept for delta baselines
+#define INTEREST_NEAR_RADIUS 256.0f   // players this close are due every frame
+#define INTEREST_MID_RADIUS 512.0f    // every 2nd frame
+#define INTEREST_VIEW_RADIUS 768.0f   // every 4th frame; farther players are not sent
+#define INTEREST_LEAVE_MARGIN 64.0f   // a player in view leaves it past VIEW + margin
+#define INTEREST_SEND_THRESHOLD 4     // priority a player needs to be due
+#define INTEREST_MAX_RECORDS 24       // players sent per packet, besides the recipient
+
+// Binary input format: u8 type (0 move, 1 attack), i8 dx, i8 dy (scaled by 127)
+#define INPUT_BINARY_SIZE 3
+#define INPUT_TYPE_MOVE 0
+#define INPUT_TYPE_ATTACK 1
+
 // External JS functions - REMOVED js_random and js_get_timestamp for determinism
 extern "C" {
     void js_log(const char* msg, int len);
@@ -54,6 +86,13 @@ void js_broadcast_state(const char* json, int len) {
 // Main function required for standalone WASM
 int main() { return 0; }
 
+// One bit per player index (snapshot active and dirty masks)
+typedef uint64_t PlayerMask;
+
+static inline PlayerMask playerBit(int i) {
+    return (PlayerMask)1 << i;
+}
+
 // Player state
 struct Player {
     int id;
@@ -67,6 +106,79 @@ struct Player {
     Player() : id(-1), x(0), y(0), vx(0), vy(0), health(100), score(0), active(false), lastInputTick(0) {}
 };
 
+// Quantized player as it appears on the wire; deltas compare these so
+// host and client agree exactly on what the baseline contains
+struct QuantizedPlayer {
+    uint16_t x, y;
+    int16_t vx, vy;
+    int16_t health;
+    int32_t score;
+};
+
+struct QuantizedSnapshot {
+    unsigned int frame;
+    PlayerMask activeMask;
+    QuantizedPlayer players[MAX_PLAYERS];
+};
+
+// Ring of recent snapshots: the host keeps what it sent, the client keeps
+// what it applied, so both sides can resolve the same baseline frame
+template <int Size>
+struct SnapshotRing {
+    QuantizedSnapshot entries[Size];
+    bool valid[Size];
+
+    SnapshotRing() {
+        for (int i = 0; i < Size; i++) valid[i] = false;
+    }
+
+    void record(const QuantizedSnapshot& snap) {
+        const int slot = snap.frame % Size;
+        entries[slot] = snap;
+        valid[slot] = true;
+    }
+
+    const QuantizedSnapshot* find(unsigned int frame) const {
+        const int slot = frame % Size;
+        if (!valid[slot] || entries[slot].frame != frame) return nullptr;
+        return &entries[slot];
+    }
+};
+
+typedef SnapshotRing<SNAPSHOT_HISTORY> SnapshotHistory;
+
+// What the host has sent one recipient. views holds the client's picture
+// after each packet (players out of its view keep stale values), so deltas
+// resolve against exactly what the client acknowledged. priority grows
+// every frame a player is in view but not sent.
+struct RecipientInterest {
+    SnapshotRing<INTEREST_HISTORY> views;
+    uint8_t priority[MAX_PLAYERS];
+
+    RecipientInterest() {
+        memset(priority, 0, sizeof(priority));
+    }
+};
+
+struct InterestSettings {
+    float nearRadius = INTEREST_NEAR_RADIUS;
+    float midRadius = INTEREST_MID_RADIUS;
+    float viewRadius = INTEREST_VIEW_RADIUS;
+    int maxRecords = INTEREST_MAX_RECORDS;
+};
+
+// Active players bucketed by cell over the world, rebuilt once per frame
+// on the first per-recipient snapshot (counting sort, no allocation after
+// the first build)
+struct InterestGrid {
+    int cols = 0;
+    int rows = 0;
+    int builtFrame = -1;
+    std::vector<uint8_t> cellStart;  // cols * rows + 1 offsets into cellPlayers
+    uint8_t cellPlayers[MAX_PLAYERS];
+    uint16_t playerCell[MAX_PLAYERS];
+};
+
 // Game state
 struct GameState {
     Player players[MAX_PLAYERS];
@@ -75,6 +187,12 @@ struct GameState {
     unsigned int lastUpdateTick; // Changed from timestamp to tick counter
     float worldWidth;
     float worldHeight;
+    SnapshotHistory history;
+    
+    // Host only: per-recipient interest state, created on first use
+    RecipientInterest* interest[MAX_PLAYERS];
+    InterestSettings interestSettings;
+    InterestGrid interestGrid;
     
     GameState() : maxPlayers(8), frameNumber(0), lastUpdateTick(0), 
                   worldWidth(WORLD_WIDTH), worldHeight(WORLD_HEIGHT) {
@@ -83,8 +201,18 @@ struct GameState {
             // Use deterministic positioning instead of random
             players[i].x = worldWidth / 2 + (deterministic_random() - 0.5) * 200;
             players[i].y = worldHeight / 2 + (deterministic_random() - 0.5) * 200;
+            interest[i] = nullptr;
+        }
+    }
+    
+    ~GameState() {
+        for (int i = 0; i < MAX_PLAYERS; i++) {
+            delete interest[i];
         }
     }
+    
+    GameState(const GameState&) = delete;
+    GameState& operator=(const GameState&) = delete;
 };
 
 // Global state buffer for JSON serialization
@@ -123,28 +251,13 @@ std::string serializeGameState(const GameState* state) {
     return json.str();
 }
 
-// Helper function to parse input JSON (simplified)
-void parseInput(const char* inputJson, int playerIndex, GameState* state) {
-    // Simple parsing for movement input
-    // Expected format: {"type":"move","dx":0.5,"dy":-0.3}
-    
+// Apply a decoded input command to a player (shared by JSON and binary input)
+void applyPlayerInput(GameState* state, int playerIndex, float dx, float dy, bool attack) {
     Player& player = state->players[playerIndex];
     if (!player.active) {
         player.active = true;
     }
     
-    // Extract dx and dy from JSON (simplified parsing)
-    float dx = 0, dy = 0;
-    const char* dxStr = strstr(inputJson, "\"dx\":");
-    const char* dyStr = strstr(inputJson, "\"dy\":");
-    
-    if (dxStr) {
-        dx = atof(dxStr + 5);
-    }
-    if (dyStr) {
-        dy = atof(dyStr + 5);
-    }
-    
     // Normalize input vector
     float mag = sqrt(dx * dx + dy * dy);
     if (mag > 0.1f) {
@@ -157,9 +270,7 @@ void parseInput(const char* inputJson, int playerIndex, GameState* state) {
     player.vy = dy * PLAYER_SPEED;
     player.lastInputTick = get_game_tick();
     
-    // Check for action type
-    if (strstr(inputJson, "\"type\":\"attack\"")) {
-        // Handle attack action
+    if (attack) {
         // Find nearest player and deal damage
         for (int i = 0; i < state->maxPlayers; i++) {
             if (i != playerIndex && state->players[i].active) {
@@ -178,6 +289,353 @@ void parseInput(const char* inputJson, int playerIndex, GameState* state) {
     }
 }
 
+// Parse input JSON: {"type":"move","dx":0.5,"dy":-0.3}
+void parseInput(const char* inputJson, int inputLen, int playerIndex, GameState* state) {
+    float dx = 0, dy = 0;
+    bool attack = false;
+    
+    JsonReader r(inputJson, inputLen);
+    JsonStr key, str;
+    if (r.begin_object()) {
+        while (r.next_key(key)) {
+            if (key == "dx") {
+                r.read_float(dx);
+            } else if (key == "dy") {
+                r.read_float(dy);
+            } else if (key == "type" && r.peek() == JsonReader::String) {
+                r.read_string(str);
+                attack = (str == "attack");
+            } else {
+                r.skip();
+            }
+        }
+    }
+    
+    applyPlayerInput(state, playerIndex, dx, dy, attack);
+}
+
+// ============================================================================
+// Binary snapshots
+// ============================================================================
+//
+// Header (28 bytes, little endian):
+//   u16 magic  u8 version  u8 flags  u32 frame  u32 baseFrame
+//   u64 activeMask  u64 dirtyMask
+// Then, for each bit set in dirtyMask (ascending player index):
+//   u8 fieldMask, followed by the fields it names in this order:
+//   POS u16 x, u16 y | VEL i16 vx, i16 vy | HEALTH i16 | SCORE i32
+//
+// A full snapshot (flags without DELTA) marks every active player dirty with
+// all fields. A delta only carries fields that differ from baseFrame; active
+// players that are not dirty keep their baseline values.
+
+static uint8_t g_stateBinaryBuffer[SNAPSHOT_MAX_SIZE];
+static int g_stateBinarySize = 0;
+
+static inline void put_u16(uint8_t*& p, uint16_t v) {
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)(v >> 8);
+    p += 2;
+}
+
+static inline void put_u32(uint8_t*& p, uint32_t v) {
+    put_u16(p, (uint16_t)(v & 0xFFFF));
+    put_u16(p, (uint16_t)(v >> 16));
+}
+
+static inline void put_u64(uint8_t*& p, uint64_t v) {
+    put_u32(p, (uint32_t)(v & 0xFFFFFFFFu));
+    put_u32(p, (uint32_t)(v >> 32));
+}
+
+static inline uint16_t get_u16(const uint8_t*& p) {
+    uint16_t v = (uint16_t)(p[0] | (p[1] << 8));
+    p += 2;
+    return v;
+}
+
+static inline uint32_t get_u32(const uint8_t*& p) {
+    uint32_t lo = get_u16(p);
+    uint32_t hi = get_u16(p);
+    return lo | (hi << 16);
+}
+
+static inline uint64_t get_u64(const uint8_t*& p) {
+    uint64_t lo = get_u32(p);
+    uint64_t hi = get_u32(p);
+    return lo | (hi << 32);
+}
+
+static inline int quantize(float v, float scale, int lo, int hi) {
+    int q = (int)lroundf(v * scale);
+    return q < lo ? lo : (q > hi ? hi : q);
+}
+
+static void quantizeState(const GameState* state, QuantizedSnapshot& out) {
+    out.frame = (unsigned int)state->frameNumber;
+    out.activeMask = 0;
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        const Player& p = state->players[i];
+        QuantizedPlayer& q = out.players[i];
+        q.x = (uint16_t)quantize(p.x, SNAPSHOT_POS_SCALE, 0, 65535);
+        q.y = (uint16_t)quantize(p.y, SNAPSHOT_POS_SCALE, 0, 65535);
+        q.vx = (int16_t)quantize(p.vx, SNAPSHOT_VEL_SCALE, -32768, 32767);
+        q.vy = (int16_t)quantize(p.vy, SNAPSHOT_VEL_SCALE, -32768, 32767);
+        q.health = (int16_t)(p.health < -32768 ? -32768 : (p.health > 32767 ? 32767 : p.health));
+        q.score = (int32_t)p.score;
+        if (i < state->maxPlayers && p.active) {
+            out.activeMask |= playerBit(i);
+        }
+    }
+}
+
+static uint8_t diffFields(const QuantizedPlayer& a, const QuantizedPlayer& b) {
+    uint8_t fields = 0;
+    if (a.x != b.x || a.y != b.y) fields |= SNAPSHOT_FIELD_POS;
+    if (a.vx != b.vx || a.vy != b.vy) fields |= SNAPSHOT_FIELD_VEL;
+    if (a.health != b.health) fields |= SNAPSHOT_FIELD_HEALTH;
+    if (a.score != b.score) fields |= SNAPSHOT_FIELD_SCORE;
+    return fields;
+}
+
+// Encode current state into out (SNAPSHOT_MAX_SIZE bytes), as a delta against
+// base when given; returns the encoded size
+static int encodeSnapshot(const QuantizedSnapshot& cur, const QuantizedSnapshot* base, uint8_t* out) {
+    uint8_t fieldMasks[MAX_PLAYERS];
+    PlayerMask dirtyMask = 0;
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        fieldMasks[i] = 0;
+        if (!(cur.activeMask & playerBit(i))) continue;
+        // Players that just became active are sent in full
+        const bool inBase = base && (base->activeMask & playerBit(i));
+        fieldMasks[i] = inBase ? diffFields(cur.players[i], base->players[i]) : SNAPSHOT_FIELD_ALL;
+        if (fieldMasks[i]) dirtyMask |= playerBit(i);
+    }
+    
+    uint8_t* p = out;
+    put_u16(p, SNAPSHOT_MAGIC);
+    *p++ = SNAPSHOT_VERSION;
+    *p++ = base ? SNAPSHOT_FLAG_DELTA : 0;
+    put_u32(p, cur.frame);
+    put_u32(p, base ? base->frame : 0);
+    put_u64(p, cur.activeMask);
+    put_u64(p, dirtyMask);
+    
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        if (!(dirtyMask & playerBit(i))) continue;
+        const QuantizedPlayer& q = cur.players[i];
+        *p++ = fieldMasks[i];
+        if (fieldMasks[i] & SNAPSHOT_FIELD_POS) { put_u16(p, q.x); put_u16(p, q.y); }
+        if (fieldMasks[i] & SNAPSHOT_FIELD_VEL) { put_u16(p, (uint16_t)q.vx); put_u16(p, (uint16_t)q.vy); }
+        if (fieldMasks[i] & SNAPSHOT_FIELD_HEALTH) { put_u16(p, (uint16_t)q.health); }
+        if (fieldMasks[i] & SNAPSHOT_FIELD_SCORE) { put_u32(p, (uint32_t)q.score); }
+    }
+    return (int)(p - out);
+}
+
+// Decode a snapshot into out, resolving deltas against history; returns
+// false for malformed data or an unknown baseline
+static bool decodeSnapshot(const uint8_t* data, int len, const SnapshotHistory& history, QuantizedSnapshot& out) {
+    if (!data || len < SNAPSHOT_HEADER_SIZE) return false;
+    const uint8_t* p = data;
+    const uint8_t* end = data + len;
+    if (get_u16(p) != SNAPSHOT_MAGIC) return false;
+    if (*p++ != SNAPSHOT_VERSION) return false;
+    const uint8_t flags = *p++;
+    const unsigned int frame = get_u32(p);
+    const unsigned int baseFrame = get_u32(p);
+    const PlayerMask activeMask = get_u64(p);
+    const PlayerMask dirtyMask = get_u64(p);
+    
+    if (flags & SNAPSHOT_FLAG_DELTA) {
+        const QuantizedSnapshot* base = history.find(baseFrame);
+        if (!base) return false;
+        out = *base;
+    } else {
+        memset(&out, 0, sizeof(out));
+    }
+    out.frame = frame;
+    out.activeMask = activeMask;
+    
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        if (!(dirtyMask & playerBit(i))) continue;
+        if (p >= end) return false;
+        const uint8_t fields = *p++;
+        const int need = ((fields & SNAPSHOT_FIELD_POS) ? 4 : 0) + ((fields & SNAPSHOT_FIELD_VEL) ? 4 : 0) +
+                         ((fields & SNAPSHOT_FIELD_HEALTH) ? 2 : 0) + ((fields & SNAPSHOT_FIELD_SCORE) ? 4 : 0);
+        if (end - p < need) return false;
+        QuantizedPlayer& q = out.players[i];
+        if (fields & SNAPSHOT_FIELD_POS) { q.x = get_u16(p); q.y = get_u16(p); }
+        if (fields & SNAPSHOT_FIELD_VEL) { q.vx = (int16_t)get_u16(p); q.vy = (int16_t)get_u16(p); }
+        if (fields & SNAPSHOT_FIELD_HEALTH) { q.health = (int16_t)get_u16(p); }
+        if (fields & SNAPSHOT_FIELD_SCORE) { q.score = (int32_t)get_u32(p); }
+    }
+    return true;
+}
+
+// Quantized state for the current frame. Recorded on first use, so every
+// client sees the same contents for a frame even if input arrived between
+// calls, and recorded baselines stay valid.
+static const QuantizedSnapshot& currentSnapshot(GameState* state) {
+    if (const QuantizedSnapshot* sent = state->history.find((unsigned int)state->frameNumber)) {
+        return *sent;
+    }
+    QuantizedSnapshot cur;
+    quantizeState(state, cur);
+    state->history.record(cur);
+    return *state->history.find(cur.frame);
+}
+
+// ============================================================================
+// Interest management
+// ============================================================================
+//
+// game_get_state_for builds one snapshot per recipient from the players
+// around that recipient's own player. Players beyond viewRadius are left
+// out of the active mask (the client drops them). The rest gain priority
+// each frame by distance tier: near +4, mid +2, far +1. A player whose
+// health changed since the client last saw it jumps straight to the
+// threshold. Players at the threshold are due; up to maxRecords of them
+// are sent, highest priority first, and their priority resets. The rest
+// carry their priority to the next frame, so nobody starves. The recipient
+// itself is always sent. The packet is an ordinary binary snapshot: a
+// delta against the view the client acknowledged, in which unsent players
+// keep their baseline values.
+
+static int interestCell(float v, float cellSize, int count) {
+    int c = (int)floorf(v / cellSize);
+    return c < 0 ? 0 : (c >= count ? count - 1 : c);
+}
+
+static void buildInterestGrid(GameState* state) {
+    InterestGrid& grid = state->interestGrid;
+    if (grid.builtFrame == state->frameNumber) return;
+    grid.builtFrame = state->frameNumber;
+    grid.cols = (int)ceilf(state->worldWidth / INTEREST_CELL_SIZE);
+    grid.rows = (int)ceilf(state->worldHeight / INTEREST_CELL_SIZE);
+    if (grid.cols < 1) grid.cols = 1;
+    if (grid.rows < 1) grid.rows = 1;
+    const int cells = grid.cols * grid.rows;
+    grid.cellStart.assign(cells + 1, 0);
+    
+    for (int i = 0; i < state->maxPlayers; i++) {
+        const Player& p = state->players[i];
+        if (!p.active) continue;
+        const int cell = interestCell(p.y, INTEREST_CELL_SIZE, grid.rows) * grid.cols +
+                         interestCell(p.x, INTEREST_CELL_SIZE, grid.cols);
+        grid.playerCell[i] = (uint16_t)cell;
+        grid.cellStart[cell + 1]++;
+    }
+    for (int c = 0; c < cells; c++) {
+        grid.cellStart[c + 1] += grid.cellStart[c];
+    }
+    uint8_t cursor[MAX_PLAYERS];
+    for (int i = 0; i < state->maxPlayers; i++) {
+        if (!state->players[i].active) continue;
+        cursor[i] = grid.cellStart[grid.playerCell[i]]++;
+    }
+    // cellStart now holds each cell's end; shift back to starts
+    for (int c = cells; c > 0; c--) {
+        grid.cellStart[c] = grid.cellStart[c - 1];
+    }
+    grid.cellStart[0] = 0;
+    for (int i = 0; i < state->maxPlayers; i++) {
+        if (!state->players[i].active) continue;
+        grid.cellPlayers[cursor[i]] = (uint8_t)i;
+    }
+}
+
+// Build recipient's view for the current frame into view, against the
+// acknowledged view base (null: a resync sending every player in view)
+static void buildInterestView(GameState* state, int recipient, const QuantizedSnapshot& cur,
+                              const QuantizedSnapshot* base, QuantizedSnapshot& view) {
+    RecipientInterest& ri = *state->interest[recipient];
+    const InterestSettings& settings = state->interestSettings;
+    const Player& me = state->players[recipient];
+    buildInterestGrid(state);
+    const InterestGrid& grid = state->interestGrid;
+    
+    if (base) {
+        view = *base;
+    } else {
+        memset(&view, 0, sizeof(view));
+    }
+    view.frame = cur.frame;
+    PlayerMask mask = 0;
+    PlayerMask inRange = 0;
+    
+    // Candidates: players in the cells under the leave radius
+    const float reach = settings.viewRadius + INTEREST_LEAVE_MARGIN;
+    const int x0 = interestCell(me.x - reach, INTEREST_CELL_SIZE, grid.cols);
+    const int x1 = interestCell(me.x + reach, INTEREST_CELL_SIZE, grid.cols);
+    const int y0 = interestCell(me.y - reach, INTEREST_CELL_SIZE, grid.rows);
+    const int y1 = interestCell(me.y + reach, INTEREST_CELL_SIZE, grid.rows);
+    
+    uint8_t due[MAX_PLAYERS];
+    int dueCount = 0;
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            const int cell = cy * grid.cols + cx;
+            for (int k = grid.cellStart[cell]; k < grid.cellStart[cell + 1]; k++) {
+                const int j = grid.cellPlayers[k];
+                const Player& other = state->players[j];
+                const float dx = other.x - me.x;
+                const float dy = other.y - me.y;
+                const float distSq = dx * dx + dy * dy;
+                const bool known = base && (base->activeMask & playerBit(j));
+                const float limit = known ? reach : settings.viewRadius;
+                if (j != recipient && distSq > limit * limit) continue;
+                inRange |= playerBit(j);
+                
+                // Known players stay in view at their baseline values until sent
+                if (known) mask |= playerBit(j);
+                int gain = distSq <= settings.nearRadius * settings.nearRadius ? 4 :
+                           distSq <= settings.midRadius * settings.midRadius ? 2 : 1;
+                if (known && cur.players[j].health != base->players[j].health) {
+                    gain = INTEREST_SEND_THRESHOLD;
+                }
+                const int raised = ri.priority[j] + gain;
+                ri.priority[j] = (uint8_t)(raised > 255 ? 255 : raised);
+                if (ri.priority[j] >= INTEREST_SEND_THRESHOLD || j == recipient || !base) {
+                    due[dueCount++] = (uint8_t)j;
+                }
+            }
+        }
+    }
+    
+    // Recipient first, then highest priority; ties by index so hosts agree
+    for (int a = 1; a < dueCount; a++) {
+        const uint8_t j = due[a];
+        int b = a;
+        while (b > 0) {
+            const int k = due[b - 1];
+            const bool before = j == recipient ||
+                (k != recipient && (ri.priority[j] > ri.priority[k] ||
+                                    (ri.priority[j] == ri.priority[k] && j < k)));
+            if (!before) break;
+            due[b] = due[b - 1];
+            b--;
+        }
+        due[b] = j;
+    }
+    
+    int sent = 0;
+    for (int a = 0; a < dueCount; a++) {
+        const int j = due[a];
+        if (j != recipient && base && sent >= settings.maxRecords) break;
+        if (j != recipient) sent++;
+        view.players[j] = cur.players[j];
+        mask |= playerBit(j);
+        ri.priority[j] = 0;
+    }
+    
+    // Players out of range start from nothing when they come back
+    for (int j = 0; j < MAX_PLAYERS; j++) {
+        if (!(inRange & playerBit(j))) ri.priority[j] = 0;
+    }
+    view.activeMask = mask & cur.activeMask;
+}
+
 extern "C" {
 
 // Initialize game with configuration
@@ -289,7 +747,8 @@ void game_update(GameState* state, float deltaTime) {
 void game_handle_input(GameState* state, int playerIndex, const char* inputJson, int inputLen) {
     if (!state || playerIndex < 0 || playerIndex >= state->maxPlayers) return;
     
-    parseInput(inputJson, playerIndex, state);
+    if (!inputJson) return;
+    parseInput(inputJson, inputLen > 0 ? inputLen : (int)strlen(inputJson), playerIndex, state);
 }
 
 // Get current game state as JSON
@@ -319,67 +778,176 @@ int game_get_state_size(GameState* state) {
     return strlen(g_stateJsonBuffer);
 }
 
+// Fields present in a JSON player object; absent ones keep the client's values
+enum JsonPlayerField {
+    JSON_PLAYER_X = 1 << 0,
+    JSON_PLAYER_Y = 1 << 1,
+    JSON_PLAYER_VX = 1 << 2,
+    JSON_PLAYER_VY = 1 << 3,
+    JSON_PLAYER_HEALTH = 1 << 4,
+    JSON_PLAYER_SCORE = 1 << 5
+};
+
+// Read one player object from a JSON state snapshot
+static int parseStatePlayer(JsonReader& r, Player& p, int& fields) {
+    int id = -1;
+    fields = 0;
+    JsonStr key;
+    if (!r.begin_object()) return -1;
+    while (r.next_key(key)) {
+        if (key == "id") r.read_int(id);
+        else if (key == "x") { r.read_float(p.x); fields |= JSON_PLAYER_X; }
+        else if (key == "y") { r.read_float(p.y); fields |= JSON_PLAYER_Y; }
+        else if (key == "vx") { r.read_float(p.vx); fields |= JSON_PLAYER_VX; }
+        else if (key == "vy") { r.read_float(p.vy); fields |= JSON_PLAYER_VY; }
+        else if (key == "health") { r.read_int(p.health); fields |= JSON_PLAYER_HEALTH; }
+        else if (key == "score") { r.read_int(p.score); fields |= JSON_PLAYER_SCORE; }
+        else r.skip();
+    }
+    return id;
+}
+
 // Apply state snapshot (for clients)
 void game_apply_state(GameState* state, const char* stateJson, int jsonLen) {
     if (!state || !stateJson) return;
+    if (jsonLen <= 0) jsonLen = (int)strlen(stateJson);
     
-    // Parse JSON and update state
-    // This is a simplified version - in production you'd want proper JSON parsing
-    
-    // Extract frame number
-    const char* frameStr = strstr(stateJson, "\"frameNumber\":");
-    if (frameStr) {
-        state->frameNumber = atoi(frameStr + 14);
+    JsonReader r(stateJson, jsonLen);
+    JsonStr key;
+    if (!r.begin_object()) return;
+    while (r.next_key(key)) {
+        if (key == "frameNumber") {
+            int frame = 0;
+            if (r.read_int(frame)) state->frameNumber = frame;
+        } else if (key == "players" && r.peek() == JsonReader::Array) {
+            // Reset all players; the snapshot lists the active ones
+            for (int i = 0; i < MAX_PLAYERS; i++) {
+                state->players[i].active = false;
+            }
+            
+            r.begin_array();
+            while (r.next_element()) {
+                Player parsed = Player();
+                int fields = 0;
+                const int id = parseStatePlayer(r, parsed, fields);
+                if (id >= 0 && id < MAX_PLAYERS) {
+                    Player& p = state->players[id];
+                    if (fields & JSON_PLAYER_X) p.x = parsed.x;
+                    if (fields & JSON_PLAYER_Y) p.y = parsed.y;
+                    if (fields & JSON_PLAYER_VX) p.vx = parsed.vx;
+                    if (fields & JSON_PLAYER_VY) p.vy = parsed.vy;
+                    if (fields & JSON_PLAYER_HEALTH) p.health = parsed.health;
+                    if (fields & JSON_PLAYER_SCORE) p.score = parsed.score;
+                    p.active = true;
+                    p.id = id;
+                }
+            }
+        } else {
+            r.skip();
+        }
     }
+}
+
+// Handle player input in the 3-byte binary format (see INPUT_BINARY_SIZE)
+void game_handle_input_binary(GameState* state, int playerIndex, const uint8_t* input, int inputLen) {
+    if (!state || !input || inputLen < INPUT_BINARY_SIZE) return;
+    if (playerIndex < 0 || playerIndex >= state->maxPlayers) return;
+    
+    const float dx = (float)(int8_t)input[1] / 127.0f;
+    const float dy = (float)(int8_t)input[2] / 127.0f;
+    applyPlayerInput(state, playerIndex, dx, dy, input[0] == INPUT_TYPE_ATTACK);
+}
+
+// Encode current state as a binary snapshot. ackFrame is the last frame the
+// receiving client acknowledged (0 for none); when it is still in history the
+// snapshot is a delta against it, otherwise a full snapshot. The returned
+// buffer is reused by the next call; its length is game_get_state_binary_size.
+const uint8_t* game_get_state_binary(GameState* state, unsigned int ackFrame) {
+    if (!state) return nullptr;
     
-    // Extract players array
-    const char* playersStr = strstr(stateJson, "\"players\":[");
-    if (!playersStr) return;
+    const QuantizedSnapshot& cur = currentSnapshot(state);
     
-    // Reset all players
-    for (int i = 0; i < MAX_PLAYERS; i++) {
-        state->players[i].active = false;
+    const QuantizedSnapshot* base = nullptr;
+    if (ackFrame != 0 && ackFrame != cur.frame) {
+        base = state->history.find(ackFrame);
+    }
+    g_stateBinarySize = encodeSnapshot(cur, base, g_stateBinaryBuffer);
+    return g_stateBinaryBuffer;
+}
+
+// Encode the current state as seen by recipient's player (see Interest
+// management). ackFrame is the last frame that client acknowledged from
+// this function; deltas resolve against its view at that frame, or fall
+// back to a full view once it leaves the INTEREST_HISTORY window. Calling
+// again in the same frame re-sends the same view. Clients apply the result
+// with game_apply_state_binary; players out of view come back inactive.
+// Shares the buffer and size of game_get_state_binary.
+const uint8_t* game_get_state_for(GameState* state, int recipient, unsigned int ackFrame) {
+    if (!state || recipient < 0 || recipient >= state->maxPlayers) return nullptr;
+    if (!state->interest[recipient]) {
+        state->interest[recipient] = new RecipientInterest();
     }
+    RecipientInterest& ri = *state->interest[recipient];
+    const QuantizedSnapshot& cur = currentSnapshot(state);
     
-    // Parse each player
-    const char* playerStart = playersStr + 11;
-    while (*playerStart && *playerStart != ']') {
-        if (*playerStart == '{') {
-            // Parse player object
-            int id = -1;
-            float x = 0, y = 0, vx = 0, vy = 0;
-            int health = 100, score = 0;
-            
-            const char* idStr = strstr(playerStart, "\"id\":");
-            if (idStr && idStr < strstr(playerStart, "}")) {
-                id = atoi(idStr + 5);
-            }
-            
-            if (id >= 0 && id < MAX_PLAYERS) {
-                const char* xStr = strstr(playerStart, "\"x\":");
-                const char* yStr = strstr(playerStart, "\"y\":");
-                const char* vxStr = strstr(playerStart, "\"vx\":");
-                const char* vyStr = strstr(playerStart, "\"vy\":");
-                const char* healthStr = strstr(playerStart, "\"health\":");
-                const char* scoreStr = strstr(playerStart, "\"score\":");
-                
-                if (xStr) state->players[id].x = atof(xStr + 4);
-                if (yStr) state->players[id].y = atof(yStr + 4);
-                if (vxStr) state->players[id].vx = atof(vxStr + 5);
-                if (vyStr) state->players[id].vy = atof(vyStr + 5);
-                if (healthStr) state->players[id].health = atoi(healthStr + 9);
-                if (scoreStr) state->players[id].score = atoi(scoreStr + 8);
-                
-                state->players[id].active = true;
-                state->players[id].id = id;
-            }
-            
-            // Move to next player
-            playerStart = strstr(playerStart, "}");
-            if (!playerStart) break;
-        }
-        playerStart++;
+    const QuantizedSnapshot* base = nullptr;
+    if (ackFrame != 0 && ackFrame != cur.frame) {
+        base = ri.views.find(ackFrame);
+    }
+    const QuantizedSnapshot* view = ri.views.find(cur.frame);
+    if (!view) {
+        QuantizedSnapshot built;
+        buildInterestView(state, recipient, cur, base, built);
+        ri.views.record(built);
+        view = ri.views.find(cur.frame);
+    }
+    g_stateBinarySize = encodeSnapshot(*view, base, g_stateBinaryBuffer);
+    return g_stateBinaryBuffer;
+}
+
+// Tune interest management: tier radii in px and the per-packet player
+// budget. Zero or negative values keep the current setting. Settings apply
+// from the next frame's views.
+void game_set_interest(GameState* state, float nearRadius, float midRadius, float viewRadius, int maxRecords) {
+    if (!state) return;
+    InterestSettings& settings = state->interestSettings;
+    if (nearRadius > 0) settings.nearRadius = nearRadius;
+    if (midRadius > 0) settings.midRadius = midRadius;
+    if (viewRadius > 0) settings.viewRadius = viewRadius;
+    if (maxRecords > 0) settings.maxRecords = maxRecords;
+}
+
+// Get size of the last binary snapshot
+int game_get_state_binary_size(GameState* state) {
+    if (!state) return 0;
+    return g_stateBinarySize;
+}
+
+// Apply a binary snapshot (for clients). Returns the applied frame number,
+// which the client should acknowledge to the host, or -1 when the snapshot is
+// malformed or its delta baseline is no longer known (keep the previous ack).
+int game_apply_state_binary(GameState* state, const uint8_t* data, int len) {
+    if (!state) return -1;
+    
+    QuantizedSnapshot snap;
+    if (!decodeSnapshot(data, len, state->history, snap)) return -1;
+    state->history.record(snap);
+    
+    state->frameNumber = (int)snap.frame;
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        Player& p = state->players[i];
+        const QuantizedPlayer& q = snap.players[i];
+        p.id = i;
+        p.active = (snap.activeMask & playerBit(i)) != 0;
+        if (!p.active) continue;
+        p.x = q.x / SNAPSHOT_POS_SCALE;
+        p.y = q.y / SNAPSHOT_POS_SCALE;
+        p.vx = q.vx / SNAPSHOT_VEL_SCALE;
+        p.vy = q.vy / SNAPSHOT_VEL_SCALE;
+        p.health = q.health;
+        p.score = q.score;
     }
+    return (int)snap.frame;
 }
 
 // Clean up game state
@@ -10,13 +10,20 @@
  */
 
 #include <cmath>
+#include <memory>
 #include <vector>
 #include <cstdint>
 #include "coordinators/GameCoordinator.h"
+#include "coordinators/InputLog.h"
 #include "GameGlobals.h"
+#include "BalanceTable.h"
+#include "Profiler.h"
+#include "BuildConfig.h"
+#include "AllocCounter.h"
 #include "physics/PhysicsManager.h"
 #include "physics/PhysicsConstants.h"
 #include "physics/PhysicsTypes.h"
+#include "physics/FixedTrig.h"
 #include "physics/PhysicsEvents.h"
 #include "physics/ForceField.h"
 #include "../entities/PhysicsBarrel.h"
@@ -24,8 +31,30 @@
 // Initialize global coordinator
 GameCoordinator g_coordinator;
 
-// Barrel management
-static std::vector<PhysicsBarrel> g_barrels;
+// Barrel management: one barrel per physics body handle
+static DensePool<PhysicsBarrel> g_barrels;
+
+// Rollback snapshot scratch buffer and timings (see benchmark_state_snapshot)
+static std::vector<uint8_t> g_snapshot_scratch;
+static std::vector<uint32_t> g_query_ids;
+static float g_snapshot_save_us = 0.0f;
+static float g_snapshot_load_us = 0.0f;
+
+// Checkpoints and wall time of the last replay_run / replay_run_to
+static std::vector<ReplayCheckpoint> g_replay_checkpoints;
+static float g_replay_ms = 0.0f;
+
+namespace {
+// Full simulation image: coordinator managers followed by the barrel list
+void save_simulation_state(SnapshotWriter& w) {
+    g_coordinator.save_state(w);
+    g_barrels.save_state(w);
+}
+
+bool load_simulation_state(SnapshotReader& r) {
+    return g_coordinator.load_state(r) && g_barrels.load_state(r);
+}
+}
 
 int main() { 
     return 0; 
@@ -38,6 +67,7 @@ int main() {
 extern "C" {
 // ---- Arm System Exports ----
 
+#if DOZEDENT_ARMS
 __attribute__((export_name("init_player_arms")))
 void init_player_arms() {
     g_coordinator.get_arm_manager().initialize(&g_coordinator.get_physics_manager(), &g_coordinator.get_player_manager());
@@ -72,24 +102,128 @@ __attribute__((export_name("get_right_elbow_z"))) float get_right_elbow_z() { fl
 __attribute__((export_name("get_right_hand_x"))) float get_right_hand_x() { float x,y,z; g_coordinator.get_arm_manager().get_right_hand(x,y,z); return x; }
 __attribute__((export_name("get_right_hand_y"))) float get_right_hand_y() { float x,y,z; g_coordinator.get_arm_manager().get_right_hand(x,y,z); return y; }
 __attribute__((export_name("get_right_hand_z"))) float get_right_hand_z() { float x,y,z; g_coordinator.get_arm_manager().get_right_hand(x,y,z); return z; }
+#endif
 
 // ---- Core Lifecycle Functions ----
 
 __attribute__((export_name("init_run")))
 void init_run(unsigned long long seed, unsigned int start_weapon) {
+    balance_commit();
     g_coordinator.initialize(seed, start_weapon);
+    g_barrels.clear();  // Their bodies went with the previous run's physics state
+    g_barrels.reserve(static_cast<size_t>(g_coordinator.get_game_state_manager().get_room_capacity().barrels));
 }
 
 __attribute__((export_name("reset_run")))
 void reset_run(unsigned long long new_seed) {
     g_coordinator.reset(new_seed);
+    g_barrels.clear();
 }
 
 __attribute__((export_name("update")))
 void update(float delta_time) {
+    // Between frames: publish a balance table staged by load_balance_blob
+    balance_commit();
     g_coordinator.update(delta_time);
 }
 
+// ---- Balance Table ----
+// Blobs come from tools/scripts/generate-balance.cjs (public/data/balance/balance.bin).
+// A loaded table takes effect at the next init_run or update.
+
+// Returns 0 on success or a negative BalanceLoadResult
+__attribute__((export_name("load_balance_blob")))
+int load_balance_blob(uintptr_t ptr, int size) {
+    if (ptr == 0 || size <= 0) return BALANCE_LOAD_BAD_SIZE;
+    return balance_load_blob(reinterpret_cast<const uint8_t*>(ptr), static_cast<size_t>(size));
+}
+
+__attribute__((export_name("reset_balance_defaults")))
+void reset_balance_defaults() {
+    balance_reset_defaults();
+}
+
+__attribute__((export_name("get_balance_revision")))
+unsigned int get_balance_revision() {
+    return balance_active_table().revision;
+}
+
+__attribute__((export_name("get_balance_value")))
+float get_balance_value(int key) {
+    if (key < 0 || key >= BAL_KEY_COUNT) return 0.0f;
+    return bal(static_cast<BalanceKey>(key));
+}
+
+__attribute__((export_name("get_balance_blob_size")))
+int get_balance_blob_size() {
+    return static_cast<int>(BALANCE_BLOB_SIZE);
+}
+
+// ---- Rollback State Snapshots ----
+// save_state_to / load_state_from copy a raw image of the whole simulation
+// (bodies, constraints, wolves and packs, RNG and phase state, combat,
+// player and skeleton). Images are only valid for the build that wrote them.
+
+__attribute__((export_name("get_state_snapshot_size")))
+int get_state_snapshot_size() {
+    SnapshotWriter counter;
+    save_simulation_state(counter);
+    return static_cast<int>(counter.size());
+}
+
+// Returns bytes written, or 0 when capacity is smaller than get_state_snapshot_size()
+__attribute__((export_name("save_state_to")))
+int save_state_to(uintptr_t out_ptr, int capacity) {
+    if (out_ptr == 0 || capacity <= 0) return 0;
+    SnapshotWriter w(reinterpret_cast<uint8_t*>(out_ptr), static_cast<size_t>(capacity));
+    save_simulation_state(w);
+    return w.ok() ? static_cast<int>(w.size()) : 0;
+}
+
+// Returns 1 on success; 0 for a foreign or corrupt image (state should then be reset)
+__attribute__((export_name("load_state_from")))
+int load_state_from(uintptr_t in_ptr, int size) {
+    if (in_ptr == 0 || size <= 0) return 0;
+    SnapshotReader r(reinterpret_cast<const uint8_t*>(in_ptr), static_cast<size_t>(size));
+    return load_simulation_state(r) ? 1 : 0;
+}
+
+// Save and restore the current state `iterations` times into a scratch buffer;
+// returns the snapshot size in bytes. Per-call costs via the getters below.
+__attribute__((export_name("benchmark_state_snapshot")))
+int benchmark_state_snapshot(int iterations) {
+    const int size = get_state_snapshot_size();
+    g_snapshot_scratch.resize(static_cast<size_t>(size));
+    iterations = std::max(1, iterations);
+    
+    double save_ms = 0.0;
+    double load_ms = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        const double t0 = perf_now_ms();
+        SnapshotWriter w(g_snapshot_scratch.data(), g_snapshot_scratch.size());
+        save_simulation_state(w);
+        const double t1 = perf_now_ms();
+        SnapshotReader r(g_snapshot_scratch.data(), w.size());
+        load_simulation_state(r);
+        const double t2 = perf_now_ms();
+        save_ms += t1 - t0;
+        load_ms += t2 - t1;
+    }
+    g_snapshot_save_us = static_cast<float>(save_ms * 1000.0 / iterations);
+    g_snapshot_load_us = static_cast<float>(load_ms * 1000.0 / iterations);
+    return size;
+}
+
+__attribute__((export_name("get_state_snapshot_save_us")))
+float get_state_snapshot_save_us() {
+    return g_snapshot_save_us;
+}
+
+__attribute__((export_name("get_state_snapshot_load_us")))
+float get_state_snapshot_load_us() {
+    return g_snapshot_load_us;
+}
+
 // ---- Input Functions ----
 
 __attribute__((export_name("set_player_input")))
@@ -117,6 +251,25 @@ void set_player_input(float input_x, float input_y, int rolling, int jumping,
                                   light_attack, heavy_attack, blocking, special);
 }
 
+// ---- Input Command Ring ----
+
+// Shared-memory input (see managers/InputCommandRing.h): JS writes commands
+// at the returned address with no calls, and update drains them
+__attribute__((export_name("get_input_command_ring_ptr")))
+uintptr_t get_input_command_ring_ptr() {
+    return reinterpret_cast<uintptr_t>(g_coordinator.get_input_manager().get_command_ring().data());
+}
+
+__attribute__((export_name("get_input_command_ring_version")))
+uint32_t get_input_command_ring_version() {
+    return input_command::VERSION;
+}
+
+__attribute__((export_name("get_input_command_stride")))
+uint32_t get_input_command_stride() {
+    return sizeof(InputCommand);
+}
+
 // ---- Player State Getters ----
 
 __attribute__((export_name("get_x")))
@@ -181,6 +334,7 @@ float get_facing_y() {
 
 // ---- Warden Shoulder Bash Abilities ----
 
+#if DOZEDENT_HAS_BASH
 __attribute__((used)) __attribute__((export_name("start_charging_bash")))
 void start_charging_bash() {
     g_coordinator.get_player_manager().start_charging_bash();
@@ -235,9 +389,11 @@ __attribute__((used)) __attribute__((export_name("check_bash_collision")))
 int check_bash_collision(float target_x, float target_y, float target_radius) {
     return g_coordinator.get_player_manager().check_bash_collision(target_x, target_y, target_radius) ? 1 : 0;
 }
+#endif
 
 // ---- Raider Berserker Charge Abilities ----
 
+#if DOZEDENT_HAS_BERSERKER_CHARGE
 __attribute__((used)) __attribute__((export_name("start_berserker_charge")))
 void start_berserker_charge() {
     g_coordinator.get_player_manager().start_berserker_charge();
@@ -282,9 +438,11 @@ __attribute__((used)) __attribute__((export_name("is_berserker_unstoppable")))
 int is_berserker_unstoppable() {
     return g_coordinator.get_player_manager().is_berserker_unstoppable() ? 1 : 0;
 }
+#endif
 
 // ---- Kensei Flow Dash Abilities ----
 
+#if DOZEDENT_HAS_FLOW_DASH
 __attribute__((used)) __attribute__((export_name("execute_flow_dash")))
 void execute_flow_dash(float direction_x, float direction_y) {
     g_coordinator.get_player_manager().execute_flow_dash(direction_x, direction_y);
@@ -324,6 +482,7 @@ __attribute__((used)) __attribute__((export_name("can_dash_cancel")))
 int can_dash_cancel() {
     return g_coordinator.get_player_manager().can_dash_cancel() ? 1 : 0;
 }
+#endif
 
 // ---- Game State Getters ----
 
@@ -520,6 +679,13 @@ void force_phase_transition(int target_phase) {
 
 // ---- Utility Functions ----
 
+// BuildConfig.h feature mask: character class in bits 0-1 (0 = all classes),
+// then arms 4, skeleton 8, debug getters 16
+__attribute__((export_name("get_build_features")))
+uint32_t get_build_features() {
+    return build::FEATURE_MASK;
+}
+
 __attribute__((export_name("clear_input_latch")))
 void clear_input_latch() {
     g_coordinator.get_input_manager().clear_input_latches();
@@ -547,48 +713,313 @@ void apply_physics_knockback(float dx, float dy, float force) {
 
 __attribute__((export_name("get_physics_player_x")))
 float get_physics_player_x() {
-    const RigidBody* body = g_coordinator.get_physics_manager().get_body(0);
-    return body ? body->position.x.to_float() : 0.5f;
+    BodySnapshot body;
+    return g_coordinator.get_physics_manager().read_body(0, body) ? body.position.x.to_float() : 0.5f;
 }
 
 __attribute__((export_name("get_physics_player_y")))
 float get_physics_player_y() {
-    const RigidBody* body = g_coordinator.get_physics_manager().get_body(0);
-    return body ? body->position.y.to_float() : 0.5f;
+    BodySnapshot body;
+    return g_coordinator.get_physics_manager().read_body(0, body) ? body.position.y.to_float() : 0.5f;
 }
 
 __attribute__((export_name("get_physics_player_vel_x")))
 float get_physics_player_vel_x() {
-    const RigidBody* body = g_coordinator.get_physics_manager().get_body(0);
-    return body ? body->velocity.x.to_float() : 0.0f;
+    BodySnapshot body;
+    return g_coordinator.get_physics_manager().read_body(0, body) ? body.velocity.x.to_float() : 0.0f;
 }
 
 __attribute__((export_name("get_physics_player_vel_y")))
 float get_physics_player_vel_y() {
-    const RigidBody* body = g_coordinator.get_physics_manager().get_body(0);
-    return body ? body->velocity.y.to_float() : 0.0f;
+    BodySnapshot body;
+    return g_coordinator.get_physics_manager().read_body(0, body) ? body.velocity.y.to_float() : 0.0f;
 }
 
+#if DOZEDENT_DEBUG_EXPORTS
 __attribute__((export_name("get_physics_perf_ms")))
 float get_physics_perf_ms() {
     return g_coordinator.get_physics_manager().get_last_step_time_ms();
 }
+#endif
+
+#if DOZEDENT_COUNT_ALLOCS
+// Operator new calls and bytes since the module started (monotonic; diff successive reads)
+__attribute__((export_name("get_heap_alloc_count")))
+uint32_t get_heap_alloc_count() {
+    return static_cast<uint32_t>(alloc_counter::count());
+}
+
+__attribute__((export_name("get_heap_alloc_bytes")))
+double get_heap_alloc_bytes() {
+    return static_cast<double>(alloc_counter::bytes());
+}
+#endif
+
+// ---- Budgeted Stepping Exports ----
+
+// Render bodies at previous + (current - previous) * alpha instead of forcing extra steps
+__attribute__((export_name("get_physics_alpha")))
+float get_physics_alpha() {
+    return g_coordinator.get_physics_manager().get_interpolation_alpha();
+}
+
+// Wall-clock cap on one update's fixed steps; 0 disables. Must stay 0 for lockstep, rollback
+// and replay (the step count would depend on the machine); sim_step and replay_run ignore it
+__attribute__((export_name("set_physics_step_budget_ms")))
+void set_physics_step_budget_ms(float budget_ms) {
+    g_coordinator.get_physics_manager().set_step_budget_ms(budget_ms);
+}
+
+__attribute__((export_name("get_physics_step_budget_ms")))
+float get_physics_step_budget_ms() {
+    return g_coordinator.get_physics_manager().get_step_budget_ms();
+}
+
+// Simulation time skipped (stalls, budget overruns) since init or reset
+__attribute__((export_name("get_physics_dropped_ms")))
+float get_physics_dropped_ms() {
+    return g_coordinator.get_physics_manager().get_dropped_time_ms();
+}
+
+__attribute__((export_name("get_physics_steps_last_frame")))
+int get_physics_steps_last_frame() {
+    return g_coordinator.get_physics_manager().get_last_steps_taken();
+}
+
+// ---- Render Interpolation Exports ----
+// Writes one 16-byte record per body into a provided buffer:
+// [id (uint32), x, y, z (float)], positions interpolated with alpha
+// (usually get_physics_alpha()). Returns the number of records written.
+__attribute__((export_name("write_interpolated_positions")))
+int write_interpolated_positions(uintptr_t out_ptr, int max_bodies, float alpha) {
+    if (out_ptr == 0 || max_bodies <= 0) {
+        return 0;
+    }
+    return g_coordinator.get_physics_manager().write_interpolated_positions(
+        alpha, reinterpret_cast<InterpolatedBody*>(out_ptr), max_bodies);
+}
+
+// ---- Hit Query Exports ----
+// One overlap query for JS-side hitboxes, instead of a call per target.
+// type: 0 circle (a, radius), 1 arc (center a, facing b, cos_half),
+// 2 capsule (a -> b, radius). Writes up to max_ids body ids and returns
+// how many overlap (may exceed max_ids).
+__attribute__((export_name("query_overlap_shape")))
+int query_overlap_shape(int type, float ax, float ay, float bx, float by, float radius, float cos_half,
+                        unsigned int layer_mask, uintptr_t out_ptr, int max_ids) {
+    QueryShape shape;
+    if (type == 1) {
+        shape = QueryShape::arc_f(ax, ay, radius, bx, by, cos_half);
+    } else if (type == 2) {
+        shape = QueryShape::capsule_f(ax, ay, bx, by, radius);
+    } else {
+        shape = QueryShape::circle_f(ax, ay, radius);
+    }
+    const int found = g_coordinator.get_physics_manager().query_overlap(shape, layer_mask, g_query_ids);
+    if (out_ptr != 0 && max_ids > 0) {
+        uint32_t* out = reinterpret_cast<uint32_t*>(out_ptr);
+        const int n = found < max_ids ? found : max_ids;
+        for (int i = 0; i < n; ++i) {
+            out[i] = g_query_ids[static_cast<size_t>(i)];
+        }
+    }
+    return found;
+}
+
+// Hits the native combat pass resolved this frame (source: 0 attack, 1 bash, 2 charge, 3 dash)
+__attribute__((export_name("get_frame_hit_count")))
+int get_frame_hit_count() {
+    return static_cast<int>(g_coordinator.get_combat_manager().get_frame_hits().size());
+}
+
+__attribute__((export_name("get_frame_hit_body")))
+unsigned int get_frame_hit_body(int index) {
+    const auto& hits = g_coordinator.get_combat_manager().get_frame_hits();
+    return (index >= 0 && index < static_cast<int>(hits.size())) ? hits[static_cast<size_t>(index)].body_id : 0xFFFFFFFFu;
+}
+
+__attribute__((export_name("get_frame_hit_source")))
+int get_frame_hit_source(int index) {
+    const auto& hits = g_coordinator.get_combat_manager().get_frame_hits();
+    return (index >= 0 && index < static_cast<int>(hits.size())) ? static_cast<int>(hits[static_cast<size_t>(index)].source) : -1;
+}
+
+// ---- Frame Profile Exports ----
+
+// Ring of ProfileFrame records (see Profiler.h): a uint32 frame number then
+// get_profile_zone_count() float milliseconds, get_profile_stride() bytes per
+// frame. Read get_profile_count() frames starting at slot get_profile_oldest(),
+// wrapping at get_profile_capacity(). Empty unless built with DOZEDENT_PROFILE=1.
+
+__attribute__((export_name("get_profile_ptr")))
+uintptr_t get_profile_ptr() {
+    return reinterpret_cast<uintptr_t>(GetFrameProfiler().data());
+}
+
+__attribute__((export_name("get_profile_count")))
+int get_profile_count() {
+    return static_cast<int>(GetFrameProfiler().count());
+}
+
+__attribute__((export_name("get_profile_oldest")))
+int get_profile_oldest() {
+    return static_cast<int>(GetFrameProfiler().oldest());
+}
+
+__attribute__((export_name("get_profile_capacity")))
+int get_profile_capacity() {
+    return static_cast<int>(FrameProfiler::CAPACITY);
+}
+
+__attribute__((export_name("get_profile_zone_count")))
+int get_profile_zone_count() {
+    return PROFILE_ZONE_COUNT;
+}
+
+__attribute__((export_name("get_profile_stride")))
+int get_profile_stride() {
+    return static_cast<int>(sizeof(ProfileFrame));
+}
+
+// Latest frame's time in one zone (ProfileZone order), or 0 with no frames
+__attribute__((export_name("get_profile_zone_ms")))
+float get_profile_zone_ms(int zone) {
+    const ProfileFrame* frame = GetFrameProfiler().latest();
+    if (!frame || zone < 0 || zone >= static_cast<int>(PROFILE_ZONE_COUNT)) return 0.0f;
+    return frame->zone_ms[zone];
+}
+
+__attribute__((export_name("clear_profile")))
+void clear_profile() {
+    GetFrameProfiler().clear();
+}
 
 // ---- Physics Event Queue Exports ----
 
+// The queue is a ring: ptr/count describe one contiguous span. Drain with
+// read span -> physics_consume_events(count) until count is 0.
+
 __attribute__((export_name("physics_get_event_count")))
 int physics_get_event_count() {
-    return GetPhysicsEventQueue().count();
+    return g_coordinator.get_physics_manager().get_event_queue().span_count();
 }
 
 __attribute__((export_name("physics_get_events_ptr")))
 uintptr_t physics_get_events_ptr() {
-    return reinterpret_cast<uintptr_t>(GetPhysicsEventQueue().data());
+    return reinterpret_cast<uintptr_t>(g_coordinator.get_physics_manager().get_event_queue().data());
+}
+
+__attribute__((export_name("physics_get_event_total")))
+int physics_get_event_total() {
+    return g_coordinator.get_physics_manager().get_event_queue().count();
+}
+
+__attribute__((export_name("physics_consume_events")))
+void physics_consume_events(int count) {
+    g_coordinator.get_physics_manager().get_event_queue().consume(count);
+}
+
+__attribute__((export_name("physics_get_events_dropped")))
+uint32_t physics_get_events_dropped() {
+    return g_coordinator.get_physics_manager().get_event_queue().dropped();
+}
+
+// Events ever pushed (monotonic); with dropped, what the step produced
+__attribute__((export_name("physics_get_events_pushed")))
+uint32_t physics_get_events_pushed() {
+    return g_coordinator.get_physics_manager().get_event_queue().pushed();
 }
 
 __attribute__((export_name("physics_clear_events")))
 void physics_clear_events() {
-    GetPhysicsEventQueue().clear();
+    g_coordinator.get_physics_manager().get_event_queue().clear();
+}
+
+// Contacts the coordinator's layer-pair filter kept out of the queue (monotonic)
+__attribute__((export_name("physics_get_events_filtered")))
+uint32_t physics_get_events_filtered() {
+    return g_coordinator.get_physics_manager().get_event_queue().filtered();
+}
+
+// ---- Physics Contact Stream Exports ----
+
+// Compact begin/stay/end records (20 bytes, see CompactCollisionEvent), read
+// with the same span protocol. Off until a filter is added; nothing else
+// drains it, so a subscriber that stops reading only loses new records.
+
+// Returns the rule index, or -1 when all 8 slots are taken
+__attribute__((export_name("physics_contact_filter_add")))
+int physics_contact_filter_add(uint32_t layers_a, uint32_t layers_b, float min_impulse, int report_stay) {
+    return g_coordinator.get_physics_manager().add_contact_filter(layers_a, layers_b, min_impulse, report_stay != 0);
+}
+
+__attribute__((export_name("physics_contact_filter_clear")))
+void physics_contact_filter_clear() {
+    g_coordinator.get_physics_manager().clear_contact_filters();
+}
+
+__attribute__((export_name("physics_get_contact_count")))
+int physics_get_contact_count() {
+    return g_coordinator.get_physics_manager().get_event_queue().contacts().span_count();
+}
+
+__attribute__((export_name("physics_get_contacts_ptr")))
+uintptr_t physics_get_contacts_ptr() {
+    return reinterpret_cast<uintptr_t>(g_coordinator.get_physics_manager().get_event_queue().contacts().data());
+}
+
+__attribute__((export_name("physics_get_contact_total")))
+int physics_get_contact_total() {
+    return g_coordinator.get_physics_manager().get_event_queue().contacts().count();
+}
+
+__attribute__((export_name("physics_consume_contacts")))
+void physics_consume_contacts(int count) {
+    g_coordinator.get_physics_manager().get_event_queue().contacts().consume(count);
+}
+
+__attribute__((export_name("physics_get_contacts_dropped")))
+uint32_t physics_get_contacts_dropped() {
+    return g_coordinator.get_physics_manager().get_event_queue().contacts().dropped();
+}
+
+// ---- Physics Force Fields ----
+
+// type: 0 = radial attract, 1 = radial repel, 2 = directional wind (dir_x, dir_y).
+// radius <= 0 reaches every awake body; lifetime_steps <= 0 never expires.
+// Returns the field id, or 0 for an unknown type.
+__attribute__((export_name("add_force_field")))
+uint32_t add_force_field(int type, float x, float y, float radius, float strength,
+                         float dir_x, float dir_y, int lifetime_steps) {
+    if (type < 0 || type > static_cast<int>(ForceFieldType::DirectionalWind)) return 0;
+    ForceField field;
+    field.type = static_cast<ForceFieldType>(type);
+    field.position = FixedVector3::from_floats(x, y, 0.0f);
+    field.direction = FixedVector3::from_floats(dir_x, dir_y, 0.0f);
+    field.radius = Fixed::from_float(radius);
+    field.strength = Fixed::from_float(strength);
+    return g_coordinator.get_physics_manager().add_force_field(field, lifetime_steps);
+}
+
+__attribute__((export_name("remove_force_field")))
+int remove_force_field(uint32_t id) {
+    return g_coordinator.get_physics_manager().remove_force_field(id) ? 1 : 0;
+}
+
+__attribute__((export_name("clear_force_fields")))
+void clear_force_fields() {
+    g_coordinator.get_physics_manager().clear_force_fields();
+}
+
+__attribute__((export_name("get_force_field_count")))
+int get_force_field_count() {
+    return g_coordinator.get_physics_manager().get_force_field_count();
+}
+
+// Body-field pairs that passed the radius cull during the last physics step
+__attribute__((export_name("get_force_field_evaluations")))
+uint32_t get_force_field_evaluations() {
+    return g_coordinator.get_physics_manager().get_force_field_evaluations();
 }
 
 // ---- Physics Collision Filter Utilities ----
@@ -596,14 +1027,35 @@ void physics_clear_events() {
 __attribute__((export_name("set_body_collision_filter")))
 void set_body_collision_filter(uint32_t body_id, uint32_t layer, uint32_t mask) {
     auto &pm = g_coordinator.get_physics_manager();
-    RigidBody *body = pm.get_body(body_id);
+    BodyHandle body = pm.get_body(body_id);
     if (!body) return;
     body->collision_layer = layer;
     body->collision_mask = mask;
 }
 
+// ---- Physics Continuous Collision ----
+
+// Bullets are swept from their previous to their new position each step, so
+// they cannot pass through thin bodies at high speed
+__attribute__((export_name("set_body_bullet")))
+void set_body_bullet(uint32_t body_id, int bullet) {
+    g_coordinator.get_physics_manager().set_body_bullet(body_id, bullet != 0);
+}
+
+__attribute__((export_name("is_body_bullet")))
+int is_body_bullet(uint32_t body_id) {
+    return g_coordinator.get_physics_manager().is_body_bullet(body_id) ? 1 : 0;
+}
+
+// Swept impacts resolved during the last physics step
+__attribute__((export_name("get_bullet_impacts")))
+uint32_t get_bullet_impacts() {
+    return g_coordinator.get_physics_manager().get_bullet_impacts();
+}
+
 // ---- Physics Perf Counters ----
 
+#if DOZEDENT_DEBUG_EXPORTS
 __attribute__((export_name("get_collision_pairs_checked")))
 uint32_t get_collision_pairs_checked() {
     return g_coordinator.get_physics_manager().get_pairs_checked();
@@ -614,6 +1066,65 @@ uint32_t get_collisions_resolved() {
     return g_coordinator.get_physics_manager().get_collisions_resolved();
 }
 
+// Bodies the last step visited; settled islands drop out of this count
+__attribute__((export_name("get_physics_awake_body_count")))
+int get_physics_awake_body_count() {
+    return g_coordinator.get_physics_manager().get_awake_body_count();
+}
+#endif
+
+__attribute__((export_name("set_physics_broadphase")))
+void set_physics_broadphase(int enabled) {
+    g_coordinator.get_physics_manager().enable_broadphase(enabled != 0);
+}
+
+// No-op unless built with DOZEDENT_PHYSICS_THREADS
+__attribute__((export_name("set_physics_worker_enabled")))
+void set_physics_worker_enabled(int enabled) {
+    g_coordinator.get_physics_manager().set_worker_enabled(enabled != 0);
+}
+
+__attribute__((export_name("is_physics_worker_enabled")))
+int is_physics_worker_enabled() {
+    return g_coordinator.get_physics_manager().is_worker_enabled() ? 1 : 0;
+}
+
+#if DOZEDENT_DEBUG_EXPORTS
+__attribute__((export_name("get_broadphase_rebuild_ms")))
+float get_broadphase_rebuild_ms() {
+    return g_coordinator.get_physics_manager().get_broadphase_rebuild_ms();
+}
+
+__attribute__((export_name("get_broadphase_pairgen_ms")))
+float get_broadphase_pairgen_ms() {
+    return g_coordinator.get_physics_manager().get_broadphase_pairgen_ms();
+}
+#endif
+
+// ---- Frame Hash / Desync Detection ----
+// One hash per physics step over all body fields, salted with wolf and RNG
+// state; the last 128 ticks are retained. Peers compare hashes for the same
+// tick to detect divergence. Hashes are folded to 32 bits for JS.
+
+__attribute__((export_name("set_frame_hash_enabled")))
+void set_frame_hash_enabled(int enabled) {
+    g_coordinator.get_physics_manager().set_frame_hash_enabled(enabled != 0);
+}
+
+__attribute__((export_name("get_frame_hash_tick")))
+uint32_t get_frame_hash_tick() {
+    return g_coordinator.get_physics_manager().get_latest_hashed_tick();
+}
+
+// Returns 0 when the tick is no longer retained (or was never hashed)
+__attribute__((export_name("get_frame_hash")))
+uint32_t get_frame_hash(uint32_t tick) {
+    uint64_t hash = 0;
+    if (!g_coordinator.get_physics_manager().get_frame_hash(tick, hash)) return 0;
+    const uint32_t folded = FrameHasher::fold32(hash);
+    return folded != 0 ? folded : 1;
+}
+
 // ---- Physics Barrel Functions ----
 
 __attribute__((export_name("spawn_barrel")))
@@ -636,7 +1147,7 @@ uint32_t spawn_barrel(float x, float y, float z) {
     // Create barrel entity
     PhysicsBarrel barrel;
     barrel.initialize(body_id, x, y, z);
-    g_barrels.push_back(barrel);
+    g_barrels.insert(body_id, barrel);
     
     return body_id;
 }
@@ -646,13 +1157,13 @@ void throw_barrel(uint32_t body_id, float dx, float dy, float dz, float force) {
     auto& physics_mgr = g_coordinator.get_physics_manager();
     
     // Ensure the body is awake before applying impulse
-    RigidBody* body = physics_mgr.get_body(body_id);
-    if (!body) {
+    BodySnapshot body;
+    if (!physics_mgr.read_body(body_id, body)) {
         // Body not found - this is the problem!
         return;
     }
     
-    body->wake();
+    physics_mgr.wake_body(body_id);
     
     FixedVector3 dir = FixedVector3::from_floats(dx, dy, dz).normalized();
     FixedVector3 impulse = dir * Fixed::from_float(force);
@@ -664,13 +1175,11 @@ void throw_barrel(uint32_t body_id, float dx, float dy, float dz, float force) {
     }
     
     physics_mgr.apply_impulse(body_id, impulse);
+    physics_mgr.set_body_bullet(body_id, true);
     
     // Mark as projectile for damage tracking
-    for (auto& barrel : g_barrels) {
-        if (barrel.get_body_id() == body_id) {
-            barrel.mark_as_projectile();
-            break;
-        }
+    if (PhysicsBarrel* barrel = g_barrels.find(body_id)) {
+        barrel->mark_as_projectile();
     }
 }
 
@@ -686,8 +1195,8 @@ float get_barrel_x(int index) {
     }
     
     auto& physics_mgr = g_coordinator.get_physics_manager();
-    const RigidBody* body = physics_mgr.get_body(g_barrels[index].get_body_id());
-    return body ? body->position.x.to_float() : 0.0f;
+    BodySnapshot body;
+    return physics_mgr.read_body(g_barrels[index].get_body_id(), body) ? body.position.x.to_float() : 0.0f;
 }
 
 __attribute__((export_name("get_barrel_y")))
@@ -697,8 +1206,8 @@ float get_barrel_y(int index) {
     }
     
     auto& physics_mgr = g_coordinator.get_physics_manager();
-    const RigidBody* body = physics_mgr.get_body(g_barrels[index].get_body_id());
-    return body ? body->position.y.to_float() : 0.0f;
+    BodySnapshot body;
+    return physics_mgr.read_body(g_barrels[index].get_body_id(), body) ? body.position.y.to_float() : 0.0f;
 }
 
 __attribute__((export_name("get_barrel_vel_x")))
@@ -708,8 +1217,8 @@ float get_barrel_vel_x(int index) {
     }
     
     auto& physics_mgr = g_coordinator.get_physics_manager();
-    const RigidBody* body = physics_mgr.get_body(g_barrels[index].get_body_id());
-    return body ? body->velocity.x.to_float() : 0.0f;
+    BodySnapshot body;
+    return physics_mgr.read_body(g_barrels[index].get_body_id(), body) ? body.velocity.x.to_float() : 0.0f;
 }
 
 __attribute__((export_name("get_barrel_vel_y")))
@@ -719,20 +1228,144 @@ float get_barrel_vel_y(int index) {
     }
     
     auto& physics_mgr = g_coordinator.get_physics_manager();
-    const RigidBody* body = physics_mgr.get_body(g_barrels[index].get_body_id());
-    return body ? body->velocity.y.to_float() : 0.0f;
+    BodySnapshot body;
+    return physics_mgr.read_body(g_barrels[index].get_body_id(), body) ? body.velocity.y.to_float() : 0.0f;
 }
 
 __attribute__((export_name("clear_all_barrels")))
 void clear_all_barrels() {
-    // Destroy physics bodies for all barrels
-    auto& physics_mgr = g_coordinator.get_physics_manager();
-    for (const auto& barrel : g_barrels) {
-        physics_mgr.destroy_body(barrel.get_body_id());
-    }
+    // Destroy physics bodies for all barrels in one batch (pool handles are the body ids)
+    g_coordinator.get_physics_manager().destroy_bodies(g_barrels.handle_data(), g_barrels.size());
     g_barrels.clear();
 }
 
+// ---- Entity Capacity ----
+// Room capacity hint: wolf, pack, barrel and physics body storage is reserved
+// up front so spawn waves do not reallocate mid-frame. Storage never shrinks;
+// bodies <= 0 means wolves + barrels + the player body.
+
+__attribute__((export_name("set_room_capacity")))
+void set_room_capacity(int wolves, int packs, int barrels, int bodies) {
+    GameStateManager::RoomCapacity capacity;
+    capacity.wolves = wolves;
+    capacity.packs = packs;
+    capacity.barrels = barrels;
+    capacity.bodies = bodies;
+    auto& game_state_mgr = g_coordinator.get_game_state_manager();
+    game_state_mgr.set_room_capacity(capacity);
+    g_coordinator.reserve_room_capacity();
+    g_barrels.reserve(static_cast<size_t>(game_state_mgr.get_room_capacity().barrels));
+}
+
+__attribute__((export_name("get_wolf_capacity")))
+int get_wolf_capacity() {
+    return g_coordinator.get_wolf_manager().get_wolf_capacity();
+}
+
+__attribute__((export_name("get_barrel_capacity")))
+int get_barrel_capacity() {
+    return static_cast<int>(g_barrels.capacity());
+}
+
+__attribute__((export_name("get_body_capacity")))
+int get_body_capacity() {
+    return static_cast<int>(g_coordinator.get_physics_manager().get_body_capacity());
+}
+
+// ---- Frame Arena ----
+// Per-update scratch memory. A frame that outgrows the arena spills to the
+// heap and the arena grows to the high-water mark at the next update.
+
+__attribute__((export_name("get_frame_arena_high_water")))
+int get_frame_arena_high_water() {
+    return static_cast<int>(g_coordinator.get_frame_arena().high_water());
+}
+
+__attribute__((export_name("get_frame_arena_capacity")))
+int get_frame_arena_capacity() {
+    return static_cast<int>(g_coordinator.get_frame_arena().capacity());
+}
+
+__attribute__((export_name("get_frame_arena_overflows")))
+int get_frame_arena_overflows() {
+    return static_cast<int>(g_coordinator.get_frame_arena().overflow_count());
+}
+
+// Applied when the next update starts (e.g. before a room whose high-water mark is known)
+__attribute__((export_name("reserve_frame_arena")))
+void reserve_frame_arena(int bytes) {
+    if (bytes > 0) {
+        g_coordinator.get_frame_arena().reserve(static_cast<size_t>(bytes));
+    }
+}
+
+// ---- Input Log Replay ----
+// Plays a recorded input log (format in coordinators/InputLog.h) in one
+// call: a fresh headless instance is initialized from the log header and
+// runs every tick at 60 Hz with no per-frame JS round trips. The default
+// game is then re-initialized and given the instance's final state (no
+// barrels; the log has none), so replay_run_to fast-forwards to a tick for
+// inspection with the usual getters. Checkpoint hashes are folded like
+// get_frame_hash.
+
+// Returns ticks run, or -1 if the log is malformed (the game is untouched then)
+__attribute__((export_name("replay_run_to")))
+int replay_run_to(const uint8_t* log_ptr, int len, uint32_t stop_tick) {
+    InputLogReader reader;
+    if (!log_ptr || len <= 0 || !reader.open(log_ptr, static_cast<size_t>(len))) {
+        return -1;
+    }
+    balance_commit();
+    g_replay_checkpoints.clear();
+    const double start = perf_now_ms();
+    // A fresh instance, not the default game: init_run's partial resets
+    // would let the previous run leak into the hashes
+    std::unique_ptr<SimInstance> replay(new SimInstance(reader.header().seed, reader.header().start_weapon));
+    const uint32_t ticks = replay_input_log(replay->get_coordinator(), reader, stop_tick, g_replay_checkpoints);
+    g_replay_ms = static_cast<float>(perf_now_ms() - start);
+
+    SnapshotWriter counter;
+    replay->get_coordinator().save_state(counter);
+    g_snapshot_scratch.resize(counter.size());
+    SnapshotWriter w(g_snapshot_scratch.data(), g_snapshot_scratch.size());
+    replay->get_coordinator().save_state(w);
+    // init_run first: the image carries state, not the managers' wiring
+    clear_all_barrels();
+    init_run(reader.header().seed, reader.header().start_weapon);
+    SnapshotReader r(g_snapshot_scratch.data(), w.size());
+    return g_coordinator.load_state(r) ? static_cast<int>(ticks) : -1;
+}
+
+__attribute__((export_name("replay_run")))
+int replay_run(const uint8_t* log_ptr, int len) {
+    return replay_run_to(log_ptr, len, UINT32_MAX);
+}
+
+__attribute__((export_name("get_replay_checkpoint_count")))
+int get_replay_checkpoint_count() {
+    return static_cast<int>(g_replay_checkpoints.size());
+}
+
+__attribute__((export_name("get_replay_checkpoint_tick")))
+uint32_t get_replay_checkpoint_tick(int index) {
+    if (index < 0 || index >= static_cast<int>(g_replay_checkpoints.size())) return 0;
+    return g_replay_checkpoints[static_cast<size_t>(index)].tick;
+}
+
+__attribute__((export_name("get_replay_checkpoint_hash")))
+uint32_t get_replay_checkpoint_hash(int index) {
+    if (index < 0 || index >= static_cast<int>(g_replay_checkpoints.size())) return 0;
+    const uint64_t hash = g_replay_checkpoints[static_cast<size_t>(index)].hash;
+    if (hash == 0) return 0;
+    const uint32_t folded = FrameHasher::fold32(hash);
+    return folded != 0 ? folded : 1;
+}
+
+__attribute__((export_name("get_replay_ms")))
+float get_replay_ms() {
+    return g_replay_ms;
+}
+
 // ---- Enemy Physics Functions ----
 
 __attribute__((export_name("create_enemy_body")))
@@ -775,9 +1408,9 @@ float get_enemy_body_x(int enemy_index) {
     
     uint32_t body_id = game_state_mgr.get_enemy_body_id(enemy_index);
     if (body_id > 0) {
-        const RigidBody* body = physics_mgr.get_body(body_id);
-        if (body) {
-            return body->position.x.to_float();
+        BodySnapshot body;
+        if (physics_mgr.read_body(body_id, body)) {
+            return body.position.x.to_float();
         }
     }
     
@@ -791,9 +1424,9 @@ float get_enemy_body_y(int enemy_index) {
     
     uint32_t body_id = game_state_mgr.get_enemy_body_id(enemy_index);
     if (body_id > 0) {
-        const RigidBody* body = physics_mgr.get_body(body_id);
-        if (body) {
-            return body->position.y.to_float();
+        BodySnapshot body;
+        if (physics_mgr.read_body(body_id, body)) {
+            return body.position.y.to_float();
         }
     }
     
@@ -843,26 +1476,26 @@ void sync_player_position_from_physics() {
     auto& physics_mgr = g_coordinator.get_physics_manager();
     auto& player_mgr = g_coordinator.get_player_manager();
     
-    const RigidBody* player_body = physics_mgr.get_body(PhysicsConstants::kPlayerBodyId);
-    if (!player_body) {
+    BodySnapshot player_body;
+    if (!physics_mgr.read_body(PhysicsConstants::kPlayerBodyId, player_body)) {
         return;
     }
 
     const PhysicsConfig& config = physics_mgr.get_config();
     const float normalized_x = CoordinateSpace::physicsToNormalizedX(
         config,
-        player_body->position.x.to_float()
+        player_body.position.x.to_float()
     );
     const float normalized_y = CoordinateSpace::physicsToNormalizedY(
         config,
-        player_body->position.y.to_float()
+        player_body.position.y.to_float()
     );
     player_mgr.set_position(normalized_x, normalized_y);
 
     const float span_x = config.world_max_x.to_float() - config.world_min_x.to_float();
     const float span_y = config.world_max_y.to_float() - config.world_min_y.to_float();
-    const float velocity_x = (span_x > 0.0f) ? (player_body->velocity.x.to_float() / span_x) : 0.0f;
-    const float velocity_y = (span_y > 0.0f) ? (player_body->velocity.y.to_float() / span_y) : 0.0f;
+    const float velocity_x = (span_x > 0.0f) ? (player_body.velocity.x.to_float() / span_x) : 0.0f;
+    const float velocity_y = (span_y > 0.0f) ? (player_body.velocity.y.to_float() / span_y) : 0.0f;
     player_mgr.set_velocity(velocity_x, velocity_y);
 }
 
@@ -883,8 +1516,8 @@ void spawn_wolves(int count) {
     for (int i = 0; i < count; i++) {
         float angle = (float)i / (float)count * 6.28318f; // 2*PI
         float dist = 0.15f; // Distance from player
-        float x = player_x + dist * cosf(angle);
-        float y = player_y + dist * sinf(angle);
+        float x = player_x + dist * trig_cos(angle);
+        float y = player_y + dist * trig_sin(angle);
         
         // Clamp to world bounds
         x = (x < 0.0f) ? 0.0f : (x > 1.0f) ? 1.0f : x;
@@ -1028,6 +1661,42 @@ float get_wolf_leg_y(int index, int leg) {
     return g_coordinator.get_wolf_manager().get_wolf_leg_y(index, leg);
 }
 
+// ---- Wolf Render State (bulk) ----
+// Fixed-stride WolfRenderState records (layout in wolves/WolfRenderState.h).
+// Check get_wolf_render_state_version() before reading.
+
+__attribute__((export_name("get_wolf_render_state_version")))
+uint32_t get_wolf_render_state_version() {
+    return WOLF_RENDER_STATE_VERSION;
+}
+
+__attribute__((export_name("get_wolf_render_state_stride")))
+uint32_t get_wolf_render_state_stride() {
+    return WOLF_RENDER_STATE_STRIDE;
+}
+
+// Copies up to max_wolves records into a caller buffer; returns records written
+__attribute__((export_name("write_wolf_render_state")))
+int write_wolf_render_state(uintptr_t out_ptr, int max_wolves) {
+    if (out_ptr == 0 || max_wolves <= 0) {
+        return 0;
+    }
+    WolfRenderState* out = reinterpret_cast<WolfRenderState*>(out_ptr);
+    return g_coordinator.get_wolf_manager().write_render_state(out, max_wolves);
+}
+
+// Zero-copy path: records refreshed by every update(). The pointer changes
+// only when the wolf count grows; re-read it (and re-create views) each frame.
+__attribute__((export_name("get_wolf_render_state_ptr")))
+uintptr_t get_wolf_render_state_ptr() {
+    return reinterpret_cast<uintptr_t>(g_coordinator.get_wolf_manager().get_render_state_buffer());
+}
+
+__attribute__((export_name("get_wolf_render_state_count")))
+int get_wolf_render_state_count() {
+    return g_coordinator.get_wolf_manager().get_render_state_count();
+}
+
 __attribute__((export_name("get_enemy_vx")))
 float get_enemy_vx(int index) {
     const Wolf* wolf = g_coordinator.get_wolf_manager().get_wolf(index);
@@ -1105,26 +1774,147 @@ int get_wolf_attack_type(int wolf_index) {
     return wolf ? static_cast<int>(wolf->current_attack_type) : 0;
 }
 
-// ---- Phase 2A: Terrain System (stubbed) ----
+// ---- World Streaming ----
+// A chunked map paged in around the player (see managers/WorldManager.h).
+// Until world_configure the game is the single unit room and positions
+// stay in [0, 1]; with a map they span [0, get_world_width()] x
+// [0, get_world_height()].
+
+// Returns 1 when the map was accepted. seed 0 derives it from the run seed.
+__attribute__((export_name("world_configure")))
+int world_configure(int chunks_x, int chunks_y, float chunk_size, float load_radius, unsigned int seed) {
+    WorldMapConfig config;
+    config.chunks_x = chunks_x;
+    config.chunks_y = chunks_y;
+    config.chunk_size = chunk_size;
+    config.load_radius = load_radius;
+    config.seed = seed != 0 ? seed
+        : static_cast<uint32_t>(g_coordinator.get_game_state_manager().get_state().rng_seed);
+    return g_coordinator.configure_world(config) ? 1 : 0;
+}
+
+__attribute__((export_name("world_disable")))
+void world_disable() {
+    g_coordinator.disable_world();
+}
+
+// Chunk page-ins plus page-outs per update (at least 1)
+__attribute__((export_name("set_world_page_budget")))
+void set_world_page_budget(int budget) {
+    g_coordinator.get_world_manager().set_page_budget(budget);
+}
+
+__attribute__((export_name("get_world_enabled")))
+int get_world_enabled() {
+    return g_coordinator.get_world_manager().is_enabled() ? 1 : 0;
+}
+
+__attribute__((export_name("get_world_width")))
+float get_world_width() {
+    return g_coordinator.get_world_manager().get_width();
+}
+
+__attribute__((export_name("get_world_height")))
+float get_world_height() {
+    return g_coordinator.get_world_manager().get_height();
+}
+
+__attribute__((export_name("get_world_resident_chunk_count")))
+int get_world_resident_chunk_count() {
+    return g_coordinator.get_world_manager().get_resident_count();
+}
+
+// Chunk index (cy * chunks_x + cx) of a resident chunk; -1 out of range
+__attribute__((export_name("get_world_resident_chunk")))
+int get_world_resident_chunk(int index) {
+    return g_coordinator.get_world_manager().get_resident_chunk(index);
+}
+
+// Bit 0 resident, bit 1 visited, bit 2 pack has survivors; -1 off the map
+__attribute__((export_name("get_world_chunk_state")))
+int get_world_chunk_state(int cx, int cy) {
+    return g_coordinator.get_world_manager().get_chunk_state(cx, cy);
+}
+
+__attribute__((export_name("get_world_page_ins")))
+uint32_t get_world_page_ins() {
+    return g_coordinator.get_world_manager().get_page_ins();
+}
+
+__attribute__((export_name("get_world_page_outs")))
+uint32_t get_world_page_outs() {
+    return g_coordinator.get_world_manager().get_page_outs();
+}
+
+// Chunks in reach that the page budget or the resident cap deferred last update
+__attribute__((export_name("get_world_pending_chunks")))
+int get_world_pending_chunks() {
+    return g_coordinator.get_world_manager().get_pending_chunks();
+}
+
+__attribute__((export_name("get_static_collider_count")))
+int get_static_collider_count() {
+    return g_coordinator.get_physics_manager().get_static_collider_count();
+}
+
+// ---- Terrain Features ----
+// Features of the resident chunks; empty without a streamed world
+
+static const TerrainFeature* terrain_feature(int feature_index) {
+    const std::vector<TerrainFeature>& features = g_coordinator.get_world_manager().get_features();
+    if (feature_index < 0 || feature_index >= static_cast<int>(features.size())) {
+        return nullptr;
+    }
+    return &features[static_cast<size_t>(feature_index)];
+}
+
 __attribute__((export_name("get_terrain_feature_count")))
 int get_terrain_feature_count() {
-    // Terrain system not implemented yet; safe default
-    return 0;
+    return static_cast<int>(g_coordinator.get_world_manager().get_features().size());
 }
 
 __attribute__((export_name("get_terrain_feature_x")))
-float get_terrain_feature_x(int /*feature_index*/) {
-    return 0.0f;
+float get_terrain_feature_x(int feature_index) {
+    const TerrainFeature* f = terrain_feature(feature_index);
+    return f ? f->x : 0.0f;
 }
 
 __attribute__((export_name("get_terrain_feature_y")))
-float get_terrain_feature_y(int /*feature_index*/) {
-    return 0.0f;
+float get_terrain_feature_y(int feature_index) {
+    const TerrainFeature* f = terrain_feature(feature_index);
+    return f ? f->y : 0.0f;
 }
 
+// TerrainFeatureType: 0 rock, 1 wall, 2 brush
 __attribute__((export_name("get_terrain_feature_type")))
-int get_terrain_feature_type(int /*feature_index*/) {
-    return 0;
+int get_terrain_feature_type(int feature_index) {
+    const TerrainFeature* f = terrain_feature(feature_index);
+    return f ? static_cast<int>(f->type) : 0;
+}
+
+// Rock and brush radius; half the larger side for a wall
+__attribute__((export_name("get_terrain_feature_radius")))
+float get_terrain_feature_radius(int feature_index) {
+    const TerrainFeature* f = terrain_feature(feature_index);
+    return f ? std::max(f->half_w, f->half_h) : 0.0f;
+}
+
+// Zero-copy path: get_terrain_feature_count() TerrainFeature records at
+// get_terrain_feature_stride() bytes. The buffer moves when features change;
+// re-read the pointer when get_terrain_revision() changes.
+__attribute__((export_name("get_terrain_feature_ptr")))
+uintptr_t get_terrain_feature_ptr() {
+    return reinterpret_cast<uintptr_t>(g_coordinator.get_world_manager().get_features().data());
+}
+
+__attribute__((export_name("get_terrain_feature_stride")))
+uint32_t get_terrain_feature_stride() {
+    return static_cast<uint32_t>(sizeof(TerrainFeature));
+}
+
+__attribute__((export_name("get_terrain_revision")))
+uint32_t get_terrain_revision() {
+    return g_coordinator.get_world_manager().get_feature_revision();
 }
 
 // ---- Phase 2B: Advanced Wolf State ----
@@ -1164,6 +1954,17 @@ int get_pack_leader_index(int pack_index) {
     return pack ? pack->leader_index : -1;
 }
 
+// Pack recomputation counters: these grow with pack events, not with time
+__attribute__((export_name("get_pack_role_updates")))
+int get_pack_role_updates() {
+    return static_cast<int>(g_coordinator.get_wolf_manager().get_pack_role_updates());
+}
+
+__attribute__((export_name("get_pack_plan_evaluations")))
+int get_pack_plan_evaluations() {
+    return static_cast<int>(g_coordinator.get_wolf_manager().get_pack_plan_evaluations());
+}
+
 // ---- Phase 3: Performance Metrics ----
 __attribute__((export_name("get_wolf_attack_success_rate")))
 float get_wolf_attack_success_rate() {
@@ -1210,6 +2011,42 @@ int get_wolf_last_message_type(int /*wolf_index*/) {
     return 0;
 }
 
+// ---- Wolf AI Level of Detail ----
+
+__attribute__((export_name("set_wolf_ai_lod_enabled")))
+void set_wolf_ai_lod_enabled(int enabled) {
+    g_coordinator.get_wolf_manager().set_ai_lod_enabled(enabled != 0);
+}
+
+__attribute__((export_name("set_wolf_ai_budget")))
+void set_wolf_ai_budget(int full_updates_per_tick) {
+    g_coordinator.get_wolf_manager().set_ai_budget(full_updates_per_tick);
+}
+
+// tier: 0 = near (every tick), 1 = mid, 2 = far
+__attribute__((export_name("get_wolf_ai_tier_count")))
+int get_wolf_ai_tier_count(int tier) {
+    return g_coordinator.get_wolf_manager().get_ai_tier_count(tier);
+}
+
+__attribute__((export_name("get_wolf_ai_tier")))
+int get_wolf_ai_tier(int wolf_index) {
+    const Wolf* w = g_coordinator.get_wolf_manager().get_wolf(wolf_index);
+    return w ? static_cast<int>(w->ai_tier) : 0;
+}
+
+#if DOZEDENT_DEBUG_EXPORTS
+__attribute__((export_name("get_wolf_ai_full_updates")))
+int get_wolf_ai_full_updates() {
+    return g_coordinator.get_wolf_manager().get_ai_full_updates();
+}
+
+__attribute__((export_name("get_wolf_ai_update_ms")))
+float get_wolf_ai_update_ms() {
+    return g_coordinator.get_wolf_manager().get_ai_update_ms();
+}
+#endif
+
 // ---- Skeleton Snapshot Exports (v1 getters) ----
 
 __attribute__((export_name("get_skeleton_joint_count")))
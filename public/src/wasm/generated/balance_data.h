@@ -1,89 +1,187 @@
 // AUTO-GENERATED FILE. DO NOT EDIT.
-// Generated by scripts/generate-balance.cjs from data/balance/*.json
+// Generated by tools/scripts/generate-balance.cjs from data/balance/*.json
 
 #pragma once
 
-#define BAL_BASE_SPEED 0.6
-#define BAL_ROLL_SPEED_MULTIPLIER 2.6
-#define BAL_PLAYER_ACCEL 12
-#define BAL_PLAYER_FRICTION 9
-#define BAL_JUMP_POWER -0.45
-#define BAL_GRAVITY 1.2
-#define BAL_MAX_JUMPS 2
-#define BAL_PLAYER_RADIUS 0.012
-#define BAL_STAMINA_REGEN_PER_SEC 0.35
-#define BAL_STAMINA_BLOCK_DRAIN_PER_SEC 0.25
-#define BAL_STAMINA_ROLL_DRAIN_PER_SEC 0.3
-#define BAL_STAMINA_ROLL_START_COST 0.15
-#define BAL_STAMINA_BLOCK_START_COST 0.05
-#define BAL_STAMINA_ATTACK_COST 0.1
-#define BAL_INPUT_BUFFER_TIME 0.12
-#define BAL_PARRY_WINDOW 0.12
-#define BAL_PARRY_STUN_DURATION 0.3
-#define BAL_ROLL_IFRAME_DURATION 0.3
-#define BAL_ATTACK_COOLDOWN_SEC 0.25
-#define BAL_ROLL_DURATION_SEC 0.4
-#define BAL_ROLL_COOLDOWN_SEC 0.5
-#define BAL_ATTACK_RANGE 0.055
-#define BAL_BACK_ATTACK_COS_THRESHOLD -0.3
-#define BAL_BLOCK_FACING_COS_THRESHOLD 0.5
-#define BAL_ATTACK_ARC_COS_THRESHOLD 0.7
-#define BAL_ATTACK_DAMAGE 20
-#define BAL_ATTACK_STUN_SEC 0.15
-#define BAL_ATTACK_KNOCKBACK 0.02
-#define BAL_LIGHT_WINDUP_SEC 0.05
-#define BAL_LIGHT_ACTIVE_SEC 0.08
-#define BAL_LIGHT_RECOVERY_SEC 0.12
-#define BAL_LIGHT_DAMAGE 15
-#define BAL_HEAVY_WINDUP_SEC 0.15
-#define BAL_HEAVY_ACTIVE_SEC 0.12
-#define BAL_HEAVY_RECOVERY_SEC 0.25
-#define BAL_HEAVY_DAMAGE 35
-#define BAL_SPECIAL_WINDUP_SEC 0.1
-#define BAL_SPECIAL_ACTIVE_SEC 0.15
-#define BAL_SPECIAL_RECOVERY_SEC 0.2
-#define BAL_SPECIAL_DAMAGE 25
-#define BAL_ROLL_SLIDE_DURATION 0.2
-#define BAL_ROLL_SLIDE_FRICTION 5
-#define BAL_WALL_CENTER_X 0.5
-#define BAL_WALL_HALF_WIDTH 0.45
-#define BAL_ENEMY_BASE_SPEED 0.18
-#define BAL_ENEMY_CIRCLE_RADIUS 0.08
-#define BAL_ENEMY_SEEK_RANGE 0.45
-#define BAL_ENEMY_HARASS_RANGE 0.11
-#define BAL_ENEMY_ACCEL 1.1
-#define BAL_ENEMY_FRICTION 2
-#define BAL_ENEMY_MAX_SPEED 0.26
-#define BAL_ENEMY_LUNGE_RANGE 0.125
-#define BAL_ENEMY_LUNGE_SPEED 0.42
-#define BAL_ENEMY_LUNGE_DURATION 0.16
-#define BAL_ENEMY_LUNGE_COOLDOWN 1.5
-#define BAL_ENEMY_FEINT_PROB 0.3
-#define BAL_ENEMY_FEINT_DURATION 0.25
-#define BAL_ENEMY_MIN_CHASE_BEFORE_LUNGE 0.8
-#define BAL_LATCH_DURATION 1.2
-#define BAL_LATCH_DRAG_SPEED 0.05
-#define BAL_PREY_CONE_COS 0.7
-#define BAL_PREY_CONE_WEIGHT 1.5
-#define BAL_FATIGUE_LUNGE_BONUS 0.15
-#define BAL_FATIGUE_PER_SPEED 0.08
-#define BAL_FATIGUE_RECOVERY_PER_SEC 0.2
-#define BAL_COMM_RANGE 0.3
-#define BAL_ENEMY_RADIUS 0.015
-#define BAL_MAX_WOLF_PACKS 3
-#define BAL_PACK_RESPAWN_DELAY 5
-#define BAL_MIN_SPAWN_DISTANCE 0.2
-#define BAL_MAX_SPAWN_DISTANCE 0.4
-#define BAL_HOWL_MAX_SPAWN_DISTANCE 0.6
-#define BAL_SPAWN_SPREAD 0.1
-#define BAL_SPAWN_MARGIN 0.05
-#define BAL_WOLF_ATTACK_ENTER_MULT 1
-#define BAL_WOLF_ATTACK_EXIT_MULT 1.15
-#define BAL_WOLF_APPROACH_ENTER_MULT 0.7
-#define BAL_WOLF_APPROACH_EXIT_MULT 0.85
-#define BAL_WOLF_ATTACK_FACING_COS 0.5
-#define BAL_WOLF_MAX_CONCURRENT_ATTACKERS 2
-#define BAL_WOLF_DAMAGE_INTERRUPT_THRESHOLD 6
-#define BAL_WOLF_CONFIDENT_RECOVER_MULT 0.8
-#define BAL_WOLF_FEARFUL_STRAFE_MULT 1.3
-#define BAL_WOLF_DESPERATE_ATTACK_MULT 0.9
+#include <cstdint>
+
+// Keys into the runtime balance table; read with bal(BAL_*) (see BalanceTable.h)
+enum BalanceKey : uint16_t {
+    BAL_BASE_SPEED,
+    BAL_ROLL_SPEED_MULTIPLIER,
+    BAL_PLAYER_ACCEL,
+    BAL_PLAYER_FRICTION,
+    BAL_JUMP_POWER,
+    BAL_GRAVITY,
+    BAL_MAX_JUMPS,
+    BAL_PLAYER_RADIUS,
+    BAL_STAMINA_REGEN_PER_SEC,
+    BAL_STAMINA_BLOCK_DRAIN_PER_SEC,
+    BAL_STAMINA_ROLL_DRAIN_PER_SEC,
+    BAL_STAMINA_ROLL_START_COST,
+    BAL_STAMINA_BLOCK_START_COST,
+    BAL_STAMINA_ATTACK_COST,
+    BAL_INPUT_BUFFER_TIME,
+    BAL_PARRY_WINDOW,
+    BAL_PARRY_STUN_DURATION,
+    BAL_ROLL_IFRAME_DURATION,
+    BAL_ATTACK_COOLDOWN_SEC,
+    BAL_ROLL_DURATION_SEC,
+    BAL_ROLL_COOLDOWN_SEC,
+    BAL_ATTACK_RANGE,
+    BAL_BACK_ATTACK_COS_THRESHOLD,
+    BAL_BLOCK_FACING_COS_THRESHOLD,
+    BAL_ATTACK_ARC_COS_THRESHOLD,
+    BAL_ATTACK_DAMAGE,
+    BAL_ATTACK_STUN_SEC,
+    BAL_ATTACK_KNOCKBACK,
+    BAL_LIGHT_WINDUP_SEC,
+    BAL_LIGHT_ACTIVE_SEC,
+    BAL_LIGHT_RECOVERY_SEC,
+    BAL_LIGHT_DAMAGE,
+    BAL_HEAVY_WINDUP_SEC,
+    BAL_HEAVY_ACTIVE_SEC,
+    BAL_HEAVY_RECOVERY_SEC,
+    BAL_HEAVY_DAMAGE,
+    BAL_SPECIAL_WINDUP_SEC,
+    BAL_SPECIAL_ACTIVE_SEC,
+    BAL_SPECIAL_RECOVERY_SEC,
+    BAL_SPECIAL_DAMAGE,
+    BAL_ROLL_SLIDE_DURATION,
+    BAL_ROLL_SLIDE_FRICTION,
+    BAL_WALL_CENTER_X,
+    BAL_WALL_HALF_WIDTH,
+    BAL_ENEMY_BASE_SPEED,
+    BAL_ENEMY_CIRCLE_RADIUS,
+    BAL_ENEMY_SEEK_RANGE,
+    BAL_ENEMY_HARASS_RANGE,
+    BAL_ENEMY_ACCEL,
+    BAL_ENEMY_FRICTION,
+    BAL_ENEMY_MAX_SPEED,
+    BAL_ENEMY_LUNGE_RANGE,
+    BAL_ENEMY_LUNGE_SPEED,
+    BAL_ENEMY_LUNGE_DURATION,
+    BAL_ENEMY_LUNGE_COOLDOWN,
+    BAL_ENEMY_FEINT_PROB,
+    BAL_ENEMY_FEINT_DURATION,
+    BAL_ENEMY_MIN_CHASE_BEFORE_LUNGE,
+    BAL_LATCH_DURATION,
+    BAL_LATCH_DRAG_SPEED,
+    BAL_PREY_CONE_COS,
+    BAL_PREY_CONE_WEIGHT,
+    BAL_FATIGUE_LUNGE_BONUS,
+    BAL_FATIGUE_PER_SPEED,
+    BAL_FATIGUE_RECOVERY_PER_SEC,
+    BAL_COMM_RANGE,
+    BAL_ENEMY_RADIUS,
+    BAL_MAX_WOLF_PACKS,
+    BAL_PACK_RESPAWN_DELAY,
+    BAL_MIN_SPAWN_DISTANCE,
+    BAL_MAX_SPAWN_DISTANCE,
+    BAL_HOWL_MAX_SPAWN_DISTANCE,
+    BAL_SPAWN_SPREAD,
+    BAL_SPAWN_MARGIN,
+    BAL_WOLF_ATTACK_ENTER_MULT,
+    BAL_WOLF_ATTACK_EXIT_MULT,
+    BAL_WOLF_APPROACH_ENTER_MULT,
+    BAL_WOLF_APPROACH_EXIT_MULT,
+    BAL_WOLF_ATTACK_FACING_COS,
+    BAL_WOLF_MAX_CONCURRENT_ATTACKERS,
+    BAL_WOLF_DAMAGE_INTERRUPT_THRESHOLD,
+    BAL_WOLF_CONFIDENT_RECOVER_MULT,
+    BAL_WOLF_FEARFUL_STRAFE_MULT,
+    BAL_WOLF_DESPERATE_ATTACK_MULT,
+    BAL_KEY_COUNT
+};
+
+// Blobs are accepted only when their key layout matches this build
+constexpr uint32_t BALANCE_LAYOUT_HASH = 0x7CDD7CA5u;
+constexpr uint32_t BALANCE_DEFAULT_REVISION = 0x51E0A5FBu;
+
+// Compiled-in defaults, identical to public/data/balance/balance.bin
+constexpr float BALANCE_DEFAULTS[BAL_KEY_COUNT] = {
+    0.6f, // BAL_BASE_SPEED
+    2.6f, // BAL_ROLL_SPEED_MULTIPLIER
+    12.0f, // BAL_PLAYER_ACCEL
+    9.0f, // BAL_PLAYER_FRICTION
+    -0.45f, // BAL_JUMP_POWER
+    1.2f, // BAL_GRAVITY
+    2.0f, // BAL_MAX_JUMPS
+    0.012f, // BAL_PLAYER_RADIUS
+    0.35f, // BAL_STAMINA_REGEN_PER_SEC
+    0.25f, // BAL_STAMINA_BLOCK_DRAIN_PER_SEC
+    0.3f, // BAL_STAMINA_ROLL_DRAIN_PER_SEC
+    0.15f, // BAL_STAMINA_ROLL_START_COST
+    0.05f, // BAL_STAMINA_BLOCK_START_COST
+    0.1f, // BAL_STAMINA_ATTACK_COST
+    0.12f, // BAL_INPUT_BUFFER_TIME
+    0.12f, // BAL_PARRY_WINDOW
+    0.3f, // BAL_PARRY_STUN_DURATION
+    0.3f, // BAL_ROLL_IFRAME_DURATION
+    0.25f, // BAL_ATTACK_COOLDOWN_SEC
+    0.4f, // BAL_ROLL_DURATION_SEC
+    0.5f, // BAL_ROLL_COOLDOWN_SEC
+    0.055f, // BAL_ATTACK_RANGE
+    -0.3f, // BAL_BACK_ATTACK_COS_THRESHOLD
+    0.5f, // BAL_BLOCK_FACING_COS_THRESHOLD
+    0.7f, // BAL_ATTACK_ARC_COS_THRESHOLD
+    20.0f, // BAL_ATTACK_DAMAGE
+    0.15f, // BAL_ATTACK_STUN_SEC
+    0.02f, // BAL_ATTACK_KNOCKBACK
+    0.05f, // BAL_LIGHT_WINDUP_SEC
+    0.08f, // BAL_LIGHT_ACTIVE_SEC
+    0.12f, // BAL_LIGHT_RECOVERY_SEC
+    15.0f, // BAL_LIGHT_DAMAGE
+    0.15f, // BAL_HEAVY_WINDUP_SEC
+    0.12f, // BAL_HEAVY_ACTIVE_SEC
+    0.25f, // BAL_HEAVY_RECOVERY_SEC
+    35.0f, // BAL_HEAVY_DAMAGE
+    0.1f, // BAL_SPECIAL_WINDUP_SEC
+    0.15f, // BAL_SPECIAL_ACTIVE_SEC
+    0.2f, // BAL_SPECIAL_RECOVERY_SEC
+    25.0f, // BAL_SPECIAL_DAMAGE
+    0.2f, // BAL_ROLL_SLIDE_DURATION
+    5.0f, // BAL_ROLL_SLIDE_FRICTION
+    0.5f, // BAL_WALL_CENTER_X
+    0.45f, // BAL_WALL_HALF_WIDTH
+    0.18f, // BAL_ENEMY_BASE_SPEED
+    0.08f, // BAL_ENEMY_CIRCLE_RADIUS
+    0.45f, // BAL_ENEMY_SEEK_RANGE
+    0.11f, // BAL_ENEMY_HARASS_RANGE
+    1.1f, // BAL_ENEMY_ACCEL
+    2.0f, // BAL_ENEMY_FRICTION
+    0.26f, // BAL_ENEMY_MAX_SPEED
+    0.125f, // BAL_ENEMY_LUNGE_RANGE
+    0.42f, // BAL_ENEMY_LUNGE_SPEED
+    0.16f, // BAL_ENEMY_LUNGE_DURATION
+    1.5f, // BAL_ENEMY_LUNGE_COOLDOWN
+    0.3f, // BAL_ENEMY_FEINT_PROB
+    0.25f, // BAL_ENEMY_FEINT_DURATION
+    0.8f, // BAL_ENEMY_MIN_CHASE_BEFORE_LUNGE
+    1.2f, // BAL_LATCH_DURATION
+    0.05f, // BAL_LATCH_DRAG_SPEED
+    0.7f, // BAL_PREY_CONE_COS
+    1.5f, // BAL_PREY_CONE_WEIGHT
+    0.15f, // BAL_FATIGUE_LUNGE_BONUS
+    0.08f, // BAL_FATIGUE_PER_SPEED
+    0.2f, // BAL_FATIGUE_RECOVERY_PER_SEC
+    0.3f, // BAL_COMM_RANGE
+    0.015f, // BAL_ENEMY_RADIUS
+    3.0f, // BAL_MAX_WOLF_PACKS
+    5.0f, // BAL_PACK_RESPAWN_DELAY
+    0.2f, // BAL_MIN_SPAWN_DISTANCE
+    0.4f, // BAL_MAX_SPAWN_DISTANCE
+    0.6f, // BAL_HOWL_MAX_SPAWN_DISTANCE
+    0.1f, // BAL_SPAWN_SPREAD
+    0.05f, // BAL_SPAWN_MARGIN
+    1.0f, // BAL_WOLF_ATTACK_ENTER_MULT
+    1.15f, // BAL_WOLF_ATTACK_EXIT_MULT
+    0.7f, // BAL_WOLF_APPROACH_ENTER_MULT
+    0.85f, // BAL_WOLF_APPROACH_EXIT_MULT
+    0.5f, // BAL_WOLF_ATTACK_FACING_COS
+    2.0f, // BAL_WOLF_MAX_CONCURRENT_ATTACKERS
+    6.0f, // BAL_WOLF_DAMAGE_INTERRUPT_THRESHOLD
+    0.8f, // BAL_WOLF_CONFIDENT_RECOVER_MULT
+    1.3f, // BAL_WOLF_FEARFUL_STRAFE_MULT
+    0.9f, // BAL_WOLF_DESPERATE_ATTACK_MULT
+};
@@ -98,10 +98,10 @@ void ArmManager::update(float dt) {
 
     // Soft separation between left and right hands to avoid self-intersection
     if (left_.hand && right_.hand) {
-        RigidBody* lh = physics_->get_body(left_.hand);
-        RigidBody* rh = physics_->get_body(right_.hand);
-        if (lh && rh) {
-            FixedVector3 d = rh->position - lh->position;
+        BodySnapshot lh;
+        BodySnapshot rh;
+        if (physics_->read_body(left_.hand, lh) && physics_->read_body(right_.hand, rh)) {
+            FixedVector3 d = rh.position - lh.position;
             Fixed distSq = d.length_squared();
             Fixed minD = Fixed::from_float(arm_separation_min_);
             Fixed minDSq = minD * minD;
@@ -110,9 +110,9 @@ void ArmManager::update(float dt) {
                 FixedVector3 n = d / dist;
                 Fixed push = (minD - dist) * Fixed::from_float(0.5f);
                 // Apply small positional push (PBD-style)
-                if (lh->type == BodyType::Dynamic) lh->position -= n * push;
-                if (rh->type == BodyType::Dynamic) rh->position += n * push;
-                lh->wake(); rh->wake();
+                if (lh.type == BodyType::Dynamic) physics_->set_position(left_.hand, lh.position - n * push);
+                if (rh.type == BodyType::Dynamic) physics_->set_position(right_.hand, rh.position + n * push);
+                physics_->wake_body(left_.hand); physics_->wake_body(right_.hand);
             }
         }
     }
@@ -123,21 +123,17 @@ void ArmManager::update_anchor_positions() {
     const float py = player_->get_y();
     const float shoulder_offset_y = 0.05f;
 
-    if (auto* a = physics_->get_body(left_.anchor)) {
-        a->position = FixedVector3::from_floats(px - 0.03f, py + shoulder_offset_y, 0.0f);
-    }
-    if (auto* a = physics_->get_body(right_.anchor)) {
-        a->position = FixedVector3::from_floats(px + 0.03f, py + shoulder_offset_y, 0.0f);
-    }
+    physics_->set_position(left_.anchor, FixedVector3::from_floats(px - 0.03f, py + shoulder_offset_y, 0.0f));
+    physics_->set_position(right_.anchor, FixedVector3::from_floats(px + 0.03f, py + shoulder_offset_y, 0.0f));
 }
 
 void ArmManager::apply_servo_to_hand(uint32_t hand_id, float tx, float ty, float tz, float dt) {
-    RigidBody* hand = physics_->get_body(hand_id);
-    if (!hand) return;
+    BodySnapshot hand;
+    if (!physics_->read_body(hand_id, hand)) return;
     // PD target in normalized world 0..1; z unused
     FixedVector3 target = FixedVector3::from_floats(tx, ty, 0.0f);
-    FixedVector3 pos = hand->position;
-    FixedVector3 vel = hand->velocity;
+    FixedVector3 pos = hand.position;
+    FixedVector3 vel = hand.velocity;
     FixedVector3 error = target - pos;
     // Convert kp,kd to Fixed and compute force, clamp to avoid instability
     Fixed kpf = Fixed::from_float(kp_);
@@ -164,12 +160,25 @@ void ArmManager::set_right_target(float x, float y, float z) {
     right_tx_ = x; right_ty_ = y; right_tz_ = z;
 }
 
+void ArmManager::save_state(SnapshotWriter& w) const {
+    w.write(left_);
+    w.write(right_);
+    w.write(left_tx_); w.write(left_ty_); w.write(left_tz_);
+    w.write(right_tx_); w.write(right_ty_); w.write(right_tz_);
+}
+
+bool ArmManager::load_state(SnapshotReader& r) {
+    return r.read(left_) && r.read(right_) &&
+        r.read(left_tx_) && r.read(left_ty_) && r.read(left_tz_) &&
+        r.read(right_tx_) && r.read(right_ty_) && r.read(right_tz_);
+}
+
 void ArmManager::read_body_pos(uint32_t id, float& x, float& y, float& z) const {
-    const RigidBody* b = physics_->get_body(id);
-    if (!b) { x = y = z = 0.0f; return; }
-    x = b->position.x.to_float();
-    y = b->position.y.to_float();
-    z = b->position.z.to_float();
+    BodySnapshot b;
+    if (!physics_->read_body(id, b)) { x = y = z = 0.0f; return; }
+    x = b.position.x.to_float();
+    y = b.position.y.to_float();
+    z = b.position.z.to_float();
 }
 
 void ArmManager::get_left_shoulder(float& x, float& y, float& z) const { read_body_pos(left_.anchor, x, y, z); }
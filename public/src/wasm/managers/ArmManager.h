@@ -2,6 +2,7 @@
 #include "../physics/PhysicsTypes.h"
 #include "../physics/CollisionLayers.h"
 #include <cstdint>
+#include "../physics/SnapshotStream.h"
 
 /**
  * ArmManager - creates and updates articulated player arms using physics bodies and constraints.
@@ -29,6 +30,10 @@ public:
     void set_left_target(float x, float y, float z);
     void set_right_target(float x, float y, float z);
 
+    // Rollback snapshots (arm bodies and constraints live in PhysicsManager)
+    void save_state(SnapshotWriter& w) const;
+    bool load_state(SnapshotReader& r);
+
     // Getters for joint positions (float, normalized world)
     void get_left_shoulder(float& x, float& y, float& z) const;
     void get_left_elbow(float& x, float& y, float& z) const;
@@ -353,6 +353,46 @@ void CombatManager::apply_attack_lunge(float facing_x, float facing_y, bool is_h
     physics_manager_->apply_impulse(0, impulse);
 }
 
+void CombatManager::add_hitbox(HitSource source, const QueryShape& shape) {
+    const int s = static_cast<int>(source);
+    if (s < 0 || s >= HIT_SOURCE_COUNT) {
+        return;
+    }
+    hitboxes_[s] = shape;
+    hitbox_mask_ |= 1u << s;
+}
+
+const std::vector<CombatManager::Hit>& CombatManager::resolve_hits(uint32_t layer_mask) {
+    frame_hits_.clear();
+    
+    for (int s = 0; s < HIT_SOURCE_COUNT; ++s) {
+        if ((hitbox_mask_ & (1u << s)) == 0u) {
+            state_.struck_count[s] = 0;  // Closed: the next opening starts fresh
+            continue;
+        }
+        if (!physics_manager_) {
+            continue;
+        }
+        
+        physics_manager_->query_overlap(hitboxes_[s], layer_mask, query_ids_);
+        uint32_t* struck = state_.struck_ids[s];
+        uint8_t& count = state_.struck_count[s];
+        for (uint32_t id : query_ids_) {
+            if (std::find(struck, struck + count, id) != struck + count) {
+                continue;
+            }
+            if (count >= MAX_STRUCK_PER_HITBOX) {
+                break;
+            }
+            struck[count++] = id;
+            frame_hits_.push_back(Hit{ id, static_cast<HitSource>(s) });
+        }
+    }
+    
+    hitbox_mask_ = 0;
+    return frame_hits_;
+}
+
 void CombatManager::apply_enemy_knockback(uint32_t enemy_body_id, float dir_x, float dir_y, float force) {
     if (!physics_manager_) {
         return;
@@ -1,5 +1,8 @@
 #pragma once
 #include <cstdint>
+#include <vector>
+#include "../physics/SnapshotStream.h"
+#include "../physics/OverlapQuery.h"
 
 // Forward declaration
 class PhysicsManager;
@@ -30,6 +33,21 @@ public:
         PerfectParry = 2
     };
 
+    // Player hitboxes; each source opens at most one hitbox per frame
+    enum class HitSource : uint8_t {
+        Attack = 0,     // Melee arc while the attack is Active
+        Bash = 1,
+        Charge = 2,
+        Dash = 3
+    };
+    static constexpr int HIT_SOURCE_COUNT = 4;
+    static constexpr int MAX_STRUCK_PER_HITBOX = 16;
+
+    struct Hit {
+        uint32_t body_id;
+        HitSource source;
+    };
+
     struct CombatState {
         // Attack state
         AttackState attack_state = AttackState::Idle;
@@ -60,6 +78,10 @@ public:
         // Timing
         float last_attack_time = -1000.0f;
         float last_roll_time = -1000.0f;
+        
+        // Hit memory: bodies each hitbox has struck since it opened
+        uint32_t struck_ids[HIT_SOURCE_COUNT][MAX_STRUCK_PER_HITBOX] = {};
+        uint8_t struck_count[HIT_SOURCE_COUNT] = {};
     };
 
     CombatManager();
@@ -108,6 +130,19 @@ public:
     float get_combo_window_remaining() const { return state_.combo_window_remaining; }
     float get_counter_window_remaining() const { return state_.counter_window_remaining; }
     
+    // Batched hit resolution: queue the frame's open hitboxes, then resolve
+    // them all with one overlap query each against the physics grid. A body
+    // is struck at most once per opening (up to MAX_STRUCK_PER_HITBOX); a
+    // source with no hitbox this frame forgets what it struck.
+    void begin_hit_frame() { hitbox_mask_ = 0; }
+    void add_hitbox(HitSource source, const QueryShape& shape);
+    const std::vector<Hit>& resolve_hits(uint32_t layer_mask);
+    const std::vector<Hit>& get_frame_hits() const { return frame_hits_; }
+    
+    // Rollback snapshots
+    void save_state(SnapshotWriter& w) const { w.write(state_); }
+    bool load_state(SnapshotReader& r) { frame_hits_.clear(); return r.read(state_); }
+    
     // Physics integration
     void set_physics_manager(PhysicsManager* pm) { physics_manager_ = pm; }
     void apply_knockback_impulse(float dir_x, float dir_y, float force);
@@ -126,6 +161,12 @@ private:
     class PlayerManager* player_manager_ = nullptr;
     class GameStateManager* game_state_manager_ = nullptr;
     
+    // This frame's hitboxes and hits (scratch, reused across frames)
+    QueryShape hitboxes_[HIT_SOURCE_COUNT];
+    uint32_t hitbox_mask_ = 0;
+    std::vector<Hit> frame_hits_;
+    std::vector<uint32_t> query_ids_;
+    
     // Combat constants
     static constexpr float ATTACK_WINDUP_SEC = 0.3f;
     static constexpr float ATTACK_ACTIVE_SEC = 0.2f;
@@ -6,6 +6,7 @@
 GameStateManager::GameStateManager() {
     // Initialize with default state
     state_ = {};
+    set_room_capacity(RoomCapacity{});
 }
 
 void GameStateManager::initialize(unsigned long long seed, unsigned int start_weapon) {
@@ -132,6 +133,14 @@ void GameStateManager::complete_room() {
     advance_room();
 }
 
+void GameStateManager::set_room_capacity(const RoomCapacity& capacity) {
+    room_capacity_.wolves = std::max(0, capacity.wolves);
+    room_capacity_.packs = std::max(0, capacity.packs);
+    room_capacity_.barrels = std::max(0, capacity.barrels);
+    const int entities = room_capacity_.wolves + room_capacity_.barrels + 1;
+    room_capacity_.bodies = capacity.bodies > 0 ? std::max(capacity.bodies, entities) : entities;
+}
+
 unsigned int GameStateManager::get_random_u32() {
     advance_rng();
     return static_cast<unsigned int>(state_.rng_state);
@@ -251,75 +260,57 @@ void GameStateManager::advance_rng() {
 // ============================================================================
 
 uint32_t GameStateManager::get_enemy_body_id(int enemy_index) const {
-    if (enemy_index < 0 || enemy_index >= GameState::MAX_ENEMIES) {
+    if (enemy_index < 0 || enemy_index >= static_cast<int>(enemy_body_by_index_.size())) {
         return 0;
     }
     
-    for (int i = 0; i < state_.enemy_count; ++i) {
-        if (state_.enemy_bodies[i].active && state_.enemy_bodies[i].enemy_index == enemy_index) {
-            return state_.enemy_bodies[i].physics_body_id;
-        }
-    }
-    
-    return 0;  // Not found
+    const uint32_t body_id = enemy_body_by_index_[enemy_index];
+    return body_id == INVALID_ENTITY ? 0 : body_id;  // 0 = not found (the player's body)
 }
 
 int GameStateManager::get_enemy_index_for_body(uint32_t body_id) const {
-    for (int i = 0; i < state_.enemy_count; ++i) {
-        if (state_.enemy_bodies[i].active && state_.enemy_bodies[i].physics_body_id == body_id) {
-            return state_.enemy_bodies[i].enemy_index;
-        }
-    }
-    
-    return -1;  // Not found
+    const EnemyBodyMapping* mapping = enemy_bodies_.find(body_id);
+    return mapping ? mapping->enemy_index : -1;  // -1 = not found
 }
 
 uint32_t GameStateManager::register_enemy_body(int enemy_index, uint32_t physics_body_id) {
-    if (enemy_index < 0 || enemy_index >= GameState::MAX_ENEMIES) {
+    if (enemy_index < 0 || physics_body_id == INVALID_ENTITY) {
         return 0;
     }
     
-    // Check if already registered
-    for (int i = 0; i < state_.enemy_count; ++i) {
-        if (state_.enemy_bodies[i].enemy_index == enemy_index) {
-            // Update existing registration
-            state_.enemy_bodies[i].physics_body_id = physics_body_id;
-            state_.enemy_bodies[i].active = true;
-            return physics_body_id;
-        }
+    if (enemy_index >= static_cast<int>(enemy_body_by_index_.size())) {
+        enemy_body_by_index_.resize(static_cast<size_t>(enemy_index) + 1, INVALID_ENTITY);
     }
     
-    // Add new registration
-    if (state_.enemy_count < GameState::MAX_ENEMIES) {
-        state_.enemy_bodies[state_.enemy_count].physics_body_id = physics_body_id;
-        state_.enemy_bodies[state_.enemy_count].enemy_index = enemy_index;
-        state_.enemy_bodies[state_.enemy_count].active = true;
-        state_.enemy_count++;
-        return physics_body_id;
+    // Re-registering an index replaces its previous body
+    const uint32_t previous = enemy_body_by_index_[enemy_index];
+    if (previous != INVALID_ENTITY && previous != physics_body_id) {
+        enemy_bodies_.remove(previous);
     }
-    
-    return 0;  // Out of slots
+    // ...and a body registered under another index moves to this one
+    if (const EnemyBodyMapping* existing = enemy_bodies_.find(physics_body_id)) {
+        enemy_body_by_index_[existing->enemy_index] = INVALID_ENTITY;
+    }
+
+    enemy_bodies_.insert(physics_body_id, EnemyBodyMapping{ physics_body_id, enemy_index });
+    enemy_body_by_index_[enemy_index] = physics_body_id;
+    return physics_body_id;
 }
 
 void GameStateManager::unregister_enemy_body(int enemy_index) {
-    for (int i = 0; i < state_.enemy_count; ++i) {
-        if (state_.enemy_bodies[i].enemy_index == enemy_index) {
-            state_.enemy_bodies[i].active = false;
-            
-            // Compact array by moving last element to this slot
-            if (i < state_.enemy_count - 1) {
-                state_.enemy_bodies[i] = state_.enemy_bodies[state_.enemy_count - 1];
-            }
-            state_.enemy_count--;
-            return;
-        }
+    if (enemy_index < 0 || enemy_index >= static_cast<int>(enemy_body_by_index_.size())) {
+        return;
+    }
+    
+    uint32_t& body_id = enemy_body_by_index_[enemy_index];
+    if (body_id != INVALID_ENTITY) {
+        enemy_bodies_.remove(body_id);  // Swap-remove; the moved mapping's index entry is patched
+        body_id = INVALID_ENTITY;
     }
 }
 
 void GameStateManager::clear_all_enemy_bodies() {
-    state_.enemy_count = 0;
-    for (int i = 0; i < GameState::MAX_ENEMIES; ++i) {
-        state_.enemy_bodies[i].active = false;
-    }
+    enemy_bodies_.clear();
+    enemy_body_by_index_.clear();
 }
 
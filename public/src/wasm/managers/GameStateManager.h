@@ -1,5 +1,9 @@
 #pragma once
 #include <cstdint>
+#include <vector>
+#include "../physics/SnapshotStream.h"
+#include "../physics/EntityRegistry.h"
+#include "../physics/FrameHash.h"
 
 /**
  * GameStateManager - Manages overall game state, phases, and core game loop coordination
@@ -28,8 +32,7 @@ public:
 
     struct EnemyBodyMapping {
         uint32_t physics_body_id;
-        int enemy_index;  // Index in enemy array
-        bool active;
+        int enemy_index;  // Index in the JS enemy array
     };
 
     struct GameState {
@@ -54,16 +57,22 @@ public:
         int gold = 0;
         int essence = 0;
         
-        // Enemy physics tracking
-        int enemy_count = 0;
-        static constexpr int MAX_ENEMIES = 32;
-        EnemyBodyMapping enemy_bodies[MAX_ENEMIES];
-        
         // Flags
         bool is_initialized = false;
         bool is_paused = false;
     };
 
+    // Entity counts a room is expected to reach. The coordinator reserves
+    // wolf, pack and physics body storage from it at initialize, so spawn
+    // waves and room transitions up to these sizes do not reallocate. Not
+    // simulation state: it survives reset and is not snapshotted.
+    struct RoomCapacity {
+        int wolves = 24;
+        int packs = 4;
+        int barrels = 16;
+        int bodies = 0;  // 0 = wolves + barrels + the player body
+    };
+
     GameStateManager();
     ~GameStateManager() = default;
 
@@ -81,6 +90,8 @@ public:
     // Room progression
     void advance_room();
     void complete_room();
+    void set_room_capacity(const RoomCapacity& capacity);
+    const RoomCapacity& get_room_capacity() const { return room_capacity_; }
     
     // RNG management
     unsigned int get_random_u32();
@@ -101,13 +112,14 @@ public:
     int get_rooms_cleared() const { return state_.rooms_cleared; }
     float get_game_time() const { return state_.game_time; }
     float get_total_play_time() const { return state_.total_play_time; }
+    void set_total_play_time(float seconds) { state_.total_play_time = seconds; }
     int get_gold() const { return state_.gold; }
     int get_essence() const { return state_.essence; }
     bool is_initialized() const { return state_.is_initialized; }
     bool is_paused() const { return state_.is_paused; }
     
     // Enemy physics queries
-    int get_enemy_count() const { return state_.enemy_count; }
+    int get_enemy_count() const { return static_cast<int>(enemy_bodies_.size()); }
     uint32_t get_enemy_body_id(int enemy_index) const;
     int get_enemy_index_for_body(uint32_t body_id) const;
     
@@ -116,6 +128,27 @@ public:
     void unregister_enemy_body(int enemy_index);
     void clear_all_enemy_bodies();
     
+    // Rollback snapshots: the whole state block, RNG included, then enemy bodies
+    void save_state(SnapshotWriter& w) const {
+        w.write(state_);
+        enemy_bodies_.save_state(w);
+        w.write_vector(enemy_body_by_index_);
+    }
+    bool load_state(SnapshotReader& r) {
+        return r.read(state_) && enemy_bodies_.load_state(r) && r.read_vector(enemy_body_by_index_);
+    }
+    
+    // Desync detection: RNG, phase and progression
+    void hash_state(FrameHasher& h) const {
+        h.add(state_.rng_seed);
+        h.add(state_.rng_state);
+        h.add(static_cast<int32_t>(state_.current_phase));
+        h.add(state_.room_count);
+        h.add(state_.wolf_kills_since_choice);
+        h.add(state_.gold);
+        h.add(state_.essence);
+    }
+    
     // Game control
     void pause();
     void resume();
@@ -123,6 +156,12 @@ public:
 
 private:
     GameState state_;
+    RoomCapacity room_capacity_;
+    
+    // Enemy physics tracking, no fixed cap: mappings keyed by body handle,
+    // plus enemy index -> body handle (INVALID_ENTITY = none)
+    DensePool<EnemyBodyMapping> enemy_bodies_;
+    std::vector<uint32_t> enemy_body_by_index_;
     
     // Phase transition helpers
     void enter_explore_phase();
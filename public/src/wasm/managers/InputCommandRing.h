@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Input command ring - player input written by JS straight into WASM memory
+ *
+ * Layout at get_input_command_ring_ptr() (little-endian): a 32-byte
+ * InputCommandRingHeader, then CAPACITY 24-byte InputCommands. JS writes
+ * a command at write_index & (capacity - 1), then bumps write_index. The
+ * simulation drains the ring once per GameCoordinator::update and bumps
+ * read_index. Both indices are free-running and each side only writes its
+ * own, so no call is needed per command. When the ring is full
+ * (write_index - read_index == capacity), JS drops the command and bumps
+ * dropped.
+ *
+ * JS stamps each command with the header's frame, the update that will
+ * drain it. A command stamped for a later frame waits in the ring. time_ms
+ * is the JS clock at the event (performance.now()). Just before calling
+ * update, JS stores the same clock in host_time_ms. A press then happened
+ * host_time_ms - time_ms before the update, which is what orders presses
+ * inside a frame and times them in the input buffer.
+ */
+namespace input_command {
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t CAPACITY = 64;  // Power of two
+
+enum Type : uint8_t {
+    STATE = 0,              // Held input as set_player_input: x, y axes, buttons = Button bits
+    LIGHT_ATTACK = 1,       // Presses: buffered for BAL_INPUT_BUFFER_TIME until they succeed
+    HEAVY_ATTACK = 2,
+    SPECIAL_ATTACK = 3,
+    ROLL = 4,
+    BASH_CHARGE = 5,        // start_charging_bash
+    BASH_RELEASE = 6,       // release_bash
+    LEFT_HAND_TARGET = 7,   // x, y, z as set_left_hand_target
+    RIGHT_HAND_TARGET = 8,  // x, y, z as set_right_hand_target
+    TYPE_COUNT
+};
+
+// STATE buttons (the same bits as the input log)
+enum Button : uint8_t {
+    BUTTON_ROLL = 1 << 0,
+    BUTTON_JUMP = 1 << 1,
+    BUTTON_LIGHT_ATTACK = 1 << 2,
+    BUTTON_HEAVY_ATTACK = 1 << 3,
+    BUTTON_BLOCK = 1 << 4,
+    BUTTON_SPECIAL = 1 << 5,
+};
+} // namespace input_command
+
+struct InputCommand {
+    uint32_t frame;    // Update that drains it (header frame when written)
+    float time_ms;     // JS clock at the event
+    uint8_t type;      // input_command::Type
+    uint8_t buttons;   // STATE: input_command::Button bits
+    uint16_t reserved;
+    float x, y, z;
+};
+static_assert(sizeof(InputCommand) == 24, "InputCommand is part of the JS ABI");
+
+struct InputCommandRingHeader {
+    uint32_t version = input_command::VERSION;
+    uint32_t capacity = input_command::CAPACITY;
+    std::atomic<uint32_t> write_index{0};  // JS only
+    std::atomic<uint32_t> read_index{0};   // Simulation only
+    uint32_t frame = 0;                    // Simulation: the next update to drain
+    std::atomic<uint32_t> dropped{0};      // JS: commands lost to a full ring
+    double host_time_ms = 0.0;             // JS: clock when update was called
+};
+static_assert(sizeof(InputCommandRingHeader) == 32, "InputCommandRingHeader is part of the JS ABI");
+
+/**
+ * InputCommandRing - the consumer side, owned by InputManager
+ *
+ * Transport only: it is not part of snapshots, and what a drain applies
+ * ends up in the InputManager state that is.
+ */
+class InputCommandRing {
+public:
+    static constexpr uint32_t MASK = input_command::CAPACITY - 1;
+    static_assert((input_command::CAPACITY & MASK) == 0, "capacity must be a power of two");
+
+    // Header followed by the commands, as JS sees them
+    void* data() { return &memory_; }
+    double host_time_ms() const { return memory_.header.host_time_ms; }
+    uint32_t frame() const { return memory_.header.frame; }
+
+    // Calls fn for each command due this frame, oldest first, then moves to
+    // the next frame. Returns the number of commands drained.
+    template <typename Fn>
+    int drain(Fn&& fn) {
+        InputCommandRingHeader& header = memory_.header;
+        const uint32_t write = header.write_index.load(std::memory_order_acquire);
+        uint32_t read = header.read_index.load(std::memory_order_relaxed);
+        // A writer that overran the ring has overwritten its oldest commands
+        if (write - read > input_command::CAPACITY) {
+            read = write - input_command::CAPACITY;
+        }
+        int drained = 0;
+        while (read != write) {
+            const InputCommand& cmd = memory_.commands[read & MASK];
+            if (static_cast<int32_t>(cmd.frame - header.frame) > 0) break;
+            fn(cmd);
+            ++read;
+            ++drained;
+        }
+        header.read_index.store(read, std::memory_order_release);
+        ++header.frame;
+        return drained;
+    }
+
+    // Discard everything written so far
+    void clear() {
+        memory_.header.read_index.store(memory_.header.write_index.load(std::memory_order_acquire),
+                                        std::memory_order_release);
+    }
+
+private:
+    struct Memory {
+        InputCommandRingHeader header;
+        InputCommand commands[input_command::CAPACITY];
+    };
+    static_assert(sizeof(Memory) == sizeof(InputCommandRingHeader) + input_command::CAPACITY * sizeof(InputCommand),
+                  "commands must follow the header directly");
+
+    Memory memory_;
+};
@@ -1,5 +1,6 @@
 #include "InputManager.h"
 #include "../GameGlobals.h"
+#include "../BalanceTable.h"
 #include "CombatManager.h"
 #include <cmath>
 #include <algorithm>
@@ -54,6 +55,71 @@ void InputManager::normalize_movement_input() {
 void InputManager::clear_input_latches() {
     current_input_ = {};
     previous_input_ = {};
+    buffered_presses_ = {};
+}
+
+int InputManager::drain_command_ring(float now) {
+    using namespace input_command;
+    frame_action_count_ = 0;
+    const double host_time_ms = command_ring_.host_time_ms();
+    const float window = bal(BAL_INPUT_BUFFER_TIME);
+    InputCommand state = {};
+    bool has_state = false;
+    
+    const int drained = command_ring_.drain([&](const InputCommand& cmd) {
+        if (!std::isfinite(cmd.x) || !std::isfinite(cmd.y) || !std::isfinite(cmd.z)) {
+            return;  // Same rule as the set_player_input export
+        }
+        if (cmd.type == STATE) {
+            state = cmd;
+            has_state = true;
+        } else if (cmd.type >= LIGHT_ATTACK && cmd.type <= ROLL) {
+            // Age within the frame; a press older than the window has already expired
+            float age = static_cast<float>((host_time_ms - static_cast<double>(cmd.time_ms)) / 1000.0);
+            age = std::max(0.0f, std::min(window, age));
+            const int slot = cmd.type - LIGHT_ATTACK;
+            buffered_presses_.pressed_at[slot] = now - age;
+            buffered_presses_.expires_at[slot] = now - age + window;
+            buffered_presses_.pending |= 1u << slot;
+        } else if (cmd.type < TYPE_COUNT) {
+            frame_actions_[frame_action_count_++] = cmd;
+        }
+    });
+    
+    // Held input only matters as of the update; earlier states in the frame are superseded
+    if (has_state) {
+        const uint8_t b = state.buttons;
+        update_input(state.x, state.y, (b & BUTTON_ROLL) != 0, (b & BUTTON_JUMP) != 0,
+                     (b & BUTTON_LIGHT_ATTACK) != 0, (b & BUTTON_HEAVY_ATTACK) != 0,
+                     (b & BUTTON_BLOCK) != 0, (b & BUTTON_SPECIAL) != 0);
+    }
+    return drained;
+}
+
+int InputManager::collect_buffered_presses(float now, uint8_t out[PRESS_COUNT]) {
+    int count = 0;
+    for (int slot = 0; slot < PRESS_COUNT; ++slot) {
+        const uint32_t bit = 1u << slot;
+        if (!(buffered_presses_.pending & bit)) continue;
+        if (now > buffered_presses_.expires_at[slot]) {
+            buffered_presses_.pending &= ~bit;
+            continue;
+        }
+        // Insertion by press time, ties by type, so simultaneous presses resolve the same way everywhere
+        int i = count++;
+        while (i > 0 && buffered_presses_.pressed_at[out[i - 1] - input_command::LIGHT_ATTACK] >
+                        buffered_presses_.pressed_at[slot]) {
+            out[i] = out[i - 1];
+            --i;
+        }
+        out[i] = static_cast<uint8_t>(input_command::LIGHT_ATTACK + slot);
+    }
+    return count;
+}
+
+void InputManager::consume_buffered_press(uint8_t type) {
+    if (type < input_command::LIGHT_ATTACK || type > input_command::ROLL) return;
+    buffered_presses_.pending &= ~(1u << (type - input_command::LIGHT_ATTACK));
 }
 
 bool InputManager::is_input_allowed() const {
@@ -1,4 +1,6 @@
 #pragma once
+#include "../physics/SnapshotStream.h"
+#include "InputCommandRing.h"
 
 /**
  * InputManager - Handles all player input processing and validation
@@ -16,6 +18,14 @@ public:
         bool is_blocking = false;
         bool special_attack = false;
     };
+    
+    // Presses from the command ring that have not succeeded yet (input buffer)
+    static constexpr int PRESS_COUNT = 4;  // input_command::LIGHT_ATTACK .. ROLL
+    struct BufferedPresses {
+        float pressed_at[PRESS_COUNT] = {};  // Game time of the latest press
+        float expires_at[PRESS_COUNT] = {};
+        uint32_t pending = 0;                // Bit per press
+    };
 
     InputManager();
     ~InputManager() = default;
@@ -26,6 +36,29 @@ public:
     void normalize_movement_input();
     void clear_input_latches();
     
+    // Command ring (see InputCommandRing.h). Drained once per update with the
+    // current game time: the last STATE command is applied as update_input,
+    // presses enter the input buffer, and the rest are kept for the
+    // coordinator to dispatch (get_frame_actions).
+    InputCommandRing& get_command_ring() { return command_ring_; }
+    int drain_command_ring(float now);
+    const InputCommand* get_frame_actions() const { return frame_actions_; }
+    int get_frame_action_count() const { return frame_action_count_; }
+    
+    // Buffered presses still inside the buffer window, oldest first (as
+    // input_command::Type). Expired presses are dropped. Consume a press once
+    // its action succeeds; the rest are retried next update.
+    int collect_buffered_presses(float now, uint8_t out[PRESS_COUNT]);
+    void consume_buffered_press(uint8_t type);
+    
+    // Rollback snapshots
+    void save_state(SnapshotWriter& w) const {
+        w.write(current_input_); w.write(previous_input_); w.write(buffered_presses_);
+    }
+    bool load_state(SnapshotReader& r) {
+        return r.read(current_input_) && r.read(previous_input_) && r.read(buffered_presses_);
+    }
+    
     // Combat manager integration (for stun state)
     void set_combat_manager(class CombatManager* cm) { combat_manager_ = cm; }
     
@@ -47,6 +80,10 @@ public:
 private:
     InputState current_input_;
     InputState previous_input_;
+    BufferedPresses buffered_presses_;
+    InputCommandRing command_ring_;
+    InputCommand frame_actions_[input_command::CAPACITY];
+    int frame_action_count_ = 0;
     class CombatManager* combat_manager_ = nullptr;
     
     // Input validation helpers
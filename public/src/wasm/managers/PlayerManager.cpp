@@ -3,10 +3,22 @@
 #include "../progression/AbilityUpgradeSystem.h"
 #include "../physics/FixedPoint.h"
 #include "../physics/PhysicsTypes.h"
+#include "../physics/OverlapQuery.h"
+#include "../Profiler.h"
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 
-// Using the real upgrade system function from AbilityUpgradeSystem
+// Upgrade effect keys, resolved during static initialization so gameplay
+// never writes the shared key table (instances may step on several threads)
+namespace {
+const int KEY_BASH_STAMINA_REFUND = upgrade_get_effect_key_id("warden.bash.stamina_refund", 26);
+const int KEY_BASH_DAMAGE = upgrade_get_effect_key_id("warden.bash.damage", 18);
+const int KEY_CHARGE_SPEED = upgrade_get_effect_key_id("raider.charge.speed", 19);
+const int KEY_CHARGE_DURATION = upgrade_get_effect_key_id("raider.charge.duration_s", 24);
+const int KEY_DASH_COST_REDUCTION = upgrade_get_effect_key_id("kensei.dash.stamina_cost_reduction", 34);
+const int KEY_DASH_IFRAMES = upgrade_get_effect_key_id("kensei.dash.iframes_ms", 22);
+}
 
 PlayerManager::PlayerManager() {
     reset_to_spawn();
@@ -23,26 +35,33 @@ void PlayerManager::update(float delta_time) {
     update_physics(delta_time);
     
     // Update skeleton physics if enabled
-    if (state_.use_skeleton_physics) {
-        update_skeleton(delta_time);
+    if constexpr (build::HAS_SKELETON) {
+        if (state_.use_skeleton_physics) {
+            PROFILE_ZONE(PROFILE_SKELETON);
+            update_skeleton(delta_time);
+        }
     }
     
-    // Update bash state
-    if (bash_state_.is_charging) {
-        update_bash_charge(delta_time);
-    }
-    if (bash_state_.is_active) {
-        update_active_bash(delta_time);
+    // Ability paths outside this build's class compile away (see BuildConfig.h)
+    if constexpr (build::HAS_BASH) {
+        if (bash_state_.is_charging) {
+            update_bash_charge(delta_time);
+        }
+        if (bash_state_.is_active) {
+            update_active_bash(delta_time);
+        }
     }
     
-    // Update berserker charge state
-    if (charge_state_.is_active) {
-        update_berserker_charge(delta_time);
+    if constexpr (build::HAS_BERSERKER_CHARGE) {
+        if (charge_state_.is_active) {
+            update_berserker_charge(delta_time);
+        }
     }
     
-    // Update flow dash state
-    if (dash_state_.is_active) {
-        update_flow_dash(delta_time);
+    if constexpr (build::HAS_FLOW_DASH) {
+        if (dash_state_.is_active) {
+            update_flow_dash(delta_time);
+        }
     }
     
     // Regenerate stamina
@@ -117,8 +136,8 @@ void PlayerManager::update_physics(float delta_time) {
     apply_friction(delta_time);
     
     // Clamp position to world bounds
-    state_.pos_x = std::max(0.0f, std::min(1.0f, state_.pos_x));
-    state_.pos_y = std::max(0.0f, std::min(1.0f, state_.pos_y));
+    state_.pos_x = std::max(bounds_min_x_, std::min(bounds_max_x_, state_.pos_x));
+    state_.pos_y = std::max(bounds_min_y_, std::min(bounds_max_y_, state_.pos_y));
 }
 
 void PlayerManager::reset_to_spawn() {
@@ -138,8 +157,15 @@ void PlayerManager::reset_to_spawn() {
 }
 
 void PlayerManager::set_position(float x, float y) {
-    state_.pos_x = std::max(0.0f, std::min(1.0f, x));
-    state_.pos_y = std::max(0.0f, std::min(1.0f, y));
+    state_.pos_x = std::max(bounds_min_x_, std::min(bounds_max_x_, x));
+    state_.pos_y = std::max(bounds_min_y_, std::min(bounds_max_y_, y));
+}
+
+void PlayerManager::set_world_bounds(float min_x, float min_y, float max_x, float max_y) {
+    bounds_min_x_ = min_x;
+    bounds_min_y_ = min_y;
+    bounds_max_x_ = std::max(min_x, max_x);
+    bounds_max_y_ = std::max(min_y, max_y);
 }
 
 void PlayerManager::set_velocity(float vx, float vy) {
@@ -147,6 +173,29 @@ void PlayerManager::set_velocity(float vx, float vy) {
     state_.vel_y = vy;
 }
 
+void PlayerManager::save_state(SnapshotWriter& w) const {
+    w.write(state_);
+    w.write(bash_state_);
+    w.write(charge_state_);
+    w.write(dash_state_);
+    w.write(skeleton_);
+}
+
+bool PlayerManager::load_state(SnapshotReader& r) {
+    // Bone constraints point into this skeleton and are fixed after initialize,
+    // so keep ours rather than the saved pointers
+    SkeletonPhysics::Constraint constraints[SkeletonPhysics::PlayerSkeleton::MAX_CONSTRAINTS];
+    std::memcpy(constraints, skeleton_.constraints, sizeof(constraints));
+    const int constraint_count = skeleton_.constraint_count;
+    
+    const bool ok = r.read(state_) && r.read(bash_state_) && r.read(charge_state_) &&
+        r.read(dash_state_) && r.read(skeleton_);
+    
+    std::memcpy(skeleton_.constraints, constraints, sizeof(constraints));
+    skeleton_.constraint_count = constraint_count;
+    return ok;
+}
+
 void PlayerManager::consume_stamina(float amount) {
     state_.stamina = std::max(0.0f, state_.stamina - amount);
 }
@@ -213,14 +262,14 @@ void PlayerManager::apply_friction(float delta_time) {
 
 void PlayerManager::handle_collisions() {
     // Simple collision with world boundaries
-    if (state_.pos_x <= 0.0f || state_.pos_x >= 1.0f) {
+    if (state_.pos_x <= bounds_min_x_ || state_.pos_x >= bounds_max_x_) {
         state_.vel_x = 0.0f;
     }
-    if (state_.pos_y <= 0.0f || state_.pos_y >= 1.0f) {
+    if (state_.pos_y <= bounds_min_y_ || state_.pos_y >= bounds_max_y_) {
         state_.vel_y = 0.0f;
     }
     
-    // TODO: Add proper collision detection with obstacles
+    // Obstacles (static geometry) are resolved by GameCoordinator after the update
 }
 
 void PlayerManager::update_grounded_state() {
@@ -238,7 +287,7 @@ void PlayerManager::update_grounded_state() {
 
 void PlayerManager::update_wall_sliding_state() {
     // Simple wall detection (TODO: improve with proper collision detection)
-    bool near_wall = (state_.pos_x <= 0.1f || state_.pos_x >= 0.9f);
+    bool near_wall = (state_.pos_x <= bounds_min_x_ + 0.1f || state_.pos_x >= bounds_max_x_ - 0.1f);
     state_.is_wall_sliding = near_wall && !state_.is_grounded && state_.vel_y < 0.0f;
 }
 
@@ -293,14 +342,7 @@ void PlayerManager::release_bash() {
     bash_state_.duration = BASH_DURATION;
     
     // Apply forward lunge (simplified - will integrate with physics manager later)
-    float bash_force = BASH_BASE_FORCE * bash_state_.force_multiplier.to_float();
-    // Apply progression: warden.bash.damage (multiplicative)
-    {
-        const char* key = "warden.bash.damage";
-        int fix = upgrade_get_effect_scalar(1, key, 18);
-        float mult = 1.0f + (fix / 65536.0f);
-        if (mult > 0.0f) bash_force *= mult;
-    }
+    float bash_force = get_bash_force();
     state_.vel_x += state_.facing_x * bash_force * 0.1f;
     state_.vel_y += state_.facing_y * bash_force * 0.1f;
     
@@ -331,7 +373,7 @@ void PlayerManager::update_active_bash(float dt) {
         bash_state_.targets_hit = 0;
     }
     
-    // TODO: Check for bash collisions with enemies
+    // Hits are resolved by the batched pass in GameCoordinator::coordinate_combat_actions
 }
 
 void PlayerManager::on_bash_hit(uint32_t target_id) {
@@ -348,8 +390,7 @@ void PlayerManager::on_bash_hit(uint32_t target_id) {
     state_.stamina = std::min(1.0f, state_.stamina + BASH_STAMINA_REFUND);
     
     // Apply progression: warden.bash.stamina_refund adds to base refund
-    const char* k = "warden.bash.stamina_refund";
-    int fix = upgrade_get_effect_scalar(1, k, 24);
+    int fix = upgrade_get_effect_scalar_id(1, KEY_BASH_STAMINA_REFUND);
     float bonus = fix / 65536.0f; // additive to base 0.1
     float refund = BASH_STAMINA_REFUND + bonus;
     if (refund > 0.0f) {
@@ -411,6 +452,15 @@ PlayerManager::BashHitbox PlayerManager::get_bash_hitbox() const {
     return hitbox;
 }
 
+float PlayerManager::get_bash_force() const {
+    float bash_force = BASH_BASE_FORCE * bash_state_.force_multiplier.to_float();
+    // Apply progression: warden.bash.damage (multiplicative)
+    int fix = upgrade_get_effect_scalar_id(1, KEY_BASH_DAMAGE);
+    float mult = 1.0f + (fix / 65536.0f);
+    if (mult > 0.0f) bash_force *= mult;
+    return bash_force;
+}
+
 bool PlayerManager::check_bash_collision(float target_x, float target_y, float target_radius) const {
     if (!bash_state_.is_active) {
         return false;
@@ -421,15 +471,9 @@ bool PlayerManager::check_bash_collision(float target_x, float target_y, float t
         return false;
     }
     
-    // Circle-circle collision detection
-    float dx = target_x - hitbox.x;
-    float dy = target_y - hitbox.y;
-    float dist_sq = dx * dx + dy * dy;
-    
-    float combined_radius = hitbox.radius + target_radius;
-    float combined_radius_sq = combined_radius * combined_radius;
-    
-    return dist_sq <= combined_radius_sq;
+    // Same circle test the batched hit pass runs (see CombatManager::resolve_hits)
+    return QueryShape::circle_f(hitbox.x, hitbox.y, hitbox.radius)
+        .overlaps(FixedVector3::from_floats(target_x, target_y, 0.0f), Fixed::from_float(target_radius));
 }
 
 void PlayerManager::update_skeleton(float delta_time) {
@@ -498,14 +542,12 @@ void PlayerManager::start_berserker_charge() {
     state_.speed_multiplier = CHARGE_SPEED_MULTIPLIER;
     // Apply progression: raider.charge.speed multiplier and duration bonus seconds
     {
-        const char* keyS = "raider.charge.speed";
-        int fixS = upgrade_get_effect_scalar(2, keyS, 19);
+        int fixS = upgrade_get_effect_scalar_id(2, KEY_CHARGE_SPEED);
         float multS = 1.0f + (fixS / 65536.0f);
         charge_state_.speed_multiplier = Fixed::from_float(2.5f * multS);
     }
     {
-        const char* keyD = "raider.charge.duration_s";
-        int fixD = upgrade_get_effect_scalar(2, keyD, 24);
+        int fixD = upgrade_get_effect_scalar_id(2, KEY_CHARGE_DURATION);
         float addSeconds = fixD / 65536.0f;
         charge_state_.duration = CHARGE_DURATION + addSeconds;
         charge_state_.remaining_duration = charge_state_.duration;
@@ -558,9 +600,9 @@ void PlayerManager::cancel_berserker_charge() {
     state_.speed_multiplier = 1.0f;
 }
 
-void PlayerManager::on_charge_hit(uint32_t target_id) {
+float PlayerManager::on_charge_hit(uint32_t target_id) {
     if (!charge_state_.is_active) {
-        return;
+        return 0.0f;
     }
     
     charge_state_.targets_hit++;
@@ -570,12 +612,12 @@ void PlayerManager::on_charge_hit(uint32_t target_id) {
                                    state_.vel_y * state_.vel_y);
     float momentum_damage = current_speed * 10.0f;
     
-    // TODO: Apply knockback to target (perpendicular to charge)
     // TODO: Check if target died for healing effect
     // For now, assume target survives - in full implementation:
     // if (is_enemy_dead(target_id)) {
     //     heal(CHARGE_HEAL_PER_KILL);
     // }
+    return momentum_damage;
 }
 
 // Berserker charge getters
@@ -648,12 +690,14 @@ void PlayerManager::execute_flow_dash(float direction_x, float direction_y) {
     }
     
     // Calculate target position
+    dash_state_.start_x = state_.pos_x;
+    dash_state_.start_y = state_.pos_y;
     dash_state_.target_x = state_.pos_x + direction_x * DASH_DISTANCE;
     dash_state_.target_y = state_.pos_y + direction_y * DASH_DISTANCE;
     
     // Clamp to world bounds [0, 1]
-    dash_state_.target_x = std::max(0.0f, std::min(1.0f, dash_state_.target_x));
-    dash_state_.target_y = std::max(0.0f, std::min(1.0f, dash_state_.target_y));
+    dash_state_.target_x = std::max(bounds_min_x_, std::min(bounds_max_x_, dash_state_.target_x));
+    dash_state_.target_y = std::max(bounds_min_y_, std::min(bounds_max_y_, dash_state_.target_y));
     
     // Initialize dash state
     dash_state_.is_active = true;
@@ -668,15 +712,13 @@ void PlayerManager::execute_flow_dash(float direction_x, float direction_y) {
     consume_stamina(actual_cost);
     // Apply progression: kensei.dash.iframes_ms and kensei.dash.stamina_cost_reduction
     {
-        const char* keyC = "kensei.dash.stamina_cost_reduction";
-        int fixC = upgrade_get_effect_scalar(3, keyC, 31);
+        int fixC = upgrade_get_effect_scalar_id(3, KEY_DASH_COST_REDUCTION);
         float reduction = fixC / 65536.0f; // 0..1
         float cost = std::max(0.0f, DASH_STAMINA_COST * (1.0f - reduction));
         consume_stamina(cost);
     }
     {
-        const char* keyI = "kensei.dash.iframes_ms";
-        int fixI = upgrade_get_effect_scalar(3, keyI, 23);
+        int fixI = upgrade_get_effect_scalar_id(3, KEY_DASH_IFRAMES);
         float addMs = fixI / 65536.0f; // milliseconds
         if (addMs > 0.0f) {
             dash_state_.is_invulnerable = true;
@@ -722,8 +764,7 @@ void PlayerManager::update_flow_dash(float dt) {
     state_.pos_x = start_x + (dash_state_.target_x - start_x) * ease_t;
     state_.pos_y = start_y + (dash_state_.target_y - start_y) * ease_t;
     
-    // TODO: Check for collisions along dash path
-    // TODO: Create dash slash hitbox
+    // Hits along the path: GameCoordinator sweeps a capsule from the dash start
 }
 
 void PlayerManager::cancel_flow_dash() {
@@ -737,9 +778,9 @@ void PlayerManager::cancel_flow_dash() {
     dash_state_.combo_level = 0;
 }
 
-void PlayerManager::on_dash_hit(uint32_t target_id) {
+float PlayerManager::on_dash_hit(uint32_t target_id) {
     if (!dash_state_.is_active) {
-        return;
+        return 0.0f;
     }
     
     // Store target for chain dash tracking
@@ -753,9 +794,7 @@ void PlayerManager::on_dash_hit(uint32_t target_id) {
     
     // Calculate damage with combo scaling
     float damage = DASH_BASE_DAMAGE * (1.0f + dash_state_.combo_level * DASH_COMBO_MULTIPLIER);
-    
-    // TODO: Apply damage to target
-    // TODO: Apply knockback
+    return damage;
 }
 
 // Flow dash getters
@@ -1,6 +1,8 @@
 #pragma once
+#include "../BuildConfig.h"
 #include "../physics/FixedPoint.h"
 #include "../physics/SkeletonPhysics.h"
+#include "../physics/SnapshotStream.h"
 
 /**
  * PlayerManager - Manages player state, movement, and basic properties
@@ -91,6 +93,8 @@ public:
         Fixed dash_distance;
         bool can_cancel = false;
         bool is_invulnerable = false;
+        float start_x = 0.0f;             // Dash start position (hit capsule runs start -> player)
+        float start_y = 0.0f;
         float target_x = 0.0f;            // Dash target position
         float target_y = 0.0f;
         float dash_progress = 0.0f;       // 0-1 interpolation
@@ -112,6 +116,13 @@ public:
     void reset_to_spawn();
     void set_position(float x, float y);
     void set_velocity(float vx, float vy);
+    // Area the player is kept in: the unit room unless a streamed world
+    // (WorldManager) widens it. Configuration, not snapshot state.
+    void set_world_bounds(float min_x, float min_y, float max_x, float max_y);
+    
+    // Rollback snapshots (see GameCoordinator::save_state)
+    void save_state(SnapshotWriter& w) const;
+    bool load_state(SnapshotReader& r);
     
     // Health and stamina
     void consume_stamina(float amount);
@@ -139,6 +150,7 @@ public:
     bool is_bash_charging() const;
     uint32_t get_bash_targets_hit() const;
     BashHitbox get_bash_hitbox() const;
+    float get_bash_force() const;  // Knockback impulse for a bash hit
     
     // Collision detection
     bool check_bash_collision(float target_x, float target_y, float target_radius) const;
@@ -150,7 +162,7 @@ public:
     void start_berserker_charge();
     void update_berserker_charge(float dt);
     void cancel_berserker_charge();
-    void on_charge_hit(uint32_t target_id);
+    float on_charge_hit(uint32_t target_id);  // Returns the momentum damage to apply
     bool can_charge() const;
     
     // Berserker charge getters
@@ -166,7 +178,7 @@ public:
     void execute_flow_dash(float direction_x, float direction_y);
     void update_flow_dash(float dt);
     void cancel_flow_dash();
-    void on_dash_hit(uint32_t target_id);
+    float on_dash_hit(uint32_t target_id);    // Returns the combo-scaled damage to apply
     bool can_dash() const;
     bool can_chain_dash() const;
     
@@ -177,6 +189,8 @@ public:
     float get_dash_progress() const;
     bool is_dash_invulnerable() const;
     bool can_dash_cancel() const;
+    float get_dash_start_x() const { return dash_state_.start_x; }
+    float get_dash_start_y() const { return dash_state_.start_y; }
     
     // Getters
     const PlayerState& get_state() const { return state_; }
@@ -198,7 +212,7 @@ public:
     float get_balance_quality() const { return state_.balance_quality; }
     bool is_left_foot_grounded() const { return state_.left_foot_grounded; }
     bool is_right_foot_grounded() const { return state_.right_foot_grounded; }
-    const SkeletonPhysics::PlayerSkeleton* get_skeleton() const { return &skeleton_; }
+    const SkeletonPhysics::PlayerSkeleton* get_skeleton() const { return build::HAS_SKELETON ? &skeleton_ : nullptr; }
 
 private:
     PlayerState state_;
@@ -206,6 +220,10 @@ private:
     BerserkerChargeState charge_state_;
     FlowDashState dash_state_;
     SkeletonPhysics::PlayerSkeleton skeleton_;
+    float bounds_min_x_ = 0.0f;
+    float bounds_min_y_ = 0.0f;
+    float bounds_max_x_ = 1.0f;
+    float bounds_max_y_ = 1.0f;
     
     // Movement constants
     static constexpr float MOVE_SPEED = 0.3f;  // Reduced from 0.8f for better control
@@ -1,9 +1,12 @@
 #include "WolfManager.h"
 #include "../coordinators/GameCoordinator.h"
 #include "../physics/FixedPoint.h"
+#include "../physics/FixedTrig.h"
 #include "../physics/PhysicsTypes.h"
-#include "generated/balance_data.h"
+#include "../physics/FrameArena.h"
+#include "BalanceTable.h"
 #include "wolves/WolfConstants.h"
+#include "../Profiler.h"
 #include <cmath>
 #include <algorithm>
 
@@ -33,8 +36,30 @@ void WolfManager::initialize(GameCoordinator* coordinator) {
 void WolfManager::clear_all() {
     wolves_.clear();
     packs_.clear();
+    render_state_.clear();
+    body_index_.clear();
+    id_index_.clear();
+    neighbor_grid_.clear();
+    neighbor_grid_dirty_ = true;
     next_wolf_id_ = 1;
     next_pack_id_ = 1;
+    pack_role_updates_ = 0;
+    pack_plan_evaluations_ = 0;
+}
+
+void WolfManager::reserve(int wolves, int packs) {
+    const size_t wolf_count = wolves > 0 ? static_cast<size_t>(wolves) : 0;
+    const size_t pack_count = packs > 0 ? static_cast<size_t>(packs) : 0;
+    wolves_.reserve(wolf_count);
+    packs_.reserve(pack_count);
+    render_state_.reserve(wolf_count);
+    body_index_.reserve(wolf_count);
+    id_index_.reserve(next_wolf_id_ + wolf_count);
+    neighbor_grid_.reserve(wolf_count);
+    perception_.reserve(wolf_count, pack_count);
+    due_wolves_.reserve(wolf_count);
+    due_dt_.reserve(wolf_count);
+    state_buckets_.reserve(wolf_count);
 }
 
 void WolfManager::update(float delta_time) {
@@ -42,18 +67,83 @@ void WolfManager::update(float delta_time) {
         return;
     }
     
-    // Update all wolves
-    for (Wolf& wolf : wolves_) {
-        update_wolf_ai(wolf, delta_time);
+    const double start_ms = perf_now_ms();
+    
+    // Index positions once; separation and line-of-sight queries read from it
+    neighbor_grid_.build(wolves_);
+    neighbor_grid_dirty_ = false;
+    
+    // Player-relative state once per frame; decisions below read from it
+    perception_.begin(perceive_player(), wolves_);
+    
+    ai_tier_counts_[0] = ai_tier_counts_[1] = ai_tier_counts_[2] = 0;
+    ai_full_updates_ = 0;
+    int budget = ai_budget_;
+    due_wolves_.clear();
+    due_dt_.clear();
+    
+    // Decide: wolves due a full update take their state transitions, all
+    // against the same start-of-frame positions
+    for (size_t i = 0; i < wolves_.size(); ++i) {
+        Wolf& wolf = wolves_[i];
+        wolf.ai_tier = classify_ai_tier(wolf);
+        ai_tier_counts_[static_cast<int>(wolf.ai_tier)]++;
+        wolf.ai_pending_dt += delta_time;
+        if (wolf.ai_frames_pending < UINT16_MAX) {
+            wolf.ai_frames_pending++;
+        }
+        
+        // Near wolves decide every tick; distant tiers wait for their interval
+        // and share the per-tick budget (wolves that miss it stay due)
+        bool full_update = wolf.ai_tier == WolfAiTier::Near;
+        if (!full_update && wolf.ai_frames_pending >= ai_tier_interval(wolf.ai_tier) && budget > 0) {
+            full_update = true;
+            budget--;
+        }
+        
+        // Decisions consume all time since the wolf's last full update
+        if (full_update) {
+            const float ai_dt = wolf.ai_pending_dt;
+            wolf.ai_pending_dt = 0.0f;
+            wolf.ai_frames_pending = 0;
+            ai_full_updates_++;
+            due_wolves_.push_back(static_cast<uint32_t>(i));
+            due_dt_.push_back(ai_dt);
+            decide_wolf_state(wolf, ai_dt);
+        }
+    }
+    
+    // Act: one tight loop per state over the wolves in it
+    run_state_behaviors();
+    
+    size_t next_due = 0;
+    for (size_t i = 0; i < wolves_.size(); ++i) {
+        Wolf& wolf = wolves_[i];
+        const bool full_update = next_due < due_wolves_.size() && due_wolves_[next_due] == i;
+        const float ai_dt = full_update ? due_dt_[next_due++] : 0.0f;
+        if (full_update) {
+            update_wolf_timers(wolf, ai_dt);
+        }
         update_wolf_physics(wolf, delta_time);
-        update_wolf_emotion(wolf, delta_time);
-        update_wolf_memory(wolf, delta_time);
+        perception_.refresh(i, wolf);
+        if (full_update) {
+            update_wolf_emotion(wolf, ai_dt);
+            update_wolf_memory(wolf, ai_dt);
+        }
+        
+        // Cheap per-tick work: physics sync, separation and animation easing
         update_wolf_spatial_awareness(wolf, delta_time);
         update_wolf_animation(wolf, delta_time);
     }
     
     // Update pack coordination
+    perception_.update_pack_centers(packs_, wolves_, neighbor_grid_);
     update_pack_coordination(delta_time);
+    perception_.end();
+    
+    refresh_render_state();
+    
+    ai_update_ms_ = static_cast<float>(perf_now_ms() - start_ms);
     
     // Update adaptive difficulty every 10 seconds
     difficulty_update_timer_ += delta_time;
@@ -64,7 +154,7 @@ void WolfManager::update(float delta_time) {
     }
 }
 
-void WolfManager::spawn_wolf(float x, float y, WolfType type) {
+uint32_t WolfManager::spawn_wolf(float x, float y, WolfType type) {
     Wolf wolf;
     wolf.id = next_wolf_id_++;
     wolf.type = type;
@@ -75,6 +165,8 @@ void WolfManager::spawn_wolf(float x, float y, WolfType type) {
     wolf.health_at_state_enter = wolf.health;
     wolf.decision_interval = 0.15f;
     wolf.decision_timer = wolf.decision_interval;
+    // Stagger distant-tier updates across ticks (round-robin by id)
+    wolf.ai_frames_pending = static_cast<uint16_t>(wolf.id % AI_LOD_FAR_INTERVAL);
     
     init_wolf_stats(wolf);
     
@@ -84,11 +176,17 @@ void WolfManager::spawn_wolf(float x, float y, WolfType type) {
     }
     
     wolves_.push_back(wolf);
+    neighbor_grid_dirty_ = true;
+    if (wolf.id >= id_index_.size()) {
+        id_index_.resize(wolf.id + 1, SparseIndex::NONE);
+    }
+    id_index_[wolf.id] = static_cast<uint32_t>(wolves_.size() - 1);
     
-    // Map physics body ID to wolf index
+    // Map physics body handle to wolf index
     if (wolf.physics_body_id != 0) {
-        body_id_to_index_[wolf.physics_body_id] = static_cast<int>(wolves_.size() - 1);
+        body_index_.set(wolf.physics_body_id, static_cast<uint32_t>(wolves_.size() - 1));
     }
+    return wolf.id;
 }
 
 void WolfManager::init_wolf_stats(Wolf& wolf) {
@@ -142,21 +240,51 @@ void WolfManager::init_wolf_stats(Wolf& wolf) {
 }
 
 void WolfManager::remove_wolf(uint32_t wolf_id) {
-    // Find wolf to get physics body ID
     Wolf* wolf = find_wolf_by_id(wolf_id);
-    if (wolf) {
-        if (wolf->physics_body_id > 0 && coordinator_) {
-            coordinator_->get_physics_manager().destroy_body(wolf->physics_body_id);
+    if (!wolf) {
+        return;
+    }
+    if (wolf->physics_body_id > 0 && coordinator_) {
+        coordinator_->get_physics_manager().destroy_body(wolf->physics_body_id);
+    }
+    body_index_.erase(wolf->physics_body_id);
+    id_index_[wolf_id] = SparseIndex::NONE;
+    const std::size_t index = static_cast<std::size_t>(wolf - wolves_.data());
+    const int last = static_cast<int>(wolves_.size()) - 1;
+
+    // Membership event: the pack reassigns roles and rescores its plan
+    if (Pack* pack = wolf->pack_id != 0 ? find_pack_by_id(wolf->pack_id) : nullptr) {
+        pack->wolf_ids.erase(std::remove(pack->wolf_ids.begin(), pack->wolf_ids.end(), wolf_id),
+                             pack->wolf_ids.end());
+        pack->dirty |= PACK_DIRTY_ROLES | PACK_DIRTY_PLAN;
+        if (pack->leader_index == static_cast<int>(index)) {
+            pack->leader_index = -1;
+        }
+    }
+
+    // Swap-remove: only the wolf moved into the hole needs its index entries patched
+    if (index + 1 < wolves_.size()) {
+        *wolf = wolves_.back();
+        if (wolf->physics_body_id != 0) {
+            body_index_.set(wolf->physics_body_id, static_cast<uint32_t>(index));
+        }
+        id_index_[wolf->id] = static_cast<uint32_t>(index);
+        for (Pack& pack : packs_) {
+            if (pack.leader_index == last) {
+                pack.leader_index = static_cast<int>(index);
+            }
         }
-        body_id_to_index_.erase(wolf->physics_body_id);
     }
+    wolves_.pop_back();
+    neighbor_grid_dirty_ = true;
+}
 
-    wolves_.erase(
-        std::remove_if(wolves_.begin(), wolves_.end(),
-            [wolf_id](const Wolf& w) { return w.id == wolf_id; }),
-        wolves_.end()
-    );
-    rebuild_body_index_map();
+const WolfNeighborGrid& WolfManager::neighbor_grid() const {
+    if (neighbor_grid_dirty_) {
+        neighbor_grid_.build(wolves_);
+        neighbor_grid_dirty_ = false;
+    }
+    return neighbor_grid_;
 }
 
 void WolfManager::damage_wolf(uint32_t wolf_id, float damage, float knockback_x, float knockback_y) {
@@ -166,11 +294,24 @@ void WolfManager::damage_wolf(uint32_t wolf_id, float damage, float knockback_x,
     }
     
     // Apply damage
+    const float health_before = wolf->health;
     wolf->health -= damage;
     if (wolf->health < 0.0f) {
         wolf->health = 0.0f;
     }
     
+    // Health threshold events for the wolf's pack
+    if (wolf->pack_id != 0 && wolf->max_health > 0.0f) {
+        const float critical = PACK_CRITICAL_HEALTH * wolf->max_health;
+        const float wounded = PACK_WOUNDED_HEALTH * wolf->max_health;
+        if ((health_before >= critical && wolf->health < critical) ||
+            (health_before > 0.0f && wolf->health <= 0.0f)) {
+            mark_pack_dirty(wolf->pack_id, PACK_DIRTY_ROLES | PACK_DIRTY_PLAN);
+        } else if (health_before >= wounded && wolf->health < wounded) {
+            mark_pack_dirty(wolf->pack_id, PACK_DIRTY_PLAN);
+        }
+    }
+    
     // Apply knockback
     wolf->vx += Fixed::from_float(knockback_x * 0.3f);
     wolf->vy += Fixed::from_float(knockback_y * 0.3f);
@@ -207,45 +348,45 @@ Wolf* WolfManager::get_wolf_mutable(int index) {
 }
 
 Wolf* WolfManager::find_wolf_by_id(uint32_t wolf_id) {
-    for (Wolf& wolf : wolves_) {
-        if (wolf.id == wolf_id) {
-            return &wolf;
-        }
+    if (wolf_id >= id_index_.size()) {
+        return nullptr;
     }
-    return nullptr;
+    const uint32_t index = id_index_[wolf_id];
+    if (index >= wolves_.size() || wolves_[index].id != wolf_id) {
+        return nullptr;
+    }
+    return &wolves_[index];
 }
 
 Wolf* WolfManager::find_wolf_by_body(uint32_t body_id) {
-    auto it = body_id_to_index_.find(body_id);
-    if (it == body_id_to_index_.end()) {
-        return nullptr;
-    }
-    const int index = it->second;
-    if (index < 0 || static_cast<std::size_t>(index) >= wolves_.size()) {
+    const uint32_t index = body_index_.find(body_id);
+    if (index >= wolves_.size() || wolves_[index].physics_body_id != body_id) {
         return nullptr;
     }
     return &wolves_[index];
 }
 
 const Wolf* WolfManager::find_wolf_by_body(uint32_t body_id) const {
-    auto it = body_id_to_index_.find(body_id);
-    if (it == body_id_to_index_.end()) {
-        return nullptr;
-    }
-    const int index = it->second;
-    if (index < 0 || static_cast<std::size_t>(index) >= wolves_.size()) {
+    const uint32_t index = body_index_.find(body_id);
+    if (index >= wolves_.size() || wolves_[index].physics_body_id != body_id) {
         return nullptr;
     }
     return &wolves_[index];
 }
 
-void WolfManager::rebuild_body_index_map() {
-    body_id_to_index_.clear();
+void WolfManager::rebuild_indices() {
+    body_index_.clear();
+    id_index_.assign(next_wolf_id_, SparseIndex::NONE);
     for (std::size_t i = 0; i < wolves_.size(); ++i) {
         const auto body_id = wolves_[i].physics_body_id;
         if (body_id != 0) {
-            body_id_to_index_[body_id] = static_cast<int>(i);
+            body_index_.set(body_id, static_cast<uint32_t>(i));
         }
+        const uint32_t id = wolves_[i].id;
+        if (id >= id_index_.size()) {
+            id_index_.resize(id + 1, SparseIndex::NONE);
+        }
+        id_index_[id] = static_cast<uint32_t>(i);
     }
 }
 
@@ -260,11 +401,46 @@ void WolfManager::set_wolf_collision_cooldown(uint32_t body_id, float cooldown_t
 // AI UPDATE - Main wolf AI logic
 // ============================================================================
 
-void WolfManager::update_wolf_ai(Wolf& wolf, float delta_time) {
-    // Update state machine
-    update_wolf_state_machine(wolf, delta_time);
+WolfAiTier WolfManager::classify_ai_tier(const Wolf& wolf) const {
+    if (!ai_lod_enabled_) {
+        return WolfAiTier::Near;
+    }
+    
+    // Engaged wolves stay at full rate regardless of distance
+    if (wolf.state == WolfState::Attack || wolf.state == WolfState::Retreat || wolf.pack_command_received) {
+        return WolfAiTier::Near;
+    }
+    
+    const float dist = get_distance_to_player(wolf);
+    WolfAiTier tier = dist < AI_LOD_NEAR_RADIUS ? WolfAiTier::Near
+                    : dist < AI_LOD_MID_RADIUS ? WolfAiTier::Mid
+                    : WolfAiTier::Far;
     
-    // Update cooldowns
+    // Pack leaders drive plans for the whole pack; keep them responsive
+    if (tier == WolfAiTier::Far && wolf.pack_id != 0 && wolf.pack_role == PackRole::Leader) {
+        tier = WolfAiTier::Mid;
+    }
+    return tier;
+}
+
+int WolfManager::ai_tier_interval(WolfAiTier tier) {
+    switch (tier) {
+        case WolfAiTier::Mid: return AI_LOD_MID_INTERVAL;
+        case WolfAiTier::Far: return AI_LOD_FAR_INTERVAL;
+        case WolfAiTier::Near:
+        default: return 1;
+    }
+}
+
+int WolfManager::get_ai_tier_count(int tier) const {
+    if (tier < 0 || tier > static_cast<int>(WolfAiTier::Far)) {
+        return 0;
+    }
+    return ai_tier_counts_[tier];
+}
+
+void WolfManager::update_wolf_timers(Wolf& wolf, float delta_time) {
+    // Update cooldowns (after this tick's behavior, which may start one)
     if (wolf.attack_cooldown > 0.0f) {
         wolf.attack_cooldown -= delta_time;
     }
@@ -292,8 +468,9 @@ void WolfManager::move_towards_player(Wolf& wolf, float delta_time) {
         return;
     }
     
-    float player_x = coordinator_->get_player_manager().get_x();
-    float player_y = coordinator_->get_player_manager().get_y();
+    const WolfPerception::Player player = perceive_player();
+    float player_x = player.x;
+    float player_y = player.y;
     
     Fixed dx = Fixed::from_float(player_x) - wolf.x;
     Fixed dy = Fixed::from_float(player_y) - wolf.y;
@@ -325,8 +502,9 @@ void WolfManager::circle_strafe(Wolf& wolf, float delta_time) {
         return;
     }
     
-    float player_x = coordinator_->get_player_manager().get_x();
-    float player_y = coordinator_->get_player_manager().get_y();
+    const WolfPerception::Player player = perceive_player();
+    float player_x = player.x;
+    float player_y = player.y;
     
     Fixed dx = Fixed::from_float(player_x) - wolf.x;
     Fixed dy = Fixed::from_float(player_y) - wolf.y;
@@ -344,16 +522,48 @@ void WolfManager::circle_strafe(Wolf& wolf, float delta_time) {
         wolf.vx = (strafe_x / length) * speed;
         wolf.vy = (strafe_y / length) * speed;
         
-        // Keep facing player
-        wolf.facing_x = dx / fixed_sqrt(dx * dx + dy * dy);
-        wolf.facing_y = dy / fixed_sqrt(dx * dx + dy * dy);
+        // Keep facing player (the strafe vector is (dx, dy) rotated, so same length)
+        wolf.facing_x = dx / length;
+        wolf.facing_y = dy / length;
+    }
+}
+
+WolfPerception::Player WolfManager::perceive_player() const {
+    if (perception_.valid()) {
+        return perception_.player();
+    }
+    WolfPerception::Player player;
+    if (coordinator_) {
+        const PlayerManager& pm = coordinator_->get_player_manager();
+        player.x = pm.get_x();
+        player.y = pm.get_y();
+        player.vx = pm.get_vel_x();
+        player.vy = pm.get_vel_y();
+        player.facing_x = pm.get_facing_x();
+        player.facing_y = pm.get_facing_y();
+    }
+    return player;
+}
+
+int WolfManager::perception_index(const Wolf& wolf) const {
+    if (!perception_.valid() || perception_.size() != wolves_.size()) {
+        return -1;
+    }
+    const Wolf* first = wolves_.data();
+    if (&wolf < first || &wolf >= first + wolves_.size()) {
+        return -1;
     }
+    return static_cast<int>(&wolf - first);
 }
 
 float WolfManager::get_distance_to_player(const Wolf& wolf) const {
     if (!coordinator_) {
         return 999.0f;
     }
+    const int index = perception_index(wolf);
+    if (index >= 0) {
+        return perception_.distance(index);
+    }
     
     float player_x = coordinator_->get_player_manager().get_x();
     float player_y = coordinator_->get_player_manager().get_y();
@@ -372,6 +582,10 @@ float WolfManager::compute_facing_dot_to_player(const Wolf& wolf) const {
     if (!coordinator_) {
         return 1.0f;
     }
+    const int index = perception_index(wolf);
+    if (index >= 0) {
+        return perception_.facing_dot(index, wolf);
+    }
     float player_x = coordinator_->get_player_manager().get_x();
     float player_y = coordinator_->get_player_manager().get_y();
     float dx = player_x - wolf.x.to_float();
@@ -386,6 +600,9 @@ float WolfManager::compute_facing_dot_to_player(const Wolf& wolf) const {
 }
 
 int WolfManager::count_current_attackers() const {
+    if (perception_.valid()) {
+        return perception_.attackers();
+    }
     int count = 0;
     for (const Wolf& w : wolves_) {
         if (w.state == WolfState::Attack) {
@@ -403,23 +620,27 @@ void WolfManager::update_wolf_physics(Wolf& wolf, float delta_time) {
     // Sync with PhysicsManager if available
     if (coordinator_ && wolf.physics_body_id > 0) {
         auto& physics_mgr = coordinator_->get_physics_manager();
-        auto* body = physics_mgr.get_body(wolf.physics_body_id);
+        BodySnapshot body;
         
-        if (body) {
+        if (physics_mgr.read_body(wolf.physics_body_id, body)) {
             // Only update physics velocity if NOT in collision cooldown
             // This allows physics separation to take effect without AI overriding it
             if (wolf.collision_cooldown <= 0.0f) {
                 // Update physics body velocity based on wolf AI
-                physics_mgr.set_velocity(wolf.physics_body_id, FixedVector3::from_floats(wolf.vx.to_float(), wolf.vy.to_float(), 0.0f));
+                const FixedVector3 ai_velocity = FixedVector3::from_floats(wolf.vx.to_float(), wolf.vy.to_float(), 0.0f);
+                physics_mgr.set_velocity(wolf.physics_body_id, ai_velocity);
+                if (!physics_mgr.is_worker_enabled()) {
+                    body.velocity = ai_velocity;  // Applied immediately when stepping inline
+                }
             }
             
             // Always read back position from physics (handles collision resolution)
-            wolf.x = body->position.x;
-            wolf.y = body->position.y;
+            wolf.x = body.position.x;
+            wolf.y = body.position.y;
             
             // Always read back velocity from physics (handles collision response)
-            wolf.vx = body->velocity.x;
-            wolf.vy = body->velocity.y;
+            wolf.vx = body.velocity.x;
+            wolf.vy = body.velocity.y;
         }
     } else {
         // Fallback: manual physics integration
@@ -537,8 +758,9 @@ void WolfManager::update_wolf_memory(Wolf& wolf, float delta_time) {
     }
     
     // Track player movement patterns
-    float player_vx = coordinator_->get_player_manager().get_vel_x();
-    float player_vy = coordinator_->get_player_manager().get_vel_y();
+    const WolfPerception::Player player = perceive_player();
+    float player_vx = player.vx;
+    float player_vy = player.vy;
     float player_speed = std::sqrt(player_vx * player_vx + player_vy * player_vy);
     
     // Exponential moving average
@@ -565,7 +787,7 @@ void WolfManager::update_wolf_memory(Wolf& wolf, float delta_time) {
 // PACK BEHAVIOR (Basic stubs for Phase 4)
 // ============================================================================
 
-void WolfManager::create_pack(const std::vector<uint32_t>& wolf_ids) {
+uint32_t WolfManager::create_pack(const std::vector<uint32_t>& wolf_ids) {
     Pack pack;
     pack.pack_id = next_pack_id_++;
     pack.wolf_ids = wolf_ids;
@@ -583,6 +805,30 @@ void WolfManager::create_pack(const std::vector<uint32_t>& wolf_ids) {
     }
     
     assign_pack_roles(packs_.back());
+    return pack.pack_id;
+}
+
+int WolfManager::remove_pack(uint32_t pack_id) {
+    Pack* pack = find_pack_by_id(pack_id);
+    if (!pack) {
+        return 0;
+    }
+    // remove_wolf edits the member list, so work from a copy
+    const std::vector<uint32_t> members = pack->wolf_ids;
+    int alive = 0;
+    for (uint32_t wolf_id : members) {
+        if (const Wolf* wolf = find_wolf_by_id(wolf_id)) {
+            alive += wolf->health > 0.0f ? 1 : 0;
+            remove_wolf(wolf_id);
+        }
+    }
+    for (size_t i = 0; i < packs_.size(); ++i) {
+        if (packs_[i].pack_id == pack_id) {
+            packs_.erase(packs_.begin() + static_cast<std::ptrdiff_t>(i));
+            break;
+        }
+    }
+    return alive;
 }
 
 void WolfManager::update_pack_roles() {
@@ -592,13 +838,15 @@ void WolfManager::update_pack_roles() {
 }
 
 void WolfManager::assign_pack_roles(Pack& pack) {
-    // Find leader (highest intelligence * morale)
+    pack_role_updates_++;
+    
+    // Find leader (highest intelligence * morale) among members fit to lead
     float best_score = 0.0f;
     Wolf* leader = nullptr;
     
     for (uint32_t wolf_id : pack.wolf_ids) {
         Wolf* w = find_wolf_by_id(wolf_id);
-        if (!w) {
+        if (!w || w->health < PACK_CRITICAL_HEALTH * w->max_health || w->health <= 0.0f) {
             continue;
         }
         
@@ -611,13 +859,8 @@ void WolfManager::assign_pack_roles(Pack& pack) {
     
     if (leader) {
         leader->pack_role = PackRole::Leader;
-        // Cache leader index for exports
-        // Find index within wolves_ vector; fallback -1 if not found
-        int li = -1;
-        for (std::size_t i = 0; i < wolves_.size(); ++i) {
-            if (wolves_[i].id == leader->id) { li = static_cast<int>(i); break; }
-        }
-        pack.leader_index = li;
+        // Cached for exports; remove_wolf patches it when the leader moves
+        pack.leader_index = static_cast<int>(leader - wolves_.data());
     } else {
         pack.leader_index = -1;
     }
@@ -646,18 +889,46 @@ void WolfManager::coordinate_pack_attack() {
 }
 
 void WolfManager::update_pack_coordination(float delta_time) {
-    // Placeholder for Phase 4
     for (Pack& pack : packs_) {
+        // Roles change only on pack events (see PACK_DIRTY_ROLES)
+        if (pack.dirty & PACK_DIRTY_ROLES) {
+            pack.dirty &= static_cast<uint8_t>(~PACK_DIRTY_ROLES);
+            assign_pack_roles(pack);
+        }
         update_pack_ai(pack, delta_time);
     }
 }
 
+void WolfManager::mark_pack_dirty(uint32_t pack_id, uint8_t bits) {
+    if (Pack* pack = pack_id != 0 ? find_pack_by_id(pack_id) : nullptr) {
+        pack->dirty |= bits;
+    }
+}
+
 void WolfManager::update_pack_ai(Pack& pack, float delta_time) {
+    // Plans run at the rate of the pack's nearest member
+    WolfAiTier tier = WolfAiTier::Far;
+    neighbor_grid().for_each_in_pack(pack.pack_id, [&](int index) {
+        tier = std::min(tier, wolves_[index].ai_tier);
+    });
+    pack.ai_pending_dt += delta_time;
+    if (pack.ai_frames_pending < UINT16_MAX) {
+        pack.ai_frames_pending++;
+    }
+    if (pack.ai_frames_pending < ai_tier_interval(tier)) {
+        return;
+    }
+    delta_time = pack.ai_pending_dt;
+    pack.ai_pending_dt = 0.0f;
+    pack.ai_frames_pending = 0;
+    
     pack.plan_timer -= delta_time;
     
-    // Re-evaluate pack plan every 3 seconds
-    if (pack.plan_timer <= 0.0f) {
-        pack.plan_timer = 3.0f;
+    // Rescore the plan after a pack event, or when it has gone stale
+    if ((pack.dirty & PACK_DIRTY_PLAN) || pack.plan_timer <= 0.0f) {
+        pack.dirty &= static_cast<uint8_t>(~PACK_DIRTY_PLAN);
+        pack.plan_timer = PACK_PLAN_INTERVAL;
+        pack_plan_evaluations_++;
         
         // Count wolves in attack range and check pack health
         int wolves_near_player = 0;
@@ -773,8 +1044,9 @@ void WolfManager::execute_pincer_plan(Pack& pack) {
         return;
     }
     
-    float player_x = coordinator_->get_player_manager().get_x();
-    float player_y = coordinator_->get_player_manager().get_y();
+    const WolfPerception::Player player = perceive_player();
+    float player_x = player.x;
+    float player_y = player.y;
     
     // Split pack into two groups attacking from opposite sides
     int wolf_count = 0;
@@ -786,8 +1058,8 @@ void WolfManager::execute_pincer_plan(Pack& pack) {
         
         // First half attacks from one side, second half from opposite
         float target_angle = (wolf_count % 2 == 0) ? 0.0f : PI;
-        float target_x = player_x + std::cos(target_angle) * 0.15f;
-        float target_y = player_y + std::sin(target_angle) * 0.15f;
+        float target_x = player_x + trig_cos(target_angle) * 0.15f;
+        float target_y = player_y + trig_sin(target_angle) * 0.15f;
         
         move_wolf_to_position(*wolf, target_x, target_y);
         wolf_count++;
@@ -797,8 +1069,7 @@ void WolfManager::execute_pincer_plan(Pack& pack) {
 void WolfManager::execute_commit_plan(Pack& pack) {
     // Threat budget: choose up to N wolves to attack; others strafe/position
     struct Candidate { uint32_t id; float dist; };
-    std::vector<Candidate> candidates;
-    candidates.reserve(pack.wolf_ids.size());
+    FrameVector<Candidate> candidates(coordinator_->get_frame_arena(), pack.wolf_ids.size());
     for (uint32_t wolf_id : pack.wolf_ids) {
         Wolf* wolf = find_wolf_by_id(wolf_id);
         if (!wolf || wolf->health <= 0.0f) {
@@ -878,24 +1149,11 @@ void WolfManager::execute_regroup_plan(Pack& pack) {
         return;
     }
     
-    // Calculate pack center
-    float center_x = 0.0f;
-    float center_y = 0.0f;
-    int count = 0;
-    
-    for (uint32_t wolf_id : pack.wolf_ids) {
-        Wolf* wolf = find_wolf_by_id(wolf_id);
-        if (!wolf) {
-            continue;
-        }
-        center_x += wolf->x.to_float();
-        center_y += wolf->y.to_float();
-        count++;
-    }
-    
-    if (count > 0) {
-        center_x /= count;
-        center_y /= count;
+    // Pack center from this frame's perception snapshot
+    const size_t pack_index = static_cast<size_t>(&pack - packs_.data());
+    if (perception_.valid() && perception_.has_pack_center(pack_index)) {
+        const float center_x = perception_.pack_center_x(pack_index);
+        const float center_y = perception_.pack_center_y(pack_index);
         
         // Move all wolves toward pack center
         for (uint32_t wolf_id : pack.wolf_ids) {
@@ -976,7 +1234,7 @@ void WolfManager::update_wolf_animation(Wolf& wolf, float delta_time) {
         case EmotionalState::Confident:
             target_stretch *= 1.1f;  // Chest out
             target_head_pitch += 0.1f;  // Head high
-            wolf.tail_wag = std::sin(wolf.state_timer * 8.0f) * 0.6f;  // Vigorous wag
+            wolf.tail_wag = trig_sin(wolf.state_timer * 8.0f) * 0.6f;  // Vigorous wag
             break;
             
         case EmotionalState::Fearful:
@@ -988,7 +1246,7 @@ void WolfManager::update_wolf_animation(Wolf& wolf, float delta_time) {
         case EmotionalState::Desperate:
             target_stretch *= 0.95f;  // Tense posture
             target_head_pitch -= 0.1f;  // Head slightly down
-            wolf.tail_wag = std::sin(wolf.state_timer * 12.0f) * 0.3f;  // Nervous twitch
+            wolf.tail_wag = trig_sin(wolf.state_timer * 12.0f) * 0.3f;  // Nervous twitch
             break;
             
         case EmotionalState::Aggressive:
@@ -1028,19 +1286,19 @@ void WolfManager::update_wolf_animation(Wolf& wolf, float delta_time) {
         float phase = wolf.anim_phase + phase_offsets[i] + (wolf.id * leg_id_offsets[i]);
         
         // X: horizontal stride (forward/back)
-        wolf.leg_positions[i][0] = sinf(phase) * 0.25f * speed;
+        wolf.leg_positions[i][0] = trig_sin(phase) * 0.25f * speed;
         
         // Y: vertical lift (ground contact = 0, max lift = 0.15)
-        float raw_lift = sinf(phase * 2.0f);
+        float raw_lift = trig_sin(phase * 2.0f);
         wolf.leg_positions[i][1] = (raw_lift > 0.0f) ? raw_lift * 0.15f : 0.0f;
     }
     
     // Body bob - vertical oscillation during movement
-    wolf.body_bob = (speed > 0.05f) ? sinf(wolf.anim_phase * 2.0f) * 0.08f * speed : 0.0f;
+    wolf.body_bob = (speed > 0.05f) ? trig_sin(wolf.anim_phase * 2.0f) * 0.08f * speed : 0.0f;
     
     // Update head_yaw to track movement direction (already have head_pitch from existing code)
     if (speed > 0.05f) {
-        wolf.head_yaw = atan2f(wolf.vy.to_float(), wolf.vx.to_float());
+        wolf.head_yaw = trig_atan2(wolf.vy.to_float(), wolf.vx.to_float());
     }
 }
 
@@ -1089,7 +1347,7 @@ bool WolfManager::should_attack(const Wolf& wolf) const {
         }
         // Facing angle gating
         float facing_dot = compute_facing_dot_to_player(wolf);
-        if (facing_dot < ATTACK_FACING_COS_THRESHOLD) {
+        if (facing_dot < state_table().thresholds().attack_facing_cos) {
             // Observability
             const_cast<WolfManager*>(this)->gating_angle_rejects_count_++;
             return false;
@@ -1198,16 +1456,17 @@ FixedVector3 WolfManager::calculate_separation_force(const Wolf& wolf) const {
     
     FixedVector3 separation_force = FixedVector3::zero();
     int nearby_count = 0;
+    const Fixed separation_dist = Fixed::from_float(SEPARATION_DISTANCE);
     
-    for (const Wolf& other : wolves_) {
+    neighbor_grid().for_each_in_radius(wolf.x.to_float(), wolf.y.to_float(), SEPARATION_DISTANCE, [&](int index) {
+        const Wolf& other = wolves_[index];
         if (other.id == wolf.id) {
-            continue;
+            return;
         }
         
         Fixed dx = wolf.x - other.x;
         Fixed dy = wolf.y - other.y;
         Fixed dist_sq = dx * dx + dy * dy;
-        Fixed separation_dist = Fixed::from_float(SEPARATION_DISTANCE);
         
         if (dist_sq < separation_dist * separation_dist && dist_sq.raw > 0) {
             Fixed dist = fixed_sqrt(dist_sq);
@@ -1221,7 +1480,7 @@ FixedVector3 WolfManager::calculate_separation_force(const Wolf& wolf) const {
             separation_force += push_dir * force_magnitude;
             nearby_count++;
         }
-    }
+    });
     
     if (nearby_count > 0) {
         // Apply strong separation force
@@ -1238,33 +1497,44 @@ bool WolfManager::has_clear_path_to_player(const Wolf& wolf) const {
         return true;
     }
     
-    float player_x = coordinator_->get_player_manager().get_x();
-    float player_y = coordinator_->get_player_manager().get_y();
+    constexpr float BLOCK_DISTANCE = 0.05f;  // Max distance from the line for a wolf to block it
     
-    for (const Wolf& other : wolves_) {
-        if (other.id == wolf.id) {
-            continue;
+    const WolfPerception::Player player = perceive_player();
+    const float player_x = player.x;
+    const float player_y = player.y;
+    const float wolf_x = wolf.x.to_float();
+    const float wolf_y = wolf.y.to_float();
+    const float wolf_to_player_x = player_x - wolf_x;
+    const float wolf_to_player_y = player_y - wolf_y;
+    const float line_length_sq = wolf_to_player_x * wolf_to_player_x + wolf_to_player_y * wolf_to_player_y;
+    if (line_length_sq <= 0.0f) {
+        return true;
+    }
+    const float line_length = std::sqrt(line_length_sq);
+    
+    bool blocked = false;
+    neighbor_grid().for_each_near_segment(wolf_x, wolf_y, player_x, player_y, BLOCK_DISTANCE, [&](int index) {
+        const Wolf& other = wolves_[index];
+        if (blocked || other.id == wolf.id) {
+            return;
         }
         
         // Check if other wolf is on the line between this wolf and player
-        float wolf_to_player_x = player_x - wolf.x.to_float();
-        float wolf_to_player_y = player_y - wolf.y.to_float();
-        float wolf_to_other_x = other.x.to_float() - wolf.x.to_float();
-        float wolf_to_other_y = other.y.to_float() - wolf.y.to_float();
+        float wolf_to_other_x = other.x.to_float() - wolf_x;
+        float wolf_to_other_y = other.y.to_float() - wolf_y;
         
-        // Dot product to check if in same direction
+        // Dot product to check if in same direction and not beyond the player
         float dot = wolf_to_player_x * wolf_to_other_x + wolf_to_player_y * wolf_to_other_y;
-        if (dot > 0.0f) {
+        if (dot > 0.0f && dot <= line_length_sq) {
             // Other wolf is in front, check if close to line
             float dist_to_line = std::abs(wolf_to_player_x * wolf_to_other_y - wolf_to_player_y * wolf_to_other_x);
-            float line_length = std::sqrt(wolf_to_player_x * wolf_to_player_x + wolf_to_player_y * wolf_to_player_y);
-            if (line_length > 0.0f && dist_to_line / line_length < 0.05f) {
-                return false;  // Path blocked
+            if (dist_to_line / line_length < BLOCK_DISTANCE) {
+                blocked = true;  // Path blocked
             }
         }
-    }
+    });
     
-    return true;
+    return !blocked;
 }
 
 // Calculate optimal attack angle based on pack positions
@@ -1273,8 +1543,9 @@ float WolfManager::get_optimal_attack_angle(const Wolf& wolf) const {
         return 0.0f;
     }
     
-    float player_x = coordinator_->get_player_manager().get_x();
-    float player_y = coordinator_->get_player_manager().get_y();
+    const WolfPerception::Player player = perceive_player();
+    float player_x = player.x;
+    float player_y = player.y;
     
     // Start with preferred angle from memory
     float best_angle = wolf.preferred_attack_angle;
@@ -1283,20 +1554,21 @@ float WolfManager::get_optimal_attack_angle(const Wolf& wolf) const {
     constexpr int NUM_ANGLES = 8;
     bool angle_occupied[NUM_ANGLES] = {false};
     
-    for (const Wolf& other : wolves_) {
-        if (other.id == wolf.id || other.pack_id != wolf.pack_id) {
-            continue;
+    neighbor_grid().for_each_in_pack(wolf.pack_id, [&](int index) {
+        const Wolf& other = wolves_[index];
+        if (other.id == wolf.id) {
+            return;
         }
         
         // Calculate angle of other wolf relative to player
         float dx = other.x.to_float() - player_x;
         float dy = other.y.to_float() - player_y;
-        float angle = std::atan2(dy, dx);
+        float angle = trig_atan2(dy, dx);
         
         // Mark this angle sector as occupied
         int sector = static_cast<int>((angle + PI) / (2.0f * PI / NUM_ANGLES)) % NUM_ANGLES;
         angle_occupied[sector] = true;
-    }
+    });
     
     // Find first unoccupied angle
     for (int i = 0; i < NUM_ANGLES; i++) {
@@ -1327,6 +1599,7 @@ bool WolfManager::check_interrupt_conditions(Wolf& wolf, WolfState& out_new_stat
     if (health_percent < 0.2f && wolf.state != WolfState::Retreat) {
         out_new_state = WolfState::Retreat;
         interrupt_critical_health_count_++;
+        mark_pack_dirty(wolf.pack_id, PACK_DIRTY_PLAN);
         return true;
     }
     
@@ -1342,15 +1615,17 @@ bool WolfManager::check_interrupt_conditions(Wolf& wolf, WolfState& out_new_stat
     if (dist_to_player < wolf.attack_range * 0.7f && wolf.state == WolfState::Patrol) {
         out_new_state = WolfState::Strafe;
         interrupt_close_proximity_count_++;
+        mark_pack_dirty(wolf.pack_id, PACK_DIRTY_PLAN);
         return true;
     }
     
     // Priority 4: Damaged while attacking - recover based on damage delta
     if (wolf.state == WolfState::Attack) {
         float damage_taken = wolf.health_at_state_enter - wolf.health;
-        if (damage_taken >= DAMAGE_INTERRUPT_THRESHOLD) {
+        if (damage_taken >= state_table().thresholds().damage_interrupt) {
             out_new_state = WolfState::Recover;
             interrupt_damage_count_++;
+            mark_pack_dirty(wolf.pack_id, PACK_DIRTY_PLAN);
             return true;
         }
     }
@@ -1358,10 +1633,142 @@ bool WolfManager::check_interrupt_conditions(Wolf& wolf, WolfState& out_new_stat
     return false;
 }
 
+// ============================================================================
+// ROLLBACK SNAPSHOTS
+// ============================================================================
+
+void WolfManager::save_state(SnapshotWriter& w) const {
+    w.write_vector(wolves_);
+    w.write(static_cast<uint32_t>(packs_.size()));
+    for (const Pack& pack : packs_) {
+        w.write(pack.pack_id);
+        w.write_vector(pack.wolf_ids);
+        w.write(pack.current_plan);
+        w.write(pack.plan_timer);
+        w.write(pack.coordination_bonus);
+        w.write(pack.pack_morale);
+        w.write(pack.leader_index);
+        w.write(pack.ai_frames_pending);
+        w.write(pack.ai_pending_dt);
+        w.write(pack.dirty);
+    }
+    w.write(next_wolf_id_);
+    w.write(next_pack_id_);
+    w.write(total_attacks_);
+    w.write(player_dodges_);
+    w.write(player_blocks_);
+    w.write(average_kill_time_);
+    w.write(difficulty_update_timer_);
+    w.write(max_concurrent_attackers_);
+}
+
+bool WolfManager::load_state(SnapshotReader& r) {
+    uint32_t pack_count = 0;
+    bool ok = r.read_vector(wolves_) && r.read(pack_count);
+    if (ok) {
+        // resize() keeps each surviving pack's wolf_ids capacity
+        packs_.resize(pack_count);
+        for (Pack& pack : packs_) {
+            ok = ok && r.read(pack.pack_id) && r.read_vector(pack.wolf_ids) &&
+                r.read(pack.current_plan) && r.read(pack.plan_timer) &&
+                r.read(pack.coordination_bonus) && r.read(pack.pack_morale) &&
+                r.read(pack.leader_index) && r.read(pack.ai_frames_pending) &&
+                r.read(pack.ai_pending_dt) && r.read(pack.dirty);
+        }
+    }
+    ok = ok && r.read(next_wolf_id_) && r.read(next_pack_id_) &&
+        r.read(total_attacks_) && r.read(player_dodges_) && r.read(player_blocks_) &&
+        r.read(average_kill_time_) && r.read(difficulty_update_timer_) &&
+        r.read(max_concurrent_attackers_);
+    if (!ok) {
+        clear_all();
+        return false;
+    }
+    
+    // One pass, no allocations once the indices have grown to the slot and id counts
+    rebuild_indices();
+    neighbor_grid_dirty_ = true;
+    refresh_render_state();
+    return true;
+}
+
+void WolfManager::hash_state(FrameHasher& h) const {
+    // Per field: Wolf has padding, and animation-only fields cannot desync gameplay
+    h.add(static_cast<uint32_t>(wolves_.size()));
+    for (const Wolf& w : wolves_) {
+        h.add(w.id);
+        h.add(w.physics_body_id);
+        h.add(w.x.raw);
+        h.add(w.y.raw);
+        h.add(w.vx.raw);
+        h.add(w.vy.raw);
+        h.add(w.health);
+        h.add(w.stamina);
+        h.add(w.state_timer);
+        h.add(w.attack_cooldown);
+        h.add(static_cast<uint32_t>(w.state) | (static_cast<uint32_t>(w.emotion) << 8) |
+              (static_cast<uint32_t>(w.pack_role) << 16) | (static_cast<uint32_t>(w.current_attack_type) << 24));
+        h.add(w.pack_id);
+    }
+    h.add(static_cast<uint32_t>(packs_.size()));
+    for (const Pack& pack : packs_) {
+        h.add(pack.pack_id);
+        h.add(static_cast<uint32_t>(pack.current_plan));
+        h.add(pack.plan_timer);
+        h.add(static_cast<uint32_t>(pack.wolf_ids.size()) | (static_cast<uint32_t>(pack.dirty) << 24));
+    }
+}
+
 // ============================================================================
 // ANIMATION STATE GETTERS (for WASM exports)
 // ============================================================================
 
+int WolfManager::write_render_state(WolfRenderState* out, int max_wolves) const {
+    if (!out || max_wolves <= 0) {
+        return 0;
+    }
+    const int count = std::min(max_wolves, static_cast<int>(wolves_.size()));
+    for (int i = 0; i < count; ++i) {
+        const Wolf& w = wolves_[i];
+        WolfRenderState& r = out[i];
+        r.id = w.id;
+        r.type = static_cast<uint32_t>(w.type);
+        r.state = static_cast<uint32_t>(w.state);
+        r.emotion = static_cast<uint32_t>(w.emotion);
+        r.pack_role = static_cast<uint32_t>(w.pack_role);
+        r.pack_id = w.pack_id;
+        r.attack_type = w.current_attack_type;
+        r.ai_tier = static_cast<uint32_t>(w.ai_tier);
+        r.x = w.x.to_float();
+        r.y = w.y.to_float();
+        r.vx = w.vx.to_float();
+        r.vy = w.vy.to_float();
+        r.facing_x = w.facing_x.to_float();
+        r.facing_y = w.facing_y.to_float();
+        r.health = w.health;
+        r.max_health = w.max_health;
+        r.stamina = w.stamina;
+        r.body_stretch = w.body_stretch;
+        r.head_pitch = w.head_pitch;
+        r.head_yaw = w.head_yaw;
+        r.tail_wag = w.tail_wag;
+        r.body_bob = w.body_bob;
+        r.ear_rotation[0] = w.ear_rotation[0];
+        r.ear_rotation[1] = w.ear_rotation[1];
+        for (int leg = 0; leg < 4; ++leg) {
+            r.leg_positions[leg][0] = w.leg_positions[leg][0];
+            r.leg_positions[leg][1] = w.leg_positions[leg][1];
+        }
+    }
+    return count;
+}
+
+void WolfManager::refresh_render_state() {
+    // resize() keeps capacity, so the buffer only moves when the wolf count grows
+    render_state_.resize(wolves_.size());
+    write_render_state(render_state_.data(), static_cast<int>(render_state_.size()));
+}
+
 float WolfManager::get_wolf_leg_x(int index, int leg) const {
     if (index < 0 || index >= static_cast<int>(wolves_.size()) || 
         leg < 0 || leg >= 4) return 0.0f;
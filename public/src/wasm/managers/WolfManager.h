@@ -2,9 +2,16 @@
 #include <vector>
 #include <cstdint>
 #include <algorithm>
-#include <unordered_map>
 #include "../physics/FixedPoint.h"
+#include "../physics/SnapshotStream.h"
+#include "../physics/FrameHash.h"
+#include "../physics/EntityRegistry.h"
+#include "wolves/WolfConstants.h"
 #include "wolves/WolfTypes.h"
+#include "wolves/WolfNeighborGrid.h"
+#include "wolves/WolfPerception.h"
+#include "wolves/WolfStateTable.h"
+#include "wolves/WolfRenderState.h"
 
 /**
  * WolfManager - Manages wolf enemy AI, behavior, and combat
@@ -29,14 +36,20 @@ public:
     void initialize(GameCoordinator* coordinator);
     void update(float delta_time);
     void clear_all();
+    // Capacity hint (see GameStateManager::RoomCapacity): wolf storage and
+    // per-update scratch for that many wolves and packs; never shrinks
+    void reserve(int wolves, int packs);
+    int get_wolf_capacity() const { return static_cast<int>(wolves_.capacity()); }
     
-    // Wolf spawning and management
-    void spawn_wolf(float x, float y, WolfType type);
+    // Wolf spawning and management (spawn_wolf returns the wolf id)
+    uint32_t spawn_wolf(float x, float y, WolfType type);
     void remove_wolf(uint32_t wolf_id);
     void damage_wolf(uint32_t wolf_id, float damage, float knockback_x, float knockback_y);
     
     // Pack management
-    void create_pack(const std::vector<uint32_t>& wolf_ids);
+    uint32_t create_pack(const std::vector<uint32_t>& wolf_ids);  // Returns the pack id
+    // Removes the pack and all its members; returns how many were alive
+    int remove_pack(uint32_t pack_id);
     void update_pack_roles();
     void coordinate_pack_attack();
     
@@ -51,13 +64,32 @@ public:
     Wolf* find_wolf_by_body(uint32_t body_id);
     const Wolf* find_wolf_by_body(uint32_t body_id) const;
     
+    // Rollback snapshots (see GameCoordinator::save_state)
+    void save_state(SnapshotWriter& w) const;
+    bool load_state(SnapshotReader& r);
+    
+    // Desync detection: gameplay-relevant wolf and pack fields
+    void hash_state(FrameHasher& h) const;
+    
     // Adaptive difficulty
     void update_difficulty_scaling(float player_skill);
     float estimate_player_skill() const;
     
+    // AI level of detail (for WASM exports / tuning)
+    void set_ai_lod_enabled(bool enabled) { ai_lod_enabled_ = enabled; }
+    bool is_ai_lod_enabled() const { return ai_lod_enabled_; }
+    void set_ai_budget(int full_updates_per_tick) { ai_budget_ = std::max(0, full_updates_per_tick); }
+    int get_ai_budget() const { return ai_budget_; }
+    int get_ai_tier_count(int tier) const;
+    int get_ai_full_updates() const { return ai_full_updates_; }
+    float get_ai_update_ms() const { return ai_update_ms_; }
+    
     // Pack info queries (for WASM exports)
     int get_pack_count() const { return static_cast<int>(packs_.size()); }
     const Pack* get_pack(int index) const;
+    // Role and plan recomputations since initialize; they follow pack events, not time
+    uint32_t get_pack_role_updates() const { return pack_role_updates_; }
+    uint32_t get_pack_plan_evaluations() const { return pack_plan_evaluations_; }
     
     // Animation state getters (for WASM exports)
     float get_wolf_leg_x(int index, int leg) const;
@@ -68,15 +100,53 @@ public:
     float get_wolf_tail_wag(int index) const;
     float get_wolf_ear_rotation(int index, int ear) const;
     float get_wolf_body_stretch(int index) const;
+    
+    // Bulk render state (for WASM exports): fixed-stride records, see WolfRenderState.h
+    int write_render_state(WolfRenderState* out, int max_wolves) const;
+    const WolfRenderState* get_render_state_buffer() const { return render_state_.data(); }
+    int get_render_state_count() const { return static_cast<int>(render_state_.size()); }
 
 private:
     GameCoordinator* coordinator_ = nullptr;
     std::vector<Wolf> wolves_;
     std::vector<Pack> packs_;
-    std::unordered_map<uint32_t, int> body_id_to_index_;
+    SparseIndex body_index_;  // Physics body handle -> index in wolves_
+    std::vector<uint32_t> id_index_;  // Wolf id -> index in wolves_ (NONE once removed); ids are not reused
     uint32_t next_wolf_id_ = 1;
     uint32_t next_pack_id_ = 1;
     
+    // Spatial index over wolves_, rebuilt each update (and lazily after spawn/remove)
+    mutable WolfNeighborGrid neighbor_grid_;
+    mutable bool neighbor_grid_dirty_ = true;
+    
+    // Player-relative view shared by every decision in an update (see WolfPerception.h)
+    WolfPerception perception_;
+    WolfPerception::Player perceive_player() const;
+    int perception_index(const Wolf& wolf) const;  // -1 outside update
+    
+    // Durations and transition thresholds, rebuilt when the balance table changes
+    mutable WolfStateTable state_table_;
+    const WolfStateTable& state_table() const;
+    
+    // Wolves due a full AI update this tick (ascending index) and their
+    // accumulated dt; bucketed by state so each behavior runs as one loop
+    std::vector<uint32_t> due_wolves_;
+    std::vector<float> due_dt_;
+    std::vector<uint32_t> state_buckets_;           // Positions in due_wolves_, grouped by state
+    uint32_t state_bucket_start_[WOLF_STATE_COUNT + 1] = {};
+    void run_state_behaviors();
+    
+    // AI level of detail: distant wolves run full updates every few ticks
+    bool ai_lod_enabled_ = true;
+    int ai_budget_ = wolves::constants::AI_LOD_DEFAULT_BUDGET;  // Full Mid/Far updates per tick
+    int ai_tier_counts_[3] = {0, 0, 0};
+    int ai_full_updates_ = 0;           // Full AI updates last tick (all tiers)
+    float ai_update_ms_ = 0.0f;         // Wall-clock, monitoring only
+    
+    // Render records refreshed at the end of each update; storage is reused
+    std::vector<WolfRenderState> render_state_;
+    void refresh_render_state();
+    
     // Performance tracking
     uint32_t total_attacks_ = 0;
     uint32_t player_dodges_ = 0;
@@ -87,9 +157,11 @@ private:
     float difficulty_update_timer_ = 0.0f;
     
     // Internal AI methods
-    void update_wolf_ai(Wolf& wolf, float delta_time);
+    WolfAiTier classify_ai_tier(const Wolf& wolf) const;
+    static int ai_tier_interval(WolfAiTier tier);
+    void update_wolf_timers(Wolf& wolf, float delta_time);
     void update_wolf_physics(Wolf& wolf, float delta_time);
-    void update_wolf_state_machine(Wolf& wolf, float delta_time);
+    void decide_wolf_state(Wolf& wolf, float delta_time);
     void update_wolf_emotion(Wolf& wolf, float delta_time);
     void update_wolf_memory(Wolf& wolf, float delta_time);
     void update_pack_coordination(float delta_time);
@@ -127,6 +199,7 @@ private:
     // Pack AI
     void update_pack_ai(Pack& pack, float delta_time);
     void assign_pack_roles(Pack& pack);
+    void mark_pack_dirty(uint32_t pack_id, uint8_t bits);
     void execute_pack_plan(Pack& pack);
     void execute_ambush_plan(Pack& pack);
     void execute_pincer_plan(Pack& pack);
@@ -140,7 +213,8 @@ private:
     // Helper methods
     Pack* find_pack_by_id(uint32_t pack_id);
     void init_wolf_stats(Wolf& wolf);
-    void rebuild_body_index_map();
+    void rebuild_indices();
+    const WolfNeighborGrid& neighbor_grid() const;
     
     // New systems - Phase 2 & 3 (Pack Intelligence & Reactive Combat)
     bool check_interrupt_conditions(Wolf& wolf, WolfState& out_new_state);
@@ -167,6 +241,8 @@ private:
     uint32_t gating_angle_rejects_count_ = 0;
     uint32_t gating_los_rejects_count_ = 0;
     uint32_t threat_budget_deferrals_count_ = 0;
+    uint32_t pack_role_updates_ = 0;
+    uint32_t pack_plan_evaluations_ = 0;
 };
 
 
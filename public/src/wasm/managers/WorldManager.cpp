@@ -0,0 +1,343 @@
+#include "WorldManager.h"
+#include "PlayerManager.h"
+#include "WolfManager.h"
+#include "../physics/PhysicsManager.h"
+#include "../physics/StaticGeometry.h"
+#include "../physics/CollisionLayers.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Chunk content stream; independent of the game RNG, so paging order never
+// changes what a chunk holds
+uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+float unit_float(uint64_t& state) {
+    return static_cast<float>(splitmix64(state) >> 40) * (1.0f / 16777216.0f);
+}
+
+// Fractions of the chunk size
+constexpr float FEATURE_MARGIN = 0.15f;  // Feature centres stay this far inside the chunk
+constexpr float CLEAR_RADIUS = 0.2f;     // Kept free around the chunk centre, where packs form
+constexpr float PACK_SPREAD = 0.05f;
+constexpr uint32_t PACK_CHANCE_PERCENT = 50;
+
+constexpr uint32_t BLOCKED_LAYERS =
+    CollisionLayers::Player | CollisionLayers::Enemy | CollisionLayers::Projectile | CollisionLayers::PlayerArm;
+
+// Member offsets from the pack centre, in PACK_SPREAD units
+constexpr float PACK_OFFSETS[WorldManager::MAX_PACK_SIZE][2] = {
+    { 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f }
+};
+}
+
+void WorldManager::initialize(PhysicsManager* physics, WolfManager* wolves, PlayerManager* player) {
+    physics_ = physics;
+    wolves_ = wolves;
+    player_ = player;
+}
+
+bool WorldManager::configure(const WorldMapConfig& config, float player_x, float player_y) {
+    const int64_t chunk_count = static_cast<int64_t>(config.chunks_x) * config.chunks_y;
+    if (config.chunks_x <= 0 || config.chunks_y <= 0 || chunk_count > MAX_CHUNKS ||
+        !(config.chunk_size > 0.0f) || !(config.load_radius >= 0.0f)) {
+        return false;
+    }
+    clear();
+    config_ = config;
+    config_.unload_margin = std::max(0.0f, config_.unload_margin);
+    config_.page_budget = std::max(1, config_.page_budget);
+    records_.assign(static_cast<size_t>(chunk_count), WorldChunkRecord{});
+
+    // The player starts in a chunk without a pack
+    const int32_t hx = std::clamp(static_cast<int32_t>(std::floor(player_x / config_.chunk_size)), 0, config_.chunks_x - 1);
+    const int32_t hy = std::clamp(static_cast<int32_t>(std::floor(player_y / config_.chunk_size)), 0, config_.chunks_y - 1);
+    home_chunk_ = hy * config_.chunks_x + hx;
+    records_[static_cast<size_t>(home_chunk_)].visited = 1;
+
+    page_ins_ = 0;
+    page_outs_ = 0;
+    pending_ = 0;
+    ++feature_revision_;
+    apply_bounds();
+    return true;
+}
+
+void WorldManager::clear() {
+    if (!is_enabled() && resident_.empty()) {
+        return;
+    }
+    while (!resident_.empty()) {
+        page_out(resident_.back());
+    }
+    records_.clear();
+    features_.clear();
+    config_ = WorldMapConfig{};
+    home_chunk_ = -1;
+    pending_ = 0;
+    ++feature_revision_;
+    apply_bounds();
+}
+
+void WorldManager::update(float player_x, float player_y) {
+    pending_ = 0;
+    if (!is_enabled()) {
+        return;
+    }
+    int ops = 0;
+    const float unload_distance = config_.load_radius + config_.unload_margin;
+
+    // A resident whose pack has a living member near the player is held
+    held_.assign(resident_.size(), 0);
+    if (!resident_.empty()) {
+        const float reach_sq = unload_distance * unload_distance;
+        for (int i = 0; i < wolves_->get_wolf_count(); ++i) {
+            const Wolf* wolf = wolves_->get_wolf(i);
+            if (wolf->pack_id == 0 || wolf->health <= 0.0f) {
+                continue;
+            }
+            const float dx = wolf->x.to_float() - player_x;
+            const float dy = wolf->y.to_float() - player_y;
+            if (dx * dx + dy * dy > reach_sq) {
+                continue;
+            }
+            for (size_t r = 0; r < resident_.size(); ++r) {
+                if (records_[resident_[r]].pack_id == wolf->pack_id) {
+                    held_[r] = 1;
+                }
+            }
+        }
+    }
+
+    // Page out first, so the chunks coming in have room
+    for (size_t r = 0; r < resident_.size() && ops < config_.page_budget;) {
+        const uint32_t chunk = resident_[r];
+        if (!held_[r] && chunk_distance(chunk, player_x, player_y) > unload_distance) {
+            page_out(chunk);  // Erases resident_[r]
+            held_.erase(held_.begin() + static_cast<std::ptrdiff_t>(r));
+            ++ops;
+        } else {
+            ++r;
+        }
+    }
+
+    // Then the nearest missing chunks in reach
+    const float size = config_.chunk_size;
+    const float reach = config_.load_radius;
+    const int32_t cx0 = std::max(0, static_cast<int32_t>(std::floor((player_x - reach) / size)));
+    const int32_t cy0 = std::max(0, static_cast<int32_t>(std::floor((player_y - reach) / size)));
+    const int32_t cx1 = std::min(config_.chunks_x - 1, static_cast<int32_t>(std::floor((player_x + reach) / size)));
+    const int32_t cy1 = std::min(config_.chunks_y - 1, static_cast<int32_t>(std::floor((player_y + reach) / size)));
+    candidates_.clear();
+    for (int32_t cy = cy0; cy <= cy1; ++cy) {
+        for (int32_t cx = cx0; cx <= cx1; ++cx) {
+            const uint32_t chunk = static_cast<uint32_t>(cy * config_.chunks_x + cx);
+            if (records_[chunk].resident) {
+                continue;
+            }
+            const float distance = chunk_distance(chunk, player_x, player_y);
+            if (distance <= reach) {
+                candidates_.push_back(Candidate{ distance, chunk });
+            }
+        }
+    }
+    std::sort(candidates_.begin(), candidates_.end(), [](const Candidate& a, const Candidate& b) {
+        return a.distance < b.distance || (a.distance == b.distance && a.chunk < b.chunk);
+    });
+    for (const Candidate& c : candidates_) {
+        if (ops >= config_.page_budget || static_cast<int32_t>(resident_.size()) >= MAX_RESIDENT_CHUNKS) {
+            ++pending_;
+            continue;
+        }
+        page_in(c.chunk);
+        ++ops;
+    }
+}
+
+float WorldManager::chunk_distance(uint32_t chunk, float x, float y) const {
+    const float size = config_.chunk_size;
+    const float x0 = static_cast<float>(chunk % static_cast<uint32_t>(config_.chunks_x)) * size;
+    const float y0 = static_cast<float>(chunk / static_cast<uint32_t>(config_.chunks_x)) * size;
+    const float dx = std::max(std::max(x0 - x, 0.0f), x - (x0 + size));
+    const float dy = std::max(std::max(y0 - y, 0.0f), y - (y0 + size));
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+void WorldManager::generate(uint32_t chunk, ChunkContent& out) const {
+    uint64_t rng = (static_cast<uint64_t>(config_.seed) << 32) ^ (chunk * 0x9E3779B1u);
+    splitmix64(rng);
+
+    const float size = config_.chunk_size;
+    const float x0 = static_cast<float>(chunk % static_cast<uint32_t>(config_.chunks_x)) * size;
+    const float y0 = static_cast<float>(chunk / static_cast<uint32_t>(config_.chunks_x)) * size;
+    const float centre_x = x0 + size * 0.5f;
+    const float centre_y = y0 + size * 0.5f;
+    const float span = 1.0f - 2.0f * FEATURE_MARGIN;
+
+    out.feature_count = 0;
+    const int wanted = static_cast<int>(splitmix64(rng) % (MAX_FEATURES_PER_CHUNK + 1));
+    for (int i = 0; i < wanted; ++i) {
+        TerrainFeature f;
+        f.type = static_cast<uint32_t>(splitmix64(rng) % 3);
+        f.x = x0 + size * (FEATURE_MARGIN + span * unit_float(rng));
+        f.y = y0 + size * (FEATURE_MARGIN + span * unit_float(rng));
+        f.chunk = chunk;
+        switch (static_cast<TerrainFeatureType>(f.type)) {
+            case TerrainFeatureType::Rock:
+                f.half_w = f.half_h = size * (0.03f + 0.04f * unit_float(rng));
+                break;
+            case TerrainFeatureType::Wall: {
+                const float length = size * (0.05f + 0.1f * unit_float(rng));
+                const bool along_x = (splitmix64(rng) & 1u) != 0;
+                f.half_w = along_x ? length : size * 0.02f;
+                f.half_h = along_x ? size * 0.02f : length;
+                break;
+            }
+            default:
+                f.half_w = f.half_h = size * (0.05f + 0.05f * unit_float(rng));
+                break;
+        }
+        // Drawn either way, so dropping one does not shift the others
+        const float dx = std::max(0.0f, std::abs(f.x - centre_x) - f.half_w);
+        const float dy = std::max(0.0f, std::abs(f.y - centre_y) - f.half_h);
+        if (dx * dx + dy * dy < (CLEAR_RADIUS * size) * (CLEAR_RADIUS * size)) {
+            continue;
+        }
+        out.features[out.feature_count++] = f;
+    }
+
+    out.pack_x = centre_x;
+    out.pack_y = centre_y;
+    out.pack_size = 0;
+    if (static_cast<int32_t>(chunk) != home_chunk_ && splitmix64(rng) % 100 < PACK_CHANCE_PERCENT) {
+        out.pack_size = 2 + static_cast<int>(splitmix64(rng) % (MAX_PACK_SIZE - 1));
+    }
+}
+
+void WorldManager::page_in(uint32_t chunk) {
+    ChunkContent content;
+    generate(chunk, content);
+    WorldChunkRecord& record = records_[chunk];
+
+    for (int i = 0; i < content.feature_count; ++i) {
+        const TerrainFeature& f = content.features[i];
+        features_.push_back(f);
+        if (f.type == static_cast<uint32_t>(TerrainFeatureType::Brush)) {
+            continue;
+        }
+        StaticCollider collider{};
+        collider.x = Fixed::from_float(f.x);
+        collider.y = Fixed::from_float(f.y);
+        collider.half_x = Fixed::from_float(f.half_w);
+        collider.half_y = Fixed::from_float(f.half_h);
+        collider.owner = chunk + 1;
+        collider.layers = BLOCKED_LAYERS;
+        collider.shape = f.type == static_cast<uint32_t>(TerrainFeatureType::Rock) ? StaticShape::Circle : StaticShape::Box;
+        physics_->add_static_collider(collider);
+    }
+
+    if (!record.visited) {
+        record.visited = 1;
+        record.pack_alive = static_cast<uint8_t>(content.pack_size);
+    }
+    if (record.pack_alive > 0) {
+        std::vector<uint32_t> ids;
+        ids.reserve(record.pack_alive);
+        const float spread = PACK_SPREAD * config_.chunk_size;
+        for (int m = 0; m < record.pack_alive; ++m) {
+            const WolfType type = (m == 0 && content.pack_size >= 3) ? WolfType::Alpha : WolfType::Normal;
+            ids.push_back(wolves_->spawn_wolf(content.pack_x + PACK_OFFSETS[m][0] * spread,
+                                              content.pack_y + PACK_OFFSETS[m][1] * spread, type));
+        }
+        record.pack_id = wolves_->create_pack(ids);
+    }
+
+    record.resident = 1;
+    resident_.push_back(chunk);
+    ++page_ins_;
+    ++feature_revision_;
+}
+
+void WorldManager::page_out(uint32_t chunk) {
+    WorldChunkRecord& record = records_[chunk];
+    if (record.pack_id != 0) {
+        // A pack cleared from WolfManager by other means counts as wiped out
+        const int alive = wolves_->remove_pack(record.pack_id);
+        record.pack_alive = static_cast<uint8_t>(std::min(alive, static_cast<int>(MAX_PACK_SIZE)));
+        record.pack_id = 0;
+    }
+    physics_->remove_static_colliders(chunk + 1);
+    features_.erase(std::remove_if(features_.begin(), features_.end(),
+                                   [chunk](const TerrainFeature& f) { return f.chunk == chunk; }),
+                    features_.end());
+    record.resident = 0;
+    resident_.erase(std::find(resident_.begin(), resident_.end(), chunk));
+    ++page_outs_;
+    ++feature_revision_;
+}
+
+void WorldManager::apply_bounds() {
+    if (is_enabled()) {
+        player_->set_world_bounds(0.0f, 0.0f, get_width(), get_height());
+        physics_->set_world_bounds(0.0f, 0.0f, get_width(), get_height());
+    } else {
+        const PhysicsConfig defaults;
+        player_->set_world_bounds(0.0f, 0.0f, 1.0f, 1.0f);
+        physics_->set_world_bounds(defaults.world_min_x.to_float(), defaults.world_min_y.to_float(),
+                                   defaults.world_max_x.to_float(), defaults.world_max_y.to_float());
+    }
+}
+
+int WorldManager::get_resident_chunk(int index) const {
+    if (index < 0 || index >= static_cast<int>(resident_.size())) {
+        return -1;
+    }
+    return static_cast<int>(resident_[static_cast<size_t>(index)]);
+}
+
+int WorldManager::get_chunk_state(int cx, int cy) const {
+    if (!is_enabled() || cx < 0 || cy < 0 || cx >= config_.chunks_x || cy >= config_.chunks_y) {
+        return -1;
+    }
+    const WorldChunkRecord& record = records_[static_cast<size_t>(cy * config_.chunks_x + cx)];
+    return (record.resident ? 1 : 0) | (record.visited ? 2 : 0) | (record.pack_alive > 0 ? 4 : 0);
+}
+
+void WorldManager::save_state(SnapshotWriter& w) const {
+    w.write(config_);
+    w.write_vector(records_);
+    w.write_vector(resident_);
+    w.write_vector(features_);
+    w.write(home_chunk_);
+    w.write(page_ins_);
+    w.write(page_outs_);
+}
+
+bool WorldManager::load_state(SnapshotReader& r) {
+    const bool ok = r.read(config_) && r.read_vector(records_) && r.read_vector(resident_) &&
+        r.read_vector(features_) && r.read(home_chunk_) && r.read(page_ins_) && r.read(page_outs_);
+    pending_ = 0;
+    ++feature_revision_;
+    // Physics bounds came back with the physics config; the player's are not saved
+    if (player_) {
+        if (is_enabled()) {
+            player_->set_world_bounds(0.0f, 0.0f, get_width(), get_height());
+        } else {
+            player_->set_world_bounds(0.0f, 0.0f, 1.0f, 1.0f);
+        }
+    }
+    return ok;
+}
+
+void WorldManager::hash_state(FrameHasher& h) const {
+    h.add(config_);
+    h.add(static_cast<uint32_t>(records_.size()));
+    h.add_bytes(records_.data(), records_.size() * sizeof(WorldChunkRecord));
+    h.add(static_cast<uint32_t>(resident_.size()));
+    h.add_bytes(resident_.data(), resident_.size() * sizeof(uint32_t));
+}
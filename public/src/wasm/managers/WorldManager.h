@@ -0,0 +1,153 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "../physics/SnapshotStream.h"
+#include "../physics/FrameHash.h"
+
+class PhysicsManager;
+class WolfManager;
+class PlayerManager;
+
+// Streamed map shape. chunks_x or chunks_y of 0 means no streamed world:
+// the game keeps its single unit room.
+struct WorldMapConfig {
+    int32_t chunks_x = 0;
+    int32_t chunks_y = 0;
+    float chunk_size = 1.0f;     // World units per chunk side; the map spans [0, chunks * size)
+    float load_radius = 1.0f;    // Chunks closer to the player than this page in
+    float unload_margin = 0.5f;  // Extra distance before a chunk pages out again
+    int32_t page_budget = 2;     // Chunk page-ins plus page-outs per update
+    uint32_t seed = 1;           // Chunk content is generated from (seed, chunk)
+};
+
+enum class TerrainFeatureType : uint32_t {
+    Rock = 0,   // Circle collider
+    Wall = 1,   // Box collider
+    Brush = 2   // Decoration only, no collider
+};
+
+// One terrain feature of a resident chunk, exported as is (24-byte stride)
+struct TerrainFeature {
+    float x, y;            // Centre
+    float half_w, half_h;  // Box half extents; a circle's radius is half_w
+    uint32_t type;         // TerrainFeatureType
+    uint32_t chunk;        // Chunk index (cy * chunks_x + cx)
+};
+static_assert(sizeof(TerrainFeature) == 24, "TerrainFeature is part of the JS ABI");
+
+// What a chunk keeps while it is not resident
+struct WorldChunkRecord {
+    uint32_t pack_id = 0;    // Live pack while resident, 0 otherwise
+    uint8_t resident = 0;
+    uint8_t visited = 0;     // Paged in at least once
+    uint8_t pack_alive = 0;  // Members the chunk's pack still has
+    uint8_t reserved = 0;
+};
+
+/**
+ * WorldManager - a large map streamed in chunks around the player
+ *
+ * The map is a grid of chunks, each with generated content: terrain
+ * features (rocks and walls become static colliders, brush is
+ * decoration) and sometimes a dormant wolf pack. Content depends only on
+ * the map seed and the chunk, so a chunk can be dropped and generated again
+ * identically. Only chunks near the player are resident:
+ *
+ * - update pages out residents farther than load_radius + unload_margin,
+ *   then pages in the nearest missing chunks within load_radius. Paging is
+ *   budgeted (page_budget operations per update), so crossing into a new
+ *   area spreads over a few updates instead of one long frame.
+ * - The resident set never exceeds MAX_RESIDENT_CHUNKS; chunks past the
+ *   cap wait (get_pending_chunks) until a resident pages out.
+ * - A resident pack is ordinary wolves in WolfManager. On page-out the
+ *   pack is removed and only its survivor count stays in the chunk record;
+ *   the next page-in spawns that many fresh wolves. A chunk whose pack has
+ *   a living member near the player stays resident.
+ * - Colliders go to PhysicsManager's static geometry tagged with the chunk,
+ *   never to the dynamic broadphase.
+ *
+ * Chunk records, residency and the features of resident chunks are
+ * simulation state: saved by GameCoordinator and hashed into the frame
+ * salt while a world is configured.
+ */
+class WorldManager {
+public:
+    static constexpr int32_t MAX_CHUNKS = 64 * 64;
+    static constexpr int32_t MAX_RESIDENT_CHUNKS = 16;
+    static constexpr int32_t MAX_FEATURES_PER_CHUNK = 4;
+    static constexpr int32_t MAX_PACK_SIZE = 4;
+
+    void initialize(PhysicsManager* physics, WolfManager* wolves, PlayerManager* player);
+
+    // Replaces any world already configured. The chunk containing
+    // (player_x, player_y) never has a pack. False (nothing changes) for a
+    // map with no chunks, more than MAX_CHUNKS, or a non-positive size.
+    bool configure(const WorldMapConfig& config, float player_x, float player_y);
+    // Pages every chunk out and returns to the unit room
+    void clear();
+    bool is_enabled() const { return config_.chunks_x > 0 && config_.chunks_y > 0; }
+    const WorldMapConfig& get_config() const { return config_; }
+    void set_page_budget(int budget) { config_.page_budget = budget > 0 ? budget : 1; }
+
+    // Streams chunks around the player
+    void update(float player_x, float player_y);
+
+    // Rollback snapshots (see GameCoordinator::save_state). load_state also
+    // re-applies the map's player bounds, which PlayerManager does not save.
+    void save_state(SnapshotWriter& w) const;
+    bool load_state(SnapshotReader& r);
+    void hash_state(FrameHasher& h) const;
+
+    // Queries (for WASM exports)
+    float get_width() const { return is_enabled() ? static_cast<float>(config_.chunks_x) * config_.chunk_size : 1.0f; }
+    float get_height() const { return is_enabled() ? static_cast<float>(config_.chunks_y) * config_.chunk_size : 1.0f; }
+    int get_resident_count() const { return static_cast<int>(resident_.size()); }
+    int get_resident_chunk(int index) const;
+    // Bit 0 resident, bit 1 visited, bit 2 its pack has survivors; -1 off the map
+    int get_chunk_state(int cx, int cy) const;
+    uint32_t get_page_ins() const { return page_ins_; }    // Since configure
+    uint32_t get_page_outs() const { return page_outs_; }
+    int get_pending_chunks() const { return pending_; }    // Wanted but deferred last update
+
+    // Terrain of the resident chunks, in page-in order
+    const std::vector<TerrainFeature>& get_features() const { return features_; }
+    // Bumped whenever features change, so readers know to re-read the buffer
+    uint32_t get_feature_revision() const { return feature_revision_; }
+
+private:
+    PhysicsManager* physics_ = nullptr;
+    WolfManager* wolves_ = nullptr;
+    PlayerManager* player_ = nullptr;
+
+    WorldMapConfig config_;
+    std::vector<WorldChunkRecord> records_;  // chunks_x * chunks_y
+    std::vector<uint32_t> resident_;         // Chunk indices, in page-in order
+    std::vector<TerrainFeature> features_;
+    int32_t home_chunk_ = -1;                // Where the player was at configure
+    uint32_t page_ins_ = 0;
+    uint32_t page_outs_ = 0;
+    uint32_t feature_revision_ = 0;
+    int pending_ = 0;
+
+    // Generated chunk content (never stored: regenerated on each page-in)
+    struct ChunkContent {
+        TerrainFeature features[MAX_FEATURES_PER_CHUNK];
+        int feature_count = 0;
+        float pack_x = 0.0f, pack_y = 0.0f;
+        int pack_size = 0;  // 0 = no pack
+    };
+    void generate(uint32_t chunk, ChunkContent& out) const;
+
+    // Per-update scratch
+    struct Candidate {
+        float distance;
+        uint32_t chunk;
+    };
+    std::vector<Candidate> candidates_;
+    std::vector<uint8_t> held_;
+
+    float chunk_distance(uint32_t chunk, float x, float y) const;
+    void page_in(uint32_t chunk);
+    void page_out(uint32_t chunk);
+    void apply_bounds();
+};
@@ -1,13 +1,16 @@
 #include "../WolfManager.h"
 #include "../coordinators/GameCoordinator.h"
 #include "../physics/PhysicsManager.h"
+#include "../physics/FixedTrig.h"
 #include "WolfConstants.h"
+#include "../../BalanceTable.h"
 #include <cmath>
 #include <algorithm>
 
 using namespace wolves::constants;
-void WolfManager::update_wolf_state_machine(Wolf& wolf, float delta_time) {
+void WolfManager::decide_wolf_state(Wolf& wolf, float delta_time) {
     wolf.state_timer -= delta_time;
+    const WolfState previous_state = wolf.state;
     
     // Check for interrupt conditions first (higher priority than timer)
     WolfState interrupt_state;
@@ -33,35 +36,67 @@ void WolfManager::update_wolf_state_machine(Wolf& wolf, float delta_time) {
         // Reset decision timer each time we evaluate
         wolf.decision_timer = wolf.decision_interval;
     }
+    if (perception_.valid() && wolf.state != previous_state) {
+        perception_.on_state_change(previous_state, wolf.state);
+    }
+}
+
+const WolfStateTable& WolfManager::state_table() const {
+    if (!state_table_.is_current()) {
+        state_table_.rebuild();
+    }
+    return state_table_;
+}
+
+void WolfManager::run_state_behaviors() {
+    using Behavior = void (WolfManager::*)(Wolf&, float);
+    // Indexed by WolfState; states without a behavior hold their motion
+    static constexpr Behavior BEHAVIORS[WOLF_STATE_COUNT] = {
+        &WolfManager::update_idle_behavior,      // Idle
+        &WolfManager::update_patrol_behavior,    // Patrol
+        nullptr,                                 // Investigate
+        &WolfManager::update_alert_behavior,     // Alert
+        &WolfManager::update_approach_behavior,  // Approach
+        &WolfManager::update_strafe_behavior,    // Strafe
+        &WolfManager::update_attack_behavior,    // Attack
+        &WolfManager::update_retreat_behavior,   // Retreat
+        &WolfManager::update_recover_behavior,   // Recover
+        nullptr,                                 // Flee
+        nullptr,                                 // Ambush
+        nullptr                                  // Flank
+    };
     
-    // Execute current state behavior
-    switch (wolf.state) {
-        case WolfState::Idle:
-            update_idle_behavior(wolf, delta_time);
-            break;
-        case WolfState::Patrol:
-            update_patrol_behavior(wolf, delta_time);
-            break;
-        case WolfState::Alert:
-            update_alert_behavior(wolf, delta_time);
-            break;
-        case WolfState::Approach:
-            update_approach_behavior(wolf, delta_time);
-            break;
-        case WolfState::Strafe:
-            update_strafe_behavior(wolf, delta_time);
-            break;
-        case WolfState::Attack:
-            update_attack_behavior(wolf, delta_time);
-            break;
-        case WolfState::Retreat:
-            update_retreat_behavior(wolf, delta_time);
-            break;
-        case WolfState::Recover:
-            update_recover_behavior(wolf, delta_time);
-            break;
-        default:
-            break;
+    // Counting sort of the due wolves by state (stable, so each bucket keeps wolf order)
+    uint32_t* start = state_bucket_start_;
+    std::fill(start, start + WOLF_STATE_COUNT + 1, 0u);
+    for (uint32_t index : due_wolves_) {
+        const int state = static_cast<int>(wolves_[index].state);
+        if (state < WOLF_STATE_COUNT) {
+            start[state + 1]++;
+        }
+    }
+    for (int s = 0; s < WOLF_STATE_COUNT; ++s) {
+        start[s + 1] += start[s];
+    }
+    state_buckets_.resize(start[WOLF_STATE_COUNT]);
+    uint32_t cursor[WOLF_STATE_COUNT];
+    std::copy(start, start + WOLF_STATE_COUNT, cursor);
+    for (uint32_t k = 0; k < due_wolves_.size(); ++k) {
+        const int state = static_cast<int>(wolves_[due_wolves_[k]].state);
+        if (state < WOLF_STATE_COUNT) {
+            state_buckets_[cursor[state]++] = k;
+        }
+    }
+    
+    for (int s = 0; s < WOLF_STATE_COUNT; ++s) {
+        const Behavior behavior = BEHAVIORS[s];
+        if (!behavior) {
+            continue;
+        }
+        for (uint32_t b = start[s]; b < start[s + 1]; ++b) {
+            const uint32_t k = state_buckets_[b];
+            (this->*behavior)(wolves_[due_wolves_[k]], due_dt_[k]);
+        }
     }
 }
 
@@ -87,26 +122,11 @@ WolfState WolfManager::evaluate_best_state(const Wolf& wolf) const {
     
     // Default behavior (for Normal type or when no preference)
     // Hysteresis thresholds
-    #ifdef BAL_WOLF_ATTACK_ENTER_MULT
-    float attack_enter = wolf.attack_range * BAL_WOLF_ATTACK_ENTER_MULT;
-    #else
-    float attack_enter = wolf.attack_range * 1.00f;
-    #endif
-    #ifdef BAL_WOLF_ATTACK_EXIT_MULT
-    float attack_exit  = wolf.attack_range * BAL_WOLF_ATTACK_EXIT_MULT;
-    #else
-    float attack_exit  = wolf.attack_range * 1.15f;
-    #endif
-    #ifdef BAL_WOLF_APPROACH_ENTER_MULT
-    float approach_enter = wolf.detection_range * BAL_WOLF_APPROACH_ENTER_MULT;
-    #else
-    float approach_enter = wolf.detection_range * 0.70f;
-    #endif
-    #ifdef BAL_WOLF_APPROACH_EXIT_MULT
-    float approach_exit  = wolf.detection_range * BAL_WOLF_APPROACH_EXIT_MULT;
-    #else
-    float approach_exit  = wolf.detection_range * 0.85f;
-    #endif
+    const WolfStateTable::Thresholds& rules = state_table().thresholds();
+    float attack_enter = wolf.attack_range * rules.attack_enter_mult;
+    float attack_exit  = wolf.attack_range * rules.attack_exit_mult;
+    float approach_enter = wolf.detection_range * rules.approach_enter_mult;
+    float approach_exit  = wolf.detection_range * rules.approach_exit_mult;
     
     // Prefer Attack only when within enter threshold and gating passes
     if (dist_to_player < attack_enter) {
@@ -133,53 +153,11 @@ WolfState WolfManager::evaluate_best_state(const Wolf& wolf) const {
 }
 
 float WolfManager::get_state_duration(WolfState state) const {
-    switch (state) {
-        case WolfState::Idle: return 2.0f;
-        case WolfState::Patrol: return 4.0f;
-        case WolfState::Alert: return 1.0f;
-        case WolfState::Approach: return 3.0f;
-        case WolfState::Strafe: return 2.0f;
-        case WolfState::Attack: return ATTACK_ANTICIPATION_TIME + ATTACK_EXECUTE_TIME + ATTACK_RECOVERY_TIME;
-        case WolfState::Retreat: return 2.0f;
-        case WolfState::Recover: return 1.0f;
-        default: return 1.0f;
-    }
+    return state_table().duration(state);
 }
 
 float WolfManager::get_state_duration_for(const Wolf& wolf, WolfState state) const {
-    float base = get_state_duration(state);
-    // Emotion multipliers
-    float mult = 1.0f;
-    switch (wolf.emotion) {
-        case EmotionalState::Confident:
-            #ifdef BAL_WOLF_CONFIDENT_RECOVER_MULT
-            if (state == WolfState::Recover) mult *= BAL_WOLF_CONFIDENT_RECOVER_MULT; // shorter recovery
-            #else
-            if (state == WolfState::Recover) mult *= 0.8f; // shorter recovery
-            #endif
-            break;
-        case EmotionalState::Fearful:
-            #ifdef BAL_WOLF_FEARFUL_STRAFE_MULT
-            if (state == WolfState::Strafe) mult *= BAL_WOLF_FEARFUL_STRAFE_MULT; // longer circling
-            #else
-            if (state == WolfState::Strafe) mult *= 1.3f; // longer circling
-            #endif
-            break;
-        case EmotionalState::Desperate:
-            #ifdef BAL_WOLF_DESPERATE_ATTACK_MULT
-            if (state == WolfState::Attack) mult *= BAL_WOLF_DESPERATE_ATTACK_MULT; // faster chain attacks
-            #else
-            if (state == WolfState::Attack) mult *= 0.9f; // faster chain attacks
-            #endif
-            break;
-        default:
-            break;
-    }
-    // Deterministic jitter based on wolf.id
-    uint32_t seed = 0x9e3779b9u ^ wolf.id * 0x85ebca6bu;
-    seed ^= (seed >> 16);
-    float jitter = static_cast<float>(seed % 100) / 1000.0f; // 0..0.099
-    return base * mult * (1.0f + jitter * 0.2f); // up to +2% jitter
+    return state_table().duration_for(wolf, state);
 }
 
 void WolfManager::on_state_enter(Wolf& wolf, WolfState new_state) {
@@ -212,14 +190,14 @@ void WolfManager::update_idle_behavior(Wolf& wolf, float delta_time) {
     wolf.vy *= f;
     
     // Subtle head movement
-    wolf.head_yaw = std::sin(wolf.state_timer * 2.0f) * 0.2f;
+    wolf.head_yaw = trig_sin(wolf.state_timer * 2.0f) * 0.2f;
 }
 
 void WolfManager::update_patrol_behavior(Wolf& wolf, float delta_time) {
     // Simple patrol: move in a circle or random direction
     float time = wolf.state_timer;
-    float patrol_x = std::cos(time) * 0.1f;
-    float patrol_y = std::sin(time) * 0.1f;
+    float patrol_x = trig_cos(time) * 0.1f;
+    float patrol_y = trig_sin(time) * 0.1f;
     
     wolf.facing_x = Fixed::from_float(patrol_x);
     wolf.facing_y = Fixed::from_float(patrol_y);
@@ -335,8 +313,9 @@ void WolfManager::update_retreat_behavior(Wolf& wolf, float delta_time) {
         return;
     }
     
-    float player_x = coordinator_->get_player_manager().get_x();
-    float player_y = coordinator_->get_player_manager().get_y();
+    const WolfPerception::Player player = perceive_player();
+    float player_x = player.x;
+    float player_y = player.y;
     
     Fixed dx = wolf.x - Fixed::from_float(player_x);
     Fixed dy = wolf.y - Fixed::from_float(player_y);
@@ -1,7 +1,5 @@
 #pragma once
 
-#include "../../generated/balance_data.h"
-
 namespace wolves {
 namespace constants {
     constexpr float PI = 3.14159265359f;
@@ -11,17 +9,19 @@ namespace constants {
     constexpr float ATTACK_EXECUTE_TIME = 0.2f;
     constexpr float ATTACK_RECOVERY_TIME = 0.3f;
 
-#ifdef BAL_WOLF_ATTACK_FACING_COS
-    constexpr float ATTACK_FACING_COS_THRESHOLD = BAL_WOLF_ATTACK_FACING_COS;
-#else
-    constexpr float ATTACK_FACING_COS_THRESHOLD = 0.5f;
-#endif
+    // AI level of detail (distances in normalized world units)
+    constexpr float AI_LOD_NEAR_RADIUS = 0.6f;   // Beyond any wolf's detection range
+    constexpr float AI_LOD_MID_RADIUS = 1.0f;
+    constexpr int AI_LOD_MID_INTERVAL = 2;
+    constexpr int AI_LOD_FAR_INTERVAL = 4;
+    constexpr int AI_LOD_DEFAULT_BUDGET = 64;    // Full Mid/Far updates per tick
+
+    // Pack events (fractions of max health a member's health falls through)
+    constexpr float PACK_WOUNDED_HEALTH = 0.5f;  // Plan is rescored
+    constexpr float PACK_CRITICAL_HEALTH = 0.2f; // Roles reassigned; too weak to lead
+    constexpr float PACK_PLAN_INTERVAL = 3.0f;   // Rescore anyway after this long without events
 
-#ifdef BAL_WOLF_DAMAGE_INTERRUPT_THRESHOLD
-    constexpr float DAMAGE_INTERRUPT_THRESHOLD = BAL_WOLF_DAMAGE_INTERRUPT_THRESHOLD;
-#else
-    constexpr float DAMAGE_INTERRUPT_THRESHOLD = 6.0f;
-#endif
+    // Tunables from data/balance live in BalanceTable: bal(BAL_WOLF_*)
 }
 }
 
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "WolfTypes.h"
+
+/**
+ * WolfNeighborGrid - per-frame uniform grid over wolf positions
+ *
+ * Rebuilt once per WolfManager::update with a counting sort into flat
+ * arrays (same layout as the physics SpatialHash), so rebuilding is O(N)
+ * and steady-state frames do not allocate. Queries return indices into
+ * the wolves vector the grid was built from; callers re-test exact
+ * distances against current positions. Positions are indexed at the start
+ * of the frame, so queries widen their search by `slack` to cover wolves
+ * that moved during the frame.
+ *
+ * Also keeps wolf indices grouped by pack_id for per-pack scans.
+ */
+class WolfNeighborGrid {
+public:
+    explicit WolfNeighborGrid(float cell_size = 0.15f, float slack = 0.05f)
+        : inv_cell_size_(1.0f / cell_size), slack_(slack) {}
+
+    void clear() {
+        cell_keys_.clear();
+        sorted_.clear();
+        bucket_start_.clear();
+        pack_order_.clear();
+        count_ = 0;
+    }
+
+    // Storage for builds of up to count wolves
+    void reserve(size_t count) {
+        uint32_t table_size = 16;
+        while (table_size < count * 2) table_size <<= 1;
+        cell_keys_.reserve(count);
+        sorted_.reserve(count);
+        pack_order_.reserve(count);
+        bucket_start_.reserve(table_size + 1);
+        cursor_.reserve(table_size);
+    }
+
+    void build(const std::vector<Wolf>& wolves) {
+        count_ = wolves.size();
+        cell_keys_.resize(count_);
+
+        uint32_t table_size = 16;
+        while (table_size < count_ * 2) table_size <<= 1;
+        mask_ = table_size - 1;
+
+        // Counting sort by bucket: count, prefix sum, scatter
+        bucket_start_.assign(table_size + 1, 0);
+        for (size_t i = 0; i < count_; ++i) {
+            CellKey& k = cell_keys_[i];
+            k.x = cell_coord(wolves[i].x.to_float());
+            k.y = cell_coord(wolves[i].y.to_float());
+            k.bucket = hash_cell(k.x, k.y);
+            bucket_start_[k.bucket + 1]++;
+        }
+        for (uint32_t b = 0; b < table_size; ++b) {
+            bucket_start_[b + 1] += bucket_start_[b];
+        }
+        sorted_.resize(count_);
+        cursor_.assign(bucket_start_.begin(), bucket_start_.end() - 1);
+        for (size_t i = 0; i < count_; ++i) {
+            sorted_[cursor_[cell_keys_[i].bucket]++] = static_cast<uint32_t>(i);
+        }
+
+        // Stable grouping by pack keeps per-pack iteration in wolves_ order
+        pack_order_.resize(count_);
+        for (size_t i = 0; i < count_; ++i) {
+            pack_order_[i] = PackEntry{ wolves[i].pack_id, static_cast<uint32_t>(i) };
+        }
+        std::sort(pack_order_.begin(), pack_order_.end(),
+            [](const PackEntry& a, const PackEntry& b) {
+                return a.pack_id != b.pack_id ? a.pack_id < b.pack_id : a.index < b.index;
+            });
+    }
+
+    size_t size() const { return count_; }
+
+    // Visit every indexed wolf whose cell overlaps the circle (x, y, radius + slack)
+    template <typename Fn>
+    void for_each_in_radius(float x, float y, float radius, Fn&& fn) const {
+        const float r = radius + slack_;
+        visit_cells(cell_coord(x - r), cell_coord(y - r), cell_coord(x + r), cell_coord(y + r), fn);
+    }
+
+    // Visit every indexed wolf whose cell may hold a point within radius + slack
+    // of the segment a->b. Walks the segment one cell row at a time, so it
+    // visits O(length / cell_size) cells rather than the whole bounding box
+    template <typename Fn>
+    void for_each_near_segment(float ax, float ay, float bx, float by, float radius, Fn&& fn) const {
+        const float r = radius + slack_;
+        const float cell = 1.0f / inv_cell_size_;
+        const float dx = bx - ax;
+        const float dy = by - ay;
+        const int32_t y0 = cell_coord(std::min(ay, by) - r);
+        const int32_t y1 = cell_coord(std::max(ay, by) + r);
+        for (int32_t cy = y0; cy <= y1; ++cy) {
+            // A point in this row within r of the segment is within r of the
+            // part of the segment inside the row's band widened by r
+            float t0 = 0.0f;
+            float t1 = 1.0f;
+            if (dy != 0.0f) {
+                const float band_lo = static_cast<float>(cy) * cell - r;
+                const float band_hi = static_cast<float>(cy + 1) * cell + r;
+                t0 = (band_lo - ay) / dy;
+                t1 = (band_hi - ay) / dy;
+                if (t0 > t1) std::swap(t0, t1);
+                t0 = std::min(1.0f, std::max(0.0f, t0));
+                t1 = std::min(1.0f, std::max(0.0f, t1));
+            }
+            const float xa = ax + dx * t0;
+            const float xb = ax + dx * t1;
+            visit_cells(cell_coord(std::min(xa, xb) - r), cy, cell_coord(std::max(xa, xb) + r), cy, fn);
+        }
+    }
+
+    // Visit every indexed wolf with the given pack_id, in wolves_ order
+    template <typename Fn>
+    void for_each_in_pack(uint32_t pack_id, Fn&& fn) const {
+        auto it = std::lower_bound(pack_order_.begin(), pack_order_.end(), pack_id,
+            [](const PackEntry& e, uint32_t id) { return e.pack_id < id; });
+        for (; it != pack_order_.end() && it->pack_id == pack_id; ++it) {
+            fn(static_cast<int>(it->index));
+        }
+    }
+
+private:
+    struct CellKey {
+        int32_t x;
+        int32_t y;
+        uint32_t bucket;
+    };
+
+    struct PackEntry {
+        uint32_t pack_id;
+        uint32_t index;
+    };
+
+    int32_t cell_coord(float v) const {
+        return static_cast<int32_t>(std::floor(v * inv_cell_size_));
+    }
+
+    uint32_t hash_cell(int32_t x, int32_t y) const {
+        return ((static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u)) & mask_;
+    }
+
+    template <typename Fn>
+    void visit_cells(int32_t x0, int32_t y0, int32_t x1, int32_t y1, Fn& fn) const {
+        if (count_ == 0) return;
+        for (int32_t cy = y0; cy <= y1; ++cy) {
+            for (int32_t cx = x0; cx <= x1; ++cx) {
+                // Exact key match filters wolves from other cells sharing the bucket
+                const uint32_t b = hash_cell(cx, cy);
+                for (uint32_t j = bucket_start_[b]; j < bucket_start_[b + 1]; ++j) {
+                    const uint32_t index = sorted_[j];
+                    if (cell_keys_[index].x == cx && cell_keys_[index].y == cy) {
+                        fn(static_cast<int>(index));
+                    }
+                }
+            }
+        }
+    }
+
+    float inv_cell_size_;
+    float slack_;
+    size_t count_ = 0;
+    uint32_t mask_ = 0;
+    std::vector<CellKey> cell_keys_;
+    std::vector<uint32_t> sorted_;
+    std::vector<uint32_t> bucket_start_;
+    std::vector<uint32_t> cursor_;
+    std::vector<PackEntry> pack_order_;
+};
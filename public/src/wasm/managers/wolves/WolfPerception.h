@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "WolfTypes.h"
+#include "WolfNeighborGrid.h"
+
+/**
+ * WolfPerception - per-frame snapshot of what the wolves know about the player
+ *
+ * Built once at the start of WolfManager::update: the player's position,
+ * velocity and facing, the number of attacking wolves, and per-wolf
+ * distance and unit bearing to the player in flat arrays indexed like the
+ * wolves vector. Decision code reads it instead of going through the
+ * coordinator and recomputing a square root for every check.
+ *
+ * A wolf's entry is refreshed after its physics sync and the attacker
+ * count follows state machine transitions, so reads later in the frame
+ * match what a live query would return (same float expressions). Pack
+ * centroids are taken after all wolves have moved, before pack plans run.
+ * Outside update the snapshot is invalid and callers query live state.
+ */
+class WolfPerception {
+public:
+    struct Player {
+        float x = 0.0f;
+        float y = 0.0f;
+        float vx = 0.0f;
+        float vy = 0.0f;
+        float facing_x = 1.0f;
+        float facing_y = 0.0f;
+    };
+
+    void begin(const Player& player, const std::vector<Wolf>& wolves) {
+        player_ = player;
+        const size_t count = wolves.size();
+        distance_.resize(count);
+        bearing_x_.resize(count);
+        bearing_y_.resize(count);
+        attackers_ = 0;
+        for (size_t i = 0; i < count; ++i) {
+            refresh(i, wolves[i]);
+            if (wolves[i].state == WolfState::Attack) {
+                attackers_++;
+            }
+        }
+        pack_center_x_.clear();
+        pack_center_y_.clear();
+        pack_members_.clear();
+        valid_ = true;
+    }
+
+    void end() { valid_ = false; }
+
+    void reserve(size_t wolves, size_t packs) {
+        distance_.reserve(wolves);
+        bearing_x_.reserve(wolves);
+        bearing_y_.reserve(wolves);
+        pack_center_x_.reserve(packs);
+        pack_center_y_.reserve(packs);
+        pack_members_.reserve(packs);
+    }
+
+    // Re-reads one wolf's position (after it moved this frame)
+    void refresh(size_t index, const Wolf& wolf) {
+        const float dx = player_.x - wolf.x.to_float();
+        const float dy = player_.y - wolf.y.to_float();
+        const float dist = std::sqrt(dx * dx + dy * dy);
+        distance_[index] = dist;
+        bearing_x_[index] = dist > 0.0f ? dx / dist : 0.0f;
+        bearing_y_[index] = dist > 0.0f ? dy / dist : 0.0f;
+    }
+
+    void on_state_change(WolfState from, WolfState to) {
+        attackers_ += (to == WolfState::Attack) - (from == WolfState::Attack);
+    }
+
+    // Centroid of each pack's members, indexed like the packs vector
+    void update_pack_centers(const std::vector<Pack>& packs, const std::vector<Wolf>& wolves,
+                             const WolfNeighborGrid& grid) {
+        pack_center_x_.assign(packs.size(), 0.0f);
+        pack_center_y_.assign(packs.size(), 0.0f);
+        pack_members_.assign(packs.size(), 0);
+        for (size_t p = 0; p < packs.size(); ++p) {
+            grid.for_each_in_pack(packs[p].pack_id, [&](int index) {
+                pack_center_x_[p] += wolves[index].x.to_float();
+                pack_center_y_[p] += wolves[index].y.to_float();
+                pack_members_[p]++;
+            });
+            if (pack_members_[p] > 0) {
+                pack_center_x_[p] /= pack_members_[p];
+                pack_center_y_[p] /= pack_members_[p];
+            }
+        }
+    }
+
+    bool valid() const { return valid_; }
+    size_t size() const { return distance_.size(); }
+    const Player& player() const { return player_; }
+    int attackers() const { return attackers_; }
+
+    float distance(size_t index) const { return distance_[index]; }
+    // Cosine between the wolf's facing and its bearing to the player (1 when on top of it)
+    float facing_dot(size_t index, const Wolf& wolf) const {
+        if (distance_[index] <= 0.0f) {
+            return 1.0f;
+        }
+        return bearing_x_[index] * wolf.facing_x.to_float() + bearing_y_[index] * wolf.facing_y.to_float();
+    }
+
+    bool has_pack_center(size_t pack_index) const {
+        return pack_index < pack_members_.size() && pack_members_[pack_index] > 0;
+    }
+    float pack_center_x(size_t pack_index) const { return pack_center_x_[pack_index]; }
+    float pack_center_y(size_t pack_index) const { return pack_center_y_[pack_index]; }
+
+private:
+    Player player_;
+    int attackers_ = 0;
+    bool valid_ = false;
+
+    std::vector<float> distance_;
+    std::vector<float> bearing_x_;
+    std::vector<float> bearing_y_;
+
+    std::vector<float> pack_center_x_;
+    std::vector<float> pack_center_y_;
+    std::vector<int> pack_members_;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * WolfRenderState - packed per-wolf record for bulk JS reads
+ *
+ * Every field is a 32-bit word so one record maps onto both a Uint32Array
+ * and a Float32Array view (the first 8 words are integers, the rest
+ * floats). Records are WOLF_RENDER_STATE_STRIDE bytes apart. Any layout
+ * change must bump WOLF_RENDER_STATE_VERSION; JS checks it before reading.
+ *
+ * Word layout (v1):
+ *   u32  0 id            1 type         2 state        3 emotion
+ *   u32  4 pack_role     5 pack_id      6 attack_type  7 ai_tier
+ *   f32  8 x             9 y           10 vx          11 vy
+ *   f32 12 facing_x     13 facing_y    14 health      15 max_health
+ *   f32 16 stamina      17 body_stretch 18 head_pitch 19 head_yaw
+ *   f32 20 tail_wag     21 body_bob    22 ear_rotation[0] 23 ear_rotation[1]
+ *   f32 24..31 leg_positions[4][2] as x0, y0, x1, y1, ...
+ */
+constexpr std::uint32_t WOLF_RENDER_STATE_VERSION = 1;
+
+struct WolfRenderState {
+    std::uint32_t id;
+    std::uint32_t type;
+    std::uint32_t state;
+    std::uint32_t emotion;
+    std::uint32_t pack_role;
+    std::uint32_t pack_id;
+    std::uint32_t attack_type;
+    std::uint32_t ai_tier;
+
+    float x;
+    float y;
+    float vx;
+    float vy;
+    float facing_x;
+    float facing_y;
+    float health;
+    float max_health;
+    float stamina;
+    float body_stretch;
+    float head_pitch;
+    float head_yaw;
+    float tail_wag;
+    float body_bob;
+    float ear_rotation[2];
+    float leg_positions[4][2];
+};
+
+constexpr std::uint32_t WOLF_RENDER_STATE_STRIDE = sizeof(WolfRenderState);
+static_assert(WOLF_RENDER_STATE_STRIDE == 32 * 4, "WolfRenderState layout is part of the JS ABI");
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "WolfTypes.h"
+#include "WolfConstants.h"
+#include "../../BalanceTable.h"
+
+constexpr int WOLF_STATE_COUNT = static_cast<int>(WolfState::Flank) + 1;
+constexpr int WOLF_EMOTION_COUNT = static_cast<int>(EmotionalState::Frustrated) + 1;
+
+/**
+ * WolfStateTable - state durations and transition thresholds in one block
+ *
+ * Every number the wolf state machine reads lives here. That covers base
+ * durations, emotion multipliers ((state, emotion) pairs without a rule
+ * hold 1.0) and the hysteresis and gating thresholds of the transition
+ * rules. The table is built from the active balance table and rebuilt
+ * when balance_commit publishes a different one. Decisions therefore
+ * index a small array instead of branching on emotion and reloading
+ * balance keys.
+ */
+class WolfStateTable {
+public:
+    struct Thresholds {
+        float attack_enter_mult = 1.0f;     // * attack_range: enter Attack
+        float attack_exit_mult = 1.0f;      // * attack_range: keep strafing while attacking
+        float approach_enter_mult = 1.0f;   // * detection_range: enter Approach
+        float approach_exit_mult = 1.0f;    // * detection_range: keep approaching
+        float attack_facing_cos = 0.0f;     // Minimum facing dot to start an attack
+        float damage_interrupt = 0.0f;      // Damage taken in Attack that forces Recover
+    };
+
+    bool is_current() const { return source_ == &balance_active_table(); }
+
+    void rebuild() {
+        using namespace wolves::constants;
+        source_ = &balance_active_table();
+        for (int s = 0; s < WOLF_STATE_COUNT; ++s) {
+            duration_[s] = 1.0f;
+            for (int e = 0; e < WOLF_EMOTION_COUNT; ++e) {
+                emotion_mult_[s][e] = 1.0f;
+            }
+        }
+        set_duration(WolfState::Idle, 2.0f);
+        set_duration(WolfState::Patrol, 4.0f);
+        set_duration(WolfState::Alert, 1.0f);
+        set_duration(WolfState::Approach, 3.0f);
+        set_duration(WolfState::Strafe, 2.0f);
+        set_duration(WolfState::Attack, ATTACK_ANTICIPATION_TIME + ATTACK_EXECUTE_TIME + ATTACK_RECOVERY_TIME);
+        set_duration(WolfState::Retreat, 2.0f);
+        set_duration(WolfState::Recover, 1.0f);
+
+        set_emotion_mult(WolfState::Recover, EmotionalState::Confident, bal(BAL_WOLF_CONFIDENT_RECOVER_MULT));  // Shorter recovery
+        set_emotion_mult(WolfState::Strafe, EmotionalState::Fearful, bal(BAL_WOLF_FEARFUL_STRAFE_MULT));       // Longer circling
+        set_emotion_mult(WolfState::Attack, EmotionalState::Desperate, bal(BAL_WOLF_DESPERATE_ATTACK_MULT));   // Faster chain attacks
+
+        thresholds_.attack_enter_mult = bal(BAL_WOLF_ATTACK_ENTER_MULT);
+        thresholds_.attack_exit_mult = bal(BAL_WOLF_ATTACK_EXIT_MULT);
+        thresholds_.approach_enter_mult = bal(BAL_WOLF_APPROACH_ENTER_MULT);
+        thresholds_.approach_exit_mult = bal(BAL_WOLF_APPROACH_EXIT_MULT);
+        thresholds_.attack_facing_cos = bal(BAL_WOLF_ATTACK_FACING_COS);
+        thresholds_.damage_interrupt = bal(BAL_WOLF_DAMAGE_INTERRUPT_THRESHOLD);
+    }
+
+    float duration(WolfState state) const {
+        const int s = static_cast<int>(state);
+        return s < WOLF_STATE_COUNT ? duration_[s] : 1.0f;
+    }
+
+    // Emotion-adjusted duration with a deterministic per-wolf jitter (up to +2%)
+    float duration_for(const Wolf& wolf, WolfState state) const {
+        const int s = static_cast<int>(state);
+        const int e = static_cast<int>(wolf.emotion);
+        const float mult = (s < WOLF_STATE_COUNT && e < WOLF_EMOTION_COUNT) ? emotion_mult_[s][e] : 1.0f;
+        uint32_t seed = 0x9e3779b9u ^ wolf.id * 0x85ebca6bu;
+        seed ^= (seed >> 16);
+        const float jitter = static_cast<float>(seed % 100) / 1000.0f;  // 0..0.099
+        return duration(state) * mult * (1.0f + jitter * 0.2f);
+    }
+
+    const Thresholds& thresholds() const { return thresholds_; }
+
+private:
+    void set_duration(WolfState state, float seconds) {
+        duration_[static_cast<int>(state)] = seconds;
+    }
+    void set_emotion_mult(WolfState state, EmotionalState emotion, float mult) {
+        emotion_mult_[static_cast<int>(state)][static_cast<int>(emotion)] = mult;
+    }
+
+    const BalanceTable* source_ = nullptr;
+    float duration_[WOLF_STATE_COUNT] = {};
+    float emotion_mult_[WOLF_STATE_COUNT][WOLF_EMOTION_COUNT] = {};
+    Thresholds thresholds_;
+};
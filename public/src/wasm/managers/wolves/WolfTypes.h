@@ -55,6 +55,13 @@ enum class PackPlan : std::uint8_t {
     Regroup = 7
 };
 
+// AI level of detail: how often a wolf runs full decision updates
+enum class WolfAiTier : std::uint8_t {
+    Near = 0,   // Every tick
+    Mid = 1,    // Every AI_LOD_MID_INTERVAL ticks
+    Far = 2     // Every AI_LOD_FAR_INTERVAL ticks
+};
+
 enum class AttackType : std::uint8_t {
     StandardLunge = 0,
     QuickJab = 1,
@@ -129,8 +136,16 @@ struct Wolf {
 
     float decision_interval = 0.15f;
     float health_at_state_enter = 100.0f;
+
+    WolfAiTier ai_tier = WolfAiTier::Near;
+    std::uint16_t ai_frames_pending = 0;  // Ticks since the last full AI update
+    float ai_pending_dt = 0.0f;           // Time since the last full AI update
 };
 
+// Pack::dirty bits: work a pack event left for the next coordination pass
+constexpr std::uint8_t PACK_DIRTY_ROLES = 1 << 0;  // Membership change, or a member at critical health or dead
+constexpr std::uint8_t PACK_DIRTY_PLAN = 1 << 1;   // Any of the above, a member wounded or a member interrupt
+
 struct Pack {
     std::uint32_t pack_id = 0;
     std::vector<std::uint32_t> wolf_ids;
@@ -140,4 +155,8 @@ struct Pack {
 
     float pack_morale = 0.7f;
     int leader_index = -1;
+
+    std::uint16_t ai_frames_pending = 0;
+    float ai_pending_dt = 0.0f;
+    std::uint8_t dirty = 0;  // PACK_DIRTY_* bits
 };
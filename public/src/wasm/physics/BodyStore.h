@@ -0,0 +1,351 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PhysicsTypes.h"
+#include "SnapshotStream.h"
+#include "FrameHash.h"
+#include "EntityRegistry.h"
+
+/**
+ * BodyRefT - reference proxy to one body inside a BodyStore
+ *
+ * Exposes the same field names as RigidBody (as references into the
+ * store's arrays), so code written against `body.position` or
+ * `body.wake()` works unchanged. Cheap to copy; never owns data.
+ */
+template <bool Const>
+struct BodyRefT {
+    template <typename T>
+    using Ref = typename std::conditional<Const, const T&, T&>::type;
+
+    Ref<uint32_t> id;
+    Ref<BodyType> type;
+    Ref<FixedVector3> position;
+    Ref<FixedVector3> velocity;
+    Ref<FixedVector3> acceleration;
+    Ref<Fixed> mass;
+    Ref<Fixed> inverse_mass;
+    Ref<Fixed> friction;
+    Ref<Fixed> restitution;
+    Ref<Fixed> drag;
+    Ref<Fixed> radius;
+    Ref<uint32_t> collision_layer;
+    Ref<uint32_t> collision_mask;
+    Ref<bool> is_sleeping;
+    Ref<Fixed> sleep_threshold;
+    Ref<int32_t> sleep_timer_ticks;
+
+    bool should_simulate() const { return BodyRules::should_simulate(*this); }
+    bool should_collide() const { return BodyRules::should_collide(*this); }
+
+    template <bool C = Const, typename = typename std::enable_if<!C>::type>
+    void update_sleep_state(int32_t timestep_micros) const {
+        BodyRefT copy = *this;
+        BodyRules::update_sleep_state(copy, timestep_micros);
+    }
+
+    template <bool C = Const, typename = typename std::enable_if<!C>::type>
+    void wake() const {
+        BodyRefT copy = *this;
+        BodyRules::wake(copy);
+    }
+
+    // Gather a value copy (for snapshots and debugging)
+    RigidBody to_body() const {
+        RigidBody b;
+        b.id = id;
+        b.type = type;
+        b.position = position;
+        b.velocity = velocity;
+        b.acceleration = acceleration;
+        b.mass = mass;
+        b.inverse_mass = inverse_mass;
+        b.friction = friction;
+        b.restitution = restitution;
+        b.drag = drag;
+        b.radius = radius;
+        b.collision_layer = collision_layer;
+        b.collision_mask = collision_mask;
+        b.is_sleeping = is_sleeping;
+        b.sleep_threshold = sleep_threshold;
+        b.sleep_timer_ticks = sleep_timer_ticks;
+        return b;
+    }
+};
+
+using BodyRef = BodyRefT<false>;
+using ConstBodyRef = BodyRefT<true>;
+
+/**
+ * BodyStore - structure-of-arrays rigid body storage
+ *
+ * Each RigidBody field lives in its own contiguous array so per-step
+ * passes (integration, sleeping, world bounds) only stream the fields
+ * they touch. Bodies are addressed by dense index; removal swaps the
+ * last body into the hole, matching the previous vector semantics.
+ *
+ * previous_positions holds each body's position before the latest step
+ * for render interpolation. It is presentation-only: never hashed or
+ * snapshotted, and reset to the current positions on load.
+ */
+class BodyStore {
+public:
+    size_t size() const { return ids_.size(); }
+    bool empty() const { return ids_.empty(); }
+
+    void reserve(size_t n) {
+        ids_.reserve(n); types_.reserve(n);
+        positions_.reserve(n); velocities_.reserve(n); accelerations_.reserve(n);
+        previous_positions_.reserve(n);
+        masses_.reserve(n); inverse_masses_.reserve(n);
+        frictions_.reserve(n); restitutions_.reserve(n);
+        drags_.reserve(n); radii_.reserve(n);
+        layers_.reserve(n); masks_.reserve(n);
+        sleep_.reserve(n);
+    }
+    size_t capacity() const { return ids_.capacity(); }
+
+    void clear() {
+        ids_.clear(); types_.clear();
+        positions_.clear(); velocities_.clear(); accelerations_.clear();
+        previous_positions_.clear();
+        masses_.clear(); inverse_masses_.clear();
+        frictions_.clear(); restitutions_.clear();
+        drags_.clear(); radii_.clear();
+        layers_.clear(); masks_.clear();
+        sleep_.clear();
+    }
+
+    void push_back(const RigidBody& b) {
+        ids_.push_back(b.id);
+        types_.push_back(b.type);
+        positions_.push_back(b.position);
+        velocities_.push_back(b.velocity);
+        accelerations_.push_back(b.acceleration);
+        previous_positions_.push_back(b.position);
+        masses_.push_back(b.mass);
+        inverse_masses_.push_back(b.inverse_mass);
+        frictions_.push_back(b.friction);
+        restitutions_.push_back(b.restitution);
+        drags_.push_back(b.drag);
+        radii_.push_back(b.radius);
+        layers_.push_back(b.collision_layer);
+        masks_.push_back(b.collision_mask);
+        sleep_.push_back(SleepState{ b.is_sleeping, b.sleep_threshold, b.sleep_timer_ticks,
+                                     b.is_sleeping && b.type == BodyType::Dynamic ? b.id : INVALID_ENTITY });
+    }
+
+    // Exchange two bodies (PhysicsManager keeps awake bodies in a leading range)
+    void swap(size_t i, size_t j) {
+        if (i == j) return;
+        std::swap(ids_[i], ids_[j]); std::swap(types_[i], types_[j]);
+        std::swap(positions_[i], positions_[j]); std::swap(velocities_[i], velocities_[j]);
+        std::swap(accelerations_[i], accelerations_[j]);
+        std::swap(previous_positions_[i], previous_positions_[j]);
+        std::swap(masses_[i], masses_[j]); std::swap(inverse_masses_[i], inverse_masses_[j]);
+        std::swap(frictions_[i], frictions_[j]); std::swap(restitutions_[i], restitutions_[j]);
+        std::swap(drags_[i], drags_[j]); std::swap(radii_[i], radii_[j]);
+        std::swap(layers_[i], layers_[j]); std::swap(masks_[i], masks_[j]);
+        std::swap(sleep_[i], sleep_[j]);
+    }
+
+    // Move the last body into slot i and shrink by one
+    void swap_remove(size_t i) {
+        const size_t last = size() - 1;
+        if (i != last) {
+            ids_[i] = ids_[last]; types_[i] = types_[last];
+            positions_[i] = positions_[last]; velocities_[i] = velocities_[last];
+            accelerations_[i] = accelerations_[last];
+            previous_positions_[i] = previous_positions_[last];
+            masses_[i] = masses_[last]; inverse_masses_[i] = inverse_masses_[last];
+            frictions_[i] = frictions_[last]; restitutions_[i] = restitutions_[last];
+            drags_[i] = drags_[last]; radii_[i] = radii_[last];
+            layers_[i] = layers_[last]; masks_[i] = masks_[last];
+            sleep_[i] = sleep_[last];
+        }
+        ids_.pop_back(); types_.pop_back();
+        positions_.pop_back(); velocities_.pop_back(); accelerations_.pop_back();
+        previous_positions_.pop_back();
+        masses_.pop_back(); inverse_masses_.pop_back();
+        frictions_.pop_back(); restitutions_.pop_back();
+        drags_.pop_back(); radii_.pop_back();
+        layers_.pop_back(); masks_.pop_back();
+        sleep_.pop_back();
+    }
+
+    // Start of a step: rows [0, count) remember where they were
+    void latch_previous_positions(size_t count) {
+        std::copy(positions_.begin(), positions_.begin() + static_cast<std::ptrdiff_t>(count),
+                  previous_positions_.begin());
+    }
+
+    BodyRef operator[](size_t i) {
+        SleepState& s = sleep_[i];
+        return BodyRef{ ids_[i], types_[i], positions_[i], velocities_[i], accelerations_[i],
+                        masses_[i], inverse_masses_[i], frictions_[i], restitutions_[i],
+                        drags_[i], radii_[i], layers_[i], masks_[i],
+                        s.is_sleeping, s.sleep_threshold, s.sleep_timer_ticks };
+    }
+
+    ConstBodyRef operator[](size_t i) const {
+        const SleepState& s = sleep_[i];
+        return ConstBodyRef{ ids_[i], types_[i], positions_[i], velocities_[i], accelerations_[i],
+                             masses_[i], inverse_masses_[i], frictions_[i], restitutions_[i],
+                             drags_[i], radii_[i], layers_[i], masks_[i],
+                             s.is_sleeping, s.sleep_threshold, s.sleep_timer_ticks };
+    }
+
+    RigidBody get(size_t i) const { return (*this)[i].to_body(); }
+
+    // Desync detection: hash the field arrays in place (SleepState has padding, so per field)
+    void hash_state(FrameHasher& h) const {
+        const size_t n = size();
+        h.add_bytes(ids_.data(), n * sizeof(uint32_t));
+        h.add_bytes(types_.data(), n * sizeof(BodyType));
+        h.add_bytes(positions_.data(), n * sizeof(FixedVector3));
+        h.add_bytes(velocities_.data(), n * sizeof(FixedVector3));
+        h.add_bytes(accelerations_.data(), n * sizeof(FixedVector3));
+        h.add_bytes(masses_.data(), n * sizeof(Fixed));
+        h.add_bytes(inverse_masses_.data(), n * sizeof(Fixed));
+        h.add_bytes(frictions_.data(), n * sizeof(Fixed));
+        h.add_bytes(restitutions_.data(), n * sizeof(Fixed));
+        h.add_bytes(drags_.data(), n * sizeof(Fixed));
+        h.add_bytes(radii_.data(), n * sizeof(Fixed));
+        h.add_bytes(layers_.data(), n * sizeof(uint32_t));
+        h.add_bytes(masks_.data(), n * sizeof(uint32_t));
+        for (const SleepState& s : sleep_) {
+            h.add(static_cast<uint32_t>(s.is_sleeping));
+            h.add(s.sleep_threshold.raw);
+            h.add(s.sleep_timer_ticks);
+            h.add(s.island_next);
+        }
+    }
+
+    // Rollback snapshots: one bulk copy per field array
+    void save_state(SnapshotWriter& w) const {
+        w.write_vector(ids_); w.write_vector(types_);
+        w.write_vector(positions_); w.write_vector(velocities_); w.write_vector(accelerations_);
+        w.write_vector(masses_); w.write_vector(inverse_masses_);
+        w.write_vector(frictions_); w.write_vector(restitutions_);
+        w.write_vector(drags_); w.write_vector(radii_);
+        w.write_vector(layers_); w.write_vector(masks_);
+        w.write_vector(sleep_);
+    }
+
+    bool load_state(SnapshotReader& r) {
+        const bool ok = r.read_vector(ids_) && r.read_vector(types_) &&
+            r.read_vector(positions_) && r.read_vector(velocities_) && r.read_vector(accelerations_) &&
+            r.read_vector(masses_) && r.read_vector(inverse_masses_) &&
+            r.read_vector(frictions_) && r.read_vector(restitutions_) &&
+            r.read_vector(drags_) && r.read_vector(radii_) &&
+            r.read_vector(layers_) && r.read_vector(masks_) &&
+            r.read_vector(sleep_);
+        // Arrays must stay parallel even for a corrupt stream
+        const size_t n = ids_.size();
+        const bool parallel = types_.size() == n && positions_.size() == n && velocities_.size() == n &&
+            accelerations_.size() == n && masses_.size() == n && inverse_masses_.size() == n &&
+            frictions_.size() == n && restitutions_.size() == n && drags_.size() == n &&
+            radii_.size() == n && layers_.size() == n && masks_.size() == n && sleep_.size() == n;
+        if (!ok || !parallel) {
+            clear();
+            return false;
+        }
+        previous_positions_ = positions_;
+        return true;
+    }
+
+    // Sleep bookkeeping grouped per body (always read together). Sleeping
+    // bodies of one island form a ring through island_next (body ids);
+    // awake bodies hold INVALID_ENTITY.
+    struct SleepState {
+        bool is_sleeping;
+        Fixed sleep_threshold;
+        int32_t sleep_timer_ticks;
+        uint32_t island_next;
+    };
+
+    // Raw array access for bulk passes
+    const uint32_t* ids() const { return ids_.data(); }
+    BodyType* types() { return types_.data(); }
+    const BodyType* types() const { return types_.data(); }
+    FixedVector3* positions() { return positions_.data(); }
+    const FixedVector3* positions() const { return positions_.data(); }
+    FixedVector3* velocities() { return velocities_.data(); }
+    const FixedVector3* velocities() const { return velocities_.data(); }
+    FixedVector3* accelerations() { return accelerations_.data(); }
+    const FixedVector3* accelerations() const { return accelerations_.data(); }
+    FixedVector3* previous_positions() { return previous_positions_.data(); }
+    const FixedVector3* previous_positions() const { return previous_positions_.data(); }
+    const Fixed* inverse_masses() const { return inverse_masses_.data(); }
+    const Fixed* drags() const { return drags_.data(); }
+    const Fixed* radii() const { return radii_.data(); }
+    const uint32_t* layers() const { return layers_.data(); }
+    const uint32_t* masks() const { return masks_.data(); }
+    SleepState* sleep_states() { return sleep_.data(); }
+    const SleepState* sleep_states() const { return sleep_.data(); }
+
+private:
+    std::vector<uint32_t> ids_;
+    std::vector<BodyType> types_;
+    std::vector<FixedVector3> positions_;
+    std::vector<FixedVector3> velocities_;
+    std::vector<FixedVector3> accelerations_;
+    std::vector<FixedVector3> previous_positions_;  // Presentation only
+    std::vector<Fixed> masses_;
+    std::vector<Fixed> inverse_masses_;
+    std::vector<Fixed> frictions_;
+    std::vector<Fixed> restitutions_;
+    std::vector<Fixed> drags_;
+    std::vector<Fixed> radii_;
+    std::vector<uint32_t> layers_;
+    std::vector<uint32_t> masks_;
+    std::vector<SleepState> sleep_;
+};
+
+/**
+ * BodyHandleT - nullable handle returned by PhysicsManager::get_body
+ *
+ * Behaves like the old RigidBody pointer: test it for null, then use
+ * `->` to reach fields. Index based, so it survives store growth but is
+ * invalidated by destroy_body like any index.
+ */
+template <bool Const>
+class BodyHandleT {
+public:
+    using Store = typename std::conditional<Const, const BodyStore, BodyStore>::type;
+
+    struct Arrow {
+        BodyRefT<Const> ref;
+        const BodyRefT<Const>* operator->() const { return &ref; }
+    };
+
+    BodyHandleT() = default;
+    BodyHandleT(std::nullptr_t) {}
+    BodyHandleT(Store* store, size_t index) : store_(store), index_(index) {}
+
+    // Non-const handles convert to const ones
+    template <bool C = Const, typename = typename std::enable_if<C>::type>
+    BodyHandleT(const BodyHandleT<false>& other)
+        : store_(other.store()), index_(other.index()) {}
+
+    explicit operator bool() const { return store_ != nullptr; }
+    bool operator==(std::nullptr_t) const { return store_ == nullptr; }
+    bool operator!=(std::nullptr_t) const { return store_ != nullptr; }
+
+    BodyRefT<Const> operator*() const { return (*store_)[index_]; }
+    Arrow operator->() const { return Arrow{ (*store_)[index_] }; }
+
+    Store* store() const { return store_; }
+    size_t index() const { return index_; }
+
+private:
+    Store* store_ = nullptr;
+    size_t index_ = 0;
+};
+
+using BodyHandle = BodyHandleT<false>;
+using ConstBodyHandle = BodyHandleT<true>;
@@ -11,6 +11,7 @@ namespace CollisionLayers {
         Environment = 1u << 3,
         Projectile  = 1u << 4,
         PlayerArm   = 1u << 5,
+        Ground      = 1u << 6,   // The ground plane in event filters; not a body layer
         All         = 0xFFFFFFFFu
     };
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "PhysicsTypes.h"
+#include "BodyStore.h"
 #include "PhysicsEvents.h"
 #include "CollisionLayers.h"
 
@@ -21,7 +22,7 @@ public:
      * Modifies body positions and velocities in-place
      * Returns true if collision occurred and was resolved
      */
-    static bool resolve_sphere_collision(RigidBody& bodyA, RigidBody& bodyB) {
+    static bool resolve_sphere_collision(BodyRef bodyA, BodyRef bodyB, PhysicsEventQueue& events) {
         FixedVector3 delta = bodyB.position - bodyA.position;
         Fixed dist_sq = delta.length_squared();
         Fixed combined_radius = bodyA.radius + bodyB.radius;
@@ -47,8 +48,8 @@ public:
         bodyB.wake();
         
         // Calculate collision normal
-        Fixed dist = fixed_sqrt(dist_sq);
-        FixedVector3 normal = delta.normalized();
+        Fixed dist;
+        FixedVector3 normal = delta.normalized_and_length(dist);
         
         // Calculate overlap amount
         Fixed overlap = combined_radius - dist;
@@ -80,7 +81,12 @@ public:
         
         // Only resolve if bodies are moving towards each other
         if (velocity_along_normal >= Fixed::from_int(0)) {
-            return true; // Separated but no impulse needed
+            // Separated but no impulse needed; still a contact for the begin/stay/end stream
+            if (events.tracking_contacts(bodyA.collision_layer, bodyB.collision_layer)) {
+                events.record_resting(make_sphere_event(bodyA, bodyB, normal, Fixed::from_int(0)),
+                                      bodyA.collision_layer, bodyB.collision_layer);
+            }
+            return true;
         }
         
         // Restitution coefficient - lower for similar mass collisions
@@ -95,19 +101,11 @@ public:
         bodyA.velocity -= impulse * bodyA.inverse_mass;
         bodyB.velocity += impulse * bodyB.inverse_mass;
         
-        // Emit collision event
-        CollisionEvent ev{};
-        ev.bodyA = bodyA.id;
-        ev.bodyB = bodyB.id;
-        ev.nx = normal.x.to_float();
-        ev.ny = normal.y.to_float();
-        ev.nz = normal.z.to_float();
-        FixedVector3 contact = bodyA.position + (normal * bodyA.radius);
-        ev.px = contact.x.to_float();
-        ev.py = contact.y.to_float();
-        ev.pz = contact.z.to_float();
-        ev.impulse = impulse_magnitude.to_float();
-        GetPhysicsEventQueue().push(ev);
+        // Emit collision event (only if some subscriber's filter takes this layer pair)
+        if (events.wants(bodyA.collision_layer, bodyB.collision_layer)) {
+            events.record(make_sphere_event(bodyA, bodyB, normal, impulse_magnitude),
+                          bodyA.collision_layer, bodyB.collision_layer);
+        }
         
         return true;
     }
@@ -117,10 +115,11 @@ public:
      * Returns true if ground collision occurred
      */
     static bool resolve_ground_collision(
-        RigidBody& body,
+        BodyRef body,
         Fixed ground_y,
         Fixed restitution,
-        Fixed friction
+        Fixed friction,
+        PhysicsEventQueue& events
     ) {
         if (!body.should_collide()) {
             return false;
@@ -141,18 +140,10 @@ public:
         // Apply ground collision response only if moving downward
         if (body.velocity.y < Fixed::from_int(0)) {
             // Emit ground collision event
-            const uint32_t GROUND_ID = 0xFFFFFFFFu;
-            CollisionEvent ev{};
-            ev.bodyA = body.id;
-            ev.bodyB = GROUND_ID;
-            ev.nx = 0.0f;
-            ev.ny = 1.0f;
-            ev.nz = 0.0f;
-            ev.px = body.position.x.to_float();
-            ev.py = (ground_y + body.radius).to_float();
-            ev.pz = body.position.z.to_float();
-            ev.impulse = (-body.velocity.y * body.mass).to_float();
-            GetPhysicsEventQueue().push(ev);
+            if (events.wants(body.collision_layer, CollisionLayers::Ground)) {
+                events.record(make_ground_event(body, ground_y, -body.velocity.y * body.mass),
+                              body.collision_layer, CollisionLayers::Ground);
+            }
             
             // Apply restitution (bounce)
             body.velocity.y *= -restitution;
@@ -164,6 +155,40 @@ public:
             return true;
         }
         
+        if (events.tracking_contacts(body.collision_layer, CollisionLayers::Ground)) {
+            events.record_resting(make_ground_event(body, ground_y, Fixed::from_int(0)),
+                                  body.collision_layer, CollisionLayers::Ground);
+        }
         return false;
     }
+
+private:
+    static CollisionEvent make_sphere_event(BodyRef bodyA, BodyRef bodyB, const FixedVector3& normal, Fixed impulse) {
+        CollisionEvent ev{};
+        ev.bodyA = bodyA.id;
+        ev.bodyB = bodyB.id;
+        ev.nx = normal.x.to_float();
+        ev.ny = normal.y.to_float();
+        ev.nz = normal.z.to_float();
+        FixedVector3 contact = bodyA.position + (normal * bodyA.radius);
+        ev.px = contact.x.to_float();
+        ev.py = contact.y.to_float();
+        ev.pz = contact.z.to_float();
+        ev.impulse = impulse.to_float();
+        return ev;
+    }
+
+    static CollisionEvent make_ground_event(BodyRef body, Fixed ground_y, Fixed impulse) {
+        CollisionEvent ev{};
+        ev.bodyA = body.id;
+        ev.bodyB = PhysicsEventQueue::GROUND_ID;
+        ev.nx = 0.0f;
+        ev.ny = 1.0f;
+        ev.nz = 0.0f;
+        ev.px = body.position.x.to_float();
+        ev.py = (ground_y + body.radius).to_float();
+        ev.pz = body.position.z.to_float();
+        ev.impulse = impulse.to_float();
+        return ev;
+    }
 };
@@ -0,0 +1,251 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SnapshotStream.h"
+
+/**
+ * EntityRegistry / SparseIndex / DensePool - generational entity handles
+ *
+ * A handle packs a slot (low ENTITY_SLOT_BITS) with that slot's generation.
+ * Destroying an entity bumps the generation, so stale handles stop
+ * resolving, and pushes the slot on a LIFO free list, so reuse order is
+ * deterministic. Handles stay below 2^31 (positive i32 on the JS side) and
+ * the first handle a fresh registry hands out is 0.
+ *
+ * PhysicsManager owns the registry: a physics body handle is the entity
+ * identity every other system keys its per-entity data on. Each system
+ * keeps that data in a dense array and maps handles to rows through a
+ * SparseIndex, which is patched in O(1) on swap-remove; nothing rebuilds a
+ * lookup map after a despawn. DensePool bundles the two for simple
+ * components.
+ */
+using EntityHandle = uint32_t;
+
+constexpr uint32_t ENTITY_SLOT_BITS = 20;
+constexpr uint32_t ENTITY_SLOT_MASK = (1u << ENTITY_SLOT_BITS) - 1;
+constexpr uint32_t ENTITY_GENERATION_MASK = (1u << (31 - ENTITY_SLOT_BITS)) - 1;
+constexpr uint32_t ENTITY_MAX_SLOTS = ENTITY_SLOT_MASK + 1;
+constexpr EntityHandle INVALID_ENTITY = 0xFFFFFFFFu;  // Never produced by make_entity_handle
+
+inline uint32_t entity_slot(EntityHandle h) { return h & ENTITY_SLOT_MASK; }
+inline uint32_t entity_generation(EntityHandle h) { return h >> ENTITY_SLOT_BITS; }
+inline EntityHandle make_entity_handle(uint32_t slot, uint32_t generation) {
+    return ((generation & ENTITY_GENERATION_MASK) << ENTITY_SLOT_BITS) | (slot & ENTITY_SLOT_MASK);
+}
+
+class EntityRegistry {
+public:
+    void clear() {
+        slots_.clear();
+        free_slots_.clear();
+        alive_count_ = 0;
+    }
+
+    // Room for count slots, and for all of them on the free list at once
+    void reserve(size_t count) {
+        slots_.reserve(count);
+        free_slots_.reserve(count);
+    }
+    size_t capacity() const { return slots_.capacity(); }
+
+    // INVALID_ENTITY once all ENTITY_MAX_SLOTS are live
+    EntityHandle create() {
+        uint32_t slot;
+        if (!free_slots_.empty()) {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        } else if (slots_.size() < ENTITY_MAX_SLOTS) {
+            slot = static_cast<uint32_t>(slots_.size());
+            slots_.push_back(Slot{});
+        } else {
+            return INVALID_ENTITY;
+        }
+        slots_[slot].alive = 1;
+        ++alive_count_;
+        return make_entity_handle(slot, slots_[slot].generation);
+    }
+
+    bool destroy(EntityHandle h) {
+        if (!alive(h)) return false;
+        Slot& s = slots_[entity_slot(h)];
+        s.alive = 0;
+        s.generation = static_cast<uint16_t>((s.generation + 1) & ENTITY_GENERATION_MASK);
+        free_slots_.push_back(entity_slot(h));
+        --alive_count_;
+        return true;
+    }
+
+    bool alive(EntityHandle h) const {
+        const uint32_t slot = entity_slot(h);
+        return h != INVALID_ENTITY && slot < slots_.size() && slots_[slot].alive &&
+            slots_[slot].generation == entity_generation(h);
+    }
+
+    uint32_t alive_count() const { return alive_count_; }
+    // Upper bound on entity_slot() of any live handle (sizes slot-indexed tables)
+    uint32_t slot_count() const { return static_cast<uint32_t>(slots_.size()); }
+
+    void save_state(SnapshotWriter& w) const {
+        w.write_vector(slots_);
+        w.write_vector(free_slots_);
+        w.write(alive_count_);
+    }
+
+    bool load_state(SnapshotReader& r) {
+        return r.read_vector(slots_) && r.read_vector(free_slots_) && r.read(alive_count_);
+    }
+
+private:
+    struct Slot {
+        uint16_t generation = 0;
+        uint16_t alive = 0;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+    uint32_t alive_count_ = 0;
+};
+
+/**
+ * SparseIndex - handle -> dense row, one entry per registry slot
+ *
+ * An entry only resolves for the exact handle stored in it, so a handle
+ * from an earlier generation of the slot misses. Owners call set() for the
+ * row that moved after a swap-remove and erase() for the removed handle.
+ */
+class SparseIndex {
+public:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    void clear() { entries_.clear(); }
+    void reserve(size_t slot_count) { entries_.reserve(slot_count); }
+
+    void set(EntityHandle h, uint32_t row) {
+        if (h == INVALID_ENTITY) return;
+        const uint32_t slot = entity_slot(h);
+        if (slot >= entries_.size()) {
+            entries_.resize(slot + 1, Entry{});
+        }
+        entries_[slot] = Entry{ h, row };
+    }
+
+    uint32_t find(EntityHandle h) const {
+        const uint32_t slot = entity_slot(h);
+        if (slot >= entries_.size() || entries_[slot].handle != h) return NONE;
+        return entries_[slot].row;
+    }
+
+    void erase(EntityHandle h) {
+        const uint32_t slot = entity_slot(h);
+        if (slot < entries_.size() && entries_[slot].handle == h) {
+            entries_[slot] = Entry{};
+        }
+    }
+
+private:
+    struct Entry {
+        EntityHandle handle = INVALID_ENTITY;
+        uint32_t row = NONE;
+    };
+
+    std::vector<Entry> entries_;
+};
+
+/**
+ * DensePool - one component per entity, packed for iteration
+ *
+ * Values and their owning handles are parallel dense arrays; remove() moves
+ * the last row into the hole. Iteration order is insertion order perturbed
+ * by removals, which is deterministic.
+ */
+template <typename T>
+class DensePool {
+public:
+    void clear() {
+        values_.clear();
+        handles_.clear();
+        index_.clear();
+    }
+
+    void reserve(size_t count) {
+        values_.reserve(count);
+        handles_.reserve(count);
+        index_.reserve(count);
+    }
+    size_t capacity() const { return values_.capacity(); }
+
+    // Adds a component, or overwrites the one the entity already has
+    T& insert(EntityHandle h, const T& value) {
+        const uint32_t row = index_.find(h);
+        if (row != SparseIndex::NONE) {
+            values_[row] = value;
+            return values_[row];
+        }
+        index_.set(h, static_cast<uint32_t>(values_.size()));
+        values_.push_back(value);
+        handles_.push_back(h);
+        return values_.back();
+    }
+
+    bool remove(EntityHandle h) {
+        const uint32_t row = index_.find(h);
+        if (row == SparseIndex::NONE) return false;
+        const uint32_t last = static_cast<uint32_t>(values_.size() - 1);
+        if (row != last) {
+            values_[row] = values_[last];
+            handles_[row] = handles_[last];
+            index_.set(handles_[row], row);
+        }
+        values_.pop_back();
+        handles_.pop_back();
+        index_.erase(h);
+        return true;
+    }
+
+    T* find(EntityHandle h) {
+        const uint32_t row = index_.find(h);
+        return row == SparseIndex::NONE ? nullptr : &values_[row];
+    }
+
+    const T* find(EntityHandle h) const {
+        const uint32_t row = index_.find(h);
+        return row == SparseIndex::NONE ? nullptr : &values_[row];
+    }
+
+    bool contains(EntityHandle h) const { return index_.find(h) != SparseIndex::NONE; }
+
+    size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+    T& operator[](size_t row) { return values_[row]; }
+    const T& operator[](size_t row) const { return values_[row]; }
+    EntityHandle handle_at(size_t row) const { return handles_[row]; }
+    const EntityHandle* handle_data() const { return handles_.data(); }
+    T* begin() { return values_.data(); }
+    T* end() { return values_.data() + values_.size(); }
+    const T* begin() const { return values_.data(); }
+    const T* end() const { return values_.data() + values_.size(); }
+
+    // Rows only; the index is rebuilt on load
+    void save_state(SnapshotWriter& w) const {
+        w.write_vector(handles_);
+        w.write_vector(values_);
+    }
+
+    bool load_state(SnapshotReader& r) {
+        if (!r.read_vector(handles_) || !r.read_vector(values_) || handles_.size() != values_.size()) {
+            clear();
+            return false;
+        }
+        index_.clear();
+        for (size_t i = 0; i < handles_.size(); ++i) {
+            index_.set(handles_[i], static_cast<uint32_t>(i));
+        }
+        return true;
+    }
+
+private:
+    std::vector<T> values_;
+    std::vector<EntityHandle> handles_;
+    SparseIndex index_;
+};
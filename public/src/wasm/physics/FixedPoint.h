@@ -104,49 +104,69 @@ struct Fixed {
     }
 };
 
+namespace fixed_detail {
+
+// Seed table: ceil(16 * sqrt(m + 1)) for the top bits m in [64, 256) of an
+// even-exponent-normalized input, so a seed is never below the true root
+struct SqrtSeedTable {
+    uint16_t seed[192];
+};
+
+constexpr uint32_t ceil_isqrt_small(uint32_t n) {
+    uint32_t r = 0;
+    while (r * r < n) {
+        ++r;
+    }
+    return r;
+}
+
+constexpr SqrtSeedTable make_sqrt_seed_table() {
+    SqrtSeedTable t{};
+    for (uint32_t m = 64; m < 256; ++m) {
+        t.seed[m - 64] = static_cast<uint16_t>(ceil_isqrt_small((m + 1) * 256));
+    }
+    return t;
+}
+
+inline constexpr SqrtSeedTable SQRT_SEED = make_sqrt_seed_table();
+
+// floor(sqrt(n)) for n in [2^16, 2^48]: clz + table seed (>= 7 good bits),
+// two Newton steps from above (>= 28 bits), one exact correction. No
+// data-dependent loop, so the cost is the same for every input.
+inline uint64_t isqrt_u48(uint64_t n) {
+    const int e = (63 - __builtin_clzll(n)) & ~1;  // Even exponent, 16..48
+    const uint64_t m = n >> (e - 6);               // [64, 256)
+    uint64_t r = static_cast<uint64_t>(SQRT_SEED.seed[m - 64]) << ((e - 14) >> 1);
+    r = (r + n / r) >> 1;
+    r = (r + n / r) >> 1;
+    // Newton from above never undershoots floor(sqrt(n)) and ends within one of it
+    r -= r * r > n;
+    return r;
+}
+
+} // namespace fixed_detail
+
 /**
- * Deterministic integer square root using Newton-Raphson method
+ * Deterministic square root: exact floor(sqrt(x_raw << 16)) in Q16.16
  * Essential for vector normalization in fixed-point math
  */
 inline Fixed fixed_sqrt(Fixed x) {
-    if (x.raw <= 0) {
-        return Fixed::from_int(0);
-    }
-    
-    // Compute sqrt for Q16.16 fixed-point correctly:
-    // y_raw = sqrt(x_raw << 16)
-    const uint64_t scaled = static_cast<uint64_t>(x.raw) << Fixed::SHIFT;
-    
-    // Use integer Newton-Raphson on 64-bit to preserve determinism
-    uint64_t guess = scaled;
-    // Provide a better initial guess to speed convergence
-    if (guess > 0) {
-        // Rough initial guess using bit-length
-        int leadingZeros = 0;
-        {
-            uint64_t v = scaled;
-            while ((v & (1ull << 63)) == 0) { v <<= 1; leadingZeros++; if (leadingZeros >= 64) break; }
-        }
-        int approxLog2 = 63 - leadingZeros; // floor(log2(scaled))
-        int approxSqrtLog2 = approxLog2 / 2;
-        guess = 1ull << approxSqrtLog2;
-    }
-    
-    // Ensure non-zero guess
-    if (guess == 0) {
-        guess = 1;
-    }
-    
-    for (int i = 0; i < 16; i++) {
-        uint64_t next = (guess + scaled / guess) >> 1;
-        if (next == guess) {
-            break; // Converged
-        }
-        guess = next;
-    }
-    
-    // Clamp to 32-bit and return as Fixed raw
-    return Fixed(static_cast<int32_t>(guess > 0x7FFFFFFF ? 0x7FFFFFFF : guess));
+    // Inputs <= 0 run on raw 1 and select 0 (selects, not branches)
+    const bool positive = x.raw > 0;
+    const uint64_t n = static_cast<uint64_t>(positive ? x.raw : 1) << Fixed::SHIFT;
+    const int32_t root = static_cast<int32_t>(fixed_detail::isqrt_u48(n));
+    return Fixed(positive ? root : 0);
+}
+
+/**
+ * Deterministic reciprocal square root: floor(1 / sqrt(x)) in Q16.16,
+ * i.e. floor(sqrt(2^48 / x_raw)); 0 for x <= 0, like division by zero
+ */
+inline Fixed fixed_rsqrt(Fixed x) {
+    const bool positive = x.raw > 0;
+    const uint64_t n = (1ull << 48) / static_cast<uint64_t>(positive ? x.raw : 1);  // [2^17, 2^48]
+    const int32_t root = static_cast<int32_t>(fixed_detail::isqrt_u48(n));
+    return Fixed(positive ? root : 0);
 }
 
 /**
@@ -243,14 +263,20 @@ struct FixedVector3 {
     
     // Deterministic normalization using fixed-point sqrt
     FixedVector3 normalized() const {
-        Fixed len = length();
+        Fixed len;
+        return normalized_and_length(len);
+    }
+    
+    // normalized() plus the length it divided by, for callers that need both
+    FixedVector3 normalized_and_length(Fixed& out_length) const {
+        out_length = length();
         
         // Avoid division by very small numbers
-        if (len.raw < (Fixed::ONE / 1000)) {
+        if (out_length.raw < (Fixed::ONE / 1000)) {
             return FixedVector3::zero();
         }
         
-        return FixedVector3(x / len, y / len, z / len);
+        return FixedVector3(x / out_length, y / out_length, z / out_length);
     }
     
     // Check if vector is approximately zero
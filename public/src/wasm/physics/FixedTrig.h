@@ -0,0 +1,191 @@
+#pragma once
+#include <cstdint>
+#include <cmath>
+#include "FixedPoint.h"
+
+/**
+ * Deterministic fixed-point trigonometry from compile-time tables
+ *
+ * fixed_sin/fixed_cos take Q16.16 radians and interpolate a 1024-segment
+ * quarter-wave table; fixed_atan2 returns Q16.16 radians in [-pi, pi] from a
+ * 1024-segment atan table over [0, 1] plus octant folding. Both tables are
+ * built by constexpr series, so results depend only on integer math at run
+ * time and match on every engine. Against <cmath> the error stays within
+ * 2.3e-5 for sin/cos (any int32 angle) and 3.4e-5 for atan2, about 1.5 and
+ * 2.2 Q16.16 ulps (tests/fixed_trig_test.cpp).
+ *
+ * Gameplay code calls the float wrappers trig_sin/trig_cos/trig_atan2, which
+ * route through the tables when built with DOZEDENT_FIXED_TRIG=1 (needed for
+ * lockstep sessions) and through <cmath> otherwise.
+ */
+
+namespace fixed_trig_detail {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr int SIN_SEGMENTS = 1024;   // Per quarter turn
+constexpr int ATAN_SEGMENTS = 1024;  // Over ratio [0, 1]
+
+constexpr double sin_series(double x) {
+    // x in [0, pi/2]; terms through x^31 are far below double precision
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 16; ++n) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double sqrt_newton(double v) {
+    double r = v > 1.0 ? v : 1.0;
+    for (int i = 0; i < 64; ++i) {
+        r = 0.5 * (r + v / r);
+    }
+    return r;
+}
+
+constexpr double atan_series(double t) {
+    // t in [0, 1]: halve the angle once (t <= tan(pi/8)), then Taylor
+    const double h = t / (1.0 + sqrt_newton(1.0 + t * t));
+    double term = h;
+    double sum = h;
+    for (int n = 1; n < 40; ++n) {
+        term *= -h * h;
+        sum += term / (2 * n + 1);
+    }
+    return 2.0 * sum;
+}
+
+constexpr int32_t to_raw(double v) {
+    return static_cast<int32_t>(v * Fixed::ONE + (v >= 0 ? 0.5 : -0.5));
+}
+
+// One extra entry past the end so interpolation at the last segment stays in bounds
+struct TrigTables {
+    int32_t sin_quarter[SIN_SEGMENTS + 2];
+    int32_t atan_unit[ATAN_SEGMENTS + 2];
+};
+
+constexpr TrigTables make_trig_tables() {
+    TrigTables t{};
+    for (int i = 0; i <= SIN_SEGMENTS; ++i) {
+        t.sin_quarter[i] = to_raw(sin_series(PI * 0.5 * i / SIN_SEGMENTS));
+    }
+    t.sin_quarter[SIN_SEGMENTS + 1] = t.sin_quarter[SIN_SEGMENTS];
+    for (int i = 0; i <= ATAN_SEGMENTS; ++i) {
+        t.atan_unit[i] = to_raw(atan_series(static_cast<double>(i) / ATAN_SEGMENTS));
+    }
+    t.atan_unit[ATAN_SEGMENTS + 1] = t.atan_unit[ATAN_SEGMENTS];
+    return t;
+}
+
+inline constexpr TrigTables TABLES = make_trig_tables();
+
+constexpr int32_t PI_RAW = to_raw(PI);
+constexpr int32_t HALF_PI_RAW = to_raw(PI * 0.5);
+// Q16.16 radians -> 2^32 units per turn: raw * 2^16 / (2 pi). The scale carries
+// 32 fraction bits, split in two so raw * scale fits int64; with only the high
+// part the phase drifts by up to 2e-5 rad near the ends of the Q16.16 range
+constexpr double TURN_SCALE = 65536.0 / (2.0 * PI) * 65536.0 * 65536.0;
+constexpr int64_t TURN_SCALE_HI = static_cast<int64_t>(TURN_SCALE / 65536.0);
+constexpr int64_t TURN_SCALE_LO = static_cast<int64_t>(TURN_SCALE - static_cast<double>(TURN_SCALE_HI) * 65536.0);
+
+// Phase: full turn = 2^32; quadrant in the top 2 bits, 10 index bits, 20 fraction bits
+inline int32_t sin_phase(uint32_t phase) {
+    const uint32_t quadrant = phase >> 30;
+    uint32_t within = phase & 0x3FFFFFFFu;
+    if (quadrant & 1u) {
+        within = 0x40000000u - within;  // Falling half of the hump
+    }
+    const uint32_t index = within >> 20;
+    const int64_t frac = within & 0xFFFFFu;
+    const int32_t a = TABLES.sin_quarter[index];
+    const int32_t b = TABLES.sin_quarter[index + 1];
+    const int32_t value = a + static_cast<int32_t>(((b - a) * frac) >> 20);
+    return (quadrant & 2u) ? -value : value;
+}
+
+inline uint32_t angle_phase(Fixed angle) {
+    // Wraps modulo one turn for any int32 angle, negative included
+    const int64_t raw = angle.raw;
+    return static_cast<uint32_t>((raw * TURN_SCALE_HI + ((raw * TURN_SCALE_LO) >> 16)) >> 16);
+}
+
+} // namespace fixed_trig_detail
+
+inline Fixed fixed_sin(Fixed angle) {
+    return Fixed(fixed_trig_detail::sin_phase(fixed_trig_detail::angle_phase(angle)));
+}
+
+inline Fixed fixed_cos(Fixed angle) {
+    return Fixed(fixed_trig_detail::sin_phase(fixed_trig_detail::angle_phase(angle) + 0x40000000u));
+}
+
+inline Fixed fixed_atan2(Fixed y, Fixed x) {
+    using namespace fixed_trig_detail;
+    const int64_t ax = x.raw < 0 ? -static_cast<int64_t>(x.raw) : x.raw;
+    const int64_t ay = y.raw < 0 ? -static_cast<int64_t>(y.raw) : y.raw;
+    if (ax == 0 && ay == 0) {
+        return Fixed(0);
+    }
+
+    // Ratio of the smaller to the larger side as 20 fraction bits, 10 index + 10 interpolation
+    const bool steep = ay > ax;
+    const int64_t ratio = steep ? (ax << 20) / ay : (ay << 20) / ax;
+    const int64_t index = ratio >> 10;
+    const int64_t frac = ratio & 1023;
+    const int32_t a = TABLES.atan_unit[index];
+    const int32_t b = TABLES.atan_unit[index + 1];
+    int32_t angle = a + static_cast<int32_t>(((b - a) * frac) >> 10);
+
+    if (steep) angle = HALF_PI_RAW - angle;
+    if (x.raw < 0) angle = PI_RAW - angle;
+    if (y.raw < 0) angle = -angle;
+    return Fixed(angle);
+}
+
+namespace fixed_trig_detail {
+
+// Float radians -> Q16.16, folding angles beyond the Q16.16 range into one turn first
+inline Fixed float_angle(float radians) {
+    if (!(std::fabs(radians) < 16384.0f)) {
+        if (!std::isfinite(radians)) {
+            return Fixed(0);
+        }
+        radians = std::fmod(radians, static_cast<float>(2.0 * PI));
+    }
+    return Fixed::from_float(radians);
+}
+
+// Float ratio inputs only matter up to their common scale
+inline void float_vector(float y, float x, Fixed& fy, Fixed& fx) {
+    const float ay = std::fabs(y);
+    const float ax = std::fabs(x);
+    const float m = ay > ax ? ay : ax;
+    if (!(m > 0.0f)) {  // Zero or NaN
+        fy = Fixed(0);
+        fx = Fixed(0);
+        return;
+    }
+    // Normalize so the larger side is 16384, the most Q16.16 precision without overflow
+    const float scale = 16384.0f / m;
+    fy = Fixed::from_float(y * scale);
+    fx = Fixed::from_float(x * scale);
+}
+
+} // namespace fixed_trig_detail
+
+#if DOZEDENT_FIXED_TRIG
+inline float trig_sin(float radians) { return fixed_sin(fixed_trig_detail::float_angle(radians)).to_float(); }
+inline float trig_cos(float radians) { return fixed_cos(fixed_trig_detail::float_angle(radians)).to_float(); }
+inline float trig_atan2(float y, float x) {
+    Fixed fy;
+    Fixed fx;
+    fixed_trig_detail::float_vector(y, x, fy, fx);
+    return fixed_atan2(fy, fx).to_float();
+}
+#else
+inline float trig_sin(float radians) { return std::sin(radians); }
+inline float trig_cos(float radians) { return std::cos(radians); }
+inline float trig_atan2(float y, float x) { return std::atan2(y, x); }
+#endif
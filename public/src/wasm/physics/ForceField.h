@@ -1,6 +1,12 @@
 #pragma once
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 #include "PhysicsTypes.h"
+#include "BodyStore.h"
+#include "FixedSimd.h"
+#include "FrameHash.h"
+#include "SnapshotStream.h"
 
 enum class ForceFieldType {
     RadialAttract = 0,
@@ -12,67 +18,299 @@ struct ForceField {
     ForceFieldType type;
     FixedVector3 position;
     FixedVector3 direction; // for wind
-    Fixed radius;
+    Fixed radius;           // Reach from position; 0 or less reaches every body
     Fixed strength;
+    uint32_t id;            // Assigned by ForceFieldManager::add
+    int32_t steps_left;     // Physics steps until removal; 0 or less never expires
 };
 
+/**
+ * ForceFieldManager - radial and wind fields applied before integration
+ *
+ * Fields are applied one at a time to a batch of candidate rows. Bounded
+ * fields (radius > 0) take their candidates from a grid of the eligible
+ * bodies: it is built once per step, and only the cells under each field's
+ * bounds are visited. Each batch then runs a squared-radius cull, four
+ * rows per pass in SIMD builds, and only the bodies it keeps pay for the
+ * normalize and divide. A field covering more cells than there are bodies
+ * scans the whole list. Accelerations are fixed-point sums, so the result
+ * does not depend on visiting order.
+ *
+ * Fields are simulation state: PhysicsManager saves and hashes them.
+ */
 class ForceFieldManager {
 public:
+    static constexpr int32_t MAX_CELLS_PER_FIELD = 64;
+
     void clear() { fields_.clear(); }
-    void add(const ForceField &f) { fields_.push_back(f); }
 
-    void apply(std::vector<RigidBody> &bodies, Fixed /* dt */) const {
-        for (auto &b : bodies) {
-            // Force fields only affect dynamic bodies with non-zero inverse mass
-            if (b.type != BodyType::Dynamic || b.is_sleeping) {
-                continue;
+    // Returns the field's id; lifetime_steps <= 0 keeps it until removed
+    uint32_t add(ForceField f, int32_t lifetime_steps = 0) {
+        f.id = next_id_++;
+        f.steps_left = lifetime_steps > 0 ? lifetime_steps : 0;
+        fields_.push_back(f);
+        return f.id;
+    }
+
+    bool remove(uint32_t id) {
+        for (size_t i = 0; i < fields_.size(); ++i) {
+            if (fields_[i].id == id) {
+                fields_.erase(fields_.begin() + static_cast<std::ptrdiff_t>(i));
+                return true;
             }
-            if (b.inverse_mass <= Fixed::from_int(0)) {
-                continue;
+        }
+        return false;
+    }
+
+    bool empty() const { return fields_.empty(); }
+    size_t size() const { return fields_.size(); }
+    const std::vector<ForceField>& fields() const { return fields_; }
+
+    // Grid cell for bounded-field lookups (about the typical field diameter)
+    void set_cell_size(Fixed size) {
+        if (size > Fixed::from_int(0)) cell_size_ = size;
+    }
+    Fixed get_cell_size() const { return cell_size_; }
+
+    // Body-field pairs that passed the radius cull during the last step
+    uint32_t get_evaluations() const { return evaluations_; }
+
+    // Bodies [0, count): PhysicsManager passes its awake range. Expired
+    // fields are removed after their last step.
+    void apply(BodyStore &bodies, size_t count, Fixed /* dt */) {
+        evaluations_ = 0;
+        if (fields_.empty()) return;
+
+        // Force fields only affect awake dynamic bodies with non-zero inverse mass
+        const BodyType* types = bodies.types();
+        const BodyStore::SleepState* sleep = bodies.sleep_states();
+        const Fixed* inverse_masses = bodies.inverse_masses();
+        eligible_.clear();
+        for (size_t i = 0; i < count; ++i) {
+            if (types[i] == BodyType::Dynamic && !sleep[i].is_sleeping && inverse_masses[i] > Fixed::from_int(0)) {
+                eligible_.push_back(static_cast<uint32_t>(i));
             }
-            
-            for (const auto &f : fields_) {
-                switch (f.type) {
-                    case ForceFieldType::RadialAttract: {
-                        FixedVector3 d = f.position - b.position;
-                        Fixed distSq = d.length_squared();
-                        // Apply inverse square falloff for realistic behavior
-                        if (distSq > Fixed::from_float(0.01f)) {
-                            FixedVector3 n = d.normalized();
-                            Fixed falloff = Fixed::from_int(1) / distSq;
-                            // Clamp falloff to prevent extreme forces at close range
-                            falloff = Fixed::min(falloff, Fixed::from_float(100.0f));
-                            b.acceleration += n * (f.strength * falloff) * b.inverse_mass;
-                        }
-                        break;
-                    }
-                    case ForceFieldType::RadialRepel: {
-                        FixedVector3 d = b.position - f.position;
-                        Fixed distSq = d.length_squared();
-                        // Apply inverse square falloff for realistic behavior
-                        if (distSq > Fixed::from_float(0.01f)) {
-                            FixedVector3 n = d.normalized();
-                            Fixed falloff = Fixed::from_int(1) / distSq;
-                            // Clamp falloff to prevent extreme forces at close range
-                            falloff = Fixed::min(falloff, Fixed::from_float(100.0f));
-                            b.acceleration += n * (f.strength * falloff) * b.inverse_mass;
-                        }
-                        break;
-                    }
-                    case ForceFieldType::DirectionalWind: {
-                        FixedVector3 n = f.direction.normalized();
-                        if (!n.is_zero()) {
-                            b.acceleration += n * f.strength * b.inverse_mass;
-                        }
-                        break;
+        }
+
+        if (!eligible_.empty()) {
+            bool grid_built = false;
+            for (const ForceField& f : fields_) {
+                const std::vector<uint32_t>* rows = &eligible_;
+                CellRange cells;
+                if (bounded(f) && cell_range(f, cells) && cells.count() < eligible_.size()) {
+                    if (!grid_built) {
+                        build_grid(bodies.positions());
+                        grid_built = true;
                     }
+                    gather(cells);
+                    rows = &candidates_;
                 }
+                apply_field(f, bodies, *rows);
             }
         }
+
+        // Expire after the last step a field applies
+        size_t kept = 0;
+        for (size_t i = 0; i < fields_.size(); ++i) {
+            ForceField& f = fields_[i];
+            if (f.steps_left > 0 && --f.steps_left == 0) continue;
+            fields_[kept++] = f;
+        }
+        fields_.resize(kept);
+    }
+
+    void save_state(SnapshotWriter& w) const {
+        w.write_vector(fields_);
+        w.write(next_id_);
+    }
+
+    bool load_state(SnapshotReader& r) {
+        return r.read_vector(fields_) && r.read(next_id_);
+    }
+
+    void hash_state(FrameHasher& h) const {
+        h.add(static_cast<uint32_t>(fields_.size()));
+        for (const ForceField& f : fields_) {
+            h.add(f);
+        }
     }
 
 private:
+    struct CellRange {
+        int32_t x0, y0, x1, y1;
+        size_t count() const {
+            return static_cast<size_t>(x1 - x0 + 1) * static_cast<size_t>(y1 - y0 + 1);
+        }
+    };
+
     std::vector<ForceField> fields_;
-};
+    uint32_t next_id_ = 1;
+    Fixed cell_size_ = Fixed::from_float(0.25f);
+    uint32_t evaluations_ = 0;
+
+    // Per-step scratch (cleared, never freed)
+    std::vector<uint32_t> eligible_;      // Rows fields may move
+    std::vector<uint32_t> bucket_start_;  // Counting-sort offsets into bucket_rows_
+    std::vector<uint32_t> bucket_rows_;   // Eligible rows grouped by grid bucket
+    std::vector<uint32_t> bucket_cursor_;
+    std::vector<uint32_t> row_bucket_;    // Bucket of each eligible_ entry
+    std::vector<uint32_t> bucket_stamp_;  // Last field that visited each bucket
+    std::vector<uint32_t> candidates_;
+    std::vector<uint32_t> accepted_;
+    uint32_t stamp_ = 0;
+    uint32_t mask_ = 0;
 
+    static bool bounded(const ForceField& f) { return f.radius > Fixed::from_int(0); }
+
+    // Square of the reach, saturated to the Fixed range (a larger reach than
+    // that cannot be told apart by length_squared anyway)
+    static int32_t radius_sq_raw(const ForceField& f) {
+        const int64_t r = f.radius.raw;
+        const int64_t sq = (r * r) >> Fixed::SHIFT;
+        return sq > 0x7FFFFFFF ? 0x7FFFFFFF : static_cast<int32_t>(sq);
+    }
+
+    // Floor division on raw fixed-point values (no float round-trip)
+    static int32_t floor_div(int64_t v, int32_t d) {
+        int64_t q = v / d;
+        if ((v % d != 0) && (v < 0)) --q;
+        return static_cast<int32_t>(q);
+    }
 
+    // False when the bounds span too many cells to be worth visiting
+    bool cell_range(const ForceField& f, CellRange& out) const {
+        const int64_t r = f.radius.raw;
+        out.x0 = floor_div(static_cast<int64_t>(f.position.x.raw) - r, cell_size_.raw);
+        out.x1 = floor_div(static_cast<int64_t>(f.position.x.raw) + r, cell_size_.raw);
+        out.y0 = floor_div(static_cast<int64_t>(f.position.y.raw) - r, cell_size_.raw);
+        out.y1 = floor_div(static_cast<int64_t>(f.position.y.raw) + r, cell_size_.raw);
+        const int64_t w = static_cast<int64_t>(out.x1) - out.x0 + 1;
+        const int64_t h = static_cast<int64_t>(out.y1) - out.y0 + 1;
+        return w * h <= MAX_CELLS_PER_FIELD;
+    }
+
+    uint32_t bucket_of(int32_t cx, int32_t cy) const {
+        return ((static_cast<uint32_t>(cx) * 73856093u) ^ (static_cast<uint32_t>(cy) * 19349663u)) & mask_;
+    }
+
+    void build_grid(const FixedVector3* positions) {
+        uint32_t table_size = 16;
+        while (table_size < eligible_.size() * 2) table_size <<= 1;
+        mask_ = table_size - 1;
+
+        bucket_start_.assign(table_size + 1, 0);
+        row_bucket_.resize(eligible_.size());
+        for (size_t k = 0; k < eligible_.size(); ++k) {
+            const FixedVector3& p = positions[eligible_[k]];
+            const uint32_t b = bucket_of(floor_div(p.x.raw, cell_size_.raw), floor_div(p.y.raw, cell_size_.raw));
+            row_bucket_[k] = b;
+            bucket_start_[b + 1]++;
+        }
+        for (uint32_t b = 0; b < table_size; ++b) {
+            bucket_start_[b + 1] += bucket_start_[b];
+        }
+        bucket_rows_.resize(eligible_.size());
+        bucket_cursor_.assign(bucket_start_.begin(), bucket_start_.end() - 1);
+        for (size_t k = 0; k < eligible_.size(); ++k) {
+            bucket_rows_[bucket_cursor_[row_bucket_[k]]++] = eligible_[k];
+        }
+        if (bucket_stamp_.size() < table_size) {
+            bucket_stamp_.assign(table_size, 0);
+            stamp_ = 0;
+        }
+    }
+
+    // Rows in the buckets under cells; a bucket shared by two cells is read
+    // once. Rows outside the field (hash neighbours) fall to the radius cull.
+    void gather(const CellRange& cells) {
+        candidates_.clear();
+        if (++stamp_ == 0) {
+            std::fill(bucket_stamp_.begin(), bucket_stamp_.end(), 0u);
+            stamp_ = 1;
+        }
+        for (int32_t cy = cells.y0; cy <= cells.y1; ++cy) {
+            for (int32_t cx = cells.x0; cx <= cells.x1; ++cx) {
+                const uint32_t b = bucket_of(cx, cy);
+                if (bucket_stamp_[b] == stamp_) continue;
+                bucket_stamp_[b] = stamp_;
+                candidates_.insert(candidates_.end(), bucket_rows_.begin() + bucket_start_[b],
+                                   bucket_rows_.begin() + bucket_start_[b + 1]);
+            }
+        }
+    }
+
+    // Keeps rows whose squared distance d = sign * (position - f.position)
+    // is above the near cutoff and, for bounded fields, within the reach
+    void cull(const ForceField& f, const FixedVector3* positions, const std::vector<uint32_t>& rows,
+              int32_t min_sq, int32_t max_sq) {
+        accepted_.clear();
+        size_t k = 0;
+#if DOZEDENT_PHYSICS_SIMD
+        using namespace FixedSimd;
+        const size_t batched = rows.size() & ~static_cast<size_t>(3);
+        const i32x4 fx = splat(f.position.x);
+        const i32x4 fy = splat(f.position.y);
+        const i32x4 fz = splat(f.position.z);
+        const i32x4 lo = splat(min_sq);
+        const i32x4 hi = splat(max_sq);
+        for (; k < batched; k += 4) {
+            // Sign does not change the squared distance
+            const Vec3x4 p = Vec3x4::load(positions, rows.data() + k);
+            const i32x4 dist_sq = length_squared(fx - p.x, fy - p.y, fz - p.z);
+            const i32x4 keep = (dist_sq > lo) & (dist_sq <= hi);
+            if (!any(keep)) continue;
+            for (int l = 0; l < 4; ++l) {
+                if (keep[l]) accepted_.push_back(rows[k + l]);
+            }
+        }
+#endif
+        for (; k < rows.size(); ++k) {
+            const Fixed dist_sq = (f.position - positions[rows[k]]).length_squared();
+            if (dist_sq.raw > min_sq && dist_sq.raw <= max_sq) {
+                accepted_.push_back(rows[k]);
+            }
+        }
+    }
+
+    void apply_field(const ForceField& f, BodyStore& bodies, const std::vector<uint32_t>& rows) {
+        const FixedVector3* positions = bodies.positions();
+        FixedVector3* accelerations = bodies.accelerations();
+        const Fixed* inverse_masses = bodies.inverse_masses();
+        const int32_t max_sq = bounded(f) ? radius_sq_raw(f) : 0x7FFFFFFF;
+
+        switch (f.type) {
+            case ForceFieldType::RadialAttract:
+            case ForceFieldType::RadialRepel: {
+                // Inverse square falloff; bodies inside the 0.01 cutoff feel nothing
+                cull(f, positions, rows, Fixed::from_float(0.01f).raw, max_sq);
+                const bool attract = f.type == ForceFieldType::RadialAttract;
+                for (uint32_t i : accepted_) {
+                    const FixedVector3 d = attract ? f.position - positions[i] : positions[i] - f.position;
+                    const Fixed distSq = d.length_squared();
+                    FixedVector3 n = d.normalized();
+                    Fixed falloff = Fixed::from_int(1) / distSq;
+                    // Clamp falloff to prevent extreme forces at close range
+                    falloff = Fixed::min(falloff, Fixed::from_float(100.0f));
+                    accelerations[i] += n * (f.strength * falloff) * inverse_masses[i];
+                }
+                break;
+            }
+            case ForceFieldType::DirectionalWind: {
+                const FixedVector3 n = f.direction.normalized();
+                if (n.is_zero()) return;
+                const FixedVector3 push = n * f.strength;
+                const std::vector<uint32_t>* hit = &rows;
+                if (bounded(f)) {
+                    cull(f, positions, rows, -1, max_sq);
+                    hit = &accepted_;
+                }
+                for (uint32_t i : *hit) {
+                    accelerations[i] += push * inverse_masses[i];
+                }
+                evaluations_ += static_cast<uint32_t>(hit->size());
+                return;
+            }
+        }
+        evaluations_ += static_cast<uint32_t>(accepted_.size());
+    }
+};
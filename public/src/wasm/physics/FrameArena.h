@@ -0,0 +1,165 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * FrameArena - linear allocator for scratch data that lives for one update
+ *
+ * GameCoordinator owns one and resets it at the start of every update;
+ * managers take transient arrays from it (see FrameVector) instead of
+ * building heap containers. Allocation is a pointer bump and nothing is
+ * freed individually; reset() rewinds the whole arena.
+ *
+ * A frame that outgrows the block spills into overflow chunks, which
+ * still works but costs a malloc each. The next reset() replaces the
+ * block with one that covers the high-water mark, so after the first
+ * frames of a new workload the arena makes no heap calls. Main thread
+ * only: the physics worker keeps its own reused buffers.
+ */
+class FrameArena {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    explicit FrameArena(size_t capacity = DEFAULT_CAPACITY) { grow(capacity); }
+    ~FrameArena() {
+        release_overflow();
+        std::free(block_);
+    }
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Uninitialized storage aligned to align (a power of two); never null
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        size_t offset = (used_ + align - 1) & ~(align - 1);
+        if (offset + bytes > capacity_) {
+            return allocate_overflow(bytes, align);
+        }
+        used_ = offset + bytes;
+        if (used_ + overflow_bytes_ > high_water_) {
+            high_water_ = used_ + overflow_bytes_;
+        }
+        return block_ + offset;
+    }
+
+    template <typename T>
+    T* allocate_array(size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                      "frame arena arrays hold trivially copyable values");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Rewinds; grows the block first if the last frame spilled or a reserve is pending
+    void reset() {
+        if (!overflow_.empty() || reserved_ > capacity_) {
+            release_overflow();
+            size_t capacity = capacity_;
+            while (capacity < high_water_ || capacity < reserved_) capacity *= 2;
+            grow(capacity);
+        }
+        used_ = 0;
+    }
+
+    // Growth hint (bytes), applied at the next reset so live scratch stays valid
+    void reserve(size_t capacity) {
+        if (capacity > reserved_) reserved_ = capacity;
+    }
+
+    size_t used() const { return used_ + overflow_bytes_; }
+    size_t capacity() const { return capacity_; }
+    size_t high_water() const { return high_water_; }  // Most bytes any frame used
+    uint32_t overflow_count() const { return overflow_count_; }  // Spilled allocations since construction
+
+private:
+    uint8_t* block_ = nullptr;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    size_t high_water_ = 0;
+    size_t reserved_ = 0;
+    size_t overflow_bytes_ = 0;
+    uint32_t overflow_count_ = 0;
+    std::vector<void*> overflow_;
+
+    void grow(size_t capacity) {
+        std::free(block_);
+        capacity_ = capacity > 0 ? capacity : 1;
+        block_ = static_cast<uint8_t*>(std::malloc(capacity_));
+    }
+
+    void* allocate_overflow(size_t bytes, size_t align) {
+        // Over-allocate so the chunk can be aligned by hand
+        uint8_t* chunk = static_cast<uint8_t*>(std::malloc(bytes + align));
+        overflow_.push_back(chunk);
+        overflow_bytes_ += bytes + align;
+        overflow_count_++;
+        if (used_ + overflow_bytes_ > high_water_) {
+            high_water_ = used_ + overflow_bytes_;
+        }
+        const uintptr_t p = reinterpret_cast<uintptr_t>(chunk);
+        return chunk + (((p + align - 1) & ~(uintptr_t(align) - 1)) - p);
+    }
+
+    void release_overflow() {
+        for (void* chunk : overflow_) {
+            std::free(chunk);
+        }
+        overflow_.clear();
+        overflow_bytes_ = 0;
+    }
+};
+
+/**
+ * FrameVector - growable array in a FrameArena
+ *
+ * Same surface as the parts of std::vector scratch code uses. Growing
+ * copies into a fresh arena range (the old one is reclaimed at reset), so
+ * reserve the expected size up front. Holds trivially copyable values and
+ * must not outlive the frame it was made in.
+ */
+template <typename T>
+class FrameVector {
+public:
+    static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                  "FrameVector holds trivially copyable values");
+
+    explicit FrameVector(FrameArena& arena, size_t capacity = 0) : arena_(&arena) {
+        reserve(capacity);
+    }
+
+    void reserve(size_t capacity) {
+        if (capacity <= capacity_) return;
+        T* grown = arena_->allocate_array<T>(capacity);
+        if (size_ > 0) {
+            std::memcpy(grown, data_, size_ * sizeof(T));
+        }
+        data_ = grown;
+        capacity_ = capacity;
+    }
+
+    void push_back(const T& value) {
+        if (size_ == capacity_) {
+            reserve(capacity_ > 0 ? capacity_ * 2 : 8);
+        }
+        data_[size_++] = value;
+    }
+
+    void clear() { size_ = 0; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    T* data() { return data_; }
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+
+private:
+    FrameArena* arena_;
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
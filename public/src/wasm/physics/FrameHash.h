@@ -0,0 +1,138 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * FrameHasher - streaming xxHash64-style hash for desync detection
+ *
+ * Four independent lanes consume 8-byte words round-robin, so hashing a
+ * field array is one pass over memory with no serialization. Callers feed
+ * raw arrays (positions, velocities, ...) or individual fields when a
+ * struct has padding. Not a cryptographic hash; only used to compare
+ * deterministic simulations across machines.
+ */
+class FrameHasher {
+public:
+    explicit FrameHasher(uint64_t seed = 0) {
+        lanes_[0] = seed + PRIME1 + PRIME2;
+        lanes_[1] = seed + PRIME2;
+        lanes_[2] = seed;
+        lanes_[3] = seed - PRIME1;
+    }
+
+    void add_bytes(const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        total_ += size;
+        // Top up a partial word left by the previous call
+        while (tail_size_ > 0 && size > 0) {
+            tail_ |= static_cast<uint64_t>(*p++) << (tail_size_ * 8);
+            --size;
+            if (++tail_size_ == 8) {
+                round(tail_);
+                tail_ = 0;
+                tail_size_ = 0;
+            }
+        }
+        while (size >= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, 8);
+            round(word);
+            p += 8;
+            size -= 8;
+        }
+        for (; size > 0; --size) {
+            tail_ |= static_cast<uint64_t>(*p++) << (tail_size_ * 8);
+            ++tail_size_;
+        }
+    }
+
+    template <typename T>
+    void add(const T& value) { add_bytes(&value, sizeof(T)); }
+
+    uint64_t finish() const {
+        uint64_t h = rotl(lanes_[0], 1) + rotl(lanes_[1], 7) + rotl(lanes_[2], 12) + rotl(lanes_[3], 18);
+        for (int i = 0; i < 4; ++i) {
+            h = (h ^ mix(0, lanes_[i])) * PRIME1 + PRIME4;
+        }
+        h += total_;
+        if (tail_size_ > 0) {
+            h = rotl(h ^ (tail_ * PRIME5), 11) * PRIME1;
+        }
+        // Avalanche
+        h ^= h >> 33;
+        h *= PRIME2;
+        h ^= h >> 29;
+        h *= PRIME3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    // 32-bit fold for JS (numbers, no BigInt)
+    static uint32_t fold32(uint64_t h) {
+        return static_cast<uint32_t>(h ^ (h >> 32));
+    }
+
+private:
+    static constexpr uint64_t PRIME1 = 11400714785074694791ULL;
+    static constexpr uint64_t PRIME2 = 14029467366897019727ULL;
+    static constexpr uint64_t PRIME3 = 1609587929392839161ULL;
+    static constexpr uint64_t PRIME4 = 9650029242287828579ULL;
+    static constexpr uint64_t PRIME5 = 2870177450012600261ULL;
+
+    static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+    static uint64_t mix(uint64_t acc, uint64_t input) { return rotl(acc + input * PRIME2, 31) * PRIME1; }
+
+    void round(uint64_t word) {
+        uint64_t& lane = lanes_[lane_++ & 3];
+        lane = mix(lane, word);
+    }
+
+    uint64_t lanes_[4];
+    uint64_t tail_ = 0;
+    uint64_t total_ = 0;
+    uint32_t lane_ = 0;
+    uint32_t tail_size_ = 0;
+};
+
+struct FrameHashEntry {
+    uint32_t tick = 0;
+    uint64_t hash = 0;
+};
+
+/**
+ * FrameHashRing - hashes of the last Capacity physics ticks, indexed by tick
+ *
+ * Ticks start at 1; tick 0 marks an empty slot.
+ */
+template <uint32_t Capacity>
+class FrameHashRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "FrameHashRing capacity must be a power of two");
+
+public:
+    void clear() {
+        for (FrameHashEntry& e : entries_) {
+            e = FrameHashEntry{};
+        }
+        latest_ = 0;
+    }
+
+    void record(uint32_t tick, uint64_t hash) {
+        entries_[tick & (Capacity - 1)] = FrameHashEntry{ tick, hash };
+        latest_ = tick;
+    }
+
+    bool find(uint32_t tick, uint64_t& out) const {
+        const FrameHashEntry& e = entries_[tick & (Capacity - 1)];
+        if (tick == 0 || e.tick != tick) return false;
+        out = e.hash;
+        return true;
+    }
+
+    uint32_t latest_tick() const { return latest_; }
+    static constexpr uint32_t capacity() { return Capacity; }
+
+private:
+    FrameHashEntry entries_[Capacity];
+    uint32_t latest_ = 0;
+};
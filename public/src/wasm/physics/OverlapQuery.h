@@ -0,0 +1,144 @@
+#pragma once
+#include <cstdint>
+#include "FixedPoint.h"
+
+/**
+ * QueryShape - hit volume for PhysicsManager::query_overlap
+ *
+ * Shapes live in the XY plane (the gameplay plane); z is ignored. An arc is
+ * a circle sector: bodies overlap when they touch the circle and their
+ * center lies within the sector's opening, or the body covers the arc's
+ * center. A capsule is a segment swept by a radius, e.g. a dash path.
+ *
+ * The exact test runs on raw Q16.16 values in 64-bit integers, so results
+ * are identical on every engine and small hitboxes keep full precision.
+ */
+struct QueryShape {
+    enum class Type : uint8_t {
+        Circle = 0,
+        Arc = 1,
+        Capsule = 2
+    };
+
+    Type type = Type::Circle;
+    FixedVector3 a;           // Circle/arc center, capsule start
+    FixedVector3 b;           // Capsule end; arc facing (unit length)
+    Fixed radius;
+    Fixed cos_half_angle;     // Arc: cosine of half the opening angle
+
+    static QueryShape circle(Fixed x, Fixed y, Fixed r) {
+        QueryShape s;
+        s.type = Type::Circle;
+        s.a = FixedVector3(x, y, Fixed(0));
+        s.radius = r;
+        return s;
+    }
+
+    // Facing need not be normalized; a zero facing degenerates to a circle
+    static QueryShape arc(Fixed x, Fixed y, Fixed r, Fixed facing_x, Fixed facing_y, Fixed cos_half) {
+        QueryShape s;
+        s.type = Type::Arc;
+        s.a = FixedVector3(x, y, Fixed(0));
+        s.b = FixedVector3(facing_x, facing_y, Fixed(0)).normalized();
+        s.radius = r;
+        s.cos_half_angle = cos_half;
+        if (s.b.is_zero()) {
+            s.type = Type::Circle;
+        }
+        return s;
+    }
+
+    static QueryShape capsule(Fixed ax, Fixed ay, Fixed bx, Fixed by, Fixed r) {
+        QueryShape s;
+        s.type = Type::Capsule;
+        s.a = FixedVector3(ax, ay, Fixed(0));
+        s.b = FixedVector3(bx, by, Fixed(0));
+        s.radius = r;
+        return s;
+    }
+
+    static QueryShape circle_f(float x, float y, float r) {
+        return circle(Fixed::from_float(x), Fixed::from_float(y), Fixed::from_float(r));
+    }
+    static QueryShape arc_f(float x, float y, float r, float facing_x, float facing_y, float cos_half) {
+        return arc(Fixed::from_float(x), Fixed::from_float(y), Fixed::from_float(r),
+                   Fixed::from_float(facing_x), Fixed::from_float(facing_y), Fixed::from_float(cos_half));
+    }
+    static QueryShape capsule_f(float ax, float ay, float bx, float by, float r) {
+        return capsule(Fixed::from_float(ax), Fixed::from_float(ay),
+                       Fixed::from_float(bx), Fixed::from_float(by), Fixed::from_float(r));
+    }
+
+    // Bounding circle for the broadphase lookup
+    void bounds(FixedVector3& center, Fixed& reach) const {
+        if (type != Type::Capsule) {
+            center = a;
+            reach = radius;
+            return;
+        }
+        const int64_t hx = (static_cast<int64_t>(b.x.raw) - a.x.raw) / 2;
+        const int64_t hy = (static_cast<int64_t>(b.y.raw) - a.y.raw) / 2;
+        center = FixedVector3(Fixed(static_cast<int32_t>(a.x.raw + hx)),
+                              Fixed(static_cast<int32_t>(a.y.raw + hy)), Fixed(0));
+        // +2 covers the rounding of the halved segment and the square root
+        reach = Fixed(static_cast<int32_t>(radius.raw + fixed_sqrt_q32(hx * hx + hy * hy) + 2));
+    }
+
+    // Exact test against a sphere body at (center, body_radius)
+    bool overlaps(const FixedVector3& center, Fixed body_radius) const {
+        const int64_t reach = static_cast<int64_t>(radius.raw) + body_radius.raw;
+        if (reach < 0) {
+            return false;
+        }
+        int64_t dx = static_cast<int64_t>(center.x.raw) - a.x.raw;
+        int64_t dy = static_cast<int64_t>(center.y.raw) - a.y.raw;
+
+        if (type == Type::Capsule) {
+            // Closest point on the segment: t = (w . d) / (d . d), clamped to [0, 1]
+            const int64_t sx = static_cast<int64_t>(b.x.raw) - a.x.raw;
+            const int64_t sy = static_cast<int64_t>(b.y.raw) - a.y.raw;
+            const int64_t len_sq = sx * sx + sy * sy;
+            const int64_t along = dx * sx + dy * sy;
+            if (len_sq > 0 && along > 0) {
+                if (along >= len_sq) {
+                    dx -= sx;
+                    dy -= sy;
+                } else {
+                    const int64_t t = (along << 16) / len_sq;  // Q16 in (0, 1)
+                    dx -= (sx * t) >> 16;
+                    dy -= (sy * t) >> 16;
+                }
+            }
+        }
+
+        const int64_t dist_sq = dx * dx + dy * dy;
+        if (dist_sq > reach * reach) {
+            return false;
+        }
+        if (type != Type::Arc) {
+            return true;
+        }
+
+        // Arc: the body covers the center, or its center is inside the opening
+        const int64_t body = body_radius.raw;
+        if (dist_sq <= body * body) {
+            return true;
+        }
+        const int64_t along_facing = (dx * b.x.raw + dy * b.y.raw) >> 16;  // Q16 distance along facing
+        const int64_t dist = fixed_sqrt_q32(dist_sq);
+        return along_facing >= ((static_cast<int64_t>(cos_half_angle.raw) * dist) >> 16);
+    }
+
+private:
+    // floor(sqrt(v)) for a Q32 squared distance, as Q16
+    static int64_t fixed_sqrt_q32(int64_t v) {
+        if (v < (int64_t(1) << 16)) {
+            int64_t r = 0;
+            while ((r + 1) * (r + 1) <= v) ++r;
+            return r;
+        }
+        const uint64_t max_n = uint64_t(1) << 48;
+        return static_cast<int64_t>(fixed_detail::isqrt_u48(
+            static_cast<uint64_t>(v) < max_n ? static_cast<uint64_t>(v) : max_n));
+    }
+};
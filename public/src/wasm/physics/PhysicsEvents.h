@@ -1,5 +1,11 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstdint>
+#include <vector>
+#include "SpscRing.h"
+#include "CollisionLayers.h"
 
 // Forward declare for data layout stability: use plain floats here for JS interop
 struct CollisionEvent {
@@ -10,40 +16,297 @@ struct CollisionEvent {
     float impulse;     // scalar impulse magnitude
 };
 
-class PhysicsEventQueue {
+/**
+ * PhysicsEventFilter - layer-pair rules deciding which contacts are recorded
+ *
+ * A rule matches a contact when one body is on a layer in layers_a and
+ * the other on a layer in layers_b (either way round). The ground plane
+ * counts as CollisionLayers::Ground. The first matching rule decides;
+ * a contact no rule matches is not recorded.
+ */
+class PhysicsEventFilter {
 public:
-    static constexpr int CAPACITY = 256;
+    static constexpr int MAX_RULES = 8;
 
-    PhysicsEventQueue() : count_(0) {}
+    struct Rule {
+        uint32_t layers_a;
+        uint32_t layers_b;
+        float min_impulse;  // Contacts below this are not recorded
+        bool report_stay;   // Contact stream only: emit Stay while the contact persists
+    };
 
+    // Returns the rule index, or -1 when the table is full
+    int add_rule(uint32_t layers_a, uint32_t layers_b, float min_impulse = 0.0f, bool report_stay = false) {
+        if (count_ >= MAX_RULES) return -1;
+        rules_[count_] = Rule{ layers_a, layers_b, min_impulse, report_stay };
+        return count_++;
+    }
     void clear() { count_ = 0; }
+    bool empty() const { return count_ == 0; }
+    int rule_count() const { return count_; }
 
-    void push(const CollisionEvent &e) {
-        // Overwrite oldest when full to avoid unbounded growth
-        if (count_ < CAPACITY) {
-            buffer_[count_] = e;
-            count_++;
-        } else {
-            // Shift down by one; O(n) but small CAPACITY and only on overflow
-            for (int i = 1; i < CAPACITY; i++) {
-                buffer_[i - 1] = buffer_[i];
+    const Rule* match(uint32_t layer_a, uint32_t layer_b) const {
+        for (int i = 0; i < count_; ++i) {
+            const Rule& rule = rules_[i];
+            if (((layer_a & rule.layers_a) && (layer_b & rule.layers_b)) ||
+                ((layer_a & rule.layers_b) && (layer_b & rule.layers_a))) {
+                return &rule;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    Rule rules_[MAX_RULES];
+    int count_ = 0;
+};
+
+enum class ContactPhase : uint8_t {
+    Begin = 0,  // First step the pair touched
+    Stay = 1,   // Still touching (only for rules with report_stay)
+    End = 2     // Untouched for longer than the grace window
+};
+
+/**
+ * CompactCollisionEvent - quantized contact record for the JS contact stream
+ *
+ * 20 bytes against CollisionEvent's 36. The sim is planar, so z is
+ * dropped. Normal components are snorm16 (value * 32767). The contact
+ * point is in world units * 8192, covering +-4 around the 0..1 arena.
+ * Impulse is * 64, saturating at about 1024; for a pair hit several
+ * times in one step it is the largest hit. End events carry the pair's
+ * last normal and point, with impulse 0.
+ */
+struct CompactCollisionEvent {
+    uint32_t body_a;   // Body handles; 0xFFFFFFFF for ground
+    uint32_t body_b;
+    int16_t nx, ny;
+    int16_t px, py;
+    uint16_t impulse;
+    uint8_t phase;     // ContactPhase
+    uint8_t reserved;
+
+    static constexpr float NORMAL_SCALE = 32767.0f;
+    static constexpr float POINT_SCALE = 8192.0f;
+    static constexpr float IMPULSE_SCALE = 64.0f;
+
+    static CompactCollisionEvent quantize(const CollisionEvent& ev) {
+        CompactCollisionEvent out;
+        out.body_a = ev.bodyA;
+        out.body_b = ev.bodyB;
+        out.nx = to_i16(ev.nx * NORMAL_SCALE);
+        out.ny = to_i16(ev.ny * NORMAL_SCALE);
+        out.px = to_i16(ev.px * POINT_SCALE);
+        out.py = to_i16(ev.py * POINT_SCALE);
+        out.impulse = to_u16(ev.impulse * IMPULSE_SCALE);
+        out.phase = static_cast<uint8_t>(ContactPhase::Begin);
+        out.reserved = 0;
+        return out;
+    }
+
+    static int16_t to_i16(float v) {
+        if (!(v > -32767.0f)) return -32767;  // Also catches NaN
+        if (v > 32767.0f) return 32767;
+        return static_cast<int16_t>(std::lround(v));
+    }
+    static uint16_t to_u16(float v) {
+        if (!(v > 0.0f)) return 0;
+        if (v > 65535.0f) return 65535;
+        return static_cast<uint16_t>(std::lround(v));
+    }
+};
+static_assert(sizeof(CompactCollisionEvent) == 20, "CompactCollisionEvent is part of the JS ABI");
+
+/**
+ * ContactEventQueue - begin/stay/end contact stream for JS
+ *
+ * The physics step reports every contact matching the stream's filter
+ * (touch), then end_step merges them per body pair: a pair that starts
+ * touching emits Begin, one that keeps touching emits Stay only if its
+ * rule asks, and one untouched for more than grace_steps emits End. A
+ * pair hit several times in a step yields one record. min_impulse gates
+ * Begin only; once tracked, a resting contact keeps the pair alive.
+ * Events for a step come out sorted by pair. With no rules the stream is
+ * off and costs nothing.
+ */
+class ContactEventQueue : public SpscRing<CompactCollisionEvent, 256> {
+public:
+    // Producer-side configuration: change only while no step runs
+    PhysicsEventFilter& filter() { return filter_; }
+    bool active() const { return !filter_.empty(); }
+
+    bool wants(uint32_t layer_a, uint32_t layer_b) const {
+        return active() && filter_.match(layer_a, layer_b) != nullptr;
+    }
+
+    void touch(const CollisionEvent& ev, uint32_t layer_a, uint32_t layer_b) {
+        const PhysicsEventFilter::Rule* rule = filter_.match(layer_a, layer_b);
+        if (!rule) return;
+        const uint64_t key = pair_key(ev.bodyA, ev.bodyB);
+        if (ev.impulse < rule->min_impulse && !was_touching(key)) return;
+        Tracked t;
+        t.key = key;
+        t.seq = static_cast<uint32_t>(current_.size());
+        t.idle_steps = 0;
+        t.report_stay = rule->report_stay;
+        t.event = CompactCollisionEvent::quantize(ev);
+        current_.push_back(t);
+    }
+
+    void end_step() {
+        if (current_.empty() && previous_.empty()) return;
+        std::sort(current_.begin(), current_.end(), [](const Tracked& a, const Tracked& b) {
+            return a.key != b.key ? a.key < b.key : a.seq < b.seq;
+        });
+        // Collapse repeat hits on a pair to its first record, keeping the largest impulse
+        size_t unique = 0;
+        for (size_t i = 0; i < current_.size(); ++i) {
+            if (unique > 0 && current_[unique - 1].key == current_[i].key) {
+                uint16_t& impulse = current_[unique - 1].event.impulse;
+                impulse = std::max(impulse, current_[i].event.impulse);
+            } else {
+                current_[unique++] = current_[i];
+            }
+        }
+        current_.resize(unique);
+
+        // Merge with the tracked set (both sorted by key) into next_
+        next_.clear();
+        size_t i = 0, j = 0;
+        while (i < current_.size() || j < previous_.size()) {
+            if (j == previous_.size() || (i < current_.size() && current_[i].key < previous_[j].key)) {
+                emit(current_[i].event, ContactPhase::Begin);
+                next_.push_back(current_[i++]);
+            } else if (i == current_.size() || previous_[j].key < current_[i].key) {
+                Tracked idle = previous_[j++];
+                if (++idle.idle_steps > grace_steps_) {
+                    idle.event.impulse = 0;
+                    emit(idle.event, ContactPhase::End);
+                } else {
+                    next_.push_back(idle);
+                }
+            } else {
+                if (current_[i].report_stay) {
+                    emit(current_[i].event, ContactPhase::Stay);
+                }
+                next_.push_back(current_[i++]);
+                ++j;
             }
-            buffer_[CAPACITY - 1] = e;
         }
+        previous_.swap(next_);
+        current_.clear();
     }
 
-    const CollisionEvent *data() const { return buffer_; }
-    int count() const { return count_; }
+    // Steps a pair may go untouched before End (collision response separates
+    // bodies past contact, so jostling pairs touch on alternate steps)
+    void set_grace_steps(uint32_t steps) { grace_steps_ = steps; }
+    uint32_t grace_steps() const { return grace_steps_; }
+
+    // Ends every tracked contact now (after a rollback the stream restarts from Begin)
+    void end_all() {
+        for (Tracked& t : previous_) {
+            t.event.impulse = 0;
+            emit(t.event, ContactPhase::End);
+        }
+        previous_.clear();
+        current_.clear();
+    }
 
 private:
-    CollisionEvent buffer_[CAPACITY];
-    int count_;
+    struct Tracked {
+        uint64_t key;
+        uint32_t seq;         // Order of arrival within the step
+        uint32_t idle_steps;  // Steps since the pair last touched
+        bool report_stay;
+        CompactCollisionEvent event;
+    };
+
+    static constexpr uint32_t DEFAULT_GRACE_STEPS = 6;
+
+    PhysicsEventFilter filter_;
+    uint32_t grace_steps_ = DEFAULT_GRACE_STEPS;
+    std::vector<Tracked> current_;   // Touched this step, in arrival order until end_step
+    std::vector<Tracked> previous_;  // Live contacts, sorted by key
+    std::vector<Tracked> next_;
+
+    static uint64_t pair_key(uint32_t a, uint32_t b) {
+        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+    }
+
+    bool was_touching(uint64_t key) const {
+        auto it = std::lower_bound(previous_.begin(), previous_.end(), key,
+                                   [](const Tracked& t, uint64_t k) { return t.key < k; });
+        return it != previous_.end() && it->key == key;
+    }
+
+    void emit(CompactCollisionEvent ev, ContactPhase phase) {
+        ev.phase = static_cast<uint8_t>(phase);
+        push(ev);
+    }
 };
 
-// Provide a single instance accessible across the physics system
-inline PhysicsEventQueue &GetPhysicsEventQueue() {
-    static PhysicsEventQueue queue;
-    return queue;
-}
+/**
+ * PhysicsEventQueue - collision events published by the physics step
+ *
+ * Each PhysicsManager owns one (get_event_queue), so independent
+ * simulations never share events. The physics step is the only producer;
+ * the coordinator or JS is the only consumer. See SpscRing for the
+ * span-based read protocol.
+ *
+ * This ring carries one full-precision event per resolved contact that
+ * passes filter(); with no rules every contact is recorded. The
+ * coordinator registers the pairs it acts on. contacts() is the compact
+ * begin/stay/end stream for JS, filtered separately.
+ */
+class PhysicsEventQueue : public SpscRing<CollisionEvent, 256> {
+public:
+    static constexpr uint32_t GROUND_ID = 0xFFFFFFFFu;
+
+    // Producer-side configuration: change only while no step runs
+    PhysicsEventFilter& filter() { return filter_; }
+    ContactEventQueue& contacts() { return contacts_; }
+    const ContactEventQueue& contacts() const { return contacts_; }
+
+    // Whether a contact between these layers goes anywhere; skip building the event if not
+    bool wants(uint32_t layer_a, uint32_t layer_b) {
+        if (filter_.empty() || filter_.match(layer_a, layer_b) || contacts_.wants(layer_a, layer_b)) {
+            return true;
+        }
+        filtered_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // A contact whose response applied an impulse
+    void record(const CollisionEvent& ev, uint32_t layer_a, uint32_t layer_b) {
+        const PhysicsEventFilter::Rule* rule = filter_.empty() ? nullptr : filter_.match(layer_a, layer_b);
+        if (filter_.empty() || (rule && ev.impulse >= rule->min_impulse)) {
+            push(ev);
+        } else {
+            filtered_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (contacts_.active()) {
+            contacts_.touch(ev, layer_a, layer_b);
+        }
+    }
 
+    // A contact resolved without an impulse (resting); only the contact stream sees it
+    bool tracking_contacts(uint32_t layer_a, uint32_t layer_b) const { return contacts_.wants(layer_a, layer_b); }
+    void record_resting(const CollisionEvent& ev, uint32_t layer_a, uint32_t layer_b) {
+        contacts_.touch(ev, layer_a, layer_b);
+    }
+
+    // Called once at the end of every physics step
+    void end_step() {
+        if (contacts_.active()) {
+            contacts_.end_step();
+        }
+    }
 
+    // Monotonic count of contacts the filter kept out of this ring
+    uint32_t filtered() const { return filtered_.load(std::memory_order_relaxed); }
+
+private:
+    PhysicsEventFilter filter_;
+    ContactEventQueue contacts_;
+    std::atomic<uint32_t> filtered_{0};
+};
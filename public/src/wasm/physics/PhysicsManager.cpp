@@ -1,14 +1,34 @@
 #include "PhysicsManager.h"
 #include <algorithm>
+#include <cmath>
 #include "CollisionLayers.h"
 #include "CollisionResolver.h"
 #include "PhysicsEvents.h"
 #include "SpatialHash.h"
 #include "ForceField.h"
+#include "StaticGeometry.h"
+#include "FixedSimd.h"
+#include "PhysicsWorker.h"
+#include "../Profiler.h"
+
+namespace {
+// floor(sqrt(n)); the float estimate is corrected with integer steps, so the result is exact
+inline uint64_t isqrt_u64(uint64_t n) {
+    if (n < 2) return n;
+    uint64_t r = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+    while (r * r > n) --r;
+    while ((r + 1) * (r + 1) <= n) ++r;
+    return r;
+}
+
+inline int64_t dot_raw(const FixedVector3& a, const FixedVector3& b) {
+    return static_cast<int64_t>(a.x.raw) * b.x.raw + static_cast<int64_t>(a.y.raw) * b.y.raw +
+           static_cast<int64_t>(a.z.raw) * b.z.raw;
+}
+}
 
 PhysicsManager::PhysicsManager() 
-    : next_body_id_(1)
-    , tick_accumulator_(0)
+    : tick_accumulator_(0)
     , last_step_time_ms_(0.0f)
     , spatial_hash_(nullptr)
     , force_field_mgr_(nullptr)
@@ -19,42 +39,76 @@ PhysicsManager::PhysicsManager()
 }
 
 PhysicsManager::~PhysicsManager() {
+    set_worker_enabled(false);
     delete spatial_hash_;
+    delete sleeper_hash_;
+    delete query_hash_;
     delete force_field_mgr_;
+    delete static_geometry_;
 }
 
 void PhysicsManager::initialize(const PhysicsConfig& config) {
+    wait_for_worker();
+    commands_.clear();
     config_ = config;
-    bodies_.clear();
-    body_id_to_index_.clear();
-    bodies_.reserve(config.max_bodies);
+    reserve_bodies(config.max_bodies > 0 ? static_cast<size_t>(config.max_bodies) : 0);
     tick_accumulator_ = 0;
-    next_body_id_ = 1;
-    
-    // Create player body (ID 0) at spawn position
-    RigidBody player_body;
-    player_body.id = 0;
-    player_body.type = BodyType::Kinematic;  // Kinematic: not affected by gravity, but can receive knockback
-    player_body.position = FixedVector3::from_floats(0.5f, 0.5f, 0.0f);
-    player_body.mass = Fixed::from_int(70);
-    player_body.inverse_mass = Fixed::from_float(1.0f / 70.0f);  // Non-zero to allow knockback
-    player_body.drag = Fixed::from_float(0.88f);  // Faster deceleration for responsive knockback
-    player_body.radius = Fixed::from_float(0.05f);
-    player_body.collision_layer = CollisionLayers::Player;
-    player_body.collision_mask = CollisionLayers::Enemy | CollisionLayers::Environment;
-    body_id_to_index_[player_body.id] = bodies_.size();
-    bodies_.push_back(player_body);
+    dropped_micros_ = 0;
+    step_tick_ = 0;
+    clear_frame_hashes();
+    clear_force_fields();
+    clear_static_colliders();
+    if (spatial_hash_) {
+        spatial_hash_->setCellSize(config_.broadphase_cell_size);
+    }
+    reset_bodies();
+    refresh_read_snapshot();
 }
 
 void PhysicsManager::reset() {
-    bodies_.clear();
-    body_id_to_index_.clear();
+    wait_for_worker();
+    commands_.clear();
     distance_constraints_.clear();
     range_constraints_.clear();
+    body_constraints_.clear();
+    constraint_colors_dirty_ = true;
     tick_accumulator_ = 0;
-    next_body_id_ = 1;
+    dropped_micros_ = 0;
+    step_tick_ = 0;
+    clear_frame_hashes();
+    clear_force_fields();
+    clear_static_colliders();
+    reset_bodies();
+    refresh_read_snapshot();
+}
+
+void PhysicsManager::reserve_bodies(size_t count) {
+    wait_for_worker();
+    bodies_.reserve(count);
+    body_handles_.reserve(count);
+    body_index_.reserve(count);
+    island_parent_.reserve(count);
+    island_head_.reserve(count);
+    island_tail_.reserve(count);
+    island_ready_.reserve(count);
+    touched_islands_.reserve(count);
+    for (PhysicsSnapshot& snapshot : snapshots_) {
+        snapshot.bodies.reserve(count);
+        snapshot.slot_of_id.reserve(count);
+    }
+}
+
+void PhysicsManager::reset_bodies() {
+    bodies_.clear();
+    body_handles_.clear();
+    body_index_.clear();
+    bullet_ids_.clear();
+    awake_count_ = 0;
+    sleeper_hash_dirty_ = true;
+    query_hash_dirty_ = true;
+    constraint_rows_dirty_ = true;
     
-    // Recreate player body
+    // Player body: the first handle of a fresh registry, so always ID 0
     RigidBody player_body;
     player_body.id = 0;
     player_body.type = BodyType::Kinematic;  // Kinematic: not affected by gravity, but can receive knockback
@@ -65,140 +119,876 @@ void PhysicsManager::reset() {
     player_body.radius = Fixed::from_float(0.05f);
     player_body.collision_layer = CollisionLayers::Player;
     player_body.collision_mask = CollisionLayers::Enemy | CollisionLayers::Environment;
-    body_id_to_index_[player_body.id] = bodies_.size();
-    bodies_.push_back(player_body);
+    add_body(player_body);
+}
+
+uint32_t PhysicsManager::add_body(RigidBody body) {
+    body.id = body_handles_.create();
+    if (body.id == INVALID_ENTITY) {
+        return INVALID_ENTITY;
+    }
+    const size_t index = bodies_.size();
+    body_index_.set(body.id, static_cast<uint32_t>(index));
+    bodies_.push_back(body);
+    if (is_awake_row(index)) {
+        move_body(index, awake_count_++);
+    }
+    // Either way a sleeping or static row may have moved
+    sleeper_hash_dirty_ = true;
+    query_hash_dirty_ = true;
+    constraint_rows_dirty_ = true;
+    return body.id;
+}
+
+bool PhysicsManager::is_awake_row(size_t index) const {
+    const BodyType type = bodies_.types()[index];
+    return type != BodyType::Static && !(type == BodyType::Dynamic && bodies_.sleep_states()[index].is_sleeping);
+}
+
+void PhysicsManager::move_body(size_t from, size_t to) {
+    if (from == to) return;
+    bodies_.swap(from, to);
+    body_index_.set(bodies_.ids()[from], static_cast<uint32_t>(from));
+    body_index_.set(bodies_.ids()[to], static_cast<uint32_t>(to));
+    constraint_rows_dirty_ = true;
+    query_hash_dirty_ = true;
 }
 
 void PhysicsManager::update(float delta_time) {
-    if (delta_time <= 0.0f) {
+    if (!(delta_time > 0.0f)) {  // Also rejects NaN
         return;
     }
     
-    // Convert delta time to microseconds (integer for determinism)
-    const int32_t dt_micros = static_cast<int32_t>(delta_time * 1000000.0f);
-    tick_accumulator_ += dt_micros;
-    
+#if DOZEDENT_PHYSICS_THREADS
+    if (worker_) {
+        // Returns immediately; readers see the previous update's snapshot this frame
+        worker_->kick(delta_time);
+        return;
+    }
+#endif
+    drain_commands();
+    run_update(delta_time);
+}
+
+void PhysicsManager::run_update(float delta_time) {
     const int32_t fixed_step_micros = config_.timestep_micros;
+    const int max_steps = std::max(1, config_.max_iterations);
+    
+    // Convert delta time to microseconds (integer for determinism). A frame
+    // longer than max_steps can simulate is clamped first so a long stall
+    // (background tab) cannot overflow the accumulator.
+    const float frame_micros = delta_time * 1000000.0f;
+    const float max_frame_micros = static_cast<float>(fixed_step_micros) * static_cast<float>(max_steps + 1);
+    int32_t dt_micros;
+    if (frame_micros < max_frame_micros) {
+        dt_micros = static_cast<int32_t>(frame_micros);
+    } else {
+        dt_micros = fixed_step_micros * (max_steps + 1);
+        if (std::isfinite(frame_micros)) {
+            dropped_micros_ += static_cast<int64_t>(std::min(frame_micros, 1.0e15f)) - dt_micros;
+        }
+    }
+    tick_accumulator_ += dt_micros;
     
     // Fixed timestep loop
+    const double start_ms = perf_now_ms();
     int steps_taken = 0;
-    while (tick_accumulator_ >= fixed_step_micros && steps_taken < config_.max_iterations) {
+    while (tick_accumulator_ >= fixed_step_micros && steps_taken < max_steps) {
         Fixed dt_fixed = config_.get_timestep_fixed();
         step(dt_fixed);
         tick_accumulator_ -= fixed_step_micros;
         steps_taken++;
+        // Machine-dependent: the one place wall-clock time changes the simulation
+        if (step_budget_ms_ > 0.0f && perf_now_ms() - start_ms >= step_budget_ms_) {
+            break;
+        }
+    }
+    
+    // Whole steps left over are dropped rather than carried into the next
+    // frame; the sub-step remainder stays for interpolation
+    if (tick_accumulator_ >= fixed_step_micros) {
+        const int32_t whole_steps = tick_accumulator_ / fixed_step_micros;
+        dropped_micros_ += static_cast<int64_t>(whole_steps) * fixed_step_micros;
+        tick_accumulator_ -= whole_steps * fixed_step_micros;
     }
     
     // Track performance (non-deterministic, for monitoring only)
-    last_step_time_ms_ = steps_taken * (fixed_step_micros / 1000.0f);
+    last_step_time_ms_ = static_cast<float>(perf_now_ms() - start_ms);
+    last_steps_taken_ = steps_taken;
+    
+    if (worker_) {
+        // Publish into the buffer readers are not using, then flip
+        const int back = 1 - read_snapshot_;
+        publish_snapshot(snapshots_[back]);
+        front_snapshot_.store(back, std::memory_order_release);
+    }
+}
+
+// ============================================================================
+// THREADED STEPPING
+// ============================================================================
+
+void PhysicsManager::set_worker_enabled(bool enabled) {
+#if DOZEDENT_PHYSICS_THREADS
+    if (enabled && !worker_) {
+        publish_snapshot(snapshots_[0]);
+        front_snapshot_.store(0, std::memory_order_release);
+        read_snapshot_ = 0;
+        worker_ = new PhysicsWorker(*this);
+    } else if (!enabled && worker_) {
+        worker_->wait_idle();
+        delete worker_;
+        worker_ = nullptr;
+        drain_commands();
+    }
+#else
+    (void)enabled;
+#endif
+}
+
+void PhysicsManager::wait_for_worker() const {
+#if DOZEDENT_PHYSICS_THREADS
+    if (worker_) {
+        worker_->wait_idle();
+    }
+#endif
+}
+
+void PhysicsManager::latch_snapshot() {
+    read_snapshot_ = front_snapshot_.load(std::memory_order_acquire);
+}
+
+void PhysicsManager::refresh_read_snapshot() {
+    // Only valid while the worker is idle: rebuild what readers see after a structural change
+    if (!worker_) {
+        return;
+    }
+    latch_snapshot();
+    publish_snapshot(snapshots_[read_snapshot_]);
+}
+
+void PhysicsManager::publish_snapshot(PhysicsSnapshot& snapshot) const {
+    const size_t count = bodies_.size();
+    snapshot.bodies.resize(count);
+    snapshot.slot_of_id.assign(body_handles_.slot_count(), -1);
+    
+    const uint32_t* ids = bodies_.ids();
+    const BodyType* types = bodies_.types();
+    const FixedVector3* positions = bodies_.positions();
+    const FixedVector3* velocities = bodies_.velocities();
+    const FixedVector3* previous = bodies_.previous_positions();
+    const BodyStore::SleepState* sleep = bodies_.sleep_states();
+    for (size_t i = 0; i < count; ++i) {
+        BodySnapshot& b = snapshot.bodies[i];
+        b.id = ids[i];
+        b.type = types[i];
+        b.position = positions[i];
+        b.velocity = velocities[i];
+        b.previous_position = i < awake_count_ ? previous[i] : positions[i];
+        b.is_sleeping = sleep[i].is_sleeping;
+        if (entity_slot(ids[i]) < snapshot.slot_of_id.size()) {
+            snapshot.slot_of_id[entity_slot(ids[i])] = static_cast<int32_t>(i);
+        }
+    }
+    snapshot.step_count++;
+    snapshot.alpha = static_cast<float>(tick_accumulator_) / static_cast<float>(config_.timestep_micros);
+}
+
+int PhysicsManager::write_interpolated_positions(float alpha, InterpolatedBody* out, int capacity) const {
+    if (!out || capacity <= 0) {
+        return 0;
+    }
+    const float t = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+    const auto lerp = [t](Fixed from, Fixed to) {
+        const float a = from.to_float();
+        return a + (to.to_float() - a) * t;
+    };
+    
+    if (worker_) {
+        const std::vector<BodySnapshot>& bodies = snapshots_[read_snapshot_].bodies;
+        const int count = std::min(capacity, static_cast<int>(bodies.size()));
+        for (int i = 0; i < count; ++i) {
+            const BodySnapshot& b = bodies[static_cast<size_t>(i)];
+            out[i] = InterpolatedBody{ b.id, lerp(b.previous_position.x, b.position.x),
+                lerp(b.previous_position.y, b.position.y), lerp(b.previous_position.z, b.position.z) };
+        }
+        return count;
+    }
+    
+    const int count = std::min(capacity, static_cast<int>(bodies_.size()));
+    const int awake = std::min(count, static_cast<int>(awake_count_));
+    const uint32_t* ids = bodies_.ids();
+    const FixedVector3* positions = bodies_.positions();
+    const FixedVector3* previous = bodies_.previous_positions();
+    for (int i = 0; i < awake; ++i) {
+        out[i] = InterpolatedBody{ ids[i], lerp(previous[i].x, positions[i].x),
+            lerp(previous[i].y, positions[i].y), lerp(previous[i].z, positions[i].z) };
+    }
+    for (int i = awake; i < count; ++i) {
+        out[i] = InterpolatedBody{ ids[i], positions[i].x.to_float(), positions[i].y.to_float(),
+            positions[i].z.to_float() };
+    }
+    return count;
+}
+
+float PhysicsManager::get_interpolation_alpha() const {
+    if (worker_) {
+        return snapshots_[read_snapshot_].alpha;
+    }
+    return static_cast<float>(tick_accumulator_) / static_cast<float>(config_.timestep_micros);
+}
+
+bool PhysicsManager::read_body(uint32_t id, BodySnapshot& out) const {
+    if (worker_) {
+        const BodySnapshot* snap = snapshots_[read_snapshot_].find(id);
+        if (!snap) {
+            return false;
+        }
+        out = *snap;
+        return true;
+    }
+    
+    ConstBodyHandle body = find_body(id);
+    if (!body) {
+        return false;
+    }
+    out.id = body->id;
+    out.type = body->type;
+    out.position = body->position;
+    out.velocity = body->velocity;
+    out.is_sleeping = body->is_sleeping;
+    return true;
+}
+
+int PhysicsManager::query_overlap(const QueryShape& shape, uint32_t layer_mask, std::vector<uint32_t>& out_ids) {
+    out_ids.clear();
+    wait_for_worker();
+    if (bodies_.size() == 0 || layer_mask == 0) {
+        return 0;
+    }
+    
+    if (!query_hash_) {
+        query_hash_ = new SpatialHash();
+        query_hash_->setCellSize(config_.broadphase_cell_size);
+    }
+    if (query_hash_dirty_) {
+        query_hash_->update(bodies_, 0, bodies_.size(), SpatialHash::Gather::Any);
+        query_hash_dirty_ = false;
+    }
+    
+    FixedVector3 center;
+    Fixed reach;
+    shape.bounds(center, reach);
+    query_candidates_.clear();
+    query_hash_->queryCandidates(center, reach, query_candidates_);
+    // Row order, independent of how the grid buckets the candidates
+    std::sort(query_candidates_.begin(), query_candidates_.end());
+    
+    const uint32_t* ids = bodies_.ids();
+    const uint32_t* layers = bodies_.layers();
+    const FixedVector3* positions = bodies_.positions();
+    const Fixed* radii = bodies_.radii();
+    for (uint32_t row : query_candidates_) {
+        if ((layers[row] & layer_mask) != 0u && shape.overlaps(positions[row], radii[row])) {
+            out_ids.push_back(ids[row]);
+        }
+    }
+    return static_cast<int>(out_ids.size());
+}
+
+void PhysicsManager::submit(const PhysicsCommand& command) {
+    if (worker_) {
+        if (commands_.push(command)) {
+            return;
+        }
+        // Queue full: let the worker finish, then apply in order on this thread
+        wait_for_worker();
+        drain_commands();
+    }
+    execute_command(command);
+}
+
+void PhysicsManager::drain_commands() {
+    // Main-thread handoff point (worker idle): also latch the next update's hash salt
+    frame_salt_ = pending_frame_salt_;
+    collect_frame_hashes();
+    const PhysicsCommand* commands = nullptr;
+    while (int count = commands_.peek(&commands)) {
+        for (int i = 0; i < count; ++i) {
+            execute_command(commands[i]);
+        }
+        commands_.consume(count);
+    }
 }
 
 void PhysicsManager::step(Fixed dt) {
     // Integrate forces for all dynamic bodies
-    if (force_field_mgr_) {
-        // Force fields modify accelerations before integration
-        force_field_mgr_->apply(bodies_, dt);
+    {
+        PROFILE_ZONE(PROFILE_PHYSICS_INTEGRATE);
+        bodies_.latch_previous_positions(awake_count_);
+        if (force_field_mgr_) {
+            // Force fields modify accelerations before integration
+            force_field_mgr_->apply(bodies_, awake_count_, dt);
+        }
+        integrate_forces(dt);
     }
-    integrate_forces(dt);
     
     // Detect and resolve collisions
-    detect_and_resolve_collisions();
+    {
+        PROFILE_ZONE(PROFILE_PHYSICS_COLLIDE);
+        detect_and_resolve_collisions();
+        sweep_bullets(dt);
+        events_.end_step();
+    }
     // Solve constraints after collision resolution
-    solve_constraints(4);
+    {
+        PROFILE_ZONE(PROFILE_PHYSICS_CONSTRAINTS);
+        solve_constraints(4);
+    }
     
     // Update sleeping state for all bodies
-    update_sleeping_bodies(config_.timestep_micros);
+    {
+        PROFILE_ZONE(PROFILE_PHYSICS_SLEEP);
+        update_sleeping_bodies(config_.timestep_micros);
+    }
+    
+    ++step_tick_;
+    query_hash_dirty_ = true;
+    if (frame_hash_enabled_) {
+        record_step_hash();
+    }
 }
 
-void PhysicsManager::integrate_forces(Fixed dt) {
-    for (auto& body : bodies_) {
-        if (!body.should_simulate()) {
-            continue;
-        }
-        
-        // For Kinematic bodies, skip gravity but still apply drag and integrate
-        FixedVector3 total_accel = body.acceleration;
-        if (body.type == BodyType::Dynamic) {
-            total_accel += config_.gravity;
-        }
-        body.velocity += total_accel * dt;
-        
-        // Clear acceleration (forces are applied for one frame only)
-        body.acceleration = FixedVector3::zero();
-        
-        // Apply drag (per-step damping)
-        body.velocity *= body.drag;
-        
-        // Clamp velocity to prevent extreme speeds
-        Fixed speed_sq = body.velocity.length_squared();
-        Fixed max_speed_sq = config_.max_velocity * config_.max_velocity;
-        
-        if (speed_sq > max_speed_sq) {
-            body.velocity = body.velocity.normalized() * config_.max_velocity;
-        }
-        
-        // Stop very small velocities to allow sleeping
-        Fixed min_velocity_threshold = Fixed::from_float(0.001f);
-        if (speed_sq < min_velocity_threshold * min_velocity_threshold) {
-            body.velocity = FixedVector3::zero();
+// ============================================================================
+// FORCE FIELDS
+// ============================================================================
+
+ForceFieldManager& PhysicsManager::force_fields() {
+    if (!force_field_mgr_) {
+        force_field_mgr_ = new ForceFieldManager();
+    }
+    return *force_field_mgr_;
+}
+
+uint32_t PhysicsManager::add_force_field(const ForceField& field, int32_t lifetime_steps) {
+    wait_for_worker();
+    return force_fields().add(field, lifetime_steps);
+}
+
+bool PhysicsManager::remove_force_field(uint32_t id) {
+    wait_for_worker();
+    return force_field_mgr_ && force_field_mgr_->remove(id);
+}
+
+void PhysicsManager::clear_force_fields() {
+    wait_for_worker();
+    if (force_field_mgr_) {
+        force_field_mgr_->clear();
+    }
+}
+
+int PhysicsManager::get_force_field_count() const {
+    wait_for_worker();
+    return force_field_mgr_ ? static_cast<int>(force_field_mgr_->size()) : 0;
+}
+
+uint32_t PhysicsManager::get_force_field_evaluations() const {
+    wait_for_worker();
+    return force_field_mgr_ ? force_field_mgr_->get_evaluations() : 0;
+}
+
+// ============================================================================
+// STATIC GEOMETRY
+// ============================================================================
+
+StaticGeometry& PhysicsManager::static_geometry() {
+    if (!static_geometry_) {
+        static_geometry_ = new StaticGeometry();
+    }
+    return *static_geometry_;
+}
+
+uint32_t PhysicsManager::add_static_collider(const StaticCollider& collider) {
+    wait_for_worker();
+    return static_geometry().add(collider);
+}
+
+bool PhysicsManager::remove_static_collider(uint32_t id) {
+    wait_for_worker();
+    return static_geometry_ && static_geometry_->remove(id);
+}
+
+int PhysicsManager::remove_static_colliders(uint32_t owner) {
+    wait_for_worker();
+    return static_geometry_ ? static_geometry_->remove_owner(owner) : 0;
+}
+
+void PhysicsManager::clear_static_colliders() {
+    wait_for_worker();
+    if (static_geometry_) {
+        static_geometry_->clear();
+    }
+}
+
+int PhysicsManager::get_static_collider_count() const {
+    wait_for_worker();
+    return static_geometry_ ? static_cast<int>(static_geometry_->size()) : 0;
+}
+
+uint32_t PhysicsManager::get_static_tests() const {
+    wait_for_worker();
+    return static_geometry_ ? static_geometry_->get_tests() : 0;
+}
+
+bool PhysicsManager::resolve_static_circle(float& x, float& y, float radius, uint32_t layer) {
+    if (!static_geometry_ || static_geometry_->empty()) return false;
+    wait_for_worker();
+    Fixed fx = Fixed::from_float(x);
+    Fixed fy = Fixed::from_float(y);
+    if (!static_geometry_->push_out(fx, fy, Fixed::from_float(radius), layer)) return false;
+    x = fx.to_float();
+    y = fy.to_float();
+    return true;
+}
+
+void PhysicsManager::set_world_bounds(float min_x, float min_y, float max_x, float max_y) {
+    wait_for_worker();
+    config_.world_min_x = Fixed::from_float(min_x);
+    config_.world_min_y = Fixed::from_float(min_y);
+    config_.world_max_x = Fixed::from_float(max_x);
+    config_.world_max_y = Fixed::from_float(max_y);
+}
+
+// ============================================================================
+// FRAME HASHES
+// ============================================================================
+
+void PhysicsManager::record_step_hash() {
+    FrameHasher h(step_tick_);
+    h.add(frame_salt_);
+    bodies_.hash_state(h);
+    for (uint32_t id : bullet_ids_) {
+        h.add(id);
+    }
+    // Nothing mixed in without fields, so field-free hashes match older builds
+    if (force_field_mgr_ && !force_field_mgr_->empty()) {
+        force_field_mgr_->hash_state(h);
+    }
+    if (static_geometry_ && !static_geometry_->empty()) {
+        static_geometry_->hash_state(h);
+    }
+    // Drained every update; a full ring (hashing without updates) just drops
+    step_hashes_.push(FrameHashEntry{ step_tick_, h.finish() });
+}
+
+void PhysicsManager::collect_frame_hashes() {
+    const FrameHashEntry* entries = nullptr;
+    while (int count = step_hashes_.peek(&entries)) {
+        for (int i = 0; i < count; ++i) {
+            frame_hashes_.record(entries[i].tick, entries[i].hash);
         }
-        
-        // Integrate velocity to position
-        body.position += body.velocity * dt;
-        
-        // Apply world bounds
-        apply_world_bounds(body);
+        step_hashes_.consume(count);
+    }
+}
+
+bool PhysicsManager::get_frame_hash(uint32_t tick, uint64_t& out) {
+    if (!worker_) {
+        collect_frame_hashes();
+    }
+    return frame_hashes_.find(tick, out);
+}
+
+uint32_t PhysicsManager::get_latest_hashed_tick() {
+    if (!worker_) {
+        collect_frame_hashes();
+    }
+    return frame_hashes_.latest_tick();
+}
+
+void PhysicsManager::clear_frame_hashes() {
+    wait_for_worker();
+    step_hashes_.clear();
+    frame_hashes_.clear();
+}
+
+void PhysicsManager::integrate_forces(Fixed dt) {
+    // Scalar in every build: a 4-wide version lost to this loop (see FixedSimd.h)
+    for (size_t i = 0; i < awake_count_; ++i) {
+        integrate_body(i, dt);
     }
 }
 
-void PhysicsManager::apply_world_bounds(RigidBody& body) {
+void PhysicsManager::integrate_body(size_t i, Fixed dt) {
+    // Streams only the hot arrays: type, sleep flag, velocity, acceleration, drag, position
+    const BodyType type = bodies_.types()[i];
+    FixedVector3& velocity = bodies_.velocities()[i];
+    FixedVector3& acceleration = bodies_.accelerations()[i];
+    
+    // Static never moves, sleeping never moves, kinematic only while it has velocity
+    if (type == BodyType::Static || bodies_.sleep_states()[i].is_sleeping) {
+        return;
+    }
+    if (type == BodyType::Kinematic && velocity.is_zero()) {
+        return;
+    }
+    
+    // For Kinematic bodies, skip gravity but still apply drag and integrate
+    FixedVector3 total_accel = acceleration;
+    if (type == BodyType::Dynamic) {
+        total_accel += config_.gravity;
+    }
+    velocity += total_accel * dt;
+    
+    // Clear acceleration (forces are applied for one frame only)
+    acceleration = FixedVector3::zero();
+    
+    // Apply drag (per-step damping)
+    velocity *= bodies_.drags()[i];
+    
+    // Clamp velocity to prevent extreme speeds
+    Fixed speed_sq = velocity.length_squared();
+    Fixed max_speed_sq = config_.max_velocity * config_.max_velocity;
+    
+    if (speed_sq > max_speed_sq) {
+        velocity = velocity.normalized() * config_.max_velocity;
+    }
+    
+    // Stop very small velocities to allow sleeping
+    Fixed min_velocity_threshold = Fixed::from_float(0.001f);
+    if (speed_sq < min_velocity_threshold * min_velocity_threshold) {
+        velocity = FixedVector3::zero();
+    }
+    
+    // Integrate velocity to position
+    bodies_.positions()[i] += velocity * dt;
+    
+    // Apply world bounds
+    apply_world_bounds(i);
+}
+
+void PhysicsManager::apply_world_bounds(size_t index) {
+    FixedVector3& position = bodies_.positions()[index];
+    FixedVector3& velocity = bodies_.velocities()[index];
     bool collision_occurred = false;
     
     // X bounds
-    if (body.position.x < config_.world_min_x) {
-        body.position.x = config_.world_min_x;
-        body.velocity.x = Fixed::from_int(0);
+    if (position.x < config_.world_min_x) {
+        position.x = config_.world_min_x;
+        velocity.x = Fixed::from_int(0);
         collision_occurred = true;
-    } else if (body.position.x > config_.world_max_x) {
-        body.position.x = config_.world_max_x;
-        body.velocity.x = Fixed::from_int(0);
+    } else if (position.x > config_.world_max_x) {
+        position.x = config_.world_max_x;
+        velocity.x = Fixed::from_int(0);
         collision_occurred = true;
     }
     
     // Y bounds
-    if (body.position.y < config_.world_min_y) {
-        body.position.y = config_.world_min_y;
-        body.velocity.y = Fixed::from_int(0);
+    if (position.y < config_.world_min_y) {
+        position.y = config_.world_min_y;
+        velocity.y = Fixed::from_int(0);
         collision_occurred = true;
-    } else if (body.position.y > config_.world_max_y) {
-        body.position.y = config_.world_max_y;
-        body.velocity.y = Fixed::from_int(0);
+    } else if (position.y > config_.world_max_y) {
+        position.y = config_.world_max_y;
+        velocity.y = Fixed::from_int(0);
         collision_occurred = true;
     }
     
     // Wake body if it hit a wall
     if (collision_occurred) {
-        body.wake();
+        BodyStore::SleepState& sleep = bodies_.sleep_states()[index];
+        sleep.is_sleeping = false;
+        sleep.sleep_timer_ticks = 0;
     }
 }
 
 void PhysicsManager::update_sleeping_bodies(int32_t timestep_micros) {
-    for (auto& body : bodies_) {
-        body.update_sleep_state(timestep_micros);
+    const uint32_t count = static_cast<uint32_t>(awake_count_);
+    const BodyType* types = bodies_.types();
+    const uint32_t* ids = bodies_.ids();
+    BodyStore::SleepState* sleep = bodies_.sleep_states();
+    FixedVector3* velocities = bodies_.velocities();
+    FixedVector3* accelerations = bodies_.accelerations();
+    
+    // Per-body rest timers
+    for (uint32_t i = 0; i < count; ++i) {
+        if (types[i] != BodyType::Dynamic) {
+            continue;
+        }
+        
+        BodyStore::SleepState& s = sleep[i];
+        Fixed speed_sq = velocities[i].length_squared();
+        Fixed threshold_sq = s.sleep_threshold * s.sleep_threshold;
+        if (speed_sq < threshold_sq) {
+            s.sleep_timer_ticks += timestep_micros;
+        } else {
+            s.sleep_timer_ticks = 0;
+        }
+    }
+    
+    // Islands: dynamic bodies joined by this step's contacts and constraints
+    island_parent_.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        island_parent_[i] = i;
+    }
+    for (const auto& pair : contact_pairs_) {
+        if (types[pair.first] == BodyType::Dynamic && types[pair.second] == BodyType::Dynamic) {
+            unite_islands(pair.first, pair.second);
+        }
+    }
+    const auto unite_bodies = [this, count, types](uint32_t id_a, uint32_t id_b) {
+        const uint32_t a = body_index_.find(id_a);
+        const uint32_t b = body_index_.find(id_b);
+        if (a < count && b < count && types[a] == BodyType::Dynamic && types[b] == BodyType::Dynamic) {
+            unite_islands(a, b);
+        }
+    };
+    for (const DistanceConstraint& c : distance_constraints_.slots()) {
+        unite_bodies(c.bodyA, c.bodyB);
+    }
+    for (const DistanceRangeConstraint& c : range_constraints_.slots()) {
+        unite_bodies(c.bodyA, c.bodyB);
+    }
+    
+    // An island sleeps once every member has rested for 1 second (1,000,000 microseconds)
+    island_ready_.assign(count, 1);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (types[i] == BodyType::Dynamic && sleep[i].sleep_timer_ticks <= 1000000) {
+            island_ready_[find_island(i)] = 0;
+        }
+    }
+    
+    // Put ready islands to sleep, linking each into a ring (row order)
+    island_head_.assign(count, SparseIndex::NONE);
+    island_tail_.resize(count);
+    bool any_slept = false;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (types[i] != BodyType::Dynamic) {
+            continue;
+        }
+        const uint32_t root = find_island(i);
+        if (!island_ready_[root]) {
+            continue;
+        }
+        sleep[i].is_sleeping = true;
+        velocities[i] = FixedVector3::zero();
+        accelerations[i] = FixedVector3::zero();
+        if (island_head_[root] == SparseIndex::NONE) {
+            island_head_[root] = i;
+        } else {
+            sleep[island_tail_[root]].island_next = ids[i];
+        }
+        island_tail_[root] = i;
+        any_slept = true;
+    }
+    if (!any_slept) {
+        return;
+    }
+    for (uint32_t root = 0; root < count; ++root) {
+        if (island_head_[root] != SparseIndex::NONE) {
+            sleep[island_tail_[root]].island_next = ids[island_head_[root]];
+        }
+    }
+    
+    // Move sleepers behind the awake prefix; rows above i are already awake
+    for (uint32_t i = count; i-- > 0;) {
+        if (types[i] == BodyType::Dynamic && sleep[i].is_sleeping) {
+            move_body(i, --awake_count_);
+        }
+    }
+    sleeper_hash_dirty_ = true;
+    query_hash_dirty_ = true;
+}
+
+uint32_t PhysicsManager::find_island(uint32_t index) {
+    while (island_parent_[index] != index) {
+        island_parent_[index] = island_parent_[island_parent_[index]];
+        index = island_parent_[index];
+    }
+    return index;
+}
+
+void PhysicsManager::unite_islands(uint32_t a, uint32_t b) {
+    a = find_island(a);
+    b = find_island(b);
+    if (a != b) {
+        // Lower row is the root, so the result does not depend on pair order
+        if (a < b) {
+            island_parent_[b] = a;
+        } else {
+            island_parent_[a] = b;
+        }
+    }
+}
+
+uint32_t PhysicsManager::wake_at(uint32_t index) {
+    BodyStore::SleepState& s = bodies_.sleep_states()[index];
+    if (bodies_.types()[index] == BodyType::Dynamic && s.is_sleeping) {
+        const uint32_t id = bodies_.ids()[index];
+        wake_island(index);
+        return body_index_.find(id);
+    }
+    s.is_sleeping = false;
+    s.sleep_timer_ticks = 0;
+    return index;
+}
+
+void PhysicsManager::wake_island(uint32_t index) {
+    const uint32_t first = bodies_.ids()[index];
+    uint32_t id = first;
+    do {
+        const uint32_t i = body_index_.find(id);
+        if (i == SparseIndex::NONE) {
+            break;
+        }
+        BodyStore::SleepState& s = bodies_.sleep_states()[i];
+        id = s.island_next;
+        s.is_sleeping = false;
+        s.sleep_timer_ticks = 0;
+        s.island_next = INVALID_ENTITY;
+        // Rested bodies have not moved since; don't interpolate from a stale step
+        bodies_.previous_positions()[i] = bodies_.positions()[i];
+        if (i >= awake_count_) {
+            move_body(i, awake_count_++);
+        }
+    } while (id != first && id != INVALID_ENTITY);
+    sleeper_hash_dirty_ = true;
+    query_hash_dirty_ = true;
+}
+
+void PhysicsManager::wake_touched_islands() {
+    if (awake_count_ == bodies_.size()) {
+        return;
+    }
+    if (!sleeper_hash_) {
+        sleeper_hash_ = new SpatialHash();
+        sleeper_hash_->setCellSize(config_.broadphase_cell_size);
+    }
+    if (sleeper_hash_dirty_) {
+        sleeper_hash_->update(bodies_, awake_count_, bodies_.size(), SpatialHash::Gather::Sleeping);
+        sleeper_hash_dirty_ = false;
+    }
+    if (sleeper_hash_->getEntryCount() == 0) {
+        return;
+    }
+    
+    // Gather first, wake after: waking reorders the sleeping rows the grid refers to
+    const uint32_t* ids = bodies_.ids();
+    const FixedVector3* positions = bodies_.positions();
+    const Fixed* radii = bodies_.radii();
+    const uint32_t* layers = bodies_.layers();
+    const uint32_t* masks = bodies_.masks();
+    touched_islands_.clear();
+    for (size_t i = 0; i < awake_count_; ++i) {
+        if (!bodies_[i].should_collide()) {
+            continue;
+        }
+        touch_candidates_.clear();
+        sleeper_hash_->queryCandidates(positions[i], radii[i], touch_candidates_);
+        for (uint32_t j : touch_candidates_) {
+            if (!shouldCollide(layers[i], masks[i], layers[j], masks[j])) {
+                continue;
+            }
+            const Fixed combined = radii[i] + radii[j];
+            if ((positions[j] - positions[i]).length_squared() < combined * combined) {
+                touched_islands_.push_back(ids[j]);
+            }
+        }
+    }
+    // Bullets also wake what lies along the path they are about to be swept over
+    const FixedVector3* previous = bodies_.previous_positions();
+    for (uint32_t id : bullet_ids_) {
+        const uint32_t i = body_index_.find(id);
+        if (i == SparseIndex::NONE || i >= awake_count_ || !bodies_[i].should_collide()) {
+            continue;
+        }
+        const QueryShape path = QueryShape::capsule(previous[i].x, previous[i].y,
+                                                    positions[i].x, positions[i].y, radii[i]);
+        FixedVector3 center;
+        Fixed reach;
+        path.bounds(center, reach);
+        touch_candidates_.clear();
+        sleeper_hash_->queryCandidates(center, reach, touch_candidates_);
+        for (uint32_t j : touch_candidates_) {
+            if (shouldCollide(layers[i], masks[i], layers[j], masks[j]) && path.overlaps(positions[j], radii[j])) {
+                touched_islands_.push_back(ids[j]);
+            }
+        }
+    }
+    for (uint32_t id : touched_islands_) {
+        const uint32_t index = body_index_.find(id);
+        if (index != SparseIndex::NONE && index >= awake_count_) {
+            wake_island(index);
+        }
+    }
+}
+
+// ============================================================================
+// ROLLBACK SNAPSHOTS
+// ============================================================================
+
+void PhysicsManager::save_state(SnapshotWriter& w) {
+    // Queued commands belong to the next step; apply them so the image is complete
+    wait_for_worker();
+    drain_commands();
+    
+    w.write(config_);
+    body_handles_.save_state(w);
+    w.write(step_tick_);
+    w.write(tick_accumulator_);
+    w.write(use_broadphase_);
+    bodies_.save_state(w);
+    w.write(static_cast<uint32_t>(awake_count_));
+    distance_constraints_.save_state(w);
+    range_constraints_.save_state(w);
+    w.write_vector(bullet_ids_);
+    static const ForceFieldManager no_fields;
+    (force_field_mgr_ ? *force_field_mgr_ : no_fields).save_state(w);
+    static const StaticGeometry no_geometry;
+    (static_geometry_ ? *static_geometry_ : no_geometry).save_state(w);
+}
+
+bool PhysicsManager::load_state(SnapshotReader& r) {
+    wait_for_worker();
+    commands_.clear();
+    // Resimulated ticks overwrite their ring entries as they are stepped again
+    collect_frame_hashes();
+    
+    uint32_t awake_count = 0;
+    const bool ok = r.read(config_) && body_handles_.load_state(r) && r.read(step_tick_) && r.read(tick_accumulator_) &&
+        r.read(use_broadphase_) && bodies_.load_state(r) && r.read(awake_count) &&
+        distance_constraints_.load_state(r) && range_constraints_.load_state(r) &&
+        r.read_vector(bullet_ids_) && force_fields().load_state(r) &&
+        static_geometry().load_state(r);
+    awake_count_ = awake_count <= bodies_.size() ? awake_count : bodies_.size();
+    sleeper_hash_dirty_ = true;
+    query_hash_dirty_ = true;
+    constraint_rows_dirty_ = true;
+    constraint_colors_dirty_ = true;
+    rebuild_constraint_adjacency();
+    
+    // One pass over the restored ids; entries reuse the index's storage
+    const uint32_t* ids = bodies_.ids();
+    body_index_.clear();
+    for (size_t i = 0; i < bodies_.size(); ++i) {
+        body_index_.set(ids[i], static_cast<uint32_t>(i));
+    }
+    if (spatial_hash_) {
+        spatial_hash_->setCellSize(config_.broadphase_cell_size);
     }
+    refresh_read_snapshot();
+    return ok;
 }
 
 uint32_t PhysicsManager::create_body(const RigidBody& body) {
-    RigidBody new_body = body;
-    new_body.id = generate_body_id();
-    body_id_to_index_[new_body.id] = bodies_.size();
-    bodies_.push_back(new_body);
-    return new_body.id;
+    wait_for_worker();
+    const uint32_t id = add_body(body);
+    refresh_read_snapshot();
+    return id;
 }
 
 uint32_t PhysicsManager::create_wolf_body(float x, float y, float radius) {
+    wait_for_worker();
     RigidBody wolf_body;
-    wolf_body.id = generate_body_id();
     wolf_body.type = BodyType::Dynamic;
     wolf_body.position = FixedVector3::from_floats(x, y, 0.0f);
     wolf_body.mass = Fixed::from_int(50);  // Wolves are lighter than player
@@ -210,140 +1000,310 @@ uint32_t PhysicsManager::create_wolf_body(float x, float y, float radius) {
     wolf_body.velocity = FixedVector3::zero();
     wolf_body.acceleration = FixedVector3::zero();
     
-    body_id_to_index_[wolf_body.id] = bodies_.size();
-    bodies_.push_back(wolf_body);
-    return wolf_body.id;
+    const uint32_t id = add_body(wolf_body);
+    refresh_read_snapshot();
+    return id;
 }
 
 void PhysicsManager::destroy_body(uint32_t id) {
-    // Remove any constraints referencing this body
-    distance_constraints_.erase(
-        std::remove_if(distance_constraints_.begin(), distance_constraints_.end(),
-            [id](const DistanceConstraint& c) {
-                return c.bodyA == id || c.bodyB == id;
-            }),
-        distance_constraints_.end()
-    );
-    
-    range_constraints_.erase(
-        std::remove_if(range_constraints_.begin(), range_constraints_.end(),
-            [id](const DistanceRangeConstraint& c) {
-                return c.bodyA == id || c.bodyB == id;
-            }),
-        range_constraints_.end()
-    );
-    
-    // Find the body's index
-    auto map_it = body_id_to_index_.find(id);
-    if (map_it == body_id_to_index_.end()) {
-        return;
-    }
-    
-    size_t index = map_it->second;
+    destroy_bodies(&id, 1);
+}
+
+void PhysicsManager::destroy_bodies(const uint32_t* ids, size_t count) {
+    wait_for_worker();
+    if (!ids || count == 0) return;
     
-    // If not the last element, swap with last and update index
-    if (index < bodies_.size() - 1) {
-        uint32_t last_id = bodies_.back().id;
-        std::swap(bodies_[index], bodies_.back());
-        body_id_to_index_[last_id] = index;
+    for (size_t k = 0; k < count; ++k) {
+        const uint32_t id = ids[k];
+        remove_body_constraints(id);
+        
+        // Find the body's index
+        const uint32_t index_found = body_index_.find(id);
+        if (index_found == SparseIndex::NONE) {
+            continue;
+        }
+        
+        // Removing a sleeper takes support away from its island
+        uint32_t index = wake_at(index_found);
+        
+        // Keep the awake prefix packed: last awake row fills the hole, then the
+        // first inactive row becomes the hole and the last row fills it
+        if (index < awake_count_) {
+            move_body(index, --awake_count_);
+            index = static_cast<uint32_t>(awake_count_);
+        }
+        move_body(index, bodies_.size() - 1);
+        
+        // Retire the handle (stale copies stop resolving) and drop the row
+        const auto bullet = std::lower_bound(bullet_ids_.begin(), bullet_ids_.end(), id);
+        if (bullet != bullet_ids_.end() && *bullet == id) {
+            bullet_ids_.erase(bullet);
+        }
+        body_index_.erase(id);
+        body_handles_.destroy(id);
+        bodies_.swap_remove(bodies_.size() - 1);
     }
-    
-    // Remove from map and vector
-    body_id_to_index_.erase(id);
-    bodies_.pop_back();
+    sleeper_hash_dirty_ = true;
+    query_hash_dirty_ = true;
+    constraint_rows_dirty_ = true;
+    refresh_read_snapshot();
 }
 
-RigidBody* PhysicsManager::get_body(uint32_t id) {
+BodyHandle PhysicsManager::get_body(uint32_t id) {
+    // Direct access serializes with the worker; per-frame readers should use read_body()
+    wait_for_worker();
+    sleeper_hash_dirty_ = true;  // The caller may move a sleeper
+    query_hash_dirty_ = true;
     return find_body(id);
 }
 
-const RigidBody* PhysicsManager::get_body(uint32_t id) const {
+ConstBodyHandle PhysicsManager::get_body(uint32_t id) const {
+    wait_for_worker();
     return find_body(id);
 }
 
-RigidBody* PhysicsManager::find_body(uint32_t id) {
-    auto it = body_id_to_index_.find(id);
-    if (it == body_id_to_index_.end()) {
+BodyHandle PhysicsManager::find_body(uint32_t id) {
+    const uint32_t index = body_index_.find(id);
+    if (index == SparseIndex::NONE) {
         return nullptr;
     }
-    return &bodies_[it->second];
+    return BodyHandle(&bodies_, index);
 }
 
-const RigidBody* PhysicsManager::find_body(uint32_t id) const {
-    auto it = body_id_to_index_.find(id);
-    if (it == body_id_to_index_.end()) {
+ConstBodyHandle PhysicsManager::find_body(uint32_t id) const {
+    const uint32_t index = body_index_.find(id);
+    if (index == SparseIndex::NONE) {
         return nullptr;
     }
-    return &bodies_[it->second];
+    return ConstBodyHandle(&bodies_, index);
 }
 
 void PhysicsManager::apply_impulse(uint32_t body_id, const FixedVector3& impulse) {
-    RigidBody* body = find_body(body_id);
-    if (!body) {
-        return;
-    }
-    
-    // Wake body if sleeping
-    body->wake();
-    
-    // Apply impulse: Δv = impulse / mass
-    body->velocity += impulse * body->inverse_mass;
+    submit(PhysicsCommand{ PhysicsCommand::Type::ApplyImpulse, body_id, impulse });
 }
 
 void PhysicsManager::apply_force(uint32_t body_id, const FixedVector3& force) {
-    RigidBody* body = find_body(body_id);
-    if (!body) {
+    submit(PhysicsCommand{ PhysicsCommand::Type::ApplyForce, body_id, force });
+}
+
+void PhysicsManager::set_velocity(uint32_t body_id, const FixedVector3& velocity) {
+    submit(PhysicsCommand{ PhysicsCommand::Type::SetVelocity, body_id, velocity });
+}
+
+void PhysicsManager::set_position(uint32_t body_id, const FixedVector3& position) {
+    submit(PhysicsCommand{ PhysicsCommand::Type::SetPosition, body_id, position });
+}
+
+void PhysicsManager::wake_body(uint32_t body_id) {
+    submit(PhysicsCommand{ PhysicsCommand::Type::Wake, body_id, FixedVector3::zero() });
+}
+
+void PhysicsManager::execute_command(const PhysicsCommand& command) {
+    uint32_t index = body_index_.find(command.body_id);
+    if (index == SparseIndex::NONE) {
         return;
     }
     
-    // Wake body if sleeping
-    body->wake();
+    // Waking a sleeper wakes its island, which can move this body's row
+    const bool wakes = command.type == PhysicsCommand::Type::ApplyImpulse ||
+        command.type == PhysicsCommand::Type::ApplyForce ||
+        command.type == PhysicsCommand::Type::Wake ||
+        (command.type == PhysicsCommand::Type::SetVelocity && !command.value.is_zero());
+    if (wakes) {
+        index = wake_at(index);
+    }
+    BodyRef body = bodies_[index];
+    query_hash_dirty_ = true;
     
-    // Accumulate force into acceleration: a = F / m
-    body->acceleration += force * body->inverse_mass;
+    switch (command.type) {
+        case PhysicsCommand::Type::ApplyImpulse:
+            // Apply impulse: Δv = impulse / mass
+            body.velocity += command.value * body.inverse_mass;
+            break;
+        case PhysicsCommand::Type::ApplyForce:
+            // Accumulate force into acceleration: a = F / m
+            body.acceleration += command.value * body.inverse_mass;
+            break;
+        case PhysicsCommand::Type::SetVelocity:
+            body.velocity = command.value;
+            break;
+        case PhysicsCommand::Type::SetPosition:
+            body.position = command.value;
+            bodies_.previous_positions()[index] = command.value;  // Teleport, no smear
+            if (index >= awake_count_) {
+                sleeper_hash_dirty_ = true;
+            }
+            break;
+        case PhysicsCommand::Type::Wake:
+            break;
+    }
 }
 
-void PhysicsManager::set_velocity(uint32_t body_id, const FixedVector3& velocity) {
-    RigidBody* body = find_body(body_id);
-    if (!body) {
+// ============================================================================
+// CONTINUOUS COLLISION (BULLETS)
+// ============================================================================
+
+void PhysicsManager::set_body_bullet(uint32_t id, bool bullet) {
+    wait_for_worker();
+    if (body_index_.find(id) == SparseIndex::NONE) {
         return;
     }
-    
-    // Wake body if setting non-zero velocity
-    if (!velocity.is_zero()) {
-        body->wake();
+    const auto it = std::lower_bound(bullet_ids_.begin(), bullet_ids_.end(), id);
+    const bool present = it != bullet_ids_.end() && *it == id;
+    if (bullet && !present) {
+        bullet_ids_.insert(it, id);
+    } else if (!bullet && present) {
+        bullet_ids_.erase(it);
     }
+}
+
+bool PhysicsManager::is_body_bullet(uint32_t id) const {
+    wait_for_worker();
+    return std::binary_search(bullet_ids_.begin(), bullet_ids_.end(), id);
+}
+
+void PhysicsManager::sweep_bullets(Fixed dt) {
+    bullet_impacts_ = 0;
+    FixedVector3* positions = bodies_.positions();
+    const FixedVector3* velocities = bodies_.velocities();
+    const FixedVector3* previous = bodies_.previous_positions();
     
-    body->velocity = velocity;
+    for (uint32_t id : bullet_ids_) {
+        const uint32_t row = body_index_.find(id);
+        if (row == SparseIndex::NONE || row >= awake_count_ || !bodies_[row].should_collide()) {
+            continue;
+        }
+        
+        // Substeps for this body only: stop at each impact, resolve it there,
+        // then move on with the new velocity for the rest of the step
+        FixedVector3 from = previous[row];
+        Fixed time_left = dt;
+        for (int sweep = 0; sweep < MAX_BULLET_SWEEPS; ++sweep) {
+            uint32_t other = 0;
+            const Fixed t = first_impact(row, from, positions[row], other);
+            if (t.raw >= Fixed::ONE) {
+                break;
+            }
+            positions[row] = from + (positions[row] - from) * t;
+            resolve_sphere_collision(row, other);
+            ++bullet_impacts_;
+            
+            time_left = time_left * Fixed(Fixed::ONE - t.raw);
+            from = positions[row];
+            positions[row] = from + velocities[row] * time_left;
+            apply_world_bounds(row);
+        }
+    }
 }
 
-void PhysicsManager::set_position(uint32_t body_id, const FixedVector3& position) {
-    RigidBody* body = find_body(body_id);
-    if (!body) {
-        return;
+Fixed PhysicsManager::first_impact(uint32_t row, const FixedVector3& from, const FixedVector3& to, uint32_t& other) {
+    const Fixed NO_IMPACT = Fixed::from_int(1);
+    const FixedVector3 d = to - from;
+    const Fixed* radii = bodies_.radii();
+    const int64_t radius = radii[row].raw;
+    const int64_t travel_sq = dot_raw(d, d);
+    if (travel_sq <= radius * radius) {
+        return NO_IMPACT;  // Slow enough for the discrete test
     }
     
-    body->position = position;
+    // Candidates: bodies near the path (grid built this step) or every awake row
+    sweep_candidates_.clear();
+    if (use_broadphase_ && spatial_hash_) {
+        const QueryShape path = QueryShape::capsule(from.x, from.y, to.x, to.y, radii[row]);
+        FixedVector3 center;
+        Fixed reach;
+        path.bounds(center, reach);
+        // Slack for contacts resolved since the grid was built
+        spatial_hash_->queryCandidates(center, Fixed(reach.raw + radii[row].raw), sweep_candidates_);
+        std::sort(sweep_candidates_.begin(), sweep_candidates_.end());
+        sweep_candidates_.erase(std::unique(sweep_candidates_.begin(), sweep_candidates_.end()), sweep_candidates_.end());
+    } else {
+        for (uint32_t j = 0; j < awake_count_; ++j) {
+            sweep_candidates_.push_back(j);
+        }
+    }
+    
+    const uint32_t* layers = bodies_.layers();
+    const uint32_t* masks = bodies_.masks();
+    const FixedVector3* positions = bodies_.positions();
+    // Solve against a slightly smaller sum so the body lands just inside contact
+    const int64_t CONTACT_SLOP = Fixed::ONE / 512;
+    int32_t best = Fixed::ONE;
+    
+    for (uint32_t j : sweep_candidates_) {
+        if (j == row || j >= awake_count_ || !bodies_[j].should_collide() ||
+            !shouldCollide(layers[row], masks[row], layers[j], masks[j])) {
+            continue;
+        }
+        const int64_t reach = radius + radii[j].raw - CONTACT_SLOP;
+        if (reach <= 0) {
+            continue;
+        }
+        
+        // |w + t d|^2 = reach^2 with w = from - c: a t^2 + 2 b t + c0 = 0
+        const FixedVector3 w = from - positions[j];
+        int64_t a = travel_sq;
+        int64_t b = dot_raw(w, d);
+        int64_t c0 = dot_raw(w, w) - reach * reach;
+        if (c0 <= 0 || b >= 0) {
+            continue;  // Already touching (discrete pass) or moving apart
+        }
+        
+        // Rescale so the discriminant fits in 64 bits (24 significant bits)
+        int64_t m = std::max(a, std::max(-b, c0));
+        while (m >= (int64_t(1) << 24)) {
+            a >>= 1;
+            b /= 2;
+            c0 >>= 1;
+            m >>= 1;
+        }
+        if (a == 0) {
+            continue;
+        }
+        const int64_t disc = b * b - a * c0;
+        if (disc < 0) {
+            continue;
+        }
+        const int64_t root = static_cast<int64_t>(isqrt_u64(static_cast<uint64_t>(disc)));
+        const int64_t t = ((-b - root) << Fixed::SHIFT) / a;  // Earlier root, Q16
+        if (t >= 0 && t < best) {
+            best = static_cast<int32_t>(t);
+            other = j;
+        }
+    }
+    return Fixed(best);
 }
 
-void PhysicsManager::resolve_sphere_collision(RigidBody& bodyA, RigidBody& bodyB) {
-    if (CollisionResolver::resolve_sphere_collision(bodyA, bodyB)) {
+bool PhysicsManager::resolve_sphere_collision(uint32_t a, uint32_t b) {
+    if (CollisionResolver::resolve_sphere_collision(bodies_[a], bodies_[b], events_)) {
         collisions_resolved_++;
+        contact_pairs_.emplace_back(a, b);
+        return true;
     }
+    return false;
 }
 
 void PhysicsManager::detect_and_resolve_collisions() {
     pairs_checked_ = 0;
     collisions_resolved_ = 0;
+    contact_pairs_.clear();
+    
+    // Sleeping islands touched by an awake body rejoin the awake prefix first
+    wake_touched_islands();
     
     // Ground collision detection
     const Fixed GROUND_Y = Fixed::from_int(0);
     const Fixed GROUND_RESTITUTION = Fixed::from_float(0.3f);
     const Fixed GROUND_FRICTION = Fixed::from_float(0.7f);
     
-    for (auto& body : bodies_) {
+    for (size_t i = 0; i < awake_count_; ++i) {
         CollisionResolver::resolve_ground_collision(
-            body, GROUND_Y, GROUND_RESTITUTION, GROUND_FRICTION);
+            bodies_[i], GROUND_Y, GROUND_RESTITUTION, GROUND_FRICTION, events_);
+    }
+    
+    // Static geometry has its own grid; it never enters the sphere broadphase
+    if (static_geometry_) {
+        static_geometry_->resolve(bodies_, awake_count_);
     }
     
     // Sphere-sphere collision detection
@@ -357,63 +1317,237 @@ void PhysicsManager::detect_and_resolve_collisions() {
 void PhysicsManager::detect_collisions_broadphase() {
     if (!spatial_hash_) {
         spatial_hash_ = new SpatialHash();
+        spatial_hash_->setCellSize(config_.broadphase_cell_size);
     }
-    spatial_hash_->update(bodies_);
     
-    std::vector<std::pair<uint32_t, uint32_t>> potentialPairs;
-    spatial_hash_->getPotentialPairs(bodies_, potentialPairs);
+    const double t0 = perf_now_ms();
+    spatial_hash_->update(bodies_, 0, awake_count_, SpatialHash::Gather::Colliding);
+    const double t1 = perf_now_ms();
+    spatial_hash_->getPotentialPairs(bodies_, broadphase_pairs_);
+    const double t2 = perf_now_ms();
+    broadphase_rebuild_ms_ = static_cast<float>(t1 - t0);
+    broadphase_pairgen_ms_ = static_cast<float>(t2 - t1);
     
-    for (const auto& pair : potentialPairs) {
-        RigidBody* bodyA = find_body(pair.first);
-        RigidBody* bodyB = find_body(pair.second);
-        
-        if (!bodyA || !bodyB) {
-            continue;
-        }
-        if (!bodyA->should_collide() || !bodyB->should_collide()) {
-            continue;
+    // Pairs are pre-filtered by the broadphase; indices are valid for this step
+    pairs_checked_ = static_cast<uint32_t>(broadphase_pairs_.size());
+    for (size_t k = resolve_pairs_simd(); k < broadphase_pairs_.size(); ++k) {
+        const auto& pair = broadphase_pairs_[k];
+        resolve_sphere_collision(pair.first, pair.second);
+    }
+}
+
+size_t PhysicsManager::resolve_pairs_simd() {
+#if DOZEDENT_PHYSICS_SIMD
+    using namespace FixedSimd;
+    
+    // Overlap pre-test four pairs at a time. Pairs it rejects are exactly the
+    // ones the resolver would reject without side effects. Once a pair in a
+    // batch resolves, positions have moved, so the rest of that batch takes
+    // the full resolver path to keep results identical to the scalar order.
+    const size_t batched = broadphase_pairs_.size() & ~static_cast<size_t>(3);
+    const FixedVector3* positions = bodies_.positions();
+    const Fixed* radii = bodies_.radii();
+    
+    for (size_t base = 0; base < batched; base += 4) {
+        uint32_t ia[4];
+        uint32_t ib[4];
+        for (int l = 0; l < 4; ++l) {
+            ia[l] = broadphase_pairs_[base + l].first;
+            ib[l] = broadphase_pairs_[base + l].second;
         }
         
-        pairs_checked_++;
-        
-        if (!shouldCollide(bodyA->collision_layer, bodyA->collision_mask,
-                          bodyB->collision_layer, bodyB->collision_mask)) {
+        const Vec3x4 pa = Vec3x4::load(positions, ia);
+        const Vec3x4 pb = Vec3x4::load(positions, ib);
+        const i32x4 dist_sq = length_squared(pb.x - pa.x, pb.y - pa.y, pb.z - pa.z);
+        const i32x4 combined = i32x4{ radii[ia[0]].raw, radii[ia[1]].raw, radii[ia[2]].raw, radii[ia[3]].raw } +
+                               i32x4{ radii[ib[0]].raw, radii[ib[1]].raw, radii[ib[2]].raw, radii[ib[3]].raw };
+        const i32x4 maybe = (dist_sq < mul(combined, combined)) & (dist_sq > splat(0));
+        if (!any(maybe)) {
             continue;
         }
         
-        resolve_sphere_collision(*bodyA, *bodyB);
+        bool moved = false;
+        for (int l = 0; l < 4; ++l) {
+            if (maybe[l] || moved) {
+                moved |= resolve_sphere_collision(ia[l], ib[l]);
+            }
+        }
     }
+    return batched;
+#else
+    return 0;
+#endif
 }
 
 void PhysicsManager::detect_collisions_naive() {
-    for (size_t i = 0; i < bodies_.size(); ++i) {
+    const uint32_t* layers = bodies_.layers();
+    const uint32_t* masks = bodies_.masks();
+    for (size_t i = 0; i < awake_count_; ++i) {
         if (!bodies_[i].should_collide()) {
             continue;
         }
         
-        for (size_t j = i + 1; j < bodies_.size(); ++j) {
+        for (size_t j = i + 1; j < awake_count_; ++j) {
             if (!bodies_[j].should_collide()) {
                 continue;
             }
             
             pairs_checked_++;
             
-            if (!shouldCollide(bodies_[i].collision_layer, bodies_[i].collision_mask,
-                              bodies_[j].collision_layer, bodies_[j].collision_mask)) {
+            if (!shouldCollide(layers[i], masks[i], layers[j], masks[j])) {
                 continue;
             }
             
-            resolve_sphere_collision(bodies_[i], bodies_[j]);
+            resolve_sphere_collision(static_cast<uint32_t>(i), static_cast<uint32_t>(j));
+        }
+    }
+}
+
+void PhysicsManager::clear_constraints() {
+    wait_for_worker();
+    distance_constraints_.clear();
+    range_constraints_.clear();
+    body_constraints_.clear();
+    constraint_colors_dirty_ = true;
+}
+
+void PhysicsManager::add_distance_constraint(const DistanceConstraint& c) {
+    wait_for_worker();
+    if (!ConstraintSlots<DistanceConstraint>::live(c)) return;
+    link_constraint(c.bodyA, c.bodyB, distance_constraints_.add(c));
+}
+
+void PhysicsManager::add_range_constraint(const DistanceRangeConstraint& c) {
+    wait_for_worker();
+    if (!ConstraintSlots<DistanceRangeConstraint>::live(c)) return;
+    link_constraint(c.bodyA, c.bodyB, range_constraints_.add(c) | RANGE_CONSTRAINT_REF);
+}
+
+void PhysicsManager::link_constraint(uint32_t body_a, uint32_t body_b, uint32_t ref) {
+    body_constraints_.add(body_a, ref);
+    if (body_b != body_a) {
+        body_constraints_.add(body_b, ref);
+    }
+    constraint_colors_dirty_ = true;
+}
+
+void PhysicsManager::remove_body_constraints(uint32_t id) {
+    // Only this body's own constraints; nothing scans the full lists
+    body_constraints_.take(id, constraint_refs_);
+    for (uint32_t ref : constraint_refs_) {
+        const uint32_t slot = ref & ~RANGE_CONSTRAINT_REF;
+        uint32_t body_a;
+        uint32_t body_b;
+        if (ref & RANGE_CONSTRAINT_REF) {
+            body_a = range_constraints_[slot].bodyA;
+            body_b = range_constraints_[slot].bodyB;
+        } else {
+            body_a = distance_constraints_[slot].bodyA;
+            body_b = distance_constraints_[slot].bodyB;
+        }
+        if (body_a != id && body_b != id) {
+            continue;  // Left behind by an earlier generation of this slot
+        }
+        const uint32_t other = body_a == id ? body_b : body_a;
+        if (other != id) {
+            body_constraints_.remove(other, ref);
+        }
+        if (ref & RANGE_CONSTRAINT_REF) {
+            range_constraints_.remove(slot);
+        } else {
+            distance_constraints_.remove(slot);
+        }
+        constraint_colors_dirty_ = true;
+    }
+}
+
+void PhysicsManager::rebuild_constraint_adjacency() {
+    body_constraints_.clear();
+    for (size_t i = 0; i < distance_constraints_.size(); ++i) {
+        const DistanceConstraint& c = distance_constraints_[i];
+        if (ConstraintSlots<DistanceConstraint>::live(c)) {
+            link_constraint(c.bodyA, c.bodyB, static_cast<uint32_t>(i));
+        }
+    }
+    for (size_t i = 0; i < range_constraints_.size(); ++i) {
+        const DistanceRangeConstraint& c = range_constraints_[i];
+        if (ConstraintSlots<DistanceRangeConstraint>::live(c)) {
+            link_constraint(c.bodyA, c.bodyB, static_cast<uint32_t>(i) | RANGE_CONSTRAINT_REF);
         }
     }
 }
 
 void PhysicsManager::solve_constraints(int iterations) {
-    if (iterations <= 0) return;
+    if (iterations <= 0 || (distance_constraints_.empty() && range_constraints_.empty())) return;
+    prepare_constraints();
+    wake_constrained_islands();  // May move rows
+    prepare_constraints();
     if (!distance_constraints_.empty()) {
-        ConstraintSolver::solve_distance_constraints(bodies_, distance_constraints_, iterations);
+        ConstraintSolver::solve_distance_constraints(
+            bodies_, distance_constraints_.slots(), distance_rows_.data(), distance_coloring_, awake_count_, iterations);
     }
     if (!range_constraints_.empty()) {
-        RangeConstraintSolver::solve(bodies_, range_constraints_, iterations);
+        RangeConstraintSolver::solve(
+            bodies_, range_constraints_.slots(), range_rows_.data(), range_coloring_, awake_count_, iterations);
+    }
+}
+
+void PhysicsManager::prepare_constraints() {
+    if (constraint_colors_dirty_) {
+        distance_coloring_.build(distance_constraints_.slots());
+        range_coloring_.build(range_constraints_.slots());
+        constraint_colors_dirty_ = false;
+        constraint_rows_dirty_ = true;
+    }
+    if (!constraint_rows_dirty_) return;
+    
+    // O(constraints) through the sparse index; no per-step id map
+    const auto resolve = [this](uint32_t id) {
+        const uint32_t row = body_index_.find(id);
+        return row == SparseIndex::NONE ? ConstraintRows::NONE : row;
+    };
+    distance_rows_.resize(distance_constraints_.size());
+    for (size_t i = 0; i < distance_constraints_.size(); ++i) {
+        distance_rows_[i] = ConstraintRows{ resolve(distance_constraints_[i].bodyA), resolve(distance_constraints_[i].bodyB) };
+    }
+    range_rows_.resize(range_constraints_.size());
+    for (size_t i = 0; i < range_constraints_.size(); ++i) {
+        range_rows_[i] = ConstraintRows{ resolve(range_constraints_[i].bodyA), resolve(range_constraints_[i].bodyB) };
+    }
+    constraint_rows_dirty_ = false;
+}
+
+void PhysicsManager::wake_constrained_islands() {
+    // A constraint from an awake body (e.g. the kinematic player) to a sleeping
+    // island wakes that island only once it would actually pull on it
+    touched_islands_.clear();
+    const size_t awake = awake_count_;
+    const BodyType* types = bodies_.types();
+    const auto sleeping_partner = [awake, types](ConstraintRows r) {
+        if (r.a == ConstraintRows::NONE || r.b == ConstraintRows::NONE || (r.a < awake) == (r.b < awake)) {
+            return ConstraintRows::NONE;
+        }
+        const uint32_t asleep = r.a < awake ? r.b : r.a;
+        return types[asleep] == BodyType::Dynamic ? asleep : ConstraintRows::NONE;
+    };
+    for (size_t i = 0; i < distance_constraints_.size(); ++i) {
+        const uint32_t asleep = sleeping_partner(distance_rows_[i]);
+        if (asleep != ConstraintRows::NONE &&
+            ConstraintSolver::needs_correction(bodies_, distance_constraints_[i], distance_rows_[i])) {
+            touched_islands_.push_back(bodies_.ids()[asleep]);
+        }
+    }
+    for (size_t i = 0; i < range_constraints_.size(); ++i) {
+        const uint32_t asleep = sleeping_partner(range_rows_[i]);
+        if (asleep != ConstraintRows::NONE &&
+            RangeConstraintSolver::needs_correction(bodies_, range_constraints_[i], range_rows_[i])) {
+            touched_islands_.push_back(bodies_.ids()[asleep]);
+        }
+    }
+    for (uint32_t id : touched_islands_) {
+        const uint32_t index = body_index_.find(id);
+        if (index != SparseIndex::NONE && index >= awake_count_) {
+            wake_island(index);
+        }
     }
 }
@@ -1,11 +1,23 @@
 #pragma once
 #include "PhysicsTypes.h"
+#include "BodyStore.h"
+#include "PhysicsSnapshot.h"
+#include "PhysicsEvents.h"
+#include "SpscRing.h"
+#include "SnapshotStream.h"
+#include "FrameHash.h"
+#include "EntityRegistry.h"
+#include "OverlapQuery.h"
+#include <atomic>
 #include <vector>
-#include <unordered_map>
 #include "constraints/DistanceConstraint.h"
 #include "constraints/DistanceRangeConstraint.h"
 class SpatialHash;
 class ForceFieldManager;
+struct ForceField;
+class StaticGeometry;
+struct StaticCollider;
+class PhysicsWorker;
 
 /**
  * PhysicsManager - Manages physics simulation with fixed-point determinism
@@ -15,6 +27,8 @@ class ForceFieldManager;
  * - Apply forces and impulses to bodies
  * - Handle world bounds and simple collisions
  * - Use integer tick counting for perfect determinism
+ * - Optionally step on a worker thread (see PhysicsWorker.h): mutators are
+ *   queued as commands and other systems read a latched snapshot
  */
 class PhysicsManager {
 public:
@@ -28,24 +42,53 @@ public:
     // Main update (called every frame with variable dt)
     void update(float delta_time);
     
-    // Body management
+    // Threaded stepping (no-op unless built with DOZEDENT_PHYSICS_THREADS)
+    void set_worker_enabled(bool enabled);
+    bool is_worker_enabled() const { return worker_ != nullptr; }
+    void wait_for_worker() const;
+    
+    // Worker entry points (called from PhysicsWorker)
+    void run_update(float delta_time);
+    void latch_snapshot();
+    void drain_commands();
+    
+    // Thread-safe read of body state: live bodies inline, latched snapshot with a worker
+    bool read_body(uint32_t id, BodySnapshot& out) const;
+    
+    // Rollback snapshots (structural: wait for the worker, flush queued commands)
+    void save_state(SnapshotWriter& w);
+    bool load_state(SnapshotReader& r);
+    
+    // Body management (structural: waits for an in-flight worker update)
     uint32_t create_body(const RigidBody& body);
     uint32_t create_wolf_body(float x, float y, float radius = 0.04f);
     void destroy_body(uint32_t id);
-    RigidBody* get_body(uint32_t id);
-    const RigidBody* get_body(uint32_t id) const;
+    // Mass despawn: O(1) row and constraint cleanup per body, one snapshot publish
+    void destroy_bodies(const uint32_t* ids, size_t count);
+    BodyHandle get_body(uint32_t id);
+    ConstBodyHandle get_body(uint32_t id) const;
+    // Capacity hint: body rows, handles and per-step scratch for count bodies,
+    // so spawn waves up to that size do not reallocate (never shrinks)
+    void reserve_bodies(size_t count);
+    size_t get_body_capacity() const { return bodies_.capacity(); }
     
-    // Force/impulse application
+    // Force/impulse application (queued while a worker update is in flight)
     void apply_impulse(uint32_t body_id, const FixedVector3& impulse);
     void apply_force(uint32_t body_id, const FixedVector3& force);
     void set_velocity(uint32_t body_id, const FixedVector3& velocity);
     void set_position(uint32_t body_id, const FixedVector3& position);
+    void wake_body(uint32_t body_id);
     
     // State queries
     int get_body_count() const { 
         return static_cast<int>(bodies_.size()); 
     }
     
+    // Bodies the step visits (awake dynamic and kinematic); the rest sleep or are static
+    int get_awake_body_count() const {
+        return static_cast<int>(awake_count_);
+    }
+    
     const PhysicsConfig& get_config() const { 
         return config_; 
     }
@@ -57,58 +100,241 @@ public:
     int32_t get_tick_accumulator() const {
         return tick_accumulator_;
     }
+    
+    // Budgeted stepping: an update runs at most config.max_iterations fixed
+    // steps, and with a wall-clock budget (ms, 0 = none) stops early once the
+    // budget is spent. Time it could not simulate is dropped, not banked, so
+    // a stall never turns into catch-up bursts. A budget makes the step count
+    // depend on wall-clock time, so peers and replays diverge: it must stay 0
+    // for lockstep, rollback and replay. SimInstance::step and
+    // replay_input_log force it to 0.
+    void set_step_budget_ms(float budget_ms) { step_budget_ms_ = budget_ms > 0.0f ? budget_ms : 0.0f; }
+    float get_step_budget_ms() const { return step_budget_ms_; }
+    int get_last_steps_taken() const { return last_steps_taken_; }
+    float get_dropped_time_ms() const { return static_cast<float>(dropped_micros_) / 1000.0f; }
+    // Fraction of a fixed step left in the accumulator, [0, 1): render bodies
+    // at previous + (current - previous) * alpha
+    float get_interpolation_alpha() const;
+    // Writes up to capacity bodies (awake rows first); sleeping and static
+    // bodies are at rest and get their current position. Returns the count.
+    int write_interpolated_positions(float alpha, InterpolatedBody* out, int capacity) const;
+    
+    // Hit queries: ids of bodies whose layer is in layer_mask and that overlap
+    // the shape, in row order (replaces out_ids). Served from a grid over all
+    // bodies that is rebuilt at most once between changes, so any number of
+    // hitboxes in a frame share one rebuild. Reads live bodies: with a worker
+    // this waits for the in-flight update, like get_body.
+    int query_overlap(const QueryShape& shape, uint32_t layer_mask, std::vector<uint32_t>& out_ids);
+    
+    // Continuous collision for bullets (thrown barrels, other fast small
+    // bodies): each step a bullet that moved farther than its radius is swept
+    // from its previous position against awake bodies, stopped at the first
+    // time of impact, resolved there, and carried on for the rest of the step
+    // (up to MAX_BULLET_SWEEPS impacts). Other bodies keep the discrete test,
+    // so the global step rate can stay low.
+    static constexpr int MAX_BULLET_SWEEPS = 4;
+    void set_body_bullet(uint32_t id, bool bullet);
+    bool is_body_bullet(uint32_t id) const;
+    int get_bullet_count() const { return static_cast<int>(bullet_ids_.size()); }
+    uint32_t get_bullet_impacts() const { return bullet_impacts_; }  // Swept impacts last step
+    
+    // Collision events from this manager's steps (the step produces, one reader consumes)
+    PhysicsEventQueue& get_event_queue() { return events_; }
+    
+    // Contact stream filter (begin/stay/end records in get_event_queue().contacts()).
+    // Clearing ends every tracked contact and turns the stream off.
+    int add_contact_filter(uint32_t layers_a, uint32_t layers_b, float min_impulse, bool report_stay) {
+        wait_for_worker();
+        return events_.contacts().filter().add_rule(layers_a, layers_b, min_impulse, report_stay);
+    }
+    void clear_contact_filters() {
+        wait_for_worker();
+        events_.contacts().end_all();
+        events_.contacts().filter().clear();
+    }
+    
+    // Force fields (see ForceFieldManager): applied to awake dynamic bodies
+    // before integration each step. A field with radius > 0 only reaches
+    // bodies within it; lifetime_steps > 0 removes it after that many steps.
+    // Fields are part of snapshots and frame hashes. Returns the field id.
+    uint32_t add_force_field(const ForceField& field, int32_t lifetime_steps);
+    bool remove_force_field(uint32_t id);
+    void clear_force_fields();
+    int get_force_field_count() const;
+    uint32_t get_force_field_evaluations() const;  // Body-field pairs applied last step
+    
+    // Static geometry (see StaticGeometry): fixed circles and boxes in their
+    // own grid, rebuilt only when the set changes and never part of the
+    // dynamic broadphase. Awake bodies are pushed out of them after the ground
+    // pass each step. Part of snapshots and frame hashes. owner tags colliders
+    // for remove_static_colliders (0 = none).
+    uint32_t add_static_collider(const StaticCollider& collider);
+    bool remove_static_collider(uint32_t id);
+    int remove_static_colliders(uint32_t owner);
+    void clear_static_colliders();
+    int get_static_collider_count() const;
+    uint32_t get_static_tests() const;  // Body-collider tests last step
+    // Pushes a circle that has no body (the player) out of the colliders that
+    // block layer; true if x or y changed
+    bool resolve_static_circle(float& x, float& y, float radius, uint32_t layer);
+    
+    // World bounds bodies are clamped to (part of the config, so snapshotted)
+    void set_world_bounds(float min_x, float min_y, float max_x, float max_y);
+    
+    // Desync detection: hash of all body state at the end of each step, keyed
+    // by step tick. The salt (wolf/RNG state from the coordinator) is mixed
+    // into every step of the next update.
+    void set_frame_hash_enabled(bool enabled) { frame_hash_enabled_ = enabled; }
+    bool is_frame_hash_enabled() const { return frame_hash_enabled_; }
+    void set_frame_salt(uint64_t salt) { pending_frame_salt_ = salt; }
+    uint32_t get_step_tick() const { return step_tick_; }
+    bool get_frame_hash(uint32_t tick, uint64_t& out);
+    uint32_t get_latest_hashed_tick();
+    void clear_frame_hashes();  // Forget every recorded hash (a new run restarts the ticks)
 
 private:
     // Configuration
     PhysicsConfig config_;
     
-    // Bodies
-    std::vector<RigidBody> bodies_;
-    std::unordered_map<uint32_t, size_t> body_id_to_index_;  // O(1) lookup by ID
-    uint32_t next_body_id_;
+    // Bodies (structure-of-arrays, dense indices); body ids are entity handles
+    BodyStore bodies_;
+    EntityRegistry body_handles_;
+    SparseIndex body_index_;  // Handle -> row in bodies_
+    
+    // Sleeping islands: rows [0, awake_count_) are awake, sleeping and static
+    // bodies follow, so every per-step pass is a loop over the awake prefix.
+    // Bodies connected by this step's contacts or constraints form an island
+    // that sleeps as a unit; its members are linked in a ring through
+    // SleepState::island_next and wake together. Sleepers sit in their own
+    // grid, rebuilt only when the sleeping set changes, which awake bodies
+    // probe to wake the islands they touch.
+    size_t awake_count_ = 0;
+    SpatialHash* sleeper_hash_ = nullptr;
+    bool sleeper_hash_dirty_ = true;
+    std::vector<std::pair<uint32_t, uint32_t>> contact_pairs_;  // Resolved this step (rows)
+    std::vector<uint32_t> island_parent_;                       // Union-find over awake rows
+    std::vector<uint32_t> island_head_;
+    std::vector<uint32_t> island_tail_;
+    std::vector<uint8_t> island_ready_;
+    std::vector<uint32_t> touch_candidates_;
+    std::vector<uint32_t> touched_islands_;
+    
+    // Hit query grid over every row; stale after any step or row change
+    SpatialHash* query_hash_ = nullptr;
+    bool query_hash_dirty_ = true;
+    std::vector<uint32_t> query_candidates_;
+    
+    PhysicsEventQueue events_;
+    
+    // Bullets: sorted handles (simulation state, saved and hashed)
+    std::vector<uint32_t> bullet_ids_;
+    std::vector<uint32_t> sweep_candidates_;
+    uint32_t bullet_impacts_ = 0;
+    bool is_awake_row(size_t index) const;
+    void move_body(size_t from, size_t to);
+    uint32_t wake_at(uint32_t index);       // Returns the body's row afterwards
+    void wake_island(uint32_t index);
+    void wake_touched_islands();
+    uint32_t find_island(uint32_t index);
+    void unite_islands(uint32_t a, uint32_t b);
     
     // Timing (using integer microseconds for determinism)
+    uint32_t step_tick_ = 0;    // Fixed steps since initialize/reset
     int32_t tick_accumulator_;  // Accumulated time in microseconds
-    float last_step_time_ms_;   // Performance tracking only (not deterministic)
+    float last_step_time_ms_;   // Wall-clock, monitoring only
+    float step_budget_ms_ = 0.0f;
+    int last_steps_taken_ = 0;
+    int64_t dropped_micros_ = 0;  // Simulation time skipped since initialize/reset
     
     // Physics simulation
     void step(Fixed dt);
     void integrate_forces(Fixed dt);
-    void apply_world_bounds(RigidBody& body);
+    void integrate_body(size_t index, Fixed dt);
+    size_t resolve_pairs_simd();  // Returns pairs handled (0 in scalar builds)
+    void apply_world_bounds(size_t index);
     void update_sleeping_bodies(int32_t timestep_micros);
     void detect_and_resolve_collisions();
     void detect_collisions_broadphase();
     void detect_collisions_naive();
-    void resolve_sphere_collision(RigidBody& bodyA, RigidBody& bodyB);
+    bool resolve_sphere_collision(uint32_t a, uint32_t b);
+    void sweep_bullets(Fixed dt);
+    Fixed first_impact(uint32_t row, const FixedVector3& from, const FixedVector3& to, uint32_t& other);
     void solve_constraints(int iterations);
     
+    // Frame hashes: produced by step() (worker thread when threaded),
+    // collected into the tick ring on the main thread
+    bool frame_hash_enabled_ = true;
+    uint64_t frame_salt_ = 0;
+    uint64_t pending_frame_salt_ = 0;
+    SpscRing<FrameHashEntry, 64> step_hashes_;
+    FrameHashRing<128> frame_hashes_;
+    void record_step_hash();
+    void collect_frame_hashes();
+    
+    // Commands and snapshots
+    void submit(const PhysicsCommand& command);
+    void execute_command(const PhysicsCommand& command);
+    void publish_snapshot(PhysicsSnapshot& snapshot) const;
+    void refresh_read_snapshot();
+    
     // Utility
-    uint32_t generate_body_id() { 
-        return next_body_id_++; 
-    }
+    uint32_t add_body(RigidBody body);  // Allocates the handle and appends the row
+    void reset_bodies();                 // Empty store, fresh registry, player body at handle 0
     
-    RigidBody* find_body(uint32_t id);
-    const RigidBody* find_body(uint32_t id) const;
+    BodyHandle find_body(uint32_t id);
+    ConstBodyHandle find_body(uint32_t id) const;
 
     // Optional systems (declared in cpp to keep header light)
     SpatialHash* spatial_hash_ = nullptr;
-    ForceFieldManager* force_field_mgr_ = nullptr;
+    ForceFieldManager* force_field_mgr_ = nullptr;  // Created by the first add_force_field
+    ForceFieldManager& force_fields();
+    StaticGeometry* static_geometry_ = nullptr;     // Created by the first add_static_collider
+    StaticGeometry& static_geometry();
     bool use_broadphase_ = false;
     // Perf counters
     uint32_t pairs_checked_ = 0;
     uint32_t collisions_resolved_ = 0;
+    float broadphase_rebuild_ms_ = 0.0f;   // Wall-clock, monitoring only
+    float broadphase_pairgen_ms_ = 0.0f;   // Wall-clock, monitoring only
+    std::vector<std::pair<uint32_t, uint32_t>> broadphase_pairs_;  // Body index pairs, reused across steps
+    // Threaded stepping
+    PhysicsWorker* worker_ = nullptr;
+    SpscRing<PhysicsCommand, 1024> commands_;
+    PhysicsSnapshot snapshots_[2];
+    std::atomic<int> front_snapshot_{0};  // Last buffer the worker published
+    int read_snapshot_ = 0;               // Buffer main-thread readers use this frame
     // Constraints
-    std::vector<DistanceConstraint> distance_constraints_;
-    std::vector<DistanceRangeConstraint> range_constraints_;
+    // Slot storage; adjacency refs are the slot, RANGE_CONSTRAINT_REF-tagged for range constraints
+    static constexpr uint32_t RANGE_CONSTRAINT_REF = 0x80000000u;
+    ConstraintSlots<DistanceConstraint> distance_constraints_;
+    ConstraintSlots<DistanceRangeConstraint> range_constraints_;
+    ConstraintAdjacency body_constraints_;
+    std::vector<uint32_t> constraint_refs_;  // Scratch for destroy
+    void link_constraint(uint32_t body_a, uint32_t body_b, uint32_t ref);
+    void remove_body_constraints(uint32_t id);
+    void rebuild_constraint_adjacency();
+    // Solver view: dense rows per constraint (re-resolved only after bodies change
+    // rows) and colors (rebuilt only when a constraint list changes)
+    std::vector<ConstraintRows> distance_rows_;
+    std::vector<ConstraintRows> range_rows_;
+    ConstraintColoring distance_coloring_;
+    ConstraintColoring range_coloring_;
+    bool constraint_rows_dirty_ = true;
+    bool constraint_colors_dirty_ = true;
+    void prepare_constraints();
+    void wake_constrained_islands();
 public:
     // Toggle/configure optional systems
-    void enable_broadphase(bool on) { use_broadphase_ = on; }
+    void enable_broadphase(bool on) { wait_for_worker(); use_broadphase_ = on; }
     uint32_t get_pairs_checked() const { return pairs_checked_; }
     uint32_t get_collisions_resolved() const { return collisions_resolved_; }
+    bool is_broadphase_enabled() const { return use_broadphase_; }
+    float get_broadphase_rebuild_ms() const { return broadphase_rebuild_ms_; }
+    float get_broadphase_pairgen_ms() const { return broadphase_pairgen_ms_; }
     // Constraints API
-    void clear_constraints() { distance_constraints_.clear(); range_constraints_.clear(); }
-    void add_distance_constraint(const DistanceConstraint& c) { distance_constraints_.push_back(c); }
-    void add_range_constraint(const DistanceRangeConstraint& c) { range_constraints_.push_back(c); }
+    void clear_constraints();
+    void add_distance_constraint(const DistanceConstraint& c);
+    void add_range_constraint(const DistanceRangeConstraint& c);
 };
 
 
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "PhysicsTypes.h"
+#include "EntityRegistry.h"
+
+/**
+ * BodySnapshot - read-only copy of the body state other systems consume
+ */
+struct BodySnapshot {
+    uint32_t id = 0;
+    BodyType type = BodyType::Dynamic;
+    FixedVector3 position;
+    FixedVector3 velocity;
+    FixedVector3 previous_position;  // Before the latest step (render interpolation)
+    bool is_sleeping = false;
+};
+
+/**
+ * InterpolatedBody - one body's render position, written for JS in bulk
+ *
+ * previous + (current - previous) * alpha, so a 120/144 Hz renderer moves
+ * bodies smoothly between fixed steps (see write_interpolated_positions).
+ */
+struct InterpolatedBody {
+    uint32_t id;
+    float x;
+    float y;
+    float z;
+};
+
+/**
+ * PhysicsSnapshot - all bodies after one physics update
+ *
+ * slot_of_id is indexed by the registry slot of a body id, so lookups are
+ * O(1) and rebuilding reuses capacity between publishes. The id stored in
+ * the body rejects handles from an earlier generation of the slot.
+ */
+struct PhysicsSnapshot {
+    std::vector<BodySnapshot> bodies;
+    std::vector<int32_t> slot_of_id;  // -1 = no such body
+    uint32_t step_count = 0;
+    float alpha = 0.0f;  // Interpolation alpha after this update
+
+    const BodySnapshot* find(uint32_t id) const {
+        const uint32_t entity = entity_slot(id);
+        if (entity >= slot_of_id.size()) return nullptr;
+        const int32_t slot = slot_of_id[entity];
+        if (slot < 0 || bodies[static_cast<size_t>(slot)].id != id) return nullptr;
+        return &bodies[static_cast<size_t>(slot)];
+    }
+};
+
+/**
+ * PhysicsCommand - deferred mutation queued while the worker steps
+ */
+struct PhysicsCommand {
+    enum class Type : uint8_t {
+        ApplyImpulse = 0,
+        ApplyForce = 1,
+        SetVelocity = 2,
+        SetPosition = 3,
+        Wake = 4
+    };
+
+    Type type = Type::ApplyImpulse;
+    uint32_t body_id = 0;
+    FixedVector3 value;
+};
@@ -10,6 +10,71 @@ enum class BodyType {
     Static = 2      // Never moves
 };
 
+/**
+ * Body state rules shared by RigidBody and the BodyStore proxies.
+ * Written against field names so both the value type and the
+ * reference proxy (see BodyStore.h) use one implementation.
+ */
+namespace BodyRules {
+    // Dynamic bodies are always simulated when not sleeping
+    // Kinematic bodies are simulated only when they have non-zero velocity (e.g., knockback)
+    template <typename Body>
+    inline bool should_simulate(const Body& b) {
+        if (b.type == BodyType::Static) {
+            return false;
+        }
+        if (b.is_sleeping) {
+            return false;
+        }
+        if (b.type == BodyType::Dynamic) {
+            return true;
+        }
+        // Kinematic: simulate only if moving (for knockback decay)
+        return !b.velocity.is_zero();
+    }
+    
+    template <typename Body>
+    inline bool should_collide(const Body& b) {
+        if (b.type == BodyType::Static) {
+            return false;
+        }
+        if (b.type == BodyType::Dynamic && b.is_sleeping) {
+            return false;
+        }
+        return true;
+    }
+    
+    template <typename Body>
+    inline void update_sleep_state(Body& b, int32_t timestep_micros) {
+        if (b.type != BodyType::Dynamic) {
+            return;
+        }
+        
+        Fixed speed_sq = b.velocity.length_squared();
+        Fixed threshold_sq = b.sleep_threshold * b.sleep_threshold;
+        
+        if (speed_sq < threshold_sq) {
+            b.sleep_timer_ticks += timestep_micros;
+            
+            // Sleep after 1 second of low velocity (1,000,000 microseconds)
+            if (b.sleep_timer_ticks > 1000000) {
+                b.is_sleeping = true;
+                b.velocity = FixedVector3::zero();
+                b.acceleration = FixedVector3::zero();
+            }
+        } else {
+            b.sleep_timer_ticks = 0;
+            b.is_sleeping = false;
+        }
+    }
+    
+    template <typename Body>
+    inline void wake(Body& b) {
+        b.is_sleeping = false;
+        b.sleep_timer_ticks = 0;
+    }
+}
+
 /**
  * Rigid body representation for physics simulation
  * All properties use fixed-point math for determinism
@@ -62,62 +127,16 @@ struct RigidBody {
     {}
     
     // Helper: Check if body should be simulated
-    // Dynamic bodies are always simulated when not sleeping
-    // Kinematic bodies are simulated only when they have non-zero velocity (e.g., knockback)
-    bool should_simulate() const {
-        if (type == BodyType::Static) {
-            return false;
-        }
-        if (is_sleeping) {
-            return false;
-        }
-        if (type == BodyType::Dynamic) {
-            return true;
-        }
-        // Kinematic: simulate only if moving (for knockback decay)
-        return !velocity.is_zero();
-    }
+    bool should_simulate() const { return BodyRules::should_simulate(*this); }
     
     // Helper: Check if body participates in collision detection
-    bool should_collide() const {
-        if (type == BodyType::Static) {
-            return false;
-        }
-        if (type == BodyType::Dynamic && is_sleeping) {
-            return false;
-        }
-        return true;
-    }
+    bool should_collide() const { return BodyRules::should_collide(*this); }
     
     // Helper: Update sleep state based on velocity
-    void update_sleep_state(int32_t timestep_micros) {
-        if (type != BodyType::Dynamic) {
-            return;
-        }
-        
-        Fixed speed_sq = velocity.length_squared();
-        Fixed threshold_sq = sleep_threshold * sleep_threshold;
-        
-        if (speed_sq < threshold_sq) {
-            sleep_timer_ticks += timestep_micros;
-            
-            // Sleep after 1 second of low velocity (1,000,000 microseconds)
-            if (sleep_timer_ticks > 1000000) {
-                is_sleeping = true;
-                velocity = FixedVector3::zero();
-                acceleration = FixedVector3::zero();
-            }
-        } else {
-            sleep_timer_ticks = 0;
-            is_sleeping = false;
-        }
-    }
+    void update_sleep_state(int32_t timestep_micros) { BodyRules::update_sleep_state(*this, timestep_micros); }
     
     // Helper: Wake up the body
-    void wake() {
-        is_sleeping = false;
-        sleep_timer_ticks = 0;
-    }
+    void wake() { BodyRules::wake(*this); }
 };
 
 /**
@@ -144,6 +163,9 @@ struct PhysicsConfig {
     Fixed world_min_y;
     Fixed world_max_y;
     
+    // Broadphase base cell size (zero = derive from body radii each rebuild)
+    Fixed broadphase_cell_size;
+    
     // Default constructor
     PhysicsConfig()
         : gravity(FixedVector3::from_floats(0.0f, -9.81f, 0.0f))
@@ -155,6 +177,7 @@ struct PhysicsConfig {
         , world_max_x(Fixed::from_int(10))
         , world_min_y(Fixed::from_int(-10))
         , world_max_y(Fixed::from_int(10))
+        , broadphase_cell_size(Fixed::from_int(0))
     {}
     
     // Helper: Get timestep as fixed-point seconds
@@ -0,0 +1,65 @@
+#include "PhysicsWorker.h"
+
+#if DOZEDENT_PHYSICS_THREADS
+#include "PhysicsManager.h"
+
+PhysicsWorker::PhysicsWorker(PhysicsManager& manager)
+    : manager_(manager)
+{
+    thread_ = std::thread([this]() { run(); });
+}
+
+PhysicsWorker::~PhysicsWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void PhysicsWorker::kick(float delta_time) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return !has_work_; });
+    
+    // Worker is idle: readers switch to the latest snapshot for this frame,
+    // and commands queued since the last kick are applied before it steps
+    // (draining here rather than on the worker keeps the order deterministic)
+    manager_.latch_snapshot();
+    manager_.drain_commands();
+    
+    pending_dt_ = delta_time;
+    has_work_ = true;
+    lock.unlock();
+    cv_.notify_all();
+}
+
+void PhysicsWorker::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return !has_work_; });
+}
+
+void PhysicsWorker::run() {
+    for (;;) {
+        float dt = 0.0f;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return has_work_ || quit_; });
+            if (quit_) {
+                return;
+            }
+            dt = pending_dt_;
+        }
+        
+        manager_.run_update(dt);
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            has_work_ = false;
+        }
+        cv_.notify_all();
+    }
+}
+#endif
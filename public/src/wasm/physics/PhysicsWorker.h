@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * PhysicsWorker - runs PhysicsManager updates on a dedicated thread
+ *
+ * Only available in builds with DOZEDENT_PHYSICS_THREADS (Emscripten
+ * pthreads / SharedArrayBuffer, or native std::thread). The main thread
+ * calls kick() once per frame; kick() waits for the previous update,
+ * latches the freshly published snapshot for readers, applies queued
+ * commands, then hands the next delta to the worker and returns
+ * immediately.
+ */
+#ifndef DOZEDENT_PHYSICS_THREADS
+#  if defined(__EMSCRIPTEN_PTHREADS__)
+#    define DOZEDENT_PHYSICS_THREADS 1
+#  else
+#    define DOZEDENT_PHYSICS_THREADS 0
+#  endif
+#endif
+
+#if DOZEDENT_PHYSICS_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class PhysicsManager;
+
+class PhysicsWorker {
+public:
+    explicit PhysicsWorker(PhysicsManager& manager);
+    ~PhysicsWorker();
+
+    PhysicsWorker(const PhysicsWorker&) = delete;
+    PhysicsWorker& operator=(const PhysicsWorker&) = delete;
+
+    // Main thread: start the next update (blocks only if the last one is still running)
+    void kick(float delta_time);
+
+    // Main thread: block until the worker is idle
+    void wait_idle();
+
+private:
+    void run();
+
+    PhysicsManager& manager_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    float pending_dt_ = 0.0f;
+    bool has_work_ = false;
+    bool quit_ = false;
+};
+#endif
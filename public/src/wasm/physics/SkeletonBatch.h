@@ -0,0 +1,512 @@
+#pragma once
+#include "FixedPoint.h"
+#include "SkeletonPhysics.h"
+#include "SnapshotStream.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * SkeletonBatch - many PlayerSkeleton-style rigs sharing one topology
+ *
+ * Simulates M humanoid skeletons (same 26 joints and 27 bones as
+ * SkeletonPhysics::PlayerSkeleton) with joint state stored SoA across
+ * instances: column j holds joint j of every skeleton contiguously, so each
+ * step of the integrator and each constraint iteration is a straight loop
+ * over instances instead of a pointer walk per skeleton. Per instance the
+ * results are bit-identical to PlayerSkeleton::update with the same
+ * settings (constraint order, ground pass and balance strategies match).
+ *
+ * Settings are batch-wide. Instances are dense; remove() swap-removes and
+ * returns the index that moved so callers can patch their handles.
+ */
+
+namespace SkeletonPhysics {
+
+// Joint order matches the PlayerSkeleton joint lists
+enum HumanoidJoint : uint8_t {
+    J_HEAD, J_NECK, J_CHEST, J_MID_SPINE, J_LOWER_SPINE, J_PELVIS,
+    J_SHOULDER_L, J_SHOULDER_R, J_ELBOW_L, J_ELBOW_R, J_WRIST_L, J_WRIST_R,
+    J_HAND_L, J_HAND_R, J_HIP_L, J_HIP_R, J_KNEE_L, J_KNEE_R,
+    J_ANKLE_L, J_ANKLE_R, J_HEEL_L, J_HEEL_R, J_FOOT_L, J_FOOT_R, J_TOE_L, J_TOE_R,
+    HUMANOID_JOINT_COUNT
+};
+
+class SkeletonBatch {
+public:
+    static constexpr int JOINT_COUNT = HUMANOID_JOINT_COUNT;
+    static constexpr int BONE_COUNT = 27;
+    static constexpr uint32_t SNAPSHOT_MAGIC = 0x42534B53; // 'SKSB'
+    // Snapshot bytes per instance: positions, previous positions, fixed flags, bone lengths, balance state
+    static constexpr size_t SNAPSHOT_INSTANCE_BYTES =
+        JOINT_COUNT * (4 * sizeof(Fixed) + 1) + BONE_COUNT * sizeof(Fixed) + sizeof(Fixed) + 2;
+
+    struct BoneDef {
+        uint8_t a, b;
+        float stiffness;
+    };
+
+    // Rest pose in units of scale * 0.01, as in PlayerSkeleton::initialize
+    struct JointDef {
+        int16_t dx, dy;
+        float mass;
+    };
+
+    // Settings (same defaults as PlayerSkeleton)
+    Fixed ground_y = Fixed::from_float(0.1f);
+    Fixed balance_strength = Fixed::from_float(0.5f);
+    Fixed ankle_flexibility = Fixed::from_float(0.4f);
+    Fixed damping = Fixed::from_float(0.95f);
+    Fixed gravity = Fixed::from_float(9.8f);
+    bool auto_balance_enabled = true;
+
+    explicit SkeletonBatch(uint32_t capacity = 0) {
+        for (int j = 0; j < JOINT_COUNT; ++j) {
+            mass_[j] = Fixed::from_float(joint_defs()[j].mass);
+        }
+        for (int c = 0; c < BONE_COUNT; ++c) {
+            stiffness_[c] = Fixed::from_float(bone_defs()[c].stiffness);
+        }
+        reserve(capacity);
+    }
+
+    uint32_t size() const { return count_; }
+    uint32_t capacity() const { return capacity_; }
+
+    void clear() { count_ = 0; }
+
+    // Columns are laid out by capacity, so growing re-lays them out once
+    void reserve(uint32_t capacity) {
+        if (capacity <= capacity_) return;
+        relayout(x_, JOINT_COUNT, capacity);
+        relayout(y_, JOINT_COUNT, capacity);
+        relayout(prev_x_, JOINT_COUNT, capacity);
+        relayout(prev_y_, JOINT_COUNT, capacity);
+        relayout(fixed_, JOINT_COUNT, capacity);
+        relayout(length_, BONE_COUNT, capacity);
+        relayout(com_offset_, 1, capacity);
+        relayout(contact_l_, 1, capacity);
+        relayout(contact_r_, 1, capacity);
+        capacity_ = capacity;
+    }
+
+    // Add a skeleton in rest pose; returns its instance index
+    uint32_t add(Fixed center_x, Fixed center_y, Fixed scale = Fixed::from_int(1)) {
+        if (count_ == capacity_) {
+            reserve(capacity_ ? capacity_ * 2 : 8);
+        }
+        const uint32_t i = count_++;
+        const Fixed s = scale * Fixed::from_float(0.01f);
+        for (int j = 0; j < JOINT_COUNT; ++j) {
+            const JointDef& d = joint_defs()[j];
+            const uint32_t k = at(j, i);
+            x_[k] = center_x + s * Fixed::from_int(d.dx);
+            y_[k] = center_y + s * Fixed::from_int(d.dy);
+            prev_x_[k] = x_[k];
+            prev_y_[k] = y_[k];
+            fixed_[k] = 0;
+        }
+        for (int c = 0; c < BONE_COUNT; ++c) {
+            const BoneDef& b = bone_defs()[c];
+            const Fixed dx = x_[at(b.b, i)] - x_[at(b.a, i)];
+            const Fixed dy = y_[at(b.b, i)] - y_[at(b.a, i)];
+            length_[at(c, i)] = fixed_sqrt(dx * dx + dy * dy);
+        }
+        com_offset_[i] = Fixed::from_int(0);
+        contact_l_[i] = 0;
+        contact_r_[i] = 0;
+        return i;
+    }
+
+    // Swap-remove; returns the old index of the instance moved into i, or -1
+    int remove(uint32_t i) {
+        if (i >= count_) return -1;
+        const uint32_t last = --count_;
+        if (i == last) return -1;
+        for (int j = 0; j < JOINT_COUNT; ++j) {
+            x_[at(j, i)] = x_[at(j, last)];
+            y_[at(j, i)] = y_[at(j, last)];
+            prev_x_[at(j, i)] = prev_x_[at(j, last)];
+            prev_y_[at(j, i)] = prev_y_[at(j, last)];
+            fixed_[at(j, i)] = fixed_[at(j, last)];
+        }
+        for (int c = 0; c < BONE_COUNT; ++c) {
+            length_[at(c, i)] = length_[at(c, last)];
+        }
+        com_offset_[i] = com_offset_[last];
+        contact_l_[i] = contact_l_[last];
+        contact_r_[i] = contact_r_[last];
+        return static_cast<int>(last);
+    }
+
+    void update(Fixed dt) {
+        const uint32_t n = count_;
+
+        // Gravity and Verlet integration
+        const Fixed g_force = gravity * dt * dt;
+        for (int j = 0; j < JOINT_COUNT; ++j) {
+            Fixed* x = &x_[at(j, 0)];
+            Fixed* y = &y_[at(j, 0)];
+            Fixed* px = &prev_x_[at(j, 0)];
+            Fixed* py = &prev_y_[at(j, 0)];
+            const uint8_t* fixed = &fixed_[at(j, 0)];
+            for (uint32_t i = 0; i < n; ++i) {
+                if (fixed[i]) continue;
+                y[i] += g_force;
+                const Fixed tx = x[i];
+                const Fixed ty = y[i];
+                x[i] += (x[i] - px[i]) * damping;
+                y[i] += (y[i] - py[i]) * damping;
+                px[i] = tx;
+                py[i] = ty;
+            }
+        }
+
+        solve_constraints(5);
+        apply_ground_constraints();
+        apply_balance_forces();
+        solve_constraints(2);
+    }
+
+    void solve_constraints(int iterations) {
+        for (int iter = 0; iter < iterations; ++iter) {
+            for (int c = 0; c < BONE_COUNT; ++c) {
+                solve_bone(c);
+            }
+        }
+    }
+
+    // Accessors
+    Fixed joint_x(uint32_t i, int joint) const { return x_[at(joint, i)]; }
+    Fixed joint_y(uint32_t i, int joint) const { return y_[at(joint, i)]; }
+    bool foot_contact_l(uint32_t i) const { return contact_l_[i] != 0; }
+    bool foot_contact_r(uint32_t i) const { return contact_r_[i] != 0; }
+    Fixed com_offset(uint32_t i) const { return com_offset_[i]; }
+
+    // Contiguous column of joint positions across all instances
+    const Fixed* joint_x_column(int joint) const { return &x_[at(joint, 0)]; }
+    const Fixed* joint_y_column(int joint) const { return &y_[at(joint, 0)]; }
+
+    void set_joint_fixed(uint32_t i, int joint, bool fixed) { fixed_[at(joint, i)] = fixed ? 1 : 0; }
+
+    void sync_to_position(uint32_t i, Fixed x, Fixed y) {
+        x_[at(J_PELVIS, i)] = x;
+        y_[at(J_PELVIS, i)] = y;
+    }
+
+    void get_foot_positions(uint32_t i, Fixed& left_x, Fixed& left_y, Fixed& right_x, Fixed& right_y) const {
+        const Fixed three = Fixed::from_int(3);
+        left_x = (joint_x(i, J_HEEL_L) + joint_x(i, J_FOOT_L) + joint_x(i, J_TOE_L)) / three;
+        left_y = (joint_y(i, J_HEEL_L) + joint_y(i, J_FOOT_L) + joint_y(i, J_TOE_L)) / three;
+        right_x = (joint_x(i, J_HEEL_R) + joint_x(i, J_FOOT_R) + joint_x(i, J_TOE_R)) / three;
+        right_y = (joint_y(i, J_HEEL_R) + joint_y(i, J_FOOT_R) + joint_y(i, J_TOE_R)) / three;
+    }
+
+    // Rollback snapshot: settings, count and the populated part of each column
+    void save_state(SnapshotWriter& w) const {
+        w.write(SNAPSHOT_MAGIC);
+        w.write(ground_y);
+        w.write(balance_strength);
+        w.write(ankle_flexibility);
+        w.write(damping);
+        w.write(gravity);
+        w.write(auto_balance_enabled);
+        w.write(count_);
+        save_columns(w, x_, JOINT_COUNT);
+        save_columns(w, y_, JOINT_COUNT);
+        save_columns(w, prev_x_, JOINT_COUNT);
+        save_columns(w, prev_y_, JOINT_COUNT);
+        save_columns(w, fixed_, JOINT_COUNT);
+        save_columns(w, length_, BONE_COUNT);
+        w.write_bytes(com_offset_.data(), count_ * sizeof(Fixed));
+        w.write_bytes(contact_l_.data(), count_);
+        w.write_bytes(contact_r_.data(), count_);
+    }
+
+    bool load_state(SnapshotReader& r) {
+        uint32_t magic = 0;
+        uint32_t count = 0;
+        if (!r.read(magic) || magic != SNAPSHOT_MAGIC ||
+            !r.read(ground_y) || !r.read(balance_strength) || !r.read(ankle_flexibility) ||
+            !r.read(damping) || !r.read(gravity) || !r.read(auto_balance_enabled) ||
+            !r.read(count) || count > r.remaining() / SNAPSHOT_INSTANCE_BYTES) {
+            return false;
+        }
+        // count is bounded by the bytes left, so a corrupt one cannot size the columns
+        reserve(count);
+        count_ = count;
+        return load_columns(r, x_, JOINT_COUNT) &&
+            load_columns(r, y_, JOINT_COUNT) &&
+            load_columns(r, prev_x_, JOINT_COUNT) &&
+            load_columns(r, prev_y_, JOINT_COUNT) &&
+            load_columns(r, fixed_, JOINT_COUNT) &&
+            load_columns(r, length_, BONE_COUNT) &&
+            r.read_bytes(com_offset_.data(), count_ * sizeof(Fixed)) &&
+            r.read_bytes(contact_l_.data(), count_) &&
+            r.read_bytes(contact_r_.data(), count_);
+    }
+
+    static const BoneDef* bone_defs() {
+        static const BoneDef BONES[BONE_COUNT] = {
+            // Spine
+            { J_HEAD, J_NECK, 0.95f }, { J_NECK, J_CHEST, 0.9f }, { J_CHEST, J_MID_SPINE, 0.85f },
+            { J_MID_SPINE, J_LOWER_SPINE, 0.85f }, { J_LOWER_SPINE, J_PELVIS, 0.9f },
+            // Shoulders
+            { J_CHEST, J_SHOULDER_L, 0.95f }, { J_CHEST, J_SHOULDER_R, 0.95f }, { J_SHOULDER_L, J_SHOULDER_R, 0.8f },
+            // Arms
+            { J_SHOULDER_L, J_ELBOW_L, 0.9f }, { J_ELBOW_L, J_WRIST_L, 0.9f }, { J_WRIST_L, J_HAND_L, 0.95f },
+            { J_SHOULDER_R, J_ELBOW_R, 0.9f }, { J_ELBOW_R, J_WRIST_R, 0.9f }, { J_WRIST_R, J_HAND_R, 0.95f },
+            // Pelvis and hips
+            { J_PELVIS, J_HIP_L, 0.95f }, { J_PELVIS, J_HIP_R, 0.95f }, { J_HIP_L, J_HIP_R, 0.8f },
+            // Legs
+            { J_HIP_L, J_KNEE_L, 0.9f }, { J_KNEE_L, J_ANKLE_L, 0.9f }, { J_ANKLE_L, J_HEEL_L, 0.95f },
+            { J_HEEL_L, J_FOOT_L, 0.95f }, { J_FOOT_L, J_TOE_L, 0.95f },
+            { J_HIP_R, J_KNEE_R, 0.9f }, { J_KNEE_R, J_ANKLE_R, 0.9f }, { J_ANKLE_R, J_HEEL_R, 0.95f },
+            { J_HEEL_R, J_FOOT_R, 0.95f }, { J_FOOT_R, J_TOE_R, 0.95f }
+        };
+        return BONES;
+    }
+
+    static const JointDef* joint_defs() {
+        static const JointDef JOINTS[JOINT_COUNT] = {
+            { 0, -200, 0.8f }, { 0, -170, 0.5f }, { 0, -140, 2.0f }, { 0, -100, 2.5f },   // head .. mid_spine
+            { 0, -60, 2.5f }, { 0, -20, 3.0f },                                           // lower_spine, pelvis
+            { -35, -150, 1.0f }, { 35, -150, 1.0f }, { -60, -100, 0.7f }, { 60, -100, 0.7f }, // shoulders, elbows
+            { -70, -50, 0.5f }, { 70, -50, 0.5f }, { -75, -30, 0.4f }, { 75, -30, 0.4f },   // wrists, hands
+            { -20, -10, 1.5f }, { 20, -10, 1.5f }, { -25, 80, 1.2f }, { 25, 80, 1.2f },     // hips, knees
+            { -25, 160, 0.8f }, { 25, 160, 0.8f }, { -25, 180, 0.6f }, { 25, 180, 0.6f },   // ankles, heels
+            { -15, 180, 0.5f }, { 15, 180, 0.5f }, { -5, 180, 0.4f }, { 5, 180, 0.4f }      // feet, toes
+        };
+        return JOINTS;
+    }
+
+private:
+    uint32_t at(int row, uint32_t i) const { return static_cast<uint32_t>(row) * capacity_ + i; }
+
+    template <typename T>
+    void relayout(std::vector<T>& column, int rows, uint32_t capacity) const {
+        std::vector<T> grown(static_cast<size_t>(rows) * capacity, T());
+        for (int r = 0; r < rows; ++r) {
+            for (uint32_t i = 0; i < count_; ++i) {
+                grown[static_cast<size_t>(r) * capacity + i] = column[at(r, i)];
+            }
+        }
+        column.swap(grown);
+    }
+
+    template <typename T>
+    void save_columns(SnapshotWriter& w, const std::vector<T>& column, int rows) const {
+        for (int r = 0; r < rows; ++r) {
+            w.write_bytes(&column[at(r, 0)], count_ * sizeof(T));
+        }
+    }
+
+    template <typename T>
+    bool load_columns(SnapshotReader& r, std::vector<T>& column, int rows) {
+        for (int row = 0; row < rows; ++row) {
+            if (!r.read_bytes(&column[at(row, 0)], count_ * sizeof(T))) return false;
+        }
+        return true;
+    }
+
+    // Constraint::solve for bone c across every instance
+    void solve_bone(int c) {
+        const BoneDef& b = bone_defs()[c];
+        Fixed* x1 = &x_[at(b.a, 0)];
+        Fixed* y1 = &y_[at(b.a, 0)];
+        Fixed* x2 = &x_[at(b.b, 0)];
+        Fixed* y2 = &y_[at(b.b, 0)];
+        const uint8_t* f1 = &fixed_[at(b.a, 0)];
+        const uint8_t* f2 = &fixed_[at(b.b, 0)];
+        const Fixed* length = &length_[at(c, 0)];
+        const Fixed half_stiff = stiffness_[c] * Fixed::from_float(0.5f);
+        const Fixed min_dist_sq = Fixed::from_float(0.0001f);
+        const Fixed min_dist = Fixed::from_float(0.01f);
+        const Fixed push_distance = Fixed::from_float(0.01f);
+        const Fixed zero = Fixed::from_int(0);
+
+        for (uint32_t i = 0; i < count_; ++i) {
+            const Fixed dx = x2[i] - x1[i];
+            const Fixed dy = y2[i] - y1[i];
+            const Fixed dist_sq = dx * dx + dy * dy;
+
+            Fixed off_x;
+            Fixed off_y;
+            if (dist_sq < min_dist_sq) {
+                // Joints are too close, push them apart slightly
+                off_x = push_distance;
+                off_y = push_distance;
+                if (dx == zero && dy == zero) {
+                    off_y = zero;
+                } else {
+                    const Fixed dist = fixed_sqrt(dist_sq);
+                    if (dist.raw > 0) {
+                        off_x = (dx * push_distance) / dist;
+                        off_y = (dy * push_distance) / dist;
+                    }
+                }
+            } else {
+                const Fixed dist = fixed_sqrt(dist_sq);
+                if (dist < min_dist) continue;
+                const Fixed diff = (length[i] - dist) / dist;
+                off_x = dx * diff * half_stiff;
+                off_y = dy * diff * half_stiff;
+            }
+
+            if (!f1[i]) {
+                x1[i] -= off_x;
+                y1[i] -= off_y;
+            }
+            if (!f2[i]) {
+                x2[i] += off_x;
+                y2[i] += off_y;
+            }
+        }
+    }
+
+    void apply_ground_constraints() {
+        static const uint8_t GROUND_JOINTS[6] = { J_HEEL_L, J_HEEL_R, J_FOOT_L, J_FOOT_R, J_TOE_L, J_TOE_R };
+        const Fixed friction = Fixed::from_float(0.85f);
+        const Fixed bounce = Fixed::from_float(0.2f);
+
+        for (int g = 0; g < 6; ++g) {
+            const int j = GROUND_JOINTS[g];
+            Fixed* x = &x_[at(j, 0)];
+            Fixed* y = &y_[at(j, 0)];
+            Fixed* px = &prev_x_[at(j, 0)];
+            Fixed* py = &prev_y_[at(j, 0)];
+            for (uint32_t i = 0; i < count_; ++i) {
+                if (y[i] > ground_y) {
+                    y[i] = ground_y;
+                    const Fixed vel_x = x[i] - px[i];
+                    px[i] = x[i] - vel_x * friction;
+                    const Fixed vel_y = y[i] - py[i];
+                    py[i] = ground_y + vel_y * bounce;
+                }
+            }
+        }
+
+        const Fixed contact_y = ground_y - Fixed::from_float(0.001f);
+        for (uint32_t i = 0; i < count_; ++i) {
+            contact_l_[i] = (y_[at(J_HEEL_L, i)] >= contact_y || y_[at(J_FOOT_L, i)] >= contact_y ||
+                             y_[at(J_TOE_L, i)] >= contact_y) ? 1 : 0;
+            contact_r_[i] = (y_[at(J_HEEL_R, i)] >= contact_y || y_[at(J_FOOT_R, i)] >= contact_y ||
+                             y_[at(J_TOE_R, i)] >= contact_y) ? 1 : 0;
+        }
+    }
+
+    // PlayerSkeleton::apply_balance_forces, one instance at a time (branchy per instance)
+    void apply_balance_forces() {
+        if (!auto_balance_enabled) return;
+
+        Fixed total_mass = Fixed::from_int(0);
+        for (int j = 0; j < JOINT_COUNT; ++j) {
+            total_mass += mass_[j];
+        }
+
+        for (uint32_t i = 0; i < count_; ++i) {
+            Fixed com_x = Fixed::from_int(0);
+            for (int j = 0; j < JOINT_COUNT; ++j) {
+                com_x += x_[at(j, i)] * mass_[j];
+            }
+            com_x = com_x / total_mass;
+
+            const bool left = contact_l_[i] != 0;
+            const bool right = contact_r_[i] != 0;
+            if (!left && !right) continue; // Not grounded
+
+            const Fixed three = Fixed::from_int(3);
+            const Fixed support_left = left
+                ? (X(J_HEEL_L, i) + X(J_FOOT_L, i) + X(J_TOE_L, i)) / three : Fixed::from_int(0);
+            const Fixed support_right = right
+                ? (X(J_HEEL_R, i) + X(J_FOOT_R, i) + X(J_TOE_R, i)) / three : Fixed::from_int(0);
+            const Fixed foot_center_x = (left && right)
+                ? (support_left + support_right) / Fixed::from_int(2)
+                : (left ? support_left : support_right);
+
+            const Fixed offset = com_x - foot_center_x;
+            com_offset_[i] = offset;
+
+            // ANKLE STRATEGY: Small disturbances
+            if (offset.abs() < Fixed::from_float(0.015f)) {
+                const Fixed ankle_force = -offset * ankle_flexibility * Fixed::from_float(0.8f);
+                const Fixed heel_toe = ankle_force * Fixed::from_float(0.3f);
+                if (left) {
+                    X(J_ANKLE_L, i) += ankle_force;
+                    X(J_HEEL_L, i) -= heel_toe;
+                    X(J_TOE_L, i) += heel_toe;
+                }
+                if (right) {
+                    X(J_ANKLE_R, i) += ankle_force;
+                    X(J_HEEL_R, i) -= heel_toe;
+                    X(J_TOE_R, i) += heel_toe;
+                }
+            }
+
+            // HIP STRATEGY: Larger disturbances
+            const Fixed hip_correction = -offset * balance_strength;
+            X(J_PELVIS, i) += hip_correction;
+            X(J_LOWER_SPINE, i) += hip_correction * Fixed::from_float(0.8f);
+            X(J_MID_SPINE, i) += hip_correction * Fixed::from_float(0.6f);
+            X(J_CHEST, i) += hip_correction * Fixed::from_float(0.4f);
+            X(J_NECK, i) += hip_correction * Fixed::from_float(0.2f);
+            X(J_HEAD, i) += hip_correction * Fixed::from_float(0.1f);
+
+            // Weight distribution
+            if (left && right) {
+                const Fixed shift_amount = (offset * Fixed::from_float(0.05f)).abs();
+                const Fixed heavy = Fixed::from_float(1.5f);
+                const Fixed light = Fixed::from_float(0.5f);
+                const Fixed shift_l = shift_amount * ((offset < Fixed::from_int(0)) ? heavy : light);
+                const Fixed shift_r = shift_amount * ((offset > Fixed::from_int(0)) ? heavy : light);
+                Y(J_HEEL_L, i) -= shift_l;
+                Y(J_FOOT_L, i) -= shift_l;
+                Y(J_TOE_L, i) -= shift_l;
+                Y(J_HEEL_R, i) -= shift_r;
+                Y(J_FOOT_R, i) -= shift_r;
+                Y(J_TOE_R, i) -= shift_r;
+
+                // STEPPING STRATEGY: Very large disturbances
+                if (offset.abs() > Fixed::from_float(0.05f)) {
+                    const Fixed step_adjust = offset * Fixed::from_float(0.1f);
+                    if (offset > Fixed::from_int(0)) {
+                        X(J_HEEL_R, i) += step_adjust;
+                        X(J_FOOT_R, i) += step_adjust;
+                        X(J_TOE_R, i) += step_adjust;
+                    } else if (offset < Fixed::from_int(0)) {
+                        X(J_HEEL_L, i) += step_adjust;
+                        X(J_FOOT_L, i) += step_adjust;
+                        X(J_TOE_L, i) += step_adjust;
+                    }
+                }
+            }
+
+            // Knee locking for stability
+            const Fixed knee_strength = Fixed::from_float(0.15f);
+            if (left) {
+                X(J_KNEE_L, i) += (X(J_ANKLE_L, i) - X(J_KNEE_L, i)) * knee_strength;
+            }
+            if (right) {
+                X(J_KNEE_R, i) += (X(J_ANKLE_R, i) - X(J_KNEE_R, i)) * knee_strength;
+            }
+        }
+    }
+
+    Fixed& X(int joint, uint32_t i) { return x_[at(joint, i)]; }
+    Fixed& Y(int joint, uint32_t i) { return y_[at(joint, i)]; }
+
+    uint32_t count_ = 0;
+    uint32_t capacity_ = 0;
+
+    // Shared topology data
+    Fixed mass_[JOINT_COUNT];
+    Fixed stiffness_[BONE_COUNT];
+
+    // SoA columns: [row * capacity_ + instance]
+    std::vector<Fixed> x_, y_, prev_x_, prev_y_;
+    std::vector<uint8_t> fixed_;
+    std::vector<Fixed> length_;
+    std::vector<Fixed> com_offset_;
+    std::vector<uint8_t> contact_l_, contact_r_;
+};
+
+} // namespace SkeletonPhysics
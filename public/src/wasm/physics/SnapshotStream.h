@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * SnapshotWriter / SnapshotReader - flat byte streams for simulation state
+ *
+ * Used by GameCoordinator::save_state / load_state (rollback snapshots).
+ * Only trivially copyable values are written, as raw memcpy images, so
+ * saving N bodies or wolves is a handful of bulk copies. Snapshots are
+ * only meant to be restored by the same build (the coordinator checks a
+ * layout fingerprint), so no endianness or padding normalization is done.
+ *
+ * A writer without a buffer only counts bytes, which is how the required
+ * buffer size is computed.
+ */
+class SnapshotWriter {
+public:
+    SnapshotWriter() = default;
+    SnapshotWriter(uint8_t* out, size_t capacity) : out_(out), capacity_(capacity) {}
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot values must be trivially copyable");
+        write_bytes(&value, sizeof(T));
+    }
+
+    // Element count followed by the raw array
+    template <typename T>
+    void write_array(const T* data, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot values must be trivially copyable");
+        write(static_cast<uint32_t>(count));
+        write_bytes(data, count * sizeof(T));
+    }
+
+    template <typename T>
+    void write_vector(const std::vector<T>& values) {
+        write_array(values.data(), values.size());
+    }
+
+    void write_bytes(const void* data, size_t size) {
+        if (out_) {
+            if (size_ + size > capacity_) {
+                overflow_ = true;
+            } else if (size > 0) {
+                std::memcpy(out_ + size_, data, size);
+            }
+        }
+        size_ += size;
+    }
+
+    // Overwrite a value already written at offset (for headers patched after the body)
+    template <typename T>
+    void patch(size_t offset, const T& value) {
+        if (out_ && offset + sizeof(T) <= capacity_) {
+            std::memcpy(out_ + offset, &value, sizeof(T));
+        }
+    }
+
+    size_t size() const { return size_; }
+    bool ok() const { return !overflow_; }
+
+private:
+    uint8_t* out_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    bool overflow_ = false;
+};
+
+class SnapshotReader {
+public:
+    SnapshotReader(const uint8_t* in, size_t size) : in_(in), size_(size) {}
+
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot values must be trivially copyable");
+        return read_bytes(&value, sizeof(T));
+    }
+
+    // Reuses the vector's capacity, so steady-state restores do not allocate
+    template <typename T>
+    bool read_vector(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot values must be trivially copyable");
+        uint32_t count = 0;
+        // Divide rather than multiply: count * sizeof(T) wraps in a 32-bit size_t
+        if (!read(count) || count > remaining() / sizeof(T)) {
+            return fail();
+        }
+        values.resize(count);
+        return read_bytes(values.data(), count * sizeof(T));
+    }
+
+    bool read_bytes(void* data, size_t size) {
+        if (size > remaining()) {
+            return fail();
+        }
+        if (size > 0) {
+            std::memcpy(data, in_ + offset_, size);
+        }
+        offset_ += size;
+        return true;
+    }
+
+    size_t remaining() const { return size_ - offset_; }
+    size_t offset() const { return offset_; }
+    bool ok() const { return !failed_; }
+
+private:
+    bool fail() {
+        failed_ = true;
+        offset_ = size_;
+        return false;
+    }
+
+    const uint8_t* in_;
+    size_t size_;
+    size_t offset_ = 0;
+    bool failed_ = false;
+};
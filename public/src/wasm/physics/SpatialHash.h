@@ -1,94 +1,265 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
-#include <unordered_map>
 #include <vector>
 #include "PhysicsTypes.h"
+#include "CollisionLayers.h"
+#include "BodyStore.h"
 
-// Lightweight uniform grid spatial hash for broadphase pairing
+// Hierarchical uniform grid broadphase built with a counting sort into flat arrays.
+// All storage lives in member vectors that are cleared (not freed) each
+// rebuild, so steady-state frames perform no heap allocations.
+// Pairs are emitted as dense BodyStore indices and are already
+// filtered by should_collide() and the layer/mask test.
+//
+// Each body is placed on the finest level whose cell size is at least its
+// diameter (level L has cell size base << L). Same-level pairs use the usual
+// forward-neighbor sweep; a body also probes the 3x3 neighborhood of its cell
+// on every coarser occupied level, so each cross-level pair is emitted once.
+//
+// A second instance indexes only sleeping bodies (Gather::Sleeping); awake
+// bodies probe it with queryCandidates() to find sleepers they touch. A third
+// indexes every body (Gather::Any) for PhysicsManager::query_overlap.
 class SpatialHash {
 public:
+    static constexpr int MAX_LEVELS = 8;
+
+    enum class Gather {
+        Colliding,  // should_collide(): awake dynamic and kinematic bodies
+        Sleeping,   // sleeping dynamic bodies only
+        Any         // every body, whatever its type or state
+    };
+
     struct GridKey {
         int32_t x;
         int32_t y;
-        bool operator==(const GridKey &o) const { return x == o.x && y == o.y; }
+        int32_t level;
+        bool operator==(const GridKey &o) const { return x == o.x && y == o.y && level == o.level; }
     };
 
-    struct KeyHasher {
-        size_t operator()(const GridKey &k) const noexcept {
-            // Simple mix
-            return (static_cast<uint32_t>(k.x) * 73856093u) ^ (static_cast<uint32_t>(k.y) * 19349663u);
+    SpatialHash() : cellSize_(Fixed::from_float(0.2f)), configuredCellSize_(cellSize_) {}
+
+    // Base cell size; zero or negative selects auto sizing from the radius distribution
+    void setCellSize(Fixed size) { configuredCellSize_ = size; }
+    Fixed getCellSize() const { return cellSize_; }
+
+    void clear() {
+        entries_.clear();
+        sorted_.clear();
+        bucketStart_.clear();
+        for (int l = 0; l < MAX_LEVELS; ++l) {
+            levelCount_[l] = 0;
+            levelMaxRadius_[l] = 0;
+        }
+    }
+
+    void update(const BodyStore &bodies) {
+        update(bodies, 0, bodies.size(), Gather::Colliding);
+    }
+
+    // Index bodies [begin, end) that match the gather rule
+    void update(const BodyStore &bodies, size_t begin, size_t end, Gather gather) {
+        entries_.clear();
+        for (int l = 0; l < MAX_LEVELS; ++l) {
+            levelCount_[l] = 0;
+            levelMaxRadius_[l] = 0;
+        }
+
+        const BodyType *types = bodies.types();
+        const BodyStore::SleepState *sleep = bodies.sleep_states();
+        for (size_t i = begin; i < end; ++i) {
+            const bool take = gather == Gather::Any ||
+                (gather == Gather::Colliding
+                    ? bodies[i].should_collide()
+                    : types[i] == BodyType::Dynamic && sleep[i].is_sleeping);
+            if (!take) continue;
+            Entry e;
+            e.key = {0, 0, 0};
+            e.index = static_cast<uint32_t>(i);
+            e.bucket = 0;
+            entries_.push_back(e);
         }
-    };
 
-    SpatialHash() : cellSize_(Fixed::from_float(0.2f)) {}
+        chooseCellSize(bodies);
 
-    void clear() { cells_.clear(); }
+        const FixedVector3 *positions = bodies.positions();
+        const Fixed *radii = bodies.radii();
+        for (auto &e : entries_) {
+            const FixedVector3 &p = positions[e.index];
+            const int level = levelForRadius(radii[e.index]);
+            e.key = toKey(p.x, p.y, level);
+            levelCount_[level]++;
+            if (radii[e.index].raw > levelMaxRadius_[level]) levelMaxRadius_[level] = radii[e.index].raw;
+        }
+
+        // Table size: power of two, at least twice the entry count
+        uint32_t tableSize = 16;
+        while (tableSize < entries_.size() * 2) tableSize <<= 1;
+        mask_ = tableSize - 1;
 
-    void update(const std::vector<RigidBody> &bodies) {
-        cells_.clear();
-        // Insert dynamic and kinematic bodies; skip static
-        for (const auto &b : bodies) {
-            if (b.type == BodyType::Static) continue;
-            GridKey key = toKey(b.position.x, b.position.y);
-            auto &vec = cells_[key];
-            vec.push_back(b.id);
+        // Counting sort by bucket: count, prefix sum, scatter
+        bucketStart_.assign(tableSize + 1, 0);
+        for (auto &e : entries_) {
+            e.bucket = hashKey(e.key);
+            bucketStart_[e.bucket + 1]++;
+        }
+        for (uint32_t b = 0; b < tableSize; ++b) {
+            bucketStart_[b + 1] += bucketStart_[b];
+        }
+        sorted_.resize(entries_.size());
+        cursor_.assign(bucketStart_.begin(), bucketStart_.end() - 1);
+        for (const auto &e : entries_) {
+            sorted_[cursor_[e.bucket]++] = e;
         }
     }
 
-    void getPotentialPairs(const std::vector<RigidBody> &bodies, std::vector<std::pair<uint32_t, uint32_t>> &outPairs) const {
+    void getPotentialPairs(const BodyStore &bodies, std::vector<std::pair<uint32_t, uint32_t>> &outPairs) const {
         outPairs.clear();
-        
+        if (sorted_.empty()) return;
+
         // Only check 4 neighbors (right, down, down-right, down-left) to avoid duplicates
-        // Each pair is only generated once when the cell with the smaller key processes it
         static const int NEIGHBOR_OFF[4][2] = {{1,0}, {0,1}, {1,1}, {-1,1}};
-        
-        for (const auto &entry : cells_) {
-            const GridKey &k = entry.first;
-            const std::vector<uint32_t> &vec = entry.second;
-            
-            // Within-cell pairs (always checked)
-            for (size_t i = 0; i < vec.size(); ++i) {
-                for (size_t j = i + 1; j < vec.size(); ++j) {
-                    uint32_t a = vec[i];
-                    uint32_t b = vec[j];
-                    if (a > b) {
-                        std::swap(a, b);
-                    }
-                    outPairs.emplace_back(a, b);
+
+        for (size_t i = 0; i < sorted_.size(); ++i) {
+            const Entry &a = sorted_[i];
+
+            // Within-cell pairs: later entries of the same bucket with the same key
+            const uint32_t end = bucketStart_[a.bucket + 1];
+            for (uint32_t j = static_cast<uint32_t>(i) + 1; j < end; ++j) {
+                if (sorted_[j].key == a.key) {
+                    emitPair(bodies, a.index, sorted_[j].index, outPairs);
                 }
             }
-            
-            // Check only forward neighbors to avoid duplicate pairs
+
+            // Forward neighbor cells; exact key match filters bucket collisions
             for (int n = 0; n < 4; ++n) {
-                GridKey nk{ k.x + NEIGHBOR_OFF[n][0], k.y + NEIGHBOR_OFF[n][1] };
-                auto it = cells_.find(nk);
-                if (it == cells_.end()) {
-                    continue;
+                GridKey nk{ a.key.x + NEIGHBOR_OFF[n][0], a.key.y + NEIGHBOR_OFF[n][1], a.key.level };
+                probeCell(bodies, a.index, nk, outPairs);
+            }
+
+            // Coarser levels: full 3x3 neighborhood around this body's cell there
+            const FixedVector3 &pos = bodies.positions()[a.index];
+            for (int level = a.key.level + 1; level < MAX_LEVELS; ++level) {
+                if (levelCount_[level] == 0) continue;
+                const GridKey ck = toKey(pos.x, pos.y, level);
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        probeCell(bodies, a.index, GridKey{ ck.x + dx, ck.y + dy, level }, outPairs);
+                    }
                 }
-                for (uint32_t a : vec) {
-                    for (uint32_t b : it->second) {
-                        // Canonical ordering to ensure consistent pair representation
-                        if (a > b) {
-                            outPairs.emplace_back(b, a);
-                        } else {
-                            outPairs.emplace_back(a, b);
-                        }
+            }
+        }
+    }
+
+    // Indexed bodies whose cells a sphere at (pos, radius) could overlap, as
+    // dense indices (appended, unfiltered; callers run the exact test)
+    void queryCandidates(const FixedVector3 &pos, Fixed radius, std::vector<uint32_t> &out) const {
+        if (sorted_.empty()) return;
+        for (int level = 0; level < MAX_LEVELS; ++level) {
+            if (levelCount_[level] == 0) continue;
+            // Any overlapping body's center lies within radius + its own radius
+            const Fixed reach(radius.raw + levelMaxRadius_[level]);
+            const GridKey lo = toKey(pos.x - reach, pos.y - reach, level);
+            const GridKey hi = toKey(pos.x + reach, pos.y + reach, level);
+            for (int32_t y = lo.y; y <= hi.y; ++y) {
+                for (int32_t x = lo.x; x <= hi.x; ++x) {
+                    const GridKey key{ x, y, level };
+                    const uint32_t b = hashKey(key);
+                    for (uint32_t j = bucketStart_[b]; j < bucketStart_[b + 1]; ++j) {
+                        if (sorted_[j].key == key) out.push_back(sorted_[j].index);
                     }
                 }
             }
         }
     }
 
+    size_t getEntryCount() const { return sorted_.size(); }
+    uint32_t getLevelCount(int level) const {
+        return (level >= 0 && level < MAX_LEVELS) ? levelCount_[level] : 0;
+    }
+
 private:
-    GridKey toKey(Fixed fx, Fixed fy) const {
-        const float cs = cellSize_.to_float();
-        int32_t gx = static_cast<int32_t>(std::floor(fx.to_float() / cs));
-        int32_t gy = static_cast<int32_t>(std::floor(fy.to_float() / cs));
-        return {gx, gy};
+    struct Entry {
+        GridKey key;
+        uint32_t index;   // dense index into the BodyStore
+        uint32_t bucket;  // hash bucket in the flat table
+    };
+
+    void probeCell(const BodyStore &bodies, uint32_t ia, const GridKey &key,
+                   std::vector<std::pair<uint32_t, uint32_t>> &outPairs) const {
+        const uint32_t nb = hashKey(key);
+        for (uint32_t j = bucketStart_[nb]; j < bucketStart_[nb + 1]; ++j) {
+            if (sorted_[j].key == key) {
+                emitPair(bodies, ia, sorted_[j].index, outPairs);
+            }
+        }
     }
 
-    Fixed cellSize_;
-    std::unordered_map<GridKey, std::vector<uint32_t>, KeyHasher> cells_;
-};
+    static void emitPair(const BodyStore &bodies, uint32_t ia, uint32_t ib,
+                         std::vector<std::pair<uint32_t, uint32_t>> &outPairs) {
+        const uint32_t *layers = bodies.layers();
+        const uint32_t *masks = bodies.masks();
+        if (!shouldCollide(layers[ia], masks[ia], layers[ib], masks[ib])) {
+            return;
+        }
+        // Canonical ordering to ensure consistent pair representation
+        if (ia > ib) std::swap(ia, ib);
+        outPairs.emplace_back(ia, ib);
+    }
 
+    // Auto mode: base cell is twice the median radius (one typical diameter)
+    void chooseCellSize(const BodyStore &bodies) {
+        if (configuredCellSize_.raw > 0) {
+            cellSize_ = configuredCellSize_;
+            return;
+        }
+        if (entries_.empty()) return;
+        radii_.clear();
+        for (const auto &e : entries_) radii_.push_back(bodies.radii()[e.index].raw);
+        std::nth_element(radii_.begin(), radii_.begin() + radii_.size() / 2, radii_.end());
+        int32_t size = radii_[radii_.size() / 2] * 2;
+        const int32_t MIN_CELL = Fixed::from_float(0.02f).raw;
+        cellSize_ = Fixed(size < MIN_CELL ? MIN_CELL : size);
+    }
+
+    int levelForRadius(Fixed radius) const {
+        const int64_t diameter = static_cast<int64_t>(radius.raw) * 2;
+        int64_t cell = cellSize_.raw;
+        int level = 0;
+        while (cell < diameter && level < MAX_LEVELS - 1) {
+            cell <<= 1;
+            ++level;
+        }
+        return level;
+    }
+
+    uint32_t hashKey(const GridKey &k) const {
+        return ((static_cast<uint32_t>(k.x) * 73856093u) ^
+                (static_cast<uint32_t>(k.y) * 19349663u) ^
+                (static_cast<uint32_t>(k.level) * 83492791u)) & mask_;
+    }
 
+    // Floor division on raw fixed-point values (no float round-trip)
+    static int32_t floorDiv(int32_t v, int32_t d) {
+        int32_t q = v / d;
+        if ((v % d != 0) && (v < 0)) --q;
+        return q;
+    }
+
+    GridKey toKey(Fixed fx, Fixed fy, int level) const {
+        const int64_t cell = static_cast<int64_t>(cellSize_.raw) << level;
+        const int32_t cs = cell > 0x7FFFFFFF ? 0x7FFFFFFF : static_cast<int32_t>(cell);
+        return { floorDiv(fx.raw, cs), floorDiv(fy.raw, cs), level };
+    }
+
+    Fixed cellSize_;
+    Fixed configuredCellSize_;
+    uint32_t mask_ = 0;
+    uint32_t levelCount_[MAX_LEVELS] = {};
+    int32_t levelMaxRadius_[MAX_LEVELS] = {};
+    std::vector<Entry> entries_;
+    std::vector<Entry> sorted_;
+    std::vector<uint32_t> bucketStart_;
+    std::vector<uint32_t> cursor_;
+    std::vector<int32_t> radii_;
+};
@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * SpscRing - fixed-capacity single-producer/single-consumer ring buffer
+ *
+ * One thread pushes, one thread peeks/consumes. Head and tail are
+ * free-running counters, so each side only writes its own index and no
+ * locks are needed. When full, push() fails and the drop is counted
+ * rather than overwriting unread entries.
+ *
+ * Reads are span based: peek() returns the longest contiguous run of
+ * unread entries starting at the head. After a wrap, drain with
+ * peek/consume in a loop.
+ */
+template <typename T, int Capacity>
+class SpscRing {
+public:
+    static constexpr int CAPACITY = Capacity;  // Must be a power of two
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    SpscRing() : head_(0), tail_(0), dropped_(0) {}
+
+    // Producer side
+    bool push(const T &e) {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const uint32_t head = head_.load(std::memory_order_acquire);
+        if (tail - head >= static_cast<uint32_t>(Capacity)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        buffer_[tail & MASK] = e;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: contiguous unread span starting at the head
+    int peek(const T **out) const {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        const uint32_t tail = tail_.load(std::memory_order_acquire);
+        const uint32_t pending = tail - head;
+        const uint32_t start = head & MASK;
+        const uint32_t run = static_cast<uint32_t>(Capacity) - start;
+        if (out) *out = buffer_ + start;
+        return static_cast<int>(pending < run ? pending : run);
+    }
+
+    void consume(int n) {
+        if (n <= 0) return;
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        const uint32_t tail = tail_.load(std::memory_order_acquire);
+        const uint32_t pending = tail - head;
+        const uint32_t step = static_cast<uint32_t>(n) < pending ? static_cast<uint32_t>(n) : pending;
+        head_.store(head + step, std::memory_order_release);
+    }
+
+    // Discard everything currently visible to the consumer
+    void clear() {
+        head_.store(tail_.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    // Start of the current contiguous span; pairs with span_count()
+    const T *data() const {
+        const T *p = nullptr;
+        peek(&p);
+        return p;
+    }
+    int span_count() const { return peek(nullptr); }
+
+    // Total unread entries (may exceed span_count() after a wrap)
+    int count() const {
+        return static_cast<int>(tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_relaxed));
+    }
+    bool empty() const { return count() == 0; }
+
+    // Monotonic; consumers diff successive reads
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    uint32_t pushed() const { return tail_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr uint32_t MASK = static_cast<uint32_t>(Capacity) - 1;
+
+    T buffer_[Capacity];
+    std::atomic<uint32_t> head_;     // Written by consumer only
+    std::atomic<uint32_t> tail_;     // Written by producer only
+    std::atomic<uint32_t> dropped_;  // Written by producer only
+};
@@ -0,0 +1,359 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "PhysicsTypes.h"
+#include "BodyStore.h"
+#include "CollisionLayers.h"
+#include "FrameHash.h"
+#include "SnapshotStream.h"
+
+enum class StaticShape : uint8_t {
+    Circle = 0,
+    Box = 1
+};
+
+// Fixed obstacles in the x/y plane (rocks, walls, pillars)
+struct StaticCollider {
+    Fixed x, y;            // Centre
+    Fixed half_x, half_y;  // Box half extents; a circle's radius is half_x
+    uint32_t id;           // Assigned by StaticGeometry::add
+    uint32_t owner;        // Caller tag for remove_owner (WorldManager: chunk + 1); 0 = none
+    uint32_t layers;       // Body layers it blocks (the body's mask must include Environment)
+    StaticShape shape;
+    uint8_t reserved[3];   // Zeroed by add, so hashes see no stale padding
+};
+
+/**
+ * StaticGeometry - immovable colliders kept out of the dynamic broadphase
+ *
+ * Colliders never move, so they sit in a grid of their own that is only
+ * rebuilt when one is added or removed (a room streaming in), not every
+ * step like the body grid. Each step PhysicsManager runs resolve over the
+ * awake rows after the ground pass: a body overlapping a collider is pushed
+ * out along the contact normal and loses the velocity into it. Sleeping
+ * bodies are not visited; one that a new collider lands on is pushed out
+ * when it wakes.
+ *
+ * Tests are discrete, like sphere pairs: a body faster than its radius per
+ * step can pass through a thin wall (mark it a bullet for body contacts;
+ * static geometry is never swept).
+ *
+ * Colliders are simulation state: PhysicsManager saves them and hashes them
+ * when there are any.
+ */
+class StaticGeometry {
+public:
+    // Colliders spanning more cells than this skip the grid and are tested
+    // against every body
+    static constexpr int32_t MAX_CELLS_PER_COLLIDER = 64;
+
+    uint32_t add(StaticCollider c) {
+        c.id = next_id_++;
+        c.reserved[0] = c.reserved[1] = c.reserved[2] = 0;
+        if (c.shape == StaticShape::Circle) c.half_y = c.half_x;
+        colliders_.push_back(c);
+        grid_dirty_ = true;
+        return c.id;
+    }
+
+    bool remove(uint32_t id) {
+        for (size_t i = 0; i < colliders_.size(); ++i) {
+            if (colliders_[i].id == id) {
+                colliders_.erase(colliders_.begin() + static_cast<std::ptrdiff_t>(i));
+                grid_dirty_ = true;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Removes every collider with this owner; returns how many
+    int remove_owner(uint32_t owner) {
+        const size_t before = colliders_.size();
+        colliders_.erase(std::remove_if(colliders_.begin(), colliders_.end(),
+                                        [owner](const StaticCollider& c) { return c.owner == owner; }),
+                         colliders_.end());
+        const int removed = static_cast<int>(before - colliders_.size());
+        if (removed) grid_dirty_ = true;
+        return removed;
+    }
+
+    void clear() {
+        colliders_.clear();
+        grid_dirty_ = true;
+    }
+
+    bool empty() const { return colliders_.empty(); }
+    size_t size() const { return colliders_.size(); }
+    const std::vector<StaticCollider>& colliders() const { return colliders_; }
+
+    void set_cell_size(Fixed size) {
+        if (size > Fixed::from_int(0) && size != cell_size_) {
+            cell_size_ = size;
+            grid_dirty_ = true;
+        }
+    }
+
+    // Body-collider overlap tests and contacts resolved during the last step
+    uint32_t get_tests() const { return tests_; }
+    uint32_t get_contacts() const { return contacts_; }
+
+    // Bodies [0, count): PhysicsManager passes its awake range
+    void resolve(BodyStore& bodies, size_t count) {
+        tests_ = 0;
+        contacts_ = 0;
+        if (colliders_.empty()) return;
+        ensure_grid();
+
+        const BodyType* types = bodies.types();
+        const Fixed* radii = bodies.radii();
+        const Fixed* inverse_masses = bodies.inverse_masses();
+        const uint32_t* layers = bodies.layers();
+        const uint32_t* masks = bodies.masks();
+        FixedVector3* positions = bodies.positions();
+        FixedVector3* velocities = bodies.velocities();
+        for (size_t i = 0; i < count; ++i) {
+            if (types[i] != BodyType::Dynamic || inverse_masses[i] <= Fixed::from_int(0) ||
+                (masks[i] & CollisionLayers::Environment) == 0u) {
+                continue;
+            }
+            FixedVector3& p = positions[i];
+            FixedVector3& v = velocities[i];
+            push_out(p.x, p.y, radii[i], layers[i], &v.x, &v.y);
+        }
+    }
+
+    // Pushes a circle that is not a body (the player) out of every collider
+    // that blocks layer; true if it moved
+    bool push_out(Fixed& x, Fixed& y, Fixed radius, uint32_t layer, Fixed* vx = nullptr, Fixed* vy = nullptr) {
+        if (colliders_.empty()) return false;
+        ensure_grid();
+        gather(x, y, radius);
+        bool moved = false;
+        for (uint32_t k : candidates_) {
+            const StaticCollider& c = colliders_[k];
+            if ((c.layers & layer) == 0u) continue;
+            ++tests_;
+            Fixed nx, ny, depth;
+            if (!penetration(c, x, y, radius, nx, ny, depth)) continue;
+            x += nx * depth;
+            y += ny * depth;
+            if (vx && vy) {
+                // Drop the velocity into the surface; sliding along it is kept
+                const Fixed vn = *vx * nx + *vy * ny;
+                if (vn < Fixed::from_int(0)) {
+                    *vx -= nx * vn;
+                    *vy -= ny * vn;
+                }
+            }
+            ++contacts_;
+            moved = true;
+        }
+        return moved;
+    }
+
+    void save_state(SnapshotWriter& w) const {
+        w.write_vector(colliders_);
+        w.write(next_id_);
+    }
+
+    bool load_state(SnapshotReader& r) {
+        grid_dirty_ = true;
+        return r.read_vector(colliders_) && r.read(next_id_);
+    }
+
+    void hash_state(FrameHasher& h) const {
+        h.add(static_cast<uint32_t>(colliders_.size()));
+        for (const StaticCollider& c : colliders_) {
+            h.add(c);
+        }
+    }
+
+private:
+    std::vector<StaticCollider> colliders_;  // In insertion order; candidates are visited in this order
+    uint32_t next_id_ = 1;
+    Fixed cell_size_ = Fixed::from_float(0.25f);
+    uint32_t tests_ = 0;
+    uint32_t contacts_ = 0;
+
+    // Grid over colliders: counting-sorted (bucket, collider) entries
+    bool grid_dirty_ = true;
+    uint32_t mask_ = 0;
+    std::vector<uint32_t> bucket_start_;
+    std::vector<uint32_t> bucket_items_;
+    std::vector<uint32_t> large_;         // Colliders too big for the grid
+    std::vector<uint32_t> stamp_of_;      // Last query that took each collider
+    uint32_t stamp_ = 0;
+    std::vector<uint32_t> candidates_;
+
+    struct GridEntry {
+        int32_t cx, cy;
+        uint32_t collider;
+        uint32_t bucket = 0;
+    };
+    std::vector<GridEntry> entries_;  // Build scratch
+
+    struct CellRange {
+        int32_t x0, y0, x1, y1;
+    };
+
+    static int32_t floor_div(int64_t v, int32_t d) {
+        int64_t q = v / d;
+        if ((v % d != 0) && (v < 0)) --q;
+        return static_cast<int32_t>(q);
+    }
+
+    CellRange cells_of(Fixed x, Fixed y, Fixed hx, Fixed hy) const {
+        CellRange r;
+        r.x0 = floor_div(static_cast<int64_t>(x.raw) - hx.raw, cell_size_.raw);
+        r.x1 = floor_div(static_cast<int64_t>(x.raw) + hx.raw, cell_size_.raw);
+        r.y0 = floor_div(static_cast<int64_t>(y.raw) - hy.raw, cell_size_.raw);
+        r.y1 = floor_div(static_cast<int64_t>(y.raw) + hy.raw, cell_size_.raw);
+        return r;
+    }
+
+    static int64_t cell_count(const CellRange& r) {
+        return (static_cast<int64_t>(r.x1) - r.x0 + 1) * (static_cast<int64_t>(r.y1) - r.y0 + 1);
+    }
+
+    uint32_t bucket_of(int32_t cx, int32_t cy) const {
+        return ((static_cast<uint32_t>(cx) * 73856093u) ^ (static_cast<uint32_t>(cy) * 19349663u)) & mask_;
+    }
+
+    void ensure_grid() {
+        if (!grid_dirty_) return;
+        grid_dirty_ = false;
+        entries_.clear();
+        large_.clear();
+        for (size_t k = 0; k < colliders_.size(); ++k) {
+            const StaticCollider& c = colliders_[k];
+            const CellRange r = cells_of(c.x, c.y, c.half_x, c.half_y);
+            if (cell_count(r) > MAX_CELLS_PER_COLLIDER) {
+                large_.push_back(static_cast<uint32_t>(k));
+                continue;
+            }
+            for (int32_t cy = r.y0; cy <= r.y1; ++cy) {
+                for (int32_t cx = r.x0; cx <= r.x1; ++cx) {
+                    entries_.push_back(GridEntry{ cx, cy, static_cast<uint32_t>(k) });
+                }
+            }
+        }
+
+        uint32_t table_size = 16;
+        while (table_size < entries_.size() * 2) table_size <<= 1;
+        mask_ = table_size - 1;
+        bucket_start_.assign(table_size + 1, 0);
+        for (GridEntry& e : entries_) {
+            e.bucket = bucket_of(e.cx, e.cy);
+            bucket_start_[e.bucket + 1]++;
+        }
+        for (uint32_t b = 0; b < table_size; ++b) {
+            bucket_start_[b + 1] += bucket_start_[b];
+        }
+        bucket_items_.resize(entries_.size());
+        std::vector<uint32_t>& cursor = candidates_;  // Free until the next query
+        cursor.assign(bucket_start_.begin(), bucket_start_.end() - 1);
+        for (const GridEntry& e : entries_) {
+            bucket_items_[cursor[e.bucket]++] = e.collider;
+        }
+        stamp_of_.assign(colliders_.size(), 0);
+        stamp_ = 0;
+    }
+
+    // Colliders that may touch the circle, each once, in collider order
+    void gather(Fixed x, Fixed y, Fixed radius) {
+        candidates_.clear();
+        if (++stamp_ == 0) {
+            std::fill(stamp_of_.begin(), stamp_of_.end(), 0u);
+            stamp_ = 1;
+        }
+        const CellRange r = cells_of(x, y, radius, radius);
+        if (cell_count(r) <= MAX_CELLS_PER_COLLIDER) {
+            for (int32_t cy = r.y0; cy <= r.y1; ++cy) {
+                for (int32_t cx = r.x0; cx <= r.x1; ++cx) {
+                    const uint32_t b = bucket_of(cx, cy);
+                    for (uint32_t e = bucket_start_[b]; e < bucket_start_[b + 1]; ++e) {
+                        const uint32_t k = bucket_items_[e];
+                        if (stamp_of_[k] == stamp_) continue;
+                        stamp_of_[k] = stamp_;
+                        candidates_.push_back(k);
+                    }
+                }
+            }
+        } else {
+            // A huge query circle: every gridded collider
+            for (uint32_t k = 0; k < colliders_.size(); ++k) {
+                stamp_of_[k] = stamp_;
+                candidates_.push_back(k);
+            }
+        }
+        for (uint32_t k : large_) {
+            if (stamp_of_[k] == stamp_) continue;
+            stamp_of_[k] = stamp_;
+            candidates_.push_back(k);
+        }
+        // Pushes are applied in turn, so fix the order independent of the grid
+        std::sort(candidates_.begin(), candidates_.end());
+    }
+
+    // floor(sqrt(n)); the float estimate is corrected with integer steps, so the result is exact
+    static uint64_t isqrt_u64(uint64_t n) {
+        if (n < 2) return n;
+        uint64_t r = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+        while (r * r > n) --r;
+        while ((r + 1) * (r + 1) <= n) ++r;
+        return r;
+    }
+
+    // Contact normal (out of the collider) and depth; false when apart
+    static bool penetration(const StaticCollider& c, Fixed x, Fixed y, Fixed radius,
+                            Fixed& nx, Fixed& ny, Fixed& depth) {
+        const Fixed zero = Fixed::from_int(0);
+        Fixed px = c.x;  // Nearest point of the collider to the circle centre
+        Fixed py = c.y;
+        Fixed reach = radius;
+        if (c.shape == StaticShape::Circle) {
+            reach = radius + c.half_x;
+        } else {
+            const Fixed dx = x - c.x;
+            const Fixed dy = y - c.y;
+            const bool inside = dx.abs() < c.half_x && dy.abs() < c.half_y;
+            if (inside) {
+                // Out through the nearest face
+                const Fixed ox = c.half_x - dx.abs();
+                const Fixed oy = c.half_y - dy.abs();
+                if (ox <= oy) {
+                    nx = dx < zero ? Fixed::from_int(-1) : Fixed::from_int(1);
+                    ny = zero;
+                    depth = ox + radius;
+                } else {
+                    nx = zero;
+                    ny = dy < zero ? Fixed::from_int(-1) : Fixed::from_int(1);
+                    depth = oy + radius;
+                }
+                return true;
+            }
+            px = c.x + Fixed::max(-c.half_x, Fixed::min(c.half_x, dx));
+            py = c.y + Fixed::max(-c.half_y, Fixed::min(c.half_y, dy));
+        }
+        const int64_t dx = static_cast<int64_t>(x.raw) - px.raw;
+        const int64_t dy = static_cast<int64_t>(y.raw) - py.raw;
+        const int64_t dist_sq = dx * dx + dy * dy;
+        const int64_t reach_raw = reach.raw;
+        if (dist_sq >= reach_raw * reach_raw) return false;
+        const int64_t dist = static_cast<int64_t>(isqrt_u64(static_cast<uint64_t>(dist_sq)));
+        if (dist == 0) {
+            // Centred exactly: out along +y, the same way every time
+            nx = zero;
+            ny = Fixed::from_int(1);
+            depth = reach;
+            return true;
+        }
+        nx.raw = static_cast<int32_t>((dx << Fixed::SHIFT) / dist);
+        ny.raw = static_cast<int32_t>((dy << Fixed::SHIFT) / dist);
+        depth.raw = static_cast<int32_t>(reach_raw - dist);
+        return true;
+    }
+};
@@ -0,0 +1,218 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "../EntityRegistry.h"
+#include "../SnapshotStream.h"
+
+/**
+ * ConstraintRows - a constraint's bodies as dense BodyStore rows
+ *
+ * Resolved by PhysicsManager from the body ids and refreshed only when
+ * bodies change rows (create, destroy, sleep, wake, load), so solvers never
+ * look ids up per iteration. NONE marks a body that no longer exists.
+ */
+struct ConstraintRows {
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+    uint32_t a = NONE;
+    uint32_t b = NONE;
+};
+
+/**
+ * ConstraintSlots - constraint storage with stable slots and a free list
+ *
+ * A slot keeps its index for the constraint's lifetime, so per-body
+ * adjacency and solver rows can refer to it. remove() frees the slot
+ * (bodyA = INVALID_ENTITY) and pushes it on a LIFO free list that add()
+ * reuses first. Both are snapshotted, so reuse replays identically.
+ */
+template <typename Constraint>
+class ConstraintSlots {
+public:
+    static bool live(const Constraint& c) { return c.bodyA != INVALID_ENTITY; }
+
+    void clear() {
+        slots_.clear();
+        free_.clear();
+    }
+
+    uint32_t add(const Constraint& c) {
+        if (!free_.empty()) {
+            const uint32_t slot = free_.back();
+            free_.pop_back();
+            slots_[slot] = c;
+            return slot;
+        }
+        slots_.push_back(c);
+        return static_cast<uint32_t>(slots_.size() - 1);
+    }
+
+    void remove(uint32_t slot) {
+        if (slot >= slots_.size() || !live(slots_[slot])) return;
+        slots_[slot] = Constraint{};
+        slots_[slot].bodyA = INVALID_ENTITY;
+        slots_[slot].bodyB = INVALID_ENTITY;
+        free_.push_back(slot);
+    }
+
+    bool empty() const { return slots_.size() == free_.size(); }
+    size_t live_count() const { return slots_.size() - free_.size(); }
+    // Slot count, free slots included (iterate and skip !live)
+    size_t size() const { return slots_.size(); }
+    const Constraint& operator[](size_t slot) const { return slots_[slot]; }
+    const std::vector<Constraint>& slots() const { return slots_; }
+
+    void save_state(SnapshotWriter& w) const {
+        w.write_vector(slots_);
+        w.write_vector(free_);
+    }
+
+    bool load_state(SnapshotReader& r) {
+        return r.read_vector(slots_) && r.read_vector(free_);
+    }
+
+private:
+    std::vector<Constraint> slots_;
+    std::vector<uint32_t> free_;
+};
+
+/**
+ * ConstraintAdjacency - the constraints touching each body
+ *
+ * Lists are keyed by registry slot and hold caller-defined constraint
+ * references, so destroying a body only visits its own constraints.
+ * A reference can outlive a generation of its slot; callers check the
+ * constraint's ids before acting on it.
+ */
+class ConstraintAdjacency {
+public:
+    // Keeps each list's capacity, so rebuilding after a restore does not allocate
+    void clear() {
+        for (std::vector<uint32_t>& list : lists_) {
+            list.clear();
+        }
+    }
+
+    void add(EntityHandle body, uint32_t ref) {
+        if (body == INVALID_ENTITY) return;
+        const uint32_t slot = entity_slot(body);
+        if (slot >= lists_.size()) {
+            lists_.resize(slot + 1);
+        }
+        lists_[slot].push_back(ref);
+    }
+
+    void remove(EntityHandle body, uint32_t ref) {
+        const uint32_t slot = entity_slot(body);
+        if (body == INVALID_ENTITY || slot >= lists_.size()) return;
+        std::vector<uint32_t>& list = lists_[slot];
+        for (size_t i = 0; i < list.size(); ++i) {
+            if (list[i] == ref) {
+                list[i] = list.back();
+                list.pop_back();
+                return;
+            }
+        }
+    }
+
+    // Hands the body's list to the caller and leaves it empty
+    void take(EntityHandle body, std::vector<uint32_t>& out) {
+        out.clear();
+        const uint32_t slot = entity_slot(body);
+        if (body == INVALID_ENTITY || slot >= lists_.size()) return;
+        out.swap(lists_[slot]);
+    }
+
+private:
+    std::vector<std::vector<uint32_t>> lists_;
+};
+
+/**
+ * ConstraintColoring - greedy graph coloring of a constraint list
+ *
+ * Constraints of one color share no body, so a color can be solved in any
+ * order, in parallel, or in SIMD batches and give the same result.
+ * Solvers walk colors in order and constraints within a color by index,
+ * which keeps the whole pass deterministic. Arm chains color in two;
+ * after MAX_COLORS, leftovers share a last color that is solved
+ * sequentially like the others.
+ *
+ * Depends only on which ids each constraint links, so it is rebuilt when
+ * the constraint list changes, not when bodies move. Free slots
+ * (bodyA == INVALID_ENTITY) get no color and are never visited.
+ */
+class ConstraintColoring {
+public:
+    static constexpr uint32_t MAX_COLORS = 32;
+    static constexpr uint32_t NO_COLOR = 0xFFFFFFFFu;
+
+    template <typename Constraint>
+    void build(const std::vector<Constraint>& constraints) {
+        const size_t count = constraints.size();
+        colors_.resize(count);
+        used_.clear();
+        uint32_t color_count = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (constraints[i].bodyA == INVALID_ENTITY) {
+                colors_[i] = NO_COLOR;
+                continue;
+            }
+            const uint32_t used_a = used_mask(constraints[i].bodyA);
+            const uint32_t used = used_a | used_mask(constraints[i].bodyB);
+            uint32_t color = 0;
+            while (color < MAX_COLORS && (used & (1u << color))) {
+                ++color;
+            }
+            if (color < MAX_COLORS) {
+                used_mask(constraints[i].bodyA) |= 1u << color;
+                used_mask(constraints[i].bodyB) |= 1u << color;
+            }
+            colors_[i] = color;
+            if (color + 1 > color_count) {
+                color_count = color + 1;
+            }
+        }
+
+        // Counting sort by color; stable, so constraint order is kept within a color
+        color_start_.assign(color_count + 1, 0);
+        for (uint32_t c : colors_) {
+            if (c != NO_COLOR) {
+                color_start_[c + 1]++;
+            }
+        }
+        for (uint32_t c = 0; c < color_count; ++c) {
+            color_start_[c + 1] += color_start_[c];
+        }
+        order_.resize(color_start_[color_count]);
+        cursor_.assign(color_start_.begin(), color_start_.end() - 1);
+        for (size_t i = 0; i < count; ++i) {
+            if (colors_[i] != NO_COLOR) {
+                order_[cursor_[colors_[i]]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+
+    uint32_t color_count() const {
+        return color_start_.empty() ? 0 : static_cast<uint32_t>(color_start_.size() - 1);
+    }
+    // Positions [color_begin(k), color_end(k)) of order()
+    uint32_t color_begin(uint32_t k) const { return color_start_[k]; }
+    uint32_t color_end(uint32_t k) const { return color_start_[k + 1]; }
+    const uint32_t* order() const { return order_.data(); }
+    uint32_t color_of(size_t constraint) const { return colors_[constraint]; }
+
+private:
+    // Colors already used at a body, keyed by registry slot
+    uint32_t& used_mask(uint32_t body_id) {
+        const uint32_t slot = entity_slot(body_id);
+        if (slot >= used_.size()) {
+            used_.resize(slot + 1, 0);
+        }
+        return used_[slot];
+    }
+
+    std::vector<uint32_t> colors_;
+    std::vector<uint32_t> order_;
+    std::vector<uint32_t> color_start_;
+    std::vector<uint32_t> cursor_;
+    std::vector<uint32_t> used_;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "../PhysicsTypes.h"
-#include <unordered_map>
+#include "../BodyStore.h"
+#include "ConstraintGraph.h"
 
 /**
  * DistanceConstraint - simple PBD-style distance constraint between two bodies
@@ -19,87 +20,110 @@ struct DistanceConstraint {
 
 /**
  * ConstraintSolver - solves distance constraints in-place on PhysicsManager bodies
+ *
+ * Takes rows PhysicsManager resolved and walks the constraints by color (see
+ * ConstraintGraph.h). Rows at or past awake_count are asleep or static and
+ * have infinite mass; the manager wakes their island first when they need
+ * to move (needs_correction).
  */
 class ConstraintSolver {
 public:
     static void solve_distance_constraints(
-        std::vector<RigidBody>& bodies,
+        BodyStore& bodies,
         const std::vector<DistanceConstraint>& constraints,
+        const ConstraintRows* rows,
+        const ConstraintColoring& coloring,
+        size_t awake_count,
         int iterations
     ) {
         if (constraints.empty() || iterations <= 0) {
             return;
         }
-        
-        // Build ID map for O(1) lookups during constraint solving
-        std::unordered_map<uint32_t, size_t> id_to_index;
-        for (size_t i = 0; i < bodies.size(); ++i) {
-            id_to_index[bodies[i].id] = i;
-        }
-        
+
+        const uint32_t* order = coloring.order();
         for (int it = 0; it < iterations; ++it) {
-            for (const auto& c : constraints) {
-                auto itA = id_to_index.find(c.bodyA);
-                auto itB = id_to_index.find(c.bodyB);
-                if (itA == id_to_index.end() || itB == id_to_index.end()) {
-                    continue;
-                }
-                
-                RigidBody* a = &bodies[itA->second];
-                RigidBody* b = &bodies[itB->second];
-
-                FixedVector3 delta = b->position - a->position;
-                Fixed distSq = delta.length_squared();
-                
-                // Handle near-zero distance
-                if (distSq < Fixed::from_float(0.0001f)) {
-                    // Push apart in arbitrary direction
-                    a->position.x -= Fixed::from_float(0.005f);
-                    b->position.x += Fixed::from_float(0.005f);
-                    continue;
-                }
-                
-                Fixed dist = fixed_sqrt(distSq);
-                Fixed diff = dist - c.restLength;
-                
-                // Skip if already at rest length
-                if (diff.abs() < Fixed::from_float(0.0001f)) {
-                    continue;
+            for (uint32_t color = 0; color < coloring.color_count(); ++color) {
+                for (uint32_t k = coloring.color_begin(color); k < coloring.color_end(color); ++k) {
+                    const uint32_t ci = order[k];
+                    const ConstraintRows r = rows[ci];
+                    if (r.a == ConstraintRows::NONE || r.b == ConstraintRows::NONE) {
+                        continue;
+                    }
+                    if (r.a >= awake_count && r.b >= awake_count) {
+                        continue;  // Both asleep or static
+                    }
+                    solve_one(bodies, constraints[ci], r, awake_count);
                 }
+            }
+        }
+    }
 
-                FixedVector3 n = delta / dist;
-
-                // Kinematic bodies get zero inverse mass contribution
-                Fixed invMassA = (a->type == BodyType::Dynamic) ? a->inverse_mass : Fixed::from_int(0);
-                Fixed invMassB = (b->type == BodyType::Dynamic) ? b->inverse_mass : Fixed::from_int(0);
-                Fixed invMassSum = invMassA + invMassB;
-                
-                if (invMassSum <= Fixed::from_int(0)) {
-                    continue;
-                }
+    // Whether solving would move the bodies (used to wake a sleeping partner)
+    static bool needs_correction(const BodyStore& bodies, const DistanceConstraint& c, ConstraintRows r) {
+        FixedVector3 delta = bodies.positions()[r.b] - bodies.positions()[r.a];
+        Fixed distSq = delta.length_squared();
+        if (distSq < Fixed::from_float(0.0001f)) {
+            return true;
+        }
+        return (fixed_sqrt(distSq) - c.restLength).abs() >= Fixed::from_float(0.0001f);
+    }
 
-                // Positional correction along n scaled by stiffness
-                Fixed correctionMag = diff * c.stiffness;
-                Fixed ratioA = invMassA / invMassSum;
-                Fixed ratioB = invMassB / invMassSum;
+private:
+    static void solve_one(BodyStore& bodies, const DistanceConstraint& c, ConstraintRows r, size_t awake_count) {
+        BodyRef a = bodies[r.a];
+        BodyRef b = bodies[r.b];
+        const bool movableA = r.a < awake_count;
+        const bool movableB = r.b < awake_count;
 
-                // Move opposite directions to reduce error
-                a->position -= n * (correctionMag * ratioA);
-                b->position += n * (correctionMag * ratioB);
+        FixedVector3 delta = b.position - a.position;
+        Fixed distSq = delta.length_squared();
 
-                // Wake if moved
-                if (ratioA > Fixed::from_int(0)) {
-                    a->wake();
-                }
-                if (ratioB > Fixed::from_int(0)) {
-                    b->wake();
-                }
+        // Handle near-zero distance
+        if (distSq < Fixed::from_float(0.0001f)) {
+            // Push apart in arbitrary direction
+            if (movableA) {
+                a.position.x -= Fixed::from_float(0.005f);
+            }
+            if (movableB) {
+                b.position.x += Fixed::from_float(0.005f);
             }
+            return;
+        }
+
+        Fixed dist = fixed_sqrt(distSq);
+        Fixed diff = dist - c.restLength;
+
+        // Skip if already at rest length
+        if (diff.abs() < Fixed::from_float(0.0001f)) {
+            return;
         }
-    }
-};
 
+        FixedVector3 n = delta / dist;
 
+        // Kinematic and sleeping bodies get zero inverse mass contribution
+        Fixed invMassA = (movableA && a.type == BodyType::Dynamic) ? a.inverse_mass : Fixed::from_int(0);
+        Fixed invMassB = (movableB && b.type == BodyType::Dynamic) ? b.inverse_mass : Fixed::from_int(0);
+        Fixed invMassSum = invMassA + invMassB;
 
+        if (invMassSum <= Fixed::from_int(0)) {
+            return;
+        }
 
+        // Positional correction along n scaled by stiffness
+        Fixed correctionMag = diff * c.stiffness;
+        Fixed ratioA = invMassA / invMassSum;
+        Fixed ratioB = invMassB / invMassSum;
 
+        // Move opposite directions to reduce error
+        a.position -= n * (correctionMag * ratioA);
+        b.position += n * (correctionMag * ratioB);
+
+        // Wake if moved
+        if (ratioA > Fixed::from_int(0)) {
+            a.wake();
+        }
+        if (ratioB > Fixed::from_int(0)) {
+            b.wake();
+        }
+    }
+};
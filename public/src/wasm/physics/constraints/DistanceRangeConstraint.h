@@ -1,6 +1,7 @@
 #pragma once
 #include "../PhysicsTypes.h"
-#include <unordered_map>
+#include "../BodyStore.h"
+#include "ConstraintGraph.h"
 
 /**
  * DistanceRangeConstraint - maintains a distance between two bodies within [minLength, maxLength].
@@ -14,88 +15,101 @@ struct DistanceRangeConstraint {
     Fixed stiffness = Fixed::from_float(0.8f);
 };
 
+/**
+ * RangeConstraintSolver - same row/color walk as ConstraintSolver
+ */
 class RangeConstraintSolver {
 public:
     static void solve(
-        std::vector<RigidBody>& bodies,
+        BodyStore& bodies,
         const std::vector<DistanceRangeConstraint>& constraints,
+        const ConstraintRows* rows,
+        const ConstraintColoring& coloring,
+        size_t awake_count,
         int iterations
     ) {
         if (constraints.empty() || iterations <= 0) {
             return;
         }
-        
-        // Build ID map for O(1) lookups during constraint solving
-        std::unordered_map<uint32_t, size_t> id_to_index;
-        for (size_t i = 0; i < bodies.size(); ++i) {
-            id_to_index[bodies[i].id] = i;
-        }
-        
-        for (int it = 0; it < iterations; ++it) {
-            for (const auto& c : constraints) {
-                auto itA = id_to_index.find(c.bodyA);
-                auto itB = id_to_index.find(c.bodyB);
-                if (itA == id_to_index.end() || itB == id_to_index.end()) {
-                    continue;
-                }
-                
-                RigidBody* a = &bodies[itA->second];
-                RigidBody* b = &bodies[itB->second];
-
-                FixedVector3 delta = b->position - a->position;
-                Fixed distSq = delta.length_squared();
-                
-                // Handle near-zero distance
-                if (distSq < Fixed::from_float(0.0001f)) {
-                    continue;
-                }
-                
-                Fixed dist = fixed_sqrt(distSq);
 
-                bool apply = false;
-                Fixed target = dist;
-                if (c.maxLength > Fixed::from_int(0) && dist > c.maxLength) {
-                    target = c.maxLength;
-                    apply = true;
-                } else if (c.minLength > Fixed::from_int(0) && dist < c.minLength) {
-                    target = c.minLength;
-                    apply = true;
-                }
-                
-                if (!apply) {
-                    continue;
+        const uint32_t* order = coloring.order();
+        for (int it = 0; it < iterations; ++it) {
+            for (uint32_t color = 0; color < coloring.color_count(); ++color) {
+                for (uint32_t k = coloring.color_begin(color); k < coloring.color_end(color); ++k) {
+                    const uint32_t ci = order[k];
+                    const ConstraintRows r = rows[ci];
+                    if (r.a == ConstraintRows::NONE || r.b == ConstraintRows::NONE) {
+                        continue;
+                    }
+                    if (r.a >= awake_count && r.b >= awake_count) {
+                        continue;  // Both asleep or static
+                    }
+                    solve_one(bodies, constraints[ci], r, awake_count);
                 }
+            }
+        }
+    }
 
-                FixedVector3 n = delta / dist;
-
-                Fixed invMassA = (a->type == BodyType::Dynamic) ? a->inverse_mass : Fixed::from_int(0);
-                Fixed invMassB = (b->type == BodyType::Dynamic) ? b->inverse_mass : Fixed::from_int(0);
-                Fixed invMassSum = invMassA + invMassB;
-                
-                if (invMassSum <= Fixed::from_int(0)) {
-                    continue;
-                }
+    static bool needs_correction(const BodyStore& bodies, const DistanceRangeConstraint& c, ConstraintRows r) {
+        Fixed target;
+        return out_of_range(bodies, c, r, target);
+    }
 
-                Fixed diff = dist - target;
-                Fixed correctionMag = diff * c.stiffness;
-                Fixed ratioA = invMassA / invMassSum;
-                Fixed ratioB = invMassB / invMassSum;
+private:
+    static bool out_of_range(const BodyStore& bodies, const DistanceRangeConstraint& c, ConstraintRows r, Fixed& target) {
+        FixedVector3 delta = bodies.positions()[r.b] - bodies.positions()[r.a];
+        Fixed distSq = delta.length_squared();
 
-                a->position -= n * (correctionMag * ratioA);
-                b->position += n * (correctionMag * ratioB);
+        // Handle near-zero distance
+        if (distSq < Fixed::from_float(0.0001f)) {
+            return false;
+        }
 
-                if (ratioA > Fixed::from_int(0)) {
-                    a->wake();
-                }
-                if (ratioB > Fixed::from_int(0)) {
-                    b->wake();
-                }
-            }
+        Fixed dist = fixed_sqrt(distSq);
+        if (c.maxLength > Fixed::from_int(0) && dist > c.maxLength) {
+            target = c.maxLength;
+            return true;
+        }
+        if (c.minLength > Fixed::from_int(0) && dist < c.minLength) {
+            target = c.minLength;
+            return true;
         }
+        return false;
     }
-};
 
+    static void solve_one(BodyStore& bodies, const DistanceRangeConstraint& c, ConstraintRows r, size_t awake_count) {
+        Fixed target;
+        if (!out_of_range(bodies, c, r, target)) {
+            return;
+        }
 
+        BodyRef a = bodies[r.a];
+        BodyRef b = bodies[r.b];
+        FixedVector3 delta = b.position - a.position;
+        Fixed dist = fixed_sqrt(delta.length_squared());
+        FixedVector3 n = delta / dist;
 
+        Fixed invMassA = (r.a < awake_count && a.type == BodyType::Dynamic) ? a.inverse_mass : Fixed::from_int(0);
+        Fixed invMassB = (r.b < awake_count && b.type == BodyType::Dynamic) ? b.inverse_mass : Fixed::from_int(0);
+        Fixed invMassSum = invMassA + invMassB;
 
+        if (invMassSum <= Fixed::from_int(0)) {
+            return;
+        }
+
+        Fixed diff = dist - target;
+        Fixed correctionMag = diff * c.stiffness;
+        Fixed ratioA = invMassA / invMassSum;
+        Fixed ratioB = invMassB / invMassSum;
 
+        a.position -= n * (correctionMag * ratioA);
+        b.position += n * (correctionMag * ratioB);
+
+        if (ratioA > Fixed::from_int(0)) {
+            a.wake();
+        }
+        if (ratioB > Fixed::from_int(0)) {
+            b.wake();
+        }
+    }
+};
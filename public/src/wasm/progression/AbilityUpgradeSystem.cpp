@@ -1,13 +1,12 @@
 #include "AbilityUpgradeSystem.h"
+#include "../JsonReader.h"
 #include <string>
 #include <vector>
 #include <sstream>
 #include <cstring>
 
-// Minimal JSON parsing helpers (expect well-formed data produced by our own JSONs)
-// For production you might integrate a proper JSON lib, but keep binary size tight.
-
-static std::string slice(const char* s, int len) { return std::string(s, s + len); }
+// Tree and state JSON are read in one pass with JsonReader, straight from
+// the buffer JS passes in.
 
 AbilityUpgradeSystem::AbilityUpgradeSystem() {}
 
@@ -20,135 +19,93 @@ UpgradeTree* AbilityUpgradeSystem::ensureTree(int classIdInt) {
 	return ptr;
 }
 
-// NOTE: For brevity, JSON parsing here is skeletal; in the real project, prefer a small JSON lib.
-// We only need fields used by our data files.
-static void parseTreeJson(UpgradeTree& tree, const std::string& json) {
+static void parseNodeJson(JsonReader& r, UpgradeNodeDef& def, int numeric,
+                          std::vector<std::pair<int, JsonStr>>& pendingRequires) {
+	JsonStr key, str;
+	if (!r.begin_object()) return;
+	while (r.next_key(key)) {
+		if (key == "id") {
+			if (r.read_string(str)) str.assign_to(def.externalId);
+		} else if (key == "title") {
+			if (r.read_string(str)) str.assign_to(def.title);
+		} else if (key == "description") {
+			if (r.read_string(str)) str.assign_to(def.description);
+		} else if (key == "cost") {
+			r.read_int(def.cost);
+		} else if (key == "maxLevel") {
+			r.read_int(def.maxLevel);
+		} else if (key == "tier") {
+			r.read_int(def.tier);
+		} else if (key == "requires" && r.peek() == JsonReader::Array) {
+			// External ids may refer to later nodes; resolved once all are known
+			r.begin_array();
+			while (r.next_element()) {
+				if (r.peek() == JsonReader::String && r.read_string(str)) pendingRequires.emplace_back(numeric, str);
+				else r.skip();
+			}
+		} else if (key == "effect" && r.peek() == JsonReader::Object) {
+			r.begin_object();
+			while (r.next_key(key)) {
+				if (key == "type") {
+					if (r.read_string(str)) str.assign_to(def.effect.type);
+				} else if (key == "key") {
+					if (r.read_string(str)) {
+						str.assign_to(def.effect.key);
+						def.effect.keyId = UpgradeTree::internEffectKey(def.effect.key);
+					}
+				} else if (key == "perLevel") {
+					double v = 0.0;
+					if (r.read_number(v)) def.effect.perLevelFix = (int)(v * 65536.0); // 16.16
+				} else {
+					r.skip();
+				}
+			}
+		} else {
+			r.skip();
+		}
+	}
+}
+
+static void parseTreeJson(UpgradeTree& tree, const char* json, int len) {
 	// Reset
 	tree.nodes.clear();
 	tree.state.clear();
 	tree.externalToNumeric.clear();
 	tree.essence = 0;
 
-	// Extremely simplified extraction: search for nodes array and iterate entries.
-	// Each node: id,title,description,cost,maxLevel,requires(effect omitted types),effect{type,key,perLevel},tier
-	// We assume IDs are small; assign numeric in insertion order
-
-	size_t pos = json.find("\"nodes\"");
-	if (pos == std::string::npos) return;
-	pos = json.find('[', pos);
-	if (pos == std::string::npos) return;
-	size_t end = json.find(']', pos);
-	if (end == std::string::npos) return;
-	std::string arr = json.substr(pos + 1, end - pos - 1);
-
-	// Split by '},{' naïvely
-	size_t start = 0; int numeric = 0;
-	while (start < arr.size()) {
-		size_t next = arr.find("},{", start);
-		std::string entry = arr.substr(start, (next == std::string::npos ? arr.size() : next) - start);
-		// Extract fields
-		UpgradeNodeDef def{};
-		def.id = numeric;
-		// id
-		size_t idp = entry.find("\"id\"");
-		if (idp != std::string::npos) {
-			size_t q1 = entry.find('"', idp + 4);
-			size_t q2 = entry.find('"', q1 + 1);
-			def.externalId = entry.substr(q1 + 1, q2 - q1 - 1);
-		}
-		// title
-		size_t tp = entry.find("\"title\"");
-		if (tp != std::string::npos) {
-			size_t q1 = entry.find('"', tp + 7);
-			size_t q2 = entry.find('"', q1 + 1);
-			def.title = entry.substr(q1 + 1, q2 - q1 - 1);
-		}
-		// description
-		size_t dp = entry.find("\"description\"");
-		if (dp != std::string::npos) {
-			size_t q1 = entry.find('"', dp + 13);
-			size_t q2 = entry.find('"', q1 + 1);
-			def.description = entry.substr(q1 + 1, q2 - q1 - 1);
-		}
-		// cost
-		size_t cp = entry.find("\"cost\"");
-		if (cp != std::string::npos) {
-			size_t colon = entry.find(':', cp);
-			size_t comma = entry.find(',', colon);
-			def.cost = std::stoi(entry.substr(colon + 1, comma - colon - 1));
-		}
-		// maxLevel
-		size_t mp = entry.find("\"maxLevel\"");
-		if (mp != std::string::npos) {
-			size_t colon = entry.find(':', mp);
-			size_t comma = entry.find(',', colon);
-			def.maxLevel = std::stoi(entry.substr(colon + 1, comma - colon - 1));
-		}
-		// tier
-		size_t trp = entry.find("\"tier\"");
-		if (trp != std::string::npos) {
-			size_t colon = entry.find(':', trp);
-			size_t comma = entry.find(',', colon);
-			def.tier = std::stoi(entry.substr(colon + 1, (comma==std::string::npos? entry.size(): comma) - colon - 1));
-		}
-		// effect.key
-		size_t ek = entry.find("\"key\"");
-		if (ek != std::string::npos) {
-			size_t q1 = entry.find('"', ek + 5);
-			size_t q2 = entry.find('"', q1 + 1);
-			def.effect.key = entry.substr(q1 + 1, q2 - q1 - 1);
-		}
-		// effect.perLevel (float or int)
-		size_t ep = entry.find("\"perLevel\"");
-		if (ep != std::string::npos) {
-			size_t colon = entry.find(':', ep);
-			size_t comma = entry.find(',', colon);
-			std::string val = entry.substr(colon + 1, (comma==std::string::npos? entry.size(): comma) - colon - 1);
-			if (val.find('.') != std::string::npos) {
-				def.effect.perLevelFix = (int)(std::stod(val) * 65536.0);
+	// Numeric ids are assigned in insertion order
+	std::vector<std::pair<int, JsonStr>> pendingRequires;
+	std::string ext;
+	JsonReader r(json, len);
+	JsonStr key, str;
+	if (r.begin_object()) {
+		while (r.next_key(key)) {
+			if (key == "classId") {
+				if (r.read_string(str)) str.assign_to(tree.classId);
+			} else if (key == "version") {
+				r.read_int(tree.version);
+			} else if (key == "nodes" && r.peek() == JsonReader::Array) {
+				r.begin_array();
+				while (r.next_element()) {
+					UpgradeNodeDef def{};
+					def.id = (int)tree.nodes.size();
+					parseNodeJson(r, def, def.id, pendingRequires);
+					tree.externalToNumeric[def.externalId] = def.id;
+					tree.nodes.push_back(std::move(def));
+					tree.state.push_back(UpgradeNodeState{});
+				}
 			} else {
-				def.effect.perLevelFix = std::stoi(val) * 65536; // integer -> 16.16
+				r.skip();
 			}
 		}
-		// requires array: very minimal (expect identifiers that map later by external id; we cannot resolve here without map)
-		// We defer resolving requires until after all nodes are known; temporarily store in description tail (skipped for simplicity)
-
-		tree.externalToNumeric[def.externalId] = def.id;
-		tree.nodes.push_back(def);
-		tree.state.push_back(UpgradeNodeState{});
-		numeric++;
-		if (next == std::string::npos) break;
-		start = next + 2; // skip '},'
 	}
 
-	// Second pass for requires: we perform a rough parse of requires arrays
-	start = 0; numeric = 0;
-	while (start < arr.size()) {
-		size_t next = arr.find("},{", start);
-		std::string entry = arr.substr(start, (next == std::string::npos ? arr.size() : next) - start);
-		size_t rp = entry.find("\"requires\"");
-		if (rp != std::string::npos) {
-			size_t lb = entry.find('[', rp);
-			size_t rb = entry.find(']', lb);
-			if (lb != std::string::npos && rb != std::string::npos) {
-				std::string list = entry.substr(lb + 1, rb - lb - 1);
-				size_t sp = 0;
-				while (sp < list.size()) {
-					size_t q1 = list.find('"', sp);
-					if (q1 == std::string::npos) break;
-					size_t q2 = list.find('"', q1 + 1);
-					if (q2 == std::string::npos) break;
-					std::string ext = list.substr(q1 + 1, q2 - q1 - 1);
-					auto it = tree.externalToNumeric.find(ext);
-					if (it != tree.externalToNumeric.end()) tree.nodes[numeric].requires.push_back(it->second);
-					sp = q2 + 1;
-				}
-			}
-		}
-		numeric++;
-		if (next == std::string::npos) break;
-		start = next + 2;
+	for (const auto& req : pendingRequires) {
+		req.second.assign_to(ext);
+		auto it = tree.externalToNumeric.find(ext);
+		if (it != tree.externalToNumeric.end()) tree.nodes[req.first].requires.push_back(it->second);
 	}
+	tree.rebuildEffectTotals();
 }
 
 static std::string stateToJson(const UpgradeTree& tree) {
@@ -164,58 +121,42 @@ static std::string stateToJson(const UpgradeTree& tree) {
 	return os.str();
 }
 
-static void applyStateJson(UpgradeTree& tree, const std::string& json) {
+static void applyStateJson(UpgradeTree& tree, const char* json, int len) {
 	// Pull essence and node levels
-	size_t ep = json.find("\"essence\"");
-	if (ep != std::string::npos) {
-		size_t colon = json.find(':', ep);
-		size_t comma = json.find(',', colon);
-		tree.essence = std::stoi(json.substr(colon + 1, (comma==std::string::npos? json.size(): comma) - colon - 1));
-	}
-	// nodes object
-	size_t np = json.find("\"nodes\"");
-	if (np != std::string::npos) {
-		size_t lb = json.find('{', np);
-		size_t rb = json.find('}', lb);
-		if (lb != std::string::npos && rb != std::string::npos) {
-			std::string body = json.substr(lb + 1, rb - lb - 1);
-			size_t sp = 0;
-			while (sp < body.size()) {
-				size_t q1 = body.find('"', sp);
-				if (q1 == std::string::npos) break;
-				size_t q2 = body.find('"', q1 + 1);
-				if (q2 == std::string::npos) break;
-				std::string ext = body.substr(q1 + 1, q2 - q1 - 1);
-				size_t colon = body.find(':', q2);
-				size_t comma = body.find(',', colon);
-				int level = std::stoi(body.substr(colon + 1, (comma==std::string::npos? body.size(): comma) - colon - 1));
+	std::string ext;
+	JsonReader r(json, len);
+	JsonStr key;
+	if (!r.begin_object()) return;
+	while (r.next_key(key)) {
+		if (key == "essence") {
+			r.read_int(tree.essence);
+		} else if (key == "nodes" && r.peek() == JsonReader::Object) {
+			r.begin_object();
+			while (r.next_key(key)) {
+				int level = 0;
+				if (!r.read_int(level)) break;
+				key.assign_to(ext);
 				auto it = tree.externalToNumeric.find(ext);
 				if (it != tree.externalToNumeric.end()) {
 					int idx = it->second;
 					if (idx >= 0 && idx < (int)tree.state.size()) tree.state[idx].level = level;
 				}
-				if (comma == std::string::npos) break;
-				sp = comma + 1;
 			}
+		} else {
+			r.skip();
 		}
 	}
 }
 
-void AbilityUpgradeSystem::setTreeJson(int classIdInt, const std::string& json) {
+void AbilityUpgradeSystem::setTreeJson(int classIdInt, const char* json, int len) {
 	UpgradeTree* t = ensureTree(classIdInt);
-	parseTreeJson(*t, json);
-	// extract classId string
-	size_t cp = json.find("\"classId\"");
-	if (cp != std::string::npos) {
-		size_t q1 = json.find('"', cp + 8);
-		size_t q2 = json.find('"', q1 + 1);
-		if (q1 != std::string::npos && q2 != std::string::npos) t->classId = json.substr(q1 + 1, q2 - q1 - 1);
-	}
+	parseTreeJson(*t, json, len);
 }
 
-void AbilityUpgradeSystem::setStateJson(int classIdInt, const std::string& json) {
+void AbilityUpgradeSystem::setStateJson(int classIdInt, const char* json, int len) {
 	UpgradeTree* t = ensureTree(classIdInt);
-	applyStateJson(*t, json);
+	applyStateJson(*t, json, len);
+	t->rebuildEffectTotals();
 }
 
 std::string AbilityUpgradeSystem::getStateJson(int classIdInt) const {
@@ -257,6 +198,7 @@ void AbilityUpgradeSystem::resetClass(int classIdInt) {
 	UpgradeTree* t = ensureTree(classIdInt);
 	for (auto& s : t->state) s.level = 0;
 	t->essence = 0;
+	t->rebuildEffectTotals();
 }
 
 int AbilityUpgradeSystem::getEffectScalarFix(int classIdInt, const std::string& key) const {
@@ -265,6 +207,12 @@ int AbilityUpgradeSystem::getEffectScalarFix(int classIdInt, const std::string&
 	return it->second->getScalarFix(key);
 }
 
+int AbilityUpgradeSystem::getEffectScalarFixById(int classIdInt, int keyId) const {
+	auto it = trees.find(classIdInt);
+	if (it == trees.end()) return 0;
+	return it->second->getScalarFixById(keyId);
+}
+
 // ---- C API glue ----
 static AbilityUpgradeSystem g_sys;
 static std::string g_lastJson;
@@ -274,11 +222,11 @@ extern "C" {
 	int upgrade_create_system() { return 1; }
 	__attribute__((used)) __attribute__((export_name("upgrade_set_tree")))
 	void upgrade_set_tree(int classId, const char* jsonPtr, int len) {
-		g_sys.setTreeJson(classId, std::string(jsonPtr, jsonPtr + len));
+		g_sys.setTreeJson(classId, jsonPtr, len);
 	}
 	__attribute__((used)) __attribute__((export_name("upgrade_set_state")))
 	void upgrade_set_state(int classId, const char* jsonPtr, int len) {
-		g_sys.setStateJson(classId, std::string(jsonPtr, jsonPtr + len));
+		g_sys.setStateJson(classId, jsonPtr, len);
 	}
 	__attribute__((used)) __attribute__((export_name("upgrade_get_state")))
 	const char* upgrade_get_state(int classId) {
@@ -299,6 +247,16 @@ extern "C" {
 	int upgrade_get_effect_scalar(int classId, const char* key, int len) {
 		return g_sys.getEffectScalarFix(classId, std::string(key, key + len));
 	}
+	// Resolve a key once, then read it with upgrade_get_effect_scalar_id.
+	// Always returns an id (keys not in any tree read as 0), valid for the session.
+	__attribute__((used)) __attribute__((export_name("upgrade_get_effect_key_id")))
+	int upgrade_get_effect_key_id(const char* key, int len) {
+		return UpgradeTree::internEffectKey(std::string(key, key + len));
+	}
+	__attribute__((used)) __attribute__((export_name("upgrade_get_effect_scalar_id")))
+	int upgrade_get_effect_scalar_id(int classId, int keyId) {
+		return g_sys.getEffectScalarFixById(classId, keyId);
+	}
 }
 
 
@@ -15,8 +15,8 @@ public:
 
 	UpgradeTree* ensureTree(int classIdInt);
 
-	void setTreeJson(int classIdInt, const std::string& json);
-	void setStateJson(int classIdInt, const std::string& json);
+	void setTreeJson(int classIdInt, const char* json, int len);
+	void setStateJson(int classIdInt, const char* json, int len);
 	std::string getStateJson(int classIdInt) const;
 	int getEssence(int classIdInt) const;
 	int canPurchase(int classIdInt, int nodeId) const;
@@ -24,6 +24,7 @@ public:
 	int purchase(int classIdInt, int nodeId);
 	void resetClass(int classIdInt);
 	int getEffectScalarFix(int classIdInt, const std::string& key) const;
+	int getEffectScalarFixById(int classIdInt, int keyId) const;
 };
 
 // Exported C API (decl only; definitions placed in cpp for Emscripten)
@@ -38,6 +39,8 @@ extern "C" {
 	int upgrade_purchase(int classId, int nodeId);
 	void upgrade_reset_class(int classId);
 	int upgrade_get_effect_scalar(int classId, const char* key, int len);
+	int upgrade_get_effect_key_id(const char* key, int len);
+	int upgrade_get_effect_scalar_id(int classId, int keyId);
 }
 
 
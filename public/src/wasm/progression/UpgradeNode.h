@@ -7,6 +7,7 @@ struct UpgradeEffect {
 	std::string type; // ability|economy|defense|...
 	std::string key;  // e.g., "warden.bash.damage"
 	int perLevelFix;  // 16.16 fixed-point value if fractional, or integer scaled
+	int keyId{-1};    // interned key (see UpgradeTree::internEffectKey)
 };
 
 struct UpgradeNodeDef {
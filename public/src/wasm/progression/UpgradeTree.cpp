@@ -22,23 +22,47 @@ bool UpgradeTree::purchase(int nodeNumericId) {
 	UpgradeNodeState& st = state[nodeNumericId];
 	essence -= def.cost;
 	st.level += 1;
+	rebuildEffectTotals();
 	return true;
 }
 
-int UpgradeTree::getScalarFix(const std::string& key) const {
-	long long accum = 0; // accumulate in 16.16
+static std::unordered_map<std::string, int>& effectKeyIds() {
+	static std::unordered_map<std::string, int> ids;
+	return ids;
+}
+
+int UpgradeTree::internEffectKey(const std::string& key) {
+	auto& ids = effectKeyIds();
+	auto it = ids.find(key);
+	if (it != ids.end()) return it->second;
+	int id = (int)ids.size();
+	ids.emplace(key, id);
+	return id;
+}
+
+int UpgradeTree::findEffectKey(const std::string& key) {
+	const auto& ids = effectKeyIds();
+	auto it = ids.find(key);
+	return it == ids.end() ? -1 : it->second;
+}
+
+void UpgradeTree::rebuildEffectTotals() {
+	std::vector<long long> accum(effectKeyIds().size(), 0); // accumulate in 16.16
 	for (size_t i = 0; i < nodes.size(); ++i) {
 		const UpgradeNodeDef& def = nodes[i];
 		const UpgradeNodeState& st = state[i];
-		if (st.level <= 0) continue;
-		if (def.effect.key == key) {
-			long long contrib = (long long)def.effect.perLevelFix * (long long)st.level;
-			accum += contrib;
-		}
+		if (st.level <= 0 || def.effect.keyId < 0) continue;
+		accum[def.effect.keyId] += (long long)def.effect.perLevelFix * (long long)st.level;
+	}
+	effectTotalsFix.assign(accum.size(), 0);
+	for (size_t k = 0; k < accum.size(); ++k) {
+		long long v = accum[k];
+		if (v > 2147483647LL) v = 2147483647LL;
+		if (v < -2147483648LL) v = -2147483648LL;
+		effectTotalsFix[k] = (int)v;
 	}
-	if (accum > 2147483647LL) accum = 2147483647LL;
-	if (accum < -2147483648LL) accum = -2147483648LL;
-	return (int)accum;
 }
 
-
+int UpgradeTree::getScalarFix(const std::string& key) const {
+	return getScalarFixById(findEffectKey(key));
+}
@@ -20,9 +20,22 @@ public:
 		return it == externalToNumeric.end() ? -1 : it->second;
 	}
 
+	// Per-key effect sums (16.16), indexed by interned key id. Rebuilt on
+	// tree load, purchase, reset and state load so reads are array loads.
+	std::vector<int> effectTotalsFix;
+
 	bool canPurchase(int nodeNumericId, int* outErrorCode = nullptr) const;
 	bool purchase(int nodeNumericId);
+	void rebuildEffectTotals();
 	int getScalarFix(const std::string& key) const; // sum effects for key in 16.16 fixed
+	int getScalarFixById(int keyId) const {
+		return keyId >= 0 && keyId < (int)effectTotalsFix.size() ? effectTotalsFix[keyId] : 0;
+	}
+
+	// Effect keys are interned process-wide, so an id stays valid across
+	// tree reloads and means the same key for every class
+	static int internEffectKey(const std::string& key);
+	static int findEffectKey(const std::string& key); // -1 if never interned
 };
 
 
@@ -4,8 +4,8 @@
 #include <string>
 #include <cmath>
 #include <algorithm>
-#include <memory>
 #include <cstdint>
+#include "../physics/FixedTrig.h"
 
 using namespace emscripten;
 
@@ -33,12 +33,13 @@ struct FixedPoint {
     
     FixedPoint operator+(const FixedPoint& other) const { return FixedPoint(value + other.value); }
     FixedPoint operator-(const FixedPoint& other) const { return FixedPoint(value - other.value); }
+    FixedPoint operator-() const { return FixedPoint(-value); }
     FixedPoint operator*(const FixedPoint& other) const { 
-        return FixedPoint((static_cast<int64_t>(value) * other.value) >> FIXED_POINT_SCALE);
+        return FixedPoint(static_cast<int32_t>((static_cast<int64_t>(value) * other.value) >> FIXED_POINT_SCALE));
     }
     FixedPoint operator/(const FixedPoint& other) const {
         if (other.value == 0) return FixedPoint(0);
-        return FixedPoint((static_cast<int64_t>(value) << FIXED_POINT_SCALE) / other.value);
+        return FixedPoint(static_cast<int32_t>((static_cast<int64_t>(value) << FIXED_POINT_SCALE) / other.value));
     }
     
     bool operator>(const FixedPoint& other) const { return value > other.value; }
@@ -120,25 +121,6 @@ struct FootContact {
     }
 };
 
-// ============================================================================
-// COLLISION DETECTION
-// ============================================================================
-
-struct CollisionInfo {
-    bool has_collision;
-    FixedPoint penetration_depth;
-    Vector3 contact_point;
-    Vector3 contact_normal;
-    FixedPoint restitution;
-    FixedPoint friction;
-    
-    CollisionInfo() 
-        : has_collision(false), penetration_depth(0)
-        , contact_point(0, 0, 0), contact_normal(0, 1, 0)
-        , restitution(FixedPoint(0.3f)), friction(FixedPoint(0.7f))
-    {}
-};
-
 // ============================================================================
 // VECTOR3 - 3D Vector Math
 // ============================================================================
@@ -225,23 +207,23 @@ struct Quaternion {
     
     static Quaternion fromAxisAngle(const Vector3& axis, float angle) {
         float halfAngle = angle * 0.5f;
-        float s = std::sin(halfAngle);
+        float s = trig_sin(halfAngle);
         Vector3 normAxis = axis.normalized();
         return Quaternion(
             normAxis.x * s,
             normAxis.y * s,
             normAxis.z * s,
-            std::cos(halfAngle)
+            trig_cos(halfAngle)
         );
     }
     
     static Quaternion fromEuler(float pitch, float yaw, float roll) {
-        float cy = std::cos(yaw * 0.5f);
-        float sy = std::sin(yaw * 0.5f);
-        float cp = std::cos(pitch * 0.5f);
-        float sp = std::sin(pitch * 0.5f);
-        float cr = std::cos(roll * 0.5f);
-        float sr = std::sin(roll * 0.5f);
+        float cy = trig_cos(yaw * 0.5f);
+        float sy = trig_sin(yaw * 0.5f);
+        float cp = trig_cos(pitch * 0.5f);
+        float sp = trig_sin(pitch * 0.5f);
+        float cr = trig_cos(roll * 0.5f);
+        float sr = trig_sin(roll * 0.5f);
         
         return Quaternion(
             sr * cp * cy - cr * sp * sy,
@@ -283,6 +265,25 @@ struct Quaternion {
     }
 };
 
+// ============================================================================
+// COLLISION DETECTION
+// ============================================================================
+
+struct CollisionInfo {
+    bool has_collision;
+    FixedPoint penetration_depth;
+    Vector3 contact_point;
+    Vector3 contact_normal;
+    FixedPoint restitution;
+    FixedPoint friction;
+    
+    CollisionInfo() 
+        : has_collision(false), penetration_depth(0)
+        , contact_point(0, 0, 0), contact_normal(0, 1, 0)
+        , restitution(FixedPoint(0.3f)), friction(FixedPoint(0.7f))
+    {}
+};
+
 // ============================================================================
 // UTILITY FUNCTIONS
 // ============================================================================
@@ -308,7 +309,7 @@ inline Vector3 quaternionToEuler(const Quaternion& q) {
     // Roll (x-axis rotation)
     float sinr_cosp = 2 * (w * x + y * z);
     float cosr_cosp = 1 - 2 * (x * x + y * y);
-    float roll = std::atan2(sinr_cosp, cosr_cosp);
+    float roll = trig_atan2(sinr_cosp, cosr_cosp);
     
     // Pitch (y-axis rotation)
     float sinp = 2 * (w * y - z * x);
@@ -322,7 +323,7 @@ inline Vector3 quaternionToEuler(const Quaternion& q) {
     // Yaw (z-axis rotation)
     float siny_cosp = 2 * (w * z + x * y);
     float cosy_cosp = 1 - 2 * (y * y + z * z);
-    float yaw = std::atan2(siny_cosp, cosy_cosp);
+    float yaw = trig_atan2(siny_cosp, cosy_cosp);
     
     return Vector3(roll, pitch, yaw);
 }
@@ -335,7 +336,6 @@ class Bone {
 public:
     std::string name;
     int parentIndex;
-    std::vector<int> childIndices;
     
     // Rest pose (local to parent)
     Vector3 restPosition;
@@ -357,6 +357,7 @@ public:
     
     // Enhanced features
     bool isFootBone;           // True for foot/ankle bones
+    bool isHipBone;            // True for pelvis/spine bones (hip balance strategy)
     FootContact footContact;   // Foot contact information
     CollisionInfo collisionInfo; // Collision detection data
     FixedPoint fixedPositionX, fixedPositionY, fixedPositionZ; // Fixed-point position for determinism
@@ -367,7 +368,7 @@ public:
           length(length), radius(radius), mass(mass),
           position(0, 0, 0), rotation(), velocity(0, 0, 0),
           angularVelocity(0, 0, 0), localRotation(),
-          isFootBone(false), fixedPositionX(0), fixedPositionY(0), fixedPositionZ(0)
+          isFootBone(false), isHipBone(false), fixedPositionX(0), fixedPositionY(0), fixedPositionZ(0)
     {
         computeInertia();
         updateFixedPointPosition();
@@ -537,10 +538,16 @@ public:
 // SKELETON
 // ============================================================================
 
+// Bones and joints are stored by value. Parents are always added before
+// their children, so ascending index order is a topological order and world
+// transforms propagate in one linear pass over updateOrder (the bones
+// reachable from the root). update() does no heap allocation.
 class Skeleton {
 private:
-    std::vector<std::shared_ptr<Bone>> bones;
-    std::vector<std::shared_ptr<Joint>> joints;
+    std::vector<Bone> bones;
+    std::vector<Joint> joints;
+    std::vector<int> updateOrder;
+    bool updateOrderDirty;
     int rootBoneIndex;
     
     Vector3 gravity;
@@ -558,7 +565,7 @@ private:
     
 public:
     Skeleton() 
-        : rootBoneIndex(-1), gravity(0, -9.81f, 0),
+        : updateOrderDirty(false), rootBoneIndex(-1), gravity(0, -9.81f, 0),
           physicsEnabled(true), gravityEnabled(true),
           globalStiffness(1.0f), globalDamping(1.0f),
           groundY(0.0f), collisionDetectionEnabled(true),
@@ -568,25 +575,25 @@ public:
     int addBone(const std::string& name, int parentIndex, 
                 float px, float py, float pz,
                 float length, float radius, float mass) {
-        auto bone = std::make_shared<Bone>(
-            name, parentIndex, Vector3(px, py, pz), length, radius, mass
-        );
+        int index = bones.size();
+        bones.emplace_back(name, parentIndex, Vector3(px, py, pz), length, radius, mass);
+        Bone& bone = bones.back();
         
-        // Mark foot bones for contact detection
+        // Classify once here rather than matching names every frame
         if (name.find("foot") != std::string::npos || 
             name.find("ankle") != std::string::npos ||
             name.find("toe") != std::string::npos) {
-            bone->isFootBone = true;
+            bone.isFootBone = true;
+        }
+        if (name.find("pelvis") != std::string::npos ||
+            name.find("spine") != std::string::npos) {
+            bone.isHipBone = true;
         }
-        
-        int index = bones.size();
-        bones.push_back(bone);
         
         if (parentIndex == -1) {
             rootBoneIndex = index;
-        } else if (parentIndex >= 0 && parentIndex < bones.size()) {
-            bones[parentIndex]->childIndices.push_back(index);
         }
+        updateOrderDirty = true;
         
         return index;
     }
@@ -600,36 +607,48 @@ public:
         JointLimits limits(Vector3(minX, minY, minZ), Vector3(maxX, maxY, maxZ));
         JointDrive drive(stiffness, damping);
         
-        auto joint = std::make_shared<Joint>(name, parentIdx, childIdx, type, limits, drive);
-        joints.push_back(joint);
+        joints.emplace_back(name, parentIdx, childIdx, type, limits, drive);
         
         return joints.size() - 1;
     }
     
-    void updateWorldTransform(int boneIndex) {
-        if (boneIndex < 0 || boneIndex >= bones.size()) return;
-        
-        auto& bone = bones[boneIndex];
-        
-        if (bone->parentIndex >= 0) {
-            auto& parent = bones[bone->parentIndex];
+    // Bones reachable from the root, parents first (a bone whose parent was
+    // added after it is never linked, as before)
+    void rebuildUpdateOrder() {
+        updateOrder.clear();
+        std::vector<char> reachable(bones.size(), 0);
+        for (int i = 0; i < static_cast<int>(bones.size()); i++) {
+            const int parent = bones[i].parentIndex;
+            if (i == rootBoneIndex || (parent >= 0 && parent < i && reachable[parent])) {
+                reachable[i] = 1;
+                updateOrder.push_back(i);
+            }
+        }
+        updateOrderDirty = false;
+    }
+    
+    void updateWorldTransforms() {
+        if (updateOrderDirty) {
+            rebuildUpdateOrder();
+        }
+        for (int index : updateOrder) {
+            Bone& bone = bones[index];
             
-            // Transform position
-            bone->position = parent->rotation.rotate(bone->restPosition);
-            bone->position += parent->position;
+            if (index != rootBoneIndex) {
+                const Bone& parent = bones[bone.parentIndex];
+                
+                // Transform position
+                bone.position = parent.rotation.rotate(bone.restPosition);
+                bone.position += parent.position;
+                
+                // Transform rotation
+                bone.rotation = parent.rotation * bone.localRotation;
+            } else {
+                bone.position = bone.restPosition;
+                bone.rotation = bone.localRotation;
+            }
             
-            // Transform rotation
-            bone->rotation = parent->rotation * bone->localRotation;
-        } else {
-            bone->position = bone->restPosition;
-            bone->rotation = bone->localRotation;
-        }
-        
-        bone->rotation.normalize();
-        
-        // Update children
-        for (int childIdx : bone->childIndices) {
-            updateWorldTransform(childIdx);
+            bone.rotation.normalize();
         }
     }
     
@@ -638,54 +657,54 @@ public:
         
         // Apply physics to each bone (except root)
         for (size_t i = 0; i < bones.size(); i++) {
-            if (i == rootBoneIndex) continue;
+            if (static_cast<int>(i) == rootBoneIndex) continue;
             
-            auto& bone = bones[i];
+            Bone& bone = bones[i];
             
             // Apply gravity (with safety check for zero mass)
-            if (gravityEnabled && bone->mass > 0.0001f) {
-                Vector3 force = gravity * bone->mass;
-                Vector3 accel = force / bone->mass;
-                bone->velocity += accel * dt;
+            if (gravityEnabled && bone.mass > 0.0001f) {
+                Vector3 force = gravity * bone.mass;
+                Vector3 accel = force / bone.mass;
+                bone.velocity += accel * dt;
             }
             
             // Apply damping
-            bone->velocity *= 0.98f;
-            bone->angularVelocity *= 0.95f;
+            bone.velocity *= 0.98f;
+            bone.angularVelocity *= 0.95f;
         }
         
         // Apply joint constraints
-        for (auto& joint : joints) {
-            if (joint->childBoneIndex < 0 || joint->childBoneIndex >= bones.size()) {
+        for (Joint& joint : joints) {
+            if (joint.childBoneIndex < 0 || joint.childBoneIndex >= static_cast<int>(bones.size())) {
                 continue;
             }
             
-            auto& bone = bones[joint->childBoneIndex];
-            Vector3 torque = joint->computeTorque(*bone, globalStiffness, globalDamping);
+            Bone& bone = bones[joint.childBoneIndex];
+            Vector3 torque = joint.computeTorque(bone, globalStiffness, globalDamping);
             
             // Apply torque (with safety check for zero inertia)
             Vector3 angAccel(
-                bone->inertia.x > 0.0001f ? torque.x / bone->inertia.x : 0.0f,
-                bone->inertia.y > 0.0001f ? torque.y / bone->inertia.y : 0.0f,
-                bone->inertia.z > 0.0001f ? torque.z / bone->inertia.z : 0.0f
+                bone.inertia.x > 0.0001f ? torque.x / bone.inertia.x : 0.0f,
+                bone.inertia.y > 0.0001f ? torque.y / bone.inertia.y : 0.0f,
+                bone.inertia.z > 0.0001f ? torque.z / bone.inertia.z : 0.0f
             );
             
-            bone->angularVelocity += angAccel * dt;
+            bone.angularVelocity += angAccel * dt;
             
             // Integrate angular velocity
-            Vector3 deltaAngles = bone->angularVelocity * dt;
+            Vector3 deltaAngles = bone.angularVelocity * dt;
             
             Quaternion deltaRot = Quaternion::fromEuler(
                 deltaAngles.x, deltaAngles.y, deltaAngles.z
             );
             
-            bone->localRotation = bone->localRotation * deltaRot;
-            bone->localRotation.normalize();
+            bone.localRotation = bone.localRotation * deltaRot;
+            bone.localRotation.normalize();
         }
         
         // Update all transforms
         if (rootBoneIndex >= 0) {
-            updateWorldTransform(rootBoneIndex);
+            updateWorldTransforms();
         }
         
         // Enhanced features
@@ -708,9 +727,9 @@ public:
         float totalMass = 0.0f;
         Vector3 com(0, 0, 0);
         
-        for (const auto& bone : bones) {
-            com += bone->position * bone->mass;
-            totalMass += bone->mass;
+        for (const Bone& bone : bones) {
+            com += bone.position * bone.mass;
+            totalMass += bone.mass;
         }
         
         if (totalMass > 0.0001f) {
@@ -724,12 +743,16 @@ public:
     int getBoneCount() const { return bones.size(); }
     int getJointCount() const { return joints.size(); }
     
+    // Native bone access (IK); index must be valid
+    const Vector3& boneWorldPosition(int index) const { return bones[index].position; }
+    const Quaternion& boneWorldRotation(int index) const { return bones[index].rotation; }
+    
     // Bone access
     val getBonePosition(int index) const {
         if (index < 0 || index >= bones.size()) {
             return val::object();
         }
-        auto& pos = bones[index]->position;
+        auto& pos = bones[index].position;
         
         val obj = val::object();
         obj.set("x", pos.x);
@@ -742,7 +765,7 @@ public:
         if (index < 0 || index >= bones.size()) {
             return val::object();
         }
-        auto& rot = bones[index]->rotation;
+        auto& rot = bones[index].rotation;
         
         val obj = val::object();
         obj.set("x", rot.x);
@@ -754,38 +777,38 @@ public:
     
     std::string getBoneName(int index) const {
         if (index < 0 || index >= bones.size()) return "";
-        return bones[index]->name;
+        return bones[index].name;
     }
     
     float getBoneLength(int index) const {
         if (index < 0 || index >= bones.size()) return 0.0f;
-        return bones[index]->length;
+        return bones[index].length;
     }
     
     float getBoneRadius(int index) const {
         if (index < 0 || index >= bones.size()) return 0.0f;
-        return bones[index]->radius;
+        return bones[index].radius;
     }
     
     // Joint access
     void setJointTargetAngles(int index, float x, float y, float z) {
         if (index >= 0 && index < joints.size()) {
-            joints[index]->targetAngles = Vector3(x, y, z);
+            joints[index].targetAngles = Vector3(x, y, z);
         }
     }
     
     // Bone rotation control
     void setBoneLocalRotation(int index, float x, float y, float z, float w) {
         if (index >= 0 && index < bones.size()) {
-            bones[index]->localRotation = Quaternion(x, y, z, w);
-            bones[index]->localRotation.normalize();
+            bones[index].localRotation = Quaternion(x, y, z, w);
+            bones[index].localRotation.normalize();
         }
     }
     
     val getJointTargetAngles(int index) const {
         val obj = val::object();
         if (index >= 0 && index < joints.size()) {
-            auto& angles = joints[index]->targetAngles;
+            auto& angles = joints[index].targetAngles;
             obj.set("x", angles.x);
             obj.set("y", angles.y);
             obj.set("z", angles.z);
@@ -795,12 +818,12 @@ public:
     
     std::string getJointName(int index) const {
         if (index < 0 || index >= joints.size()) return "";
-        return joints[index]->name;
+        return joints[index].name;
     }
     
     int getJointChildBoneIndex(int index) const {
         if (index < 0 || index >= joints.size()) return -1;
-        return joints[index]->childBoneIndex;
+        return joints[index].childBoneIndex;
     }
     
     // Physics settings
@@ -816,8 +839,8 @@ public:
     
     // Enhanced feature methods
     void detectAndResolveCollisions() {
-        for (auto& bone : bones) {
-            bone->resolveGroundCollision(groundY);
+        for (Bone& bone : bones) {
+            bone.resolveGroundCollision(groundY);
         }
     }
     
@@ -825,15 +848,15 @@ public:
         balanceState.left_foot_grounded = false;
         balanceState.right_foot_grounded = false;
         
-        for (auto& bone : bones) {
-            if (bone->isFootBone) {
-                bone->updateFootContact(groundY);
+        for (Bone& bone : bones) {
+            if (bone.isFootBone) {
+                bone.updateFootContact(groundY);
                 
                 // Determine left/right foot based on position
-                if (bone->position.x < 0) {
-                    balanceState.left_foot_grounded = balanceState.left_foot_grounded || bone->footContact.isGrounded();
+                if (bone.position.x < 0) {
+                    balanceState.left_foot_grounded = balanceState.left_foot_grounded || bone.footContact.isGrounded();
                 } else {
-                    balanceState.right_foot_grounded = balanceState.right_foot_grounded || bone->footContact.isGrounded();
+                    balanceState.right_foot_grounded = balanceState.right_foot_grounded || bone.footContact.isGrounded();
                 }
             }
         }
@@ -853,9 +876,9 @@ public:
         FixedPoint supportCenterX = FixedPoint(0);
         int contactCount = 0;
         
-        for (auto& bone : bones) {
-            if (bone->isFootBone && bone->footContact.isGrounded()) {
-                supportCenterX = supportCenterX + FixedPoint(bone->position.x);
+        for (Bone& bone : bones) {
+            if (bone.isFootBone && bone.footContact.isGrounded()) {
+                supportCenterX = supportCenterX + FixedPoint(bone.position.x);
                 contactCount++;
             }
         }
@@ -907,15 +930,15 @@ public:
     
     void applyAnkleStrategy() {
         // Apply ankle corrections to foot bones
-        for (auto& bone : bones) {
-            if (bone->isFootBone && bone->footContact.isGrounded()) {
+        for (Bone& bone : bones) {
+            if (bone.isFootBone && bone.footContact.isGrounded()) {
                 FixedPoint ankleCorrection = -balanceState.com_offset_x * FixedPoint(0.3f);
                 
                 // Apply correction as rotation
                 Vector3 correctionVector(ankleCorrection.toFloat(), 0, 0);
                 Quaternion correctionRot = Quaternion::fromAxisAngle(Vector3(0, 0, 1), ankleCorrection.toFloat() * 0.1f);
-                bone->localRotation = bone->localRotation * correctionRot;
-                bone->localRotation.normalize();
+                bone.localRotation = bone.localRotation * correctionRot;
+                bone.localRotation.normalize();
             }
         }
     }
@@ -924,15 +947,14 @@ public:
         // Apply hip strategy to pelvis and spine
         FixedPoint hipCorrection = -balanceState.com_offset_x * FixedPoint(0.5f);
         
-        for (auto& bone : bones) {
-            if (bone->name.find("pelvis") != std::string::npos ||
-                bone->name.find("spine") != std::string::npos) {
+        for (Bone& bone : bones) {
+            if (bone.isHipBone) {
                 
                 // Apply correction as rotation
                 Vector3 correctionVector(hipCorrection.toFloat(), 0, 0);
                 Quaternion correctionRot = Quaternion::fromAxisAngle(Vector3(0, 0, 1), hipCorrection.toFloat() * 0.05f);
-                bone->localRotation = bone->localRotation * correctionRot;
-                bone->localRotation.normalize();
+                bone.localRotation = bone.localRotation * correctionRot;
+                bone.localRotation.normalize();
             }
         }
     }
@@ -941,18 +963,18 @@ public:
         // Apply stepping corrections
         FixedPoint stepCorrection = -balanceState.com_offset_x * FixedPoint(0.2f);
         
-        for (auto& bone : bones) {
-            if (bone->isFootBone && bone->footContact.isGrounded()) {
+        for (Bone& bone : bones) {
+            if (bone.isFootBone && bone.footContact.isGrounded()) {
                 // Move foot in direction of correction
-                bone->position.x += stepCorrection.toFloat() * 0.1f;
-                bone->updateFixedPointPosition();
+                bone.position.x += stepCorrection.toFloat() * 0.1f;
+                bone.updateFixedPointPosition();
             }
         }
     }
     
     void updateFixedPointPositions() {
-        for (auto& bone : bones) {
-            bone->updateFixedPointPosition();
+        for (Bone& bone : bones) {
+            bone.updateFixedPointPosition();
         }
     }
     
@@ -998,9 +1020,9 @@ public:
         Vector3 pole(poleX, poleY, poleZ);
         
         // Get current bone positions
-        Vector3 rootPos = skeleton.getBonePosition(rootBoneIdx);
-        Vector3 midPos = skeleton.getBonePosition(midBoneIdx);
-        Vector3 endPos = skeleton.getBonePosition(endBoneIdx);
+        Vector3 rootPos = skeleton.boneWorldPosition(rootBoneIdx);
+        Vector3 midPos = skeleton.boneWorldPosition(midBoneIdx);
+        Vector3 endPos = skeleton.boneWorldPosition(endBoneIdx);
         
         // Calculate bone lengths
         float rootToMidLength = (midPos - rootPos).length();
@@ -1073,7 +1095,7 @@ private:
     static void applyRotationToBone(Skeleton& skeleton, int boneIdx, 
                                    const Vector3& fromPos, const Vector3& toPos) {
         // Calculate rotation needed to point bone from fromPos to toPos
-        Vector3 currentDirection = skeleton.getBoneRotation(boneIdx).rotate(Vector3(0, 1, 0));
+        Vector3 currentDirection = skeleton.boneWorldRotation(boneIdx).rotate(Vector3(0, 1, 0));
         Vector3 targetDirection = (toPos - fromPos).normalized();
         
         if (currentDirection.length() < 0.1f || targetDirection.length() < 0.1f) return;
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdio>
+
+/**
+ * Check.h - minimal assertions for the native tests in this directory
+ *
+ * CHECK records a failure and keeps going; a test's main returns
+ * check_result() so ctest sees any failure.
+ */
+
+inline int& check_failures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++check_failures(); \
+        } \
+    } while (0)
+
+inline int check_result() {
+    if (check_failures() == 0) return 0;
+    std::fprintf(stderr, "%d check(s) failed\n", check_failures());
+    return 1;
+}
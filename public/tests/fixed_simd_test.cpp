@@ -0,0 +1,185 @@
+/**
+ * fixed_simd_test - FixedSimd lanes (src/wasm/physics/FixedSimd.h) against the scalar Fixed operators
+ *
+ * Built with DOZEDENT_PHYSICS_SIMD=1 so the i32x4 kernels exist natively.
+ * Every lane must equal the scalar result bit for bit, over random values
+ * and over edges where the 64-bit product truncates or a sum wraps. The
+ * target builds with -fwrapv: a wrapping int32 sum is undefined in the
+ * scalar operators and wraps in the lanes, and the check compares them there too.
+ */
+#define DOZEDENT_PHYSICS_SIMD 1
+#include "physics/FixedSimd.h"
+#include "Check.h"
+#include <cstdint>
+#include <vector>
+
+using namespace FixedSimd;
+
+namespace {
+
+// Same LCG as the bench scripts
+struct Rng {
+    uint32_t state;
+    uint32_t next() { return state = state * 1664525u + 1013904223u; }
+};
+
+// Raw values at and around overflow, sign and Q16.16 boundaries
+const int32_t EDGES[] = {
+    0, 1, -1, 2, -2, 0xFFFF, 0x10000, -0x10000, 0x10001, 0x7FFF, 0x8000, -0x8000,
+    0x00B504F3, -0x00B504F3,   // ~181.02: its square is just past the int32 range
+    0x01000000, -0x01000000, 0x3FFFFFFF, -0x40000000,
+    0x7FFFFFFF, 0x7FFFFFFE, INT32_MIN, INT32_MIN + 1
+};
+constexpr int EDGE_COUNT = sizeof(EDGES) / sizeof(EDGES[0]);
+
+// Input sets of four lanes: random, random per magnitude band, and every edge combination
+std::vector<int32_t> inputs(Rng& rng) {
+    std::vector<int32_t> v;
+    for (int i = 0; i < 4096; ++i) {
+        v.push_back(static_cast<int32_t>(rng.next()));
+    }
+    for (int shift = 0; shift < 31; shift += 3) {
+        for (int i = 0; i < 256; ++i) {
+            v.push_back(static_cast<int32_t>(rng.next()) >> shift);
+        }
+    }
+    for (int a = 0; a < EDGE_COUNT; ++a) {
+        for (int b = 0; b < EDGE_COUNT; ++b) {
+            v.push_back(EDGES[a]);
+            v.push_back(EDGES[b]);
+        }
+    }
+    v.resize(v.size() & ~static_cast<size_t>(3));
+    return v;
+}
+
+i32x4 lanes(const int32_t* p) { return i32x4{ p[0], p[1], p[2], p[3] }; }
+
+int g_mismatches = 0;
+
+void expect_lanes(const char* kernel, i32x4 got, const int32_t* want) {
+    for (int l = 0; l < 4; ++l) {
+        if (got[l] != want[l]) {
+            if (g_mismatches < 8) {
+                std::fprintf(stderr, "%s lane %d: simd %d scalar %d\n", kernel, l, got[l], want[l]);
+            }
+            ++g_mismatches;
+        }
+    }
+}
+
+void test_mul(const std::vector<int32_t>& a, const std::vector<int32_t>& b) {
+    for (size_t k = 0; k + 4 <= a.size(); k += 4) {
+        int32_t want[4];
+        for (int l = 0; l < 4; ++l) want[l] = (Fixed(a[k + l]) * Fixed(b[k + l])).raw;
+        expect_lanes("mul", mul(lanes(&a[k]), lanes(&b[k])), want);
+
+        // Compound form used by drag: v *= drag
+        for (int l = 0; l < 4; ++l) {
+            Fixed v(a[k + l]);
+            v *= Fixed(b[k + l]);
+            want[l] = v.raw;
+        }
+        expect_lanes("mul_assign", mul(lanes(&a[k]), lanes(&b[k])), want);
+    }
+}
+
+void test_length_squared(const std::vector<int32_t>& x, const std::vector<int32_t>& y,
+                         const std::vector<int32_t>& z) {
+    for (size_t k = 0; k + 4 <= x.size(); k += 4) {
+        int32_t want[4];
+        for (int l = 0; l < 4; ++l) {
+            want[l] = FixedVector3(Fixed(x[k + l]), Fixed(y[k + l]), Fixed(z[k + l])).length_squared().raw;
+        }
+        expect_lanes("length_squared", length_squared(lanes(&x[k]), lanes(&y[k]), lanes(&z[k])), want);
+    }
+}
+
+// integrate_forces_simd's velocity update and its clamp/stop masks against integrate_body's scalar steps
+void test_velocity_step(const std::vector<int32_t>& v, const std::vector<int32_t>& a, Rng& rng) {
+    const Fixed dt = Fixed::from_float(1.0f / 60.0f);
+    const Fixed gravity = Fixed::from_float(-9.8f);
+    const Fixed max_sq = Fixed::from_int(50) * Fixed::from_int(50);
+    const Fixed min_sq = Fixed::from_float(0.001f) * Fixed::from_float(0.001f);
+    for (size_t k = 0; k + 4 <= v.size(); k += 4) {
+        const uint32_t bits = rng.next();
+        i32x4 dynamic = splat(0);
+        i32x4 drag4 = splat(0);
+        int32_t want_v[4];
+        int32_t want_clamp[4];
+        int32_t want_stop[4];
+        for (int l = 0; l < 4; ++l) {
+            const bool is_dynamic = (bits >> l) & 1;
+            const Fixed drag = Fixed::from_float(0.9f + 0.1f * static_cast<float>((bits >> (8 + l * 4)) & 15) / 15.0f);
+            dynamic[l] = is_dynamic ? -1 : 0;
+            drag4[l] = drag.raw;
+
+            Fixed vel(v[k + l]);
+            Fixed accel(a[k + l]);
+            if (is_dynamic) accel += gravity;
+            vel += accel * dt;
+            vel *= drag;
+            const Fixed speed_sq = vel * vel;
+            want_v[l] = vel.raw;
+            want_clamp[l] = speed_sq > max_sq ? -1 : 0;
+            want_stop[l] = speed_sq < min_sq ? -1 : 0;
+        }
+        i32x4 vel = lanes(&v[k]);
+        vel += mul(lanes(&a[k]) + (splat(gravity) & dynamic), splat(dt));
+        vel = mul(vel, drag4);
+        const i32x4 speed_sq = mul(vel, vel);
+        expect_lanes("velocity", vel, want_v);
+        expect_lanes("clamp_mask", speed_sq > splat(max_sq), want_clamp);
+        expect_lanes("stop_mask", speed_sq < splat(min_sq), want_stop);
+
+        int32_t want_sel[4];
+        for (int l = 0; l < 4; ++l) want_sel[l] = want_stop[l] ? 0 : want_v[l];
+        expect_lanes("select", select(speed_sq < splat(min_sq), splat(0), vel), want_sel);
+        CHECK(any(speed_sq < splat(min_sq)) == (want_stop[0] || want_stop[1] || want_stop[2] || want_stop[3]));
+    }
+}
+
+void test_vec3x4() {
+    FixedVector3 v[6];
+    for (int i = 0; i < 6; ++i) {
+        v[i] = FixedVector3(Fixed(EDGES[i]), Fixed(EDGES[EDGE_COUNT - 1 - i]), Fixed(i * 0x10000));
+    }
+    const uint32_t idx[4] = { 5, 0, 3, 3 };
+    const Vec3x4 gathered = Vec3x4::load(v, idx);
+    for (int l = 0; l < 4; ++l) {
+        const FixedVector3 lane = gathered.lane(l);
+        CHECK(lane.x == v[idx[l]].x && lane.y == v[idx[l]].y && lane.z == v[idx[l]].z);
+    }
+
+    // store() writes only masked lanes
+    FixedVector3 out[4];
+    Vec3x4 row = Vec3x4::load(v);
+    row.set_lane(2, FixedVector3(Fixed(7), Fixed(8), Fixed(9)));
+    row.store(out, i32x4{ -1, 0, -1, 0 });
+    CHECK(out[0].x == v[0].x && out[0].y == v[0].y && out[0].z == v[0].z);
+    CHECK(out[1].x.raw == 0 && out[1].y.raw == 0 && out[1].z.raw == 0);
+    CHECK(out[2].x.raw == 7 && out[2].y.raw == 8 && out[2].z.raw == 9);
+    CHECK(out[3].x.raw == 0);
+}
+
+} // namespace
+
+int main() {
+    Rng rng{12345};
+    const std::vector<int32_t> a = inputs(rng);
+    const std::vector<int32_t> b = inputs(rng);
+    const std::vector<int32_t> c = inputs(rng);
+
+    test_mul(a, b);
+    test_mul(b, a);
+    test_length_squared(a, b, c);
+    test_length_squared(c, c, c);
+    test_velocity_step(a, b, rng);
+    test_vec3x4();
+
+    if (g_mismatches) {
+        std::fprintf(stderr, "%d lane mismatches\n", g_mismatches);
+    }
+    CHECK(g_mismatches == 0);
+    return check_result();
+}
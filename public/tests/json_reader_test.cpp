@@ -0,0 +1,157 @@
+/**
+ * json_reader_test - JsonReader (src/wasm/JsonReader.h)
+ */
+#include "JsonReader.h"
+#include "Check.h"
+#include <cstring>
+#include <string>
+
+namespace {
+
+// The reader keeps pointers into json, which must outlive it
+JsonReader reader(const std::string& json) {
+    return JsonReader(json.data(), static_cast<int>(json.size()));
+}
+
+JsonReader reader(const char* json) {
+    return JsonReader(json, static_cast<int>(std::strlen(json)));
+}
+
+// Reads {"a": <value>, "b": 7} skipping "a"; true when "b" comes back as 7
+bool skips_to_b(const std::string& value) {
+    const std::string json = "{\"a\": " + value + ", \"b\": 7}";
+    JsonReader r = reader(json);
+    JsonStr key;
+    int b = 0;
+    if (!r.begin_object()) return false;
+    while (r.next_key(key)) {
+        if (key == "b") {
+            r.read_int(b);
+        } else {
+            r.skip();
+        }
+    }
+    return r.ok() && b == 7;
+}
+
+void test_nested_containers() {
+    // Keys after a nested array used to be lost by the find()-based scanning
+    CHECK(skips_to_b("[[1, 2], [3, [4, 5]], {\"x\": [6]}]"));
+    CHECK(skips_to_b("{\"deep\": {\"deeper\": {\"b\": 1}}, \"list\": []}"));
+    CHECK(skips_to_b("[]"));
+    CHECK(skips_to_b("{}"));
+    CHECK(skips_to_b("[\"]\", \"}\", \"[\"]"));
+    CHECK(skips_to_b("[true, false, null, -1.5e3]"));
+
+    JsonReader r = reader("[[1], [2, 3], []]");
+    int outer = 0;
+    CHECK(r.begin_array());
+    while (r.next_element()) {
+        CHECK(r.skip());
+        ++outer;
+    }
+    CHECK(r.ok());
+    CHECK(outer == 3);
+}
+
+void test_strings() {
+    JsonReader r = reader("[\"plain\", \"say \\\"hi\\\"\\n\", \"a\\\\b\\/c\\t\"]");
+    JsonStr s;
+    CHECK(r.begin_array());
+    CHECK(r.next_element() && r.read_string(s));
+    CHECK(!s.escaped && s == "plain");
+    CHECK(r.next_element() && r.read_string(s));
+    CHECK(s.escaped && s.to_string() == "say \"hi\"\n");
+    CHECK(r.next_element() && r.read_string(s));
+    CHECK(s.to_string() == "a\\b/c\t");
+    CHECK(!r.next_element() && r.ok());
+}
+
+void test_unicode_escapes() {
+    JsonReader r = reader("\"A\\u0041 \\u00e9 \\u20AC\"");
+    JsonStr s;
+    CHECK(r.read_string(s));
+    // U+0041, U+00E9 (2-byte UTF-8) and U+20AC (3-byte UTF-8)
+    CHECK(s.to_string() == "AA \xC3\xA9 \xE2\x82\xAC");
+}
+
+void test_numbers() {
+    JsonReader r = reader("[0, -12, 3.25, 1e3, 2.5E-2, -4e+1, 123456789012, 0.1]");
+    double d = 0.0;
+    const double expected[] = {0.0, -12.0, 3.25, 1000.0, 0.025, -40.0, 123456789012.0, 0.1};
+    CHECK(r.begin_array());
+    for (double e : expected) {
+        CHECK(r.next_element() && r.read_number(d));
+        CHECK(d == e);
+    }
+    CHECK(!r.next_element() && r.ok());
+
+    int i = 0;
+    JsonReader big = reader("1e12");
+    CHECK(big.read_int(i) && i == 2147483647);
+    float f = 0.0f;
+    JsonReader small = reader("-7.5e-1");
+    CHECK(small.read_float(f) && f == -0.75f);
+}
+
+void test_malformed() {
+    const char* bad[] = {
+        "{\"a\": ",          // Truncated after a key
+        "{\"a\": [1, 2",     // Unclosed array
+        "{\"a\": \"open",    // Unterminated string
+        "{\"a\": -}",        // Sign without digits
+        "{\"a\": nul}",      // Bad literal
+        "{\"a\": @}",        // No value
+        "{\"a\" 1}",         // Missing colon
+    };
+    for (const char* json : bad) {
+        JsonReader r(json, static_cast<int>(std::strlen(json)));
+        JsonStr key;
+        int guard = 0;
+        if (r.begin_object()) {
+            while (r.next_key(key) && ++guard < 10) {
+                r.skip();
+            }
+        }
+        CHECK(!r.ok());
+        CHECK(guard < 10);
+        // A failed reader stays failed
+        CHECK(!r.skip() && r.peek() == JsonReader::Invalid);
+    }
+
+    // The length bounds the buffer even without a NUL
+    const char buf[] = {'[', '1', ',', '2', ']', 'x'};
+    JsonReader r(buf, 3);
+    CHECK(r.skip() == false);
+}
+
+void test_depth_cap() {
+    std::string ok_nesting(JsonReader::MAX_DEPTH, '[');
+    ok_nesting += std::string(JsonReader::MAX_DEPTH, ']');
+    JsonReader r = reader(ok_nesting);
+    CHECK(r.skip() && r.ok());
+
+    std::string too_deep(JsonReader::MAX_DEPTH + 1, '[');
+    too_deep += std::string(JsonReader::MAX_DEPTH + 1, ']');
+    JsonReader deep = reader(too_deep);
+    CHECK(!deep.skip() && !deep.ok());
+
+    // Hostile input: far deeper than any stack could recurse, unterminated
+    std::string hostile(100000, '[');
+    CHECK(!skips_to_b(hostile));
+    std::string objects;
+    for (int i = 0; i < 100000; ++i) objects += "{\"k\":";
+    CHECK(!skips_to_b(objects));
+}
+
+} // namespace
+
+int main() {
+    test_nested_containers();
+    test_strings();
+    test_unicode_escapes();
+    test_numbers();
+    test_malformed();
+    test_depth_cap();
+    return check_result();
+}
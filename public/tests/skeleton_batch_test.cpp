@@ -0,0 +1,196 @@
+/**
+ * skeleton_batch_test - SkeletonBatch (src/wasm/physics/SkeletonBatch.h)
+ *
+ * Steps a batch next to one PlayerSkeleton per instance and requires
+ * bit-identical joints, foot contacts and balance offsets on every tick.
+ */
+#include "physics/SkeletonBatch.h"
+#include "Check.h"
+#include <cstdint>
+#include <vector>
+
+using namespace SkeletonPhysics;
+
+namespace {
+
+constexpr int INSTANCES = 24;
+constexpr int TICKS = 600;
+const Fixed TICK_DT = Fixed::from_float(1.0f / 60.0f);
+
+// PlayerSkeleton joints in HumanoidJoint order
+Joint PlayerSkeleton::* const JOINTS[SkeletonBatch::JOINT_COUNT] = {
+    &PlayerSkeleton::head, &PlayerSkeleton::neck, &PlayerSkeleton::chest,
+    &PlayerSkeleton::mid_spine, &PlayerSkeleton::lower_spine, &PlayerSkeleton::pelvis,
+    &PlayerSkeleton::shoulder_l, &PlayerSkeleton::shoulder_r, &PlayerSkeleton::elbow_l,
+    &PlayerSkeleton::elbow_r, &PlayerSkeleton::wrist_l, &PlayerSkeleton::wrist_r,
+    &PlayerSkeleton::hand_l, &PlayerSkeleton::hand_r, &PlayerSkeleton::hip_l, &PlayerSkeleton::hip_r,
+    &PlayerSkeleton::knee_l, &PlayerSkeleton::knee_r, &PlayerSkeleton::ankle_l, &PlayerSkeleton::ankle_r,
+    &PlayerSkeleton::heel_l, &PlayerSkeleton::heel_r, &PlayerSkeleton::foot_l, &PlayerSkeleton::foot_r,
+    &PlayerSkeleton::toe_l, &PlayerSkeleton::toe_r
+};
+
+// Same LCG as the bench scripts
+struct Rng {
+    uint32_t state;
+    uint32_t next() { return state = state * 1664525u + 1013904223u; }
+    float unit() { return static_cast<float>(next() >> 8) / 16777216.0f; }
+};
+
+// PlayerSkeleton constraints point into the skeleton, so references are never copied or moved
+using Reference = std::vector<PlayerSkeleton>;
+
+bool matches(const SkeletonBatch& batch, uint32_t i, const PlayerSkeleton& sk) {
+    for (int j = 0; j < SkeletonBatch::JOINT_COUNT; ++j) {
+        const Joint& joint = sk.*JOINTS[j];
+        if (batch.joint_x(i, j).raw != joint.x.raw || batch.joint_y(i, j).raw != joint.y.raw) {
+            return false;
+        }
+    }
+    return batch.foot_contact_l(i) == sk.foot_contact_l &&
+        batch.foot_contact_r(i) == sk.foot_contact_r &&
+        batch.com_offset(i).raw == sk.com_offset.raw;
+}
+
+// Instances in varied poses: drops from different heights, scales and one pinned hand
+void populate(SkeletonBatch& batch, Reference& ref, Rng& rng) {
+    for (int i = 0; i < INSTANCES; ++i) {
+        const Fixed x = Fixed::from_float(rng.unit());
+        const Fixed y = Fixed::from_float(-0.2f - 0.5f * rng.unit());
+        const Fixed scale = Fixed::from_float(0.1f + 0.2f * rng.unit());
+        batch.add(x, y, scale);
+        ref[i].initialize(x, y, scale);
+        if (i % 7 == 3) {
+            batch.set_joint_fixed(static_cast<uint32_t>(i), J_HAND_L, true);
+            ref[i].hand_l.fixed = true;
+        }
+    }
+}
+
+// A pelvis shove on a few instances per tick tips them into the larger balance strategies
+void shove(SkeletonBatch& batch, Reference& ref, Rng& rng, int tick) {
+    if (tick % 11 != 0) return;
+    const uint32_t i = rng.next() % batch.size();
+    const Fixed push = Fixed::from_float(0.08f * (rng.unit() - 0.5f));
+    PlayerSkeleton& sk = ref[i];
+    batch.sync_to_position(i, sk.pelvis.x + push, sk.pelvis.y);
+    sk.sync_to_player_position(sk.pelvis.x + push, sk.pelvis.y);
+}
+
+void test_matches_player_skeleton() {
+    Rng rng{12345};
+    SkeletonBatch batch(4);  // Grows (and re-lays out its columns) while populating
+    Reference ref(INSTANCES);
+    populate(batch, ref, rng);
+    CHECK(batch.size() == static_cast<uint32_t>(INSTANCES));
+
+    int first_mismatch = -1;
+    int grounded = 0;
+    for (int t = 0; t < TICKS; ++t) {
+        shove(batch, ref, rng, t);
+        batch.update(TICK_DT);
+        for (PlayerSkeleton& sk : ref) {
+            sk.update(TICK_DT);
+        }
+        for (uint32_t i = 0; i < batch.size(); ++i) {
+            if (first_mismatch < 0 && !matches(batch, i, ref[i])) {
+                first_mismatch = t;
+            }
+            grounded += batch.foot_contact_l(i) ? 1 : 0;
+        }
+    }
+    CHECK(first_mismatch == -1);
+    CHECK(grounded > 0);  // The balance strategies actually ran
+}
+
+void test_settings_and_remove() {
+    Rng rng{777};
+    SkeletonBatch batch;
+    Reference ref(INSTANCES);
+    populate(batch, ref, rng);
+    batch.auto_balance_enabled = false;
+    batch.damping = Fixed::from_float(0.9f);
+    for (PlayerSkeleton& sk : ref) {
+        sk.auto_balance_enabled = false;
+        sk.damping = Fixed::from_float(0.9f);
+    }
+
+    // Instance index -> reference skeleton, patched as remove() moves instances
+    std::vector<int> owner(INSTANCES);
+    for (int i = 0; i < INSTANCES; ++i) owner[i] = i;
+
+    bool ok = true;
+    for (int t = 0; t < 240; ++t) {
+        if (t % 40 == 20) {
+            const uint32_t victim = rng.next() % batch.size();
+            const int moved = batch.remove(victim);
+            const uint32_t last = batch.size();
+            CHECK(moved == (victim == last ? -1 : static_cast<int>(last)));
+            if (moved >= 0) owner[victim] = owner[static_cast<size_t>(moved)];
+            owner.pop_back();
+        }
+        batch.update(TICK_DT);
+        for (PlayerSkeleton& sk : ref) {
+            sk.update(TICK_DT);
+        }
+        for (uint32_t i = 0; i < batch.size(); ++i) {
+            ok = ok && matches(batch, i, ref[static_cast<size_t>(owner[i])]);
+        }
+    }
+    CHECK(ok);
+    CHECK(batch.size() == static_cast<uint32_t>(INSTANCES - 6));
+}
+
+void test_snapshot_round_trip() {
+    Rng rng{99};
+    SkeletonBatch batch;
+    Reference ref(INSTANCES);
+    populate(batch, ref, rng);
+    for (int t = 0; t < 30; ++t) batch.update(TICK_DT);
+
+    SnapshotWriter counter;
+    batch.save_state(counter);
+    std::vector<uint8_t> image(counter.size());
+    SnapshotWriter w(image.data(), image.size());
+    batch.save_state(w);
+    CHECK(w.ok());
+
+    for (int t = 0; t < 60; ++t) batch.update(TICK_DT);
+    std::vector<Fixed> expected;
+    for (uint32_t i = 0; i < batch.size(); ++i) expected.push_back(batch.joint_y(i, J_HEAD));
+
+    // A fresh batch restored from the image replays the same 60 ticks
+    SkeletonBatch restored;
+    SnapshotReader r(image.data(), image.size());
+    CHECK(restored.load_state(r) && r.remaining() == 0);
+    CHECK(restored.size() == batch.size());
+    for (int t = 0; t < 60; ++t) restored.update(TICK_DT);
+    bool same = true;
+    for (uint32_t i = 0; i < restored.size(); ++i) {
+        same = same && restored.joint_y(i, J_HEAD).raw == expected[i].raw;
+    }
+    CHECK(same);
+
+    // Truncated images fail
+    SnapshotReader truncated(image.data(), image.size() - 1);
+    CHECK(!restored.load_state(truncated));
+
+    // A corrupt count is rejected before it sizes the columns
+    const size_t count_offset = sizeof(uint32_t) + 5 * sizeof(Fixed) + sizeof(bool);
+    std::vector<uint8_t> corrupt(image.begin(), image.begin() + static_cast<long>(count_offset));
+    const uint32_t huge = 0x7FFFFFFFu;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&huge);
+    corrupt.insert(corrupt.end(), bytes, bytes + sizeof(huge));
+    SkeletonBatch victim;
+    SnapshotReader hostile(corrupt.data(), corrupt.size());
+    CHECK(!victim.load_state(hostile));
+    CHECK(victim.capacity() == 0);
+}
+
+} // namespace
+
+int main() {
+    test_matches_player_skeleton();
+    test_settings_and_remove();
+    test_snapshot_round_trip();
+    return check_result();
+}
@@ -0,0 +1,45 @@
+#pragma once
+/**
+ * Native stand-in for <emscripten/bind.h> - just enough embind surface for
+ * src/wasm/skeleton/skeleton-physics.cpp to compile in the native build
+ *
+ * Registrations type-check their member and function pointers and do
+ * nothing. The real module is built with em++ (public/wasm/build-skeleton-physics.sh).
+ */
+#include "val.h"
+
+namespace emscripten {
+
+template <typename T>
+class value_object {
+public:
+    explicit value_object(const char*) {}
+    template <typename Field>
+    value_object& field(const char*, Field T::*) { return *this; }
+};
+
+template <typename E>
+class enum_ {
+public:
+    explicit enum_(const char*) {}
+    enum_& value(const char*, E) { return *this; }
+};
+
+template <typename T>
+class class_ {
+public:
+    explicit class_(const char*) {}
+    template <typename... Args>
+    class_& constructor() { return *this; }
+    template <typename Fn>
+    class_& function(const char*, Fn) { return *this; }
+    template <typename Fn>
+    class_& class_function(const char*, Fn) { return *this; }
+};
+
+} // namespace emscripten
+
+#define EMSCRIPTEN_BINDINGS(name) \
+    static void embind_init_##name(); \
+    static const int embind_registered_##name = (embind_init_##name(), 0); \
+    static void embind_init_##name()
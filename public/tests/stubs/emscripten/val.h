@@ -0,0 +1,14 @@
+#pragma once
+/**
+ * Native stand-in for <emscripten/val.h> (see bind.h)
+ */
+namespace emscripten {
+
+class val {
+public:
+    static val object() { return val(); }
+    template <typename T>
+    void set(const char*, const T&) {}
+};
+
+} // namespace emscripten
@@ -0,0 +1,105 @@
+/**
+ * wolf_neighbor_grid_test - WolfNeighborGrid (src/wasm/managers/wolves/WolfNeighborGrid.h)
+ */
+#include "managers/wolves/WolfNeighborGrid.h"
+#include "Check.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr float CELL = 0.15f;
+constexpr float SLACK = 0.05f;
+
+// Same LCG as the bench scripts
+struct Rng {
+    uint32_t state;
+    uint32_t next() { return state = state * 1664525u + 1013904223u; }
+    float unit() { return static_cast<float>(next() >> 8) / 16777216.0f; }
+};
+
+std::vector<Wolf> scatter(Rng& rng, int count, float extent) {
+    std::vector<Wolf> wolves(static_cast<size_t>(count));
+    for (Wolf& w : wolves) {
+        w.x = Fixed::from_float(rng.unit() * extent);
+        w.y = Fixed::from_float(rng.unit() * extent);
+    }
+    return wolves;
+}
+
+float distance_to_segment(float px, float py, float ax, float ay, float bx, float by) {
+    const float dx = bx - ax;
+    const float dy = by - ay;
+    const float len_sq = dx * dx + dy * dy;
+    float t = len_sq > 0.0f ? ((px - ax) * dx + (py - ay) * dy) / len_sq : 0.0f;
+    t = std::fmin(1.0f, std::fmax(0.0f, t));
+    return std::hypot(px - (ax + dx * t), py - (ay + dy * t));
+}
+
+int cell_of(float v) { return static_cast<int>(std::floor(v / CELL)); }
+
+void test_segment_finds_every_near_wolf() {
+    Rng rng{12345};
+    const std::vector<Wolf> wolves = scatter(rng, 2000, 2.0f);
+    WolfNeighborGrid grid(CELL, SLACK);
+    grid.build(wolves);
+
+    std::vector<int> seen(wolves.size());
+    int missed = 0;
+    int duplicates = 0;
+    for (int q = 0; q < 400; ++q) {
+        const float ax = rng.unit() * 2.0f;
+        const float ay = rng.unit() * 2.0f;
+        // Every fifth segment is axis-aligned or a point
+        const float bx = q % 5 == 1 ? ax : rng.unit() * 2.0f;
+        const float by = q % 5 == 2 ? ay : (q % 5 == 3 ? ay + 0.001f : rng.unit() * 2.0f);
+        const float radius = 0.05f * rng.unit();
+
+        std::fill(seen.begin(), seen.end(), 0);
+        grid.for_each_near_segment(ax, ay, bx, by, radius, [&](int i) {
+            duplicates += seen[static_cast<size_t>(i)]++ > 0 ? 1 : 0;
+        });
+        for (size_t i = 0; i < wolves.size(); ++i) {
+            const float d = distance_to_segment(wolves[i].x.to_float(), wolves[i].y.to_float(), ax, ay, bx, by);
+            if (d <= radius + SLACK && !seen[i]) ++missed;
+        }
+    }
+    CHECK(missed == 0);
+    CHECK(duplicates == 0);
+}
+
+void test_diagonal_skips_bounding_box() {
+    Rng rng{777};
+    const std::vector<Wolf> wolves = scatter(rng, 4000, 4.0f);
+    WolfNeighborGrid grid(CELL, SLACK);
+    grid.build(wolves);
+
+    // A corner-to-corner line: its bounding box holds every wolf
+    const float ax = 0.1f;
+    const float ay = 0.1f;
+    const float bx = 3.9f;
+    const float by = 3.9f;
+    const float radius = 0.05f;
+    int visited = 0;
+    grid.for_each_near_segment(ax, ay, bx, by, radius, [&](int) { ++visited; });
+
+    const float r = radius + SLACK;
+    int in_box = 0;
+    for (const Wolf& w : wolves) {
+        const int cx = cell_of(w.x.to_float());
+        const int cy = cell_of(w.y.to_float());
+        if (cx >= cell_of(ax - r) && cx <= cell_of(bx + r) && cy >= cell_of(ay - r) && cy <= cell_of(by + r)) {
+            ++in_box;
+        }
+    }
+    CHECK(visited > 0);
+    CHECK(visited * 4 < in_box);
+}
+
+} // namespace
+
+int main() {
+    test_segment_finds_every_near_wolf();
+    test_diagonal_skips_bounding_box();
+    return check_result();
+}
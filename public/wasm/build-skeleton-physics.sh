@@ -0,0 +1,29 @@
+#!/bin/bash
+# Builds the standalone embind skeleton module (skeleton-physics.js + .wasm)
+# Usage: bash public/wasm/build-skeleton-physics.sh   (npm run wasm:build:skeleton)
+#
+# Replaces the JS stand-in public/wasm/skeleton-physics.js with the real
+# Emscripten glue; src/skeleton/WasmLoaderService.js imports either.
+
+set -e
+cd "$(dirname "$0")/../.."
+
+if ! command -v em++ &> /dev/null; then
+    echo "Error: em++ not found. Activate emsdk first (source ./emsdk/emsdk_env.sh)"
+    exit 1
+fi
+
+flags="-O3"
+
+# Opt-in deterministic trig tables (same switch as build-wasm.sh)
+if [ "${WASM_FIXED_TRIG:-0}" = "1" ]; then
+    flags="$flags -DDOZEDENT_FIXED_TRIG=1"
+    echo "Fixed-point trig tables enabled"
+fi
+
+cmd="em++ public/src/wasm/skeleton/skeleton-physics.cpp $flags -std=c++17 -lembind -s MODULARIZE=1 -s EXPORT_ES6=1 -s ENVIRONMENT=web -s ALLOW_MEMORY_GROWTH=1 -o public/wasm/skeleton-physics.js"
+echo "Command: $cmd"
+eval "$cmd"
+
+size=$(stat -c%s "public/wasm/skeleton-physics.wasm" 2>/dev/null || stat -f%z "public/wasm/skeleton-physics.wasm" 2>/dev/null)
+echo "skeleton-physics.wasm built successfully ($((size / 1024)) KB)"
@@ -0,0 +1,87 @@
+/**
+ * Tests for the sim performance baseline checks (tools/scripts/perf-regression.js)
+ */
+import { describe, it } from 'mocha';
+import { expect } from 'chai';
+import { compareToBaseline, baselineFromReport } from '../../tools/scripts/perf-regression.js';
+
+const baseline = {
+  thresholds: {
+    'tickNs.p50': { ratio: 2.0, timing: true },
+    'tickNs.p99': { ratio: 3.0, timing: true },
+    allocsPerTick: { ratio: 1.0, above: 0.1 },
+    pairsPerTick: { ratio: 1.02, above: 1 },
+    eventsPerTick: { ratio: 1.05, above: 0.5 }
+  },
+  targets: {
+    native: {
+      slo: { 'tickNs.p99': 4000000, allocsPerTick: 0.25 },
+      scenarios: {
+        wolves_100: { tickNs: { p50: 80000, p99: 100000 }, allocsPerTick: 0, pairsPerTick: 320, eventsPerTick: 120 }
+      }
+    }
+  }
+};
+
+function scenario(overrides = {}) {
+  return {
+    name: 'wolves_100',
+    tickNs: { mean: 85000, p50: 85000, p95: 110000, p99: 120000, max: 200000 },
+    allocsPerTick: 0,
+    pairsPerTick: 320,
+    eventsPerTick: 120,
+    ...overrides
+  };
+}
+
+const report = (scenarios, skipped = []) => ({ target: 'native', scenarios, skipped });
+
+describe('perf-regression baselines', () => {
+  it('passes a run that matches its baseline', () => {
+    const result = compareToBaseline(report([scenario()]), baseline);
+    expect(result.failed).to.equal(0);
+    expect(result.checks.every((c) => c.status === 'pass')).to.equal(true);
+  });
+
+  it('fails a counter past its threshold', () => {
+    const result = compareToBaseline(report([scenario({ pairsPerTick: 340 })]), baseline);
+    expect(result.failed).to.equal(1);
+    const failure = result.checks.find((c) => c.status === 'fail');
+    expect(failure.metric).to.equal('pairsPerTick');
+    expect(failure.limit).to.equal(320 * 1.02 + 1);
+  });
+
+  it('ignores timing thresholds and timing SLOs with skipTiming', () => {
+    const slow = scenario({ tickNs: { p50: 500000, p99: 5000000 } });
+    expect(compareToBaseline(report([slow]), baseline).failed).to.equal(3);
+    expect(compareToBaseline(report([slow]), baseline, { skipTiming: true }).failed).to.equal(0);
+  });
+
+  it('enforces SLOs on top of the baseline', () => {
+    const allocating = scenario({ allocsPerTick: 0.3 });
+    const result = compareToBaseline(report([allocating]), baseline);
+    expect(result.checks.filter((c) => c.status === 'fail' && c.slo).length).to.equal(1);
+  });
+
+  it('fails a baseline scenario that did not run, skips one the module cannot run', () => {
+    expect(compareToBaseline(report([]), baseline).failed).to.equal(1);
+    const skipped = compareToBaseline(report([], [{ name: 'wolves_100', missing: ['spawn_wolf'] }]), baseline);
+    expect(skipped.failed).to.equal(0);
+    expect(skipped.checks[0].status).to.equal('skip');
+  });
+
+  it('skips metrics a module does not measure', () => {
+    const result = compareToBaseline(report([scenario({ allocsPerTick: null })]), baseline);
+    expect(result.failed).to.equal(0);
+    expect(result.checks.find((c) => c.metric === 'allocsPerTick').status).to.equal('skip');
+  });
+
+  it('records the baseline metrics from a report', () => {
+    const entry = baselineFromReport(report([scenario({ eventsPerTick: null })])).wolves_100;
+    expect(entry.tickNs.p50).to.equal(85000);
+    expect(entry.tickNs.p99).to.equal(120000);
+    expect(entry.tickNs.max).to.equal(undefined);
+    expect(entry.pairsPerTick).to.equal(320);
+    expect('eventsPerTick' in entry).to.equal(false);
+  });
+});
@@ -124,6 +124,35 @@ describe('ReplayRecorder', () => {
     });
   });
 
+  describe('exportInputLog()', () => {
+    it('should write the header and one record per input change', () => {
+      recorder.start(12345);
+      const held = { axisX: 1, axisY: 0, flags: { light: true } };
+      recorder.recordFrame({ tick: 1, input: held });
+      recorder.recordFrame({ tick: 2, input: held });
+      recorder.recordFrame({ tick: 3, input: { axisX: -0.5, axisY: 0.25, flags: { roll: true, block: true } } });
+
+      const bytes = recorder.exportInputLog({ checkpointInterval: 60, startWeapon: 2 });
+      const view = new DataView(bytes.buffer);
+
+      expect(bytes.length).to.equal(24 + 2 * 8);
+      expect(view.getUint32(0, true)).to.equal(0x4C495A44);
+      expect(view.getUint16(4, true)).to.equal(1);
+      expect(view.getUint16(6, true)).to.equal(60);
+      expect(view.getBigUint64(8, true)).to.equal(12345n);
+      expect(view.getUint32(16, true)).to.equal(2);
+      expect(view.getUint32(20, true)).to.equal(3);
+
+      expect(view.getUint32(24, true)).to.equal(0);
+      expect(view.getInt8(28)).to.equal(127);
+      expect(view.getUint8(30)).to.equal(1 << 2);
+      expect(view.getUint32(32, true)).to.equal(2);
+      expect(view.getInt8(36)).to.equal(-64);
+      expect(view.getInt8(37)).to.equal(32);
+      expect(view.getUint8(38)).to.equal((1 << 0) | (1 << 4));
+    });
+  });
+
   describe('import()', () => {
     it('should import replay data', () => {
       const replayData = {
@@ -0,0 +1,87 @@
+// input-command-ring.spec.js
+// Unit tests for the InputCommandRing writer
+
+import { describe, it, beforeEach } from 'mocha';
+import { expect } from 'chai';
+import {
+  InputCommandRing,
+  InputCommandType,
+  InputButton,
+  INPUT_COMMAND_RING_VERSION,
+  INPUT_COMMAND_STRIDE,
+  INPUT_COMMAND_HEADER_BYTES
+} from '../../../public/src/input/InputCommandRing.js';
+
+const CAPACITY = 4;
+
+function makeExports({ version = INPUT_COMMAND_RING_VERSION } = {}) {
+  const memory = { buffer: new ArrayBuffer(1024) };
+  const ptr = 64;
+  const head = new Uint32Array(memory.buffer, ptr, 8);
+  head[0] = INPUT_COMMAND_RING_VERSION;
+  head[1] = CAPACITY;
+  return {
+    memory,
+    get_input_command_ring_ptr: () => ptr,
+    get_input_command_ring_version: () => version,
+    get_input_command_stride: () => INPUT_COMMAND_STRIDE
+  };
+}
+
+function slot(exports, index) {
+  const ptr = exports.get_input_command_ring_ptr();
+  return new DataView(exports.memory.buffer, ptr + INPUT_COMMAND_HEADER_BYTES + index * INPUT_COMMAND_STRIDE, INPUT_COMMAND_STRIDE);
+}
+
+describe('InputCommandRing', () => {
+  let exports;
+
+  beforeEach(() => {
+    exports = makeExports();
+  });
+
+  it('writes held input with button bits and publishes the write index', () => {
+    const ring = new InputCommandRing(exports);
+    expect(ring.available()).to.equal(true);
+    expect(ring.writeState(0.5, -1, false, true, true, false, true, false, 12.5)).to.equal(true);
+    const cmd = slot(exports, 0);
+    expect(cmd.getFloat32(4, true)).to.equal(12.5);
+    expect(cmd.getUint8(8)).to.equal(InputCommandType.STATE);
+    expect(cmd.getUint8(9)).to.equal(InputButton.JUMP | InputButton.LIGHT_ATTACK | InputButton.BLOCK);
+    expect(cmd.getFloat32(12, true)).to.equal(0.5);
+    expect(cmd.getFloat32(16, true)).to.equal(-1);
+    expect(ring.pending()).to.equal(1);
+  });
+
+  it('stamps commands with the frame that will drain them', () => {
+    const ring = new InputCommandRing(exports);
+    new Uint32Array(exports.memory.buffer, 64, 8)[4] = 7;
+    ring.press(InputCommandType.ROLL, 1);
+    expect(slot(exports, 0).getUint32(0, true)).to.equal(7);
+  });
+
+  it('drops commands while the ring is full', () => {
+    const ring = new InputCommandRing(exports);
+    for (let i = 0; i < CAPACITY; i++) {
+      expect(ring.press(InputCommandType.LIGHT_ATTACK, i)).to.equal(true);
+    }
+    expect(ring.press(InputCommandType.HEAVY_ATTACK, 9)).to.equal(false);
+    expect(ring.dropped()).to.equal(1);
+    // The simulation consuming two frees two slots
+    new Uint32Array(exports.memory.buffer, 64, 8)[3] = 2;
+    expect(ring.press(InputCommandType.HEAVY_ATTACK, 10)).to.equal(true);
+    expect(slot(exports, 0).getUint8(8)).to.equal(InputCommandType.HEAVY_ATTACK);
+  });
+
+  it('stores the host clock on flush', () => {
+    const ring = new InputCommandRing(exports);
+    ring.flush(1234.5);
+    expect(new Float64Array(exports.memory.buffer, 64, 4)[3]).to.equal(1234.5);
+  });
+
+  it('is unavailable when the layout version differs', () => {
+    const ring = new InputCommandRing(makeExports({ version: 99 }));
+    expect(ring.available()).to.equal(false);
+    expect(ring.press(InputCommandType.ROLL)).to.equal(false);
+  });
+});
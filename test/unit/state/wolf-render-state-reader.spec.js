@@ -0,0 +1,69 @@
+// wolf-render-state-reader.spec.js
+// Unit tests for WolfRenderStateReader and the WolfStateManager bulk path
+
+import { describe, it, beforeEach } from 'mocha';
+import { expect } from 'chai';
+import {
+  WolfRenderStateReader,
+  WolfRenderField as F,
+  WOLF_RENDER_STATE_WORDS,
+  WOLF_RENDER_STATE_VERSION
+} from '../../../public/src/game/state/WolfRenderStateReader.js';
+import { WolfStateManager } from '../../../public/src/game/state/WolfStateManager.js';
+
+function makeExports(count, { version = WOLF_RENDER_STATE_VERSION } = {}) {
+  const memory = { buffer: new ArrayBuffer(4096) };
+  const ptr = 64;
+  const u32 = new Uint32Array(memory.buffer, ptr, count * WOLF_RENDER_STATE_WORDS);
+  const f32 = new Float32Array(memory.buffer, ptr, count * WOLF_RENDER_STATE_WORDS);
+  for (let i = 0; i < count; i++) {
+    const b = i * WOLF_RENDER_STATE_WORDS;
+    u32[b + F.ID] = i + 1;
+    u32[b + F.STATE] = 6;
+    u32[b + F.EMOTION] = 2;
+    f32[b + F.X] = 0.25 * (i + 1);
+    f32[b + F.Y] = 0.5;
+    f32[b + F.HEALTH] = 80;
+  }
+  return {
+    memory,
+    get_wolf_render_state_version: () => version,
+    get_wolf_render_state_stride: () => WOLF_RENDER_STATE_WORDS * 4,
+    get_wolf_render_state_ptr: () => ptr,
+    get_wolf_render_state_count: () => count,
+    get_wolf_count: () => { throw new Error('per-field path should not be used'); }
+  };
+}
+
+describe('WolfRenderStateReader', () => {
+  let exports;
+
+  beforeEach(() => {
+    exports = makeExports(3);
+  });
+
+  it('reads records through typed array views', () => {
+    const reader = new WolfRenderStateReader(exports);
+    expect(reader.available()).to.equal(true);
+    expect(reader.refresh()).to.equal(3);
+    const b = reader.base(2);
+    expect(reader.u32[b + F.ID]).to.equal(3);
+    expect(reader.f32[b + F.X]).to.be.closeTo(0.75, 1e-6);
+  });
+
+  it('is unavailable when the layout version differs', () => {
+    const reader = new WolfRenderStateReader(makeExports(1, { version: 99 }));
+    expect(reader.available()).to.equal(false);
+    expect(reader.refresh()).to.equal(0);
+  });
+
+  it('feeds WolfStateManager snapshots without per-field calls', () => {
+    const manager = new WolfStateManager(exports);
+    const snapshot = manager.getSnapshot(1);
+    expect(snapshot.wolves).to.have.length(3);
+    expect(snapshot.wolves[0].position[0]).to.be.closeTo(0.25, 1e-6);
+    expect(snapshot.wolves[0].state).to.equal(6);
+    expect(snapshot.wolves[0].emotion).to.equal(2);
+    expect(snapshot.wolves[0].health).to.equal(80);
+  });
+});
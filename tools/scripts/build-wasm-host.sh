@@ -12,7 +12,7 @@ cd wasm
 emcc game-host.cpp \
     -O3 \
     -s STANDALONE_WASM=1 \
-    -s EXPORTED_FUNCTIONS='["_game_init","_game_create_state","_game_update","_game_handle_input","_game_get_state","_game_get_state_size","_game_apply_state","_game_destroy","_malloc","_free"]' \
+    -s EXPORTED_FUNCTIONS='["_game_init","_game_create_state","_game_update","_game_handle_input","_game_get_state","_game_get_state_size","_game_apply_state","_game_handle_input_binary","_game_get_state_binary","_game_get_state_binary_size","_game_apply_state_binary","_game_get_state_for","_game_set_interest","_game_destroy","_malloc","_free"]' \
     -s EXPORTED_RUNTIME_METHODS='["ccall","cwrap"]' \
     -s ALLOW_MEMORY_GROWTH=1 \
     -s WASM_BIGINT=1 \
@@ -1,9 +1,9 @@
 # PowerShell script to build WASM modules with proper environment setup
-# Usage: .\scripts\build-wasm.ps1 [dev|prod|host|all]
+# Usage: .\scripts\build-wasm.ps1 [dev|prod|host|classes|perf|all]
 
 param(
     [Parameter(Position=0)]
-    [ValidateSet('dev', 'prod', 'prod-safe', 'host', 'all', '')]
+    [ValidateSet('dev', 'prod', 'prod-safe', 'host', 'classes', 'perf', 'all', '')]
     [string]$BuildType = 'prod'
 )
 
@@ -59,10 +59,15 @@ try {
     exit 1
 }
 
+# Character class ids (see public/src/wasm/BuildConfig.h)
+$classIds = @{ warden = 1; raider = 2; kensei = 3 }
+
 function Build-GameWasm {
-    param([string]$Mode)
+    # Optional class: game_<class>.wasm with one ability path and no debug getters
+    param([string]$Mode, [string]$Class = '')
     
-    Write-Host "Building game.wasm in $Mode mode..." -ForegroundColor Cyan
+    $output = if ($Class) { "game_$Class.wasm" } elseif ($Mode -eq "perf") { "game-perf.wasm" } else { "game.wasm" }
+    Write-Host "Building $output in $Mode mode..." -ForegroundColor Cyan
     
     if ($Mode -eq "dev") {
         $flags = "-O1 -g -s ASSERTIONS=1"
@@ -70,15 +75,25 @@ function Build-GameWasm {
     } elseif ($Mode -eq "prod-safe") {
         $flags = "-O2"
         Write-Host "Production build with safe optimization (O2)" -ForegroundColor Yellow
+    } elseif ($Mode -eq "perf") {
+        # For tools/scripts/wasm-bench.js only: profile zones and counted operator new
+        $flags = "-O3 -DDOZEDENT_PROFILE=1 -DDOZEDENT_COUNT_ALLOCS=1"
+        Write-Host "Perf build with profile zones and heap allocation counting" -ForegroundColor Yellow
     } else {
         $flags = "-O3"
         Write-Host "Production build with maximum optimization" -ForegroundColor Yellow
     }
     
+    if ($Class) {
+        $flags = "$flags -DDOZEDENT_CLASS=$($classIds[$Class]) -DDOZEDENT_DEBUG_EXPORTS=0"
+        Write-Host "Class module: $Class" -ForegroundColor Yellow
+    }
+    
     # Collect all C++ source files
     $sourceFiles = @(
         "public/src/wasm/game_refactored.cpp",
         "public/src/wasm/GameGlobals.cpp",
+        "public/src/wasm/AllocCounter.cpp",
         "public/src/wasm/managers/CombatManager.cpp",
         "public/src/wasm/managers/GameStateManager.cpp",
         "public/src/wasm/managers/InputManager.cpp",
@@ -86,7 +101,10 @@ function Build-GameWasm {
         "public/src/wasm/managers/WolfManager.cpp",
         "public/src/wasm/managers/wolves/StateMachine.cpp",
         "public/src/wasm/managers/ArmManager.cpp",
+        "public/src/wasm/managers/WorldManager.cpp",
         "public/src/wasm/coordinators/GameCoordinator.cpp",
+        "public/src/wasm/coordinators/SimInstance.cpp",
+        "public/src/wasm/coordinators/InputLog.cpp",
         "public/src/wasm/physics/PhysicsManager.cpp",
         "public/src/wasm/progression/AbilityUpgradeSystem.cpp",
         "public/src/wasm/progression/UpgradeTree.cpp",
@@ -117,25 +135,29 @@ function Build-GameWasm {
         # Wolf Animation (Procedural leg IK and body bob)
         "_get_wolf_leg_x", "_get_wolf_leg_y", "_get_wolf_body_bob", "_get_wolf_head_pitch", "_get_wolf_ear_rotation"
     )
+    if ($Class) {
+        # Debug getters are compiled out of class modules
+        $exportedFunctions = $exportedFunctions | Where-Object { $_ -notin @("_get_physics_perf_ms", "_get_collision_pairs_checked", "_get_collisions_resolved") }
+    }
     $exportedFunctionsJson = '["' + ($exportedFunctions -join '","') + '"]'
-    $cmd = "em++ $($sourceFiles -join ' ') $flags -Ipublic/src/wasm -Ipublic/src/wasm/managers -Ipublic/src/wasm/coordinators -Ipublic/src/wasm/physics -Ipublic/src/wasm/progression -Ipublic/src/entities -s STANDALONE_WASM=1 -s WASM_BIGINT=1 -s ALLOW_MEMORY_GROWTH=1 -s EXPORTED_FUNCTIONS=`"$exportedFunctionsJson`" -o ./public/wasm/game.wasm"
+    $cmd = "em++ $($sourceFiles -join ' ') $flags -Ipublic/src/wasm -Ipublic/src/wasm/managers -Ipublic/src/wasm/coordinators -Ipublic/src/wasm/physics -Ipublic/src/wasm/progression -Ipublic/src/entities -s STANDALONE_WASM=1 -s WASM_BIGINT=1 -s ALLOW_MEMORY_GROWTH=1 -s EXPORTED_FUNCTIONS=`"$exportedFunctionsJson`" -o ./public/wasm/$output"
     Write-Host "Command: $cmd" -ForegroundColor Gray
     
     try {
         Invoke-Expression $cmd
         if ($LASTEXITCODE -eq 0) {
-            $sizeBytes = (Get-Item "public/wasm/game.wasm").Length
+            $sizeBytes = (Get-Item "public/wasm/$output").Length
             $sizeKB = [math]::Round($sizeBytes / 1KB, 1)
-            Write-Host "game.wasm built successfully ($sizeKB KB)" -ForegroundColor Green
+            Write-Host "$output built successfully ($sizeKB KB)" -ForegroundColor Green
             Write-Host "Verifying required skeleton exports..." -ForegroundColor Yellow
-            $null = node ./tools/scripts/verify-skeleton-exports.js ./public/wasm/game.wasm | Write-Host
+            $null = node ./tools/scripts/verify-skeleton-exports.js ./public/wasm/$output | Write-Host
             if ($LASTEXITCODE -ne 0) {
                 Write-Host "Error: Required skeleton exports missing." -ForegroundColor Red
                 return $false
             }
             return $true
         } else {
-            Write-Host "game.wasm build failed" -ForegroundColor Red
+            Write-Host "$output build failed" -ForegroundColor Red
             return $false
         }
     } catch {
@@ -183,9 +205,16 @@ switch ($BuildType) {
     'host' {
         $success = Build-HostWasm
     }
+    'perf' {
+        $success = Build-GameWasm -Mode "perf"
+    }
+    'classes' {
+        $success = (Build-GameWasm -Mode "prod" -Class "warden") -and (Build-GameWasm -Mode "prod" -Class "raider") -and (Build-GameWasm -Mode "prod" -Class "kensei")
+    }
     'all' {
         Write-Host "Building all WASM modules..." -ForegroundColor Cyan
-        $success = (Build-GameWasm -Mode "prod") -and (Build-HostWasm)
+        $success = (Build-GameWasm -Mode "prod") -and (Build-HostWasm) -and
+            (Build-GameWasm -Mode "prod" -Class "warden") -and (Build-GameWasm -Mode "prod" -Class "raider") -and (Build-GameWasm -Mode "prod" -Class "kensei")
     }
     default {
         $success = Build-GameWasm -Mode "prod"
@@ -214,6 +243,7 @@ if ($success) {
     Write-Host "  npm run wasm:build      - Build production game.wasm" -ForegroundColor White
     Write-Host "  npm run wasm:build:dev  - Build development game.wasm" -ForegroundColor White
     Write-Host "  npm run wasm:build:host - Build game-host.wasm" -ForegroundColor White
+    Write-Host "  npm run wasm:build:perf - Build game-perf.wasm for npm run perf:wasm" -ForegroundColor White
     Write-Host "  npm run wasm:build:all  - Build all WASM modules" -ForegroundColor White
 
     # Generate export manifest for CI/auditing
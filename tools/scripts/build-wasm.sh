@@ -1,6 +1,6 @@
 #!/bin/bash
 # Shell script to build WASM modules with proper environment setup
-# Usage: ./scripts/build-wasm.sh [dev|prod|host|all]
+# Usage: ./scripts/build-wasm.sh [dev|prod|host|classes|perf|all]
 
 BUILD_TYPE="${1:-prod}"
 
@@ -19,8 +19,16 @@ em++ --version | head -n1
 
 # Clean previous builds
 echo "Cleaning previous WASM builds..."
-rm -f *.wasm
-rm -f public/wasm/*.wasm
+if [ "$BUILD_TYPE" = "classes" ]; then
+    # Keep game.wasm; class modules are built alongside it
+    rm -f public/wasm/game_*.wasm
+elif [ "$BUILD_TYPE" = "perf" ]; then
+    # Keep the shipped modules; the perf module is a separate file
+    rm -f public/wasm/game-perf.wasm
+else
+    rm -f *.wasm
+    rm -f public/wasm/*.wasm
+fi
 
 # Generate balance header from data files
 echo "Generating balance data header..."
@@ -30,10 +38,28 @@ if ! node ./tools/scripts/generate-balance.cjs; then
 fi
 echo "Balance data generated"
 
+# Character class ids (see public/src/wasm/BuildConfig.h)
+class_id() {
+    case "$1" in
+        warden) echo 1 ;;
+        raider) echo 2 ;;
+        kensei) echo 3 ;;
+        *) echo "" ;;
+    esac
+}
+
 build_game_wasm() {
     local mode="$1"
+    # Optional class: game_<class>.wasm with one ability path and no debug getters
+    local class="${2:-}"
+    local output="game.wasm"
+    if [ -n "$class" ]; then
+        output="game_${class}.wasm"
+    elif [ "$mode" = "perf" ]; then
+        output="game-perf.wasm"
+    fi
     
-    echo "Building game.wasm in $mode mode..."
+    echo "Building $output in $mode mode..."
     
     if [ "$mode" = "dev" ]; then
         flags="-O1 -g -s ASSERTIONS=1"
@@ -41,23 +67,75 @@ build_game_wasm() {
     elif [ "$mode" = "prod-safe" ]; then
         flags="-O2"
         echo "Production build with safe optimization (O2)"
+    elif [ "$mode" = "perf" ]; then
+        # For tools/scripts/wasm-bench.js only: profile zones and counted operator new
+        flags="-O3 -DDOZEDENT_PROFILE=1 -DDOZEDENT_COUNT_ALLOCS=1"
+        echo "Perf build with profile zones and heap allocation counting"
     else
         flags="-O3"
         echo "Production build with maximum optimization"
     fi
     
+    # Opt-in SIMD pair pre-test and force-field cull (bit-identical to the scalar path)
+    if [ "${WASM_SIMD:-0}" = "1" ]; then
+        flags="$flags -msimd128 -DDOZEDENT_PHYSICS_SIMD=1"
+        echo "WASM SIMD128 physics kernels enabled"
+    fi
+    
+    # Opt-in deterministic trig tables (wolf AI/animation match across engines)
+    if [ "${WASM_FIXED_TRIG:-0}" = "1" ]; then
+        flags="$flags -DDOZEDENT_FIXED_TRIG=1"
+        echo "Fixed-point trig tables enabled"
+    fi
+    
+    # Opt-in profile zones (get_profile_ptr ring for the overlay and telemetry)
+    if [ "${WASM_PROFILE:-0}" = "1" ]; then
+        flags="$flags -DDOZEDENT_PROFILE=1"
+        echo "Frame profile zones enabled"
+    fi
+    
+    # Opt-in physics worker thread (needs a pthread-capable, cross-origin isolated host)
+    if [ "${WASM_THREADS:-0}" = "1" ]; then
+        flags="$flags -pthread -DDOZEDENT_PHYSICS_THREADS=1"
+        echo "Physics worker thread enabled"
+    fi
+    
+    if [ -n "$class" ]; then
+        flags="$flags -DDOZEDENT_CLASS=$(class_id "$class") -DDOZEDENT_DEBUG_EXPORTS=0"
+        echo "Class module: $class"
+    fi
+    
+    # Opt-out features for slim modules (compiled out, not just disabled)
+    if [ "${WASM_NO_ARMS:-0}" = "1" ]; then
+        flags="$flags -DDOZEDENT_ARMS=0"
+        echo "Arm IK compiled out"
+    fi
+    if [ "${WASM_NO_SKELETON:-0}" = "1" ]; then
+        flags="$flags -DDOZEDENT_SKELETON=0"
+        echo "Skeleton physics compiled out"
+    fi
+    
     # Collect all C++ source files
-    SOURCE_FILES="public/src/wasm/game_refactored.cpp public/src/wasm/GameGlobals.cpp public/src/wasm/managers/CombatManager.cpp public/src/wasm/managers/GameStateManager.cpp public/src/wasm/managers/InputManager.cpp public/src/wasm/managers/PlayerManager.cpp public/src/wasm/managers/WolfManager.cpp public/src/wasm/managers/wolves/StateMachine.cpp public/src/wasm/managers/ArmManager.cpp public/src/wasm/coordinators/GameCoordinator.cpp public/src/wasm/physics/PhysicsManager.cpp public/src/wasm/progression/AbilityUpgradeSystem.cpp public/src/wasm/progression/UpgradeTree.cpp public/src/entities/PhysicsBarrel.cpp"
+    SOURCE_FILES="public/src/wasm/game_refactored.cpp public/src/wasm/GameGlobals.cpp public/src/wasm/AllocCounter.cpp public/src/wasm/managers/CombatManager.cpp public/src/wasm/managers/GameStateManager.cpp public/src/wasm/managers/InputManager.cpp public/src/wasm/managers/PlayerManager.cpp public/src/wasm/managers/WolfManager.cpp public/src/wasm/managers/wolves/StateMachine.cpp public/src/wasm/managers/ArmManager.cpp public/src/wasm/managers/WorldManager.cpp public/src/wasm/coordinators/GameCoordinator.cpp public/src/wasm/coordinators/SimInstance.cpp public/src/wasm/coordinators/InputLog.cpp public/src/wasm/physics/PhysicsManager.cpp public/src/wasm/physics/PhysicsWorker.cpp public/src/wasm/progression/AbilityUpgradeSystem.cpp public/src/wasm/progression/UpgradeTree.cpp public/src/entities/PhysicsBarrel.cpp"
+    
+    exports='"_spawn_barrel","_throw_barrel","_get_barrel_count","_get_barrel_x","_get_barrel_y","_get_barrel_vel_x","_get_barrel_vel_y","_clear_all_barrels","_get_physics_player_x","_get_physics_player_y","_get_physics_player_vel_x","_get_physics_player_vel_y","_get_physics_perf_ms","_physics_get_event_count","_physics_get_events_ptr","_physics_clear_events","_set_body_collision_filter","_get_collision_pairs_checked","_get_collisions_resolved","_init_run","_start","_update","_set_player_input","_get_skeleton_joint_count","_get_skeleton_joint_x","_get_skeleton_joint_y","_get_balance_quality","_get_left_foot_grounded","_get_right_foot_grounded","_write_skeleton_joints_xy","_get_wolf_health","_get_wolf_state","_get_wolf_emotion","_get_wolf_x","_get_wolf_y","_get_pack_count","_get_pack_plan","_get_pack_morale","_get_terrain_feature_count","_get_terrain_feature_x","_get_terrain_feature_y","_get_terrain_feature_type","_get_wolf_aggression","_get_wolf_morale","_get_wolf_stamina","_get_wolf_pack_id","_get_wolf_pack_role","_get_wolf_limp_severity","_get_wolf_facing_x","_get_wolf_facing_y","_get_pack_wolf_count","_get_pack_leader_index","_get_wolf_body_stretch","_get_wolf_head_yaw","_get_wolf_tail_wag","_get_wolf_attack_success_rate","_get_pack_coordination_bonus","_get_player_skill_estimate","_get_wolf_message_count","_get_wolf_last_message_type","_get_wolf_leg_x","_get_wolf_leg_y","_get_wolf_body_bob","_get_wolf_head_pitch","_get_wolf_ear_rotation"'
+    if [ -n "$class" ]; then
+        # Debug getters are compiled out of class modules
+        exports=$(echo "$exports" | sed -e 's/"_get_physics_perf_ms",//' -e 's/"_get_collision_pairs_checked",//' -e 's/"_get_collisions_resolved",//')
+    fi
     
-    cmd="em++ $SOURCE_FILES $flags -Ipublic/src/wasm -Ipublic/src/wasm/managers -Ipublic/src/wasm/coordinators -Ipublic/src/wasm/physics -Ipublic/src/wasm/progression -Ipublic/src/entities -s STANDALONE_WASM=1 -s WASM_BIGINT=1 -s ALLOW_MEMORY_GROWTH=1 -s EXPORTED_FUNCTIONS=\"[\"_spawn_barrel\",\"_throw_barrel\",\"_get_barrel_count\",\"_get_barrel_x\",\"_get_barrel_y\",\"_get_barrel_vel_x\",\"_get_barrel_vel_y\",\"_clear_all_barrels\",\"_get_physics_player_x\",\"_get_physics_player_y\",\"_get_physics_player_vel_x\",\"_get_physics_player_vel_y\",\"_get_physics_perf_ms\",\"_physics_get_event_count\",\"_physics_get_events_ptr\",\"_physics_clear_events\",\"_set_body_collision_filter\",\"_get_collision_pairs_checked\",\"_get_collisions_resolved\",\"_init_run\",\"_start\",\"_update\",\"_set_player_input\",\"_get_skeleton_joint_count\",\"_get_skeleton_joint_x\",\"_get_skeleton_joint_y\",\"_get_balance_quality\",\"_get_left_foot_grounded\",\"_get_right_foot_grounded\",\"_write_skeleton_joints_xy\",\"_get_wolf_health\",\"_get_wolf_state\",\"_get_wolf_emotion\",\"_get_wolf_x\",\"_get_wolf_y\",\"_get_pack_count\",\"_get_pack_plan\",\"_get_pack_morale\",\"_get_terrain_feature_count\",\"_get_terrain_feature_x\",\"_get_terrain_feature_y\",\"_get_terrain_feature_type\",\"_get_wolf_aggression\",\"_get_wolf_morale\",\"_get_wolf_stamina\",\"_get_wolf_pack_id\",\"_get_wolf_pack_role\",\"_get_wolf_limp_severity\",\"_get_wolf_facing_x\",\"_get_wolf_facing_y\",\"_get_pack_wolf_count\",\"_get_pack_leader_index\",\"_get_wolf_body_stretch\",\"_get_wolf_head_yaw\",\"_get_wolf_tail_wag\",\"_get_wolf_attack_success_rate\",\"_get_pack_coordination_bonus\",\"_get_player_skill_estimate\",\"_get_wolf_message_count\",\"_get_wolf_last_message_type\",\"_get_wolf_leg_x\",\"_get_wolf_leg_y\",\"_get_wolf_body_bob\",\"_get_wolf_head_pitch\",\"_get_wolf_ear_rotation\"]\" -o ./public/wasm/game.wasm"
+    cmd="em++ $SOURCE_FILES $flags -Ipublic/src/wasm -Ipublic/src/wasm/managers -Ipublic/src/wasm/coordinators -Ipublic/src/wasm/physics -Ipublic/src/wasm/progression -Ipublic/src/entities -s STANDALONE_WASM=1 -s WASM_BIGINT=1 -s ALLOW_MEMORY_GROWTH=1 -s EXPORTED_FUNCTIONS=\"[$exports]\" -o ./public/wasm/$output"
     echo "Command: $cmd"
     
     if eval "$cmd"; then
-        size=$(stat -c%s "public/wasm/game.wasm" 2>/dev/null || stat -f%z "public/wasm/game.wasm" 2>/dev/null)
+        size=$(stat -c%s "public/wasm/$output" 2>/dev/null || stat -f%z "public/wasm/$output" 2>/dev/null)
         size_kb=$((size / 1024))
-        echo "game.wasm built successfully (${size_kb} KB)"
+        echo "$output built successfully (${size_kb} KB)"
+        if [ "${WASM_NO_SKELETON:-0}" = "1" ]; then
+            return 0
+        fi
         echo "Verifying required skeleton exports..."
-        if node ./tools/scripts/verify-skeleton-exports.js ./public/wasm/game.wasm; then
+        if node ./tools/scripts/verify-skeleton-exports.js ./public/wasm/$output; then
             echo "Skeleton exports verified."
         else
             echo "Error: Required skeleton exports missing."
@@ -65,7 +143,7 @@ build_game_wasm() {
         fi
         return 0
     else
-        echo "game.wasm build failed"
+        echo "$output build failed"
         return 1
     fi
 }
@@ -73,7 +151,7 @@ build_game_wasm() {
 build_host_wasm() {
     echo "Building game-host.wasm..."
     
-    cmd='em++ public/src/wasm/game-host.cpp -O3 -s STANDALONE_WASM=1 -s EXPORTED_FUNCTIONS="[\"_game_init\",\"_game_create_state\",\"_game_update\",\"_game_handle_input\",\"_game_get_state\",\"_game_get_state_size\",\"_game_apply_state\",\"_game_destroy\",\"_malloc\",\"_free\"]" -s EXPORTED_RUNTIME_METHODS="[\"ccall\",\"cwrap\"]" -s ALLOW_MEMORY_GROWTH=1 -s WASM_BIGINT=1 -o ./game-host.wasm'
+    cmd='em++ public/src/wasm/game-host.cpp -O3 -s STANDALONE_WASM=1 -s EXPORTED_FUNCTIONS="[\"_game_init\",\"_game_create_state\",\"_game_update\",\"_game_handle_input\",\"_game_get_state\",\"_game_get_state_size\",\"_game_apply_state\",\"_game_handle_input_binary\",\"_game_get_state_binary\",\"_game_get_state_binary_size\",\"_game_apply_state_binary\",\"_game_get_state_for\",\"_game_set_interest\",\"_game_destroy\",\"_malloc\",\"_free\"]" -s EXPORTED_RUNTIME_METHODS="[\"ccall\",\"cwrap\"]" -s ALLOW_MEMORY_GROWTH=1 -s WASM_BIGINT=1 -o ./game-host.wasm'
     echo "Command: $cmd"
     
     if eval "$cmd"; then
@@ -109,6 +187,18 @@ case "$BUILD_TYPE" in
             exit 1
         fi
         ;;
+    perf)
+        if ! build_game_wasm "perf"; then
+            exit 1
+        fi
+        ;;
+    classes)
+        for class in warden raider kensei; do
+            if ! build_game_wasm "prod" "$class"; then
+                exit 1
+            fi
+        done
+        ;;
     all)
         echo "Building all WASM modules..."
         if ! build_game_wasm "prod"; then
@@ -117,20 +207,28 @@ case "$BUILD_TYPE" in
         if ! build_host_wasm; then
             exit 1
         fi
+        for class in warden raider kensei; do
+            if ! build_game_wasm "prod" "$class"; then
+                exit 1
+            fi
+        done
         echo "All WASM modules built successfully"
         ;;
     *)
         echo "Invalid build type: $BUILD_TYPE"
-        echo "Usage: $0 [dev|prod|prod-safe|host|all]"
+        echo "Usage: $0 [dev|prod|prod-safe|host|classes|perf|all]"
         exit 1
         ;;
 esac
 
 # Copy WASM files to dist/wasm if they exist
-if [ -f "public/wasm/game.wasm" ] || [ -f "game-host.wasm" ]; then
+if [ -f "public/wasm/game.wasm" ] || [ -f "game-host.wasm" ] || ls public/wasm/game_*.wasm &> /dev/null; then
     echo "Copying WASM files to dist/wasm..."
     mkdir -p dist/wasm
     [ -f "public/wasm/game.wasm" ] && cp public/wasm/game.wasm dist/wasm/
+    for module in public/wasm/game_*.wasm; do
+        [ -f "$module" ] && cp "$module" dist/wasm/
+    done
     [ -f "game-host.wasm" ] && cp game-host.wasm dist/wasm/
     echo "WASM files copied to dist/wasm/"
 fi
@@ -392,6 +392,12 @@ class EnhancedBuildSystem {
       }
     };
 
+    // Native sim benchmark results, if dozedent_bench --json SIM_BENCH.json was run
+    const simBench = await this.readSimBench();
+    if (simBench) {
+      report.simBench = simBench;
+    }
+
     // Write JSON report
     const reportPath = path.join(projectRoot, 'BUILD_REPORT.json');
     await fs.writeFile(reportPath, JSON.stringify(report, null, 2));
@@ -407,6 +413,18 @@ class EnhancedBuildSystem {
     this.displayBuildSummary(report);
   }
 
+  /**
+   * Read SIM_BENCH.json written by public/bench/dozedent_bench (optional)
+   */
+  async readSimBench() {
+    try {
+      const benchPath = path.join(projectRoot, 'SIM_BENCH.json');
+      return JSON.parse(await fs.readFile(benchPath, 'utf8'));
+    } catch (error) {
+      return null;
+    }
+  }
+
   /**
    * Generate markdown report
    */
@@ -1,9 +1,21 @@
 // AUTO-GENERATED BALANCE GENERATOR SCRIPT (CJS)
-// Reads data/balance/*.json and emits src/wasm/generated/balance_data.h
+// Reads data/balance/*.json and emits:
+// - public/src/wasm/generated/balance_data.h: BalanceKey enum, layout hash and
+//   compiled-in defaults for the runtime table (public/src/wasm/BalanceTable.h)
+// - public/data/balance/balance.bin: the same values as a versioned binary blob
+//   that can be hot-loaded with load_balance_blob (no rebuild, no JSON at runtime)
 
 const fs = require('fs');
 const path = require('path');
 
+// Blob layout (little endian): u32 magic "DZBL", u16 format version, u16 count,
+// u32 layout hash, u32 revision, then count float32 values in BalanceKey order
+const BLOB_MAGIC = 0x4C425A44;
+const BLOB_VERSION = 1;
+const BLOB_HEADER_SIZE = 16;
+
+const entries = [];
+
 function readJson(file) {
   return JSON.parse(fs.readFileSync(file, 'utf8'));
 }
@@ -13,11 +25,71 @@ function ensureDir(dir) {
 }
 
 function define(name, value) {
-  if (typeof value === 'number') {
-    return `#define ${name} ${value}\n`;
+  if (typeof value !== 'number' || !Number.isFinite(value)) {
+    throw new Error(`${name}: expected a number, got ${JSON.stringify(value)}`);
   }
-  if (typeof value === 'string') return `#define ${name} ${value}\n`;
-  return `// ${name} unsupported type\n`;
+  entries.push({ name, value });
+}
+
+function fnv1a(bytes, hash = 0x811c9dc5) {
+  for (const b of bytes) {
+    hash ^= b;
+    hash = Math.imul(hash, 0x01000193) >>> 0;
+  }
+  return hash >>> 0;
+}
+
+function hex32(v) {
+  return `0x${v.toString(16).toUpperCase().padStart(8, '0')}u`;
+}
+
+// Shortest decimal that parses back to the same float32
+function floatLiteral(value) {
+  const f = Math.fround(value);
+  for (let p = 1; p <= 9; p++) {
+    const text = Number(f.toPrecision(p)).toString();
+    if (Math.fround(Number(text)) === f) {
+      return /[.e]/.test(text) ? `${text}f` : `${text}.0f`;
+    }
+  }
+  return `${f.toPrecision(9)}f`;
+}
+
+function layoutHash() {
+  return fnv1a(Buffer.from(entries.map(e => e.name).join('\0'), 'utf8'));
+}
+
+function buildBlob() {
+  const values = Buffer.alloc(entries.length * 4);
+  entries.forEach((e, i) => values.writeFloatLE(e.value, i * 4));
+  const header = Buffer.alloc(BLOB_HEADER_SIZE);
+  header.writeUInt32LE(BLOB_MAGIC, 0);
+  header.writeUInt16LE(BLOB_VERSION, 4);
+  header.writeUInt16LE(entries.length, 6);
+  header.writeUInt32LE(layoutHash(), 8);
+  header.writeUInt32LE(fnv1a(values), 12);
+  return Buffer.concat([header, values]);
+}
+
+function emitHeader(blob) {
+  let out = '';
+  out += '// AUTO-GENERATED FILE. DO NOT EDIT.\n';
+  out += '// Generated by tools/scripts/generate-balance.cjs from data/balance/*.json\n\n';
+  out += '#pragma once\n\n';
+  out += '#include <cstdint>\n\n';
+  out += '// Keys into the runtime balance table; read with bal(BAL_*) (see BalanceTable.h)\n';
+  out += 'enum BalanceKey : uint16_t {\n';
+  for (const e of entries) {out += `    ${e.name},\n`;}
+  out += '    BAL_KEY_COUNT\n';
+  out += '};\n\n';
+  out += '// Blobs are accepted only when their key layout matches this build\n';
+  out += `constexpr uint32_t BALANCE_LAYOUT_HASH = ${hex32(layoutHash())};\n`;
+  out += `constexpr uint32_t BALANCE_DEFAULT_REVISION = ${hex32(blob.readUInt32LE(12))};\n\n`;
+  out += '// Compiled-in defaults, identical to public/data/balance/balance.bin\n';
+  out += 'constexpr float BALANCE_DEFAULTS[BAL_KEY_COUNT] = {\n';
+  for (const e of entries) {out += `    ${floatLiteral(e.value)}, // ${e.name}\n`;}
+  out += '};\n';
+  return out;
 }
 
 function main() {
@@ -28,134 +100,134 @@ function main() {
   const player = readJson(playerPath);
   const enemies = readJson(enemiesPath);
 
-  let out = '';
-  out += '// AUTO-GENERATED FILE. DO NOT EDIT.\n';
-  out += '// Generated by scripts/generate-balance.cjs from data/balance/*.json\n\n';
-  out += '#pragma once\n\n';
-
   // Player
   const p = player.player;
-  out += define('BAL_BASE_SPEED', p.baseSpeed);
-  out += define('BAL_ROLL_SPEED_MULTIPLIER', p.rollSpeedMultiplier);
-  out += define('BAL_PLAYER_ACCEL', p.acceleration);
-  out += define('BAL_PLAYER_FRICTION', p.friction);
-  out += define('BAL_JUMP_POWER', p.jumpPower);
-  out += define('BAL_GRAVITY', p.gravity);
-  out += define('BAL_MAX_JUMPS', p.maxJumps);
-  out += define('BAL_PLAYER_RADIUS', p.radius);
+  define('BAL_BASE_SPEED', p.baseSpeed);
+  define('BAL_ROLL_SPEED_MULTIPLIER', p.rollSpeedMultiplier);
+  define('BAL_PLAYER_ACCEL', p.acceleration);
+  define('BAL_PLAYER_FRICTION', p.friction);
+  define('BAL_JUMP_POWER', p.jumpPower);
+  define('BAL_GRAVITY', p.gravity);
+  define('BAL_MAX_JUMPS', p.maxJumps);
+  define('BAL_PLAYER_RADIUS', p.radius);
 
   const st = player.stamina;
-  out += define('BAL_STAMINA_REGEN_PER_SEC', st.regenPerSec);
-  out += define('BAL_STAMINA_BLOCK_DRAIN_PER_SEC', st.blockDrainPerSec);
-  out += define('BAL_STAMINA_ROLL_DRAIN_PER_SEC', st.rollDrainPerSec);
-  out += define('BAL_STAMINA_ROLL_START_COST', st.rollStartCost);
-  out += define('BAL_STAMINA_BLOCK_START_COST', st.blockStartCost);
-  out += define('BAL_STAMINA_ATTACK_COST', st.attackCost);
+  define('BAL_STAMINA_REGEN_PER_SEC', st.regenPerSec);
+  define('BAL_STAMINA_BLOCK_DRAIN_PER_SEC', st.blockDrainPerSec);
+  define('BAL_STAMINA_ROLL_DRAIN_PER_SEC', st.rollDrainPerSec);
+  define('BAL_STAMINA_ROLL_START_COST', st.rollStartCost);
+  define('BAL_STAMINA_BLOCK_START_COST', st.blockStartCost);
+  define('BAL_STAMINA_ATTACK_COST', st.attackCost);
 
   const t = player.timing;
-  out += define('BAL_INPUT_BUFFER_TIME', t.inputBufferTime);
-  out += define('BAL_PARRY_WINDOW', t.parryWindow);
-  out += define('BAL_PARRY_STUN_DURATION', t.parryStunDuration);
-  out += define('BAL_ROLL_IFRAME_DURATION', t.rollIFrameDuration);
-  out += define('BAL_ATTACK_COOLDOWN_SEC', t.attackCooldown);
-  out += define('BAL_ROLL_DURATION_SEC', t.rollDuration);
-  out += define('BAL_ROLL_COOLDOWN_SEC', t.rollCooldown);
+  define('BAL_INPUT_BUFFER_TIME', t.inputBufferTime);
+  define('BAL_PARRY_WINDOW', t.parryWindow);
+  define('BAL_PARRY_STUN_DURATION', t.parryStunDuration);
+  define('BAL_ROLL_IFRAME_DURATION', t.rollIFrameDuration);
+  define('BAL_ATTACK_COOLDOWN_SEC', t.attackCooldown);
+  define('BAL_ROLL_DURATION_SEC', t.rollDuration);
+  define('BAL_ROLL_COOLDOWN_SEC', t.rollCooldown);
 
   const c = player.combat;
-  out += define('BAL_ATTACK_RANGE', c.attackRange);
-  out += define('BAL_BACK_ATTACK_COS_THRESHOLD', c.backAttackCosThreshold);
-  out += define('BAL_BLOCK_FACING_COS_THRESHOLD', c.blockFacingCosThreshold);
-  out += define('BAL_ATTACK_ARC_COS_THRESHOLD', c.attackArcCosThreshold);
-  out += define('BAL_ATTACK_DAMAGE', c.attackDamage);
-  out += define('BAL_ATTACK_STUN_SEC', c.attackStunSec);
-  out += define('BAL_ATTACK_KNOCKBACK', c.attackKnockback);
+  define('BAL_ATTACK_RANGE', c.attackRange);
+  define('BAL_BACK_ATTACK_COS_THRESHOLD', c.backAttackCosThreshold);
+  define('BAL_BLOCK_FACING_COS_THRESHOLD', c.blockFacingCosThreshold);
+  define('BAL_ATTACK_ARC_COS_THRESHOLD', c.attackArcCosThreshold);
+  define('BAL_ATTACK_DAMAGE', c.attackDamage);
+  define('BAL_ATTACK_STUN_SEC', c.attackStunSec);
+  define('BAL_ATTACK_KNOCKBACK', c.attackKnockback);
 
   const la = player.lightAttack;
-  out += define('BAL_LIGHT_WINDUP_SEC', la.windup);
-  out += define('BAL_LIGHT_ACTIVE_SEC', la.active);
-  out += define('BAL_LIGHT_RECOVERY_SEC', la.recovery);
-  out += define('BAL_LIGHT_DAMAGE', la.damage);
+  define('BAL_LIGHT_WINDUP_SEC', la.windup);
+  define('BAL_LIGHT_ACTIVE_SEC', la.active);
+  define('BAL_LIGHT_RECOVERY_SEC', la.recovery);
+  define('BAL_LIGHT_DAMAGE', la.damage);
 
   const ha = player.heavyAttack;
-  out += define('BAL_HEAVY_WINDUP_SEC', ha.windup);
-  out += define('BAL_HEAVY_ACTIVE_SEC', ha.active);
-  out += define('BAL_HEAVY_RECOVERY_SEC', ha.recovery);
-  out += define('BAL_HEAVY_DAMAGE', ha.damage);
+  define('BAL_HEAVY_WINDUP_SEC', ha.windup);
+  define('BAL_HEAVY_ACTIVE_SEC', ha.active);
+  define('BAL_HEAVY_RECOVERY_SEC', ha.recovery);
+  define('BAL_HEAVY_DAMAGE', ha.damage);
 
   const sa = player.specialAttack;
-  out += define('BAL_SPECIAL_WINDUP_SEC', sa.windup);
-  out += define('BAL_SPECIAL_ACTIVE_SEC', sa.active);
-  out += define('BAL_SPECIAL_RECOVERY_SEC', sa.recovery);
-  out += define('BAL_SPECIAL_DAMAGE', sa.damage);
+  define('BAL_SPECIAL_WINDUP_SEC', sa.windup);
+  define('BAL_SPECIAL_ACTIVE_SEC', sa.active);
+  define('BAL_SPECIAL_RECOVERY_SEC', sa.recovery);
+  define('BAL_SPECIAL_DAMAGE', sa.damage);
 
   const roll = player.roll;
-  out += define('BAL_ROLL_SLIDE_DURATION', roll.slideDuration);
-  out += define('BAL_ROLL_SLIDE_FRICTION', roll.slideFriction);
+  define('BAL_ROLL_SLIDE_DURATION', roll.slideDuration);
+  define('BAL_ROLL_SLIDE_FRICTION', roll.slideFriction);
 
   const world = player.world;
-  out += define('BAL_WALL_CENTER_X', world.wallCenterX);
-  out += define('BAL_WALL_HALF_WIDTH', world.wallHalfWidth);
+  define('BAL_WALL_CENTER_X', world.wallCenterX);
+  define('BAL_WALL_HALF_WIDTH', world.wallHalfWidth);
 
   // Enemies
   const e = enemies.enemy;
-  out += define('BAL_ENEMY_BASE_SPEED', e.baseSpeed);
-  out += define('BAL_ENEMY_CIRCLE_RADIUS', e.circleRadius);
-  out += define('BAL_ENEMY_SEEK_RANGE', e.seekRange);
-  out += define('BAL_ENEMY_HARASS_RANGE', e.harassRange);
-  out += define('BAL_ENEMY_ACCEL', e.accel);
-  out += define('BAL_ENEMY_FRICTION', e.friction);
-  out += define('BAL_ENEMY_MAX_SPEED', e.maxSpeed);
-  out += define('BAL_ENEMY_LUNGE_RANGE', e.lungeRange);
-  out += define('BAL_ENEMY_LUNGE_SPEED', e.lungeSpeed);
-  out += define('BAL_ENEMY_LUNGE_DURATION', e.lungeDuration);
-  out += define('BAL_ENEMY_LUNGE_COOLDOWN', e.lungeCooldown);
-  out += define('BAL_ENEMY_FEINT_PROB', e.feintProb);
-  out += define('BAL_ENEMY_FEINT_DURATION', e.feintDuration);
-  out += define('BAL_ENEMY_MIN_CHASE_BEFORE_LUNGE', e.minChaseBeforeLunge);
-  out += define('BAL_LATCH_DURATION', e.latchDuration);
-  out += define('BAL_LATCH_DRAG_SPEED', e.latchDragSpeed);
-  out += define('BAL_PREY_CONE_COS', e.preyConeCos);
-  out += define('BAL_PREY_CONE_WEIGHT', e.preyConeWeight);
-  out += define('BAL_FATIGUE_LUNGE_BONUS', e.fatigueLungeBonus);
-  out += define('BAL_FATIGUE_PER_SPEED', e.fatiguePerSpeed);
-  out += define('BAL_FATIGUE_RECOVERY_PER_SEC', e.fatigueRecoveryPerSec);
-  out += define('BAL_COMM_RANGE', e.commRange);
+  define('BAL_ENEMY_BASE_SPEED', e.baseSpeed);
+  define('BAL_ENEMY_CIRCLE_RADIUS', e.circleRadius);
+  define('BAL_ENEMY_SEEK_RANGE', e.seekRange);
+  define('BAL_ENEMY_HARASS_RANGE', e.harassRange);
+  define('BAL_ENEMY_ACCEL', e.accel);
+  define('BAL_ENEMY_FRICTION', e.friction);
+  define('BAL_ENEMY_MAX_SPEED', e.maxSpeed);
+  define('BAL_ENEMY_LUNGE_RANGE', e.lungeRange);
+  define('BAL_ENEMY_LUNGE_SPEED', e.lungeSpeed);
+  define('BAL_ENEMY_LUNGE_DURATION', e.lungeDuration);
+  define('BAL_ENEMY_LUNGE_COOLDOWN', e.lungeCooldown);
+  define('BAL_ENEMY_FEINT_PROB', e.feintProb);
+  define('BAL_ENEMY_FEINT_DURATION', e.feintDuration);
+  define('BAL_ENEMY_MIN_CHASE_BEFORE_LUNGE', e.minChaseBeforeLunge);
+  define('BAL_LATCH_DURATION', e.latchDuration);
+  define('BAL_LATCH_DRAG_SPEED', e.latchDragSpeed);
+  define('BAL_PREY_CONE_COS', e.preyConeCos);
+  define('BAL_PREY_CONE_WEIGHT', e.preyConeWeight);
+  define('BAL_FATIGUE_LUNGE_BONUS', e.fatigueLungeBonus);
+  define('BAL_FATIGUE_PER_SPEED', e.fatiguePerSpeed);
+  define('BAL_FATIGUE_RECOVERY_PER_SEC', e.fatigueRecoveryPerSec);
+  define('BAL_COMM_RANGE', e.commRange);
 
   const rad = enemies.radii;
-  out += define('BAL_ENEMY_RADIUS', rad.enemyRadius);
+  define('BAL_ENEMY_RADIUS', rad.enemyRadius);
 
   const pack = enemies.pack;
-  out += define('BAL_MAX_WOLF_PACKS', pack.maxPacks);
-  out += define('BAL_PACK_RESPAWN_DELAY', pack.respawnDelay);
+  define('BAL_MAX_WOLF_PACKS', pack.maxPacks);
+  define('BAL_PACK_RESPAWN_DELAY', pack.respawnDelay);
 
   const sp = enemies.spawn;
-  out += define('BAL_MIN_SPAWN_DISTANCE', sp.minSpawnDistance);
-  out += define('BAL_MAX_SPAWN_DISTANCE', sp.maxSpawnDistance);
-  out += define('BAL_HOWL_MAX_SPAWN_DISTANCE', sp.howlMaxSpawnDistance);
-  out += define('BAL_SPAWN_SPREAD', sp.spread);
-  out += define('BAL_SPAWN_MARGIN', sp.spawnMargin);
+  define('BAL_MIN_SPAWN_DISTANCE', sp.minSpawnDistance);
+  define('BAL_MAX_SPAWN_DISTANCE', sp.maxSpawnDistance);
+  define('BAL_HOWL_MAX_SPAWN_DISTANCE', sp.howlMaxSpawnDistance);
+  define('BAL_SPAWN_SPREAD', sp.spread);
+  define('BAL_SPAWN_MARGIN', sp.spawnMargin);
 
   // Wolf-specific tunables
   const w = enemies.wolf;
-  out += define('BAL_WOLF_ATTACK_ENTER_MULT', w.attackEnterMult);
-  out += define('BAL_WOLF_ATTACK_EXIT_MULT', w.attackExitMult);
-  out += define('BAL_WOLF_APPROACH_ENTER_MULT', w.approachEnterMult);
-  out += define('BAL_WOLF_APPROACH_EXIT_MULT', w.approachExitMult);
-  out += define('BAL_WOLF_ATTACK_FACING_COS', w.attackFacingCosThreshold);
-  out += define('BAL_WOLF_MAX_CONCURRENT_ATTACKERS', w.maxConcurrentAttackers);
-  out += define('BAL_WOLF_DAMAGE_INTERRUPT_THRESHOLD', w.damageInterruptThreshold);
+  define('BAL_WOLF_ATTACK_ENTER_MULT', w.attackEnterMult);
+  define('BAL_WOLF_ATTACK_EXIT_MULT', w.attackExitMult);
+  define('BAL_WOLF_APPROACH_ENTER_MULT', w.approachEnterMult);
+  define('BAL_WOLF_APPROACH_EXIT_MULT', w.approachExitMult);
+  define('BAL_WOLF_ATTACK_FACING_COS', w.attackFacingCosThreshold);
+  define('BAL_WOLF_MAX_CONCURRENT_ATTACKERS', w.maxConcurrentAttackers);
+  define('BAL_WOLF_DAMAGE_INTERRUPT_THRESHOLD', w.damageInterruptThreshold);
   const wd = w.durations;
-  out += define('BAL_WOLF_CONFIDENT_RECOVER_MULT', wd.confidentRecoverMult);
-  out += define('BAL_WOLF_FEARFUL_STRAFE_MULT', wd.fearfulStrafeMult);
-  out += define('BAL_WOLF_DESPERATE_ATTACK_MULT', wd.desperateAttackMult);
+  define('BAL_WOLF_CONFIDENT_RECOVER_MULT', wd.confidentRecoverMult);
+  define('BAL_WOLF_FEARFUL_STRAFE_MULT', wd.fearfulStrafeMult);
+  define('BAL_WOLF_DESPERATE_ATTACK_MULT', wd.desperateAttackMult);
 
+  const blob = buildBlob();
   const outDir = path.join(root, 'public', 'src', 'wasm', 'generated');
   ensureDir(outDir);
   const outFile = path.join(outDir, 'balance_data.h');
-  fs.writeFileSync(outFile, out, 'utf8');
+  fs.writeFileSync(outFile, emitHeader(blob), 'utf8');
   console.log(`Generated ${path.relative(root, outFile)}`);
+
+  const blobDir = path.join(root, 'public', 'data', 'balance');
+  ensureDir(blobDir);
+  const blobFile = path.join(blobDir, 'balance.bin');
+  fs.writeFileSync(blobFile, blob);
+  console.log(`Generated ${path.relative(root, blobFile)} (${blob.length} bytes, revision ${hex32(blob.readUInt32LE(12))})`);
 }
 
 main();
-
-
@@ -0,0 +1,252 @@
+#!/usr/bin/env node
+/**
+ * perf-regression - run the fixed-seed sim scenarios and enforce baselines
+ *
+ * Runs public/bench/dozedent_bench (native) and/or tools/scripts/wasm-bench.js
+ * (game-perf.wasm), then checks every scenario against public/bench/baselines.json:
+ *
+ * - thresholds: per metric, current may not exceed baseline * ratio + above.
+ *   Counters (allocations, pairs, events per tick) are deterministic for a
+ *   given tree and get tight limits; tick times are noisy and get loose ones.
+ * - slo: per target, absolute limits every scenario must meet whatever its
+ *   baseline says.
+ *
+ * Exits 1 when any check fails, 2 on usage or setup errors.
+ *
+ *   node tools/scripts/perf-regression.js [--target native|wasm|all] [--bench FILE] [--wasm FILE]
+ *       [--baseline FILE] [--ticks N] [--scenario NAME] [--skip-timing] [--report FILE] [--update-baseline]
+ *
+ * --skip-timing checks counters only (for machines unlike the one that
+ * recorded the baseline). --update-baseline rewrites the target sections
+ * from this run and keeps thresholds and SLOs.
+ */
+
+import { existsSync, readFileSync, writeFileSync, mkdtempSync, rmSync } from 'node:fs';
+import { join, resolve } from 'node:path';
+import { tmpdir } from 'node:os';
+import { spawnSync } from 'node:child_process';
+import { fileURLToPath } from 'node:url';
+import { runWasmBench } from './wasm-bench.js';
+
+const DEFAULT_BASELINE = 'public/bench/baselines.json';
+const DEFAULT_BENCH = process.env.DOZEDENT_BENCH || 'build/dozedent_bench';
+const DEFAULT_WASM = 'public/wasm/game-perf.wasm';
+
+// Metrics a baseline records per scenario
+export const BASELINE_METRICS = ['tickNs.p50', 'tickNs.p99', 'allocsPerTick', 'pairsPerTick', 'eventsPerTick'];
+
+export function readMetric(scenario, metric) {
+  const value = metric.split('.').reduce((node, key) => (node == null ? undefined : node[key]), scenario);
+  return typeof value === 'number' ? value : null;
+}
+
+function setMetric(scenario, metric, value) {
+  const keys = metric.split('.');
+  let node = scenario;
+  for (const key of keys.slice(0, -1)) {
+    node[key] ??= {};
+    node = node[key];
+  }
+  node[keys[keys.length - 1]] = value;
+}
+
+/**
+ * Check one target's bench report against its baseline section
+ * @returns {{checks: Array<object>, failed: number}} One check per metric per
+ *   scenario: status 'pass', 'fail' or 'skip' (no baseline or not measured)
+ */
+export function compareToBaseline(report, baseline, { skipTiming = false } = {}) {
+  const target = baseline.targets?.[report.target] ?? {};
+  const thresholds = baseline.thresholds ?? {};
+  const slo = target.slo ?? {};
+  const results = new Map(report.scenarios.map((s) => [s.name, s]));
+  const skipped = new Map((report.skipped ?? []).map((s) => [s.name, s]));
+  const checks = [];
+
+  for (const [name, expected] of Object.entries(target.scenarios ?? {})) {
+    const current = results.get(name);
+    if (!current) {
+      // A module built without a scenario's exports cannot run it; a missing native scenario is a failure
+      const skip = skipped.get(name);
+      checks.push({
+        scenario: name, metric: '-', status: skip ? 'skip' : 'fail',
+        note: skip ? `module lacks ${skip.missing.join(', ')}` : 'scenario did not run'
+      });
+      continue;
+    }
+    for (const metric of BASELINE_METRICS) {
+      const rule = thresholds[metric];
+      if (!rule) continue;
+      const value = readMetric(current, metric);
+      const base = readMetric(expected, metric);
+      if (rule.timing && skipTiming) continue;
+      if (value === null || base === null) {
+        checks.push({ scenario: name, metric, value, base, status: 'skip', note: value === null ? 'not measured' : 'no baseline' });
+        continue;
+      }
+      const limit = base * (rule.ratio ?? 1) + (rule.above ?? 0);
+      checks.push({ scenario: name, metric, value, base, limit, status: value <= limit ? 'pass' : 'fail' });
+    }
+  }
+
+  for (const current of report.scenarios) {
+    if (!target.scenarios?.[current.name]) {
+      checks.push({ scenario: current.name, metric: '-', status: 'skip', note: 'no baseline' });
+    }
+    for (const [metric, limit] of Object.entries(slo)) {
+      if (thresholds[metric]?.timing && skipTiming) continue;
+      const value = readMetric(current, metric);
+      if (value === null) continue;
+      checks.push({ scenario: current.name, metric, value, limit, slo: true, status: value <= limit ? 'pass' : 'fail' });
+    }
+  }
+
+  return { checks, failed: checks.filter((c) => c.status === 'fail').length };
+}
+
+// Baseline section for a target from a bench report
+export function baselineFromReport(report) {
+  const scenarios = {};
+  for (const current of report.scenarios) {
+    const entry = {};
+    for (const metric of BASELINE_METRICS) {
+      const value = readMetric(current, metric);
+      if (value !== null) setMetric(entry, metric, value);
+    }
+    scenarios[current.name] = entry;
+  }
+  return scenarios;
+}
+
+function runNative(benchPath, ticks, only) {
+  if (!existsSync(benchPath)) {
+    throw new Error(`no bench binary at ${benchPath}; build it with\n` +
+      '  cmake -S public -B build -DDOZEDENT_BUILD_BENCH=ON -DCMAKE_BUILD_TYPE=Release\n' +
+      '  cmake --build build --target dozedent_bench\nor pass --bench FILE');
+  }
+  const dir = mkdtempSync(join(tmpdir(), 'dozedent-bench-'));
+  try {
+    const jsonPath = join(dir, 'bench.json');
+    const args = ['--ticks', String(ticks), '--json', jsonPath];
+    if (only) args.push('--scenario', only);
+    const proc = spawnSync(benchPath, args, { stdio: 'inherit' });
+    if (proc.error || proc.status !== 0) {
+      throw new Error(`${benchPath} failed: ${proc.error?.message ?? `exit ${proc.status}`}`);
+    }
+    return JSON.parse(readFileSync(jsonPath, 'utf8'));
+  } finally {
+    rmSync(dir, { recursive: true, force: true });
+  }
+}
+
+function printChecks(target, { checks, failed }) {
+  const format = (v) => (v == null ? '-' : Number.isInteger(v) ? String(v) : v.toFixed(2));
+  console.log(`\n[perf-regression] ${target}`);
+  for (const c of checks) {
+    if (c.status === 'pass') continue;
+    const detail = c.limit !== undefined
+      ? `${format(c.value)} ${c.status === 'pass' ? '<=' : '>'} ${format(c.limit)}${c.slo ? ' (SLO)' : ` (baseline ${format(c.base)})`}`
+      : c.note;
+    console.log(`  ${c.status.toUpperCase().padEnd(4)} ${c.scenario.padEnd(13)} ${c.metric.padEnd(14)} ${detail}`);
+  }
+  const passed = checks.filter((c) => c.status === 'pass').length;
+  console.log(`  ${passed} passed, ${failed} failed, ${checks.length - passed - failed} skipped`);
+}
+
+function parseArgs(argv) {
+  const options = {
+    target: 'all', bench: DEFAULT_BENCH, wasm: DEFAULT_WASM, baseline: DEFAULT_BASELINE,
+    ticks: null, only: null, skipTiming: false, report: null, update: false
+  };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    const value = () => {
+      if (i + 1 >= argv.length) throw new Error(`${arg} needs a value`);
+      return argv[++i];
+    };
+    if (arg === '--target') options.target = value();
+    else if (arg === '--bench') options.bench = value();
+    else if (arg === '--wasm') options.wasm = value();
+    else if (arg === '--baseline') options.baseline = value();
+    else if (arg === '--ticks') options.ticks = Math.max(1, parseInt(value(), 10) || 1);
+    else if (arg === '--scenario') options.only = value();
+    else if (arg === '--report') options.report = value();
+    else if (arg === '--skip-timing') options.skipTiming = true;
+    else if (arg === '--update-baseline') options.update = true;
+    else throw new Error(`unknown option ${arg}`);
+  }
+  if (!['native', 'wasm', 'all'].includes(options.target)) {
+    throw new Error(`--target must be native, wasm or all, not ${options.target}`);
+  }
+  return options;
+}
+
+function main(argv) {
+  let options;
+  let baseline;
+  try {
+    options = parseArgs(argv);
+    baseline = JSON.parse(readFileSync(resolve(options.baseline), 'utf8'));
+  } catch (error) {
+    console.error(`[perf-regression] ${error.message}`);
+    return 2;
+  }
+  // Baselines are recorded at a fixed length so percentiles compare like for like
+  const ticks = options.ticks ?? baseline.ticks ?? 600;
+  const targets = options.target === 'all' ? ['native', 'wasm'] : [options.target];
+
+  const reports = {};
+  try {
+    for (const target of targets) {
+      console.log(`[perf-regression] ${target}: ${ticks} ticks per scenario`);
+      reports[target] = target === 'native'
+        ? runNative(resolve(options.bench), ticks, options.only)
+        : runWasmBench({ wasmPath: options.wasm, ticks, only: options.only });
+    }
+  } catch (error) {
+    console.error(`[perf-regression] ${error.message}`);
+    return 2;
+  }
+
+  if (options.update) {
+    for (const [target, report] of Object.entries(reports)) {
+      baseline.targets ??= {};
+      baseline.targets[target] ??= {};
+      baseline.targets[target].scenarios = {
+        ...(options.only ? baseline.targets[target].scenarios : {}),
+        ...baselineFromReport(report)
+      };
+    }
+    baseline.ticks = ticks;
+    writeFileSync(resolve(options.baseline), JSON.stringify(baseline, null, 2) + '\n');
+    console.log(`[perf-regression] baselines written to ${options.baseline}`);
+    return 0;
+  }
+
+  let failed = 0;
+  const summary = {};
+  for (const [target, report] of Object.entries(reports)) {
+    const scoped = options.only
+      ? { ...baseline, targets: { [target]: filterScenario(baseline.targets?.[target], options.only) } }
+      : baseline;
+    const result = compareToBaseline(report, scoped, { skipTiming: options.skipTiming });
+    printChecks(target, result);
+    failed += result.failed;
+    summary[target] = { report, ...result };
+  }
+  if (options.report) {
+    writeFileSync(resolve(options.report), JSON.stringify({ ticks, failed, targets: summary }, null, 2) + '\n');
+  }
+  console.log(failed ? `\n[perf-regression] FAILED (${failed})` : '\n[perf-regression] OK');
+  return failed ? 1 : 0;
+}
+
+function filterScenario(target, only) {
+  if (!target) return target;
+  const scenarios = target.scenarios?.[only] ? { [only]: target.scenarios[only] } : {};
+  return { ...target, scenarios };
+}
+
+if (process.argv[1] && resolve(process.argv[1]) === fileURLToPath(import.meta.url)) {
+  process.exitCode = main(process.argv.slice(2));
+}
@@ -0,0 +1,373 @@
+#!/usr/bin/env node
+/**
+ * wasm-bench - the dozedent_bench scenarios, run inside game-perf.wasm
+ *
+ * Mirrors public/bench/dozedent_bench.cpp through the module's exports: the
+ * same init_run seed, script seed, warmup and per-tick scripts, and the same
+ * JSON shape (target "wasm"), so tools/scripts/perf-regression.js checks both
+ * against bench/baselines.json the same way. wolf_packs and arm_chains build
+ * packs and kinematic chains that no export creates, so they run natively only.
+ *
+ *   node tools/scripts/wasm-bench.js [--wasm FILE] [--ticks N] [--scenario NAME] [--json FILE]
+ *
+ * `npm run perf:wasm` builds public/wasm/game-perf.wasm (build-wasm.sh perf:
+ * DOZEDENT_PROFILE=1 and DOZEDENT_COUNT_ALLOCS=1) and runs this against it.
+ * Each scenario gets a fresh instance. Allocations come from
+ * get_heap_alloc_count/_bytes (DOZEDENT_COUNT_ALLOCS) and pairs from
+ * get_collision_pairs_checked (DOZEDENT_DEBUG_EXPORTS), snapshot size and
+ * save/load cost from benchmark_state_snapshot, and per-zone times from
+ * the profile ring. Other modules (--wasm public/wasm/game.wasm) run too:
+ * metrics a module cannot report are null, and scenarios needing missing
+ * exports are listed under "skipped".
+ */
+
+import { readFileSync, writeFileSync } from 'node:fs';
+import { resolve } from 'node:path';
+import { fileURLToPath } from 'node:url';
+
+export const TICK_DT = 1 / 60;
+export const WARMUP_TICKS = 60;
+export const RUN_SEED = 1n;
+export const SCRIPT_SEED = 12345;
+
+// ProfileZone order (public/src/wasm/Profiler.h)
+const PROFILE_ZONE_NAMES = [
+  'frame', 'physics', 'physicsIntegrate', 'physicsCollide', 'physicsConstraints',
+  'physicsSleep', 'player', 'skeleton', 'combat', 'wolves', 'arms', 'gameState',
+  'coordination', 'world'
+];
+
+// Same LCG as the native ScriptRng
+class ScriptRng {
+  constructor(seed) {
+    this.state = seed >>> 0;
+  }
+
+  next() {
+    this.state = (Math.imul(this.state, 1664525) + 1013904223) >>> 0;
+    return this.state;
+  }
+
+  unit() {
+    return (this.next() >>> 8) / 16777216;
+  }
+}
+
+// ---- Scenario scripts ----
+
+function spawnWolfRing(wasm, count) {
+  const px = wasm.get_x();
+  const py = wasm.get_y();
+  for (let i = 0; i < count; i++) {
+    const angle = (i / count) * 6.28318;
+    const dist = 0.15 + 0.05 * Math.floor(i / 50);
+    const x = Math.min(1, Math.max(0, px + dist * Math.cos(angle)));
+    const y = Math.min(1, Math.max(0, py + dist * Math.sin(angle)));
+    wasm.spawn_wolf(x, y, i % 5);
+  }
+}
+
+function scriptPlayerFights(wasm, rng, tick) {
+  const phase = tick * 0.05;
+  wasm.set_player_input(Math.cos(phase), Math.sin(phase),
+    tick % 120 === 0 ? 1 : 0, 0, tick % 20 === 0 ? 1 : 0, tick % 90 === 45 ? 1 : 0, tick % 60 >= 50 ? 1 : 0, 0);
+}
+
+const STORM_BARRELS = 400;
+
+function setupBarrelStorm(wasm, rng, state) {
+  state.barrels = [];
+  for (let i = 0; i < STORM_BARRELS; i++) {
+    const x = rng.unit();
+    const y = rng.unit();
+    state.barrels.push(wasm.spawn_barrel(x, y, 0));
+  }
+  spawnWolfRing(wasm, 20);
+}
+
+// The native script applies impulse (dx, dy) * 10; throw_barrel takes a direction and magnitude
+function scriptBarrelStorm(wasm, rng, tick, state) {
+  scriptPlayerFights(wasm, rng, tick);
+  if (tick % 20 !== 0) return;
+  for (let i = 0; i < 40; i++) {
+    const id = state.barrels[rng.next() % state.barrels.length];
+    const dx = rng.unit() * 2 - 1;
+    const dy = rng.unit() * 2 - 1;
+    wasm.throw_barrel(id, dx, dy, 0, 10 * Math.hypot(dx, dy));
+  }
+}
+
+const FIELD_ATTRACT = 0;
+const FIELD_REPEL = 1;
+const FIELD_WIND = 2;
+
+function setupForceFields(wasm, rng, state) {
+  setupBarrelStorm(wasm, rng, state);
+  wasm.add_force_field(FIELD_ATTRACT, 0.5, 0.5, 0, 0.02, 0, 0, 0);
+}
+
+function scriptForceFields(wasm, rng, tick, state) {
+  scriptPlayerFights(wasm, rng, tick);
+  if (tick % 5 === 0) {
+    for (let i = 0; i < 4; i++) {
+      const x = rng.unit();
+      const y = rng.unit();
+      wasm.add_force_field(FIELD_REPEL, x, y, 0.08, 0.5, 0, 0, 12);
+    }
+  }
+  if (tick % 30 === 0) {
+    const x = rng.unit();
+    const y = rng.unit();
+    const dx = rng.unit() * 2 - 1;
+    const dy = rng.unit() * 2 - 1;
+    wasm.add_force_field(FIELD_WIND, x, y, 0.2, 1.0, dx, dy, 20);
+  }
+}
+
+function scriptWorldStream(wasm, rng, tick) {
+  const moveX = Math.floor(tick / 600) % 2 === 0 ? 1 : -1;
+  const moveY = Math.floor(tick / 900) % 2 === 0 ? 0.7 : -0.7;
+  wasm.set_player_input(moveX, moveY, 0, 0, tick % 20 === 3 ? 1 : 0, 0, 0, 0);
+}
+
+const FIGHT_EXPORTS = ['get_x', 'get_y', 'spawn_wolf', 'set_player_input'];
+const BARREL_EXPORTS = [...FIGHT_EXPORTS, 'spawn_barrel', 'throw_barrel'];
+
+export const SCENARIOS = [
+  {
+    name: 'wolves_10', description: '10 wolves around a fighting player', requires: FIGHT_EXPORTS,
+    setup: (wasm) => spawnWolfRing(wasm, 10), script: scriptPlayerFights
+  },
+  {
+    name: 'wolves_100', description: '100 wolves around a fighting player', requires: FIGHT_EXPORTS,
+    setup: (wasm) => spawnWolfRing(wasm, 100), script: scriptPlayerFights
+  },
+  {
+    name: 'wolves_500', description: '500 wolves around a fighting player', requires: FIGHT_EXPORTS,
+    setup: (wasm) => spawnWolfRing(wasm, 500), script: scriptPlayerFights
+  },
+  {
+    name: 'barrel_storm', description: '400 barrels thrown in volleys, 20 wolves', requires: BARREL_EXPORTS,
+    setup: setupBarrelStorm, script: scriptBarrelStorm
+  },
+  {
+    name: 'force_fields', description: '400 barrels, a global pull, short-lived blasts and gusts',
+    requires: [...BARREL_EXPORTS, 'add_force_field'],
+    setup: setupForceFields, script: scriptForceFields
+  },
+  {
+    name: 'world_stream', description: '8x8 streamed chunks crossed by a walking player',
+    requires: ['set_player_input', 'world_configure'],
+    setup: (wasm) => wasm.world_configure(8, 8, 1.0, 1.0, 1234), script: scriptWorldStream
+  },
+  {
+    // Each timed tick also saves and restores the whole simulation, as a rollback peer would
+    name: 'rollback_100', description: '100 wolves, full snapshot save and restore every tick',
+    requires: [...FIGHT_EXPORTS, 'benchmark_state_snapshot'], rollback: true,
+    setup: (wasm) => spawnWolfRing(wasm, 100), script: scriptPlayerFights
+  }
+];
+
+const SNAPSHOT_ITERATIONS = 20;
+
+// ---- Module loading ----
+
+class ProcExit extends Error {
+  constructor(code) {
+    super(`proc_exit(${code})`);
+    this.code = code;
+  }
+}
+
+// Stubs for whatever the module imports (WASI, emscripten notifications);
+// the simulation makes no host calls while it ticks
+function stubImports(module) {
+  const imports = {};
+  for (const entry of WebAssembly.Module.imports(module)) {
+    if (entry.kind !== 'function') continue;
+    imports[entry.module] ??= {};
+    imports[entry.module][entry.name] = entry.name === 'proc_exit'
+      ? (code) => { throw new ProcExit(code); }
+      : () => 0;
+  }
+  return imports;
+}
+
+function instantiate(module) {
+  const instance = new WebAssembly.Instance(module, stubImports(module));
+  const wasm = instance.exports;
+  try {
+    if (typeof wasm._initialize === 'function') {
+      wasm._initialize();
+    } else if (typeof wasm._start === 'function') {
+      wasm._start();  // Static constructors, then the empty main, then proc_exit(0)
+    }
+  } catch (error) {
+    if (!(error instanceof ProcExit) || error.code !== 0) throw error;
+  }
+  return wasm;
+}
+
+// ---- Measurement ----
+
+function summarize(samples) {
+  if (samples.length === 0) return { mean: 0, p50: 0, p95: 0, p99: 0, max: 0 };
+  const sorted = Float64Array.from(samples).sort();
+  const at = (q) => sorted[Math.floor(q * (sorted.length - 1) + 0.5)];
+  const sum = sorted.reduce((a, b) => a + b, 0);
+  return {
+    mean: Math.round(sum / sorted.length),
+    p50: Math.round(at(0.50)),
+    p95: Math.round(at(0.95)),
+    p99: Math.round(at(0.99)),
+    max: Math.round(sorted[sorted.length - 1])
+  };
+}
+
+const round = (value, digits) => {
+  const scale = 10 ** digits;
+  return Math.round(value * scale) / scale;
+};
+
+function runScenario(module, scenario, ticks) {
+  const wasm = instantiate(module);
+  wasm.init_run(RUN_SEED, 0);
+  if (wasm.set_physics_broadphase) wasm.set_physics_broadphase(1);
+
+  const rng = new ScriptRng(SCRIPT_SEED);
+  const state = {};
+  scenario.setup(wasm, rng, state);
+  for (let t = 0; t < WARMUP_TICKS; t++) {
+    scenario.script(wasm, rng, t, state);
+    wasm.update(TICK_DT);
+  }
+
+  const hasAllocs = typeof wasm.get_heap_alloc_count === 'function';
+  const hasPairs = typeof wasm.get_collision_pairs_checked === 'function';
+  const hasEvents = typeof wasm.physics_get_events_pushed === 'function';
+  const hasProfile = typeof wasm.get_profile_zone_ms === 'function';
+  const eventCount = () => wasm.physics_get_events_pushed() + wasm.physics_get_events_dropped();
+
+  const tickNs = [];
+  const zoneMs = new Float64Array(PROFILE_ZONE_NAMES.length);
+  let pairs = 0;
+  let profiled = false;
+  const allocsBefore = hasAllocs ? wasm.get_heap_alloc_count() : 0;
+  const allocBytesBefore = hasAllocs ? wasm.get_heap_alloc_bytes() : 0;
+  const eventsBefore = hasEvents ? eventCount() : 0;
+
+  for (let t = 0; t < ticks; t++) {
+    scenario.script(wasm, rng, WARMUP_TICKS + t, state);
+    const start = process.hrtime.bigint();
+    if (scenario.rollback) wasm.benchmark_state_snapshot(1);
+    wasm.update(TICK_DT);
+    tickNs.push(Number(process.hrtime.bigint() - start));
+
+    if (hasPairs) pairs += wasm.get_collision_pairs_checked();
+    if (hasProfile && wasm.get_profile_count() > 0) {
+      profiled = true;
+      for (let z = 0; z < zoneMs.length; z++) zoneMs[z] += wasm.get_profile_zone_ms(z);
+    }
+  }
+
+  // Size and cost of a rollback snapshot of the final state
+  let snapshot = null;
+  if (typeof wasm.benchmark_state_snapshot === 'function') {
+    const bytes = wasm.benchmark_state_snapshot(SNAPSHOT_ITERATIONS);
+    snapshot = {
+      bytes,
+      saveNs: Math.round(wasm.get_state_snapshot_save_us() * 1e3),
+      loadNs: Math.round(wasm.get_state_snapshot_load_us() * 1e3)
+    };
+  }
+
+  let subsystemNs = null;
+  if (profiled) {
+    subsystemNs = {};
+    PROFILE_ZONE_NAMES.forEach((name, z) => { subsystemNs[name] = Math.round(zoneMs[z] * 1e6 / ticks); });
+  }
+  return {
+    name: scenario.name,
+    description: scenario.description,
+    ticks,
+    wolves: wasm.get_wolf_count ? wasm.get_wolf_count() : null,
+    tickNs: summarize(tickNs),
+    subsystemNs,
+    allocsPerTick: hasAllocs ? round(((wasm.get_heap_alloc_count() - allocsBefore) >>> 0) / ticks, 2) : null,
+    allocBytesPerTick: hasAllocs ? Math.round((wasm.get_heap_alloc_bytes() - allocBytesBefore) / ticks) : null,
+    pairsPerTick: hasPairs ? round(pairs / ticks, 1) : null,
+    eventsPerTick: hasEvents ? round(((eventCount() - eventsBefore) >>> 0) / ticks, 2) : null,
+    snapshot
+  };
+}
+
+/**
+ * Run the scenarios in a game.wasm; resolves to the dozedent_bench JSON shape
+ * @param {{wasmPath?: string, ticks?: number, only?: string}} options
+ */
+export function runWasmBench({ wasmPath = 'public/wasm/game-perf.wasm', ticks = 600, only = null } = {}) {
+  const module = new WebAssembly.Module(readFileSync(resolve(wasmPath)));
+  const exported = new Set(WebAssembly.Module.exports(module).map((e) => e.name));
+  const report = {
+    benchmark: 'wasm-bench',
+    target: 'wasm',
+    module: wasmPath,
+    tickDt: TICK_DT,
+    warmupTicks: WARMUP_TICKS,
+    seed: Number(RUN_SEED),
+    scriptSeed: SCRIPT_SEED,
+    scenarios: [],
+    skipped: []
+  };
+  for (const scenario of SCENARIOS) {
+    if (only && scenario.name !== only) continue;
+    const missing = ['init_run', 'update', ...scenario.requires].filter((name) => !exported.has(name));
+    if (missing.length) {
+      report.skipped.push({ name: scenario.name, missing });
+      continue;
+    }
+    report.scenarios.push(runScenario(module, scenario, ticks));
+  }
+  return report;
+}
+
+function printResult(r) {
+  const us = (ns) => (ns / 1e3).toFixed(1).padStart(8);
+  const metric = (value, digits) => (value === null ? '-' : value.toFixed(digits));
+  console.log(`${r.name.padEnd(13)} wolves ${String(r.wolves ?? '-').padStart(3)} | tick us p50 ${us(r.tickNs.p50)}` +
+    ` p95 ${us(r.tickNs.p95)} p99 ${us(r.tickNs.p99)} max ${us(r.tickNs.max)}` +
+    ` | allocs/tick ${metric(r.allocsPerTick, 1)} pairs/tick ${metric(r.pairsPerTick, 0)}` +
+    ` events/tick ${metric(r.eventsPerTick, 1)}` +
+    (r.snapshot ? ` | snapshot ${r.snapshot.bytes} B save ${us(r.snapshot.saveNs)} load ${us(r.snapshot.loadNs)} us` : ''));
+}
+
+function main(argv) {
+  const options = {};
+  let jsonPath = null;
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (arg === '--wasm' && i + 1 < argv.length) options.wasmPath = argv[++i];
+    else if (arg === '--ticks' && i + 1 < argv.length) options.ticks = Math.max(1, parseInt(argv[++i], 10) || 1);
+    else if (arg === '--scenario' && i + 1 < argv.length) options.only = argv[++i];
+    else if (arg === '--json' && i + 1 < argv.length) jsonPath = argv[++i];
+    else {
+      console.error('usage: wasm-bench.js [--wasm FILE] [--ticks N] [--scenario NAME] [--json FILE]');
+      return 2;
+    }
+  }
+  const report = runWasmBench(options);
+  report.scenarios.forEach(printResult);
+  for (const skip of report.skipped) {
+    console.log(`${skip.name.padEnd(13)} skipped: module lacks ${skip.missing.join(', ')}`);
+  }
+  if (report.scenarios.length === 0 && report.skipped.length === 0) {
+    console.error(`unknown scenario: ${options.only}`);
+    return 2;
+  }
+  if (jsonPath) writeFileSync(jsonPath, JSON.stringify(report, null, 2) + '\n');
+  return 0;
+}
+
+if (process.argv[1] && resolve(process.argv[1]) === fileURLToPath(import.meta.url)) {
+  process.exitCode = main(process.argv.slice(2));
+}